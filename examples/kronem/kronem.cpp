@@ -21,6 +21,7 @@ int main(int argc, char* argv[]) {
   const TInt NSamples = Env.GetIfArgPrefixInt("-s:", 2000, "Samples per gradient estimation");
   const bool ScaleInitMtx = Env.GetIfArgPrefixBool("-sim:", false, "Scale the initiator to match the number of edges");
   const TFlt PermSwapNodeProb = Env.GetIfArgPrefixFlt("-nsp:", 0.6, "Probability of using NodeSwap (vs. EdgeSwap) MCMC proposal");
+  const TInt Chains = Env.GetIfArgPrefixInt("-ch:", 1, "Parallel MCMC chains in E-step");
   const TBool Debug = Env.GetIfArgPrefixBool("-debug:", false, "Debug mode");
 //  const TStr Perm = Env.GetIfArgPrefixStr("-p:", "r", "Permutation: d:Degree, r:Random, o:Order, b:BestMatched").GetLc();
 //  const TStr TypeStr = Env.GetIfArgPrefixStr("-t:", "d", "KronEM type: d:denoise, o:denoise with ordered removal p:process e:edges").GetLc();
@@ -47,6 +48,7 @@ int main(int argc, char* argv[]) {
   InitKronMtx.Dump("SCALED PARAM", true);
 //  KronLL.SetPerm(Perm.GetCh(0));
   KronLL.SetDebug(Debug);
+  KronLL.SetChains(Chains);
 
   KronLL.RunKronEM(EMIter, GradIter, LrnRate, MnStep, MxStep, WarmUp, WarmUp, NSamples);
 
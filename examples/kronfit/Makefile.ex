@@ -5,4 +5,4 @@
 MAIN = kronfit
 DEPH = $(EXSNAPADV)/kronecker.h
 DEPCPP = $(EXSNAPADV)/kronecker.cpp
-
+CXXFLAGS += $(CXXOPENMP)
@@ -5,4 +5,4 @@
 MAIN = krongen
 DEPH = $(EXSNAPADV)/kronecker.h
 DEPCPP = $(EXSNAPADV)/kronecker.cpp
-
+CXXFLAGS += $(CXXOPENMP)
@@ -17,10 +17,21 @@ int main(int argc, char* argv[]) {
   printf("\n*** Kronecker:\n");
   // slow but exact O(n^2) algorightm
   //PNGraph Graph = TKronMtx::GenKronecker(SeedMtx, NIter, true, Seed); 
-  // fast O(e) approximate algorithm
-  PNGraph Graph = TKronMtx::GenFastKronecker(SeedMtx, NIter, true, Seed); 
+  // parallel fast algorithm, out-edges of node i are NbrV[OffV[i]..OffV[i+1]-1]
+  TVec<TInt64> OffV;
+  TVec<TInt, int64> NbrV;
+  TKronMtx::GenFastKroneckerMP(SeedMtx, NIter, (int64) pow(SeedMtx.GetMtxSum(), double(NIter)), true, Seed, OffV, NbrV);
   // save edge list
-  TSnap::SaveEdgeList(Graph, OutFNm, TStr::Fmt("Kronecker Graph: seed matrix [%s]", MtxNm.CStr()));
+  FILE *F = fopen(OutFNm.CStr(), "wt");
+  fprintf(F, "# Directed graph: %s \n", OutFNm.CStr());
+  fprintf(F, "# Kronecker Graph: seed matrix [%s]\n", MtxNm.CStr());
+  fprintf(F, "# Nodes: %d Edges: %s\n", OffV.Len()-1, TUInt64::GetStr(NbrV.Len()).CStr());
+  fprintf(F, "# FromNodeId\tToNodeId\n");
+  for (int i = 0; i < OffV.Len()-1; i++) {
+    for (int64 e = OffV[i]; e < OffV[i+1]; e++) {
+      fprintf(F, "%d\t%d\n", i, NbrV[e].Val); }
+  }
+  fclose(F);
   Catch
   printf("\nrun time: %s (%s)\n", ExeTm.GetTmStr(), TSecTm::GetCurTm().GetTmStr().CStr());
   return 0;
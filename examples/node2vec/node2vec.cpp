@@ -9,7 +9,7 @@
 void ParseArgs(int& argc, char* argv[], TStr& InFile, TStr& OutFile,
  int& Dimensions, int& WalkLen, int& NumWalks, int& WinSize, int& Iter,
  bool& Verbose, double& ParamP, double& ParamQ, bool& Directed, bool& Weighted,
- bool& OutputWalks) {
+ bool& OutputWalks, bool& RejectSampling, TStr& WalksFile, bool& BinaryOutput) {
   Env = TEnv(argc, argv, TNotify::StdNotify);
   Env.PrepArgs(TStr::Fmt("\nAn algorithmic framework for representational learning on graphs."));
   InFile = Env.GetIfArgPrefixStr("-i:", "graph/karate.edgelist",
@@ -34,6 +34,10 @@ void ParseArgs(int& argc, char* argv[], TStr& InFile, TStr& OutFile,
   Directed = Env.IsArgStr("-dr", "Graph is directed.");
   Weighted = Env.IsArgStr("-w", "Graph is weighted.");
   OutputWalks = Env.IsArgStr("-ow", "Output random walks instead of embeddings.");
+  RejectSampling = Env.IsArgStr("-rs", "Sample walks by rejection sampling, without per edge-pair tables (for graphs with hubs).");
+  WalksFile = Env.GetIfArgPrefixStr("-sw:", "",
+   "Spill walks to this file and reuse them in every epoch");
+  BinaryOutput = Env.IsArgStr("-ob", "Write embeddings in binary word2vec format.");
 }
 
 void ReadGraph(TStr& InFile, bool& Directed, bool& Weighted, bool& Verbose, PWNet& InNet) {
@@ -68,7 +72,11 @@ void ReadGraph(TStr& InFile, bool& Directed, bool& Weighted, bool& Verbose, PWNe
 }
 
 void WriteOutput(TStr& OutFile, TIntFltVH& EmbeddingsHV, TVVec<TInt, int64>& WalksVV,
- bool& OutputWalks) {
+ bool& OutputWalks, bool& BinaryOutput) {
+  if (BinaryOutput && !OutputWalks) {
+    SaveEmbeddingsBin(TFOut::New(OutFile), EmbeddingsHV);
+    return;
+  }
   TFOut FOut(OutFile);
   if (OutputWalks) {
     for (int64 i = 0; i < WalksVV.GetXDim(); i++) {
@@ -102,18 +110,18 @@ void WriteOutput(TStr& OutFile, TIntFltVH& EmbeddingsHV, TVVec<TInt, int64>& Wal
 }
 
 int main(int argc, char* argv[]) {
-  TStr InFile,OutFile;
+  TStr InFile,OutFile,WalksFile;
   int Dimensions, WalkLen, NumWalks, WinSize, Iter;
   double ParamP, ParamQ;
-  bool Directed, Weighted, Verbose, OutputWalks;
+  bool Directed, Weighted, Verbose, OutputWalks, RejectSampling, BinaryOutput;
   ParseArgs(argc, argv, InFile, OutFile, Dimensions, WalkLen, NumWalks, WinSize,
-   Iter, Verbose, ParamP, ParamQ, Directed, Weighted, OutputWalks);
+   Iter, Verbose, ParamP, ParamQ, Directed, Weighted, OutputWalks, RejectSampling, WalksFile, BinaryOutput);
   PWNet InNet = PWNet::New();
   TIntFltVH EmbeddingsHV;
   TVVec <TInt, int64> WalksVV;
   ReadGraph(InFile, Directed, Weighted, Verbose, InNet);
   node2vec(InNet, ParamP, ParamQ, Dimensions, WalkLen, NumWalks, WinSize, Iter, 
-   Verbose, OutputWalks, WalksVV, EmbeddingsHV);
-  WriteOutput(OutFile, EmbeddingsHV, WalksVV, OutputWalks);
+   Verbose, OutputWalks, WalksVV, EmbeddingsHV, RejectSampling, WalksFile);
+  WriteOutput(OutFile, EmbeddingsHV, WalksVV, OutputWalks, BinaryOutput);
   return 0;
 }
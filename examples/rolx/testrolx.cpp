@@ -20,9 +20,9 @@ int main(int argc, char* argv[]) {
   printf("loading file...\n");
   PUNGraph Graph = TSnap::LoadEdgeList<PUNGraph>(InFNm, 0, 1);
   printf("extracting features...\n");
-  TIntFtrH Features = ExtractFeatures(Graph);
-  TIntIntH NodeIdMtxIdH = CreateNodeIdMtxIdxHash(Features);
-  TFltVV V = ConvertFeatureToMatrix(Features, NodeIdMtxIdH);
+  TFltVV V;
+  TIntIntH NodeIdMtxIdH;
+  ExtractFeatures(Graph, V, NodeIdMtxIdH);
   printf("saving features...\n");
   FPrintMatrix(V, "v.txt");
   printf("feature matrix is saved in v.txt\n");
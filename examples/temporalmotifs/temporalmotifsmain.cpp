@@ -23,6 +23,10 @@ int main(int argc, char* argv[]) {
     Env.GetIfArgPrefixFlt("-delta:", 4096, "Time window delta");
   const int num_threads =
     Env.GetIfArgPrefixInt("-nt:", 4, "Number of threads for parallelization");
+  const TFlt sample_prob =
+    Env.GetIfArgPrefixFlt("-sp:", 1, "Interval sampling probability (1: exact counts)");
+  const TFlt window_factor =
+    Env.GetIfArgPrefixFlt("-sw:", 30, "Sampled interval length in units of delta");
 
 #ifdef USE_OPENMP
   omp_set_num_threads(num_threads);
@@ -30,17 +34,34 @@ int main(int argc, char* argv[]) {
 
   // Count all 2-node and 3-node temporal motifs with 3 temporal edges
   TempMotifCounter tmc(temporal_graph_filename);
-  Counter2D counts;
-  tmc.Count3TEdge23Node(delta, counts);
   FILE* output_file = fopen(output.CStr(), "wt");
-  for (int i = 0; i < counts.m(); i++) {
-    for (int j = 0; j < counts.n(); j++) {
-      int count = counts(i, j);
-      fprintf(output_file, "%d", count);
-      if (j < counts.n() - 1) { fprintf(output_file, " "); }
+  if (sample_prob < 1) {
+    // Estimate the counts from a sample of time intervals
+    TRnd rnd(0);
+    TFltVV estimates, std_errors;
+    tmc.Count3TEdge23NodeSampled(delta, window_factor, sample_prob, rnd,
+                                 estimates, std_errors);
+    for (int i = 0; i < estimates.GetXDim(); i++) {
+      for (int j = 0; j < estimates.GetYDim(); j++) {
+        fprintf(output_file, "%.0f(%.0f)", estimates(i, j).Val,
+                std_errors(i, j).Val);
+        if (j < estimates.GetYDim() - 1) { fprintf(output_file, " "); }
+      }
+      fprintf(output_file, "\n");
+    }
+  } else {
+    Counter2D counts;
+    tmc.Count3TEdge23Node(delta, counts);
+    for (int i = 0; i < counts.m(); i++) {
+      for (int j = 0; j < counts.n(); j++) {
+        int count = counts(i, j);
+        fprintf(output_file, "%d", count);
+        if (j < counts.n() - 1) { fprintf(output_file, " "); }
+      }
+      fprintf(output_file, "\n");
     }
-    fprintf(output_file, "\n");
   }
+  fclose(output_file);
   
   Catch
   printf("\nrun time: %s (%s)\n", ExeTm.GetTmStr(),
@@ -136,6 +136,7 @@
 #include <time.h>
 #include <typeinfo>
 #include <stdexcept>
+#include <new>
 
 #ifdef GLib_CYGWIN
   #define timezone _timezone
@@ -417,6 +417,92 @@ public:
   }
 };
 
+/////////////////////////////////////////////////
+// Relocatable-Values
+/// Tests (at compile time) if objects of type \c TVal can be moved to another address with \c memcpy.
+/// Such objects do not point to themselves, so arrays of them can grow with \c realloc and
+/// nested vectors, hash tables and strings keep their buffers instead of being copied.
+template <class TVal> struct TIsRelocatable { enum { Val = 0 }; };
+template <> struct TIsRelocatable<bool> { enum { Val = 1 }; };
+template <> struct TIsRelocatable<char> { enum { Val = 1 }; };
+template <> struct TIsRelocatable<uchar> { enum { Val = 1 }; };
+template <> struct TIsRelocatable<short> { enum { Val = 1 }; };
+template <> struct TIsRelocatable<int> { enum { Val = 1 }; };
+template <> struct TIsRelocatable<uint> { enum { Val = 1 }; };
+template <> struct TIsRelocatable<int64> { enum { Val = 1 }; };
+template <> struct TIsRelocatable<uint64> { enum { Val = 1 }; };
+template <> struct TIsRelocatable<float> { enum { Val = 1 }; };
+template <> struct TIsRelocatable<double> { enum { Val = 1 }; };
+template <class TVal> struct TIsRelocatable<TVal*> { enum { Val = 1 }; };
+template <> struct TIsRelocatable<TBool> { enum { Val = 1 }; };
+template <> struct TIsRelocatable<TCh> { enum { Val = 1 }; };
+template <> struct TIsRelocatable<TUCh> { enum { Val = 1 }; };
+template <> struct TIsRelocatable<TSInt> { enum { Val = 1 }; };
+template <> struct TIsRelocatable<TInt> { enum { Val = 1 }; };
+template <> struct TIsRelocatable<TUInt> { enum { Val = 1 }; };
+template <> struct TIsRelocatable<TUInt64> { enum { Val = 1 }; };
+template <class Base> struct TIsRelocatable<TNum<Base> > { enum { Val = 1 }; };
+template <> struct TIsRelocatable<TFlt> { enum { Val = 1 }; };
+template <> struct TIsRelocatable<TSFlt> { enum { Val = 1 }; };
+template <> struct TIsRelocatable<TLFlt> { enum { Val = 1 }; };
+template <> struct TIsRelocatable<TStr> { enum { Val = 1 }; };
+template <> struct TIsRelocatable<TChA> { enum { Val = 1 }; };
+template <class TRec> struct TIsRelocatable<TPt<TRec> > { enum { Val = 1 }; };
+template <class TVal, class TSizeTy> struct TIsRelocatable<TVec<TVal, TSizeTy> > { enum { Val = 1 }; };
+template <class TVal1, class TVal2> struct TIsRelocatable<TPair<TVal1, TVal2> > {
+  enum { Val = TIsRelocatable<TVal1>::Val && TIsRelocatable<TVal2>::Val }; };
+template <class TVal1, class TVal2, class TVal3> struct TIsRelocatable<TTriple<TVal1, TVal2, TVal3> > {
+  enum { Val = TIsRelocatable<TVal1>::Val && TIsRelocatable<TVal2>::Val && TIsRelocatable<TVal3>::Val }; };
+template <class TVal1, class TVal2, class TVal3, class TVal4> struct TIsRelocatable<TQuad<TVal1, TVal2, TVal3, TVal4> > {
+  enum { Val = TIsRelocatable<TVal1>::Val && TIsRelocatable<TVal2>::Val && TIsRelocatable<TVal3>::Val && TIsRelocatable<TVal4>::Val }; };
+template <class TKey, class TDat> struct TIsRelocatable<TKeyDat<TKey, TDat> > {
+  enum { Val = TIsRelocatable<TKey>::Val && TIsRelocatable<TDat>::Val }; };
+
+/////////////////////////////////////////////////
+// Vector-Allocation
+/// Allocates the arrays of \c TVec. Values are default constructed and freed with \c new[] and \c delete[].
+template <class TVal, class TSizeTy, bool IsRelocatable>
+class TVecAlloc {
+public:
+  static TVal* New(const TSizeTy& MxVals) { return new TVal[MxVals]; }
+  static void Del(TVal* ValT, const TSizeTy& MxVals) { delete[] ValT; }
+  /// Returns an array of \c NewMxVals values that starts with the first \c Vals values of \c ValT and frees \c ValT.
+  static TVal* Renew(TVal* ValT, const TSizeTy& Vals, const TSizeTy& MxVals, const TSizeTy& NewMxVals) {
+    TVal* NewValT = new TVal[NewMxVals];
+    for (TSizeTy ValN = 0; ValN < Vals; ValN++) { NewValT[ValN] = ValT[ValN]; }
+    delete[] ValT;
+    return NewValT; }
+};
+
+/// Arrays of relocatable values live in \c malloc memory, so \c Renew() moves the values with \c realloc
+/// (which remaps the pages of large arrays) instead of copying them one by one.
+template <class TVal, class TSizeTy>
+class TVecAlloc<TVal, TSizeTy, true> {
+private:
+  // size of MxVals values in bytes, sizes that are negative or do not fit in size_t throw bad_alloc
+  static size_t GetBytes(const TSizeTy& MxVals) {
+    if (MxVals < 0 || uint64(MxVals) > uint64(size_t(-1) / sizeof(TVal))) { throw std::bad_alloc(); }
+    return size_t(MxVals) * sizeof(TVal); }
+public:
+  static TVal* New(const TSizeTy& MxVals) {
+    TVal* ValT = (TVal*) malloc(GetBytes(MxVals));
+    if (ValT == NULL && MxVals > 0) { throw std::bad_alloc(); }
+    for (TSizeTy ValN = 0; ValN < MxVals; ValN++) { new (ValT + ValN) TVal(); }
+    return ValT; }
+  static void Del(TVal* ValT, const TSizeTy& MxVals) {
+    for (TSizeTy ValN = 0; ValN < MxVals; ValN++) { ValT[ValN].~TVal(); }
+    free(ValT); }
+  static TVal* Renew(TVal* ValT, const TSizeTy& Vals, const TSizeTy& MxVals, const TSizeTy& NewMxVals) {
+    const size_t NewBytes = GetBytes(NewMxVals);
+    for (TSizeTy ValN = Vals; ValN < MxVals; ValN++) { ValT[ValN].~TVal(); }
+    TVal* NewValT = (TVal*) realloc((void*) ValT, NewBytes);
+    if (NewValT == NULL && NewMxVals > 0) {
+      for (TSizeTy ValN = Vals; ValN < MxVals; ValN++) { new (ValT + ValN) TVal(); }
+      throw std::bad_alloc(); }
+    for (TSizeTy ValN = Vals; ValN < NewMxVals; ValN++) { new (NewValT + ValN) TVal(); }
+    return NewValT; }
+};
+
 //#//////////////////////////////////////////////
 /// Vector is a sequence \c TVal objects representing an array that can change in size. ##TVec
 template <class TVal, class TSizeTy = int>
@@ -428,6 +514,10 @@ protected:
   TSizeTy Vals;   //!< Vector length. Length is the number of elements stored in the vector.
   TVal* ValT;     //!< Pointer to the memory where the elements of the vector are stored.
   bool IsShM; //!< True if the vector array is in shared memory
+  /// Allocates an array of \c _MxVals default constructed values.
+  static TVal* AllocValT(const TSizeTy& _MxVals) { return TVecAlloc<TVal, TSizeTy, TIsRelocatable<TVal>::Val>::New(_MxVals); }
+  /// Frees the array \c _ValT of \c _MxVals values.
+  static void FreeValT(TVal* _ValT, const TSizeTy& _MxVals) { TVecAlloc<TVal, TSizeTy, TIsRelocatable<TVal>::Val>::Del(_ValT, _MxVals); }
   /// Resizes the vector so that it can store at least \c _MxVals.
   void Resize(const TSizeTy& _MxVals=-1);
   /// Constructs the out of bounds error message.
@@ -439,29 +529,29 @@ public:
   explicit TVec(const TSizeTy& _Vals){
     IsShM = false;
     IAssert(0<=_Vals); MxVals=Vals=_Vals;
-    if (_Vals==0){ValT=NULL;} else {ValT=new TVal[_Vals];}}
+    if (_Vals==0){ValT=NULL;} else {ValT=AllocValT(_Vals);}}
   /// Constructs a vector (an array) of length \c _Vals, while reserving enough memory to store \c _MxVals elements.
   TVec(const TSizeTy& _MxVals, const TSizeTy& _Vals){
     IsShM = false;
     IAssert((0<=_Vals)&&(_Vals<=_MxVals)); MxVals=_MxVals; Vals=_Vals;
-    if (_MxVals==0){ValT=NULL;} else {ValT=new TVal[_MxVals];}}
+    if (_MxVals==0){ValT=NULL;} else {ValT=AllocValT(_MxVals);}}
   /// Constructs a vector of \c _Vals elements of memory array \c _ValT. ##TVec::TVec
   explicit TVec(TVal *_ValT, const TSizeTy& _Vals):
     MxVals(-1), Vals(_Vals), ValT(_ValT), IsShM(false){}
-  ~TVec() {if ((ValT!=NULL) && (MxVals!=-1)) {delete[] ValT;}}
+  ~TVec() {if ((ValT!=NULL) && (MxVals!=-1)) {FreeValT(ValT, MxVals);}}
   explicit TVec(TSIn& SIn): MxVals(0), Vals(0), ValT(NULL), IsShM(false) {Load(SIn);}
   /// Constructs the vector from a shared memory input ##TVec::LoadShM
   void LoadShM(TShMIn& ShMIn);
   /// Constructs vector from shared memory input passing in functor to initialize elements
   template <typename TLoadShMElem>
   void LoadShM(TShMIn& ShMIn, TLoadShMElem LoadFromShMFn) {
-    if ((ValT!=NULL) && (MxVals!=-1)) {delete[] ValT;}
+    if ((ValT!=NULL) && (MxVals!=-1)) {FreeValT(ValT, MxVals);}
     ShMIn.Load(MxVals);
     ShMIn.Load(Vals);
     if (MxVals == 0) {
       ValT = NULL;
     } else {
-        ValT=new TVal[MxVals];
+        ValT=AllocValT(MxVals);
         for (TSizeTy ValN=0; ValN<Vals; ValN++) {
           LoadFromShMFn(ValT+ValN, ShMIn);
         }
@@ -504,15 +594,15 @@ public:
 
   /// Constructs a vector (an array) of \c _Vals elements.
   void Gen(const TSizeTy& _Vals){ IAssert(0<=_Vals);
-    if (ValT!=NULL && MxVals!=-1){delete[] ValT;} MxVals=Vals=_Vals;
-    if (MxVals==0){ValT=NULL;} else {ValT=new TVal[MxVals];}}
+    if (ValT!=NULL && MxVals!=-1){FreeValT(ValT, MxVals);} MxVals=Vals=_Vals;
+    if (MxVals==0){ValT=NULL;} else {ValT=AllocValT(MxVals);}}
   /// Constructs a vector (an array) of \c _Vals elements, while reserving enough memory for \c _MxVals elements.
   void Gen(const TSizeTy& _MxVals, const TSizeTy& _Vals){ IAssert((0<=_Vals)&&(_Vals<=_MxVals));
-    if (ValT!=NULL  && MxVals!=-1){delete[] ValT;} MxVals=_MxVals; Vals=_Vals;
-    if (_MxVals==0){ValT=NULL;} else {ValT=new TVal[_MxVals];}}
+    if (ValT!=NULL  && MxVals!=-1){FreeValT(ValT, MxVals);} MxVals=_MxVals; Vals=_Vals;
+    if (_MxVals==0){ValT=NULL;} else {ValT=AllocValT(_MxVals);}}
   /// Constructs a vector of \c _Vals elements of memory array \c _ValT. ##TVec::GenExt
   void GenExt(TVal *_ValT, const TSizeTy& _Vals){
-    if (ValT!=NULL && MxVals!=-1){delete[] ValT;}
+    if (ValT!=NULL && MxVals!=-1){FreeValT(ValT, MxVals);}
     MxVals=-1; Vals=_Vals; ValT=_ValT;}
   /// Returns true if the vector was created using the \c GenExt(). ##TVec::IsExt
   bool IsExt() const {return MxVals==-1;}
@@ -694,6 +784,37 @@ public:
       else { const TVal Val = *GetPivotValNCmp(BI, EI, Cmp);
         TIter Split = PartitionCmp(BI, EI, Val, Cmp);
         QSortCmp(BI, Split, Cmp);  QSortCmp(Split, EI, Cmp); } } }
+  /// Moves the value at position \c Root of the heap <tt>BI...BI+Vals</tt> down to restore the heap order under the comparator \c Cmp.
+  template <class TCmp>
+  static void SiftDownCmp(TIter BI, TSizeTy Root, const TSizeTy& Vals, const TCmp& Cmp) {
+    const TVal Tmp = *(BI+Root);
+    for (TSizeTy Child = 2*Root+1; Child < Vals; Child = 2*Root+1) {
+      if (Child+1 < Vals && Cmp(*(BI+Child), *(BI+Child+1))) { Child++; }
+      if (! Cmp(Tmp, *(BI+Child))) { break; }
+      *(BI+Root) = *(BI+Child);  Root = Child; }
+    *(BI+Root) = Tmp; }
+  /// Heap sorts the values between positions <tt>BI...EI</tt> under the comparator \c Cmp.
+  template <class TCmp>
+  static void HSortCmp(TIter BI, TIter EI, const TCmp& Cmp) {
+    const TSizeTy Vals = TSizeTy(EI-BI);
+    for (TSizeTy i = Vals/2; i > 0; i--) { SiftDownCmp(BI, i-1, Vals, Cmp); }
+    for (TSizeTy i = Vals-1; i > 0; i--) { SwapI(BI, BI+i);  SiftDownCmp(BI, 0, i, Cmp); } }
+  /// Sorts the values between positions <tt>BI...EI</tt> under the comparator \c Cmp with a median-of-three quick sort that switches to heap sort on deep recursion.
+  /// Unlike \c QSortCmp it draws no random pivots, so threads can sort disjoint ranges concurrently.
+  template <class TCmp>
+  static void IntroSortCmp(TIter BI, TIter EI, const TCmp& Cmp) {
+    int Depth = 0;
+    for (TSizeTy Vals = TSizeTy(EI-BI); Vals > 1; Vals /= 2) { Depth += 2; }
+    IntroSortCmp(BI, EI, Cmp, Depth); }
+  template <class TCmp>
+  static void IntroSortCmp(TIter BI, TIter EI, const TCmp& Cmp, const int& Depth) {
+    if (EI - BI < 20) { ISortCmp(BI, EI, Cmp);  return; }
+    if (Depth == 0) { HSortCmp(BI, EI, Cmp);  return; }
+    TIter MI = BI + (EI-BI)/2;  // median of the first, middle and last value
+    if (Cmp(*MI, *BI)) { SwapI(MI, BI); }
+    if (Cmp(*(EI-1), *MI)) { SwapI(EI-1, MI);  if (Cmp(*MI, *BI)) { SwapI(MI, BI); } }
+    TIter Split = PartitionCmp(BI, EI, *MI, Cmp);
+    IntroSortCmp(BI, Split, Cmp, Depth-1);  IntroSortCmp(Split, EI, Cmp, Depth-1); }
   /// Sorts the elements of the vector using the comparator \c Cmp.
   template <class TCmp>
   void SortCmp(const TCmp& Cmp){ QSortCmp(BegI(), EndI(), Cmp);}
@@ -794,7 +915,7 @@ void TVec<TVal, TSizeTy>::Resize(const TSizeTy& _MxVals){
   }
   if (ValT==NULL){
     try {
-      ValT=new TVal[MxVals];
+      ValT=AllocValT(MxVals);
     }
     catch (std::exception Ex){
       FailR(TStr::Fmt("TVec::Resize: %s, Length:%s, Capacity:%s, New capacity:%s, Type:%s [Program failed to allocate more memory. Solution: Get a bigger machine and a 64-bit compiler.]",
@@ -802,14 +923,18 @@ void TVec<TVal, TSizeTy>::Resize(const TSizeTy& _MxVals){
   } else {
     TVal* NewValT = NULL;
     try {
-      NewValT=new TVal[MxVals];
+      if (OldMxVals != -1) { // moves relocatable values instead of copying them
+        NewValT=TVecAlloc<TVal, TSizeTy, TIsRelocatable<TVal>::Val>::Renew(ValT, Vals, OldMxVals, MxVals);
+      } else {
+        NewValT=AllocValT(MxVals);
+        for (TSizeTy ValN=0; ValN<Vals; ValN++){NewValT[ValN]=ValT[ValN];}
+      }
     }
     catch (std::exception Ex){
       FailR(TStr::Fmt("TVec::Resize: %s, Length:%s, Capacity:%s, New capacity:%s, Type:%s [Program failed to allocate more memory. Solution-1: Get a bigger machine and a 64-bit compiler.]",
         Ex.what(), TInt::GetStr(Vals).CStr(), TInt::GetStr(MxVals).CStr(), TInt::GetStr(_MxVals).CStr(), GetTypeNm(*this).CStr()).CStr());}
     IAssert(NewValT!=NULL);
-    for (TSizeTy ValN=0; ValN<Vals; ValN++){NewValT[ValN]=ValT[ValN];}
-    if (OldMxVals != -1) {delete[] ValT;} ValT=NewValT;
+    ValT=NewValT;
   }
   IsShM = false;
 }
@@ -827,7 +952,7 @@ template <class TVal, class TSizeTy>
 TVec<TVal, TSizeTy>::TVec(const TVec<TVal, TSizeTy>& Vec){
   MxVals=Vec.MxVals;
   Vals=Vec.Vals;
-  if (MxVals==0) {ValT=NULL;} else {ValT=new TVal[MxVals];}
+  if (MxVals==0) {ValT=NULL;} else {ValT=AllocValT(MxVals);}
   for (TSizeTy ValN=0; ValN<Vec.Vals; ValN++){ValT[ValN]=Vec.ValT[ValN];}
   IsShM = false;
 }
@@ -835,7 +960,7 @@ TVec<TVal, TSizeTy>::TVec(const TVec<TVal, TSizeTy>& Vec){
 
 template <class TVal, class TSizeTy>
 void TVec<TVal, TSizeTy>::LoadShM(TShMIn& ShMIn) {
-  if ((ValT!=NULL) && (MxVals!=-1)) {delete[] ValT;}
+  if ((ValT!=NULL) && (MxVals!=-1)) {FreeValT(ValT, MxVals);}
   ShMIn.Load(MxVals);
   MxVals = -1;
   ShMIn.Load(Vals);
@@ -849,9 +974,9 @@ void TVec<TVal, TSizeTy>::LoadShM(TShMIn& ShMIn) {
 
 template <class TVal, class TSizeTy>
 void TVec<TVal, TSizeTy>::Load(TSIn& SIn){
-  if ( (ValT!=NULL) && (MxVals!=-1)) {delete[] ValT;}
+  if ( (ValT!=NULL) && (MxVals!=-1)) {FreeValT(ValT, MxVals);}
   SIn.Load(MxVals); SIn.Load(Vals); MxVals=Vals;
-  if ( MxVals==0 ){ValT=NULL;} else {ValT=new TVal[MxVals];}
+  if ( MxVals==0 ){ValT=NULL;} else {ValT=AllocValT(MxVals);}
   for (TSizeTy ValN=0; ValN<Vals; ValN++){ValT[ValN]=TVal(SIn);}
 }
 
@@ -865,9 +990,9 @@ void TVec<TVal, TSizeTy>::Save(TSOut& SOut) const {
 template <class TVal, class TSizeTy>
 TVec<TVal, TSizeTy>& TVec<TVal, TSizeTy>::operator=(const TVec<TVal, TSizeTy>& Vec){
   if (this!=&Vec){
-    if ((ValT!=NULL)&&(MxVals!=-1)){delete[] ValT;}
+    if ((ValT!=NULL)&&(MxVals!=-1)){FreeValT(ValT, MxVals);}
     MxVals=Vals=Vec.Vals;
-    if (MxVals==0){ValT=NULL;} else {ValT=new TVal[MxVals];}
+    if (MxVals==0){ValT=NULL;} else {ValT=AllocValT(MxVals);}
     for (TSizeTy ValN=0; ValN<Vec.Vals; ValN++){ValT[ValN]=Vec.ValT[ValN];}
   }
   return *this;
@@ -926,7 +1051,7 @@ int TVec<TVal, TSizeTy>::GetSecHashCd() const {
 template <class TVal, class TSizeTy>
 void TVec<TVal, TSizeTy>::Clr(const bool& DoDel, const TSizeTy& NoDelLim){
   if ((DoDel)||((!DoDel)&&(NoDelLim!=-1)&&(MxVals>NoDelLim))){
-    if ((ValT!=NULL)&&(MxVals!=-1)){delete[] ValT;}
+    if ((ValT!=NULL)&&(MxVals!=-1)){FreeValT(ValT, MxVals);}
     MxVals=Vals=0; ValT=NULL;
   } else {
     IAssertR(MxVals!=-1 || IsShM, "This vector was obtained from TVecPool. Such vectors cannot change its size!");
@@ -943,18 +1068,17 @@ void TVec<TVal, TSizeTy>::Trunc(const TSizeTy& _Vals){
     return;
   } else
     if (((_Vals==-1)&&(Vals==0))||(_Vals==0)){
-      if (ValT!=NULL){delete[] ValT;}
+      if (ValT!=NULL){FreeValT(ValT, MxVals);}
       MxVals=Vals=0; ValT=NULL;
     } else {
+      const TSizeTy OldMxVals=MxVals;
       if (_Vals==-1){
         if (MxVals==Vals){return;} else {MxVals=Vals;}
       } else {
         MxVals=Vals=_Vals;
       }
-      TVal* NewValT=new TVal[MxVals];
-      IAssert(NewValT!=NULL);
-      for (TSizeTy ValN=0; ValN<Vals; ValN++){NewValT[ValN]=ValT[ValN];}
-      delete[] ValT; ValT=NewValT;
+      ValT=TVecAlloc<TVal, TSizeTy, TIsRelocatable<TVal>::Val>::Renew(ValT, Vals, OldMxVals, MxVals);
+      IAssert(ValT!=NULL);
     }
 }
 
@@ -963,21 +1087,19 @@ void TVec<TVal, TSizeTy>::Pack(){
   EAssertR(!(IsShM && (MxVals == -1)), "Cannot pack accessed shared memory");
   IAssertR(MxVals!=-1, "This vector was obtained from TVecPool. Such vectors cannot change its size!");
   if (Vals==0){
-    if (ValT!=NULL){delete[] ValT;} ValT=NULL;
+    if (ValT!=NULL){FreeValT(ValT, MxVals);} ValT=NULL; MxVals=0;
   } else
     if (Vals<MxVals){
+      ValT=TVecAlloc<TVal, TSizeTy, TIsRelocatable<TVal>::Val>::Renew(ValT, Vals, MxVals, Vals);
+      IAssert(ValT!=NULL);
       MxVals=Vals;
-      TVal* NewValT=new TVal[MxVals];
-      IAssert(NewValT!=NULL);
-      for (TSizeTy ValN=0; ValN<Vals; ValN++){NewValT[ValN]=ValT[ValN];}
-      delete[] ValT; ValT=NewValT;
     }
 }
 
 template <class TVal, class TSizeTy>
 void TVec<TVal, TSizeTy>::MoveFrom(TVec<TVal, TSizeTy>& Vec){
   if (this!=&Vec){
-    if (ValT!=NULL && MxVals!=-1){delete[] ValT;}
+    if (ValT!=NULL && MxVals!=-1){FreeValT(ValT, MxVals);}
     MxVals=Vec.MxVals; Vals=Vec.Vals; ValT=Vec.ValT;
     Vec.MxVals=0; Vec.Vals=0; Vec.ValT=NULL;
   }
@@ -988,8 +1110,8 @@ void TVec<TVal, TSizeTy>::CopyUniqueFrom(TVec<TVal, TSizeTy>& Vec, TInt Offset,
   EAssertR(!(IsShM && (MxVals == -1)), "Cannot write to shared memory");
   if (this!=&Vec){
     if (ValT!=NULL && MxVals!=-1 && MxVals < Sz){
-      delete[] ValT;
-      ValT=new TVal[Sz];
+      FreeValT(ValT, MxVals);
+      ValT=AllocValT(Sz);  MxVals=Sz;
     }
     if (Sz == 0) { Vals = 0; return; }
     ValT[0] = Vec.ValT[Offset];
@@ -1813,6 +1935,144 @@ void TVecPool<TVal, TSizeTy>::ShuffleAll(TRnd& Rnd) {
 }
 
 
+//#//////////////////////////////////////////////
+/// Slab pool of growable vectors. ##TSlabPool
+template <class TVal>
+class TSlabPool {
+public:
+  typedef TPt<TSlabPool<TVal> > PSlabPool;
+private:
+  enum { MnCapBits = 1, Classes = 30, ClassBits = 5, ClassMask = 31, ChunkValBits = 16 };
+  TCRef CRef;
+  TVec<TVal*> ChunkV[Classes];        // chunks of slots of each size class
+  int64 Slots[Classes];               // number of slots carved from the chunks of each class
+  TVec<TInt64, int64> FreeV[Classes]; // free slots of each class
+private:
+  static int GetCapBits(const int& Class) { return Class + MnCapBits; }
+  static int GetChunkBits(const int& Class) { return GetCapBits(Class) < ChunkValBits ? ChunkValBits - GetCapBits(Class) : 0; }
+  void CopyFrom(const TSlabPool& Pool);
+public:
+  TSlabPool() { for (int c = 0; c < Classes; c++) { Slots[c] = 0; } }
+  TSlabPool(const TSlabPool& Pool) { CopyFrom(Pool); }
+  ~TSlabPool() { Clr(); }
+  static PSlabPool New() { return new TSlabPool(); }
+  TSlabPool& operator = (const TSlabPool& Pool) { if (this != &Pool) { Clr(); CopyFrom(Pool); } return *this; }
+
+  /// Returns the size class of the smallest slot that holds \c Vals values.
+  static int GetClass(const int& Vals) { int Class = 0; while ((1 << GetCapBits(Class)) < Vals) { Class++; } return Class; }
+  /// Returns the number of values slot \c SlotId can hold. Slot -1 is the empty slot.
+  static int GetCap(const int64& SlotId) { return SlotId == -1 ? 0 : 1 << GetCapBits(int(SlotId & ClassMask)); }
+  /// Returns the largest number of values a slot can hold.
+  static int GetMxCap() { return 1 << GetCapBits(Classes-1); }
+  /// Returns pointer to the first value of slot \c SlotId.
+  TVal* GetValVPt(const int64& SlotId) const {
+    const int Class = int(SlotId & ClassMask), ChunkBits = GetChunkBits(Class);
+    const int64 SlotN = SlotId >> ClassBits;
+    return ChunkV[Class][int(SlotN >> ChunkBits)] + ((SlotN & ((int64(1) << ChunkBits) - 1)) << GetCapBits(Class)); }
+  /// Returns a slot that holds at least \c MnVals values. ##TSlabPool::AddSlot
+  int64 AddSlot(const int& MnVals);
+  /// Returns a slot that holds a copy of the \c Vals values at \c ValT, or -1 if \c Vals is 0.
+  int64 AddV(const TVal* ValT, const int& Vals);
+  /// Returns slot \c SlotId to the free list of its size class.
+  void DelSlot(const int64& SlotId) { if (SlotId != -1) { FreeV[SlotId & ClassMask].Add(SlotId); } }
+  /// Returns a slot that holds at least \c MnVals values and starts with the first \c Vals values of slot \c SlotId. ##TSlabPool::Renew
+  int64 Renew(const int64& SlotId, const int& Vals, const int& MnVals);
+  /// Returns the number of slots in use.
+  int64 GetSlots() const { int64 SlotCnt = 0;
+    for (int c = 0; c < Classes; c++) { SlotCnt += Slots[c] - FreeV[c].Len(); }  return SlotCnt; }
+  /// Returns the number of free slots.
+  int64 GetFreeSlots() const { int64 SlotCnt = 0;
+    for (int c = 0; c < Classes; c++) { SlotCnt += FreeV[c].Len(); }  return SlotCnt; }
+  /// Returns the total memory footprint (in bytes) of the pool.
+  ::TSize GetMemUsed() const;
+  /// Frees all slots and chunks.
+  void Clr();
+  /// Swaps the contents of the two pools.
+  void Swap(TSlabPool& Pool);
+  friend class TPt<TSlabPool<TVal> >;
+};
+
+template <class TVal>
+void TSlabPool<TVal>::CopyFrom(const TSlabPool& Pool) {
+  for (int c = 0; c < Classes; c++) {
+    const int64 ChunkVals = int64(1) << (GetChunkBits(c) + GetCapBits(c));
+    ChunkV[c].Gen(Pool.ChunkV[c].Len(), 0);
+    for (int ChunkN = 0; ChunkN < Pool.ChunkV[c].Len(); ChunkN++) {
+      TVal* ValT = new TVal [ChunkVals];
+      for (int64 ValN = 0; ValN < ChunkVals; ValN++) { ValT[ValN] = Pool.ChunkV[c][ChunkN][ValN]; }
+      ChunkV[c].Add(ValT);
+    }
+    Slots[c] = Pool.Slots[c];
+    FreeV[c] = Pool.FreeV[c];
+  }
+}
+
+template <class TVal>
+int64 TSlabPool<TVal>::AddSlot(const int& MnVals) {
+  IAssertR(MnVals <= GetMxCap(), TStr::Fmt("TSlabPool: slot of %d values is too large", MnVals));
+  const int Class = GetClass(MnVals);
+  if (! FreeV[Class].Empty()) {
+    const int64 SlotId = FreeV[Class].Last();
+    FreeV[Class].DelLast();
+    return SlotId;
+  }
+  const int ChunkBits = GetChunkBits(Class);
+  if ((Slots[Class] >> ChunkBits) == ChunkV[Class].Len()) {
+    ChunkV[Class].Add(new TVal [int64(1) << (ChunkBits + GetCapBits(Class))]); }
+  const int64 SlotN = Slots[Class]++;
+  return (SlotN << ClassBits) | Class;
+}
+
+template <class TVal>
+int64 TSlabPool<TVal>::AddV(const TVal* ValT, const int& Vals) {
+  if (Vals == 0) { return -1; }
+  const int64 SlotId = AddSlot(Vals);
+  TVal* SlotValT = GetValVPt(SlotId);
+  for (int ValN = 0; ValN < Vals; ValN++) { SlotValT[ValN] = ValT[ValN]; }
+  return SlotId;
+}
+
+template <class TVal>
+int64 TSlabPool<TVal>::Renew(const int64& SlotId, const int& Vals, const int& MnVals) {
+  if (GetCap(SlotId) >= MnVals) { return SlotId; }
+  const int64 NewSlotId = AddSlot(MnVals);
+  if (Vals > 0) {
+    const TVal* ValT = GetValVPt(SlotId);
+    TVal* NewValT = GetValVPt(NewSlotId);
+    for (int ValN = 0; ValN < Vals; ValN++) { NewValT[ValN] = ValT[ValN]; }
+  }
+  DelSlot(SlotId);
+  return NewSlotId;
+}
+
+template <class TVal>
+::TSize TSlabPool<TVal>::GetMemUsed() const {
+  ::TSize MemUsed = sizeof(TSlabPool);
+  for (int c = 0; c < Classes; c++) {
+    MemUsed += ::TSize(ChunkV[c].Len()) * (::TSize(1) << (GetChunkBits(c) + GetCapBits(c))) * sizeof(TVal);
+    MemUsed += ChunkV[c].Reserved() * sizeof(TVal*) + ::TSize(FreeV[c].Reserved()) * sizeof(TInt64);
+  }
+  return MemUsed;
+}
+
+template <class TVal>
+void TSlabPool<TVal>::Clr() {
+  for (int c = 0; c < Classes; c++) {
+    for (int ChunkN = 0; ChunkN < ChunkV[c].Len(); ChunkN++) { delete [] ChunkV[c][ChunkN]; }
+    ChunkV[c].Clr();  FreeV[c].Clr();  Slots[c] = 0;
+  }
+}
+
+template <class TVal>
+void TSlabPool<TVal>::Swap(TSlabPool& Pool) {
+  for (int c = 0; c < Classes; c++) {
+    ChunkV[c].Swap(Pool.ChunkV[c]);
+    FreeV[c].Swap(Pool.FreeV[c]);
+    const int64 SlotCnt = Slots[c];  Slots[c] = Pool.Slots[c];  Pool.Slots[c] = SlotCnt;
+  }
+}
+
+
 /////////////////////////////////////////////////
 // Below are old 32-bit implementations of TVec and other classes.
 // Old TVec takes at most 2G elements.
@@ -914,14 +914,17 @@ public:
   TNum operator--(int){ TNum oldVal = Val; Val--; return oldVal; } // postfix
   int GetMemUsed() const { return sizeof(TNum); }
 
+  int GetPrimHashCd() const { return int(Val ^ (Val >> 32)); }
+  int GetSecHashCd() const { return int(Val ^ (Val >> 32)) / 0x10; }
+
 #ifdef GLib_WIN
   TStr GetStr() const { return TStr::Fmt("%I64", Val); }
   static TStr GetStr(const TNum& Int){ return TStr::Fmt("%I64", Int.Val); }
   static TStr GetHexStr(const TNum& Int){ return TStr::Fmt("%I64X", Int.Val); }
 #else
-  TStr GetStr() const { return TStr::Fmt("%ll", Val); }
-  static TStr GetStr(const TNum& Int){ return TStr::Fmt("%ll", Int.Val); }
-  static TStr GetHexStr(const TNum& Int){ return TStr::Fmt("%ll", Int.Val); }
+  TStr GetStr() const { return TStr::Fmt("%lld", (long long) Val); }
+  static TStr GetStr(const TNum& Int){ return TStr::Fmt("%lld", (long long) Int.Val); }
+  static TStr GetHexStr(const TNum& Int){ return TStr::Fmt("%llX", (long long) Int.Val); }
 #endif
 
   static TStr GetKiloStr(const int64& Val){
@@ -43,6 +43,10 @@ public:
 };
 #pragma pack(pop)
 
+template<class TKey, class TDat>
+struct TIsRelocatable<THashKeyDat<TKey, TDat> > {
+  enum { Val = TIsRelocatable<TKey>::Val && TIsRelocatable<TDat>::Val }; };
+
 /////////////////////////////////////////////////
 // Hash-Table-Key-Data-Iterator
 template<class TKey, class TDat>
@@ -218,6 +222,8 @@ public:
   TIter EndI() const {return TIter(KeyDatV.EndI(), KeyDatV.EndI());}
   //TIter GetI(const int& KeyId) const {return TIter(&KeyDatV[KeyId], KeyDatV.EndI());}
   TIter GetI(const TKey& Key) const {return TIter(&KeyDatV[GetKeyId(Key)], KeyDatV.EndI());}
+  /// Returns the KeyId of the element the iterator I points to.
+  int GetKeyId(const TIter& I) const {return int(&I() - KeyDatV.BegI());}
 
   void Gen(const int& ExpectVals){
     PortV.Gen(GetNextPrime(ExpectVals/2)); KeyDatV.Gen(ExpectVals, 0);
@@ -292,6 +298,9 @@ public:
   void SortByDat(const bool& Asc=true) { Sort(false, Asc); }
 };
 
+template<class TKey, class TDat, class THashFunc>
+struct TIsRelocatable<THash<TKey, TDat, THashFunc> > { enum { Val = 1 }; };
+
 template<class TKey, class TDat, class THashFunc>
 const unsigned int THash<TKey, TDat, THashFunc>::HashPrimeT[HashPrimes]={
   3ul, 5ul, 11ul, 23ul,
@@ -1003,6 +1003,9 @@ public:
 };
 #pragma pack(pop)
 
+template <class TKey>
+struct TIsRelocatable<THashSetKey<TKey> > { enum { Val = TIsRelocatable<TKey>::Val }; };
+
 /////////////////////////////////////////////////
 // Set-Hash-Key-Iterator
 template <class TKey>
@@ -1180,6 +1183,9 @@ public:
 
 };
 
+template <class TKey, class THashFunc>
+struct TIsRelocatable<THashSet<TKey, THashFunc> > { enum { Val = 1 }; };
+
 template <class TKey, class THashFunc>
 uint THashSet<TKey, THashFunc>::GetNextPrime(const uint& Val) const {
   uint* f=(uint*)TIntH::HashPrimeT, *m, *l=(uint*)TIntH::HashPrimeT + (int)TIntH::HashPrimes;
@@ -482,6 +482,26 @@ bool TSsParser::GetUInt64(const int& FldN, uint64& Val) const {
   return true;
 }
 
+bool TSsParser::GetInt64(const int& FldN, int64& Val) const {
+  // parsing format {ws} [+/-] +{ddd}
+  if (FldN >= Len()) { return false; }
+  int64 _Val = -1;
+  bool Minus=false;
+  const char *c = GetFld(FldN);
+  while (TCh::IsWs(*c)) { c++; }
+  if (*c=='-') { Minus=true; c++; }
+  if (! TCh::IsNum(*c)) { return false; }
+  _Val = TCh::GetNum(*c);  c++;
+  while (TCh::IsNum(*c)){
+    _Val = 10 * _Val + TCh::GetNum(*c);
+    c++;
+  }
+  if (Minus) { _Val = -_Val; }
+  if (*c != 0) { return false; }
+  Val = _Val;
+  return true;
+}
+
 bool TSsParser::GetFlt(const int& FldN, double& Val) const {
   // parsing format {ws} [+/-] +{d} ([.]{d}) ([E|e] [+/-] +{d})
   if (FldN >= Len()) { return false; }
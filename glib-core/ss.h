@@ -135,6 +135,13 @@ public:
   /// Assumes \c FldN is a 64-bit unsigned integer point number its value is returned. If \c FldN is not a 64-bit unsigned integer an exception is thrown.
   uint64 GetUInt64(const int& FldN) const { uint64 Val=0; IAssert(GetUInt64(FldN, Val)); return Val; }
 
+  /// If the field \c FldN is a 64-bit integer its value is returned in \c Val and the function returns \c true.
+  bool GetInt64(const int& FldN, int64& Val) const;
+  /// Checks whether fields \c FldN is a 64-bit integer number.
+  bool IsInt64(const int& FldN) const { int64 v; return GetInt64(FldN, v); }
+  /// Assumes \c FldN is a 64-bit integer its value is returned. If \c FldN is not a 64-bit integer an exception is thrown.
+  int64 GetInt64(const int& FldN) const { int64 Val=0; IAssert(GetInt64(FldN, Val)); return Val; }
+
   const char* DumpStr() const;
 };
 
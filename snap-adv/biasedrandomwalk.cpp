@@ -141,3 +141,77 @@ void SimulateWalk(PWNet& InNet, int64 StartNId, const int& WalkLen, TRnd& Rnd, T
     WalkV.Add(InNet->GetNI(Dst).GetNbrNId(Next));
   }
 }
+
+TRejectionWalker::TRejectionWalker(const PWNet& InNet, const double& _ParamP, const double& _ParamQ) :
+ Net(InNet), ParamP(_ParamP), ParamQ(_ParamQ), MxAlpha(1.0) {
+  MxAlpha = TMath::Mx(1.0/ParamP, 1.0/ParamQ, 1.0);
+  TIntV NIds;
+  int64 Edges = 0;
+  for (TWNet::TNodeI NI = Net->BegNI(); NI < Net->EndNI(); NI++) {
+    NIds.Add(NI.GetId());
+    NIdOffH.AddDat(NI.GetId(), Edges);
+    Edges += NI.GetOutDeg();
+  }
+  AliasKV.Gen(Edges);
+  AliasUV.Gen(Edges);
+  //first order alias tables of edge weights
+#pragma omp parallel for schedule(dynamic,1000)
+  for (int64 i = 0; i < NIds.Len(); i++) {
+    TWNet::TNodeI NI = Net->GetNI(NIds[i]);
+    const int64 Deg = NI.GetOutDeg();
+    if (Deg == 0) { continue; }
+    TFltV PTable(Deg);
+    double Psum = 0;
+    for (int64 j = 0; j < Deg; j++) {
+      PTable[j] = NI.GetOutEDat(j);
+      Psum += PTable[j];
+    }
+    for (int64 j = 0; j < Deg; j++) {
+      PTable[j] /= Psum;
+    }
+    TIntVFltVPr NTTable;
+    NTTable.Val1.Gen(Deg);
+    NTTable.Val2.Gen(Deg);
+    GetNodeAlias(PTable, NTTable);
+    const int64 Off = NIdOffH.GetDat(NIds[i]);
+    for (int64 j = 0; j < Deg; j++) {
+      AliasKV[Off+j] = NTTable.Val1[j];
+      AliasUV[Off+j] = NTTable.Val2[j];
+    }
+  }
+}
+
+void TRejectionWalker::SimulateWalk(const int64& StartNId, const int& WalkLen, TRnd& Rnd, TIntV& WalkV) const {
+  WalkV.Add(StartNId);
+  if (WalkLen == 1) { return; }
+  TWNet::TNodeI SrcI = Net->GetNI(StartNId);
+  if (SrcI.GetOutDeg() == 0) { return; }
+  //the first step is uniform, as in SimulateWalk
+  WalkV.Add(SrcI.GetNbrNId(Rnd.GetUniDevInt(SrcI.GetOutDeg())));
+  while (WalkV.Len() < WalkLen) {
+    TWNet::TNodeI DstI = Net->GetNI(WalkV.Last());
+    const int64 Deg = DstI.GetOutDeg();
+    if (Deg == 0) { return; }
+    const int64 Src = WalkV.LastLast();
+    const int64 Off = NIdOffH.GetDat(DstI.GetId());
+    TWNet::TNodeI SrcNI = Net->GetNI(Src);
+    while (true) {
+      //draw by edge weight, then accept by the second order bias
+      const int64 X = static_cast<int64>(Rnd.GetUniDev()*Deg);
+      const int64 Next = Rnd.GetUniDev() < AliasUV[Off+X] ? X : AliasKV[Off+X].Val;
+      const int64 NextNId = DstI.GetNbrNId(Next);
+      double Alpha;
+      if (NextNId == Src) {
+        Alpha = 1.0/ParamP;
+      } else if (SrcNI.IsOutNId(NextNId)) {
+        Alpha = 1.0;
+      } else {
+        Alpha = 1.0/ParamQ;
+      }
+      if (Alpha >= MxAlpha || Rnd.GetUniDev()*MxAlpha < Alpha) {
+        WalkV.Add(NextNId);
+        break;
+      }
+    }
+  }
+}
@@ -13,4 +13,26 @@ void SimulateWalk(PWNet& InNet, int64 StartNId, const int& WalkLen, TRnd& Rnd, T
 //Predicts approximate memory required for preprocessing the graph
 int64 PredictMemoryRequirements(PWNet& InNet);
 
+///Node2vec walks by rejection sampling, without per (t, v) alias tables
+///Keeps only a first order alias table of edge weights for every node, O(m) memory.
+///A second order step from v (previous node t) draws x by the edge weight and accepts it with
+///probability alpha(t,x)/max(alpha), alpha being 1/p (x==t), 1 (x neighbor of t) or 1/q (otherwise),
+///so walks follow the same distribution as with PreprocessTransitionProbs and SimulateWalk.
+///See: K. Yang et al., KnightKing: A Fast Distributed Graph Random Walk Engine, SOSP 2019
+class TRejectionWalker {
+private:
+  PWNet Net;
+  TFlt ParamP, ParamQ;
+  TFlt MxAlpha;                  //largest of 1/p, 1 and 1/q
+  THash<TInt, TInt64> NIdOffH;   //node id -> position of the node's alias table in AliasKV, AliasUV
+  TVec<TInt, int64> AliasKV;
+  TVec<TFlt, int64> AliasUV;
+public:
+  TRejectionWalker(const PWNet& InNet, const double& _ParamP, const double& _ParamQ);
+  ///Simulates one walk and writes it into WalkV, safe to call from several threads with different Rnd
+  void SimulateWalk(const int64& StartNId, const int& WalkLen, TRnd& Rnd, TIntV& WalkV) const;
+  ///Returns the memory used by the alias tables
+  int64 GetMemUsed() const { return AliasKV.Len()*(sizeof(TInt)+sizeof(TFlt)) + NIdOffH.GetMemUsed(); }
+};
+
 #endif //RAND_WALK_H
@@ -1,6 +1,46 @@
 #include "stdafx.h"
 #include "cliques.h"
 
+// Searches whose candidate and excluded sets hold at most this many nodes use bitsets.
+static const int CliqueBitsMxNodes = 1024;
+
+static int GetCliqueThreads() {
+#ifdef USE_OPENMP
+  return omp_get_max_threads();
+#else
+  return 1;
+#endif
+}
+
+static int GetCliqueThreadN() {
+#ifdef USE_OPENMP
+  return omp_get_thread_num();
+#else
+  return 0;
+#endif
+}
+
+static int GetBitCnt(uint64 Word) {
+#ifdef __GNUC__
+  return __builtin_popcountll(Word);
+#else
+  int Cnt = 0;
+  for (; Word != 0; Word &= Word - 1) { Cnt++; }
+  return Cnt;
+#endif
+}
+
+// Returns the position of the lowest set bit of a non-zero word.
+static int GetLowBit(uint64 Word) {
+#ifdef __GNUC__
+  return __builtin_ctzll(Word);
+#else
+  int Bit = 0;
+  while ((Word & 1) == 0) { Word >>= 1;  Bit++; }
+  return Bit;
+#endif
+}
+
 /////////////////////////////////////////////////
 // TCommunity implementation
 void TCliqueOverlap::GetRelativeComplement(const THashSet<TInt>& A, const THashSet<TInt>& B, THashSet<TInt>& Complement) {
@@ -124,53 +164,105 @@ void TCliqueOverlap::GetMaximalCliques(const PUNGraph& G, int MinMaxCliqueSize,
 	Expand(SUBG, CAND);
 }
 
+// Returns the ids of the cliques on at least MinLen nodes that contain node NId in NodeCliquesV[NIdxH.GetDat(NId)], in increasing order.
+static void GetNodeCliques(const TVec<TIntV>& MaxCliques, const int& MinLen, TIntH& NIdxH, TVec<TIntV>& NodeCliquesV) {
+  NIdxH.Clr();  NodeCliquesV.Clr();
+  for (int i = 0; i < MaxCliques.Len(); i++) {
+    if (MaxCliques[i].Len() < MinLen) { continue; }
+    for (int j = 0; j < MaxCliques[i].Len(); j++) {
+      const int KeyId = NIdxH.AddKey(MaxCliques[i][j]);
+      if (KeyId == NodeCliquesV.Len()) { NodeCliquesV.Add(); }
+      NodeCliquesV[KeyId].Add(i);
+    }
+  }
+}
+
+// Clique overlaps are counted through the cliques of every node, so only pairs of cliques that share nodes are visited.
 void TCliqueOverlap::CalculateOverlapMtx(const TVec<TIntV>& MaxCliques, int MinNodeOverlap, TVec<TIntV>& OverlapMtx) {
-	OverlapMtx.Clr();
-	//
-	int n = MaxCliques.Len();
-	//Convert max cliques to HashSets
-		TVec<THashSet<TInt> > cliques;
-	for (int i=0; i<n; i++) {
-		const int len = MaxCliques[i].Len();
-    cliques.Add();
-    if (len < MinNodeOverlap) { continue; }
-		THashSet<TInt>& set = cliques.Last();  set.Gen(len);
-    for (int j=0; j<len; j++) { set.AddKey(MaxCliques[i][j]); }
-	}
-	//Init clique clique overlap matrix
-	n = cliques.Len();
-	OverlapMtx.Gen(n);
-	for (int i=0; i<n; i++) OverlapMtx[i].Gen(n);
-	//Calculate clique clique overlap matrix
-  for (int i=0; i<n; i++) {
-    OverlapMtx[i][i] = cliques[i].Len();
-    for (int j=i+1; j<n; j++) {
-      OverlapMtx[i][j] = Intersection(cliques[i], cliques[j]); }
+  const int n = MaxCliques.Len();
+  TIntH NIdxH;
+  TVec<TIntV> NodeCliquesV;
+  GetNodeCliques(MaxCliques, MinNodeOverlap, NIdxH, NodeCliquesV);
+  //Init and calculate clique clique overlap matrix
+  OverlapMtx.Clr();
+  OverlapMtx.Gen(n);
+  #pragma omp parallel for schedule(dynamic,100)
+  for (int i = 0; i < n; i++) {
+    TIntV& OverlapV = OverlapMtx[i];
+    OverlapV.Gen(n);
+    if (MaxCliques[i].Len() < MinNodeOverlap) { continue; }
+    OverlapV[i] = MaxCliques[i].Len();
+    for (int k = 0; k < MaxCliques[i].Len(); k++) {
+      const TIntV& CliqueIdV = NodeCliquesV[NIdxH.GetKeyId(MaxCliques[i][k])];
+      for (int c = CliqueIdV.Len() - 1; c >= 0 && CliqueIdV[c] > i; c--) { OverlapV[CliqueIdV[c]]++; }
+    }
   }
 }
 
+// A clique sharing at least MinNodeOverlap nodes with clique i contains one of the
+// Len-MinNodeOverlap+1 nodes of i that are in the fewest cliques, so only the cliques
+// of these nodes are candidates. Candidates are checked by merging the sorted cliques.
 PUNGraph TCliqueOverlap::CalculateOverlapMtx(const TVec<TIntV>& MaxCliques, int MinNodeOverlap) {
-	const int n = MaxCliques.Len();
-  //Convert max cliques to HashSets
-	TVec<THashSet<TInt> > cliques;
-	for (int i=0; i<n; i++) {
-		const int len = MaxCliques[i].Len();
-    cliques.Add();
-    if (len < MinNodeOverlap) { continue; }
-		THashSet<TInt>& set = cliques.Last();  set.Gen(len);
-    for (int j=0; j<len; j++) { set.AddKey(MaxCliques[i][j]); }
-	}
-	//Init clique clique overlap matrix
-	PUNGraph OverlapMtx = TUNGraph::New();
-  for (int i=0; i < n; i++) {
+  const int n = MaxCliques.Len();
+  //Init clique clique overlap matrix
+  PUNGraph OverlapMtx = TUNGraph::New();
+  for (int i = 0; i < n; i++) {
     OverlapMtx->AddNode(i); }
-	//Calculate clique clique overlap matrix
-  for (int i=0; i<n; i++) {
-    for (int j=i+1; j<n; j++) {
-      if (Intersection(cliques[i], cliques[j]) >= MinNodeOverlap) {
-        OverlapMtx->AddEdge(i,j); }
+  if (MinNodeOverlap <= 0) { // every pair of cliques overlaps
+    for (int i = 0; i < n; i++) {
+      for (int j = i+1; j < n; j++) { OverlapMtx->AddEdge(i, j); } }
+    return OverlapMtx;
+  }
+  TIntH NIdxH;
+  TVec<TIntV> NodeCliquesV;
+  GetNodeCliques(MaxCliques, MinNodeOverlap, NIdxH, NodeCliquesV);
+  // cliques as sorted vectors of node indices
+  TVec<TIntV> CliqueNIdxVV(n);
+  #pragma omp parallel for schedule(dynamic,1000)
+  for (int i = 0; i < n; i++) {
+    if (MaxCliques[i].Len() < MinNodeOverlap) { continue; }
+    TIntV& NIdxV = CliqueNIdxVV[i];
+    NIdxV.Gen(MaxCliques[i].Len(), 0);
+    for (int k = 0; k < MaxCliques[i].Len(); k++) { NIdxV.Add(NIdxH.GetKeyId(MaxCliques[i][k])); }
+    NIdxV.Sort();
+  }
+  //Calculate clique clique overlaps, every thread collects its edges
+  TVec<TIntPrV> EdgeVV(GetCliqueThreads());
+  #pragma omp parallel
+  {
+    TIntPrV& EdgeV = EdgeVV[GetCliqueThreadN()];
+    TIntV SeenV(n), TouchedV;
+    TIntPrV NodeCntV;
+    #pragma omp for schedule(dynamic,100)
+    for (int i = 0; i < n; i++) {
+      const TIntV& NIdxV = CliqueNIdxVV[i];
+      if (NIdxV.Empty()) { continue; }
+      NodeCntV.Clr(false);
+      for (int k = 0; k < NIdxV.Len(); k++) { NodeCntV.Add(TIntPr(NodeCliquesV[NIdxV[k]].Len(), NIdxV[k])); }
+      NodeCntV.Sort();
+      for (int k = 0; k < NIdxV.Len() - MinNodeOverlap + 1; k++) {
+        const TIntV& CliqueIdV = NodeCliquesV[NodeCntV[k].Val2];
+        for (int c = CliqueIdV.Len() - 1; c >= 0 && CliqueIdV[c] > i; c--) {
+          const int j = CliqueIdV[c];
+          if (SeenV[j] != 0) { continue; }
+          SeenV[j] = 1;  TouchedV.Add(j);
+          if (NIdxV.IntrsLen(CliqueNIdxVV[j]) >= MinNodeOverlap) { EdgeV.Add(TIntPr(i, j)); }
+        }
+      }
+      for (int t = 0; t < TouchedV.Len(); t++) { SeenV[TouchedV[t]] = 0; }
+      TouchedV.Clr(false);
     }
   }
+  // every pair is found once, so edges are appended unchecked and the adjacency sorted at the end
+  TIntV DegV(n);
+  for (int t = 0; t < EdgeVV.Len(); t++) {
+    for (int e = 0; e < EdgeVV[t].Len(); e++) { DegV[EdgeVV[t][e].Val1]++;  DegV[EdgeVV[t][e].Val2]++; } }
+  for (int i = 0; i < n; i++) { OverlapMtx->ReserveNIdDeg(i, DegV[i]); }
+  for (int t = 0; t < EdgeVV.Len(); t++) {
+    for (int e = 0; e < EdgeVV[t].Len(); e++) { OverlapMtx->AddEdgeUnchecked(EdgeVV[t][e].Val1, EdgeVV[t][e].Val2); }
+    EdgeVV[t].Clr();
+  }
+  OverlapMtx->SortNodeAdjV();
   return OverlapMtx;
 }
 
@@ -215,9 +307,8 @@ void TCliqueOverlap::GetOverlapCliques(const TVec<TIntV>& OverlapMtx, const TVec
 
 /// Enumerate maximal cliques of the network on more than MinMaxCliqueSize nodes
 void TCliqueOverlap::GetMaxCliques(const PUNGraph& G, int MinMaxCliqueSize, TVec<TIntV>& MaxCliques) {
-  TCliqueOverlap CO;
-  MaxCliques.Clr(false);
-  CO.GetMaximalCliques(G, MinMaxCliqueSize, MaxCliques);
+  TMaxCliqueEnum CliqueEnum(G);
+  CliqueEnum.GetMaxCliques(MinMaxCliqueSize, MaxCliques);
 }
 
 /// Clique Percolation method communities
@@ -249,3 +340,288 @@ void TCliqueOverlap::GetCPMCommunities(const PUNGraph& G, int MinMaxCliqueSize,
   }
   printf("done [%s].\n", ExeTm.GetStr());
 }
+
+/////////////////////////////////////////////////
+// Maximal clique enumeration
+// Collects the cliques into one vector per thread.
+class TCliqueCollector : public TCliqueVisitor {
+public:
+  TVec<TVec<TIntV> > CliquesVV;
+  TCliqueCollector() : CliquesVV(GetCliqueThreads()) { }
+  void OnClique(const TIntV& NIdV) { CliquesVV[GetCliqueThreadN()].Add(NIdV); }
+};
+
+// Returns the number of elements of the sorted vector ValV in the sorted range [BegN, EndN).
+static int GetIntrsLen(const TIntV& ValV, const TInt* BegN, const TInt* EndN) {
+  int Cnt = 0;
+  for (int i = 0; i < ValV.Len() && BegN < EndN; ) {
+    if (ValV[i] < *BegN) { i++; }
+    else if (*BegN < ValV[i]) { BegN++; }
+    else { Cnt++;  i++;  BegN++; }
+  }
+  return Cnt;
+}
+
+// Returns the elements of the sorted vector ValV in the sorted range [BegN, EndN) in DstValV.
+static void GetIntrs(const TIntV& ValV, const TInt* BegN, const TInt* EndN, TIntV& DstValV) {
+  DstValV.Clr(false);
+  for (int i = 0; i < ValV.Len() && BegN < EndN; ) {
+    if (ValV[i] < *BegN) { i++; }
+    else if (*BegN < ValV[i]) { BegN++; }
+    else { DstValV.Add(ValV[i]);  i++;  BegN++; }
+  }
+}
+
+// State of the searches run by one thread. Sets of nodes are sorted vectors of
+// ranks, or bitsets over LocalV once they are small enough.
+class TMaxCliqueEnum::TSearch {
+private:
+  const TMaxCliqueEnum& Enum;
+  TCliqueVisitor& Visitor;
+  const int MinSize;
+  TIntV CliqueV;         // ranks of the nodes of the current clique
+  TIntV CliqueNIdV;
+  TIntV LocalV;          // rank of the i-th node of the bitset neighborhood
+  TIntV RankToLocalV;    // position in LocalV by rank, -1 if not in the neighborhood
+  int Words;             // 64 bit words per bitset
+  TVec<uint64> AdjV;     // row i holds the neighbors of LocalV[i] in the neighborhood
+  TVec<uint64> SetV;     // candidate and excluded bitsets of every recursion level
+private:
+  const TInt* BegNbr(const int& Rank) const { return Enum.NbrV.BegI() + Enum.OffV[Rank]; }
+  const TInt* EndNbr(const int& Rank) const { return Enum.NbrV.BegI() + Enum.OffV[Rank+1]; }
+  void ReportClique();
+  void ExpandVec(TIntV& CandV, TIntV& ExclV);
+  void InitBits(const TIntV& CandV, const TIntV& ExclV);
+  void ExpandBits(const int& Lev);
+public:
+  TSearch(const TMaxCliqueEnum& _Enum, TCliqueVisitor& _Visitor, const int& _MinSize) :
+    Enum(_Enum), Visitor(_Visitor), MinSize(_MinSize), CliqueV(), CliqueNIdV(), LocalV(),
+    RankToLocalV(_Enum.NIdV.Len()), Words(0), AdjV(), SetV() { RankToLocalV.PutAll(-1); }
+  /// Enumerates the maximal cliques whose earliest node has rank Rank.
+  void Expand(const int& Rank);
+};
+
+void TMaxCliqueEnum::TSearch::ReportClique() {
+  CliqueNIdV.Gen(CliqueV.Len(), 0);
+  for (int i = 0; i < CliqueV.Len(); i++) { CliqueNIdV.Add(Enum.NIdV[CliqueV[i]]); }
+  Visitor.OnClique(CliqueNIdV);
+}
+
+void TMaxCliqueEnum::TSearch::Expand(const int& Rank) {
+  TIntV CandV, ExclV;
+  for (const TInt* N = BegNbr(Rank); N < EndNbr(Rank); N++) {
+    if (*N > Rank) { CandV.Add(*N); } else { ExclV.Add(*N); }
+  }
+  if (1 + CandV.Len() < MinSize) { return; }
+  CliqueV.Gen(Enum.Degeneracy + 1, 0);
+  CliqueV.Add(Rank);
+  ExpandVec(CandV, ExclV);
+}
+
+// Bron-Kerbosch step on sorted vectors, used while the sets are large.
+void TMaxCliqueEnum::TSearch::ExpandVec(TIntV& CandV, TIntV& ExclV) {
+  if (CandV.Empty()) {
+    if (ExclV.Empty() && CliqueV.Len() >= MinSize) { ReportClique(); }
+    return;
+  }
+  if (CliqueV.Len() + CandV.Len() < MinSize) { return; }
+  if (CandV.Len() + ExclV.Len() <= CliqueBitsMxNodes) {
+    InitBits(CandV, ExclV);
+    ExpandBits(0);
+    return;
+  }
+  // pivot on the node with the most neighbors among the candidates
+  int Pivot = -1, PivotCnt = -1;
+  for (int s = 0; s < 2; s++) {
+    const TIntV& NodeV = s == 0 ? CandV : ExclV;
+    for (int i = 0; i < NodeV.Len(); i++) {
+      const int Cnt = GetIntrsLen(CandV, BegNbr(NodeV[i]), EndNbr(NodeV[i]));
+      if (Cnt > PivotCnt) { PivotCnt = Cnt;  Pivot = NodeV[i]; }
+    }
+  }
+  TIntV BranchV;
+  const TInt* N = BegNbr(Pivot);
+  for (int i = 0; i < CandV.Len(); i++) {
+    while (N < EndNbr(Pivot) && *N < CandV[i]) { N++; }
+    if (N == EndNbr(Pivot) || *N != CandV[i]) { BranchV.Add(CandV[i]); }
+  }
+  TIntV NewCandV, NewExclV;
+  for (int b = 0; b < BranchV.Len(); b++) {
+    const int V = BranchV[b];
+    GetIntrs(CandV, BegNbr(V), EndNbr(V), NewCandV);
+    GetIntrs(ExclV, BegNbr(V), EndNbr(V), NewExclV);
+    CliqueV.Add(V);
+    ExpandVec(NewCandV, NewExclV);
+    CliqueV.DelLast();
+    CandV.Del(CandV.SearchBin(V));
+    ExclV.AddSorted(V);
+  }
+}
+
+// Relabels the candidate and excluded nodes to 0..L-1 and builds their adjacency bitsets.
+void TMaxCliqueEnum::TSearch::InitBits(const TIntV& CandV, const TIntV& ExclV) {
+  LocalV = CandV;
+  LocalV.AddV(ExclV);
+  const int Len = LocalV.Len();
+  Words = (Len + 63) / 64;
+  for (int i = 0; i < Len; i++) { RankToLocalV[LocalV[i]] = i; }
+  AdjV.Gen(Len * Words);
+  AdjV.PutAll(0);
+  for (int i = 0; i < Len; i++) {
+    uint64* Row = AdjV.BegI() + i * Words;
+    const TInt* BegN = BegNbr(LocalV[i]);
+    const TInt* EndN = EndNbr(LocalV[i]);
+    if (EndN - BegN <= 8 * Len) {
+      for (const TInt* N = BegN; N < EndN; N++) {
+        const int j = RankToLocalV[*N];
+        if (j != -1) { Row[j / 64] |= uint64(1) << (j % 64); }
+      }
+    } else { // high degree node, look up the neighborhood in its neighbors
+      for (int j = 0; j < Len; j++) {
+        const TInt* LoN = BegN;
+        for (int Cnt = int(EndN - BegN); Cnt > 0; ) { // first neighbor not below LocalV[j]
+          const int Half = Cnt / 2;
+          if (LoN[Half] < LocalV[j]) { LoN += Half + 1;  Cnt -= Half + 1; } else { Cnt = Half; }
+        }
+        if (LoN < EndN && *LoN == LocalV[j]) { Row[j / 64] |= uint64(1) << (j % 64); }
+      }
+    }
+  }
+  for (int i = 0; i < Len; i++) { RankToLocalV[LocalV[i]] = -1; }
+  // level 0 holds the candidates CandV and the excluded nodes ExclV
+  SetV.Gen((CandV.Len() + 2) * 2 * Words);
+  SetV.PutAll(0);
+  for (int i = 0; i < Len; i++) {
+    SetV[(i < CandV.Len() ? 0 : Words) + i / 64] |= uint64(1) << (i % 64); }
+}
+
+// Bron-Kerbosch step on the bitsets of level Lev, which writes its children to level Lev+1.
+void TMaxCliqueEnum::TSearch::ExpandBits(const int& Lev) {
+  uint64* Cand = SetV.BegI() + Lev * 2 * Words;
+  uint64* Excl = Cand + Words;
+  int CandCnt = 0;
+  bool ExclEmpty = true;
+  for (int w = 0; w < Words; w++) {
+    CandCnt += GetBitCnt(Cand[w]);
+    ExclEmpty = ExclEmpty && Excl[w] == 0;
+  }
+  if (CandCnt == 0) {
+    if (ExclEmpty && CliqueV.Len() >= MinSize) { ReportClique(); }
+    return;
+  }
+  if (CliqueV.Len() + CandCnt < MinSize) { return; }
+  // pivot on the node with the most neighbors among the candidates
+  int Pivot = -1, PivotCnt = -1;
+  for (int w = 0; w < Words; w++) {
+    for (uint64 Bits = Cand[w] | Excl[w]; Bits != 0; Bits &= Bits - 1) {
+      const int U = w * 64 + GetLowBit(Bits);
+      const uint64* Row = AdjV.BegI() + U * Words;
+      int Cnt = 0;
+      for (int k = 0; k < Words; k++) { Cnt += GetBitCnt(Cand[k] & Row[k]); }
+      if (Cnt > PivotCnt) { PivotCnt = Cnt;  Pivot = U; }
+    }
+  }
+  const uint64* PivotRow = AdjV.BegI() + Pivot * Words;
+  uint64* NewCand = Excl + Words;
+  uint64* NewExcl = NewCand + Words;
+  for (int w = 0; w < Words; w++) {
+    for (uint64 Bits = Cand[w] & ~PivotRow[w]; Bits != 0; Bits &= Bits - 1) {
+      const int V = w * 64 + GetLowBit(Bits);
+      const uint64 VBit = uint64(1) << (V % 64);
+      const uint64* Row = AdjV.BegI() + V * Words;
+      for (int k = 0; k < Words; k++) {
+        NewCand[k] = Cand[k] & Row[k];
+        NewExcl[k] = Excl[k] & Row[k];
+      }
+      CliqueV.Add(LocalV[V]);
+      ExpandBits(Lev + 1);
+      CliqueV.DelLast();
+      Cand[w] &= ~VBit;
+      Excl[w] |= VBit;
+    }
+  }
+}
+
+TMaxCliqueEnum::TMaxCliqueEnum(const PUNGraph& G) : NIdV(), OffV(), NbrV(), Degeneracy(0) {
+  const int Nodes = G->GetNodes();
+  TIntV NIdxV(G->GetMxNId());  // node index by node id, nodes are indexed in iteration order
+  TIntV IdxNIdV(Nodes, 0);
+  TIntV DegV(Nodes, 0);
+  int MxDeg = 0;
+  for (TUNGraph::TNodeI NI = G->BegNI(); NI < G->EndNI(); NI++) {
+    NIdxV[NI.GetId()] = IdxNIdV.Add(NI.GetId());
+    DegV.Add(NI.GetDeg() - (NI.IsNbrNId(NI.GetId()) ? 1 : 0));
+    MxDeg = TMath::Mx(MxDeg, DegV.Last().Val);
+  }
+  // smallest-last order with degree buckets, V. Batagelj, M. Zaversnik, An O(m) algorithm for cores decomposition of networks, 2003
+  TIntV BinV(MxDeg + 1), PosV(Nodes), VertV(Nodes);
+  BinV.PutAll(0);
+  for (int i = 0; i < Nodes; i++) { BinV[DegV[i]]++; }
+  for (int d = 0, Start = 0; d <= MxDeg; d++) {
+    const int Cnt = BinV[d];  BinV[d] = Start;  Start += Cnt; }
+  for (int i = 0; i < Nodes; i++) {
+    PosV[i] = BinV[DegV[i]];  VertV[PosV[i]] = i;  BinV[DegV[i]]++; }
+  for (int d = MxDeg; d > 0; d--) { BinV[d] = BinV[d-1]; }
+  BinV[0] = 0;
+  int MxCore = 0;
+  for (int k = 0; k < Nodes; k++) {
+    const int V = VertV[k];
+    MxCore = TMath::Mx(MxCore, DegV[V].Val);
+    const TUNGraph::TNodeI NI = G->GetNI(IdxNIdV[V]);
+    for (int e = 0; e < NI.GetDeg(); e++) {
+      const int U = NIdxV[NI.GetNbrNId(e)];
+      if (DegV[U] > DegV[V]) { // move U to the front of its bucket, then one bucket down
+        const int DegU = DegV[U], PosU = PosV[U];
+        const int PosW = BinV[DegU], W = VertV[PosW];
+        if (U != W) { PosV[U] = PosW;  VertV[PosU] = W;  PosV[W] = PosU;  VertV[PosW] = U; }
+        BinV[DegU]++;
+        DegV[U]--;
+      }
+    }
+  }
+  Degeneracy = MxCore;
+  // adjacency in rank space, the rank of a node is its position in VertV
+  NIdV.Gen(Nodes);
+  for (int k = 0; k < Nodes; k++) { NIdV[k] = IdxNIdV[VertV[k]]; }
+  OffV.Gen(Nodes + 1);
+  OffV[0] = 0;
+  for (int k = 0; k < Nodes; k++) {
+    const TUNGraph::TNodeI NI = G->GetNI(NIdV[k]);
+    OffV[k+1] = OffV[k] + NI.GetDeg() - (NI.IsNbrNId(NI.GetId()) ? 1 : 0);
+  }
+  // appending every rank to the lists of its neighbors in increasing order keeps the lists sorted
+  NbrV.Gen(OffV[Nodes]);
+  TIntV EndV(OffV);
+  for (int k = 0; k < Nodes; k++) {
+    const TUNGraph::TNodeI NI = G->GetNI(NIdV[k]);
+    for (int e = 0; e < NI.GetDeg(); e++) {
+      if (NI.GetNbrNId(e) == NI.GetId()) { continue; }
+      const int Nbr = PosV[NIdxV[NI.GetNbrNId(e)]];
+      NbrV[EndV[Nbr]] = k;
+      EndV[Nbr]++;
+    }
+  }
+}
+
+void TMaxCliqueEnum::GetMaxCliques(const int& MinSize, TCliqueVisitor& Visitor) const {
+  const int Nodes = NIdV.Len();
+  #pragma omp parallel
+  {
+    TSearch Search(*this, Visitor, MinSize);
+    // nodes of the densest cores come last and have the largest searches, start with them
+    #pragma omp for schedule(dynamic,1)
+    for (int k = 0; k < Nodes; k++) { Search.Expand(Nodes - 1 - k); }
+  }
+}
+
+void TMaxCliqueEnum::GetMaxCliques(const int& MinSize, TVec<TIntV>& MaxCliques) const {
+  TCliqueCollector Collector;
+  GetMaxCliques(MinSize, Collector);
+  int Cliques = 0;
+  for (int t = 0; t < Collector.CliquesVV.Len(); t++) { Cliques += Collector.CliquesVV[t].Len(); }
+  MaxCliques.Gen(Cliques, 0);
+  for (int t = 0; t < Collector.CliquesVV.Len(); t++) {
+    MaxCliques.AddV(Collector.CliquesVV[t]);
+    Collector.CliquesVV[t].Clr();
+  }
+}
@@ -21,17 +21,60 @@ public:
 	static void GetRelativeComplement(const THashSet<TInt>& A, const THashSet<TInt>& B, THashSet<TInt>& Complement);
 	static void GetIntersection(const THashSet<TInt>& A, const THashSet<TInt>& B, THashSet<TInt>& C);
 	static int Intersection(const THashSet<TInt>& A, const THashSet<TInt>& B);
+  /// Overlaps of all pairs of cliques on at least MinNodeOverlap nodes, computed in parallel; only the upper triangle is filled
   static void CalculateOverlapMtx(const TVec<TIntV>& MaxCliques, int MinNodeOverlap, TVec<TIntV>& OverlapMtx);
+  /// Graph on clique ids with an edge between cliques sharing at least MinNodeOverlap nodes, computed in parallel
   static PUNGraph CalculateOverlapMtx(const TVec<TIntV>& MaxCliques, int MinNodeOverlap);
 	static void GetOverlapCliques(const TVec<TIntV>& OverlapMtx, int MinNodeOverlap, TVec<TIntV>& CliqueIdVV);
 	static void GetOverlapCliques(const TVec<TIntV>& OverlapMtx, const TVec<TIntV>& MaxCliques, double MinOverlapFrac, TVec<TIntV>& CliqueIdVV);
 public:
   TCliqueOverlap() : m_G(), m_Q(), m_maxCliques(NULL), m_minMaxCliqueSize(3) { }
 	void GetMaximalCliques(const PUNGraph& G, int MinMaxCliqueSize, TVec<TIntV>& MaxCliques);
-  /// Enumerate maximal cliques of the network on more than MinMaxCliqueSize nodes
+  /// Enumerate maximal cliques of the network on at least MinMaxCliqueSize nodes, in parallel with TMaxCliqueEnum
   static void GetMaxCliques(const PUNGraph& G, int MinMaxCliqueSize, TVec<TIntV>& MaxCliques);
   /// Clique Percolation method communities
   static void GetCPMCommunities(const PUNGraph& G, int MinMaxCliqueSize, TVec<TIntV>& Communities);
 };
 
+/////////////////////////////////////////////////
+// Maximal clique enumeration
+
+/// Receives the maximal cliques found by TMaxCliqueEnum. ##TCliqueVisitor
+/// With OpenMP, OnClique() is called concurrently from all threads of the search.
+class TCliqueVisitor {
+public:
+  virtual ~TCliqueVisitor() { }
+  /// Called once for every maximal clique, NIdV holds the node ids of the clique.
+  virtual void OnClique(const TIntV& NIdV) = 0;
+};
+
+/// Parallel maximal clique enumeration. ##TMaxCliqueEnum
+/// Nodes are ranked in degeneracy order (repeatedly removing a node of minimum
+/// degree) and a Bron-Kerbosch search with Tomita pivoting is started from every
+/// node v, with the later neighbors of v as candidates and the earlier ones as
+/// excluded nodes. Every maximal clique is thus found once, from its earliest
+/// node, and the searches of different start nodes run in parallel. Once the
+/// candidate and excluded sets of a search are small, they are relabeled and
+/// stored as bitsets over that neighborhood.
+/// See: D. Eppstein, M. Loffler, D. Strash, Listing all maximal cliques in sparse
+/// graphs in near-optimal time, ISAAC 2010.
+class TMaxCliqueEnum {
+private:
+  class TSearch;
+  TIntV NIdV;       // node id by rank in the degeneracy order
+  TIntV OffV;       // neighbors of rank r are NbrV[OffV[r]..OffV[r+1]), as increasing ranks
+  TIntV NbrV;
+  TInt Degeneracy;
+public:
+  /// Ranks the nodes of G, self-loops are ignored.
+  TMaxCliqueEnum(const PUNGraph& G);
+  int GetNodes() const { return NIdV.Len(); }
+  /// Returns the degeneracy of the graph, an upper bound on the candidates of a search.
+  int GetDegeneracy() const { return Degeneracy; }
+  /// Calls Visitor.OnClique() for every maximal clique on at least MinSize nodes.
+  void GetMaxCliques(const int& MinSize, TCliqueVisitor& Visitor) const;
+  /// Returns all maximal cliques on at least MinSize nodes, in no particular order.
+  void GetMaxCliques(const int& MinSize, TVec<TIntV>& MaxCliques) const;
+};
+
 #endif
@@ -455,6 +455,249 @@ PNGraph TKronMtx::GenFastKronecker(const TKronMtx& SeedMtx, const int& NIter, co
   return Graph;
 }
 
+/////////////////////////////////////////////////
+// Parallel fast Kronecker generation
+
+// edges drawn by one chunk, every chunk has its own random generator
+static const int KronChunkDraws = 1<<16;
+
+static int64 FetchAddMP(TInt64& Cnt, const int64& Val) {
+#ifdef USE_OPENMP
+  return __sync_fetch_and_add(&Cnt.Val, Val);
+#else
+  const int64 Old = Cnt;  Cnt += Val;
+  return Old;
+#endif
+}
+
+// seed of the random generator of chunk ChunkN (splitmix64 of the base seed and the chunk number)
+static int GetKronChunkSeed(const int& BaseSeed, const int64& ChunkN) {
+  uint64 Key = (uint64(uint(BaseSeed)) << 32) + uint64(ChunkN) + 0x9E3779B97F4A7C15ULL;
+  Key = (Key ^ (Key >> 30)) * 0xBF58476D1CE4E5B9ULL;
+  Key = (Key ^ (Key >> 27)) * 0x94D049BB133111EBULL;
+  Key = Key ^ (Key >> 31);
+  return 1 + int(Key % uint64(TInt::Mx - 1));
+}
+
+// RMat like recursive descent over the cells of the seed matrix
+class TKronEdgeDraw {
+private:
+  TVec<TFltIntIntTr> ProbToRCPosV; // cumulative cell probability, row, col position
+  TIntV RngV;                      // node range of the cell at each level
+  bool IsDir;
+public:
+  TKronEdgeDraw(const TKronMtx& SeedMtx, const int& NIter, const bool& _IsDir) : ProbToRCPosV(), RngV(NIter, 0), IsDir(_IsDir) {
+    const int MtxDim = SeedMtx.GetDim();
+    const double MtxSum = SeedMtx.GetMtxSum();
+    for (int Rng = SeedMtx.GetNodes(NIter) / MtxDim; RngV.Len() < NIter; Rng /= MtxDim) { RngV.Add(Rng); }
+    double CumProb = 0.0;
+    for (int r = 0; r < MtxDim; r++) {
+      for (int c = 0; c < MtxDim; c++) {
+        const double Prob = SeedMtx.At(r, c);
+        if (Prob > 0.0) {
+          CumProb += Prob;
+          ProbToRCPosV.Add(TFltIntIntTr(CumProb/MtxSum, r, c));
+        }
+      }
+    }
+    IAssert(! ProbToRCPosV.Empty());
+  }
+  // undirected edges are returned as node pairs with Row <= Col
+  void Draw(TRnd& Rnd, int& Row, int& Col) const {
+    const int LastCell = ProbToRCPosV.Len() - 1;
+    Row = 0;  Col = 0;
+    for (int iter = 0; iter < RngV.Len(); iter++) {
+      const double Prob = Rnd.GetUniDev();
+      int n = 0;  while (n < LastCell && Prob > ProbToRCPosV[n].Val1) { n++; }
+      Row += ProbToRCPosV[n].Val2 * RngV[iter];
+      Col += ProbToRCPosV[n].Val3 * RngV[iter];
+    }
+    if (! IsDir && Row > Col) { const int Tmp = Row;  Row = Col;  Col = Tmp; }
+  }
+};
+
+static void SiftKronRow(TInt* V, int64 Root, const int64& Len) {
+  const int Val = V[Root];
+  for (int64 Child = 2*Root+1; Child < Len; Child = 2*Root+1) {
+    if (Child+1 < Len && V[Child] < V[Child+1]) { Child++; }
+    if (V[Child] <= Val) { break; }
+    V[Root] = V[Child];  Root = Child;
+  }
+  V[Root] = Val;
+}
+
+// sorts a row in place (TVec::Sort draws pivots from the shared TInt::Rnd and can not run in threads)
+static void SortKronRow(TInt* Beg, TInt* End) {
+  const int64 Len = End - Beg;
+  if (Len < 32) {
+    for (int64 i = 1; i < Len; i++) {
+      const int Val = Beg[i];
+      int64 j = i;
+      for (; j > 0 && Beg[j-1] > Val; j--) { Beg[j] = Beg[j-1]; }
+      Beg[j] = Val;
+    }
+    return;
+  }
+  for (int64 i = Len/2 - 1; i >= 0; i--) { SiftKronRow(Beg, i, Len); }
+  for (int64 i = Len - 1; i > 0; i--) {
+    const int Val = Beg[i];  Beg[i] = Beg[0];  Beg[0] = Val;
+    SiftKronRow(Beg, 0, i);
+  }
+}
+
+// merges sorted rows without duplicates into Out (if not NULL), returns the length of the merged row
+static int64 MergeKronRows(const TInt* A, const TInt* AEnd, const TInt* B, const TInt* BEnd, TInt* Out) {
+  int64 Len = 0;
+  while (A < AEnd || B < BEnd) {
+    int Val;
+    if (B == BEnd || (A < AEnd && *A < *B)) { Val = *A;  A++; }
+    else if (A == AEnd || *B < *A) { Val = *B;  B++; }
+    else { Val = *A;  A++;  B++; }
+    if (Out != NULL) { Out[Len] = Val; }
+    Len++;
+  }
+  return Len;
+}
+
+// draws Draws edges from chunks FirstChunk, FirstChunk+1, ... and merges the new ones into the sorted rows
+// OffV, NbrV. Every chunk fills its own part of the edge buffer, rows are built by a counting sort of the buffer.
+static void AddKronDrawsMP(const TKronEdgeDraw& EdgeDraw, const int& NNodes, const int& BaseSeed, const int64& FirstChunk,
+ const int64& Draws, TVec<TInt64>& OffV, TVec<TInt, int64>& NbrV) {
+  const int64 Chunks = (Draws + KronChunkDraws - 1) / KronChunkDraws;
+  TVec<TIntPr, int64> EdgeV(Draws);
+  TVec<TInt64> DOffV(NNodes + 1);
+  DOffV.PutAll(0);
+  #pragma omp parallel for schedule(dynamic,1)
+  for (int64 c = 0; c < Chunks; c++) {
+    TRnd Rnd(GetKronChunkSeed(BaseSeed, FirstChunk + c));
+    const int64 End = TMath::Mn((c+1) * KronChunkDraws, Draws);
+    int Row, Col;
+    for (int64 d = c * KronChunkDraws; d < End; d++) {
+      EdgeDraw.Draw(Rnd, Row, Col);
+      EdgeV[d].Val1 = Row;  EdgeV[d].Val2 = Col;
+      FetchAddMP(DOffV[Row+1], 1);
+    }
+  }
+  for (int i = 0; i < NNodes; i++) { DOffV[i+1] += DOffV[i]; }
+  TVec<TInt64> PosV(DOffV);
+  TVec<TInt, int64> DNbrV(Draws);
+  #pragma omp parallel for schedule(static)
+  for (int64 d = 0; d < Draws; d++) {
+    DNbrV[FetchAddMP(PosV[EdgeV[d].Val1], 1)] = EdgeV[d].Val2; }
+  EdgeV.Clr();
+  // sort and deduplicate the drawn rows, PosV[i] becomes the end of row i
+  TVec<TInt64> NewOffV(NNodes + 1);
+  NewOffV[0] = 0;
+  #pragma omp parallel for schedule(dynamic,10000)
+  for (int i = 0; i < NNodes; i++) {
+    TInt* Beg = DNbrV.BegI() + DOffV[i];
+    TInt* End = DNbrV.BegI() + DOffV[i+1];
+    SortKronRow(Beg, End);
+    int64 Len = 0;
+    for (TInt* N = Beg; N < End; N++) {
+      if (Len == 0 || Beg[Len-1] != *N) { Beg[Len] = *N;  Len++; } }
+    PosV[i] = DOffV[i] + Len;
+    NewOffV[i+1] = MergeKronRows(NbrV.BegI()+OffV[i], NbrV.BegI()+OffV[i+1], Beg, Beg+Len, NULL);
+  }
+  for (int i = 0; i < NNodes; i++) { NewOffV[i+1] += NewOffV[i]; }
+  TVec<TInt, int64> NewNbrV(NewOffV[NNodes]);
+  #pragma omp parallel for schedule(dynamic,10000)
+  for (int i = 0; i < NNodes; i++) {
+    MergeKronRows(NbrV.BegI()+OffV[i], NbrV.BegI()+OffV[i+1], DNbrV.BegI()+DOffV[i], DNbrV.BegI()+PosV[i],
+      NewNbrV.BegI()+NewOffV[i]);
+  }
+  OffV.Swap(NewOffV);
+  NbrV.Swap(NewNbrV);
+}
+
+// sorted rows of the reversed edges or, if IsSym, of the edges in both directions (self-loops appear once)
+static void GetRevKronRowsMP(const TVec<TInt64>& OffV, const TVec<TInt, int64>& NbrV, const bool& IsSym,
+ TVec<TInt64>& RevOffV, TVec<TInt, int64>& RevNbrV) {
+  const int NNodes = OffV.Len() - 1;
+  RevOffV.Gen(NNodes + 1);
+  RevOffV.PutAll(0);
+  #pragma omp parallel for schedule(dynamic,10000)
+  for (int i = 0; i < NNodes; i++) {
+    for (int64 e = OffV[i]; e < OffV[i+1]; e++) {
+      const int j = NbrV[e];
+      if (IsSym) { FetchAddMP(RevOffV[i+1], 1); }
+      if (! IsSym || j != i) { FetchAddMP(RevOffV[j+1], 1); }
+    }
+  }
+  for (int i = 0; i < NNodes; i++) { RevOffV[i+1] += RevOffV[i]; }
+  TVec<TInt64> PosV(RevOffV);
+  RevNbrV.Gen(RevOffV[NNodes]);
+  #pragma omp parallel for schedule(dynamic,10000)
+  for (int i = 0; i < NNodes; i++) {
+    for (int64 e = OffV[i]; e < OffV[i+1]; e++) {
+      const int j = NbrV[e];
+      if (IsSym) { RevNbrV[FetchAddMP(PosV[i], 1)] = j; }
+      if (! IsSym || j != i) { RevNbrV[FetchAddMP(PosV[j], 1)] = i; }
+    }
+  }
+  #pragma omp parallel for schedule(dynamic,10000)
+  for (int i = 0; i < NNodes; i++) {
+    SortKronRow(RevNbrV.BegI()+RevOffV[i], RevNbrV.BegI()+RevOffV[i+1]); }
+}
+
+// Draws are split into chunks of KronChunkDraws edges, chunk k draws from its own TRnd seeded from (Seed, k),
+// so the graph does not depend on the number of threads. Rows are sorted and deduplicated in parallel,
+// edges lost to collisions are drawn again from further chunks and merged into the rows.
+void TKronMtx::GenFastKroneckerMP(const TKronMtx& SeedMtx, const int& NIter, const int64& Edges, const bool& IsDir, const int& Seed,
+ TVec<TInt64>& OffV, TVec<TInt, int64>& NbrV) {
+  const TKronEdgeDraw EdgeDraw(SeedMtx, NIter, IsDir);
+  const int NNodes = SeedMtx.GetNodes(NIter);
+  // undirected edges are drawn as node pairs, each pair gives 2 edges
+  const int64 Pairs = IsDir ? Edges : (Edges + 1) / 2;
+  const int64 MxPairs = IsDir ? int64(NNodes) * int64(NNodes) : int64(NNodes) * int64(NNodes+1) / 2;
+  IAssertR(Pairs <= MxPairs, TStr::Fmt("%s edges do not fit on %d nodes", TUInt64::GetStr(Edges).CStr(), NNodes));
+  printf("  FastKroneckerMP: %d nodes, %s edges, %s...\n", NNodes, TUInt64::GetStr(Edges).CStr(), IsDir ? "Directed":"UnDirected");
+  TExeTm ExeTm;
+  int BaseSeed = Seed;
+  if (BaseSeed == 0) { TRnd TmRnd(0);  BaseSeed = TmRnd.GetUniDevInt(1, TInt::Mx-1); }
+  OffV.Gen(NNodes + 1);
+  OffV.PutAll(0);
+  NbrV.Clr();
+  int64 Chunks = 0, Drawn = 0;
+  while (NbrV.Len() < Pairs) {
+    const int64 Draws = Pairs - NbrV.Len();
+    AddKronDrawsMP(EdgeDraw, NNodes, BaseSeed, Chunks, Draws, OffV, NbrV);
+    Chunks += (Draws + KronChunkDraws - 1) / KronChunkDraws;
+    Drawn += Draws;
+  }
+  if (! IsDir) {
+    TVec<TInt64> SymOffV;  TVec<TInt, int64> SymNbrV;
+    GetRevKronRowsMP(OffV, NbrV, true, SymOffV, SymNbrV);
+    OffV.Swap(SymOffV);  NbrV.Swap(SymNbrV);
+  }
+  printf("             %s edges, collisions: %s (%.4f) [%s]\n", TUInt64::GetStr(NbrV.Len()).CStr(),
+    TUInt64::GetStr(Drawn - Pairs).CStr(), (Drawn - Pairs)/double(TMath::Mx(Pairs, int64(1))), ExeTm.GetTmStr());
+}
+
+PNGraph TKronMtx::GenFastKroneckerMP(const TKronMtx& SeedMtx, const int& NIter, const bool& IsDir, const int& Seed) {
+  return GenFastKroneckerMP(SeedMtx, NIter, SeedMtx.GetEdges(NIter), IsDir, Seed);
+}
+
+PNGraph TKronMtx::GenFastKroneckerMP(const TKronMtx& SeedMtx, const int& NIter, const int& Edges, const bool& IsDir, const int& Seed) {
+  TVec<TInt64> OffV, InOffV;
+  TVec<TInt, int64> NbrV, InNbrV;
+  GenFastKroneckerMP(SeedMtx, NIter, Edges, IsDir, Seed, OffV, NbrV);
+  if (IsDir) { GetRevKronRowsMP(OffV, NbrV, false, InOffV, InNbrV); }
+  const TVec<TInt64>& InOff = IsDir ? InOffV : OffV;
+  const TVec<TInt, int64>& InNbr = IsDir ? InNbrV : NbrV;
+  const int NNodes = OffV.Len() - 1;
+  PNGraph Graph = TNGraph::New(NNodes, int(NbrV.Len()));
+  TIntV InNIdV, OutNIdV;
+  for (int i = 0; i < NNodes; i++) {
+    OutNIdV.Gen(int(OffV[i+1] - OffV[i]), 0);
+    for (int64 e = OffV[i]; e < OffV[i+1]; e++) { OutNIdV.Add(NbrV[e]); }
+    InNIdV.Gen(int(InOff[i+1] - InOff[i]), 0);
+    for (int64 e = InOff[i]; e < InOff[i+1]; e++) { InNIdV.Add(InNbr[e]); }
+    Graph->AddNode(i, InNIdV, OutNIdV);
+  }
+  return Graph;
+}
+
 PNGraph TKronMtx::GenDetKronecker(const TKronMtx& SeedMtx, const int& NIter, const bool& IsDir) {
   const TKronMtx& SeedGraph = SeedMtx;
   const int NNodes = SeedGraph.GetNodes(NIter);
@@ -1033,18 +1276,31 @@ double TKroneckerLL::CalcGraphLL() {
   return LogLike;
 }
 
+// parallel sums over the nodes are taken over blocks of KronLLBlockNodes nodes and the
+// block sums are added up in order, so the result does not depend on the number of threads
+static const int KronLLBlockNodes = 1000;
+
 // approximate graph log-likelihood, takes O(E + N_0)
 double TKroneckerLL::CalcApxGraphLL() {
-  LogLike = GetApxEmptyGraphLL(); // O(N_0)
-  for (int nid = 0; nid < Nodes; nid++) {
-    const TNGraph::TNodeI Node = Graph->GetNI(nid);
-    const int SrcNId = NodePerm[nid];
-    for (int e = 0; e < Node.GetOutDeg(); e++) {
-      const int DstNId = NodePerm[Node.GetOutNId(e)];
-      LogLike = LogLike - LLMtx.GetApxNoEdgeLL(SrcNId, DstNId, KronIters)
-        + LLMtx.GetEdgeLL(SrcNId, DstNId, KronIters);
+  const int Blocks = (Nodes + KronLLBlockNodes - 1) / KronLLBlockNodes;
+  TFltV BlockLLV(Blocks);
+  #pragma omp parallel for schedule(dynamic,1)
+  for (int b = 0; b < Blocks; b++) {
+    double BlockLL = 0.0;
+    for (int nid = b * KronLLBlockNodes; nid < TMath::Mn(Nodes.Val, (b+1) * KronLLBlockNodes); nid++) {
+      const TNGraph::TNodeI Node = Graph->GetNI(nid);
+      const int SrcNId = NodePerm[nid];
+      for (int e = 0; e < Node.GetOutDeg(); e++) {
+        const int DstNId = NodePerm[Node.GetOutNId(e)];
+        BlockLL += - LLMtx.GetApxNoEdgeLL(SrcNId, DstNId, KronIters)
+          + LLMtx.GetEdgeLL(SrcNId, DstNId, KronIters);
+      }
     }
+    BlockLLV[b] = BlockLL;
   }
+  double EdgeLL = 0.0;
+  for (int b = 0; b < Blocks; b++) { EdgeLL += BlockLLV[b]; }
+  LogLike = GetApxEmptyGraphLL() + EdgeLL; // O(N_0)
   return LogLike;
 }
 
@@ -1110,16 +1366,17 @@ double TKroneckerLL::SwapNodesLL(const int& NId1, const int& NId2) {
 // metropolis sampling from P(permutation|graph)
 bool TKroneckerLL::SampleNextPerm(int& NId1, int& NId2) {
   // pick 2 uniform nodes and swap
-  if (TKronMtx::Rnd.GetUniDev() < PermSwapNodeProb) {
-    NId1 = TKronMtx::Rnd.GetUniDevInt(Nodes);
-    NId2 = TKronMtx::Rnd.GetUniDevInt(Nodes);
-    while (NId2 == NId1) { NId2 = TKronMtx::Rnd.GetUniDevInt(Nodes); }
+  TRnd& Rnd = GetRnd();
+  if (Rnd.GetUniDev() < PermSwapNodeProb) {
+    NId1 = Rnd.GetUniDevInt(Nodes);
+    NId2 = Rnd.GetUniDevInt(Nodes);
+    while (NId2 == NId1) { NId2 = Rnd.GetUniDevInt(Nodes); }
   } else {
     // pick uniform edge and swap endpoints (slow as it moves around high degree nodes)
-    const int e = TKronMtx::Rnd.GetUniDevInt(GEdgeV.Len());
+    const int e = Rnd.GetUniDevInt(GEdgeV.Len());
     NId1 = GEdgeV[e].Val1;  NId2 = GEdgeV[e].Val2;
   }
-  const double U = TKronMtx::Rnd.GetUniDev();
+  const double U = Rnd.GetUniDev();
   const double OldLL = LogLike;
   const double NewLL = SwapNodesLL(NId1, NId2);
   const double LogU = log(U);
@@ -1192,18 +1449,26 @@ const TFltV& TKroneckerLL::CalcFullApxGraphDLL() {
 
 // fast approximate gradient, runs O(E)
 const TFltV& TKroneckerLL::CalcApxGraphDLL() {
+  const int Blocks = (Nodes + KronLLBlockNodes - 1) / KronLLBlockNodes;
+  TFltV BlockDLLV(Blocks);
   for (int ParamId = 0; ParamId < LLMtx.Len(); ParamId++) {
-    double DLL = GetApxEmptyGraphDLL(ParamId);
-    for (int nid = 0; nid < Nodes; nid++) {
-      const TNGraph::TNodeI Node = Graph->GetNI(nid);
-      const int SrcNId = NodePerm[nid];
-      for (int e = 0; e < Node.GetOutDeg(); e++) {
-        const int DstNId = NodePerm[Node.GetOutNId(e)];
-        DLL = DLL - LLMtx.GetApxNoEdgeDLL(ParamId, SrcNId, DstNId, KronIters)
-          + LLMtx.GetEdgeDLL(ParamId, SrcNId, DstNId, KronIters);
+    #pragma omp parallel for schedule(dynamic,1)
+    for (int b = 0; b < Blocks; b++) {
+      double BlockDLL = 0.0;
+      for (int nid = b * KronLLBlockNodes; nid < TMath::Mn(Nodes.Val, (b+1) * KronLLBlockNodes); nid++) {
+        const TNGraph::TNodeI Node = Graph->GetNI(nid);
+        const int SrcNId = NodePerm[nid];
+        for (int e = 0; e < Node.GetOutDeg(); e++) {
+          const int DstNId = NodePerm[Node.GetOutNId(e)];
+          BlockDLL += - LLMtx.GetApxNoEdgeDLL(ParamId, SrcNId, DstNId, KronIters)
+            + LLMtx.GetEdgeDLL(ParamId, SrcNId, DstNId, KronIters);
+        }
       }
+      BlockDLLV[b] = BlockDLL;
     }
-    GradV[ParamId] = DLL;
+    double DLL = 0.0;
+    for (int b = 0; b < Blocks; b++) { DLL += BlockDLLV[b]; }
+    GradV[ParamId] = GetApxEmptyGraphDLL(ParamId) + DLL;
   }
   return GradV;
 }
@@ -1268,31 +1533,79 @@ void TKroneckerLL::UpdateGraphDLL(const int& SwapNId1, const int& SwapNId2) {
   }
 }
 
-void TKroneckerLL::SampleGradient(const int& WarmUp, const int& NSamples, double& AvgLL, TFltV& AvgGradV) {
-  printf("SampleGradient: %s (%s warm-up):", TInt::GetMegaStr(NSamples).CStr(), TInt::GetMegaStr(WarmUp).CStr());
-  int NId1=0, NId2=0, NAccept=0;
-  TExeTm ExeTm1;
+// copy of the sampler state for a parallel chain, the chain shares the graph unless CopyGraph
+PKroneckerLL TKroneckerLL::NewChain(const int& RndSeed, const bool& CopyGraph) const {
+  PKroneckerLL Chain = TKroneckerLL::New();
+  Chain->Graph = CopyGraph ? PNGraph(new TNGraph(*Graph)) : Graph;
+  Chain->Nodes = Nodes;  Chain->KronIters = KronIters;
+  Chain->PermSwapNodeProb = PermSwapNodeProb;
+  Chain->GEdgeV = GEdgeV;  Chain->LEdgeV = LEdgeV;  Chain->LSelfEdge = LSelfEdge;
+  Chain->NodePerm = NodePerm;  Chain->InvertPerm = InvertPerm;
+  Chain->RealNodes = RealNodes;  Chain->RealEdges = RealEdges;
+  Chain->ProbMtx = ProbMtx;  Chain->LLMtx = LLMtx;
+  Chain->LogLike = LogLike;  Chain->GradV = GradV;
+  Chain->EMType = EMType;  Chain->MissEdges = MissEdges;
+  Chain->IsChain = true;
+  Chain->ChainRnd.PutSeed(RndSeed);
+  return Chain;
+}
+
+// samples of chain ChainN when NSamples are split over the chains
+int TKroneckerLL::GetChainSamples(const int& NSamples, const int& ChainN) const {
+  return NSamples / GetChains() + (ChainN < NSamples % GetChains() ? 1 : 0);
+}
+
+// warm-up and NSamples steps of the permutation chain, sums the LL and the gradient over the samples
+void TKroneckerLL::SampleChain(const int& WarmUp, const int& NSamples, double& SumLL, TFltV& SumGradV, int& NAccept) {
+  int NId1=0, NId2=0;
   if (WarmUp > 0) {
     CalcApxGraphLL();
     for (int s = 0; s < WarmUp; s++) { SampleNextPerm(NId1, NId2); }
-    printf("  warm-up:%s,", ExeTm1.GetTmStr());  ExeTm1.Tick();
   }
   CalcApxGraphLL(); // re-calculate LL (due to numerical errors)
   CalcApxGraphDLL();
-  AvgLL = 0;
-  AvgGradV.Gen(LLMtx.Len());  AvgGradV.PutAll(0.0);
-  printf("  sampl");
+  SumLL = 0;  NAccept = 0;
+  SumGradV.Gen(LLMtx.Len());  SumGradV.PutAll(0.0);
   for (int s = 0; s < NSamples; s++) {
     if (SampleNextPerm(NId1, NId2)) { // new permutation
       UpdateGraphDLL(NId1, NId2);  NAccept++; }
-    for (int m = 0; m < LLMtx.Len(); m++) { AvgGradV[m] += GradV[m]; }
-    AvgLL += GetLL();
+    for (int m = 0; m < LLMtx.Len(); m++) { SumGradV[m] += GradV[m]; }
+    SumLL += GetLL();
+  }
+}
+
+// With several chains every chain starts from the current permutation, runs the whole warm-up
+// and its share of the samples. The estimate averages the samples of all chains, the current
+// permutation continues from the first chain.
+void TKroneckerLL::SampleGradient(const int& WarmUp, const int& NSamples, double& AvgLL, TFltV& AvgGradV) {
+  const int Chains = GetChains();
+  printf("SampleGradient: %s (%s warm-up)", TInt::GetMegaStr(NSamples).CStr(), TInt::GetMegaStr(WarmUp).CStr());
+  if (Chains > 1) { printf(", %d chains", Chains); }
+  printf(":");
+  TExeTm ExeTm1;
+  TVec<PKroneckerLL> ChainV;
+  for (int c = 1; c < Chains; c++) {
+    ChainV.Add(NewChain(TKronMtx::Rnd.GetUniDevInt(1, TInt::Mx-1), false)); }
+  TFltV SumLLV(Chains);
+  TVec<TFltV> SumGradVV(Chains);
+  TIntV NAcceptV(Chains);
+  #pragma omp parallel for schedule(dynamic,1) if(Chains > 1)
+  for (int c = 0; c < Chains; c++) {
+    TKroneckerLL& Chain = c == 0 ? *this : *ChainV[c-1];
+    Chain.SampleChain(WarmUp, GetChainSamples(NSamples, c), SumLLV[c].Val, SumGradVV[c], NAcceptV[c].Val);
+  }
+  ChainV.Clr();
+  int NAccept = 0;
+  AvgLL = 0;
+  AvgGradV.Gen(LLMtx.Len());  AvgGradV.PutAll(0.0);
+  for (int c = 0; c < Chains; c++) {
+    AvgLL += SumLLV[c];  NAccept += NAcceptV[c];
+    for (int m = 0; m < LLMtx.Len(); m++) { AvgGradV[m] += SumGradVV[c][m]; }
   }
-  printf("ing");
   AvgLL = AvgLL / double(NSamples);
   for (int m = 0; m < LLMtx.Len(); m++) {
     AvgGradV[m] = AvgGradV[m] / double(NSamples); }
-  printf(":%s (%.0f/s), accept %.1f%%\n", ExeTm1.GetTmStr(), double(NSamples)/ExeTm1.GetSecs(),
+  printf("  sampling:%s (%.0f/s), accept %.1f%%\n", ExeTm1.GetTmStr(), double(NSamples)/ExeTm1.GetSecs(),
     double(100*NAccept)/double(NSamples));
 }
 
@@ -1435,7 +1748,7 @@ void TKroneckerLL::SetRandomEdges(const int& NEdges, const bool isDir) {
 	while(added < NEdges) {
 		Rng = Nodes;	Row = 0;	Col = 0;
 		for (int iter = 0; iter < KronIters; iter++) {
-			const double& Prob = TKronMtx::Rnd.GetUniDev();
+			const double& Prob = GetRnd().GetUniDev();
 			n = 0; while(Prob > ProbToRCPosV[n].Val1) { n++; }
 			const int MtxRow = ProbToRCPosV[n].Val2;
 			const int MtxCol = ProbToRCPosV[n].Val3;
@@ -1507,7 +1820,7 @@ void TKroneckerLL::MetroGibbsSampleNext(const int& WarmUp, const bool DLLUpdate)
 
 	if(LEdgeV.Len()) {
 		for(int i = 0; i < WarmUp; i++) {
-			hit = TKronMtx::Rnd.GetUniDevInt(LEdgeV.Len());
+			hit = GetRnd().GetUniDevInt(LEdgeV.Len());
 
 			NId1 = LEdgeV[hit].Val1;	NId2 = LEdgeV[hit].Val2;
 			GId = LEdgeV[hit].Val3;
@@ -1517,7 +1830,7 @@ void TKroneckerLL::MetroGibbsSampleNext(const int& WarmUp, const bool DLLUpdate)
 			RndAccept = (1.0 - exp(LLMtx.GetEdgeLL(NewEdge.Val1, NewEdge.Val2, KronIters))) / (1.0 - exp(LLMtx.GetEdgeLL(NId1, NId2, KronIters)));
 			RndAccept = (RndAccept > 1.0) ? 1.0 : RndAccept;
 
-			if(TKronMtx::Rnd.GetUniDev() > RndAccept) { //	reject
+			if(GetRnd().GetUniDev() > RndAccept) { //	reject
 				Graph->DelEdge(NewEdge.Val1, NewEdge.Val2);
 				if(NewEdge.Val1 != NewEdge.Val2) {	GEdgeV.DelLast();	}
 				else {	LSelfEdge--;	}
@@ -1563,18 +1876,18 @@ void TKroneckerLL::MetroGibbsSampleNext(const int& WarmUp, const bool DLLUpdate)
 	}
 }
 
-// E-step in KronEM
-void TKroneckerLL::RunEStep(const int& GibbsWarmUp, const int& WarmUp, const int& NSamples, TFltV& LLV, TVec<TFltV>& DLLV) {
+// E-step of one chain
+void TKroneckerLL::RunChainEStep(const int& GibbsWarmUp, const int& WarmUp, const int& NSamples, TFltV& LLV, TVec<TFltV>& DLLV, const bool& Verbose) {
 	TExeTm ExeTm, TotalTm;
 	LLV.Gen(NSamples, 0);
 	DLLV.Gen(NSamples, 0);
 
 	ExeTm.Tick();
 	for(int i = 0; i < 2; i++)	MetroGibbsSampleSetup(WarmUp);
-	printf("  Warm-Up [%u] : %s\n", WarmUp, ExeTm.GetTmStr());
+	if(Verbose)	printf("  Warm-Up [%u] : %s\n", WarmUp, ExeTm.GetTmStr());
 	CalcApxGraphLL();
 	for(int i = 0; i < GibbsWarmUp; i++)	MetroGibbsSampleNext(10, false);
-	printf("  Gibbs Warm-Up [%u] : %s\n", GibbsWarmUp, ExeTm.GetTmStr());
+	if(Verbose)	printf("  Gibbs Warm-Up [%u] : %s\n", GibbsWarmUp, ExeTm.GetTmStr());
 
 	ExeTm.Tick();
 	CalcApxGraphLL();
@@ -1585,14 +1898,43 @@ void TKroneckerLL::RunEStep(const int& GibbsWarmUp, const int& WarmUp, const int
 		LLV.Add(LogLike);
 		DLLV.Add(GradV);
 
-		int OnePercent = (i+1) % (NSamples / 10);
-		if(OnePercent == 0) {
+		if(Verbose && NSamples >= 10 && (i+1) % (NSamples / 10) == 0) {
 			int TenPercent = ((i+1) / (NSamples / 10)) * 10;
 			printf("  %3u%% done : %s\n", TenPercent, ExeTm.GetTmStr());
 		}
 	}
 }
 
+// E-step in KronEM, with several chains every chain runs the whole warm-up on its own copy
+// of the graph and its share of the samples, the samples are concatenated in chain order
+void TKroneckerLL::RunEStep(const int& GibbsWarmUp, const int& WarmUp, const int& NSamples, TFltV& LLV, TVec<TFltV>& DLLV) {
+	const int Chains = GetChains();
+	if(Chains == 1) {
+		RunChainEStep(GibbsWarmUp, WarmUp, NSamples, LLV, DLLV, true);
+		return;
+	}
+	TExeTm ExeTm;
+	TVec<PKroneckerLL> ChainV;
+	for(int c = 1; c < Chains; c++) {
+		ChainV.Add(NewChain(TKronMtx::Rnd.GetUniDevInt(1, TInt::Mx-1), true));
+	}
+	TVec<TFltV> ChainLLVV(Chains);
+	TVec<TVec<TFltV> > ChainDLLVV(Chains);
+	#pragma omp parallel for schedule(dynamic,1)
+	for(int c = 0; c < Chains; c++) {
+		TKroneckerLL& Chain = c == 0 ? *this : *ChainV[c-1];
+		Chain.RunChainEStep(GibbsWarmUp, WarmUp, GetChainSamples(NSamples, c), ChainLLVV[c], ChainDLLVV[c], false);
+	}
+	ChainV.Clr();
+	LLV.Gen(NSamples, 0);
+	DLLV.Gen(NSamples, 0);
+	for(int c = 0; c < Chains; c++) {
+		LLV.AddV(ChainLLVV[c]);
+		DLLV.AddV(ChainDLLVV[c]);
+	}
+	printf("  E-Step [%d chains] : %s\n", Chains, ExeTm.GetTmStr());
+}
+
 // M-step in KronEM
 double TKroneckerLL::RunMStep(const TFltV& LLV, const TVec<TFltV>& DLLV, const int& GradIter, const double& LrnRate, double MnStep, double MxStep) {
 	TExeTm IterTm, TotalTm;
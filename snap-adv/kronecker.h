@@ -87,6 +87,11 @@ public:
   static PNGraph GenKronecker(const TKronMtx& SeedMtx, const int& NIter, const bool& IsDir, const int& Seed=0);
   static PNGraph GenFastKronecker(const TKronMtx& SeedMtx, const int& NIter, const bool& IsDir, const int& Seed=0);
   static PNGraph GenFastKronecker(const TKronMtx& SeedMtx, const int& NIter, const int& Edges, const bool& IsDir, const int& Seed=0);
+  // parallel GenFastKronecker, the graph depends on Seed but not on the number of threads
+  static void GenFastKroneckerMP(const TKronMtx& SeedMtx, const int& NIter, const int64& Edges, const bool& IsDir, const int& Seed,
+    TVec<TInt64>& OffV, TVec<TInt, int64>& NbrV); // sorted out-neighbors of node i are NbrV[OffV[i]..OffV[i+1]-1]
+  static PNGraph GenFastKroneckerMP(const TKronMtx& SeedMtx, const int& NIter, const bool& IsDir, const int& Seed=0);
+  static PNGraph GenFastKroneckerMP(const TKronMtx& SeedMtx, const int& NIter, const int& Edges, const bool& IsDir, const int& Seed=0);
   static PNGraph GenDetKronecker(const TKronMtx& SeedMtx, const int& NIter, const bool& IsDir);
   static void PlotCmpGraphs(const TKronMtx& SeedMtx, const PNGraph& Graph, const TStr& OutFNm, const TStr& Desc);
   static void PlotCmpGraphs(const TKronMtx& SeedMtx1, const TKronMtx& SeedMtx2, const PNGraph& Graph, const TStr& OutFNm, const TStr& Desc);
@@ -142,6 +147,17 @@ private:
   TFltV LLV;			// Log-likelihood (per EM iteration)
   TVec<TKronMtx> MtxV;	// Kronecker initiator matrix (per EM iteration)
 
+  TInt NChains;         // parallel MCMC chains in SampleGradient and RunEStep
+  TBool IsChain;        // parallel chain, samples from ChainRnd instead of TKronMtx::Rnd
+  TRnd ChainRnd;
+
+private:
+  TRnd& GetRnd() { return IsChain ? ChainRnd : TKronMtx::Rnd; }
+  PKroneckerLL NewChain(const int& RndSeed, const bool& CopyGraph) const;
+  int GetChainSamples(const int& NSamples, const int& ChainN) const;
+  void SampleChain(const int& WarmUp, const int& NSamples, double& SumLL, TFltV& SumGradV, int& NAccept);
+  void RunChainEStep(const int& GibbsWarmUp, const int& WarmUp, const int& NSamples, TFltV& LLV, TVec<TFltV>& DLLV, const bool& Verbose);
+
 public:
   // RS 07/03/12, changed the order in the constructor initializer list
   //    so that it matches the declaration order. This changes also
@@ -165,6 +181,9 @@ public:
   int GetDim() const { return ProbMtx.GetDim(); }
 
   void SetDebug(const bool Debug) { DebugMode = Debug; }
+  // MCMC chains run in parallel by SampleGradient (GradDescent) and RunEStep (RunKronEM)
+  void SetChains(const int& Chains) { NChains = Chains; }
+  int GetChains() const { return TMath::Mx(1, NChains()); }
   const TFltV& GetLLHist() const { return LLV; }
   const TVec<TKronMtx>& GetParamHist() const { return MtxV; }
 
@@ -33,6 +33,22 @@ static void IncrementWeight(int i, int j, WeightVH& weights) {
   edge_weights(maxval) += 1;
 }
 
+static int GetMotifThreads() {
+#ifdef USE_OPENMP
+  return omp_get_max_threads();
+#else
+  return 1;
+#endif
+}
+
+static int GetMotifThreadN() {
+#ifdef USE_OPENMP
+  return omp_get_thread_num();
+#else
+  return 0;
+#endif
+}
+
 MotifType MotifCluster::ParseMotifType(const TStr& motif) {
   TStr motif_lc = motif.GetLc();
   if      (motif_lc == "m1")          { return M1; }
@@ -181,7 +197,7 @@ bool MotifCluster::IsMotifM13(PNGraph graph, int center, int v, int w) {
 
 
 /////////////////////////////////////////////////
-// Triangle weighting
+// Degree ordering
 void MotifCluster::DegreeOrdering(PNGraph graph, TIntV& order) {
   // Note: This is the most efficient when the nodes are numbered
   // 0, 1, ..., num_nodes - 1.
@@ -210,131 +226,354 @@ void MotifCluster::DegreeOrdering(PNGraph graph, TIntV& order) {
   }
 }
 
-void MotifCluster::TriangleMotifAdjacency(PNGraph graph, MotifType motif,
-                                          WeightVH& weights) {
-  TIntV order;
-  DegreeOrdering(graph, order);
-  for (TNGraph::TNodeI NI = graph->BegNI(); NI < graph->EndNI(); NI++) {
-    int src = NI.GetId();
-    int src_pos = order[src];
-    
-    // Get all neighbors who come later in the ordering
-    TIntV neighbors_higher;
-    for (int i = 0; i < NI.GetOutDeg(); i++) {
-      int nbr = NI.GetOutNId(i);
-      if (order[nbr] > src_pos) {
-        neighbors_higher.Add(nbr);
+/////////////////////////////////////////////////
+// Triangle and wedge weighting
+
+// Swaps the out and in bits of an edge direction bitmask, which gives the
+// directions of the edge seen from the other node.
+static inline int SwapDirs(int dirs) {
+  return ((dirs & 1) << 1) | ((dirs >> 1) & 1);
+}
+
+// Returns the directed triangle motif formed by the nodes u, v and w, where
+// uv, vw and uw are the direction bitmasks of the edges (u, v), (v, w) and
+// (u, w) seen from u, v and u (bit 1: edge to the other node, bit 2: edge from
+// the other node).  All three bitmasks must be nonzero.
+static MotifType GetTriangleMotif(int uv, int vw, int uw) {
+  // adj[x][y] is true if there is an edge x --> y
+  bool adj[3][3] = {{false, false, false}, {false, false, false},
+                    {false, false, false}};
+  adj[0][1] = (uv & 1) != 0;  adj[1][0] = (uv & 2) != 0;
+  adj[1][2] = (vw & 1) != 0;  adj[2][1] = (vw & 2) != 0;
+  adj[0][2] = (uw & 1) != 0;  adj[2][0] = (uw & 2) != 0;
+  int num_bidir = 0;
+  int bidir_x = -1, bidir_y = -1;
+  for (int x = 0; x < 3; x++) {
+    for (int y = x + 1; y < 3; y++) {
+      if (adj[x][y] && adj[y][x]) {
+        num_bidir++;
+        bidir_x = x;
+        bidir_y = y;
       }
     }
-    for (int i = 0; i < NI.GetInDeg(); i++) {
-      int nbr = NI.GetInNId(i);
-      if (!NI.IsOutNId(nbr) && order[nbr] > src_pos) {
-        neighbors_higher.Add(nbr);
-      }
+  }
+  if (num_bidir == 3) { return M4; }
+  if (num_bidir == 2) { return M3; }
+  if (num_bidir == 0) {
+    // A cycle if every node has exactly one outgoing edge
+    for (int x = 0; x < 3; x++) {
+      if (adj[x][(x + 1) % 3] == adj[x][(x + 2) % 3]) { return M5; }
+    }
+    return M1;
+  }
+  // One bidirectional edge (x, y), the third node z has unidirectional edges
+  int z = 3 - bidir_x - bidir_y;
+  if (adj[z][bidir_x] && adj[z][bidir_y]) { return M6; }
+  if (adj[bidir_x][z] && adj[bidir_y][z]) { return M7; }
+  return M2;
+}
+
+// Returns the directed wedge motif with the given center, where ca and cb are
+// the direction bitmasks of the edges from the center to the two other nodes.
+// Both bitmasks must be nonzero.
+static MotifType GetWedgeMotif(int ca, int cb) {
+  int lo = MIN(ca, cb);
+  int hi = MAX(ca, cb);
+  if (lo == 1 && hi == 1) { return M8; }
+  if (lo == 1 && hi == 2) { return M9; }
+  if (lo == 2 && hi == 2) { return M10; }
+  if (lo == 1 && hi == 3) { return M11; }
+  if (lo == 2 && hi == 3) { return M12; }
+  return M13;
+}
+
+// Returns the first position in the sorted range nbrs[beg..end-1] with a value
+// larger than val.
+static int GetFirstAbove(const TIntV& nbrs, int beg, int end, int val) {
+  while (beg < end) {
+    int mid = beg + (end - beg) / 2;
+    if (nbrs[mid] <= val) {
+      beg = mid + 1;
+    } else {
+      end = mid;
     }
+  }
+  return beg;
+}
 
-    for (int ind1 = 0; ind1 < neighbors_higher.Len(); ind1++) {
-      for (int ind2 = ind1 + 1; ind2 < neighbors_higher.Len(); ind2++) {
-        int dst1 = neighbors_higher[ind1];
-        int dst2 = neighbors_higher[ind2];
-        // Check for triangle formation
-        if (graph->IsEdge(dst1, dst2) || graph->IsEdge(dst2, dst1)) {
-          bool motif_occurs = false;
-          switch (motif) {
-          case M1:
-            motif_occurs = IsMotifM1(graph, src, dst1, dst2);
-            break;
-          case M2:
-            motif_occurs = IsMotifM2(graph, src, dst1, dst2);
-            break;
-          case M3:
-            motif_occurs = IsMotifM3(graph, src, dst1, dst2);
-            break;
-          case M4:
-            motif_occurs = IsMotifM4(graph, src, dst1, dst2);
-            break;
-          case M5:
-            motif_occurs = IsMotifM5(graph, src, dst1, dst2);
-            break;
-          case M6:
-            motif_occurs = IsMotifM6(graph, src, dst1, dst2);
-            break;
-          case M7:
-            motif_occurs = IsMotifM7(graph, src, dst1, dst2);
-            break;
-          default:
-            TExcept::Throw("Unknown directed triangle motif");
-          }
-          // Increment weights of the triad (src, dst1, dst2) if it occurs.
-          if (motif_occurs) {
-            IncrementWeight(src,  dst1, weights);
-            IncrementWeight(src,  dst2, weights);
-            IncrementWeight(dst1, dst2, weights);
+TriadMotifWeighter::TriadMotifWeighter(PNGraph graph) {
+  // Node ids in increasing order, so that nodes of equal degree are ranked by
+  // id as in MotifCluster::DegreeOrdering()
+  TIntV ids;
+  graph->GetNIdV(ids);
+  ids.Sort();
+  const int nodes = ids.Len();
+  TIntV degs(nodes);
+  #pragma omp parallel for schedule(dynamic,1000)
+  for (int i = 0; i < nodes; i++) {
+    // Number of unique neighbors, merging the sorted out and in lists
+    TNGraph::TNodeI NI = graph->GetNI(ids[i]);
+    int deg = 0;
+    int out = 0, in = 0;
+    while (out < NI.GetOutDeg() || in < NI.GetInDeg()) {
+      int out_nbr = out < NI.GetOutDeg() ? NI.GetOutNId(out) : TInt::Mx;
+      int in_nbr = in < NI.GetInDeg() ? NI.GetInNId(in) : TInt::Mx;
+      int nbr = MIN(out_nbr, in_nbr);
+      if (out_nbr == nbr) { out++; }
+      if (in_nbr == nbr) { in++; }
+      if (nbr != ids[i]) { deg++; }
+    }
+    degs[i] = deg;
+  }
+
+  // Rank the nodes by degree with a counting sort
+  int max_deg = 0;
+  for (int i = 0; i < nodes; i++) { max_deg = MAX(max_deg, degs[i].Val); }
+  TIntV deg_starts(max_deg + 2);
+  for (int i = 0; i < nodes; i++) { deg_starts[degs[i] + 1] += 1; }
+  for (int d = 1; d < deg_starts.Len(); d++) {
+    deg_starts[d] += deg_starts[d - 1];
+  }
+  TIntV ranks(graph->GetMxNId());
+  nids_.Gen(nodes);
+  offsets_.Gen(nodes + 1);
+  for (int i = 0; i < nodes; i++) {
+    int rank = deg_starts[degs[i]];
+    deg_starts[degs[i]] += 1;
+    nids_[rank] = ids[i];
+    ranks[ids[i]] = rank;
+    offsets_[rank + 1] = degs[i];
+  }
+  for (int i = 0; i < nodes; i++) { offsets_[i + 1] += offsets_[i]; }
+
+  // Unsorted adjacency lists over ranks, seen from each node
+  const int entries = offsets_[nodes];
+  TIntV tmp_nbrs(entries);
+  TUChV tmp_dirs(entries);
+  #pragma omp parallel for schedule(dynamic,1000)
+  for (int i = 0; i < nodes; i++) {
+    TNGraph::TNodeI NI = graph->GetNI(nids_[i]);
+    int pos = offsets_[i];
+    int out = 0, in = 0;
+    while (out < NI.GetOutDeg() || in < NI.GetInDeg()) {
+      int out_nbr = out < NI.GetOutDeg() ? NI.GetOutNId(out) : TInt::Mx;
+      int in_nbr = in < NI.GetInDeg() ? NI.GetInNId(in) : TInt::Mx;
+      int nbr = MIN(out_nbr, in_nbr);
+      int dirs = 0;
+      if (out_nbr == nbr) { out++;  dirs |= kOutEdge; }
+      if (in_nbr == nbr) { in++;  dirs |= kInEdge; }
+      if (nbr == nids_[i]) { continue; }
+      tmp_nbrs[pos] = ranks[nbr];
+      tmp_dirs[pos] = uchar(dirs);
+      pos++;
+    }
+  }
+
+  // Sorted lists: visiting the nodes by increasing rank and appending every
+  // node to the lists of its neighbors fills each list in increasing order
+  nbrs_.Gen(entries);
+  dirs_.Gen(entries);
+  TIntV cursors(nodes);
+  for (int i = 0; i < nodes; i++) { cursors[i] = offsets_[i]; }
+  for (int j = 0; j < nodes; j++) {
+    for (int pos = offsets_[j]; pos < offsets_[j + 1]; pos++) {
+      int i = tmp_nbrs[pos];
+      nbrs_[cursors[i]] = j;
+      dirs_[cursors[i]] = uchar(SwapDirs(tmp_dirs[pos]));
+      cursors[i] += 1;
+    }
+  }
+
+  // Reverse entries: the lower neighbors of each node are met in increasing
+  // order as well
+  rev_.Gen(entries);
+  higher_.Gen(nodes);
+  for (int i = 0; i < nodes; i++) { cursors[i] = offsets_[i]; }
+  for (int i = 0; i < nodes; i++) {
+    higher_[i] = cursors[i];
+    for (int pos = cursors[i]; pos < offsets_[i + 1]; pos++) {
+      int j = nbrs_[pos];
+      rev_[pos] = cursors[j];
+      rev_[cursors[j]] = pos;
+      cursors[j] += 1;
+    }
+  }
+}
+
+void TriadMotifWeighter::Run(MotifType motif) {
+  edge_weights_.Gen(nbrs_.Len());
+  pair_weights_.Clr();
+  switch (motif) {
+  case M1:
+  case M2:
+  case M3:
+  case M4:
+  case M5:
+  case M6:
+  case M7: {
+    // Indexed by uv | vw << 2 | uw << 4
+    bool match[64];
+    for (int code = 0; code < 64; code++) {
+      int uv = code & 3, vw = (code >> 2) & 3, uw = code >> 4;
+      match[code] = uv != 0 && vw != 0 && uw != 0 &&
+        GetTriangleMotif(uv, vw, uw) == motif;
+    }
+    TriangleWeights(match);
+    break;
+  }
+  case M8:
+  case M9:
+  case M10:
+  case M11:
+  case M12:
+  case M13: {
+    // Indexed by ca | cb << 2
+    bool match[16];
+    for (int code = 0; code < 16; code++) {
+      int ca = code & 3, cb = code >> 2;
+      match[code] = ca != 0 && cb != 0 && GetWedgeMotif(ca, cb) == motif;
+    }
+    WedgeWeights(match);
+    break;
+  }
+  case edge:
+    edge_weights_.PutAll(1);
+    break;
+  default:
+    TExcept::Throw("Unknown triad motif type");
+  }
+}
+
+void TriadMotifWeighter::TriangleWeights(const bool* match) {
+  const int nodes = GetNodes();
+  TVec<TIntV> buffers(GetMotifThreads());
+  #pragma omp parallel
+  {
+    TIntV& buffer = buffers[GetMotifThreadN()];
+    buffer.Gen(nbrs_.Len());
+    #pragma omp for schedule(dynamic,100)
+    for (int u = 0; u < nodes; u++) {
+      const int u_end = offsets_[u + 1];
+      for (int p = higher_[u]; p < u_end; p++) {
+        const int v = nbrs_[p];
+        const int v_end = offsets_[v + 1];
+        // Triangles (u, v, w) with u < v < w are the common higher neighbors
+        int q = p + 1, r = higher_[v];
+        while (q < u_end && r < v_end) {
+          if (nbrs_[q] < nbrs_[r]) {
+            q++;
+          } else if (nbrs_[q] > nbrs_[r]) {
+            r++;
+          } else {
+            if (match[dirs_[p].Val | (dirs_[r].Val << 2) | (dirs_[q].Val << 4)]) {
+              buffer[p] += 1;
+              buffer[q] += 1;
+              buffer[r] += 1;
+            }
+            q++;
+            r++;
           }
         }
       }
     }
   }
+  ReduceEdgeWeights(buffers);
 }
 
-/////////////////////////////////////////////////
-// Wedge weighting
-void MotifCluster::WedgeMotifAdjacency(PNGraph graph, MotifType motif,
-                                       WeightVH& weights) {
-  for (TNGraph::TNodeI NI = graph->BegNI(); NI < graph->EndNI(); NI++) {
-    int center = NI.GetId();
-    
-    // Get all neighbors
-    TIntV neighbors;
-    for (int i = 0; i < NI.GetOutDeg(); i++) {
-      int nbr = NI.GetOutNId(i);
-      neighbors.Add(nbr);
-    }
-    for (int i = 0; i < NI.GetInDeg(); i++) {
-      int nbr = NI.GetInNId(i);
-      if (!NI.IsOutNId(nbr)) {
-        neighbors.Add(nbr);
+void TriadMotifWeighter::WedgeWeights(const bool* match) {
+  const int nodes = GetNodes();
+  TVec<TIntV> buffers(GetMotifThreads());
+  pair_weights_.Gen(nodes);
+  #pragma omp parallel
+  {
+    TIntV& buffer = buffers[GetMotifThreadN()];
+    buffer.Gen(nbrs_.Len());
+    TIntV adjacent(nodes);  // a if the node is a neighbor of a
+    adjacent.PutAll(-1);
+    TIntV counts(nodes);    // number of wedges between a and the node
+    TIntV touched;
+    #pragma omp for schedule(dynamic,100)
+    for (int a = 0; a < nodes; a++) {
+      const int a_end = offsets_[a + 1];
+      for (int k = offsets_[a]; k < a_end; k++) { adjacent[nbrs_[k]] = a; }
+      // Wedges (a, c, b) with center c and nonadjacent endpoints a < b
+      for (int k = offsets_[a]; k < a_end; k++) {
+        const int c = nbrs_[k];
+        const int ca = SwapDirs(dirs_[k]);
+        const int c_end = offsets_[c + 1];
+        for (int j = GetFirstAbove(nbrs_, offsets_[c], c_end, a); j < c_end; j++) {
+          const int b = nbrs_[j];
+          if (adjacent[b] == a || !match[ca | (dirs_[j].Val << 2)]) { continue; }
+          buffer[k] += 1;
+          buffer[j] += 1;
+          if (counts[b] == 0) { touched.Add(b); }
+          counts[b] += 1;
+        }
+      }
+      TIntPrV& row = pair_weights_[a];
+      row.Gen(touched.Len(), 0);
+      for (int t = 0; t < touched.Len(); t++) {
+        row.Add(TIntPr(touched[t], counts[touched[t]]));
+        counts[touched[t]] = 0;
       }
+      touched.Clr(false);
     }
+  }
+  ReduceEdgeWeights(buffers);
+}
 
-    for (int ind1 = 0; ind1 < neighbors.Len(); ind1++) {
-      for (int ind2 = ind1 + 1; ind2 < neighbors.Len(); ind2++) {
-        int dst1 = neighbors[ind1];
-        int dst2 = neighbors[ind2];
-        bool motif_occurs = false;
-        switch (motif) {
-        case M8:
-          motif_occurs = IsMotifM8(graph, center, dst1, dst2);
-          break;
-        case M9:
-          motif_occurs = IsMotifM9(graph, center, dst1, dst2);
-          break;
-        case M10:
-          motif_occurs = IsMotifM10(graph, center, dst1, dst2);
-          break;
-        case M11:
-          motif_occurs = IsMotifM11(graph, center, dst1, dst2);
-          break;
-        case M12:
-          motif_occurs = IsMotifM12(graph, center, dst1, dst2);
-          break;
-        case M13:
-          motif_occurs = IsMotifM13(graph, center, dst1, dst2);
-          break;
-        default:
-          TExcept::Throw("Unknown directed wedge motif");
-        }
-        // Increment weights of (center, dst1, dst2) if it occurs.
-        if (motif_occurs) {
-          IncrementWeight(center, dst1, weights);
-          IncrementWeight(center, dst2, weights);
-          IncrementWeight(dst1,   dst2, weights);
-        }
+void TriadMotifWeighter::ReduceEdgeWeights(const TVec<TIntV>& buffers) {
+  #pragma omp parallel for schedule(static)
+  for (int pos = 0; pos < nbrs_.Len(); pos++) {
+    int weight = 0;
+    for (int t = 0; t < buffers.Len(); t++) {
+      if (buffers[t].Empty()) { continue; }
+      weight += buffers[t][pos] + buffers[t][rev_[pos]];
+    }
+    edge_weights_[pos] = weight;
+  }
+}
+
+void TriadMotifWeighter::GetMatrix(TSparseColMatrix& W) const {
+  const int nodes = GetNodes();
+  W.RowN = nodes;
+  W.ColN = nodes;
+  W.ColSpVV.Gen(nodes);
+  #pragma omp parallel for schedule(dynamic,1000)
+  for (int i = 0; i < nodes; i++) {
+    TIntFltKdV& col = W.ColSpVV[i];
+    for (int pos = offsets_[i]; pos < offsets_[i + 1]; pos++) {
+      if (edge_weights_[pos] > 0) {
+        col.Add(TIntFltKd(nbrs_[pos], edge_weights_[pos].Val));
       }
     }
   }
+  for (int a = 0; a < pair_weights_.Len(); a++) {
+    const TIntPrV& row = pair_weights_[a];
+    for (int t = 0; t < row.Len(); t++) {
+      W.ColSpVV[a].Add(TIntFltKd(row[t].Val1, row[t].Val2.Val));
+      W.ColSpVV[row[t].Val1].Add(TIntFltKd(a, row[t].Val2.Val));
+    }
+  }
 }
 
+void TriadMotifWeighter::GetWeights(WeightVH& weights) const {
+  for (int i = 0; i < GetNodes(); i++) {
+    for (int pos = higher_[i]; pos < offsets_[i + 1]; pos++) {
+      if (edge_weights_[pos] > 0) {
+        int src = nids_[i], dst = nids_[nbrs_[pos]];
+        weights[MIN(src, dst)](MAX(src, dst)) = edge_weights_[pos];
+      }
+    }
+  }
+  for (int a = 0; a < pair_weights_.Len(); a++) {
+    const TIntPrV& row = pair_weights_[a];
+    for (int t = 0; t < row.Len(); t++) {
+      int src = nids_[a], dst = nids_[row[t].Val1];
+      weights[MIN(src, dst)](MAX(src, dst)) = row[t].Val2;
+    }
+  }
+}
 
 /////////////////////////////////////////////////
 // Bifan weighting
@@ -440,20 +679,6 @@ void MotifCluster::SemicliqueMotifAdjacency(PUNGraph graph, WeightVH& weights) {
 
 /////////////////////////////////////////////////
 // Simple edge weighting
-void MotifCluster::EdgeMotifAdjacency(PNGraph graph, WeightVH& weights) {
-  for (TNGraph::TEdgeI it = graph->BegEI(); it < graph->EndEI(); it++) {
-    int src = it.GetSrcNId();    
-    int dst = it.GetDstNId();
-    if (src == dst) {
-      continue;
-    }
-    // Only count reciprocated edges if src < dst
-    if (!graph->IsEdge(dst, src) || src < dst) {
-      IncrementWeight(src, dst, weights);
-    }
-  }
-}
-
 void MotifCluster::EdgeMotifAdjacency(PUNGraph graph, WeightVH& weights) {
   for (TUNGraph::TEdgeI it = graph->BegEI(); it < graph->EndEI(); it++) {
     int src = it.GetSrcNId();    
@@ -479,22 +704,21 @@ void MotifCluster::MotifAdjacency(PNGraph graph, MotifType motif,
   case M5:
   case M6:
   case M7:
-    TriangleMotifAdjacency(graph, motif, weights);
-    break;
   case M8:
   case M9:
   case M10:
   case M11:
   case M12:
   case M13:
-    WedgeMotifAdjacency(graph, motif, weights);
-    break;    
+  case edge: {
+    TriadMotifWeighter tmw(graph);
+    tmw.Run(motif);
+    tmw.GetWeights(weights);
+    break;
+  }
   case bifan:
     BifanMotifAdjacency(graph, weights);
     break;
-  case edge:
-    EdgeMotifAdjacency(graph, weights);
-    break;
   default:
     TExcept::Throw("Unknown directed motif type");
   }
@@ -701,9 +925,18 @@ void ChibaNishizekiWeighter::CliqueEnum(int k, const TIntV& U) {
 void MotifCluster::GetMotifCluster(PNGraph graph, MotifType motif,
 				   TSweepCut& sweepcut, double tol,
 				   int maxiter) {
-  WeightVH weights;
-  MotifAdjacency(graph, motif, weights);
-  SpectralCut(weights, sweepcut, tol, maxiter);
+  if (motif == bifan) {
+    WeightVH weights;
+    MotifAdjacency(graph, motif, weights);
+    SpectralCut(weights, sweepcut, tol, maxiter);
+    return;
+  }
+  // Triad motifs and edges: build the matrix directly from the edge weights
+  TriadMotifWeighter tmw(graph);
+  tmw.Run(motif);
+  TSparseColMatrix W;
+  tmw.GetMatrix(W);
+  SpectralCut(W, tmw.GetNIdV(), sweepcut, tol, maxiter);
 }
 
 void MotifCluster::GetMotifCluster(PUNGraph graph, MotifType motif,
@@ -767,46 +1000,6 @@ double MotifCluster::NFiedlerVector(const TSparseColMatrix& W, TFltV& fvec,
   return evals[1] - 1;
 }
 
-// Given a vector of hashmaps representing weights in a graph, construct the
-// undirected, unweighted. graph with the same network structure.
-static PUNGraph UnweightedGraphRepresentation(const WeightVH& weights) {
-  int num_edges = 0;
-  for (int i = 0; i < weights.Len(); i++) {
-    num_edges += weights[i].Len();
-  }
-  PUNGraph graph = TUNGraph::New(weights.Len(), num_edges);
-  for (int i = 0; i < weights.Len(); i++) {
-    graph->AddNode(i);
-  }
-  for (int i = 0; i < weights.Len(); i++) {
-    const THash<TInt, TInt>& edge_list = weights[i];
-    for (THash<TInt, TInt>::TIter it = edge_list.BegI(); it < edge_list.EndI();
-	 it++) {    
-      graph->AddEdge(i, it->Key);
-    }
-  }
-
-  return graph;
-}
-
-// Maps a vector of unique ids to 0, 1, ..., num_ids - 1.  Sets up data
-// structures id_map and rev_id_map so that
-//     id_map[original_id] = new_id
-//     rev_id_map[new_id]  = original_id
-static void MapIdsToFirstN(const TIntV& ids, THash<TInt, TInt>& id_map,
-                           TIntV& rev_id_map) {
-  id_map = THash<TInt, TInt>();
-  rev_id_map = TIntV(ids.Len());
-  for (int i = 0; i < ids.Len(); i++) {
-    int id = ids[i];
-    if (id_map.IsKey(id)) {
-      TExcept::Throw("List of ids is not unique.");
-    }
-    id_map(id) = i;
-    rev_id_map[i] = id;
-  }
-}
-
 // Run a sweep cut on the network represented by W and Fiedler vector fvec,
 // storing the conductances from the sweep in conds and the order of the nodes
 // in order.
@@ -870,62 +1063,97 @@ static void Sweep(const TSparseColMatrix& W, const TFltV& fvec, TFltV& conds,
 
 void MotifCluster::SpectralCut(const WeightVH& weights, TSweepCut& sweepcut,
 			       double tol, int maxiter) {
-  // Form graph and get maximum component
-  PUNGraph graph = UnweightedGraphRepresentation(weights);
-  TCnComV components;
-  TSnap::GetWccs(graph, components);
-  int max_wcc_size = 0;
-  int max_wcc_ind = -1;
-  for (int i = 0; i < components.Len(); i++) {
-    int size = components[i].Len();
-    if (size > max_wcc_size) {
-      max_wcc_size = size;
-      max_wcc_ind = i;
+  // Form the symmetric matrix over the node ids 0, 1, ..., weights.Len() - 1
+  int N = weights.Len();
+  TVec<TIntFltKdV> matrix_entries(N);
+  for (int i = 0; i < N; i++) {
+    const THash<TInt, TInt>& edge_list = weights[i];
+    for (THash<TInt, TInt>::TIter it = edge_list.BegI(); it < edge_list.EndI();
+	 it++) {
+      int j = it->Key;
+      int val = it->Dat;
+      matrix_entries[i].Add(TIntFltKd(j, val));
+      matrix_entries[j].Add(TIntFltKd(i, val));
     }
   }
-  TCnCom comp = components[max_wcc_ind];
+  TSparseColMatrix W(matrix_entries, N, N);
+  TIntV nids(N);
+  for (int i = 0; i < N; i++) {
+    nids[i] = i;
+  }
+  SpectralCut(W, nids, sweepcut, tol, maxiter);
+}
+
+void MotifCluster::SpectralCut(const TSparseColMatrix& W, const TIntV& nids,
+			       TSweepCut& sweepcut, double tol, int maxiter) {
+  // Get the largest connected component of the nonzero pattern of W
+  int N = W.GetCols();
+  TIntV comp_ids(N);
+  comp_ids.PutAll(-1);
+  TIntV queue;
+  int max_comp_size = 0;
+  int max_comp_id = -1;
+  for (int src = 0; src < N; src++) {
+    if (comp_ids[src] != -1) { continue; }
+    queue.Clr(false);
+    queue.Add(src);
+    comp_ids[src] = src;
+    for (int head = 0; head < queue.Len(); head++) {
+      const TIntFltKdV& col = W.ColSpVV[queue[head]];
+      for (int ind = 0; ind < col.Len(); ind++) {
+        int nbr = col[ind].Key;
+        if (comp_ids[nbr] == -1) {
+          comp_ids[nbr] = src;
+          queue.Add(nbr);
+        }
+      }
+    }
+    if (queue.Len() > max_comp_size) {
+      max_comp_size = queue.Len();
+      max_comp_id = src;
+    }
+  }
+
+  // Map largest connected component to a matrix, keeping track of ids.
+  TIntV id_map(N);
+  TIntV rev_id_map;
+  for (int i = 0; i < N; i++) {
+    id_map[i] = -1;
+    if (comp_ids[i] == max_comp_id) {
+      id_map[i] = rev_id_map.Add(i);
+    }
+  }
+  TCnCom comp;
+  for (int i = 0; i < rev_id_map.Len(); i++) {
+    comp.Add(nids[rev_id_map[i]]);
+  }
   sweepcut.component = comp;
-  if (comp.Len() == 1) {
+  if (comp.Len() <= 1) {
     printf("WARNING: No non-trivial connected components "
 	   "(likely due to no instances of the motif)\n");
     sweepcut.cond = 0;
     sweepcut.eig = 0;
     return;
   }
-  
-
-  // Map largest connected component to a matrix, keeping track of ids.
-  THash<TInt, TInt> id_map;
-  TIntV rev_id_map;
-  MapIdsToFirstN(comp.NIdV, id_map, rev_id_map);
 
   TVec<TIntFltKdV> matrix_entries(comp.Len());
-  for (int ind1 = 0; ind1 < comp.Len(); ++ind1) {
-    int c_ind = comp[ind1];
-    const THash<TInt, TInt>& edge_list = weights[c_ind];
-    int i_ind = id_map(c_ind);
+  for (int i_ind = 0; i_ind < comp.Len(); ++i_ind) {
+    const TIntFltKdV& W_col = W.ColSpVV[rev_id_map[i_ind]];
     TIntFltKdV& col = matrix_entries[i_ind];
-    for (THash<TInt, TInt>::TIter it = edge_list.BegI(); it < edge_list.EndI();
-	 it++) {
-      int ind2 = it->Key;
-      int val = it->Dat;
-      if (comp.IsNIdIn(ind2)) {
-        int j_ind = id_map(ind2);
-        col.Add(TIntFltKd(j_ind, val));
-        // Add symmetric part
-        matrix_entries[j_ind].Add(TIntFltKd(i_ind, val));
-      }
+    col.Gen(W_col.Len(), 0);
+    for (int ind = 0; ind < W_col.Len(); ind++) {
+      col.Add(TIntFltKd(id_map[W_col[ind].Key], W_col[ind].Dat));
     }
   }
 
   // Get Fiedler vector and run the sweep
-  TSparseColMatrix W(matrix_entries, comp.Len(), comp.Len());
+  TSparseColMatrix W_comp(matrix_entries, comp.Len(), comp.Len());
   TFltV fvec;
-  sweepcut.eig = NFiedlerVector(W, fvec, tol, maxiter);
+  sweepcut.eig = NFiedlerVector(W_comp, fvec, tol, maxiter);
 
   TFltV conds;
   TIntV order;
-  Sweep(W, fvec, conds, order);
+  Sweep(W_comp, fvec, conds, order);
   sweepcut.sweep_profile = conds;
 
   // Extract the cluster
@@ -947,7 +1175,7 @@ void MotifCluster::SpectralCut(const WeightVH& weights, TSweepCut& sweepcut,
     end = conds.Len() + 1;
   }
   for (int i = start; i < end; i++) {
-    cluster.Add(rev_id_map[order[i]]);    
+    cluster.Add(nids[rev_id_map[order[i]]]);
   }
   sweepcut.cluster = cluster;
 }
@@ -80,6 +80,12 @@ class MotifCluster {
   static void SpectralCut(const WeightVH& weights, TSweepCut& sweepcut,
 			  double tol=kDefaultTol, int maxiter=kMaxIter);
 
+  // Same as above for a network given by the symmetric nonnegative matrix W,
+  // where row and column i correspond to the node with id nids[i].
+  static void SpectralCut(const TSparseColMatrix& W, const TIntV& nids,
+			  TSweepCut& sweepcut, double tol=kDefaultTol,
+			  int maxiter=kMaxIter);
+
   // Compute the normalized Fiedler vector for the normalized Laplacian of the
   // graph corresponding to the nonnegative matrix W and store the result in
   // fvec.  The normalized Fiedler vector is the eigenvector corresponding to
@@ -124,18 +130,8 @@ class MotifCluster {
 
  private:
   // Handles MotifAdjacency() functionality for simple edges..
-  static void EdgeMotifAdjacency(PNGraph graph, WeightVH& weights);
   static void EdgeMotifAdjacency(PUNGraph graph, WeightVH& weights);  
 
-  
-  // Handles MotifAdjacency() functionality for directed triangle motifs.
-  static void TriangleMotifAdjacency(PNGraph graph, MotifType motif,
-                              WeightVH& weights);
-
-  // Handles MotifAdjacency() functionality for directed wedges.
-  static void WedgeMotifAdjacency(PNGraph graph, MotifType motif,
-				  WeightVH& weights);  
-
   // Handles MotifAdjacency() functionality for the bifan motif.
   static void BifanMotifAdjacency(PNGraph graph, WeightVH& weights);
 
@@ -147,6 +143,56 @@ class MotifCluster {
 				   WeightVH& weights);
 };
 
+// Helper class for the motif adjacency weights of the directed triangle motifs
+// M1-M7, the directed wedge motifs M8-M13 and of simple edges.  The graph is
+// flattened once into sorted adjacency lists over the nodes ranked by degree,
+// and every adjacency entry keeps a bitmask of the edge directions.  Triangles
+// are listed once from their lowest ranked node by merging adjacency lists,
+// and wedges once from their lowest ranked endpoint, so the motif of each
+// instance is read from a table indexed by the direction bitmasks of its edges
+// instead of being tested with edge lookups.  Nodes are processed in parallel
+// and the edge weights are accumulated into thread-local buffers.
+class TriadMotifWeighter {
+ public:
+  TriadMotifWeighter(PNGraph graph);
+
+  // Form motif adjacency weights for the motif (M1-M13 or edge)
+  void Run(MotifType motif);
+
+  // Number of nodes and node id of the node with the given rank
+  int GetNodes() const { return nids_.Len(); }
+  int GetNId(int rank) const { return nids_[rank]; }
+  // Node ids by rank, the row and column order of GetMatrix()
+  const TIntV& GetNIdV() const { return nids_; }
+
+  // Get the symmetric motif adjacency matrix, indexed by node rank
+  void GetMatrix(TSparseColMatrix& W) const;
+
+  // Set the weights indexed by node id, as in MotifCluster::MotifAdjacency().
+  // The weights vector must have an entry for every node id.
+  void GetWeights(WeightVH& weights) const;
+
+ private:
+  // Direction bits of an adjacency entry of node x for the neighbor y
+  enum { kOutEdge = 1, kInEdge = 2 };
+
+  void TriangleWeights(const bool* match);
+  void WedgeWeights(const bool* match);
+
+  // Adds the thread-local buffers into edge_weights_ for both entries of
+  // every edge
+  void ReduceEdgeWeights(const TVec<TIntV>& buffers);
+
+  TIntV nids_;           // node id by rank
+  TIntV offsets_;        // neighbors of rank i are at offsets_[i]..offsets_[i+1]-1
+  TIntV higher_;         // position of the first neighbor with a higher rank
+  TIntV nbrs_;           // neighbor ranks, sorted in each list
+  TUChV dirs_;           // direction bits of each adjacency entry
+  TIntV rev_;            // position of the entry for the same edge at the neighbor
+  TIntV edge_weights_;   // motif weight of the edge of each adjacency entry
+  TVec<TIntPrV> pair_weights_;  // (rank j, weight) of nonadjacent pairs i < j
+};
+
 // Helper Class for doing undirected clique adjacency matrix weighting.  Uses
 // the Chiba & Nishizeki algorithm with (k-1)-core preprocessing.  See:
 //
@@ -1,13 +1,295 @@
 #include "stdafx.h"
 #include "n2v.h"
 
+//Walks travel between threads in batches of node indices, every walk is terminated by -1
+const int WalkBatchWalks = 64;
+
+//Encodes walks for the spill file, every index+1 as a varint and 0 at the end of a walk
+static void GetWalkSpillBf(const TIntV& WalkV, TVec<uchar>& BfV) {
+  BfV.Gen(WalkV.Len()*2, 0);
+  for (int i = 0; i < WalkV.Len(); i++) {
+    uint64 Val = WalkV[i] + 1;
+    while (Val >= 0x80) { BfV.Add(uchar(Val & 0x7f) | 0x80);  Val >>= 7; }
+    BfV.Add(uchar(Val));
+  }
+}
+
+void SaveWalkSpill(const PSOut& SOut, const TIntV& WalkV) {
+  TVec<uchar> BfV;
+  GetWalkSpillBf(WalkV, BfV);
+  SOut->PutBf(BfV.BegI(), BfV.Len());
+}
+
+bool LoadWalkSpill(const PSIn& SIn, TIntV& WalkV) {
+  if (SIn->Eof()) { return false; }
+  int64 Val = 0;
+  int Shift = 0;
+  while (true) {
+    const uchar Ch = (uchar) SIn->GetCh();
+    Val |= int64(Ch & 0x7f) << Shift;
+    Shift += 7;
+    if ((Ch & 0x80) != 0) { continue; }
+    if (Val == 0) { break; }
+    WalkV.Add((int) (Val-1));
+    Val = 0;  Shift = 0;
+  }
+  WalkV.Add(-1);
+  return true;
+}
+
+#ifdef USE_OPENMP
+//Bounded queue of walk batches, filled by walk generating threads and drained by training threads.
+//Push blocks while the queue is full and Pop while it is empty and not closed. A blocked thread
+//retries a few times and then sleeps for a millisecond between retries, so waiting consumers do
+//not keep their cores busy while the producers are slow.
+class TWalkBatchQueue {
+private:
+  TVec<TIntV> BatchV;       //ring buffer, batch buffers are recycled by swapping
+  int Head, Len;
+  bool Closed;
+  omp_lock_t Lock;
+private:
+  TWalkBatchQueue(const TWalkBatchQueue&);
+  TWalkBatchQueue& operator = (const TWalkBatchQueue&);
+  static void Wait(int& Tries) { Tries++;  if (Tries > 16) { TSysProc::Sleep(1); } }
+public:
+  TWalkBatchQueue(const int& Capacity) : BatchV(Capacity), Head(0), Len(0), Closed(false) { omp_init_lock(&Lock); }
+  ~TWalkBatchQueue() { omp_destroy_lock(&Lock); }
+  //Moves WalkV into the queue, waits while the queue is full. WalkV gets an empty recycled buffer.
+  void Push(TIntV& WalkV) {
+    for (int Tries = 0; ; Wait(Tries)) {
+      omp_set_lock(&Lock);
+      const bool Done = Len < BatchV.Len();
+      if (Done) {
+        BatchV[(Head+Len) % BatchV.Len()].Swap(WalkV);
+        Len++;
+      }
+      omp_unset_lock(&Lock);
+      if (Done) { break; }
+    }
+    WalkV.Clr(false);
+  }
+  //Moves the oldest batch into WalkV, waits while the queue is empty. Returns false once the queue is closed and empty.
+  bool Pop(TIntV& WalkV) {
+    for (int Tries = 0; ; Wait(Tries)) {
+      omp_set_lock(&Lock);
+      const bool Done = Len > 0, Empty = ! Done && Closed;
+      if (Done) {
+        BatchV[Head].Swap(WalkV);
+        Head = (Head+1) % BatchV.Len();
+        Len--;
+      }
+      omp_unset_lock(&Lock);
+      if (Done) { return true; }
+      if (Empty) { return false; }
+    }
+  }
+  //No more batches will be pushed
+  void Close() {
+    omp_set_lock(&Lock);
+    Closed = true;
+    omp_unset_lock(&Lock);
+  }
+};
+#endif
+
+//Source of walks for the streaming pipeline, generates them or reads them back from a spill file.
+//Walks hold node indices, the spill file is written by SaveWalkSpill and read by LoadWalkSpill.
+class TWalkStream {
+private:
+  PWNet Net;
+  const TRejectionWalker* Walker;
+  const TIntV& NIdV;
+  const TIntIntH& NIdIdxH;
+  int WalkLen;
+  int NumWalks;
+  TVec<TInt64> PermAV, PermBV;   //walk j of round r starts at node index (PermAV[r]*j+PermBV[r]) % nodes
+  TInt64 NextWalk;
+  PSIn SpillIn;
+private:
+  static int64 GetGcd(int64 A, int64 B) { while (B != 0) { const int64 C = A % B;  A = B;  B = C; }  return A; }
+public:
+  TWalkStream(const PWNet& InNet, const TRejectionWalker* _Walker, const TIntV& _NIdV,
+    const TIntIntH& _NIdIdxH, const int& _WalkLen, const int& _NumWalks) : Net(InNet),
+    Walker(_Walker), NIdV(_NIdV), NIdIdxH(_NIdIdxH), WalkLen(_WalkLen), NumWalks(_NumWalks),
+    PermAV(), PermBV(), NextWalk(0), SpillIn() { }
+  //Starts a pass that generates NumWalks walks from every node, in a random order in each round
+  void StartGen(TRnd& Rnd) {
+    const int64 Nodes = NIdV.Len();
+    PermAV.Gen(NumWalks);  PermBV.Gen(NumWalks);
+    for (int r = 0; r < NumWalks; r++) {
+      do { PermAV[r] = Rnd.GetUniDevInt64(Nodes-1) + 1; } while (Nodes > 1 && GetGcd(PermAV[r], Nodes) != 1);
+      PermBV[r] = Rnd.GetUniDevInt64(Nodes);
+    }
+    NextWalk = 0;
+    SpillIn.Clr();
+  }
+  //Starts a pass that reads the walks back from the spill file FNm
+  void StartRead(const TStr& FNm) { SpillIn = TZipIn::NewIfZip(FNm); }
+  //Fills WalkV with the next batch of walks, returns false at the end of the pass. Thread safe.
+  bool GetBatch(TIntV& WalkV, TRnd& Rnd) {
+    WalkV.Clr(false);
+    if (! SpillIn.Empty()) {
+      bool More = true;
+#pragma omp critical(WalkSpillIn)
+      {
+        for (int w = 0; w < WalkBatchWalks && More; w++) { More = LoadWalkSpill(SpillIn, WalkV); }
+      }
+      return ! WalkV.Empty();
+    }
+    const int64 Nodes = NIdV.Len();
+    const int64 AllWalks = NumWalks * Nodes;
+#ifdef USE_OPENMP
+    const int64 First = __sync_fetch_and_add(&NextWalk.Val, (int64) WalkBatchWalks);
+#else
+    const int64 First = NextWalk;
+    NextWalk += WalkBatchWalks;
+#endif
+    if (First >= AllWalks) { return false; }
+    TIntV NIdWalkV;
+    for (int64 w = First; w < TMath::Mn(First + WalkBatchWalks, AllWalks); w++) {
+      const int64 Round = w / Nodes;
+      const int64 StartNId = NIdV[(int) ((PermAV[(int) Round] * (w % Nodes) + PermBV[(int) Round]) % Nodes)];
+      NIdWalkV.Clr(false);
+      if (Walker != NULL) {
+        Walker->SimulateWalk(StartNId, WalkLen, Rnd, NIdWalkV);
+      } else {
+        SimulateWalk(Net, StartNId, WalkLen, Rnd, NIdWalkV);
+      }
+      for (int k = 0; k < NIdWalkV.Len(); k++) { WalkV.Add(NIdIdxH.GetDat(NIdWalkV[k])); }
+      WalkV.Add(-1);
+    }
+    return true;
+  }
+};
+
+//Appends a batch of walks to the spill file
+static void PutSpillBatch(const PSOut& SpillOut, const TIntV& WalkV) {
+  TVec<uchar> BfV;
+  GetWalkSpillBf(WalkV, BfV);
+#pragma omp critical(WalkSpillOut)
+  {
+    SpillOut->PutBf(BfV.BegI(), BfV.Len());
+  }
+}
+
+static void TrainWalkBatch(TSkipGram& SkipGram, const TIntV& WalkV, TRnd& Rnd) {
+  for (int i = 0; i < WalkV.Len(); ) {
+    int j = i;
+    while (WalkV[j] != -1) { j++; }
+    SkipGram.TrainWalk(WalkV.BegI() + i, j - i, Rnd);
+    i = j + 1;
+  }
+}
+
+//Streaming node2vec: walk generating threads push batches of walks into a bounded queue
+//and training threads consume them right away, so walks are never materialized and
+//memory does not depend on the number of walks. Negative sampling needs the word counts
+//up front, they come from a first pass that only generates and counts walks. It is cheap
+//next to training, and its walks are written to WalksFNm if given, so that all epochs read
+//them back. Without the spill file every epoch trains on freshly generated walks.
+static void StreamEmbeddings(PWNet& InNet, const TRejectionWalker* Walker,
+  const int& Dimensions, const int& WalkLen, const int& NumWalks, const int& WinSize,
+  const int& Iter, const bool& Verbose, const TStr& WalksFNm, TIntFltVH& EmbeddingsHV) {
+  TIntV NIdV;
+  TIntIntH NIdIdxH;
+  for (TWNet::TNodeI NI = InNet->BegNI(); NI < InNet->EndNI(); NI++) {
+    NIdIdxH.AddDat(NI.GetId(), NIdV.Len());
+    NIdV.Add(NI.GetId());
+  }
+  if (NIdV.Empty()) { return; }
+  TRnd Rnd(time(NULL));
+#ifdef USE_OPENMP
+  const int Threads = omp_get_max_threads();
+#else
+  const int Threads = 1;
+#endif
+  TVec<TRnd> RndV(Threads);
+  for (int t = 0; t < Threads; t++) { RndV[t].PutSeed(Rnd.GetUniDevInt(1, TInt::Mx-1)); }
+  TWalkStream Stream(InNet, Walker, NIdV, NIdIdxH, WalkLen, NumWalks);
+  //counting pass
+  TIntV Vocab(NIdV.Len());
+  {
+    PSOut SpillOut;
+    if (! WalksFNm.Empty()) { SpillOut = TZipOut::NewIfZip(WalksFNm); }
+    Stream.StartGen(Rnd);
+#pragma omp parallel num_threads(Threads)
+    {
+#ifdef USE_OPENMP
+      TRnd& ThreadRnd = RndV[omp_get_thread_num()];
+#else
+      TRnd& ThreadRnd = RndV[0];
+#endif
+      TIntV WalkV;
+      while (Stream.GetBatch(WalkV, ThreadRnd)) {
+        if (! SpillOut.Empty()) { PutSpillBatch(SpillOut, WalkV); }
+        for (int i = 0; i < WalkV.Len(); i++) {
+          if (WalkV[i] == -1) { continue; }
+#ifdef USE_OPENMP
+          __sync_fetch_and_add(&Vocab[WalkV[i]].Val, 1);
+#else
+          Vocab[WalkV[i]]++;
+#endif
+        }
+      }
+    }
+  }
+  int64 Words = 0;
+  for (int i = 0; i < Vocab.Len(); i++) { Words += Vocab[i]; }
+  TSkipGram SkipGram(Vocab, Dimensions, WinSize, Iter*Words, Verbose, Rnd);
+  for (int Pass = 0; Pass < Iter; Pass++) {
+    if (WalksFNm.Empty()) {
+      Stream.StartGen(Rnd);
+    } else {
+      Stream.StartRead(WalksFNm);
+    }
+#ifdef USE_OPENMP
+    TWalkBatchQueue Queue(4*Threads);
+    int ProducersDone = 0;
+#pragma omp parallel num_threads(Threads)
+    {
+      const int ThreadN = omp_get_thread_num();
+      const int TeamThreads = omp_get_num_threads();
+      //walk generation is much cheaper than training, one producer per eight threads
+      const int Producers = TMath::Mx(1, TeamThreads/8);
+      TRnd& ThreadRnd = RndV[ThreadN];
+      TIntV WalkV;
+      if (TeamThreads < 2) {
+        while (Stream.GetBatch(WalkV, ThreadRnd)) { TrainWalkBatch(SkipGram, WalkV, ThreadRnd); }
+      } else if (ThreadN < Producers) {
+        while (Stream.GetBatch(WalkV, ThreadRnd)) { Queue.Push(WalkV); }
+        if (__sync_add_and_fetch(&ProducersDone, 1) == Producers) { Queue.Close(); }
+      } else {
+        while (Queue.Pop(WalkV)) { TrainWalkBatch(SkipGram, WalkV, ThreadRnd); }
+      }
+    }
+#else
+    TIntV WalkV;
+    while (Stream.GetBatch(WalkV, RndV[0])) { TrainWalkBatch(SkipGram, WalkV, RndV[0]); }
+#endif
+  }
+  if (Verbose) { printf("\n"); fflush(stdout); }
+  SkipGram.GetEmbeddings(NIdV, EmbeddingsHV);
+}
+
 void node2vec(PWNet& InNet, const double& ParamP, const double& ParamQ,
   const int& Dimensions, const int& WalkLen, const int& NumWalks,
   const int& WinSize, const int& Iter, const bool& Verbose,
   const bool& OutputWalks, TVVec<TInt, int64>& WalksVV,
-  TIntFltVH& EmbeddingsHV) {
-  //Preprocess transition probabilities
-  PreprocessTransitionProbs(InNet, ParamP, ParamQ, Verbose);
+  TIntFltVH& EmbeddingsHV, const bool& RejectSampling, const TStr& WalksFNm) {
+  //Preprocess transition probabilities, or only first order tables for rejection sampling
+  TRejectionWalker* Walker = NULL;
+  if (RejectSampling) {
+    Walker = new TRejectionWalker(InNet, ParamP, ParamQ);
+  } else {
+    PreprocessTransitionProbs(InNet, ParamP, ParamQ, Verbose);
+  }
+  if (!OutputWalks) {
+    StreamEmbeddings(InNet, Walker, Dimensions, WalkLen, NumWalks, WinSize, Iter,
+     Verbose, WalksFNm, EmbeddingsHV);
+    delete Walker;
+    return;
+  }
   TIntV NIdsV;
   for (TWNet::TNodeI NI = InNet->BegNI(); NI < InNet->EndNI(); NI++) {
     NIdsV.Add(NI.GetId());
@@ -16,6 +298,12 @@ void node2vec(PWNet& InNet, const double& ParamP, const double& ParamQ,
   int64 AllWalks = (int64)NumWalks * NIdsV.Len();
   WalksVV = TVVec<TInt, int64>(AllWalks,WalkLen);
   TRnd Rnd(time(NULL));
+#ifdef USE_OPENMP
+  TVec<TRnd> RndV(omp_get_max_threads());
+#else
+  TVec<TRnd> RndV(1);
+#endif
+  for (int t = 0; t < RndV.Len(); t++) { RndV[t].PutSeed(Rnd.GetUniDevInt(1, TInt::Mx-1)); }
   int64 WalksDone = 0;
   for (int64 i = 0; i < NumWalks; i++) {
     NIdsV.Shuffle(Rnd);
@@ -24,22 +312,28 @@ void node2vec(PWNet& InNet, const double& ParamP, const double& ParamQ,
       if ( Verbose && WalksDone%10000 == 0 ) {
         printf("\rWalking Progress: %.2lf%%",(double)WalksDone*100/(double)AllWalks);fflush(stdout);
       }
+#ifdef USE_OPENMP
+      TRnd& ThreadRnd = RndV[omp_get_thread_num()];
+#else
+      TRnd& ThreadRnd = RndV[0];
+#endif
       TIntV WalkV;
-      SimulateWalk(InNet, NIdsV[j], WalkLen, Rnd, WalkV);
+      if (Walker != NULL) {
+        Walker->SimulateWalk(NIdsV[j], WalkLen, ThreadRnd, WalkV);
+      } else {
+        SimulateWalk(InNet, NIdsV[j], WalkLen, ThreadRnd, WalkV);
+      }
       for (int64 k = 0; k < WalkV.Len(); k++) { 
         WalksVV.PutXY(i*NIdsV.Len()+j, k, WalkV[k]);
       }
       WalksDone++;
     }
   }
+  delete Walker;
   if (Verbose) {
     printf("\n");
     fflush(stdout);
   }
-  //Learning embeddings
-  if (!OutputWalks) {
-    LearnEmbeddings(WalksVV, Dimensions, WinSize, Iter, Verbose, EmbeddingsHV);
-  }
 }
 
 void node2vec(PWNet& InNet, const double& ParamP, const double& ParamQ,
@@ -57,7 +351,7 @@ void node2vec(const PNGraph& InNet, const double& ParamP, const double& ParamQ,
   const int& Dimensions, const int& WalkLen, const int& NumWalks,
   const int& WinSize, const int& Iter, const bool& Verbose,
   const bool& OutputWalks, TVVec<TInt, int64>& WalksVV,
-  TIntFltVH& EmbeddingsHV) {
+  TIntFltVH& EmbeddingsHV, const bool& RejectSampling, const TStr& WalksFNm) {
   PWNet NewNet = PWNet::New();
   for (TNGraph::TEdgeI EI = InNet->BegEI(); EI < InNet->EndEI(); EI++) {
     if (!NewNet->IsNode(EI.GetSrcNId())) { NewNet->AddNode(EI.GetSrcNId()); }
@@ -65,7 +359,7 @@ void node2vec(const PNGraph& InNet, const double& ParamP, const double& ParamQ,
     NewNet->AddEdge(EI.GetSrcNId(), EI.GetDstNId(), 1.0);
   }
   node2vec(NewNet, ParamP, ParamQ, Dimensions, WalkLen, NumWalks, WinSize, Iter, 
-   Verbose, OutputWalks, WalksVV, EmbeddingsHV);
+   Verbose, OutputWalks, WalksVV, EmbeddingsHV, RejectSampling, WalksFNm);
 }
 
 void node2vec(const PNGraph& InNet, const double& ParamP, const double& ParamQ,
@@ -82,7 +376,7 @@ void node2vec(const PNEANet& InNet, const double& ParamP, const double& ParamQ,
   const int& Dimensions, const int& WalkLen, const int& NumWalks,
   const int& WinSize, const int& Iter, const bool& Verbose,
   const bool& OutputWalks, TVVec<TInt, int64>& WalksVV,
-  TIntFltVH& EmbeddingsHV) {
+  TIntFltVH& EmbeddingsHV, const bool& RejectSampling, const TStr& WalksFNm) {
   PWNet NewNet = PWNet::New();
   for (TNEANet::TEdgeI EI = InNet->BegEI(); EI < InNet->EndEI(); EI++) {
     if (!NewNet->IsNode(EI.GetSrcNId())) { NewNet->AddNode(EI.GetSrcNId()); }
@@ -90,7 +384,7 @@ void node2vec(const PNEANet& InNet, const double& ParamP, const double& ParamQ,
     NewNet->AddEdge(EI.GetSrcNId(), EI.GetDstNId(), InNet->GetFltAttrDatE(EI,"weight"));
   }
   node2vec(NewNet, ParamP, ParamQ, Dimensions, WalkLen, NumWalks, WinSize, Iter, 
-   Verbose, OutputWalks, WalksVV, EmbeddingsHV);
+   Verbose, OutputWalks, WalksVV, EmbeddingsHV, RejectSampling, WalksFNm);
 }
 
 void node2vec(const PNEANet& InNet, const double& ParamP, const double& ParamQ,
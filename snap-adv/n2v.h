@@ -8,11 +8,16 @@
 #include "word2vec.h"
 
 /// Calculates node2vec feature representation for nodes and writes them into EmbeddinsHV, see http://arxiv.org/pdf/1607.00653v1.pdf
+/// RejectSampling samples the walks with TRejectionWalker instead of precomputed (t, v) alias tables, needs O(m) memory
+/// WalksVV is only filled if OutputWalks is set. Otherwise walks are streamed into training as they are generated,
+/// without materializing them. If WalksFNm is given, the walks are also written to it (compressed if the name has
+/// a zip extension) and every epoch reads them back, otherwise every epoch trains on freshly generated walks.
 void node2vec(PWNet& InNet, const double& ParamP, const double& ParamQ,
   const int& Dimensions, const int& WalkLen, const int& NumWalks,
   const int& WinSize, const int& Iter, const bool& Verbose,
   const bool& OutputWalks, TVVec<TInt, int64>& WalksVV,
-  TIntFltVH& EmbeddingsHV); 
+  TIntFltVH& EmbeddingsHV, const bool& RejectSampling=false,
+  const TStr& WalksFNm=TStr()); 
 
 /// Version without walk output flag. For backward compatibility.
 void node2vec(PWNet& InNet, const double& ParamP, const double& ParamQ,
@@ -25,7 +30,8 @@ void node2vec(const PNGraph& InNet, const double& ParamP, const double& ParamQ,
   const int& Dimensions, const int& WalkLen, const int& NumWalks,
   const int& WinSize, const int& Iter, const bool& Verbose,
   const bool& OutputWalks, TVVec<TInt, int64>& WalksVV,
-  TIntFltVH& EmbeddingsHV); 
+  TIntFltVH& EmbeddingsHV, const bool& RejectSampling=false,
+  const TStr& WalksFNm=TStr()); 
 
 /// Version for unweighted graphs without walk output flag. For backward compatibility.
 void node2vec(const PNGraph& InNet, const double& ParamP, const double& ParamQ,
@@ -38,11 +44,18 @@ void node2vec(const PNEANet& InNet, const double& ParamP, const double& ParamQ,
   const int& Dimensions, const int& WalkLen, const int& NumWalks,
   const int& WinSize, const int& Iter, const bool& Verbose,
   const bool& OutputWalks, TVVec<TInt, int64>& WalksVV,
-  TIntFltVH& EmbeddingsHV); 
+  TIntFltVH& EmbeddingsHV, const bool& RejectSampling=false,
+  const TStr& WalksFNm=TStr()); 
 
 /// Version for weighted graphs. Edges must have TFlt attribute "weight". No walk output flag. For backward compatibility.
 void node2vec(const PNEANet& InNet, const double& ParamP, const double& ParamQ,
   const int& Dimensions, const int& WalkLen, const int& NumWalks,
   const int& WinSize, const int& Iter, const bool& Verbose,
  TIntFltVH& EmbeddingsHV);
+
+/// Appends walks to a walk spill file (WalksFNm of node2vec). WalkV holds node indices in the order of
+/// node iteration, every walk terminated by -1. Every index+1 is stored as a varint, 0 ends a walk.
+void SaveWalkSpill(const PSOut& SOut, const TIntV& WalkV);
+/// Reads the next walk of a walk spill file and appends it to WalkV, terminated by -1. Returns false at the end of the file.
+bool LoadWalkSpill(const PSIn& SIn, TIntV& WalkV);
 #endif //N2V_H
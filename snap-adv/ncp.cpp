@@ -237,6 +237,154 @@ void TLocClust::PlotNCP(const PUNGraph& Graph, const TStr& FNm, const TStr Desc,
   }
 }
 
+//////////////////////////////////////////////////
+// Batch Local Spectral Clustering
+
+static int GetNcpThreads() {
+#ifdef USE_OPENMP
+  return omp_get_max_threads();
+#else
+  return 1;
+#endif
+}
+
+static int GetNcpThreadN() {
+#ifdef USE_OPENMP
+  return omp_get_thread_num();
+#else
+  return 0;
+#endif
+}
+
+static void SiftDown(TFltIntKdV& ValV, int Pos, const int& Len) {
+  while (2*Pos+1 < Len) {
+    int Child = 2*Pos+1;
+    if (Child+1 < Len && ValV[Child] < ValV[Child+1]) { Child++; }
+    if (! (ValV[Pos] < ValV[Child])) { break; }
+    ValV.Swap(Pos, Child);
+    Pos = Child;
+  }
+}
+
+// Heap sort in increasing order, it needs no random pivots and no extra memory
+static void HeapSortAsc(TFltIntKdV& ValV) {
+  for (int i = ValV.Len()/2-1; i >= 0; i--) { SiftDown(ValV, i, ValV.Len()); }
+  for (int Len = ValV.Len()-1; Len > 0; Len--) {
+    ValV.Swap(0, Len);
+    SiftDown(ValV, 0, Len);
+  }
+}
+
+TLocClustBatch::TLocClustBatch(const PUNGraph& Graph, const double& AlphaVal) :
+  Csr(Graph), Edges2(2*Graph->GetEdges()), Alpha(AlphaVal), WorkV(GetNcpThreads()) {
+}
+
+// queues the node in the bucket of log2(residual/(eps*degree)) if the node is active
+void TLocClustBatch::Enqueue(TWork& Work, const int& KeyId, const double& Eps, int& TopBucket) const {
+  const double Thresh = Eps * Csr.GetOutDeg(Work.NIdxSet.GetKey(KeyId));
+  const double Res = Work.ResV[KeyId];
+  if (Res < Thresh) { return; }
+  const int QBucket = Work.QBucketV[KeyId];
+  if (QBucket != -1 && (QBucket+1 == Work.BucketVV.Len() || Res < Thresh * double(1ll << (QBucket+1)))) { return; } // still in its bucket
+  int Bucket;
+  frexp(Res / Thresh, &Bucket); // the ratio is in [2^(Bucket-1), 2^Bucket)
+  Bucket = TMath::Mn(Bucket-1, Work.BucketVV.Len()-1);
+  if (Bucket <= Work.QBucketV[KeyId]) { return; }
+  Work.QBucketV[KeyId] = Bucket; // an entry in a lower bucket becomes stale
+  Work.BucketVV[Bucket].Add(KeyId);
+  if (Bucket > TopBucket) { TopBucket = Bucket; }
+}
+
+void TLocClustBatch::ApproxPageRank(TWork& Work, const int& SeedNIdx, const double& Eps) const {
+  Work.NIdxSet.Clr(false);
+  Work.ProbV.Clr(false);  Work.ResV.Clr(false);  Work.QBucketV.Clr(false);  Work.RankV.Clr(false);
+  int TopBucket = -1;
+  const int SeedId = Touch(Work, SeedNIdx);
+  Work.ResV[SeedId] = 1.0;
+  if (Csr.GetOutDeg(SeedNIdx) > 0) { Enqueue(Work, SeedId, Eps, TopBucket); }
+  if (Work.QBucketV[SeedId] == -1) { // the seed is pushed even if its residual is below the threshold
+    Work.QBucketV[SeedId] = 0;  Work.BucketVV[0].Add(SeedId);  TopBucket = 0; }
+  while (TopBucket >= 0) {
+    TIntV& BucketV = Work.BucketVV[TopBucket];
+    if (BucketV.Empty()) { TopBucket--;  continue; }
+    const int KeyId = BucketV.Last();  BucketV.DelLast();
+    if (Work.QBucketV[KeyId] != TopBucket) { continue; } // stale, the node was moved to a higher bucket
+    Work.QBucketV[KeyId] = -1;
+    Work.RankV[KeyId] = 0; // pushed nodes form the support of the sweep
+    const int NIdx = Work.NIdxSet.GetKey(KeyId);
+    const int Deg = Csr.GetOutDeg(NIdx);
+    const double PushVal = Work.ResV[KeyId] - 0.5*Eps*Deg;
+    Work.ProbV[KeyId] += Alpha*PushVal;
+    Work.ResV[KeyId] = 0.5*Eps*Deg;
+    if (Deg == 0) { continue; }
+    const double PutVal = (1.0-Alpha) * PushVal / double(Deg);
+    for (const TInt* N = Csr.BegOut(NIdx); N < Csr.EndOut(NIdx); N++) {
+      const int NbrId = Touch(Work, *N);
+      Work.ResV[NbrId] += PutVal;
+      Enqueue(Work, NbrId, Eps, TopBucket);
+    }
+  }
+}
+
+void TLocClustBatch::SupportSweep(TWork& Work) const {
+  TSweep& Sweep = Work.Sweep;
+  Sweep.NIdV.Clr(false);  Sweep.VolV.Clr(false);  Sweep.CutV.Clr(false);  Sweep.PhiV.Clr(false);
+  Sweep.BestCutIdx = -1;
+  // order the support by decreasing PageRank divided by the degree
+  TFltIntKdV& OrderV = Work.OrderV;
+  OrderV.Clr(false);
+  for (int KeyId = 0; KeyId < Work.NIdxSet.Len(); KeyId++) {
+    if (Work.RankV[KeyId] != -1) {
+      OrderV.Add(TFltIntKd(-Work.ProbV[KeyId] / Csr.GetOutDeg(Work.NIdxSet.GetKey(KeyId)), KeyId)); }
+  }
+  HeapSortAsc(OrderV);
+  for (int i = 0; i < OrderV.Len(); i++) {
+    Work.RankV[OrderV[i].Dat] = i;
+    Sweep.NIdV.Add(Csr.GetNId(Work.NIdxSet.GetKey(OrderV[i].Dat)));
+  }
+  int Vol = 0, Cut = 0;
+  double MnPhi = TFlt::Mx;
+  for (int i = 0; i < OrderV.Len(); i++) {
+    const int NIdx = Work.NIdxSet.GetKey(OrderV[i].Dat);
+    const int Deg = Csr.GetOutDeg(NIdx);
+    int CutSz = Deg; // edges outside
+    for (const TInt* N = Csr.BegOut(NIdx); N < Csr.EndOut(NIdx); N++) {
+      const int NbrId = Work.NIdxSet.GetKeyId(*N);
+      if (NbrId == -1) { continue; }
+      const int Rank = Work.RankV[NbrId];
+      if (Rank > -1 && Rank < i) { CutSz -= 2; }
+    }
+    Vol += Deg;  Cut += CutSz;
+    double Phi = 1.0;
+    if (i > 0 && Vol < Edges2) {
+      if (2*Vol > Edges2) { Phi = Cut / double(Edges2-Vol); }
+      else { Phi = Cut / double(Vol); }
+    }
+    IAssert(i == 0 || (Phi+1e-6) >= 1.0/(double(i)*double(i+1)+1)); // conductance is worse than the best possible
+    Sweep.VolV.Add(Vol);  Sweep.CutV.Add(Cut);  Sweep.PhiV.Add(Phi);
+    if (Phi < MnPhi) { MnPhi = Phi;  Sweep.BestCutIdx = i; }
+  }
+}
+
+void TLocClustBatch::Run(const TIntV& SeedNIdV, const int& ClustSz, TVisitor& Visitor) {
+  const double Eps = 1.0/double(ClustSz);
+  #pragma omp parallel
+  {
+    const int ThreadN = GetNcpThreadN();
+    TWork& Work = WorkV[ThreadN];
+    if (Work.BucketVV.Empty()) { Work.BucketVV.Gen(62); }
+    #pragma omp for schedule(dynamic,1)
+    for (int s = 0; s < SeedNIdV.Len(); s++) {
+      const int SeedNIdx = Csr.GetNIdx(SeedNIdV[s]);
+      IAssertR(SeedNIdx != -1, TStr::Fmt("Seed %d is not a node of the graph", SeedNIdV[s].Val));
+      ApproxPageRank(Work, SeedNIdx, Eps);
+      SupportSweep(Work);
+      Work.Sweep.SeedNId = SeedNIdV[s];
+      Visitor.OnSweep(ThreadN, s, Work.Sweep);
+    }
+  }
+}
+
 //////////////////////////////////////////////////
 // Local Clustering Statistics
 
@@ -297,6 +445,82 @@ void TLocClustStat::Clr() {
   BagOfWhiskerV.Clr(false); // (Size, Conductance) of bag of whiskers clusters
 }
 
+// Gathers the cuts of TLocClustStat::Run() from TLocClustBatch, every thread into its own state.
+// Ties in conductance go to the later seed, as when the seeds are processed one by one.
+class TLocClustStatAcc : public TLocClustBatch::TVisitor {
+public:
+  class TThreadAcc {
+  public:
+    TFlt SumSz, SumVol, Count;
+    THash<TInt, TLocClustStat::TCutInfo> BestCutH; // best cut at size K
+    TIntH BestSeedH;                               // seed of the cut in BestCutH
+    TFlt BestPhi;                                  // best over-all cut and its seed and sweep position
+    TInt BestSeed, BestS;
+    TLocClustStat::TCutInfo BestCut;
+    THash<TInt, TFltV> SizePhiH;
+    TVec<TLocClustStat::TNodeSweep> SweepsV;
+  public:
+    TThreadAcc() : SumSz(0), SumVol(0), Count(0), BestPhi(TFlt::Mx), BestSeed(-1), BestS(-1) { }
+    void Clr() {
+      SumSz = 0;  SumVol = 0;  Count = 0;
+      BestCutH.Clr(false);  BestSeedH.Clr(false);
+      BestPhi = TFlt::Mx;  BestSeed = -1;  BestS = -1;
+      SizePhiH.Clr(false);  SweepsV.Clr(false);
+    }
+    // true if the cut (Phi, Seed, S) is better than the best over-all cut of the thread
+    bool IsBest(const double& Phi, const int& Seed, const int& S) const {
+      return BestSeed == -1 || Phi < BestPhi || (Phi == BestPhi && (Seed > BestSeed || (Seed == BestSeed && S > BestS))); }
+  };
+  TVec<TThreadAcc> AccV;
+  TInt SeedOff;            // position of the current batch in the sequence of seeds
+  bool SaveAllSweeps, SaveAllCond, SaveBestNodesAtK;
+  const TIntSet& SizeBucketSet;
+public:
+  TLocClustStatAcc(const int& Threads, const bool& _SaveAllSweeps, const bool& _SaveAllCond, const bool& _SaveBestNodesAtK,
+    const TIntSet& _SizeBucketSet) : AccV(Threads), SeedOff(0), SaveAllSweeps(_SaveAllSweeps), SaveAllCond(_SaveAllCond),
+    SaveBestNodesAtK(_SaveBestNodesAtK), SizeBucketSet(_SizeBucketSet) { }
+  void OnSweep(const int& ThreadN, const int& SeedN, const TLocClustBatch::TSweep& Sweep);
+};
+
+void TLocClustStatAcc::OnSweep(const int& ThreadN, const int& SeedN, const TLocClustBatch::TSweep& Sweep) {
+  TThreadAcc& Acc = AccV[ThreadN];
+  const int Seed = SeedOff + SeedN;
+  const int Sz = Sweep.BestCutNodes();
+  const int Vol = Sweep.GetCutVol();
+  const double Phi = TMath::Round(Sweep.GetCutPhi(), 4);
+  if (Sz == 0 || Vol == 0 || Phi == 0) { return; }
+  Acc.SumSz += Sz;  Acc.SumVol += Vol;  Acc.Count += 1;
+  if (SaveAllSweeps) { // save the full cut set and conductances for all trials
+    Acc.SweepsV.Add(TLocClustStat::TNodeSweep(Sweep.SeedNId, Sweep.NIdV, Sweep.PhiV)); }
+  int SAtBestPhi=-1;
+  for (int s = 0; s < Sweep.Len(); s++) {
+    const int size = s+1;
+    const int cut = Sweep.GetCut(s);
+    const int edges = (Sweep.GetVol(s)-cut)/2;
+    const double phi = Sweep.GetPhi(s);
+    if (phi != double(cut)/double(2*edges+cut)) { continue; } // more than half of the edges
+    IAssert((Sweep.GetVol(s) - cut) % 2 == 0);
+    IAssert(phi >= 1.0/(double(1+s)*double(s)+1));
+    if (Acc.IsBest(phi, Seed, s)) {
+      Acc.BestPhi = phi;  Acc.BestSeed = Seed;  Acc.BestS = s;
+      Acc.BestCut = TLocClustStat::TCutInfo(size, edges, cut);
+      SAtBestPhi = s;
+    }
+    const int KeyId = Acc.BestCutH.GetKeyId(size);
+    if (KeyId == -1 || Acc.BestCutH[KeyId].GetPhi() > phi || (Acc.BestCutH[KeyId].GetPhi() == phi && Acc.BestSeedH.GetDat(size) < Seed)) {
+      TLocClustStat::TCutInfo& CutInfo = Acc.BestCutH.AddDat(size);
+      CutInfo = TLocClustStat::TCutInfo(size, edges, cut);
+      Acc.BestSeedH.AddDat(size, Seed);
+      if (SaveBestNodesAtK && (SizeBucketSet.Empty() || SizeBucketSet.IsKey(size))) { // only save best clusters at SizeBucketSet
+        Sweep.NIdV.GetSubValV(0, size-1, CutInfo.CutNIdV); }
+    }
+    if (SaveAllCond) { // for every size store all conductances
+      Acc.SizePhiH.AddDat(size).Add(phi); }
+  }
+  if (SAtBestPhi != -1) { // take nodes in best cluster
+    Sweep.NIdV.GetSubValV(0, SAtBestPhi, Acc.BestCut.CutNIdV); }
+}
+
 void TLocClustStat::Run(const PUNGraph& _Graph, const bool& SaveAllSweeps, const bool& SaveAllCond, const bool& SaveBestNodesAtK) {
   Graph = TSnap::GetMxWcc(_Graph);
   const int Nodes = Graph->GetNodes();
@@ -308,7 +532,7 @@ void TLocClustStat::Run(const PUNGraph& _Graph, const bool& SaveAllSweeps, const
   printf("  SizeFrac: %g\n\n", SizeFrac());
   TExeTm TotTm;
   Clr();
-  TLocClust Clust(Graph, Alpha);
+  TLocClustBatch Clust(Graph, Alpha);
   BestCut.CutNIdV.Clr(false); 
   BestCut.CutSz=-1;  BestCut.Edges=-1;
   double BestPhi = TFlt::Mx;
@@ -324,6 +548,9 @@ void TLocClustStat::Run(const PUNGraph& _Graph, const bool& SaveAllSweeps, const
       SizeBucketSet.AddKey(int(floor(BPos) - 1));
     }
   }
+  TLocClustStatAcc StatAcc(Clust.GetThreads(), SaveAllSweeps, SaveAllCond, SaveBestNodesAtK, SizeBucketSet);
+  const int BatchSz = Mega(1)/10;
+  TIntV SeedNIdV(BatchSz, 0);
   for (int K = KMin, cnt=1; K < KMax; K = int(KFac * double(K))+1, cnt++) {
     if (K == prevK) { K++; } prevK = K;
     const int Runs = 2 + int(Coverage /**pow(1.1, cnt)*/ * floor(double(Graph->GetEdges()) / double(K)));
@@ -331,64 +558,52 @@ void TLocClustStat::Run(const PUNGraph& _Graph, const bool& SaveAllSweeps, const
     if (NextDone) { break; } // done
     if (K+1 > 2*Graph->GetEdges()) { K = Graph->GetEdges(); NextDone=true; }
     //if (K+1 > Graph->GetEdges()) { K = Graph->GetEdges(); NextDone=true; }
-    TExeTm ExeTm, IterTm;
-    double MeanSz=0.0, MeanVol=0.0, Count=0.0;
-    for (int run = 0; run < Runs; run++) {
-      const int SeedNId = Graph->GetRndNId();  IterTm.Tick();
-      Clust.FindBestCut(SeedNId, K, SizeFrac);
-      const int Sz = Clust.BestCutNodes();
-      const int Vol = Clust.GetCutVol();
-      const double Phi = TMath::Round(Clust.GetCutPhi(), 4);
-      if (Sz == 0 || Vol == 0 || Phi == 0) { continue; }
-      MeanSz+=Sz;  MeanVol+=Vol;  Count+= 1;
-      if (SaveAllSweeps) { // save the full cut set and conductances for all trials
-        SweepsV.Add(TNodeSweep(SeedNId, Clust.GetNIdV(), Clust.GetPhiV())); }
-      int SAtBestPhi=-1;
-      for (int s = 0; s < Clust.Len(); s++) {
-        const int size = s+1;
-        const int cut = Clust.GetCut(s);
-        const int edges = (Clust.GetVol(s)-cut)/2;
-        const double phi = Clust.GetPhi(s);
-        if (( Clust.GetPhi(s) != double(cut)/double(2*edges+cut))) { continue; } // more than half of the edges
-        IAssert((Clust.GetVol(s) - cut) % 2 == 0);
-        IAssert(phi == double(cut)/double(2*edges+cut));
-        IAssert(phi >= 1.0/double((1+s)*s+1));
-        //// If we want to take pieces that minimize some other community goodness measure
-        // TCutInfo CutInfo(size, edges, cut); Clust.GetNIdV().GetSubValV(0, size-1, CutInfo.CutNIdV);
-        //double MxFrac=0, AvgFrac=0, MedianFrac=0, Pct9Frac=0, Flake=0;
-        //CutInfo.GetFracDegOut(Graph, MxFrac, AvgFrac, MedianFrac, Pct9Frac, Flake);
-        //const double phi = MxFrac;
-        if (BestPhi >= phi) {
-          BestPhi = phi;
-          BestCut = TCutInfo(size, edges, cut);
-          SAtBestPhi = s;
-        }
-        //// If we want to take pieces that minimize some other community goodness measure
-        //bool TAKE=false;  if (! BestCutH.IsKey(size)) { TAKE=true; }
-        //else { BestCutH.GetDat(size).GetFracDegOut(Graph, MxFrac, AvgFrac, MedianFrac, Pct9Frac, Flake);  if (MxFrac >= phi) { TAKE = true; } }
-        // if (TAKE) {
-        if (! BestCutH.IsKey(size) || BestCutH.GetDat(size).GetPhi() >= phi) { //new best cut (size, edges inside and nodes)
-          BestCutH.AddDat(size, TCutInfo(size, edges, cut));  // for every size store best cut (NIds inside the cut)
-          if (SaveBestNodesAtK) { // store node ids in best community for each size k
-            if (! SizeBucketSet.Empty() && ! SizeBucketSet.IsKey(size)) { continue; } // only save best clusters at SizeBucketSet
-            Clust.GetNIdV().GetSubValV(0, size-1, BestCutH.GetDat(size).CutNIdV); }
-        }
-        if (SaveAllCond) { // for every size store all conductances
-          SizePhiH.AddDat(size).Add(phi); }
-      }
-      if (SAtBestPhi != -1) { // take nodes in best cluster
-        const int size = SAtBestPhi+1;
-        Clust.GetNIdV().GetSubValV(0, size-1, BestCut.CutNIdV); 
-      }
+    TExeTm ExeTm;
+    for (int t = 0; t < StatAcc.AccV.Len(); t++) { StatAcc.AccV[t].Clr(); }
+    // seeds are drawn in batches, every batch is processed in parallel
+    for (int run = 0; run < Runs; run += BatchSz) {
+      SeedNIdV.Clr(false);
+      for (int s = run; s < TMath::Mn(Runs, run+BatchSz); s++) {
+        SeedNIdV.Add(Graph->GetRndNId()); }
+      StatAcc.SeedOff = run;
+      Clust.Run(SeedNIdV, K, StatAcc);
       if (TLocClust::Verbose) {
-        printf(".");
-        if (run % 50 == 0) {
-          printf("\r                                                   %d / %d \r", run, Runs); }
-      }
+        printf("\r                                                   %d / %d \r", run+SeedNIdV.Len(), Runs); }
     }
     if (TLocClust::Verbose) {
       printf("\r  %d / %d: %s                                                   \n", Runs, Runs, ExeTm.GetStr()); 
     }
+    // merge the thread-local cuts, ties go to the later seed
+    double MeanSz=0.0, MeanVol=0.0, Count=0.0;
+    THash<TInt, TCutInfo> KBestCutH;
+    TIntH KBestSeedH;
+    int BestThread = -1;
+    for (int t = 0; t < StatAcc.AccV.Len(); t++) {
+      TLocClustStatAcc::TThreadAcc& Acc = StatAcc.AccV[t];
+      MeanSz += Acc.SumSz;  MeanVol += Acc.SumVol;  Count += Acc.Count;
+      for (int c = 0; c < Acc.BestCutH.Len(); c++) {
+        const int size = Acc.BestCutH.GetKey(c);
+        const double phi = Acc.BestCutH[c].GetPhi();
+        const int Seed = Acc.BestSeedH.GetDat(size);
+        const int KeyId = KBestCutH.GetKeyId(size);
+        if (KeyId == -1 || KBestCutH[KeyId].GetPhi() > phi || (KBestCutH[KeyId].GetPhi() == phi && KBestSeedH.GetDat(size) < Seed)) {
+          KBestCutH.AddDat(size, Acc.BestCutH[c]);  KBestSeedH.AddDat(size, Seed); }
+      }
+      if (Acc.BestSeed != -1 && (BestThread == -1 || StatAcc.AccV[BestThread].IsBest(Acc.BestPhi, Acc.BestSeed, Acc.BestS))) {
+        BestThread = t; }
+      for (int c = 0; c < Acc.SizePhiH.Len(); c++) {
+        SizePhiH.AddDat(Acc.SizePhiH.GetKey(c)).AddV(Acc.SizePhiH[c]); }
+      SweepsV.AddV(Acc.SweepsV);
+    }
+    for (int c = 0; c < KBestCutH.Len(); c++) {
+      const int size = KBestCutH.GetKey(c);
+      if (! BestCutH.IsKey(size) || BestCutH.GetDat(size).GetPhi() >= KBestCutH[c].GetPhi()) { //new best cut (size, edges inside and nodes)
+        BestCutH.AddDat(size, KBestCutH[c]); }
+    }
+    if (BestThread != -1 && BestPhi >= StatAcc.AccV[BestThread].BestPhi) {
+      BestPhi = StatAcc.AccV[BestThread].BestPhi;
+      BestCut = StatAcc.AccV[BestThread].BestCut;
+    }
     MeanSz/=Count;  MeanVol/=Count;
     printf("  Graph(%d, %d)  ", Nodes, Edges);
     printf("       mean:  sz: %.2f  vol: %.2f [%s] %s\n", MeanSz, MeanVol, ExeTm.GetStr(), TExeTm::GetCurTm());
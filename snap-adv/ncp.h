@@ -90,6 +90,79 @@ public:
   friend class TLocClustStat;
 };
 
+//#///////////////////////////////////////////////
+/// Local Spectral Clustering from many seed nodes in parallel. ##TLocClustBatch
+/// Runs the same approximate PageRank and sweep as TLocClust::FindBestCut()
+/// for a batch of seeds. The graph is flattened into a TCsrGraph once. Every
+/// thread keeps the PageRank and residuals of the nodes touched by the last seed
+/// only, so its memory grows with the largest support rather than with the graph
+/// (the support of a seed has volume O(ClustSz/Alpha)). Residuals are pushed from a queue
+/// bucketed by the ratio of residual to degree, so the largest residuals are
+/// pushed first. Sweeps are handed to a visitor together with the thread number,
+/// so the results can be gathered into thread-local state without locking.
+class TLocClustBatch {
+public:
+  /// Sweep of one seed, see TLocClust for the meaning of the vectors.
+  class TSweep {
+  public:
+    TInt SeedNId;
+    TIntV NIdV, VolV, CutV;
+    TFltV PhiV;
+    TInt BestCutIdx;
+  public:
+    TSweep() : SeedNId(-1), NIdV(), VolV(), CutV(), PhiV(), BestCutIdx(-1) { }
+    int Len() const { return VolV.Len(); }
+    int GetVol(const int& Nodes) const { return VolV[Nodes]; }
+    int GetCut(const int& Nodes) const { return CutV[Nodes]; }
+    double GetPhi(const int& ValId) const { return PhiV[ValId]; }
+    int BestCut() const { return BestCutIdx; }
+    int BestCutNodes() const { return BestCutIdx+1; }
+    int GetCutVol() const { return GetVol(BestCut()); }
+    double GetCutPhi() const { return GetPhi(BestCut()); }
+  };
+  /// Receives the sweep of every seed. OnSweep() is called concurrently from all
+  /// threads, ThreadN is between 0 and GetThreads()-1 and SeedN is the position
+  /// of the seed in the batch.
+  class TVisitor {
+  public:
+    virtual ~TVisitor() { }
+    virtual void OnSweep(const int& ThreadN, const int& SeedN, const TSweep& Sweep) = 0;
+  };
+private:
+  // per-thread workspace, vectors are indexed by the key id of the node in NIdxSet
+  class TWork {
+  public:
+    TIntSet NIdxSet;     // CSR indices of the nodes with a non-zero PageRank or residual
+    TFltV ProbV, ResV;   // approximate PageRank and residuals
+    TIntV QBucketV;      // bucket the node is queued in, -1 if not queued
+    TVec<TIntV> BucketVV; // key ids of the queued nodes
+    TIntV RankV;         // position of the node in the sweep, -1 if the node was not pushed
+    TFltIntKdV OrderV;   // support sorted by decreasing degree-normalized PageRank
+    TSweep Sweep;
+  };
+  TCsrGraph Csr;
+  int Edges2;            // 2*edges in the graph
+  double Alpha;
+  TVec<TWork> WorkV;
+private:
+  // returns the key id of the node, the node starts with zero PageRank and residual
+  int Touch(TWork& Work, const int& NIdx) const {
+    int KeyId = Work.NIdxSet.GetKeyId(NIdx);
+    if (KeyId == -1) {
+      KeyId = Work.NIdxSet.AddKey(NIdx);
+      Work.ProbV.Add(0.0);  Work.ResV.Add(0.0);  Work.QBucketV.Add(-1);  Work.RankV.Add(-1); }
+    return KeyId; }
+  void Enqueue(TWork& Work, const int& KeyId, const double& Eps, int& TopBucket) const;
+  void ApproxPageRank(TWork& Work, const int& SeedNIdx, const double& Eps) const;
+  void SupportSweep(TWork& Work) const;
+public:
+  TLocClustBatch(const PUNGraph& Graph, const double& AlphaVal);
+  /// Number of threads and thread-local workspaces used by Run().
+  int GetThreads() const { return WorkV.Len(); }
+  /// Finds the minimum conductance cut around every seed in SeedNIdV, with PageRank tolerance 1/ClustSz. ##TLocClustBatch::Run
+  void Run(const TIntV& SeedNIdV, const int& ClustSz, TVisitor& Visitor);
+};
+
 //#///////////////////////////////////////////////
 /// Local-Spectral-Clustering statistics of a given Graph.
 class TLocClustStat {
@@ -45,12 +45,348 @@ TFtr GetNthFeature(const TIntFtrH& Features, const int N) {
   return NthFeature;
 }
 
-TIntFtrH ExtractFeatures(const PUNGraph Graph) {
-  TIntFtrH Features = CreateEmptyFeatures(Graph);
-  AddNeighborhoodFeatures(Graph, Features);
+static int GetRolXThreads() {
+#ifdef USE_OPENMP
+  return omp_get_max_threads();
+#else
+  return 1;
+#endif
+}
+
+static int GetRolXThreadN() {
+#ifdef USE_OPENMP
+  return omp_get_thread_num();
+#else
+  return 0;
+#endif
+}
+
+static void AddCountMP(int64& Dst, const int64& Val) {
+#ifdef USE_OPENMP
+  __sync_fetch_and_add(&Dst, Val);
+#else
+  Dst += Val;
+#endif
+}
+
+// true if V comes after U in the (degree, index) order
+static bool IsHigherNode(const TCsrGraph& Csr, const int& V, const int& U) {
+  const int DegV = Csr.GetOutDeg(V), DegU = Csr.GetOutDeg(U);
+  return DegV > DegU || (DegV == DegU && V > U);
+}
+
+// Counts the triangles of every node, self-loops are ignored. Every edge is
+// oriented towards its higher endpoint, so each triangle is found once from its
+// lowest node, whose higher neighbors are marked with its index.
+static void GetNodeTriangles(const TCsrGraph& Csr, TVec<TInt64>& TriV) {
+  const int NumNodes = Csr.GetNodes();
+  TIntV HiOffV(NumNodes + 1);
+  #pragma omp parallel for schedule(dynamic,10000)
+  for (int u = 0; u < NumNodes; ++u) {
+    int NumHi = 0;
+    for (const TInt* N = Csr.BegOut(u); N < Csr.EndOut(u); N++) {
+      if (IsHigherNode(Csr, *N, u)) { ++NumHi; }
+    }
+    HiOffV[u + 1] = NumHi;
+  }
+  for (int u = 0; u < NumNodes; ++u) {
+    HiOffV[u + 1] += HiOffV[u];
+  }
+  TIntV HiNbrV(HiOffV[NumNodes]);
+  #pragma omp parallel for schedule(dynamic,10000)
+  for (int u = 0; u < NumNodes; ++u) {
+    int Pos = HiOffV[u];
+    for (const TInt* N = Csr.BegOut(u); N < Csr.EndOut(u); N++) {
+      if (IsHigherNode(Csr, *N, u)) { HiNbrV[Pos++] = *N; }
+    }
+  }
+  TriV.Gen(NumNodes);
+  #pragma omp parallel
+  {
+    TIntV MarkV(NumNodes);
+    MarkV.PutAll(-1);
+    #pragma omp for schedule(dynamic,1000)
+    for (int u = 0; u < NumNodes; ++u) {
+      for (int i = HiOffV[u]; i < HiOffV[u + 1]; ++i) {
+        MarkV[HiNbrV[i]] = u;
+      }
+      int64 NumTri = 0;
+      for (int i = HiOffV[u]; i < HiOffV[u + 1]; ++i) {
+        const int V = HiNbrV[i];
+        for (int j = HiOffV[V]; j < HiOffV[V + 1]; ++j) {
+          if (MarkV[HiNbrV[j]] == u) {
+            ++NumTri;
+            AddCountMP(TriV[V].Val, 1);
+            AddCountMP(TriV[HiNbrV[j]].Val, 1);
+          }
+        }
+      }
+      if (NumTri > 0) {
+        AddCountMP(TriV[u].Val, NumTri);
+      }
+    }
+  }
+}
+
+// Local and egonet features: degree, edges within the egonet and edges leaving
+// the egonet. They are derived from the triangle counts instead of building
+// the egonet of every node.
+static void GetNeighborhoodFeatures(const TCsrGraph& Csr, TFltVV& FtrVV) {
+  const int NumNodes = Csr.GetNodes();
+  TVec<TInt64> TriV;
+  GetNodeTriangles(Csr, TriV);
+  TIntV LoopV(NumNodes);
+  #pragma omp parallel for schedule(dynamic,10000)
+  for (int u = 0; u < NumNodes; ++u) {
+    for (const TInt* N = Csr.BegOut(u); N < Csr.EndOut(u); N++) {
+      if (*N == u) { LoopV[u] = 1; }
+    }
+  }
+  FtrVV.Gen(NumNodes, 3);
+  #pragma omp parallel for schedule(dynamic,10000)
+  for (int u = 0; u < NumNodes; ++u) {
+    const int Deg = Csr.GetOutDeg(u);
+    int64 EgoLoops = LoopV[u], ArndEdges = 0;
+    for (const TInt* N = Csr.BegOut(u); N < Csr.EndOut(u); N++) {
+      if (*N != u) {
+        EgoLoops += LoopV[*N];
+        ArndEdges += Csr.GetOutDeg(*N) - 1 - LoopV[*N];
+      }
+    }
+    FtrVV(u, 0) = Deg;
+    FtrVV(u, 1) = double(Deg - LoopV[u] + TriV[u] + EgoLoops);
+    FtrVV(u, 2) = double(ArndEdges - 2 * TriV[u]);
+  }
+}
+
+// Sum and mean of every current feature over the neighbors, in the column
+// order of GenerateRecursiveFeatures(). Neighbor rows are added as whole
+// vectors.
+static void GetRecursiveFeatures(const TCsrGraph& Csr, const TFltVV& CurrVV,
+    TFltVV& NewVV) {
+  const int NumNodes = CurrVV.GetXDim();
+  const int NumCurrFeatures = CurrVV.GetYDim();
+  NewVV.Gen(NumNodes, 2 * NumCurrFeatures);
+  #pragma omp parallel
+  {
+    TFltV SumV(NumCurrFeatures);
+    #pragma omp for schedule(dynamic,10000)
+    for (int u = 0; u < NumNodes; ++u) {
+      TFlt* Sum = SumV.BegI();
+      for (int j = 0; j < NumCurrFeatures; ++j) {
+        Sum[j] = 0;
+      }
+      for (const TInt* N = Csr.BegOut(u); N < Csr.EndOut(u); N++) {
+        const TFlt* Row = &CurrVV.At(*N, 0);
+        for (int j = 0; j < NumCurrFeatures; ++j) {
+          Sum[j].Val += Row[j].Val;
+        }
+      }
+      const int Deg = Csr.GetOutDeg(u);
+      TFlt* NewRow = &NewVV.At(u, 0);
+      for (int j = 0; j < NumCurrFeatures; ++j) {
+        NewRow[2 * j] = Sum[j];
+        NewRow[2 * j + 1] = 0 == Deg ? 0.0 : Sum[j] / Deg;
+      }
+    }
+  }
+}
+
+// stable merge sort by key, TmpV is scratch space
+static void MergeSortByKey(TFltIntKdV& KdV, TFltIntKdV& TmpV) {
+  const int Len = KdV.Len();
+  TmpV.Gen(Len);
+  TFltIntKd* Src = KdV.BegI();
+  TFltIntKd* Dst = TmpV.BegI();
+  for (int Width = 1; Width < Len; Width *= 2) {
+    for (int Lo = 0; Lo < Len; Lo += 2 * Width) {
+      const int Mid = TMath::Mn(Lo + Width, Len);
+      const int Hi = TMath::Mn(Lo + 2 * Width, Len);
+      int i = Lo, j = Mid, k = Lo;
+      while (i < Mid && j < Hi) {
+        if (Src[j].Key < Src[i].Key) {
+          Dst[k++] = Src[j++];
+        } else {
+          Dst[k++] = Src[i++];
+        }
+      }
+      while (i < Mid) { Dst[k++] = Src[i++]; }
+      while (j < Hi) { Dst[k++] = Src[j++]; }
+    }
+    TFltIntKd* Tmp = Src; Src = Dst; Dst = Tmp;
+  }
+  if (Src != KdV.BegI()) {
+    KdV.Swap(TmpV);
+  }
+}
+
+// Vertical logarithmic binning of one feature column, see AssignBinValue().
+// Ties are broken by node index.
+static void GetLogBins(const TFltVV& FtrVV, const int& FtrN,
+    const float BinFraction, TFltIntKdV& KdV, TFltIntKdV& TmpV, TUChV& BinV) {
+  const int NumNodes = FtrVV.GetXDim();
+  KdV.Gen(NumNodes);
+  for (int i = 0; i < NumNodes; ++i) {
+    KdV[i] = TFltIntKd(FtrVV(i, FtrN), i);
+  }
+  MergeSortByKey(KdV, TmpV);
+  BinV.Gen(NumNodes);
+  int NumAssigned = 0;
+  int BinValue = 0;
+  while (NumAssigned < NumNodes) {
+    const int NumToAssign = int(ceil(BinFraction *
+        double(NumNodes - NumAssigned)));
+    IAssert(BinValue <= TUCh::Mx);
+    for (int i = NumAssigned; i < NumAssigned + NumToAssign; ++i) {
+      BinV[KdV[i].Dat] = uchar(BinValue);
+    }
+    NumAssigned += NumToAssign;
+    ++BinValue;
+  }
+}
+
+// IsSimilarFeature() on binned features, compared in blocks without branches
+static bool IsSimilarBins(const TUChV& Bin1V, const TUChV& Bin2V,
+    const int SimilarityThreshold) {
+  IAssert(Bin1V.Len() == Bin2V.Len());
+  const int Len = Bin1V.Len();
+  const TUCh* B1 = Bin1V.BegI();
+  const TUCh* B2 = Bin2V.BegI();
+  for (int Beg = 0; Beg < Len; Beg += 4096) {
+    const int End = TMath::Mn(Beg + 4096, Len);
+    int MxDiff = 0;
+    for (int i = Beg; i < End; ++i) {
+      const int Diff = abs(int(B1[i].Val) - int(B2[i].Val));
+      MxDiff = Diff > MxDiff ? Diff : MxDiff;
+    }
+    if (MxDiff > SimilarityThreshold) {
+      return false;
+    }
+  }
+  return true;
+}
+
+static int FindFeatureRoot(TIntV& ParentV, int FtrN) {
+  while (ParentV[FtrN] != FtrN) {
+    ParentV[FtrN] = ParentV[ParentV[FtrN]];
+    FtrN = ParentV[FtrN];
+  }
+  return FtrN;
+}
+
+// Recursive feature generation and pruning on the feature matrix, the same
+// rounds as AddRecursiveFeatures(). Bins of the kept features are computed
+// once, and only pairs with a new feature are compared: a new feature is
+// retained if its s-friend component has no old feature and it is the first
+// feature of the component.
+static void AddRecursiveFeatures(const TCsrGraph& Csr, TFltVV& FtrVV) {
+  const int NumNodes = FtrVV.GetXDim();
+  const float BinFraction = 0.5;
+  const int Threads = GetRolXThreads();
+  TVec<TFltIntKdV> KdVV(Threads), TmpVV(Threads);
+  TVec<TUChV> BinVV(FtrVV.GetYDim());
+  #pragma omp parallel for schedule(dynamic,1)
+  for (int f = 0; f < FtrVV.GetYDim(); ++f) {
+    const int ThreadN = GetRolXThreadN();
+    GetLogBins(FtrVV, f, BinFraction, KdVV[ThreadN], TmpVV[ThreadN], BinVV[f]);
+  }
+  TFltVV CurrVV = FtrVV;
+  for (int SimilarityThreshold = 0; ; ++SimilarityThreshold) {
+    TFltVV NewVV;
+    GetRecursiveFeatures(Csr, CurrVV, NewVV);
+    const int NumOld = FtrVV.GetYDim();
+    const int NumNew = NewVV.GetYDim();
+    for (int j = 0; j < NumNew; ++j) {
+      BinVV.Add();
+    }
+    TVec<TIntPrV> EdgeVV(Threads);
+    #pragma omp parallel for schedule(dynamic,1)
+    for (int j = 0; j < NumNew; ++j) {
+      const int ThreadN = GetRolXThreadN();
+      GetLogBins(NewVV, j, BinFraction, KdVV[ThreadN], TmpVV[ThreadN],
+          BinVV[NumOld + j]);
+    }
+    #pragma omp parallel for schedule(dynamic,1)
+    for (int j = 0; j < NumNew; ++j) {
+      const int ThreadN = GetRolXThreadN();
+      for (int i = 0; i < NumOld + j; ++i) {
+        if (IsSimilarBins(BinVV[i], BinVV[NumOld + j], SimilarityThreshold)) {
+          EdgeVV[ThreadN].Add(TIntPr(i, NumOld + j));
+        }
+      }
+    }
+    // components of the s-friend graph, rooted at their first feature
+    TIntV ParentV(NumOld + NumNew);
+    for (int f = 0; f < ParentV.Len(); ++f) {
+      ParentV[f] = f;
+    }
+    for (int t = 0; t < EdgeVV.Len(); ++t) {
+      for (int e = 0; e < EdgeVV[t].Len(); ++e) {
+        const int Root1 = FindFeatureRoot(ParentV, EdgeVV[t][e].Val1);
+        const int Root2 = FindFeatureRoot(ParentV, EdgeVV[t][e].Val2);
+        ParentV[TMath::Mx(Root1, Root2)] = TMath::Mn(Root1, Root2);
+      }
+    }
+    TIntV RetainedIdx;
+    for (int j = 0; j < NumNew; ++j) {
+      if (FindFeatureRoot(ParentV, NumOld + j) == NumOld + j) {
+        RetainedIdx.Add(j);
+      }
+    }
+    if (RetainedIdx.Empty()) {
+      break;
+    }
+    const int NumRetained = RetainedIdx.Len();
+    TFltVV AllVV(NumNodes, NumOld + NumRetained);
+    CurrVV.Gen(NumNodes, NumRetained);
+    #pragma omp parallel for schedule(static)
+    for (int u = 0; u < NumNodes; ++u) {
+      for (int j = 0; j < NumOld; ++j) {
+        AllVV(u, j) = FtrVV(u, j);
+      }
+      for (int j = 0; j < NumRetained; ++j) {
+        CurrVV(u, j) = NewVV(u, RetainedIdx[j]);
+        AllVV(u, NumOld + j) = CurrVV(u, j);
+      }
+    }
+    FtrVV = AllVV;
+    for (int j = 0; j < NumRetained; ++j) {
+      BinVV[NumOld + j].Swap(BinVV[NumOld + RetainedIdx[j]]);
+    }
+    BinVV.Reduce(NumOld + NumRetained);
+    printf("recursion %d: ", SimilarityThreshold + 1);
+    printf("current feature number %d\n", FtrVV.GetYDim());
+  }
+}
+
+void ExtractFeatures(const PUNGraph& Graph, TFltVV& FtrVV,
+    TIntIntH& NodeIdMtxIdxH) {
+  const TCsrGraph Csr(Graph);
+  NodeIdMtxIdxH.Clr();
+  for (int i = 0; i < Csr.GetNodes(); ++i) {
+    NodeIdMtxIdxH.AddDat(Csr.GetNId(i), i);
+  }
+  GetNeighborhoodFeatures(Csr, FtrVV);
   printf("finish neighborhood features\n");
-  AddRecursiveFeatures(Graph, Features);
+  if (Csr.GetNodes() > 0) {
+    AddRecursiveFeatures(Csr, FtrVV);
+  }
   printf("finish recursive features\n");
+}
+
+TIntFtrH ExtractFeatures(const PUNGraph Graph) {
+  TFltVV FtrVV;
+  TIntIntH NodeIdMtxIdxH;
+  ExtractFeatures(Graph, FtrVV, NodeIdMtxIdxH);
+  TIntFtrH Features = CreateEmptyFeatures(Graph);
+  for (TIntFtrH::TIter HI = Features.BegI(); HI < Features.EndI(); HI++) {
+    const int i = GetMtxIdx(HI.GetKey(), NodeIdMtxIdxH);
+    TFtr& Feature = HI.GetDat();
+    Feature.Gen(FtrVV.GetYDim());
+    for (int j = 0; j < FtrVV.GetYDim(); ++j) {
+      Feature[j] = FtrVV(i, j);
+    }
+  }
   return Features;
 }
 
@@ -215,7 +551,7 @@ void AssignBinValue(const TVec<TInt>& SortedNId, const float BinFraction,
   int NumAssigned = 0;
   int BinValue = 0;
   while (NumAssigned < NumNodes) {
-    int NumToAssign = ceil(BinFraction * (NumNodes - NumAssigned));
+    int NumToAssign = ceil(BinFraction * double(NumNodes - NumAssigned));
     for (int i = NumAssigned; i < NumAssigned + NumToAssign; ++i) {
       int NId = SortedNId[i];
       LogBinFeatures.GetDat(NId).Add(BinValue);
@@ -283,83 +619,115 @@ bool FltIsZero(const TFlt Number) {
   return TFlt::Abs(Number) < TFlt::Eps;
 }
 
+// Multiplicative updates of the KL-divergence NMF. Every iteration is a single
+// parallel pass over row blocks of V: a row of the product W*H is computed
+// together with its cost, the new row of W and its contribution to W'*(V/WH),
+// the numerators of the H update. Partial sums are kept per thread and added
+// up in thread order, so the result does not depend on scheduling.
 void CalcNonNegativeFactorization(const TFltVV& V, const int NumRoles,
     TFltVV& W, TFltVV& H, const double Threshold) {
   double Cost = 100, NewCost = 0;
-  int NumNodes = V.GetXDim();
-  int NumFeatures = V.GetYDim();
+  const int NumNodes = V.GetXDim();
+  const int NumFeatures = V.GetYDim();
+  const int Threads = GetRolXThreads();
   W = CreateRandMatrix(NumNodes, NumRoles);
   H = CreateRandMatrix(NumRoles, NumFeatures);
   TFltVV NewW(NumNodes, NumRoles);
   TFltVV NewH(NumRoles, NumFeatures);
-  TFltVV Product(NumNodes, NumFeatures);
-  TFltV Sum(NumRoles);
-  TFltVV *PW = &W, *PH = &H, *PNewW = &NewW, *PNewH = &NewH, *Tmp;
-  //int IterNum = 1;
+  // per thread: cost, column sums of the new W, numerators of the H update
+  const int PartLen = 1 + NumRoles + NumRoles * NumFeatures;
+  TFltVV PartVV(Threads, PartLen);
+  TFltV Sum(PartLen);
   while (TFlt::Abs((NewCost - Cost)/Cost) > Threshold) {
-    TLinAlg::Multiply(*PW, *PH, Product);
-    //converge condition
-    Cost = NewCost;
-    NewCost = 0;
-    for (int i = 0; i < NumNodes; i++) {
-      for (int j = 0; j < NumFeatures; j++) {
-        NewCost += V(i, j) * TMath::Log(Product(i, j)) - Product(i, j);
-      }
-    }
-    // update W
-    for (int i = 0; i < NumNodes; i++) {
-      for (int a = 0; a < NumRoles; a++) {
-        double SumU = 0;
-        for (int u = 0; u < NumFeatures; ++u) {
-          if (!FltIsZero(Product(i, u))) {
-            SumU += V(i, u) / Product(i, u) * PH->At(a, u);
+    PartVV.PutAll(0);
+    #pragma omp parallel
+    {
+      TFlt* Part = &PartVV.At(GetRolXThreadN(), 0);
+      TFlt* SumW = Part + 1;
+      TFlt* NumH = Part + 1 + NumRoles;
+      TFltV ProductV(NumFeatures), RatioV(NumFeatures);
+      TFlt* Product = ProductV.BegI();
+      TFlt* Ratio = RatioV.BegI();
+      double ThreadCost = 0;
+      #pragma omp for schedule(static)
+      for (int i = 0; i < NumNodes; i++) {
+        const TFlt* VRow = &V.At(i, 0);
+        const TFlt* WRow = &W.At(i, 0);
+        TFlt* NewWRow = &NewW.At(i, 0);
+        for (int u = 0; u < NumFeatures; u++) {
+          Product[u] = 0;
+        }
+        for (int a = 0; a < NumRoles; a++) {
+          const double Wia = WRow[a];
+          const TFlt* HRow = &H.At(a, 0);
+          for (int u = 0; u < NumFeatures; u++) {
+            Product[u].Val += Wia * HRow[u].Val;
+          }
+        }
+        for (int u = 0; u < NumFeatures; u++) {
+          // zero entries add no log term, rows of isolated nodes are all zero
+          if (!FltIsZero(VRow[u])) {
+            ThreadCost += VRow[u] * TMath::Log(Product[u]);
           }
+          ThreadCost -= Product[u];
+          Ratio[u] = FltIsZero(Product[u]) ? 0.0 : VRow[u] / Product[u];
+        }
+        for (int a = 0; a < NumRoles; a++) {
+          const double Wia = WRow[a];
+          const TFlt* HRow = &H.At(a, 0);
+          TFlt* NumHRow = NumH + a * NumFeatures;
+          double SumU = 0;
+          for (int u = 0; u < NumFeatures; u++) {
+            SumU += Ratio[u].Val * HRow[u].Val;
+            NumHRow[u].Val += Wia * Ratio[u].Val;
+          }
+          NewWRow[a] = Wia * SumU;
+          SumW[a] += NewWRow[a];
         }
-        PNewW->At(i, a) = PW->At(i, a) * SumU;
       }
+      Part[0] = ThreadCost;
     }
-    for (int i = 0; i < NumRoles; i++) {
-      Sum[i] = 0;
-    }
-    for (int i = 0; i < NumNodes; i++) {
-      for (int j = 0; j < NumRoles; j++) {
-        Sum[j] += PNewW->At(i, j);
+    Sum.PutAll(0);
+    for (int t = 0; t < Threads; t++) {
+      for (int k = 0; k < PartLen; k++) {
+        Sum[k] += PartVV(t, k);
       }
     }
+    //converge condition
+    Cost = NewCost;
+    NewCost = Sum[0];
+    // update W
+    #pragma omp parallel for schedule(static)
     for (int i = 0; i < NumNodes; i++) {
       for (int j = 0; j < NumRoles; j++) {
-        PNewW->At(i, j) /= Sum[j];
+        NewW(i, j) /= Sum[1 + j];
       }
     }
     // update H
     for (int a = 0; a < NumRoles; a++) {
       for (int u = 0; u < NumFeatures; u++) {
-        double SumI = 0;
-        for (int i = 0; i < NumNodes; ++i) {
-          if (!FltIsZero(Product(i, u))) {
-            SumI += PW->At(i, a) * V(i, u) / Product(i, u);
-          }
-        }
-        PNewH->At(a, u) = PH->At(a, u) * SumI;
+        NewH(a, u) = H(a, u) * Sum[1 + NumRoles + a * NumFeatures + u];
       }
     }
-    //printf("iteration %d, cost is %f\n", IterNum++, NewCost);
-    Tmp = PW; PW = PNewW; PNewW = Tmp;
-    Tmp = PH; PH = PNewH; PNewH = Tmp;
+    W.Get1DVec().Swap(NewW.Get1DVec());
+    H.Get1DVec().Swap(NewH.Get1DVec());
   }
 }
 
 TFlt CalcDescriptionLength(const TFltVV& V, const TFltVV& G,
     const TFltVV& F) {
-  int B = 64;
-  int M = B * V.GetYDim() * (V.GetXDim() + F.GetYDim());
-  TFlt E = 0;
-  TFltVV GF(G.GetXDim(), F.GetYDim());
-  TLinAlg::Multiply(G, F, GF);
+  const int B = 64;
+  const double M = double(B) * V.GetYDim() * (V.GetXDim() + F.GetYDim());
+  const int NumRoles = G.GetYDim();
+  double E = 0;
+  #pragma omp parallel for reduction(+:E) schedule(static)
   for (int i = 0; i < V.GetXDim(); ++i) {
     for (int j = 0; j < V.GetYDim(); ++j) {
-      TFlt ValueV = V(i, j);
-      TFlt ValueGF = GF(i, j);
+      double ValueGF = 0;
+      for (int a = 0; a < NumRoles; ++a) {
+        ValueGF += G(i, a) * F(a, j);
+      }
+      const double ValueV = V(i, j);
       if (FltIsZero(ValueV)) {
         E += ValueGF;
       } else if (!FltIsZero(ValueGF)) {
@@ -395,8 +763,21 @@ int GetNodeId(const TInt MtxId, const TIntIntH& NodeIdMtxIdxH) {
   return -1;
 }
 
+// matrix index -> node ID
+static void GetMtxIdxNodeIdV(const TIntIntH& NodeIdMtxIdxH, TIntV& NodeIdV) {
+  NodeIdV.Gen(NodeIdMtxIdxH.Len());
+  NodeIdV.PutAll(-1);
+  for (TIntIntH::TIter HI = NodeIdMtxIdxH.BegI();
+      HI < NodeIdMtxIdxH.EndI();
+      HI++) {
+    NodeIdV[HI.GetDat()] = HI.GetKey();
+  }
+}
+
 TIntIntH FindRoles(const TFltVV& G, const TIntIntH& NodeIdMtxIdxH) {
   TIntIntH Roles;
+  TIntV NodeIdV;
+  GetMtxIdxNodeIdV(NodeIdMtxIdxH, NodeIdV);
   for (int i = 0; i < G.GetXDim(); i++) {
     int Role = -1;
     TFlt Max = TFlt::Mn;
@@ -406,8 +787,7 @@ TIntIntH FindRoles(const TFltVV& G, const TIntIntH& NodeIdMtxIdxH) {
         Role = j;
       }
     }
-    int NodeId = GetNodeId(i, NodeIdMtxIdxH);
-    Roles.AddDat(NodeId, Role);
+    Roles.AddDat(NodeIdV[i], Role);
   }
   return Roles;
 }
@@ -452,9 +832,10 @@ void FPrintNodeMappings(const TIntIntH& NodeIdMtxIdxH, const TStr& Path) {
   FILE *Fp;
   Fp = fopen(Path.CStr(), "w");
   fprintf(Fp, "# mappings from the feature line numbers to node IDs\n");
-  for (int i = 0; i < NodeIdMtxIdxH.Len(); i++) {
-    int NodeId = GetNodeId(i, NodeIdMtxIdxH);
-    fprintf(Fp, "%d %d\n", i, NodeId);
+  TIntV NodeIdV;
+  GetMtxIdxNodeIdV(NodeIdMtxIdxH, NodeIdV);
+  for (int i = 0; i < NodeIdV.Len(); i++) {
+    fprintf(Fp, "%d %d\n", i, NodeIdV[i]());
   }
   fclose(Fp);
 }
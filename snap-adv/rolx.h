@@ -19,6 +19,10 @@ int GetNumFeatures(const TIntFtrH& Features);
 TFtr GetNthFeature(const TIntFtrH& Features, const int N);
 /// Performs feature extraction, the first step of RolX.
 TIntFtrH ExtractFeatures(const PUNGraph Graph);
+/// Performs feature extraction into a dense matrix, computed in parallel.
+/// Row i of FtrVV holds the features of the node mapped to i by NodeIdMtxIdxH.
+void ExtractFeatures(const PUNGraph& Graph, TFltVV& FtrVV,
+    TIntIntH& NodeIdMtxIdxH);
 /// Adds neighborhood features (local + egonet) to the node-feature mapping.
 void AddNeighborhoodFeatures(const PUNGraph Graph, TIntFtrH& Features);
 /// Adds recursive features to the node-feature mapping.
@@ -3,12 +3,40 @@
 
 ///////////////////////////////////////////////////////////////////////////////
 // Initialization and helper methods for TempMotifCounter
-TempMotifCounter::TempMotifCounter(const TStr& filename) {
-  // First load the static graph
-  static_graph_ = TSnap::LoadEdgeList<PNGraph>(filename, 0, 1);
-  int max_nodes = static_graph_->GetMxNId();
-  temporal_data_ = TVec< THash<TInt, TIntV> >(max_nodes);
+// Parallel loops accumulate into one counter per thread, reduced at the end.
+static int GetNumThreads() {
+#ifdef USE_OPENMP
+  return omp_get_max_threads();
+#else
+  return 1;
+#endif
+}
 
+static int GetThreadId() {
+#ifdef USE_OPENMP
+  return omp_get_thread_num();
+#else
+  return 0;
+#endif
+}
+
+// Collects the temporal edges (source, destination, timestamp) of a table.
+static void GetTableEvents(const PTable& table, const TStr& src_col,
+                           const TStr& dst_col, const TStr& time_col,
+                           TVec<TIntTr>& events) {
+  TInt src_idx = table->GetColIdx(src_col);
+  TInt dst_idx = table->GetColIdx(dst_col);
+  TInt tim_idx = table->GetColIdx(time_col);
+  events = TVec<TIntTr>(table->GetNumValidRows(), 0);
+  for (TRowIterator RI = table->BegRI(); RI < table->EndRI(); RI++) {
+    TInt row_idx = RI.GetRowIdx();
+    events.Add(TIntTr(table->GetIntValAtRowIdx(src_idx, row_idx),
+                      table->GetIntValAtRowIdx(dst_idx, row_idx),
+                      table->GetIntValAtRowIdx(tim_idx, row_idx)));
+  }
+}
+
+TempMotifCounter::TempMotifCounter(const TStr& filename) {
   // Formulate input File Format:
   //   source_node destination_node timestamp
   TTableContext context;
@@ -17,20 +45,71 @@ TempMotifCounter::TempMotifCounter(const TStr& filename) {
   temp_graph_schema.Add(TPair<TStr,TAttrType>("destination", atInt));
   temp_graph_schema.Add(TPair<TStr,TAttrType>("time", atInt));
 
-  // Load the temporal graph
+  // Load the temporal graph, the static graph is built from the same table
   PTable data_ptr = TTable::LoadSS(temp_graph_schema, filename, &context, ' ');
-  TInt src_idx = data_ptr->GetColIdx("source");
-  TInt dst_idx = data_ptr->GetColIdx("destination");
-  TInt tim_idx = data_ptr->GetColIdx("time");
-  for (TRowIterator RI = data_ptr->BegRI(); RI < data_ptr->EndRI(); RI++) {
-    TInt row_idx = RI.GetRowIdx();
-    int src = data_ptr->GetIntValAtRowIdx(src_idx, row_idx).Val;
-    int dst = data_ptr->GetIntValAtRowIdx(dst_idx, row_idx).Val;
-    int tim = data_ptr->GetIntValAtRowIdx(tim_idx, row_idx).Val;
+  TVec<TIntTr> events;
+  GetTableEvents(data_ptr, "source", "destination", "time", events);
+  Init(events);
+}
+
+TempMotifCounter::TempMotifCounter(const PTable& table, const TStr& src_col,
+                                   const TStr& dst_col, const TStr& time_col) {
+  TVec<TIntTr> events;
+  GetTableEvents(table, src_col, dst_col, time_col, events);
+  Init(events);
+}
+
+void TempMotifCounter::Init(TVec<TIntTr>& events) {
+  // Sorting by (source, destination, time) lays out the temporal edges of every
+  // static edge next to each other and in time order.
+  events.Sort();
+  int max_nodes = 0;
+  for (int i = 0; i < events.Len(); i++) {
+    max_nodes = MAX(max_nodes, MAX(events[i].Val1.Val, events[i].Val2.Val) + 1);
+  }
+  static_graph_ = TNGraph::New();
+  out_offsets_ = TIntV(max_nodes + 1);
+  out_offsets_.PutAll(0);
+  out_nbrs_.Clr();
+  time_offsets_.Clr();
+  edge_times_ = TIntV(events.Len(), 0);
+  int prev_src = -1, prev_dst = -1;
+  for (int i = 0; i < events.Len(); i++) {
+    int src = events[i].Val1;
+    int dst = events[i].Val2;
+    if (!static_graph_->IsNode(src)) { static_graph_->AddNode(src); }
+    if (!static_graph_->IsNode(dst)) { static_graph_->AddNode(dst); }
     // Do not include self loops as they do not appear in the definition of
     // temporal motifs.
-    if (src != dst) { temporal_data_[src](dst).Add(tim); }
+    if (src == dst) { continue; }
+    if (src != prev_src || dst != prev_dst) {
+      static_graph_->AddEdge(src, dst);
+      out_nbrs_.Add(dst);
+      out_offsets_[src + 1]++;
+      time_offsets_.Add(edge_times_.Len());
+      prev_src = src;
+      prev_dst = dst;
+    }
+    edge_times_.Add(events[i].Val3);
   }
+  time_offsets_.Add(edge_times_.Len());
+  for (int u = 0; u < max_nodes; u++) { out_offsets_[u + 1] += out_offsets_[u]; }
+}
+
+int TempMotifCounter::GetEdgeIdx(int u, int v) const {
+  if (u < 0 || u + 1 >= out_offsets_.Len()) { return -1; }
+  // Binary search over the sorted destinations of u
+  int lo = out_offsets_[u], hi = out_offsets_[u + 1];
+  while (lo < hi) {
+    int mid = (lo + hi) / 2;
+    if (out_nbrs_[mid] < v) { lo = mid + 1; } else { hi = mid; }
+  }
+  return lo < out_offsets_[u + 1] && out_nbrs_[lo] == v ? lo : -1;
+}
+
+int TempMotifCounter::GetEdges(int u, int v) const {
+  int e = GetEdgeIdx(u, v);
+  return e == -1 ? 0 : time_offsets_[e + 1] - time_offsets_[e];
 }
 
 void TempMotifCounter::GetAllNodes(TIntV& nodes) {
@@ -42,7 +121,7 @@ void TempMotifCounter::GetAllNodes(TIntV& nodes) {
 }
 
 bool TempMotifCounter::HasEdges(int u, int v) {
-  return temporal_data_[u].IsKey(v);
+  return GetEdgeIdx(u, v) != -1;
 }
 
 void TempMotifCounter::GetAllNeighbors(int node, TIntV& nbrs) {
@@ -82,9 +161,11 @@ void TempMotifCounter::GetAllStaticTriangles(TIntV& Us, TIntV& Vs, TIntV& Ws) {
   }
 
   // Get triangles centered at a given node where that node is the smallest in
-  // the degree ordering.
+  // the degree ordering.  Every thread collects its own triangles.
+  TVec< TVec<TIntTr> > triangles(GetNumThreads());
   #pragma omp parallel for schedule(dynamic)  
   for (int node_id = 0; node_id < nodes.Len(); node_id++) {
+    TVec<TIntTr>& local_triangles = triangles[GetThreadId()];
     int src = nodes[node_id];
     int src_pos = order[src];
     
@@ -103,16 +184,18 @@ void TempMotifCounter::GetAllStaticTriangles(TIntV& Us, TIntV& Vs, TIntV& Ws) {
         int dst2 = neighbors_higher[ind2];
         // Check for triangle formation
         if (static_graph_->IsEdge(dst1, dst2) || static_graph_->IsEdge(dst2, dst1)) {
-          #pragma omp critical
-          {
-            Us.Add(src);
-            Vs.Add(dst1);
-            Ws.Add(dst2);
-          }
+          local_triangles.Add(TIntTr(src, dst1, dst2));
         }
       }
     }
   }
+  for (int t = 0; t < triangles.Len(); t++) {
+    for (int i = 0; i < triangles[t].Len(); i++) {
+      Us.Add(triangles[t][i].Val1);
+      Vs.Add(triangles[t][i].Val2);
+      Ws.Add(triangles[t][i].Val3);
+    }
+  }
 }
 
 void TempMotifCounter::Count3TEdge23Node(double delta, Counter2D& counts) {
@@ -168,6 +251,124 @@ void TempMotifCounter::Count3TEdge23Node(double delta, Counter2D& counts) {
   counts(3, 5) = triad_counts(1, 1, 1);
 }
 
+// Returns the index of the first temporal edge (timestamp, source, destination)
+// at time >= t, or > t if after is true.
+static int GetFirstEvent(const TVec<TIntTr>& time_events, double t, bool after) {
+  int lo = 0, hi = time_events.Len();
+  while (lo < hi) {
+    int mid = (lo + hi) / 2;
+    double event_time = time_events[mid].Val1;
+    if (event_time < t || (after && event_time == t)) {
+      lo = mid + 1;
+    } else {
+      hi = mid;
+    }
+  }
+  return lo;
+}
+
+void TempMotifCounter::Count3TEdge23NodeSlice(const TVec<TIntTr>& time_events,
+                                              int beg, int end, double delta,
+                                              Counter2D& counts) {
+  THash<TInt, TInt> node_ids;
+  TVec<TIntTr> events(end - beg, 0);
+  for (int i = beg; i < end; i++) {
+    const TIntTr& event = time_events[i];
+    int src = node_ids.IsKey(event.Val2) ? node_ids.GetDat(event.Val2).Val
+      : node_ids.AddDat(event.Val2, node_ids.Len()).Val;
+    int dst = node_ids.IsKey(event.Val3) ? node_ids.GetDat(event.Val3).Val
+      : node_ids.AddDat(event.Val3, node_ids.Len()).Val;
+    events.Add(TIntTr(src, dst, event.Val1));
+  }
+  TempMotifCounter slice;
+  slice.Init(events);
+  slice.Count3TEdge23Node(delta, counts);
+}
+
+void TempMotifCounter::Count3TEdge23NodeSampled(double delta,
+                                                double window_factor,
+                                                double sample_prob, TRnd& rnd,
+                                                TFltVV& estimates,
+                                                TFltVV& std_errors) {
+  IAssert(window_factor > 0 && sample_prob > 0 && sample_prob <= 1);
+  estimates = TFltVV(6, 6);
+  std_errors = TFltVV(6, 6);
+  estimates.PutAll(0);
+  std_errors.PutAll(0);
+  // All temporal edges (timestamp, source, destination) in time order
+  TVec<TIntTr> time_events(edge_times_.Len(), 0);
+  for (int u = 0; u + 1 < out_offsets_.Len(); u++) {
+    for (int e = out_offsets_[u]; e < out_offsets_[u + 1]; e++) {
+      for (int i = time_offsets_[e]; i < time_offsets_[e + 1]; i++) {
+        time_events.Add(TIntTr(edge_times_[i], u, out_nbrs_[e]));
+      }
+    }
+  }
+  if (time_events.Empty()) { return; }
+  time_events.Sort();
+
+  // Cut the time line into intervals of length window_len at a random offset
+  // and sample them.  sampled holds the start of every sampled interval.
+  double window_len = MAX(window_factor * delta, 1.0);
+  double first_time = time_events[0].Val1;
+  double last_time = time_events.Last().Val1;
+  TFltV sampled;
+  for (double start = first_time - rnd.GetUniDev() * window_len;
+       start <= last_time; start += window_len) {
+    if (rnd.GetUniDev() < sample_prob) { sampled.Add(start); }
+  }
+
+  // Exact counts of the motifs starting in every sampled interval.  Motif
+  // instances span at most delta, so they are those in
+  // [start, start + window_len + delta] minus those that fall entirely in
+  // [start + window_len, start + window_len + delta].
+  TVec<TFltVV> thread_sums(GetNumThreads()), thread_sqsums(GetNumThreads());
+  for (int t = 0; t < thread_sums.Len(); t++) {
+    thread_sums[t] = TFltVV(6, 6);
+    thread_sqsums[t] = TFltVV(6, 6);
+    thread_sums[t].PutAll(0);
+    thread_sqsums[t].PutAll(0);
+  }
+  #pragma omp parallel for schedule(dynamic)
+  for (int w = 0; w < sampled.Len(); w++) {
+    TFltVV& local_sums = thread_sums[GetThreadId()];
+    TFltVV& local_sqsums = thread_sqsums[GetThreadId()];
+    double start = sampled[w];
+    double mid = start + window_len;
+    double end = mid + delta;
+    int beg_idx = GetFirstEvent(time_events, start, false);
+    int mid_idx = GetFirstEvent(time_events, mid, false);
+    int end_idx = GetFirstEvent(time_events, end, true);
+    if (beg_idx == mid_idx) { continue; }  // no motif starts in the interval
+    Counter2D all_counts, tail_counts;
+    Count3TEdge23NodeSlice(time_events, beg_idx, end_idx, delta, all_counts);
+    Count3TEdge23NodeSlice(time_events, mid_idx, end_idx, delta, tail_counts);
+    for (int i = 0; i < 6; i++) {
+      for (int j = 0; j < 6; j++) {
+        double x = double(all_counts(i, j)) - double(tail_counts(i, j));
+        local_sums(i, j) += x;
+        local_sqsums(i, j) += x * x;
+      }
+    }
+  }
+
+  // Horvitz-Thompson estimates and their estimated standard errors
+  for (int t = 0; t < thread_sums.Len(); t++) {
+    for (int i = 0; i < 6; i++) {
+      for (int j = 0; j < 6; j++) {
+        estimates(i, j) += thread_sums[t](i, j) / sample_prob;
+        std_errors(i, j) += thread_sqsums[t](i, j) * (1 - sample_prob)
+          / (sample_prob * sample_prob);
+      }
+    }
+  }
+  for (int i = 0; i < 6; i++) {
+    for (int j = 0; j < 6; j++) {
+      std_errors(i, j) = sqrt(std_errors(i, j).Val);
+    }
+  }
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 // Two-node (static edge) counting methods
 void TempMotifCounter::Count3TEdge2Node(double delta, Counter2D& counts) {
@@ -182,19 +383,20 @@ void TempMotifCounter::Count3TEdge2Node(double delta, Counter2D& counts) {
     }
   }
   counts = Counter2D(2, 2);
+  TVec<Counter2D> thread_counts(GetNumThreads());
+  for (int t = 0; t < thread_counts.Len(); t++) { thread_counts[t] = Counter2D(2, 2); }
   #pragma omp parallel for schedule(dynamic)
   for (int i = 0; i < undir_edges.Len(); i++) {
+    Counter2D& local_counts = thread_counts[GetThreadId()];
     TIntPair edge = undir_edges[i];
     Counter3D local;
     Count3TEdge2Node(edge.Key, edge.Dat, delta, local);
-    #pragma omp critical
-    {
-      counts(0, 0) += local(0, 1, 0) + local(1, 0, 1);  // M_{5,1}
-      counts(0, 1) += local(1, 0, 0) + local(0, 1, 1);  // M_{5,2}
-      counts(1, 0) += local(0, 0, 0) + local(1, 1, 1);  // M_{6,1}
-      counts(1, 1) += local(0, 0, 1) + local(1, 1, 0);  // M_{6,2}
-    }
+    local_counts(0, 0) += local(0, 1, 0) + local(1, 0, 1);  // M_{5,1}
+    local_counts(0, 1) += local(1, 0, 0) + local(0, 1, 1);  // M_{5,2}
+    local_counts(1, 0) += local(0, 0, 0) + local(1, 1, 1);  // M_{6,1}
+    local_counts(1, 1) += local(0, 0, 1) + local(1, 1, 0);  // M_{6,2}
   }
+  for (int t = 0; t < thread_counts.Len(); t++) { counts.Add(thread_counts[t]); }
 }
 
 void TempMotifCounter::Count3TEdge2Node(int u, int v, double delta,
@@ -220,10 +422,10 @@ void TempMotifCounter::Count3TEdge2Node(int u, int v, double delta,
 // Star counting methods
 void TempMotifCounter::AddStarEdges(TVec<TIntPair>& combined, int u, int v,
                                     int key) {
-  if (HasEdges(u, v)) {
-    const TIntV& timestamps = temporal_data_[u].GetDat(v);
-    for (int i = 0; i < timestamps.Len(); i++) {
-      combined.Add(TIntPair(timestamps[i], key));
+  int e = GetEdgeIdx(u, v);
+  if (e != -1) {
+    for (int i = time_offsets_[e]; i < time_offsets_[e + 1]; i++) {
+      combined.Add(TIntPair(edge_times_[i], key));
     }
   }
 }
@@ -236,9 +438,19 @@ void TempMotifCounter::Count3TEdge3NodeStarsNaive(
   pre_counts = Counter3D(2, 2, 2);
   pos_counts = Counter3D(2, 2, 2);
   mid_counts = Counter3D(2, 2, 2);
+  TVec<Counter3D> thread_pre(GetNumThreads()), thread_pos(GetNumThreads()),
+    thread_mid(GetNumThreads());
+  for (int t = 0; t < thread_pre.Len(); t++) {
+    thread_pre[t] = Counter3D(2, 2, 2);
+    thread_pos[t] = Counter3D(2, 2, 2);
+    thread_mid[t] = Counter3D(2, 2, 2);
+  }
   // Get counts for each node as the center
   #pragma omp parallel for schedule(dynamic)
   for (int c = 0; c < centers.Len(); c++) {
+    Counter3D& local_pre = thread_pre[GetThreadId()];
+    Counter3D& local_pos = thread_pos[GetThreadId()];
+    Counter3D& local_mid = thread_mid[GetThreadId()];
     // Gather all adjacent events
     int center = centers[c];
     TIntV nbrs;
@@ -263,33 +475,36 @@ void TempMotifCounter::Count3TEdge3NodeStarsNaive(
         Counter3D local;
         counter.Count(edge_id, timestamps, delta, local);
 
-        #pragma omp critical
-        {  // Update with local counts
-          for (int dir1 = 0; dir1 < 2; ++dir1) {
-            for (int dir2 = 0; dir2 < 2; ++dir2) {
-              for (int dir3 = 0; dir3 < 2; ++dir3) {
-                pre_counts(dir1, dir2, dir3) +=
-                  local(dir1, dir2, dir3 + 2) + local(dir1 + 2, dir2 + 2, dir3);
-                pos_counts(dir1, dir2, dir3) +=
-                  local(dir1, dir2 + 2, dir3 + 2) + local(dir1 + 2, dir2, dir3);
-                mid_counts(dir1, dir2, dir3) +=
-                  local(dir1, dir2 + 2, dir3) + local(dir1 + 2, dir2, dir3 + 2);
-              }
+        // Update with local counts
+        for (int dir1 = 0; dir1 < 2; ++dir1) {
+          for (int dir2 = 0; dir2 < 2; ++dir2) {
+            for (int dir3 = 0; dir3 < 2; ++dir3) {
+              local_pre(dir1, dir2, dir3) +=
+                local(dir1, dir2, dir3 + 2) + local(dir1 + 2, dir2 + 2, dir3);
+              local_pos(dir1, dir2, dir3) +=
+                local(dir1, dir2 + 2, dir3 + 2) + local(dir1 + 2, dir2, dir3);
+              local_mid(dir1, dir2, dir3) +=
+                local(dir1, dir2 + 2, dir3) + local(dir1 + 2, dir2, dir3 + 2);
             }
           }
         }
       }
     }
   }
+  for (int t = 0; t < thread_pre.Len(); t++) {
+    pre_counts.Add(thread_pre[t]);
+    pos_counts.Add(thread_pos[t]);
+    mid_counts.Add(thread_mid[t]);
+  }
 }
 
 void TempMotifCounter::AddStarEdgeData(TVec<TIntPair>& ts_indices,
                                        TVec<StarEdgeData>& events,
                                        int& index, int u, int v, int nbr, int key) {
-  if (HasEdges(u, v)) {
-    const TIntV& ts_vec = temporal_data_[u].GetDat(v);
-    for (int j = 0; j < ts_vec.Len(); ++j) {
-      ts_indices.Add(TIntPair(ts_vec[j], index));
+  int e = GetEdgeIdx(u, v);
+  if (e != -1) {
+    for (int j = time_offsets_[e]; j < time_offsets_[e + 1]; ++j) {
+      ts_indices.Add(TIntPair(edge_times_[j], index));
       events.Add(StarEdgeData(nbr, key));
       index++;
     }
@@ -304,9 +519,21 @@ void TempMotifCounter::Count3TEdge3NodeStars(double delta, Counter3D& pre_counts
   pre_counts = Counter3D(2, 2, 2);
   pos_counts = Counter3D(2, 2, 2);
   mid_counts = Counter3D(2, 2, 2);
+  // Counts are unsigned, the edge-wise subtractions below may wrap around in a
+  // thread's counter but the reduced sums are exact.
+  TVec<Counter3D> thread_pre(GetNumThreads()), thread_pos(GetNumThreads()),
+    thread_mid(GetNumThreads());
+  for (int t = 0; t < thread_pre.Len(); t++) {
+    thread_pre[t] = Counter3D(2, 2, 2);
+    thread_pos[t] = Counter3D(2, 2, 2);
+    thread_mid[t] = Counter3D(2, 2, 2);
+  }
   // Get counts for each node as the center
   #pragma omp parallel for schedule(dynamic)  
   for (int c = 0; c < centers.Len(); c++) {
+    Counter3D& local_pre = thread_pre[GetThreadId()];
+    Counter3D& local_pos = thread_pos[GetThreadId()];
+    Counter3D& local_mid = thread_mid[GetThreadId()];
     // Gather all adjacent events
     int center = centers[c];
     TVec<TIntPair> ts_indices;
@@ -333,15 +560,13 @@ void TempMotifCounter::Count3TEdge3NodeStars(double delta, Counter3D& pre_counts
     ThreeTEdgeStarCounter tesc(nbr_index);
     // dirs: outgoing --> 0, incoming --> 1
     tesc.Count(ordered_events, timestamps, delta);
-    #pragma omp critical
-    { // Update counts
-      for (int dir1 = 0; dir1 < 2; ++dir1) {
-        for (int dir2 = 0; dir2 < 2; ++dir2) {
-          for (int dir3 = 0; dir3 < 2; ++dir3) {
-            pre_counts(dir1, dir2, dir3) += tesc.PreCount(dir1, dir2, dir3);
-            pos_counts(dir1, dir2, dir3) += tesc.PosCount(dir1, dir2, dir3);
-            mid_counts(dir1, dir2, dir3) += tesc.MidCount(dir1, dir2, dir3);
-          }
+    // Update counts
+    for (int dir1 = 0; dir1 < 2; ++dir1) {
+      for (int dir2 = 0; dir2 < 2; ++dir2) {
+        for (int dir3 = 0; dir3 < 2; ++dir3) {
+          local_pre(dir1, dir2, dir3) += tesc.PreCount(dir1, dir2, dir3);
+          local_pos(dir1, dir2, dir3) += tesc.PosCount(dir1, dir2, dir3);
+          local_mid(dir1, dir2, dir3) += tesc.MidCount(dir1, dir2, dir3);
         }
       }
     }
@@ -351,20 +576,22 @@ void TempMotifCounter::Count3TEdge3NodeStars(double delta, Counter3D& pre_counts
       int nbr = nbrs[nbr_id];
       Counter3D edge_counts;
       Count3TEdge2Node(center, nbr, delta, edge_counts);
-      #pragma omp critical
-      {
-        for (int dir1 = 0; dir1 < 2; ++dir1) {
-          for (int dir2 = 0; dir2 < 2; ++dir2) {
-            for (int dir3 = 0; dir3 < 2; ++dir3) {
-              pre_counts(dir1, dir2, dir3) -= edge_counts(dir1, dir2, dir3);
-              pos_counts(dir1, dir2, dir3) -= edge_counts(dir1, dir2, dir3);
-              mid_counts(dir1, dir2, dir3) -= edge_counts(dir1, dir2, dir3);
-            }
+      for (int dir1 = 0; dir1 < 2; ++dir1) {
+        for (int dir2 = 0; dir2 < 2; ++dir2) {
+          for (int dir3 = 0; dir3 < 2; ++dir3) {
+            local_pre(dir1, dir2, dir3) -= edge_counts(dir1, dir2, dir3);
+            local_pos(dir1, dir2, dir3) -= edge_counts(dir1, dir2, dir3);
+            local_mid(dir1, dir2, dir3) -= edge_counts(dir1, dir2, dir3);
           }
         }
       }
     }
   }
+  for (int t = 0; t < thread_pre.Len(); t++) {
+    pre_counts.Add(thread_pre[t]);
+    pos_counts.Add(thread_pos[t]);
+    mid_counts.Add(thread_mid[t]);
+  }
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -373,8 +600,13 @@ void TempMotifCounter::Count3TEdgeTriadsNaive(double delta, Counter3D& counts) {
   TIntV Us, Vs, Ws;
   GetAllStaticTriangles(Us, Vs, Ws);
   counts = Counter3D(2, 2, 2);
+  TVec<Counter3D> thread_counts(GetNumThreads());
+  for (int t = 0; t < thread_counts.Len(); t++) {
+    thread_counts[t] = Counter3D(2, 2, 2);
+  }
   #pragma omp parallel for schedule(dynamic)
   for (int i = 0; i < Us.Len(); i++) {
+    Counter3D& tri_counts = thread_counts[GetThreadId()];
     int u = Us[i];
     int v = Vs[i];
     int w = Ws[i];
@@ -399,34 +631,34 @@ void TempMotifCounter::Count3TEdgeTriadsNaive(double delta, Counter3D& counts) {
     Counter3D local;
     counter.Count(edge_id, timestamps, delta, local);
 
-    // Update the global counter with the various symmetries
-    #pragma omp critical
-    {
-      // i --> j, k --> j, i --> k
-      counts(0, 0, 0) += local(uv, wv, uw) + local(vu, wu, vw) + local(uw, vw, uv)
-        + local(wu, vu, wv) + local(vw, uw, vu) + local(wv, uv, wu);
-      // i --> j, k --> j, k --> i
-      counts(0, 0, 1) += local(uv, wv, wu) + local(vu, wu, wv) + local(uw, vw, vu)
-        + local(wu, vu, vw) + local(vw, uw, uv) + local(wv, uv, uw);
-      // i --> j, j --> k, i --> k
-      counts(0, 1, 0) += local(uv, vw, uw) + local(vu, uw, vw) + local(uw, wv, uv)
-        + local(wu, uv, wv) + local(vw, wu, vu) + local(wv, vu, wu);
-      // i --> j, j --> k, k --> i
-      counts(0, 1, 1) += local(uv, vw, wu) + local(vu, uw, wv) + local(uw, wv, vu)
-        + local(wu, uv, vw) + local(vw, wu, uv) + local(wv, vu, uw);
-      // i --> j, k --> i, j --> k
-      counts(1, 0, 0) += local(uv, wu, vw) + local(vu, wv, uw) + local(uw, vu, wv)
-        + local(wu, vw, uv) + local(vw, uv, wu) + local(wv, uw, vu);
-      // i --> j, k --> i, k --> j
-      counts(1, 0, 1) += local(uv, wu, wv) + local(vu, wv, wu) + local(uw, vu, vw)
-        + local(wu, vw, vu) + local(vw, uv, uw) + local(wv, uw, uv);
-      // i --> j, i --> k, j --> k
-      counts(1, 1, 0) += local(uv, uw, vw) + local(vu, vw, uw) + local(uw, uv, wv)
-        + local(wu, wv, uv) + local(vw, vu, wu) + local(wv, wu, vu);      
-      // i --> j, i --> k, k --> j
-      counts(1, 1, 1) += local(uv, uw, wv) + local(vu, vw, wu) + local(uw, uv, vw)
-        + local(wu, wv, vu) + local(vw, vu, uw) + local(wv, wu, uv);
-    }
+    // Update the thread's counter with the various symmetries
+    // i --> j, k --> j, i --> k
+    tri_counts(0, 0, 0) += local(uv, wv, uw) + local(vu, wu, vw) + local(uw, vw, uv)
+      + local(wu, vu, wv) + local(vw, uw, vu) + local(wv, uv, wu);
+    // i --> j, k --> j, k --> i
+    tri_counts(0, 0, 1) += local(uv, wv, wu) + local(vu, wu, wv) + local(uw, vw, vu)
+      + local(wu, vu, vw) + local(vw, uw, uv) + local(wv, uv, uw);
+    // i --> j, j --> k, i --> k
+    tri_counts(0, 1, 0) += local(uv, vw, uw) + local(vu, uw, vw) + local(uw, wv, uv)
+      + local(wu, uv, wv) + local(vw, wu, vu) + local(wv, vu, wu);
+    // i --> j, j --> k, k --> i
+    tri_counts(0, 1, 1) += local(uv, vw, wu) + local(vu, uw, wv) + local(uw, wv, vu)
+      + local(wu, uv, vw) + local(vw, wu, uv) + local(wv, vu, uw);
+    // i --> j, k --> i, j --> k
+    tri_counts(1, 0, 0) += local(uv, wu, vw) + local(vu, wv, uw) + local(uw, vu, wv)
+      + local(wu, vw, uv) + local(vw, uv, wu) + local(wv, uw, vu);
+    // i --> j, k --> i, k --> j
+    tri_counts(1, 0, 1) += local(uv, wu, wv) + local(vu, wv, wu) + local(uw, vu, vw)
+      + local(wu, vw, vu) + local(vw, uv, uw) + local(wv, uw, uv);
+    // i --> j, i --> k, j --> k
+    tri_counts(1, 1, 0) += local(uv, uw, vw) + local(vu, vw, uw) + local(uw, uv, wv)
+      + local(wu, wv, uv) + local(vw, vu, wu) + local(wv, wu, vu);      
+    // i --> j, i --> k, k --> j
+    tri_counts(1, 1, 1) += local(uv, uw, wv) + local(vu, vw, wu) + local(uw, uv, vw)
+      + local(wu, wv, vu) + local(vw, vu, uw) + local(wv, wu, uv);
+  }
+  for (int t = 0; t < thread_counts.Len(); t++) {
+    counts.Add(thread_counts[t]);
   }
 }
 
@@ -434,10 +666,10 @@ void TempMotifCounter::AddTriadEdgeData(TVec<TriadEdgeData>& events,
                                         TVec<TIntPair>& ts_indices,
                                         int& index, int u, int v, int nbr,
                                         int key1, int key2) {
-  if (HasEdges(u, v)) {
-    const TIntV& timestamps = temporal_data_[u].GetDat(v);
-    for (int i = 0; i < timestamps.Len(); i++) {
-      ts_indices.Add(TIntPair(timestamps[i], index));
+  int edge_idx = GetEdgeIdx(u, v);
+  if (edge_idx != -1) {
+    for (int i = time_offsets_[edge_idx]; i < time_offsets_[edge_idx + 1]; i++) {
+      ts_indices.Add(TIntPair(edge_times_[i], index));
       events.Add(TriadEdgeData(nbr, key1, key2));
       ++index;
     }
@@ -456,15 +688,18 @@ void TempMotifCounter::Count3TEdgeTriads(double delta, Counter3D& counts) {
     int dst = it.GetDstNId();
     int min_node = MIN(src, dst);
     int max_node = MAX(src, dst);
-    edge_counts[min_node](max_node) += temporal_data_[src](dst).Len();
+    edge_counts[min_node](max_node) += GetEdges(src, dst);
     assignments[min_node](max_node) = TIntV();
   }
   
-  // Assign triangles to the edge with the most events
+  // Assign triangles to the edge with the most events. Each thread records
+  // (edge min node, edge max node, third node), applied after the loop.
   TIntV Us, Vs, Ws;
   GetAllStaticTriangles(Us, Vs, Ws);
+  TVec< TVec<TIntTr> > thread_assignments(GetNumThreads());
   #pragma omp parallel for schedule(dynamic)
   for (int i = 0; i < Us.Len(); i++) {
+    TVec<TIntTr>& local_assignments = thread_assignments[GetThreadId()];
     int u = Us[i];
     int v = Vs[i];
     int w = Ws[i];
@@ -472,23 +707,18 @@ void TempMotifCounter::Count3TEdgeTriads(double delta, Counter3D& counts) {
     int counts_uw = edge_counts[MIN(u, w)].GetDat(MAX(u, w));
     int counts_vw = edge_counts[MIN(v, w)].GetDat(MAX(v, w));
     if        (counts_uv >= MAX(counts_uw, counts_vw)) {
-      #pragma omp critical
-      {
-        TIntV& assignment = assignments[MIN(u, v)].GetDat(MAX(u, v));
-        assignment.Add(w);
-      }
+      local_assignments.Add(TIntTr(MIN(u, v), MAX(u, v), w));
     } else if (counts_uw >= MAX(counts_uv, counts_vw)) {
-      #pragma omp critical
-      {
-        TIntV& assignment = assignments[MIN(u, w)].GetDat(MAX(u, w));
-        assignment.Add(v);      
-      }
+      local_assignments.Add(TIntTr(MIN(u, w), MAX(u, w), v));
     } else if (counts_vw >= MAX(counts_uv, counts_uw)) {
-      #pragma omp critical
-      {
-        TIntV& assignment = assignments[MIN(v, w)].GetDat(MAX(v, w));
-        assignment.Add(u);              
-      }
+      local_assignments.Add(TIntTr(MIN(v, w), MAX(v, w), u));
+    }
+  }
+  for (int t = 0; t < thread_assignments.Len(); t++) {
+    const TVec<TIntTr>& local_assignments = thread_assignments[t];
+    for (int i = 0; i < local_assignments.Len(); i++) {
+      const TIntTr& tr = local_assignments[i];
+      assignments[tr.Val1].GetDat(tr.Val2).Add(tr.Val3);
     }
   }
 
@@ -508,8 +738,13 @@ void TempMotifCounter::Count3TEdgeTriads(double delta, Counter3D& counts) {
   }
 
   // Count triangles on edges with the assigned neighbors
+  TVec<Counter3D> thread_counts(GetNumThreads());
+  for (int t = 0; t < thread_counts.Len(); t++) {
+    thread_counts[t] = Counter3D(2, 2, 2);
+  }
   #pragma omp parallel for schedule(dynamic)
   for (int edge_id = 0; edge_id < all_edges.Len(); edge_id++) {
+    Counter3D& local_counts = thread_counts[GetThreadId()];
     TIntPair edge = all_edges[edge_id];
     int u = edge.Key;
     int v = edge.Dat;
@@ -549,17 +784,17 @@ void TempMotifCounter::Count3TEdgeTriads(double delta, Counter3D& counts) {
     // Get the counts and update the counter
     ThreeTEdgeTriadCounter tetc(nbr_index, 0, 1);
     tetc.Count(sorted_events, timestamps, delta);
-    #pragma omp critical
-    {
-      for (int dir1 = 0; dir1 < 2; dir1++) {
-        for (int dir2 = 0; dir2 < 2; dir2++) {
-          for (int dir3 = 0; dir3 < 2; dir3++) {        
-            counts(dir1, dir2, dir3) += tetc.Counts(dir1, dir2, dir3);
-          }
+    for (int dir1 = 0; dir1 < 2; dir1++) {
+      for (int dir2 = 0; dir2 < 2; dir2++) {
+        for (int dir3 = 0; dir3 < 2; dir3++) {
+          local_counts(dir1, dir2, dir3) += tetc.Counts(dir1, dir2, dir3);
         }
       }
     }
   }
+  for (int t = 0; t < thread_counts.Len(); t++) {
+    counts.Add(thread_counts[t]);
+  }
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -18,6 +18,10 @@ class Counter1D {
   const TUInt64& operator()(int i) const { return data_[i]; }
   TUInt64& operator()(int i) { return data_[i]; }
   int m() { return m_; }
+  // Adds the counts of other, which must have the same dimensions.
+  void Add(const Counter1D& other) {
+    for (int i = 0; i < data_.Len(); i++) { data_[i] += other.data_[i]; }
+  }
   
  private:
   int m_;
@@ -36,6 +40,10 @@ class Counter2D {
   TUInt64& operator()(int i, int j) { return data_[i + j * m_]; }
   int m() { return m_; }
   int n() { return n_; }
+  // Adds the counts of other, which must have the same dimensions.
+  void Add(const Counter2D& other) {
+    for (int i = 0; i < data_.Len(); i++) { data_[i] += other.data_[i]; }
+  }
   
  private:
   int m_;
@@ -60,6 +68,10 @@ class Counter3D {
   int m() { return m_; }
   int n() { return n_; }
   int p() { return p_; }  
+  // Adds the counts of other, which must have the same dimensions.
+  void Add(const Counter3D& other) {
+    for (int i = 0; i < data_.Len(); i++) { data_[i] += other.data_[i]; }
+  }
   
  private:
   int m_;
@@ -98,6 +110,11 @@ class TempMotifCounter {
   //    source_node destination_node unix_timestamp
   TempMotifCounter(const TStr& filename);
 
+  // Takes the temporal edges from the integer columns of an already loaded
+  // table, one temporal edge per row.
+  TempMotifCounter(const PTable& table, const TStr& src_col="source",
+                   const TStr& dst_col="destination", const TStr& time_col="time");
+
   // Count all three temporal edge, two-node delta-temporal motifs and fills the
   // counter counts with the results.  The format is:
   //   counts(0, 0): u --> v, v --> u, u --> v  (M_{5,1})
@@ -160,7 +177,35 @@ class TempMotifCounter {
   // counts such that counts(i, j) corresponds to motif M_{i,j}.
   void Count3TEdge23Node(double delta, Counter2D& counts);  
 
+  // Estimates the counts of Count3TEdge23Node() by interval sampling.  The
+  // time line is cut into intervals of length window_factor * delta at a random
+  // offset, and every interval is sampled independently with probability
+  // sample_prob.  For a sampled interval [a, a + L), the motif instances that
+  // start in it are counted exactly, as the instances in [a, a + L + delta)
+  // minus those in [a + L, a + L + delta).  The estimates are these counts
+  // divided by sample_prob, which is unbiased; std_errors holds the estimated
+  // standard errors.  Both are 6 x 6 and indexed like counts above.
+  // See: P. Liu, A. R. Benson, M. Charikar, Sampling Methods for Counting
+  // Temporal Motifs, WSDM 2019.
+  void Count3TEdge23NodeSampled(double delta, double window_factor,
+                                double sample_prob, TRnd& rnd,
+                                TFltVV& estimates, TFltVV& std_errors);
+
  private:
+  TempMotifCounter() {}
+  // Builds the static graph and the temporal edge arrays from the temporal
+  // edges (source, destination, timestamp).  Self loops are skipped.
+  void Init(TVec<TIntTr>& events);
+  // Returns the static edge index of (u, v) or -1 if there is no temporal edge
+  // from u to v.
+  int GetEdgeIdx(int u, int v) const;
+  // Returns the number of temporal edges from u to v.
+  int GetEdges(int u, int v) const;
+  // Runs Count3TEdge23Node() on the temporal edges (timestamp, source,
+  // destination) time_events[beg..end), relabeling the nodes densely.
+  static void Count3TEdge23NodeSlice(const TVec<TIntTr>& time_events, int beg,
+                                     int end, double delta, Counter2D& counts);
+
   // Get all triangles in the static graph, (Us(i), Vs(i), Ws(i)) is the ith
   // triangle.
   void GetAllStaticTriangles(TIntV& Us, TIntV& Vs, TIntV& Ws);
@@ -185,9 +230,15 @@ class TempMotifCounter {
   // Directed graph from ignoring timestamps
   PNGraph static_graph_;  
 
-  // Core data structure for storing temporal edges.  temporal_data_[u](v) is a
-  // list of temporal edges along the static edge (u, v).
-  TVec< THash<TInt, TIntV> > temporal_data_;
+  // Core data structure for storing temporal edges.  The static edges with
+  // source u are out_nbrs_[out_offsets_[u]..out_offsets_[u + 1]), sorted by
+  // destination; the position e of (u, v) there is its static edge index.  The
+  // timestamps of the temporal edges along static edge e are
+  // edge_times_[time_offsets_[e]..time_offsets_[e + 1]), sorted by time.
+  TIntV out_offsets_;
+  TIntV out_nbrs_;
+  TIntV time_offsets_;
+  TIntV edge_times_;
 };
 
 // This class exhaustively counts all size^3 three-edge temporal motifs in an
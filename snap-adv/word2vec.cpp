@@ -15,7 +15,7 @@ void LearnVocab(TVVec<TInt, int64>& WalksVV, TIntV& Vocab) {
 }
 
 //Precompute unigram table using alias sampling method
-void InitUnigramTable(TIntV& Vocab, TIntV& KTable, TFltV& UTable) {
+void InitUnigramTable(const TIntV& Vocab, TIntV& KTable, TFltV& UTable) {
   double TrainWordsPow = 0;
   double Pwr = 0.75;
   TFltV ProbV(Vocab.Len());
@@ -63,105 +63,210 @@ void InitUnigramTable(TIntV& Vocab, TIntV& KTable, TFltV& UTable) {
   }
 }
 
-int64 RndUnigramInt(TIntV& KTable, TFltV& UTable, TRnd& Rnd) {
-  TInt X = KTable[static_cast<int64>(Rnd.GetUniDev()*KTable.Len())];
-  double Y = Rnd.GetUniDev();
-  return Y < UTable[X] ? X : KTable[X];
+//Returns a pointer into BufV aligned to 64 bytes
+static float* GetAligned(TVec<float, int64>& BufV) {
+  return reinterpret_cast<float*>((reinterpret_cast<size_t>(BufV.BegI()) + 63) & ~static_cast<size_t>(63));
 }
 
-//Initialize negative embeddings
-void InitNegEmb(TIntV& Vocab, const int& Dimensions, TVVec<TFlt, int64>& SynNeg) {
-  SynNeg = TVVec<TFlt, int64>(Vocab.Len(),Dimensions);
-  for (int64 i = 0; i < SynNeg.GetXDim(); i++) {
-    for (int j = 0; j < SynNeg.GetYDim(); j++) {
-      SynNeg(i,j) = 0;
-    }
-  }
+//Returns a pointer into BufV aligned to 64 bytes, with room for Len floats
+static float* GenAligned(TVec<float, int64>& BufV, const int64& Len) {
+  BufV.Gen(Len + 16);
+  for (int64 i = 0; i < BufV.Len(); i++) { BufV[i] = 0; }
+  return GetAligned(BufV);
+}
+
+//Dot product of two aligned rows, Len is a multiple of 16
+static inline float GetDot(const float* X, const float* Y, const int& Len) {
+  float Sum = 0;
+#pragma omp simd reduction(+:Sum) aligned(X,Y:64)
+  for (int i = 0; i < Len; i++) { Sum += X[i] * Y[i]; }
+  return Sum;
+}
+
+//Y += A*X on aligned rows, Len is a multiple of 16
+static inline void AddScaled(const float& A, const float* X, float* Y, const int& Len) {
+#pragma omp simd aligned(X,Y:64)
+  for (int i = 0; i < Len; i++) { Y[i] += A * X[i]; }
+}
+
+//Y = X on aligned rows, Len is a multiple of 16
+static inline void CopyRow(const float* X, float* Y, const int& Len) {
+#pragma omp simd aligned(X,Y:64)
+  for (int i = 0; i < Len; i++) { Y[i] = X[i]; }
 }
 
-//Initialize positive embeddings
-void InitPosEmb(TIntV& Vocab, const int& Dimensions, TRnd& Rnd, TVVec<TFlt, int64>& SynPos) {
-  SynPos = TVVec<TFlt, int64>(Vocab.Len(),Dimensions);
-  for (int64 i = 0; i < SynPos.GetXDim(); i++) {
-    for (int j = 0; j < SynPos.GetYDim(); j++) {
-      SynPos(i,j) =(Rnd.GetUniDev()-0.5)/Dimensions;
+TSkipGram::TSkipGram(const TIntV& Vocab, const int& _Dimensions, const int& _WinSize,
+    const int64& _AllWords, const bool& _Verbose, TRnd& Rnd) : Dimensions(_Dimensions),
+    WinSize(_WinSize), RowLen((_Dimensions + 15) / 16 * 16), Verbose(_Verbose),
+    KTable(Vocab.Len()), UTable(Vocab.Len()), SigmoidV(TableSize),
+    AllWords(_AllWords), WordCntAll(0) {
+  const int64 Words = Vocab.Len();
+  SynPos = GenAligned(SynPosV, Words * RowLen);
+  SynNeg = GenAligned(SynNegV, Words * RowLen);
+  //positive embeddings are random, negative ones zero, padding stays zero
+  for (int64 i = 0; i < Words; i++) {
+    for (int j = 0; j < Dimensions; j++) {
+      SynPos[i*RowLen + j] = static_cast<float>((Rnd.GetUniDev()-0.5)/Dimensions);
     }
   }
+  InitUnigramTable(Vocab, KTable, UTable);
+  //local copies of the context rows (inputs) and the target rows (the word and its negatives)
+#ifdef USE_OPENMP
+  TrainBufV.Gen(omp_get_max_threads());
+#else
+  TrainBufV.Gen(1);
+#endif
+  const int MxCtx = 2 * WinSize, MxTgt = NegSamN + 1;
+  for (int t = 0; t < TrainBufV.Len(); t++) {
+    TTrainBuf& Buf = TrainBufV[t];
+    GenAligned(Buf.InBufV, MxCtx * RowLen);
+    GenAligned(Buf.InGradBufV, MxCtx * RowLen);
+    GenAligned(Buf.OutBufV, MxTgt * RowLen);
+    GenAligned(Buf.OutGradBufV, MxTgt * RowLen);
+    Buf.CtxV.Gen(MxCtx);
+    Buf.TgtV.Gen(MxTgt);
+    Buf.GradV.Gen(MxCtx * MxTgt);
+  }
+  for (int i = 0; i < TableSize; i++ ) {
+    double Value = -MaxExp + static_cast<double>(i) / static_cast<double>(ExpTablePrecision);
+    SigmoidV[i] = static_cast<float>(1 / (1 + TMath::Power(TMath::E, -Value)));
+  }
 }
 
-void TrainModel(TVVec<TInt, int64>& WalksVV, const int& Dimensions,
-    const int& WinSize, const int& Iter, const bool& Verbose,
-    TIntV& KTable, TFltV& UTable, int64& WordCntAll, TFltV& ExpTable,
-    double& Alpha, int64 CurrWalk, TRnd& Rnd,
-    TVVec<TFlt, int64>& SynNeg, TVVec<TFlt, int64>& SynPos)  {
-  TFltV Neu1V(Dimensions);
-  TFltV Neu1eV(Dimensions);
-  int64 AllWords = WalksVV.GetXDim()*WalksVV.GetYDim();
-  TIntV WalkV(WalksVV.GetYDim());
-  for (int j = 0; j < WalksVV.GetYDim(); j++) { WalkV[j] = WalksVV(CurrWalk,j); }
-  for (int64 WordI=0; WordI<WalkV.Len(); WordI++) {
-    if ( WordCntAll%10000 == 0 ) {
-      if ( Verbose ) {
-        printf("\rLearning Progress: %.2lf%% ",(double)WordCntAll*100/(double)(Iter*AllWords));
-        fflush(stdout);
-      }
-      Alpha = StartAlpha * (1 - WordCntAll / static_cast<double>(Iter * AllWords + 1));
-      if ( Alpha < StartAlpha * 0.0001 ) { Alpha = StartAlpha * 0.0001; }
-    }
-    int64 Word = WalkV[WordI];
-    for (int i = 0; i < Dimensions; i++) {
-      Neu1V[i] = 0;
-      Neu1eV[i] = 0;
-    }
-    int Offset = Rnd.GetUniDevInt() % WinSize;
+//Draws a word from the unigram^0.75 distribution with the alias table
+int TSkipGram::GetRndUnigram(TRnd& Rnd) const {
+  const int X = static_cast<int>(Rnd.GetUniDev()*KTable.Len());
+  return Rnd.GetUniDev() < UTable[X] ? X : KTable[X].Val;
+}
+
+void TSkipGram::TrainWalk(const TInt* WalkI, const int& WalkLen, TRnd& Rnd) {
+  //learning rate is set once per walk from the shared word count
+  float Alpha = static_cast<float>(StartAlpha * (1 - WordCntAll / static_cast<double>(AllWords + 1)));
+  if ( Alpha < StartAlpha * 0.0001 ) { Alpha = static_cast<float>(StartAlpha * 0.0001); }
+#ifdef USE_OPENMP
+  const int ThreadN = omp_get_thread_num();
+#else
+  const int ThreadN = 0;
+#endif
+  IAssertR(ThreadN < TrainBufV.Len(), "More threads than at construction of TSkipGram");
+  TTrainBuf& Buf = TrainBufV[ThreadN];
+  const int MxTgt = NegSamN + 1;
+  float* InM = GetAligned(Buf.InBufV);
+  float* InGradM = GetAligned(Buf.InGradBufV);
+  float* OutM = GetAligned(Buf.OutBufV);
+  float* OutGradM = GetAligned(Buf.OutGradBufV);
+  TIntV& CtxV = Buf.CtxV;
+  TIntV& TgtV = Buf.TgtV;
+  TVec<float>& GradV = Buf.GradV;
+  for (int WordI = 0; WordI < WalkLen; WordI++) {
+    const int Word = WalkI[WordI];
+    const int Offset = Rnd.GetUniDevInt() % WinSize;
+    int Ctxs = 0;
     for (int a = Offset; a < WinSize * 2 + 1 - Offset; a++) {
       if (a == WinSize) { continue; }
-      int64 CurrWordI = WordI - WinSize + a;
-      if (CurrWordI < 0){ continue; }
-      if (CurrWordI >= WalkV.Len()){ continue; }
-      int64 CurrWord = WalkV[CurrWordI];
-      for (int i = 0; i < Dimensions; i++) { Neu1eV[i] = 0; }
-      //negative sampling
-      for (int j = 0; j < NegSamN+1; j++) {
-        int64 Target, Label;
-        if (j == 0) {
-          Target = Word;
-          Label = 1;
-        } else {
-          Target = RndUnigramInt(KTable, UTable, Rnd);
-          if (Target == Word) { continue; }
-          Label = 0;
-        }
-        double Product = 0;
-        for (int i = 0; i < Dimensions; i++) {
-          Product += SynPos(CurrWord,i) * SynNeg(Target,i);
-        }
-        double Grad;                     //Gradient multiplied by learning rate
-        if (Product > MaxExp) { Grad = (Label - 1) * Alpha; }
-        else if (Product < -MaxExp) { Grad = Label * Alpha; }
-        else { 
-          double Exp = ExpTable[static_cast<int>(Product*ExpTablePrecision)+TableSize/2];
-          Grad = (Label - 1 + 1 / (1 + Exp)) * Alpha;
-        }
-        for (int i = 0; i < Dimensions; i++) { 
-          Neu1eV[i] += Grad * SynNeg(Target,i);
-          SynNeg(Target,i) += Grad * SynPos(CurrWord,i);
-        }
-      }
-      for (int i = 0; i < Dimensions; i++) {
-        SynPos(CurrWord,i) += Neu1eV[i];
+      const int CurrWordI = WordI - WinSize + a;
+      if (CurrWordI < 0 || CurrWordI >= WalkLen) { continue; }
+      CtxV[Ctxs++] = WalkI[CurrWordI];
+    }
+    if (Ctxs == 0) { continue; }
+    //the word is the positive target, negatives are shared by the whole window
+    int Tgts = 0;
+    TgtV[Tgts++] = Word;
+    for (int j = 0; j < NegSamN; j++) {
+      const int Target = GetRndUnigram(Rnd);
+      if (Target != Word) { TgtV[Tgts++] = Target; }
+    }
+    for (int c = 0; c < Ctxs; c++) { CopyRow(SynPos + int64(CtxV[c])*RowLen, InM + c*RowLen, RowLen); }
+    for (int t = 0; t < Tgts; t++) { CopyRow(SynNeg + int64(TgtV[t])*RowLen, OutM + t*RowLen, RowLen); }
+    //Ctxs x Tgts scores, gradient multiplied by learning rate
+    for (int c = 0; c < Ctxs; c++) {
+      for (int t = 0; t < Tgts; t++) {
+        const float Product = GetDot(InM + c*RowLen, OutM + t*RowLen, RowLen);
+        float Sigmoid;
+        if (Product >= MaxExp) { Sigmoid = 1; }
+        else if (Product <= -MaxExp) { Sigmoid = 0; }
+        else { Sigmoid = SigmoidV[static_cast<int>((Product + MaxExp) * ExpTablePrecision)]; }
+        GradV[c*MxTgt + t] = ((t == 0 ? 1 : 0) - Sigmoid) * Alpha;
       }
     }
-    WordCntAll++;
+    //input gradients Grad x OutM, output gradients Grad^T x InM
+    for (int c = 0; c < Ctxs; c++) {
+      float* InGrad = InGradM + c*RowLen;
+      for (int i = 0; i < RowLen; i++) { InGrad[i] = 0; }
+      for (int t = 0; t < Tgts; t++) { AddScaled(GradV[c*MxTgt + t], OutM + t*RowLen, InGrad, RowLen); }
+    }
+    for (int t = 0; t < Tgts; t++) {
+      float* OutGrad = OutGradM + t*RowLen;
+      for (int i = 0; i < RowLen; i++) { OutGrad[i] = 0; }
+      for (int c = 0; c < Ctxs; c++) { AddScaled(GradV[c*MxTgt + t], InM + c*RowLen, OutGrad, RowLen); }
+    }
+    for (int c = 0; c < Ctxs; c++) { AddScaled(1, InGradM + c*RowLen, SynPos + int64(CtxV[c])*RowLen, RowLen); }
+    for (int t = 0; t < Tgts; t++) { AddScaled(1, OutGradM + t*RowLen, SynNeg + int64(TgtV[t])*RowLen, RowLen); }
+  }
+#ifdef USE_OPENMP
+  const int64 PrevCnt = __sync_fetch_and_add(&WordCntAll.Val, (int64) WalkLen);
+#else
+  const int64 PrevCnt = WordCntAll;
+  WordCntAll += WalkLen;
+#endif
+  if ( Verbose && PrevCnt/100000 != (PrevCnt+WalkLen)/100000 ) {
+    printf("\rLearning Progress: %.2lf%% ",(double)(PrevCnt+WalkLen)*100/(double)AllWords);
+    fflush(stdout);
+  }
+}
+
+void TSkipGram::GetEmbeddings(const TIntV& NIdV, TIntFltVH& EmbeddingsHV) const {
+  for (int i = 0; i < KTable.Len(); i++) {
+    TFltV CurrV(Dimensions);
+    for (int j = 0; j < Dimensions; j++) { CurrV[j] = SynPos[int64(i)*RowLen + j]; }
+    EmbeddingsHV.AddDat(NIdV[i], CurrV);
+  }
+}
+
+void SaveEmbeddingsBin(const PSOut& SOut, const TIntFltVH& EmbeddingsHV) {
+  int KeyId = EmbeddingsHV.FFirstKeyId();
+  const int Dimensions = EmbeddingsHV.FNextKeyId(KeyId) ? EmbeddingsHV[KeyId].Len() : 0;
+  SOut->PutStr(TStr::Fmt("%d %d", EmbeddingsHV.Len(), Dimensions));
+  SOut->PutLn();
+  for (int i = EmbeddingsHV.FFirstKeyId(); EmbeddingsHV.FNextKeyId(i);) {
+    IAssertR(EmbeddingsHV[i].Len() == Dimensions, "All embeddings must have the same dimensions");
+    SOut->PutInt(EmbeddingsHV.GetKey(i));
+    SOut->PutCh(' ');
+    for (int j = 0; j < Dimensions; j++) {
+      const float Val = static_cast<float>(EmbeddingsHV[i][j]);
+      SOut->PutBf(&Val, sizeof(float));
+    }
+    SOut->PutLn();
   }
 }
 
+void LoadEmbeddingsBin(const PSIn& SIn, TIntFltVH& EmbeddingsHV) {
+  TStr Ln;
+  EAssertR(SIn->GetNextLn(Ln), "Missing header line of binary embeddings");
+  TStr NStr, DimStr;
+  Ln.SplitOnCh(NStr, ' ', DimStr);
+  const int N = NStr.GetInt(), Dimensions = DimStr.GetInt();
+  EmbeddingsHV.Gen(N);
+  for (int i = 0; i < N; i++) {
+    TChA NIdChA;
+    char Ch;
+    while ((Ch = SIn->GetCh()) != ' ') { NIdChA += Ch; }
+    TFltV CurrV(Dimensions);
+    for (int j = 0; j < Dimensions; j++) {
+      float Val;
+      SIn->GetBf(&Val, sizeof(float));
+      CurrV[j] = Val;
+    }
+    EAssertR(SIn->GetCh() == '\n', "Bad format of binary embeddings");
+    EmbeddingsHV.AddDat(TStr(NIdChA).GetInt(), CurrV);
+  }
+}
 
 void LearnEmbeddings(TVVec<TInt, int64>& WalksVV, const int& Dimensions,
   const int& WinSize, const int& Iter, const bool& Verbose,
   TIntFltVH& EmbeddingsHV) {
   TIntIntH RnmH;
-  TIntIntH RnmBackH;
+  TIntV RnmBackV;
   int64 NNodes = 0;
   //renaming nodes into consecutive numbers
   for (int i = 0; i < WalksVV.GetXDim(); i++) {
@@ -170,42 +275,37 @@ void LearnEmbeddings(TVVec<TInt, int64>& WalksVV, const int& Dimensions,
         WalksVV(i, j) = RnmH.GetDat(WalksVV(i, j));
       } else {
         RnmH.AddDat(WalksVV(i,j),NNodes);
-        RnmBackH.AddDat(NNodes,WalksVV(i, j));
+        RnmBackV.Add(WalksVV(i, j));
         WalksVV(i, j) = NNodes++;
       }
     }
   }
   TIntV Vocab(NNodes);
   LearnVocab(WalksVV, Vocab);
-  TIntV KTable(NNodes);
-  TFltV UTable(NNodes);
-  TVVec<TFlt, int64> SynNeg;
-  TVVec<TFlt, int64> SynPos;
   TRnd Rnd(time(NULL));
-  InitPosEmb(Vocab, Dimensions, Rnd, SynPos);
-  InitNegEmb(Vocab, Dimensions, SynNeg);
-  InitUnigramTable(Vocab, KTable, UTable);
-  TFltV ExpTable(TableSize);
-  double Alpha = StartAlpha;                              //learning rate
-#pragma omp parallel for schedule(dynamic)
-  for (int i = 0; i < TableSize; i++ ) {
-    double Value = -MaxExp + static_cast<double>(i) / static_cast<double>(ExpTablePrecision);
-    ExpTable[i] = TMath::Power(TMath::E, Value);
-  }
-  int64 WordCntAll = 0;
+  const int64 AllWords = WalksVV.GetXDim()*WalksVV.GetYDim();
+  TSkipGram SkipGram(Vocab, Dimensions, WinSize, Iter*AllWords, Verbose, Rnd);
+  //one generator per thread, seeded from the shared one
+#ifdef USE_OPENMP
+  TVec<TRnd> RndV(omp_get_max_threads());
+#else
+  TVec<TRnd> RndV(1);
+#endif
+  for (int t = 0; t < RndV.Len(); t++) { RndV[t].PutSeed(Rnd.GetUniDevInt(1, TInt::Mx-1)); }
+  const int WalkLen = (int) WalksVV.GetYDim();
 // op RS 2016/09/26, collapse does not compile on Mac OS X
 //#pragma omp parallel for schedule(dynamic) collapse(2)
   for (int j = 0; j < Iter; j++) {
 #pragma omp parallel for schedule(dynamic)
     for (int64 i = 0; i < WalksVV.GetXDim(); i++) {
-      TrainModel(WalksVV, Dimensions, WinSize, Iter, Verbose, KTable, UTable,
-       WordCntAll, ExpTable, Alpha, i, Rnd, SynNeg, SynPos); 
+#ifdef USE_OPENMP
+      TRnd& ThreadRnd = RndV[omp_get_thread_num()];
+#else
+      TRnd& ThreadRnd = RndV[0];
+#endif
+      SkipGram.TrainWalk(&WalksVV.At(i, 0), WalkLen, ThreadRnd);
     }
   }
   if (Verbose) { printf("\n"); fflush(stdout); }
-  for (int64 i = 0; i < SynPos.GetXDim(); i++) {
-    TFltV CurrV(SynPos.GetYDim());
-    for (int j = 0; j < SynPos.GetYDim(); j++) { CurrV[j] = SynPos(i, j); }
-    EmbeddingsHV.AddDat(RnmBackH.GetDat(i), CurrV);
-  }
+  SkipGram.GetEmbeddings(RnmBackV, EmbeddingsHV);
 }
@@ -19,4 +19,61 @@ const int NegSamN = 5;
 //Learning rate for SGD. Value taken from original word2vec code.
 const double StartAlpha = 0.025;
 
+///Skip-gram model with negative sampling, trained one walk at a time
+///Words are node indices 0..Vocab.Len()-1, Vocab holds their counts in the corpus.
+///TrainWalk() can be called from the threads of a parallel region at once (Hogwild), each with its own Rnd.
+///The learning rate decays linearly over AllWords, the number of words of all training passes.
+///Embeddings are float32 matrices with rows padded and aligned to 64 bytes, so the dot products
+///and updates vectorize (build with -march=native to get AVX). Negative samples are drawn once per
+///window and shared by all its context words, which turns the updates of a window into small
+///dense matrix products on local copies of the rows. See: S. Ji, N. Satish, S. Li, P. Dubey,
+///Parallelizing Word2Vec in Shared and Distributed Memory, IEEE TPDS 2019
+class TSkipGram {
+private:
+  //scratch of one thread, reused by all TrainWalk() calls of the thread
+  class TTrainBuf {
+  public:
+    TVec<float, int64> InBufV, InGradBufV, OutBufV, OutGradBufV; //local rows, over-allocated for alignment
+    TIntV CtxV, TgtV;
+    TVec<float> GradV;
+  public:
+    TTrainBuf() : InBufV(), InGradBufV(), OutBufV(), OutGradBufV(), CtxV(), TgtV(), GradV() { }
+  };
+private:
+  int Dimensions;
+  int WinSize;
+  int RowLen;                   //floats per matrix row, Dimensions rounded up to a multiple of 16
+  TBool Verbose;
+  TIntV KTable;                 //alias table of the unigram^0.75 distribution for negatives
+  TFltV UTable;
+  TVec<float> SigmoidV;         //sigmoid on [-MaxExp, MaxExp)
+  TVec<float, int64> SynPosV;   //storage of the matrices, over-allocated for alignment
+  TVec<float, int64> SynNegV;
+  float* SynPos;                //aligned row-major Vocab.Len() x RowLen matrices
+  float* SynNeg;
+  TInt64 AllWords;
+  TInt64 WordCntAll;            //words trained so far
+  TVec<TTrainBuf> TrainBufV;    //indexed by thread number
+  UndefCopyAssign(TSkipGram);
+private:
+  int GetRndUnigram(TRnd& Rnd) const;
+public:
+  TSkipGram(const TIntV& Vocab, const int& _Dimensions, const int& _WinSize,
+    const int64& _AllWords, const bool& _Verbose, TRnd& Rnd);
+  ///Trains the model on the walk WalkI[0..WalkLen-1], the thread number must be below omp_get_max_threads() at construction
+  void TrainWalk(const TInt* WalkI, const int& WalkLen, TRnd& Rnd);
+  ///Returns the number of words trained so far
+  int64 GetWordCnt() const { return WordCntAll; }
+  ///Returns the memory used by the embedding matrices in bytes
+  int64 GetMemUsed() const { return (SynPosV.Len() + SynNegV.Len()) * int64(sizeof(float)); }
+  ///Writes the embedding of word i under the node id NIdV[i] into EmbeddingsHV
+  void GetEmbeddings(const TIntV& NIdV, TIntFltVH& EmbeddingsHV) const;
+};
+
+///Writes embeddings in the binary word2vec format: a header line with the number of
+///embeddings and dimensions, then for every node its id, a space, the float32 values and a newline
+void SaveEmbeddingsBin(const PSOut& SOut, const TIntFltVH& EmbeddingsHV);
+///Reads embeddings in the binary word2vec format written by SaveEmbeddingsBin
+void LoadEmbeddingsBin(const PSIn& SIn, TIntFltVH& EmbeddingsHV);
+
 #endif //WORD_2_VEC_H
@@ -14,6 +14,10 @@
 // graph data structures
 #include "graph.cpp"         // graphs
 #include "graphmp.cpp"       // graphs
+#include "graphslab.cpp"     // graphs with adjacency lists in a slab pool
+#include "graphconc.cpp"     // graphs for concurrent updates
+#include "graphout.cpp"      // graphs that store only out-edges
+#include "graphzip.cpp"      // read-only compressed graphs
 //#include "mmgraph.cpp"       // multimodal graphs
 #include "network.cpp"       // networks
 #include "networkmp.cpp"     // networks OMP
@@ -33,8 +37,10 @@
 #include "gsvd.cpp"          // SVD and eigenvector computations
 #include "gstat.cpp"         // graph statistics
 #include "centr.cpp"         // centrality measures
+#include "sssp.cpp"          // weighted shortest paths
 #include "cmty.cpp"          // community detection algorithms
 #include "flow.cpp"          // network flow algorithms
+#include "partition.cpp"     // graph partitioning
 #include "coreper.cpp"       // core-periphery algorithms
 #include "triad.cpp"         // clustering coefficient and triads
 #include "casc.cpp"          // cascade graph construction from events^M
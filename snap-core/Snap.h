@@ -22,6 +22,13 @@
 #include "bignet.h"          // large networks
 #include "timenet.h"         // time evolving networks
 #include "mmnet.h"           // multimodal networks
+#include "csrgraph.h"        // compressed sparse row graph snapshots
+#include "graph64.h"         // graphs with 64-bit node ids
+#include "graphslab.h"       // graphs with adjacency lists in a slab pool
+#include "graphconc.h"       // graphs for concurrent updates
+#include "graphout.h"        // graphs that store only out-edges
+#include "graphzip.h"        // read-only compressed graphs
+#include "graphview.h"       // read-only views of graphs
 
 // table data structures and algorithms
 #include "table.h"           // table
@@ -33,14 +40,17 @@
 #include "anf.h"             // approximate diameter calculation
 #include "bfsdfs.h"          // breadth and depth first search
 #include "cncom.h"           // connected components
+#include "vprog.h"           // vertex programs
 #include "kcore.h"           // k-core decomposition
 #include "alg.h"             // misc graph algorithms
 #include "triad.h"           // clustering coefficient and triads
 #include "gsvd.h"            // SVD and eigenvector computations
 #include "gstat.h"           // graph statistics
 #include "centr.h"           // centrality measures
+#include "sssp.h"            // weighted shortest paths
 #include "cmty.h"            // community detection algorithms
 #include "flow.h"            // network flow algorithms
+#include "partition.h"       // graph partitioning
 #include "coreper.h"         // core-periphery algorithms
 #include "randwalk.h"        // Personalized PageRank
 #include "casc.h"            // cascade graph construction from events^M
@@ -59,6 +59,10 @@ template <class PGraph> int CntSelfEdges(const PGraph& Graph);
 template <class PGraph> PGraph GetUnDir(const PGraph& Graph);
 /// Makes the graph undirected. For every edge <code>(u,v)</code> an edge <code>(v,u)</code> is added (if it does not yet exist).
 template <class PGraph> void MakeUnDir(const PGraph& Graph);
+/// Returns an undirected view of a directed graph, the graph is not copied.
+template <class PGraph> TPt<TSymView<PGraph> > GetSymView(const PGraph& Graph);
+/// Returns a view of a directed graph with the direction of all edges reversed, the graph is not copied.
+template <class PGraph> TPt<TTransView<PGraph> > GetTransView(const PGraph& Graph);
 /// Adds a self-edge to every node in the graph.
 template <class PGraph> void AddSelfEdges(const PGraph& Graph);
 /// Removes all the self-edges from the graph.
@@ -365,6 +369,16 @@ void MakeUnDir(const PGraph& Graph) {
   }
 }
 
+template <class PGraph>
+TPt<TSymView<PGraph> > GetSymView(const PGraph& Graph) {
+  return TSymView<PGraph>::New(Graph);
+}
+
+template <class PGraph>
+TPt<TTransView<PGraph> > GetTransView(const PGraph& Graph) {
+  return TTransView<PGraph>::New(Graph);
+}
+
 template <class PGraph>
 void AddSelfEdges(const PGraph& Graph) {
   TIntV EdgeV;
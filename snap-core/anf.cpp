@@ -59,3 +59,191 @@ double CalcAvgDiamPdf(const TFltPrV& DistNbrsPdfV) {
 } // namespace TSnapDetail
 } // namespace TSnap
 
+
+/////////////////////////////////////////////////
+// HyperLogLog based Approximate Neighborhood Function
+#if defined(GLib_UNIX)
+#include <sys/mman.h>
+#endif
+
+namespace TSnap {
+namespace TSnapDetail {
+// byte-wise maximum of two words, all bytes must be below 128
+static inline uint64 GetMxBytes(const uint64& A, const uint64& B) {
+  const uint64 HiBits = 0x8080808080808080ULL;
+  const uint64 GeMask = ((((A | HiBits) - B) & HiBits) >> 7) * 0xFFULL; // 0xFF in bytes where A >= B
+  return (A & GeMask) | (B & ~GeMask);
+}
+// 64-bit mixing function (SplitMix64 finalizer)
+static inline uint64 GetHash64(uint64 Key) {
+  Key = (Key ^ (Key >> 30)) * 0xBF58476D1CE4E5B9ULL;
+  Key = (Key ^ (Key >> 27)) * 0x94D049BB133111EBULL;
+  return Key ^ (Key >> 31);
+}
+} // namespace TSnapDetail
+} // namespace TSnap
+
+void THyperAnf::Init(const int& NApprox, const int& RndSeed) {
+  for (Log2Regs = 4; (1 << Log2Regs) < NApprox; Log2Regs++) { }
+  NRegs = 1 << Log2Regs;
+  WordsPerNd = NRegs / 8;
+  Seed = RndSeed;
+  if (Seed == 0) { TRnd Rnd(0);  Seed = Rnd.GetUniDevInt(TInt::Mx-1) + 1; }
+  RegWords = int64(Csr.GetNodes()) * int64(WordsPerNd);
+  AllocRegs();
+  EstV.Gen(Csr.GetNodes());
+}
+
+void THyperAnf::AllocRegs() {
+  FreeRegs();
+  if (RegFNm.Empty()) {
+    CurRegV.Gen(RegWords);  NextRegV.Gen(RegWords);
+    CurRegs = CurRegV.BegI();  NextRegs = NextRegV.BegI();
+    return;
+  }
+#if defined(GLib_UNIX)
+  MapBytes = 2 * RegWords * int64(sizeof(uint64));
+  const int FileId = open(RegFNm.CStr(), O_RDWR | O_CREAT | O_TRUNC, 0600);
+  EAssertR(FileId != -1, "Can not open file '"+RegFNm+"'.");
+  EAssertR(MapBytes == 0 || ftruncate(FileId, MapBytes) == 0, "Can not resize file '"+RegFNm+"'.");
+  if (MapBytes > 0) {
+    MapPt = mmap(0, MapBytes, PROT_READ | PROT_WRITE, MAP_SHARED, FileId, 0);
+    EAssertR(MapPt != MAP_FAILED, "mmap failed for '"+RegFNm+"'.");
+  }
+  close(FileId);
+  unlink(RegFNm.CStr()); // the space is released once the mapping is removed
+  CurRegs = (uint64*) MapPt;
+  NextRegs = CurRegs + RegWords;
+#else
+  FailR("Register files are only supported on UNIX");
+#endif
+}
+
+void THyperAnf::FreeRegs() {
+#if defined(GLib_UNIX)
+  if (MapPt != NULL) { munmap(MapPt, MapBytes);  MapPt = NULL;  MapBytes = 0; }
+#endif
+  CurRegV.Clr();  NextRegV.Clr();
+  CurRegs = NULL;  NextRegs = NULL;
+}
+
+void THyperAnf::InitRegs() {
+  const int Nodes = Csr.GetNodes();
+  const uint64 SeedMix = TSnap::TSnapDetail::GetHash64(uint64(Seed) * 0x9E3779B97F4A7C15ULL);
+  const int MxRank = 64 - Log2Regs + 1;
+  #pragma omp parallel for schedule(static)
+  for (int i = 0; i < Nodes; i++) {
+    uint64* Regs = CurRegs + int64(i) * WordsPerNd;
+    for (int w = 0; w < WordsPerNd; w++) { Regs[w] = 0; }
+    // register index from the low bits, rank from the trailing zeros of the rest
+    const uint64 Hash = TSnap::TSnapDetail::GetHash64(uint64(Csr.GetNId(i)) + SeedMix);
+    const int Reg = int(Hash & (NRegs - 1));
+    uint64 Rest = Hash >> Log2Regs;
+    int Rank = 1;
+    while (Rank < MxRank && (Rest & 1) == 0) { Rest >>= 1;  Rank++; }
+    ((uchar*) Regs)[Reg] = uchar(Rank);
+    memcpy(NextRegs + int64(i) * WordsPerNd, Regs, WordsPerNd * sizeof(uint64));
+    EstV[i] = GetEst(i);
+  }
+}
+
+double THyperAnf::GetEst(const int& NIdx) const {
+  const uchar* Regs = (const uchar*) (CurRegs + int64(NIdx) * WordsPerNd);
+  const int M = NRegs;
+  double Sum = 0;
+  int Zeros = 0;
+  for (int r = 0; r < M; r++) {
+    Sum += ldexp(1.0, -int(Regs[r]));
+    if (Regs[r] == 0) { Zeros++; }
+  }
+  const double Alpha = M == 16 ? 0.673 : (M == 32 ? 0.697 : (M == 64 ? 0.709 : 0.7213 / (1.0 + 1.079 / M)));
+  const double Est = Alpha * M * M / Sum;
+  // linear counting for small cardinalities
+  if (Est <= 2.5 * M && Zeros > 0) { return M * log(M / double(Zeros)); }
+  return Est;
+}
+
+void THyperAnf::DoStep(const bool& IsDir, const TIntV& ActiveV, TIntV& ChangedV) {
+  // a node takes the maximum of its own registers and those of the nodes it reaches in one hop
+  ChangedV.Gen(ActiveV.Len(), 0);
+  #pragma omp parallel for schedule(dynamic,1000)
+  for (int k = 0; k < ActiveV.Len(); k++) {
+    const int U = ActiveV[k];
+    uint64* DstRegs = NextRegs + int64(U) * WordsPerNd;
+    for (int Dir = 0; Dir < (IsDir || ! Csr.IsDirected() ? 1 : 2); Dir++) {
+      const TInt* BegN = Dir == 0 ? Csr.BegOut(U) : Csr.BegIn(U);
+      const TInt* EndN = Dir == 0 ? Csr.EndOut(U) : Csr.EndIn(U);
+      for (const TInt* N = BegN; N < EndN; N++) {
+        const uint64* SrcRegs = CurRegs + int64(N->Val) * WordsPerNd;
+        for (int w = 0; w < WordsPerNd; w++) { DstRegs[w] = TSnap::TSnapDetail::GetMxBytes(DstRegs[w], SrcRegs[w]); }
+      }
+    }
+    if (memcmp(DstRegs, CurRegs + int64(U) * WordsPerNd, WordsPerNd * sizeof(uint64)) != 0) {
+#ifdef USE_OPENMP
+      ChangedV.AddMP(U);
+#else
+      ChangedV.Add(U);
+#endif
+    }
+  }
+  // commit the changed counters, both register arrays are equal again afterwards
+  #pragma omp parallel for schedule(static)
+  for (int k = 0; k < ChangedV.Len(); k++) {
+    const int U = ChangedV[k];
+    memcpy(CurRegs + int64(U) * WordsPerNd, NextRegs + int64(U) * WordsPerNd, WordsPerNd * sizeof(uint64));
+    EstV[U] = GetEst(U);
+  }
+}
+
+void THyperAnf::GetActive(const bool& IsDir, const TIntV& ChangedV, TIntV& ActiveV, TBoolV& IsActiveV) const {
+  // a changed counter is read by the in-neighbors (all neighbors if directions are ignored)
+  ActiveV.Clr(false);
+  for (int k = 0; k < ChangedV.Len(); k++) {
+    const int U = ChangedV[k];
+    for (int Dir = 0; Dir < (IsDir || ! Csr.IsDirected() ? 1 : 2); Dir++) {
+      const TInt* BegN = Dir == 0 ? Csr.BegIn(U) : Csr.BegOut(U);
+      const TInt* EndN = Dir == 0 ? Csr.EndIn(U) : Csr.EndOut(U);
+      for (const TInt* N = BegN; N < EndN; N++) {
+        if (! IsActiveV[*N]) { IsActiveV[*N] = true;  ActiveV.Add(*N); }
+      }
+    }
+  }
+  for (int k = 0; k < ActiveV.Len(); k++) { IsActiveV[ActiveV[k]] = false; }
+}
+
+void THyperAnf::GetGraphAnf(TIntFltKdV& DistNbrsV, const int& MxDist, const bool& IsDir) {
+  const int Nodes = Csr.GetNodes();
+  InitRegs();
+  DistNbrsV.Clr();
+  DistNbrsV.Add(TIntFltKd(0, Nodes));
+  TIntV ActiveV(Nodes, 0), ChangedV;
+  TBoolV IsActiveV(Nodes);
+  for (int i = 0; i < Nodes; i++) { ActiveV.Add(i); }
+  for (int Dist = 1; Dist < (MxDist == -1 ? TInt::Mx : MxDist) && ! ActiveV.Empty(); Dist++) {
+    DoStep(IsDir, ActiveV, ChangedV);
+    if (ChangedV.Empty()) { break; }
+    double NPairs = 0;
+    #pragma omp parallel for reduction(+:NPairs) schedule(static)
+    for (int i = 0; i < Nodes; i++) { NPairs += EstV[i]; }
+    DistNbrsV.Add(TIntFltKd(Dist, NPairs));
+    GetActive(IsDir, ChangedV, ActiveV, IsActiveV);
+  }
+}
+
+void THyperAnf::GetNodeAnf(const int& SrcNId, TIntFltKdV& DistNbrsV, const int& MxDist, const bool& IsDir) {
+  const int Nodes = Csr.GetNodes();
+  const int SrcNIdx = Csr.GetNIdx(SrcNId);
+  IAssertR(SrcNIdx != -1, "Source must be a node of the graph");
+  InitRegs();
+  DistNbrsV.Clr();
+  DistNbrsV.Add(TIntFltKd(0, 1));
+  TIntV ActiveV(Nodes, 0), ChangedV;
+  TBoolV IsActiveV(Nodes);
+  for (int i = 0; i < Nodes; i++) { ActiveV.Add(i); }
+  for (int Dist = 1; Dist < (MxDist == -1 ? TInt::Mx : MxDist) && ! ActiveV.Empty(); Dist++) {
+    DoStep(IsDir, ActiveV, ChangedV);
+    if (ChangedV.Empty()) { break; }
+    DistNbrsV.Add(TIntFltKd(Dist, EstV[SrcNIdx]));
+    GetActive(IsDir, ChangedV, ActiveV, IsActiveV);
+  }
+}
@@ -15,11 +15,18 @@ template <class PGraph> void GetAnf(const PGraph& Graph, const int& SrcNId, TInt
 /// @param IsDir false: consider links as undirected (drop link directions).
 /// @param NApprox Quality of approximation. See the ANF paper.
 template <class PGraph> void GetAnf(const PGraph& Graph, TIntFltKdV& DistNbrsV, const int& MxDist, const bool& IsDir, const int& NApprox=32);
-/// Returns a given Percentile of the shortest path length distribution of a Graph (based on a single run of ANF of approximation quality NApprox).
+/// Approximate Neighborhood Function of a Graph computed with HyperLogLog counters (see THyperAnf).
+/// DistNbrsV has the same meaning as in GetAnf(). NApprox is the number of registers per node.
+template <class PGraph> void GetHyperAnf(const PGraph& Graph, TIntFltKdV& DistNbrsV, const int& MxDist, const bool& IsDir, const int& NApprox=64);
+/// Approximate Neighborhood Function of a node computed with HyperLogLog counters (see THyperAnf).
+template <class PGraph> void GetHyperAnf(const PGraph& Graph, const int& SrcNId, TIntFltKdV& DistNbrsV, const int& MxDist, const bool& IsDir, const int& NApprox=64);
+/// Returns a given Percentile of the shortest path length distribution of a Graph (based on a single run of HyperANF with NApprox registers per node).
 /// @param IsDir false: consider links as undirected (drop link directions).
+/// @param NApprox Number of HyperLogLog registers per node, rounded up to a power of 2 (at least 16). Before HyperANF was used, NApprox was the number of Flajolet-Martin bit-string copies of GetAnf().
 template <class PGraph> double GetAnfEffDiam(const PGraph& Graph, const bool& IsDir, const double& Percentile, const int& NApprox);
-/// Returns a 90-th percentile of the shortest path length distribution of a Graph (based on a NRuns runs of ANF of approximation quality NApprox).
+/// Returns a 90-th percentile of the shortest path length distribution of a Graph (based on a NRuns runs of HyperANF with NApprox registers per node).
 /// @param IsDir false: consider links as undirected (drop link directions).
+/// @param NApprox Number of HyperLogLog registers per node as in the function above, -1: 64, 32 or 16 depending on the size of the graph.
 template <class PGraph> double GetAnfEffDiam(const PGraph& Graph, const int NRuns=1, int NApprox=-1);
 } // namespace TSnap
 
@@ -181,6 +188,55 @@ void TGraphAnf<PGraph>::GetGraphAnf(TIntFltKdV& DistNbrsV, const int& MxDist, co
     //TGnuPlot::SaveTs(DistNbrsV, "hops.tab", "HOPS, REACHABLE PAIRS");
   }
 }
+/////////////////////////////////////////////////
+/// HyperLogLog based Approximate Neighborhood Function.
+/// Every node keeps a HyperLogLog counter of the nodes within distance H, stored
+/// as NRegs byte registers in one packed array. Counters of neighbors are merged
+/// by a register-wise maximum that works on 8 registers per 64-bit word. Only
+/// nodes with a neighbor whose counter changed in the previous step are
+/// recomputed, in parallel. The two register arrays can be kept in a scratch
+/// file mapped into memory instead of the heap (RegFNm), so graphs whose
+/// counters do not fit into RAM can be processed.
+/// See P. Boldi, M. Rosa, S. Vigna, HyperANF: Approximating the Neighbourhood Function of Very Large Graphs on a Budget, WWW 2011.
+class THyperAnf {
+private:
+  TCsrGraph Csr;
+  TInt Log2Regs, NRegs, WordsPerNd; // NRegs=2^Log2Regs registers per node, NRegs/8 64-bit words
+  TInt Seed;
+  TStr RegFNm;                      // scratch file for the registers, empty: keep them on the heap
+  int64 RegWords;                   // words in one register array
+  uint64* CurRegs;                  // registers after the last step
+  uint64* NextRegs;                 // registers written by the running step
+  TVec<uint64, int64> CurRegV, NextRegV;
+  TFltV EstV;                       // current estimate of every node
+  void* MapPt;
+  int64 MapBytes;
+private:
+  UndefDefaultCopyAssign(THyperAnf);
+  void Init(const int& NApprox, const int& RndSeed);
+  void AllocRegs();
+  void FreeRegs();
+  void InitRegs();
+  double GetEst(const int& NIdx) const;
+  /// One step of the iteration, recomputes the nodes in ActiveV. Returns the nodes whose counter changed in ChangedV.
+  void DoStep(const bool& IsDir, const TIntV& ActiveV, TIntV& ChangedV);
+  /// Marks the nodes that gather from the nodes in ChangedV.
+  void GetActive(const bool& IsDir, const TIntV& ChangedV, TIntV& ActiveV, TBoolV& IsActiveV) const;
+public:
+  /// @param NApprox Number of HyperLogLog registers per node, rounded up to a power of 2 (at least 16). The relative error of the counts is about 1.04/sqrt(NApprox).
+  /// @param RndSeed Seed of the hash functions, 0: random seed.
+  /// @param RegFNm If not empty, the register arrays are stored in this (temporary) file instead of main memory.
+  template <class PGraph> THyperAnf(const PGraph& Graph, const int& NApprox=64, const int& RndSeed=0, const TStr& _RegFNm=TStr()) :
+    Csr(Graph), RegFNm(_RegFNm), RegWords(0), CurRegs(NULL), NextRegs(NULL), MapPt(NULL), MapBytes(0) { Init(NApprox, RndSeed); }
+  ~THyperAnf() { FreeRegs(); }
+  int GetRegs() const { return NRegs; }
+  /// Returns the number of pairs of nodes reachable in at most H hops, see TGraphAnf::GetGraphAnf().
+  /// Stops when no counter changes any more or after MxDist hops (-1: no limit).
+  void GetGraphAnf(TIntFltKdV& DistNbrsV, const int& MxDist, const bool& IsDir);
+  /// Returns the number of nodes reachable from SrcNId in at most H hops.
+  void GetNodeAnf(const int& SrcNId, TIntFltKdV& DistNbrsV, const int& MxDist, const bool& IsDir);
+};
+
 /////////////////////////////////////////////////
 // Approximate Neighborhood Function
 namespace TSnap {
@@ -212,10 +268,22 @@ void GetAnf(const PGraph& Graph, TIntFltKdV& DistNbrsV, const int& MxDist, const
   Anf.GetGraphAnf(DistNbrsV, MxDist, IsDir);
 }
 
+template <class PGraph>
+void GetHyperAnf(const PGraph& Graph, TIntFltKdV& DistNbrsV, const int& MxDist, const bool& IsDir, const int& NApprox) {
+  THyperAnf Anf(Graph, NApprox, 0);
+  Anf.GetGraphAnf(DistNbrsV, MxDist, IsDir);
+}
+
+template <class PGraph>
+void GetHyperAnf(const PGraph& Graph, const int& SrcNId, TIntFltKdV& DistNbrsV, const int& MxDist, const bool& IsDir, const int& NApprox) {
+  THyperAnf Anf(Graph, NApprox, 0);
+  Anf.GetNodeAnf(SrcNId, DistNbrsV, MxDist, IsDir);
+}
+
 template <class PGraph>
 double GetAnfEffDiam(const PGraph& Graph, const bool& IsDir, const double& Percentile, const int& NApprox) {
   TIntFltKdV DistNbrsV;
-  TGraphAnf<PGraph> Anf(Graph, NApprox, 5, 0);
+  THyperAnf Anf(Graph, NApprox, 0);
   Anf.GetGraphAnf(DistNbrsV, -1, IsDir);
   return TSnap::TSnapDetail::CalcEffDiam(DistNbrsV, Percentile);
 }
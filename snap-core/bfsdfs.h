@@ -5,18 +5,18 @@ namespace TSnap {
 /// Returns a directed Breadth-First-Search tree rooted at StartNId. ##GetBfsTree1
 template <class PGraph> PNGraph GetBfsTree(const PGraph& Graph, const int& StartNId, const bool& FollowOut, const bool& FollowIn);
 /// Returns the BFS tree size (number of nodes) and depth (number of levels) by following in-links (parameter FollowIn = true) and/or out-links (parameter FollowOut = true) of node StartNId.
-template <class PGraph> int GetSubTreeSz(const PGraph& Graph, const int& StartNId, const bool& FollowOut, const bool& FollowIn, int& TreeSzX, int& TreeDepthX);
+template <class PGraph> int GetSubTreeSz(const PGraph& Graph, const typename TNIdType<typename PGraph::TObj>::TNId& StartNId, const bool& FollowOut, const bool& FollowIn, int& TreeSzX, int& TreeDepthX);
 /// Finds IDs of all nodes that are at distance Hop from node StartNId. ##GetSubTreeSz
-template <class PGraph> int GetNodesAtHop(const PGraph& Graph, const int& StartNId, const int& Hop, TIntV& NIdV, const bool& IsDir=false);
+template <class PGraph> int GetNodesAtHop(const PGraph& Graph, const typename TNIdType<typename PGraph::TObj>::TNId& StartNId, const int& Hop, TVec<typename TNIdType<typename PGraph::TObj>::TNIdT>& NIdV, const bool& IsDir=false);
 /// Returns the number of nodes at each hop distance from the starting node StartNId. ##GetNodesAtHops
-template <class PGraph> int GetNodesAtHops(const PGraph& Graph, const int& StartNId, TIntPrV& HopCntV, const bool& IsDir=false);
+template <class PGraph> int GetNodesAtHops(const PGraph& Graph, const typename TNIdType<typename PGraph::TObj>::TNId& StartNId, TIntPrV& HopCntV, const bool& IsDir=false);
 
 /////////////////////////////////////////////////
 // Shortest paths
 /// Returns the length of the shortest path from node SrcNId to node DstNId. ##GetShortPath1
-template <class PGraph> int GetShortPath(const PGraph& Graph, const int& SrcNId, const int& DstNId, const bool& IsDir=false);
+template <class PGraph> int GetShortPath(const PGraph& Graph, const typename TNIdType<typename PGraph::TObj>::TNId& SrcNId, const typename TNIdType<typename PGraph::TObj>::TNId& DstNId, const bool& IsDir=false);
 /// Returns the length of the shortest path from node SrcNId to all other nodes in the network. ##GetShortPath2
-template <class PGraph> int GetShortPath(const PGraph& Graph, const int& SrcNId, TIntH& NIdToDistH, const bool& IsDir=false, const int& MaxDist=TInt::Mx);
+template <class PGraph> int GetShortPath(const PGraph& Graph, const typename TNIdType<typename PGraph::TObj>::TNId& SrcNId, THash<typename TNIdType<typename PGraph::TObj>::TNIdT, TInt>& NIdToDistH, const bool& IsDir=false, const int& MaxDist=TInt::Mx);
 
 /////////////////////////////////////////////////
 // Diameter
@@ -32,7 +32,7 @@ template <class PGraph> double GetBfsEffDiam(const PGraph& Graph, const int& NTe
 /// Returns the (approximation of the) Effective Diameter, the Diameter and the Average Shortest Path length in a graph (by performing BFS from NTestNodes random starting nodes). ##GetBfsEffDiamAll
 template <class PGraph> double GetBfsEffDiamAll(const PGraph& Graph, const int& NTestNodes, const bool& IsDir, double& EffDiamX, int& FullDiamX, double& AvgSPLX);
 /// Use the whole graph (all edges) to measure the shortest path lengths but only report the path lengths between nodes in the SubGraphNIdV. ##GetBfsEffDiam4
-template <class PGraph> double GetBfsEffDiam(const PGraph& Graph, const int& NTestNodes, const TIntV& SubGraphNIdV, const bool& IsDir, double& EffDiamX, int& FullDiamX);
+template <class PGraph> double GetBfsEffDiam(const PGraph& Graph, const int& NTestNodes, const TVec<typename TNIdType<typename PGraph::TObj>::TNIdT>& SubGraphNIdV, const bool& IsDir, double& EffDiamX, int& FullDiamX);
 
 // TODO: Implement in the future
 //template <class PGraph> int GetRangeDist(const PGraph& Graph, const int& SrcNId, const int& DstNId, const bool& IsDir=false);
@@ -55,30 +55,33 @@ template <class PGraph> double GetBfsEffDiam(const PGraph& Graph, const int& NTe
 /// The class is meant for executing many BFSs over a fixed graph. This means that the class can keep the hash tables and queues initialized between different calls of the DoBfs() function.
 template<class PGraph>
 class TBreathFS {
+public:
+  typedef typename TSnap::TNIdType<typename PGraph::TObj>::TNId TNId;
+  typedef typename TSnap::TNIdType<typename PGraph::TObj>::TNIdT TNIdT;
 public:
   PGraph Graph;
-  TSnapQueue<int> Queue;
-  TInt StartNId;
-  TIntH NIdDistH;
+  TSnapQueue<TNId> Queue;
+  TNIdT StartNId;
+  THash<TNIdT, TInt> NIdDistH;
 public:
   TBreathFS(const PGraph& GraphPt, const bool& InitBigQ=true) :
     Graph(GraphPt), Queue(InitBigQ?Graph->GetNodes():1024), NIdDistH(InitBigQ?Graph->GetNodes():1024) { }
   /// Sets the graph to be used by the BFS to GraphPt and resets the data structures.
   void SetGraph(const PGraph& GraphPt);
   /// Performs BFS from node id StartNode for at maps MxDist steps by only following in-links (parameter FollowIn = true) and/or out-links (parameter FollowOut = true).
-  int DoBfs(const int& StartNode, const bool& FollowOut, const bool& FollowIn, const int& TargetNId=-1, const int& MxDist=TInt::Mx);
-  /// Same functionality as DoBfs with better performance.
+  int DoBfs(const TNId& StartNode, const bool& FollowOut, const bool& FollowIn, const TNId& TargetNId=-1, const int& MxDist=TInt::Mx);
+  /// Same functionality as DoBfs with better performance. Only for graphs with int node ids.
   int DoBfsHybrid(const int& StartNode, const bool& FollowOut, const bool& FollowIn, const int& TargetNId=-1, const int& MxDist=TInt::Mx);
   /// Returns the number of nodes visited/reached by the BFS.
   int GetNVisited() const { return NIdDistH.Len(); }
   /// Returns the IDs of the nodes visited/reached by the BFS.
-  void GetVisitedNIdV(TIntV& NIdV) const { NIdDistH.GetKeyV(NIdV); }
+  void GetVisitedNIdV(TVec<TNIdT>& NIdV) const { NIdDistH.GetKeyV(NIdV); }
   /// Returns the shortst path distance between SrcNId and DistNId.
   /// Note you have to first call DoBFs(). SrcNId must be equal to StartNode, otherwise return value is -1.
-  int GetHops(const int& SrcNId, const int& DstNId) const;
+  int GetHops(const TNId& SrcNId, const TNId& DstNId) const;
   /// Returns a random shortest path from SrcNId to DstNId.
   /// Note you have to first call DoBFs(). SrcNId must be equal to StartNode, otherwise return value is -1.
-  int GetRndPath(const int& SrcNId, const int& DstNId, TIntV& PathNIdV) const;
+  int GetRndPath(const TNId& SrcNId, const TNId& DstNId, TVec<TNIdT>& PathNIdV) const;
 
 /* Private variables and functions for DoBfsHybrid */
 private:
@@ -99,7 +102,7 @@ void TBreathFS<PGraph>::SetGraph(const PGraph& GraphPt) {
 }
 
 template<class PGraph>
-int TBreathFS<PGraph>::DoBfs(const int& StartNode, const bool& FollowOut, const bool& FollowIn, const int& TargetNId, const int& MxDist) {
+int TBreathFS<PGraph>::DoBfs(const TNId& StartNode, const bool& FollowOut, const bool& FollowIn, const TNId& TargetNId, const int& MxDist) {
   StartNId = StartNode;
   IAssert(Graph->IsNode(StartNId));
 //  const typename PGraph::TObj::TNodeI StartNodeI = Graph->GetNI(StartNode);
@@ -108,13 +111,13 @@ int TBreathFS<PGraph>::DoBfs(const int& StartNode, const bool& FollowOut, const
   Queue.Clr(false);  Queue.Push(StartNId);
   int v, MaxDist = 0;
   while (! Queue.Empty()) {
-    const int NId = Queue.Top();  Queue.Pop();
+    const TNId NId = Queue.Top();  Queue.Pop();
     const int Dist = NIdDistH.GetDat(NId);
     if (Dist == MxDist) { break; } // max distance limit reached
     const typename PGraph::TObj::TNodeI NodeI = Graph->GetNI(NId);
     if (FollowOut) { // out-links
       for (v = 0; v < NodeI.GetOutDeg(); v++) {  // out-links
-        const int DstNId = NodeI.GetOutNId(v);
+        const TNId DstNId = NodeI.GetOutNId(v);
         if (! NIdDistH.IsKey(DstNId)) {
           NIdDistH.AddDat(DstNId, Dist+1);
           MaxDist = TMath::Mx(MaxDist, Dist+1);
@@ -125,7 +128,7 @@ int TBreathFS<PGraph>::DoBfs(const int& StartNode, const bool& FollowOut, const
     }
     if (FollowIn) { // in-links
       for (v = 0; v < NodeI.GetInDeg(); v++) {
-        const int DstNId = NodeI.GetInNId(v);
+        const TNId DstNId = NodeI.GetInNId(v);
         if (! NIdDistH.IsKey(DstNId)) {
           NIdDistH.AddDat(DstNId, Dist+1);
           MaxDist = TMath::Mx(MaxDist, Dist+1);
@@ -265,7 +268,7 @@ bool TBreathFS<PGraph>::BottomUpStep(TIntV &NIdDistV, TIntV *Frontier, TIntV *Ne
 }
 
 template<class PGraph>
-int TBreathFS<PGraph>::GetHops(const int& SrcNId, const int& DstNId) const {
+int TBreathFS<PGraph>::GetHops(const TNId& SrcNId, const TNId& DstNId) const {
   TInt Dist;
   if (SrcNId!=StartNId) { return -1; }
   if (! NIdDistH.IsKeyGetDat(DstNId, Dist)) { return -1; }
@@ -273,19 +276,19 @@ int TBreathFS<PGraph>::GetHops(const int& SrcNId, const int& DstNId) const {
 }
 
 template<class PGraph>
-int TBreathFS<PGraph>::GetRndPath(const int& SrcNId, const int& DstNId, TIntV& PathNIdV) const {
+int TBreathFS<PGraph>::GetRndPath(const TNId& SrcNId, const TNId& DstNId, TVec<TNIdT>& PathNIdV) const {
   PathNIdV.Clr(false);
   if (SrcNId!=StartNId || ! NIdDistH.IsKey(DstNId)) { return -1; }
   PathNIdV.Add(DstNId);
-  TIntV CloserNIdV;
-  int CurNId = DstNId;
+  TVec<TNIdT> CloserNIdV;
+  TNId CurNId = DstNId;
   TInt CurDist, NextDist;
   while (CurNId != SrcNId) {
     typename PGraph::TObj::TNodeI NI = Graph->GetNI(CurNId);
     IAssert(NIdDistH.IsKeyGetDat(CurNId, CurDist));
     CloserNIdV.Clr(false);
     for (int e = 0; e < NI.GetDeg(); e++) {
-      const int Next = NI.GetNbrNId(e);
+      const TNId Next = NI.GetNbrNId(e);
       if (NIdDistH.IsKeyGetDat(Next, NextDist)) {
         if (NextDist == CurDist-1) { CloserNIdV.Add(Next); }
       }
@@ -334,7 +337,7 @@ PNGraph GetBfsTree(const PGraph& Graph, const int& StartNId, const bool& FollowO
 }
 
 template <class PGraph>
-int GetSubTreeSz(const PGraph& Graph, const int& StartNId, const bool& FollowOut, const bool& FollowIn, int& TreeSz, int& TreeDepth) {
+int GetSubTreeSz(const PGraph& Graph, const typename TNIdType<typename PGraph::TObj>::TNId& StartNId, const bool& FollowOut, const bool& FollowIn, int& TreeSz, int& TreeDepth) {
   TBreathFS<PGraph> BFS(Graph);
   BFS.DoBfs(StartNId, FollowOut, FollowIn, -1, TInt::Mx);
   TreeSz = BFS.NIdDistH.Len();
@@ -346,7 +349,7 @@ int GetSubTreeSz(const PGraph& Graph, const int& StartNId, const bool& FollowOut
 }
 
 template <class PGraph>
-int GetNodesAtHop(const PGraph& Graph, const int& StartNId, const int& Hop, TIntV& NIdV, const bool& IsDir) {
+int GetNodesAtHop(const PGraph& Graph, const typename TNIdType<typename PGraph::TObj>::TNId& StartNId, const int& Hop, TVec<typename TNIdType<typename PGraph::TObj>::TNIdT>& NIdV, const bool& IsDir) {
   TBreathFS<PGraph> BFS(Graph);
   BFS.DoBfs(StartNId, true, !IsDir, -1, Hop);
   NIdV.Clr(false);
@@ -358,7 +361,7 @@ int GetNodesAtHop(const PGraph& Graph, const int& StartNId, const int& Hop, TInt
 }
 
 template <class PGraph>
-int GetNodesAtHops(const PGraph& Graph, const int& StartNId, TIntPrV& HopCntV, const bool& IsDir) {
+int GetNodesAtHops(const PGraph& Graph, const typename TNIdType<typename PGraph::TObj>::TNId& StartNId, TIntPrV& HopCntV, const bool& IsDir) {
   TBreathFS<PGraph> BFS(Graph);
   BFS.DoBfs(StartNId, true, !IsDir, -1, TInt::Mx);
   TIntH HopCntH;
@@ -371,7 +374,7 @@ int GetNodesAtHops(const PGraph& Graph, const int& StartNId, TIntPrV& HopCntV, c
 }
 
 template <class PGraph>
-int GetShortPath(const PGraph& Graph, const int& SrcNId, TIntH& NIdToDistH, const bool& IsDir, const int& MaxDist) {
+int GetShortPath(const PGraph& Graph, const typename TNIdType<typename PGraph::TObj>::TNId& SrcNId, THash<typename TNIdType<typename PGraph::TObj>::TNIdT, TInt>& NIdToDistH, const bool& IsDir, const int& MaxDist) {
   TBreathFS<PGraph> BFS(Graph);
   BFS.DoBfs(SrcNId, true, ! IsDir, -1, MaxDist);
   NIdToDistH.Clr();
@@ -380,7 +383,7 @@ int GetShortPath(const PGraph& Graph, const int& SrcNId, TIntH& NIdToDistH, cons
 }
 
 template <class PGraph>
-int GetShortPath(const PGraph& Graph, const int& SrcNId, const int& DstNId, const bool& IsDir) {
+int GetShortPath(const PGraph& Graph, const typename TNIdType<typename PGraph::TObj>::TNId& SrcNId, const typename TNIdType<typename PGraph::TObj>::TNId& DstNId, const bool& IsDir) {
   TBreathFS<PGraph> BFS(Graph);
   BFS.DoBfs(SrcNId, true, ! IsDir, DstNId, TInt::Mx);
   return BFS.GetHops(SrcNId, DstNId);
@@ -415,10 +418,10 @@ double GetBfsEffDiam(const PGraph& Graph, const int& NTestNodes, const bool& IsD
   TIntFltH DistToCntH;
   TBreathFS<PGraph> BFS(Graph);
   // shotest paths
-  TIntV NodeIdV;
+  TVec<typename TBreathFS<PGraph>::TNIdT> NodeIdV;
   Graph->GetNIdV(NodeIdV);  NodeIdV.Shuffle(TInt::Rnd);
   for (int tries = 0; tries < TMath::Mn(NTestNodes, Graph->GetNodes()); tries++) {
-    const int NId = NodeIdV[tries];
+    const typename TBreathFS<PGraph>::TNId NId = NodeIdV[tries];
     BFS.DoBfs(NId, true, ! IsDir, -1, TInt::Mx);
     for (int i = 0; i < BFS.NIdDistH.Len(); i++) {
       DistToCntH.AddDat(BFS.NIdDistH[i]) += 1; }
@@ -443,17 +446,17 @@ double GetBfsEffDiamAll(const PGraph& Graph, const int& NTestNodes, const bool&
 }
 
 template <class PGraph>
-double GetBfsEffDiam(const PGraph& Graph, const int& NTestNodes, const TIntV& SubGraphNIdV, const bool& IsDir, double& EffDiam, int& FullDiam) {
+double GetBfsEffDiam(const PGraph& Graph, const int& NTestNodes, const TVec<typename TNIdType<typename PGraph::TObj>::TNIdT>& SubGraphNIdV, const bool& IsDir, double& EffDiam, int& FullDiam) {
   EffDiam = -1;
   FullDiam = -1;
 
   TIntFltH DistToCntH;
   TBreathFS<PGraph> BFS(Graph);
   // shotest paths
-  TIntV NodeIdV(SubGraphNIdV);  NodeIdV.Shuffle(TInt::Rnd);
+  TVec<typename TBreathFS<PGraph>::TNIdT> NodeIdV(SubGraphNIdV);  NodeIdV.Shuffle(TInt::Rnd);
   TInt Dist;
   for (int tries = 0; tries < TMath::Mn(NTestNodes, SubGraphNIdV.Len()); tries++) {
-    const int NId = NodeIdV[tries];
+    const typename TBreathFS<PGraph>::TNId NId = NodeIdV[tries];
     BFS.DoBfs(NId, true, ! IsDir, -1, TInt::Mx);
     for (int i = 0; i < SubGraphNIdV.Len(); i++) {
       if (BFS.NIdDistH.IsKeyGetDat(SubGraphNIdV[i], Dist)) {
@@ -396,7 +396,8 @@ TIntH MaxCPGreedyBetter3(const PUNGraph& Graph, const int k) {
 int GetWeightedPageRank(const PNEANet Graph, TIntFltH& PRankH, const TStr& Attr, const double& C, const double& Eps, const int& MaxIter) {
   if (!Graph->IsFltAttrE(Attr)) return -1;
 
-  TFltV Weights = Graph->GetFltAttrVecE(Attr);
+  const TNEANet::TFltAttrCol WeightCol = Graph->GetFltAttrColE(Attr);
+  const TFltV& Weights = WeightCol.GetColV();
 
   int mxid = Graph->GetMxNId();
   TFltV OutWeights(mxid);
@@ -417,8 +418,7 @@ int GetWeightedPageRank(const PNEANet Graph, TIntFltH& PRankH, const TStr& Attr,
       for (int e = 0; e < NI.GetInDeg(); e++) {
         const int InNId = NI.GetInNId(e);
         const TFlt OutWeight = OutWeights[InNId];
-        int EId = Graph->GetEId(InNId, NI.GetId());
-        const TFlt Weight = Weights[Graph->GetFltKeyIdE(EId)];
+        const TFlt Weight = WeightCol.GetDat(NI.GetInEId(e));
         if (OutWeight > 0) {
           TmpV[j] += PRankH.GetDat(InNId) * Weight / OutWeight; }
       }
@@ -461,13 +461,16 @@ int GetWeightedPageRankMP(const PNEANet Graph, TIntFltH& PRankH, const TStr& Att
   TFltV PRankV(MxId+1);
   TFltV OutWeights(MxId+1);
 
-  TFltV Weights = Graph->GetFltAttrVecE(Attr);
+  const TNEANet::TFltAttrCol WeightCol = Graph->GetFltAttrColE(Attr);
 
   #pragma omp parallel for schedule(dynamic,10000)
   for (int j = 0; j < NNodes; j++) {
     TNEANet::TNodeI NI = NV[j];
     int Id = NI.GetId();
-    OutWeights[Id] = Graph->GetWeightOutEdges(NI, Attr);
+    OutWeights[Id] = 0;
+    for (int e = 0; e < NI.GetOutDeg(); e++) {
+      OutWeights[Id] += WeightCol.GetDat(NI.GetOutEId(e));
+    }
     PRankV[Id] = 1/NNodes;
   }
 
@@ -483,8 +486,7 @@ int GetWeightedPageRankMP(const PNEANet Graph, TIntFltH& PRankH, const TStr& Att
 
         const TFlt OutWeight = OutWeights[InNId];
 
-        int EId = Graph->GetEId(InNId, NI.GetId());
-        const TFlt Weight = Weights[Graph->GetFltKeyIdE(EId)];
+        const TFlt Weight = WeightCol.GetDat(NI.GetInEId(e));
 
         if (OutWeight > 0) {
           Tmp += PRankH.GetDat(InNId) * Weight / OutWeight;
@@ -682,52 +684,41 @@ TIntH LoadNodeList(TStr InFNmNodes){
 }
 
 
-int findMinimum(TIntV& Frontier, TIntFltH& NIdDistH) {
-  TFlt minimum = TInt::Mx;
-  int min_index = 0;
-  for (int i = 0; i < Frontier.Len(); i++) {
-    int NId = Frontier.GetVal(i);
-    if (NIdDistH.GetDat(NId) < minimum) {
-      minimum = NIdDistH.GetDat(NId);
-      min_index = i;
-    }
-  }
-  const int NId = Frontier.GetVal(min_index);
-  Frontier.Del(min_index);
-  return NId;
-}
-
 int GetWeightedShortestPath(
 const PNEANet Graph, const int& SrcNId, TIntFltH& NIdDistH, const TFltV& Attr) {
-  TIntV frontier;
-
-  NIdDistH.Clr(false); NIdDistH.AddDat(SrcNId, 0);
-  frontier.Add(SrcNId);
-  while (! frontier.Empty()) {
-    const int NId = findMinimum(frontier, NIdDistH);
-    const PNEANet::TObj::TNodeI NodeI = Graph->GetNI(NId);
-    for (int v = 0; v < NodeI.GetOutDeg(); v++) {
-      int DstNId = NodeI.GetOutNId(v);
-      int EId = NodeI.GetOutEId(v);
-
-      if (! NIdDistH.IsKey(DstNId)) {
-        NIdDistH.AddDat(DstNId, NIdDistH.GetDat(NId) + Attr[EId]);
-        frontier.Add(DstNId);
-      } else {
-        if (NIdDistH.GetDat(DstNId) > NIdDistH.GetDat(NId) + Attr[EId]) {
-          NIdDistH.GetDat(DstNId) = NIdDistH.GetDat(NId) + Attr[EId]; 
-        }
-      }
-    }
-  }
+  TWgtShortPath ShortPath(Graph, Attr);
+  ShortPath.GetDijkstra(SrcNId);
+  ShortPath.GetNIdDistH(NIdDistH);
   return 0;
 }
 
+int GetWeightedShortestPath(const PNEANet Graph, const int& SrcNId, TIntFltH& NIdDistH, const TStr& Attr) {
+  TWgtShortPath ShortPath(Graph, Attr);
+  ShortPath.GetDijkstra(SrcNId);
+  ShortPath.GetNIdDistH(NIdDistH);
+  return 0;
+}
+
+#ifdef USE_OPENMP
+int GetWeightedShortestPathMP(const PNEANet Graph, const int& SrcNId, TIntFltH& NIdDistH, const TFltV& Attr, const double& Delta) {
+  TWgtShortPath ShortPath(Graph, Attr);
+  ShortPath.GetDeltaStepping(SrcNId, Delta);
+  ShortPath.GetNIdDistH(NIdDistH);
+  return 0;
+}
+#endif // USE_OPENMP
+
 double GetWeightedFarnessCentr(const PNEANet Graph, const int& NId, const TFltV& Attr, const bool& Normalized, const bool& IsDir) {
-  TIntFltH NDistH(Graph->GetNodes());
-  
-  GetWeightedShortestPath(Graph, NId, NDistH, Attr);
-  
+  TWgtShortPath ShortPath(Graph, Attr);
+  return GetWeightedFarnessCentr(ShortPath, NId, Normalized);
+}
+
+double GetWeightedFarnessCentr(TWgtShortPath& ShortPath, const int& NId, const bool& Normalized) {
+  TIntFltH NDistH(ShortPath.GetCsr().GetNodes());
+
+  ShortPath.GetDijkstra(NId);
+  ShortPath.GetNIdDistH(NDistH);
+
   double sum = 0;
   for (TIntFltH::TIter I = NDistH.BegI(); I < NDistH.EndI(); I++) {
     sum += I->Dat();
@@ -735,7 +726,7 @@ double GetWeightedFarnessCentr(const PNEANet Graph, const int& NId, const TFltV&
   if (NDistH.Len() > 1) { 
     double centr = sum/double(NDistH.Len()-1); 
     if (Normalized) {
-      centr *= (Graph->GetNodes() - 1)/double(NDistH.Len()-1);
+      centr *= (ShortPath.GetCsr().GetNodes() - 1)/double(NDistH.Len()-1);
     }
     return centr;
   }
@@ -749,6 +740,12 @@ double GetWeightedClosenessCentr(const PNEANet Graph, const int& NId, const TFlt
   return 0.0;
 }
 
+double GetWeightedClosenessCentr(TWgtShortPath& ShortPath, const int& NId, const bool& Normalized) {
+  const double Farness = GetWeightedFarnessCentr(ShortPath, NId, Normalized);
+  if (Farness != 0.0) { return 1.0/Farness; }
+  else { return 0.0; }
+}
+
 void GetWeightedBetweennessCentr(const PNEANet Graph, const TIntV& BtwNIdV, TIntFltH& NodeBtwH, const bool& DoNodeCent, TIntPrFltH& EdgeBtwH, const bool& DoEdgeCent, const TFltV& Attr, const bool& IsDir) {
   if (DoNodeCent) { NodeBtwH.Clr(); }
   if (DoEdgeCent) { EdgeBtwH.Clr(); }
@@ -1,3 +1,5 @@
+class TWgtShortPath;
+
 namespace TSnap {
 
 /////////////////////////////////////////////////
@@ -36,24 +38,28 @@ int Intersect1(TUNGraph::TNodeI Node, TStr NNodes);
 TIntH LoadNodeList(TStr InFNmNodes);
 /// Returns Farness centrality of a given node NId.
 /// Farness centrality of a node is the average shortest path length to all other nodes that reside is the same connected component as the given node.
-template <class PGraph> double GetFarnessCentr(const PGraph& Graph, const int& NId, const bool& Normalized=true, const bool& IsDir=false);
+template <class PGraph> double GetFarnessCentr(const PGraph& Graph, const typename TNIdType<typename PGraph::TObj>::TNId& NId, const bool& Normalized=true, const bool& IsDir=false);
 
 template <class PGraph> double GetFarnessCentrMP(const PGraph& Graph, const int& NId, const bool& Normalized=true, const bool& IsDir=false);
 
 /// Returns weighted Farness centrality of a given node \c NId.
 /// Farness centrality of a node is the average shortest path length to all other nodes that reside is the same connected component as the given node.
 double GetWeightedFarnessCentr(const PNEANet Graph, const int& NId, const TFltV& Attr, const bool& Normalized=true, const bool& IsDir=false);
+/// Returns weighted Farness centrality of a given node \c NId, the flattened network of \c ShortPath is reused by calls for many nodes.
+double GetWeightedFarnessCentr(TWgtShortPath& ShortPath, const int& NId, const bool& Normalized=true);
 
 /// Returns Closeness centrality of a given node NId.
 /// Closeness centrality of a node is defined as 1/FarnessCentrality.
-template <class PGraph> double GetClosenessCentr(const PGraph& Graph, const int& NId, const bool& Normalized=true, const bool& IsDir=false);
+template <class PGraph> double GetClosenessCentr(const PGraph& Graph, const typename TNIdType<typename PGraph::TObj>::TNId& NId, const bool& Normalized=true, const bool& IsDir=false);
 template <class PGraph> double GetClosenessCentrMP(const PGraph& Graph, const int& NId, const bool& Normalized=true, const bool& IsDir=false);
 /// Returns Closeness centrality of a given node \c NId. 
 /// Closeness centrality of a node is defined as 1/FarnessCentrality.
 double GetWeightedClosenessCentr(const PNEANet Graph, const int& NId, const TFltV& Attr, const bool& Normalized=true, const bool& IsDir=false);
+/// Returns weighted Closeness centrality of a given node \c NId, the flattened network of \c ShortPath is reused by calls for many nodes.
+double GetWeightedClosenessCentr(TWgtShortPath& ShortPath, const int& NId, const bool& Normalized=true);
 /// Returns node Eccentricity, the largest shortest-path distance from the node NId to any other node in the Graph.
 /// @param IsDir false: ignore edge directions and consider edges as undirected (in case they are directed).
-template <class PGraph> int GetNodeEcc(const PGraph& Graph, const int& NId, const bool& IsDir=false);
+template <class PGraph> int GetNodeEcc(const PGraph& Graph, const typename TNIdType<typename PGraph::TObj>::TNId& NId, const bool& IsDir=false);
 
 /// Computes (approximate) Node Beetweenness Centrality based on a sample of NodeFrac nodes.
 /// @param NIdBtwH hash table mapping node ids to their corresponding betweenness centrality values.
@@ -95,8 +101,8 @@ void GetEigenVectorCentr(const PUNGraph& Graph, TIntFltH& NIdEigenH, const doubl
 
 /// PageRank
 /// For more info see: http://en.wikipedia.org/wiki/PageRank
-template<class PGraph> void GetPageRank(const PGraph& Graph, TIntFltH& PRankH, const double& C=0.85, const double& Eps=1e-4, const int& MaxIter=100);
-template<class PGraph> void GetPageRank_v1(const PGraph& Graph, TIntFltH& PRankH, const double& C=0.85, const double& Eps=1e-4, const int& MaxIter=100);
+template<class PGraph> void GetPageRank(const PGraph& Graph, THash<typename TNIdType<typename PGraph::TObj>::TNIdT, TFlt>& PRankH, const double& C=0.85, const double& Eps=1e-4, const int& MaxIter=100);
+template<class PGraph> void GetPageRank_v1(const PGraph& Graph, THash<typename TNIdType<typename PGraph::TObj>::TNIdT, TFlt>& PRankH, const double& C=0.85, const double& Eps=1e-4, const int& MaxIter=100);
 #ifdef USE_OPENMP
 template<class PGraph> void GetPageRankMP(const PGraph& Graph, TIntFltH& PRankH, const double& C=0.85, const double& Eps=1e-4, const int& MaxIter=100);
 #endif
@@ -109,23 +115,32 @@ int GetWeightedPageRankMP(const PNEANet Graph, TIntFltH& PRankH, const TStr& Att
 
 /// HITS: Hubs and Authorities
 /// For more info see: http://en.wikipedia.org/wiki/HITS_algorithm)
-template<class PGraph> void GetHits(const PGraph& Graph, TIntFltH& NIdHubH, TIntFltH& NIdAuthH, const int& MaxIter=20);
+template<class PGraph> void GetHits(const PGraph& Graph, THash<typename TNIdType<typename PGraph::TObj>::TNIdT, TFlt>& NIdHubH, THash<typename TNIdType<typename PGraph::TObj>::TNIdT, TFlt>& NIdAuthH, const int& MaxIter=20);
 #ifdef USE_OPENMP
+/// Parallel version of GetHits(), runs THitsVP on a snapshot of the graph.
 template<class PGraph> void GetHitsMP(const PGraph& Graph, TIntFltH& NIdHubH, TIntFltH& NIdAuthH, const int& MaxIter=20);
 #endif
 
 /// Dijkstra Algorithm
 /// For more info see:  https://en.wikipedia.org/wiki/Dijkstra%27s_algorithm
 int GetWeightedShortestPath(const PNEANet Graph, const int& SrcNId, TIntFltH& NIdDistH, const TFltV& Attr);
+/// Dijkstra Algorithm with edge weights taken from flt edge attribute Attr.
+int GetWeightedShortestPath(const PNEANet Graph, const int& SrcNId, TIntFltH& NIdDistH, const TStr& Attr);
+#ifdef USE_OPENMP
+/// Parallel delta-stepping version of GetWeightedShortestPath, Delta<=0 picks the mean edge weight as the bucket width.
+/// See TWgtShortPath for repeated queries, early termination and A* search.
+int GetWeightedShortestPathMP(const PNEANet Graph, const int& SrcNId, TIntFltH& NIdDistH, const TFltV& Attr, const double& Delta=-1);
+#endif
 /////////////////////////////////////////////////
 // Implementation
 template <class PGraph>
-double GetFarnessCentr(const PGraph& Graph, const int& NId, const bool& Normalized, const bool& IsDir) {
-  TIntH NDistH(Graph->GetNodes());
+double GetFarnessCentr(const PGraph& Graph, const typename TNIdType<typename PGraph::TObj>::TNId& NId, const bool& Normalized, const bool& IsDir) {
+  typedef THash<typename TNIdType<typename PGraph::TObj>::TNIdT, TInt> TNIdDistH;
+  TNIdDistH NDistH(Graph->GetNodes());
   TSnap::GetShortPath<PGraph>(Graph, NId, NDistH, IsDir, TInt::Mx);  
   
   double sum = 0;
-  for (TIntH::TIter I = NDistH.BegI(); I < NDistH.EndI(); I++) {
+  for (typename TNIdDistH::TIter I = NDistH.BegI(); I < NDistH.EndI(); I++) {
     sum += I->Dat();
   }
   if (NDistH.Len() > 1) { 
@@ -158,7 +173,7 @@ double GetFarnessCentrMP(const PGraph& Graph, const int& NId, const bool& Normal
 }
 
 template <class PGraph>
-double GetClosenessCentr(const PGraph& Graph, const int& NId, const bool& Normalized, const bool& IsDir) {
+double GetClosenessCentr(const PGraph& Graph, const typename TNIdType<typename PGraph::TObj>::TNId& NId, const bool& Normalized, const bool& IsDir) {
   const double Farness = GetFarnessCentr<PGraph> (Graph, NId, Normalized, IsDir);
   if (Farness != 0.0) { return 1.0/Farness; }
   else { return 0.0; }
@@ -174,7 +189,7 @@ double GetClosenessCentrMP(const PGraph& Graph, const int& NId, const bool& Norm
 }
 
 template <class PGraph>
-int GetNodeEcc(const PGraph& Graph, const int& NId, const bool& IsDir) {
+int GetNodeEcc(const PGraph& Graph, const typename TNIdType<typename PGraph::TObj>::TNId& NId, const bool& IsDir) {
   int NodeEcc;
   int Dist;
   TBreathFS<PGraph> BFS(Graph);
@@ -197,7 +212,7 @@ int GetNodeEcc(const PGraph& Graph, const int& NId, const bool& IsDir) {
 //   iGraph -- iGraph implementation(which treats leaked PageRank in a funny way)
 // This implementation is an unoptimized version, it accesses nodes via a hash table.
 template<class PGraph>
-void GetPageRank_v1(const PGraph& Graph, TIntFltH& PRankH, const double& C, const double& Eps, const int& MaxIter) {
+void GetPageRank_v1(const PGraph& Graph, THash<typename TNIdType<typename PGraph::TObj>::TNIdT, TFlt>& PRankH, const double& C, const double& Eps, const int& MaxIter) {
   const int NNodes = Graph->GetNodes();
   //const double OneOver = 1.0/double(NNodes);
   PRankH.Gen(NNodes);
@@ -211,7 +226,7 @@ void GetPageRank_v1(const PGraph& Graph, TIntFltH& PRankH, const double& C, cons
     for (typename PGraph::TObj::TNodeI NI = Graph->BegNI(); NI < Graph->EndNI(); NI++, j++) {
       TmpV[j] = 0;
       for (int e = 0; e < NI.GetInDeg(); e++) {
-        const int InNId = NI.GetInNId(e);
+        const typename TNIdType<typename PGraph::TObj>::TNId InNId = NI.GetInNId(e);
         const int OutDeg = Graph->GetNI(InNId).GetOutDeg();
         if (OutDeg > 0) {
           TmpV[j] += PRankH.GetDat(InNId) / OutDeg; }
@@ -236,8 +251,11 @@ void GetPageRank_v1(const PGraph& Graph, TIntFltH& PRankH, const double& C, cons
 //   Berkhin -- (the correct way) see Algorithm 1 of P. Berkhin, A Survey on PageRank Computing, Internet Mathematics, 2005
 //   iGraph -- iGraph implementation(which treats leaked PageRank in a funny way)
 // This implementation is an optimized version, it builds a vector and accesses nodes via the vector.
+// Graphs with 64-bit node ids use GetPageRank_v1(), since their node ids cannot index a vector.
 template<class PGraph>
-void GetPageRank(const PGraph& Graph, TIntFltH& PRankH, const double& C, const double& Eps, const int& MaxIter) {
+void GetPageRank(const PGraph& Graph, THash<typename TNIdType<typename PGraph::TObj>::TNIdT, TFlt>& PRankH, const double& C, const double& Eps, const int& MaxIter) {
+  if (sizeof(typename TNIdType<typename PGraph::TObj>::TNId) > sizeof(int)) {
+    GetPageRank_v1(Graph, PRankH, C, Eps, MaxIter);  return; }
   const int NNodes = Graph->GetNodes();
   TVec<typename PGraph::TObj::TNodeI> NV;
   PRankH.Gen(NNodes);
@@ -521,7 +539,7 @@ void GetBetweennessCentr(const PGraph& Graph, TIntFltH& NodeBtwH, TIntPrFltH& Ed
 }
 
 template<class PGraph>
-void GetHits(const PGraph& Graph, TIntFltH& NIdHubH, TIntFltH& NIdAuthH, const int& MaxIter) {
+void GetHits(const PGraph& Graph, THash<typename TNIdType<typename PGraph::TObj>::TNIdT, TFlt>& NIdHubH, THash<typename TNIdType<typename PGraph::TObj>::TNIdT, TFlt>& NIdAuthH, const int& MaxIter) {
   const int NNodes = Graph->GetNodes();
   NIdHubH.Gen(NNodes);
   NIdAuthH.Gen(NNodes);
@@ -567,52 +585,17 @@ void GetHits(const PGraph& Graph, TIntFltH& NIdHubH, TIntFltH& NIdAuthH, const i
 #ifdef USE_OPENMP
 template<class PGraph>
 void GetHitsMP(const PGraph& Graph, TIntFltH& NIdHubH, TIntFltH& NIdAuthH, const int& MaxIter) {
-  const int NNodes = Graph->GetNodes();
-  TIntV NV;
-  NIdHubH.Gen(NNodes);
-  NIdAuthH.Gen(NNodes);
-  for (typename PGraph::TObj::TNodeI NI = Graph->BegNI(); NI < Graph->EndNI(); NI++) {
-    NV.Add(NI.GetId());
-    NIdHubH.AddDat(NI.GetId(), 1.0);
-    NIdAuthH.AddDat(NI.GetId(), 1.0);
+  const TCsrGraph Csr(Graph);
+  THitsVP Hits;
+  TVtxProgEngine<THitsVP> Engine(Csr);
+  Engine.Run(Hits, 2*MaxIter);
+  const TVec<TFltPr>& ValV = Engine.GetValV();
+  NIdHubH.Gen(Csr.GetNodes());
+  NIdAuthH.Gen(Csr.GetNodes());
+  for (int i = 0; i < Csr.GetNodes(); i++) {
+    NIdHubH.AddDat(Csr.GetNId(i), ValV[i].Val1);
+    NIdAuthH.AddDat(Csr.GetNId(i), ValV[i].Val2);
   }
-  double Norm=0;
-  for (int iter = 0; iter < MaxIter; iter++) {
-    // update authority scores
-    Norm = 0;
-    #pragma omp parallel for reduction(+:Norm) schedule(dynamic,1000)
-    for (int i = 0; i < NNodes; i++) {
-      typename PGraph::TObj::TNodeI NI = Graph->GetNI(NV[i]);
-      double& Auth = NIdAuthH.GetDat(NI.GetId()).Val;
-      Auth = 0;
-      for (int e = 0; e < NI.GetInDeg(); e++) {
-        Auth +=  NIdHubH.GetDat(NI.GetInNId(e)); }
-      Norm = Norm + Auth*Auth;
-    }
-    Norm = sqrt(Norm);
-    for (int i = 0; i < NIdAuthH.Len(); i++) { NIdAuthH[i] /= Norm; }
-    // update hub scores
-    #pragma omp parallel for reduction(+:Norm) schedule(dynamic,1000)
-    for (int i = 0; i < NNodes; i++) {
-      typename PGraph::TObj::TNodeI NI = Graph->GetNI(NV[i]);
-      double& Hub = NIdHubH.GetDat(NI.GetId()).Val;
-      Hub = 0;
-      for (int e = 0; e < NI.GetOutDeg(); e++) {
-        Hub += NIdAuthH.GetDat(NI.GetOutNId(e)); }
-      Norm = Norm + Hub*Hub;
-    }
-    Norm = sqrt(Norm);
-    for (int i = 0; i < NIdHubH.Len(); i++) { NIdHubH[i] /= Norm; }
-  }
-  // make sure Hub and Authority scores normalize to L2 norm 1
-  Norm = 0.0;
-  for (int i = 0; i < NIdHubH.Len(); i++) { Norm += TMath::Sqr(NIdHubH[i]); }
-  Norm = sqrt(Norm);
-  for (int i = 0; i < NIdHubH.Len(); i++) { NIdHubH[i] /= Norm; }
-  Norm = 0.0;
-  for (int i = 0; i < NIdAuthH.Len(); i++) { Norm += TMath::Sqr(NIdAuthH[i]); }
-  Norm = sqrt(Norm);
-  for (int i = 0; i < NIdAuthH.Len(); i++) { NIdAuthH[i] /= Norm; }
 }
 #endif
 
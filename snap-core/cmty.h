@@ -22,6 +22,12 @@ double CommunityGirvanNewman(PUNGraph& Graph, TCnComV& CmtyV);
 /// See: Finding community structure in very large networks, A. Clauset, M.E.J. Newman, C. Moore, 2004
 double CommunityCNM(const PUNGraph& Graph, TCnComV& CmtyV);
 
+/// Label propagation community detection, run as a parallel vertex program (see TLabelPropVP).
+/// Every node repeatedly adopts the most frequent label among its neighbors until no label changes or MaxIter supersteps are done.
+/// Returns the modularity of the communities.
+/// See: Raghavan U. N., Albert R., Kumara S., Near linear time algorithm to detect community structures in large-scale networks, Phys. Rev. E 76, 036106 (2007)
+template<typename PGraph> double CommunityLabelProp(const PGraph& Graph, TCnComV& CmtyV, const int& MaxIter=100);
+
 /// Rosvall-Bergstrom community detection algorithm based on information theoretic approach.
 /// See: Rosvall M., Bergstrom C. T., Maps of random walks on complex networks reveal community structure, Proc. Natl. Acad. Sci. USA 105, 1118-1123 (2008)
 double Infomap(PUNGraph& Graph, TCnComV& CmtyV);
@@ -90,4 +96,14 @@ void GetEdgesInOut(const PGraph& Graph, const TIntV& NIdV, int& EdgesIn, int& Ed
   EdgesIn /= 2;
 }
 
+template<typename PGraph>
+double CommunityLabelProp(const PGraph& Graph, TCnComV& CmtyV, const int& MaxIter) {
+  const TCsrGraph Csr(Graph);
+  TLabelPropVP LabelProp;
+  TVtxProgEngine<TLabelPropVP> Engine(Csr);
+  Engine.Run(LabelProp, MaxIter);
+  GetCnComFromLabels(Csr, Engine.GetValV(), CmtyV);
+  return GetModularity(Graph, CmtyV);
+}
+
 }; // namespace TSnap
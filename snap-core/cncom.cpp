@@ -1,6 +1,7 @@
 /////////////////////////////////////////////////
 // Connected Components
-void TCnCom::Dump(const TCnComV& CnComV, const TStr& Desc) {
+template <>
+void TCnComT<int>::Dump(const TCnComV& CnComV, const TStr& Desc) {
   if (! Desc.Empty()) { printf("%s:\n", Desc.CStr()); }
   for (int cc = 0; cc < CnComV.Len(); cc++) {
     const TIntV& NIdV = CnComV[cc].NIdV;
@@ -10,7 +11,8 @@ void TCnCom::Dump(const TCnComV& CnComV, const TStr& Desc) {
   }
 }
 
-void TCnCom::SaveTxt(const TCnComV& CnComV, const TStr& FNm, const TStr& Desc) {
+template <>
+void TCnComT<int>::SaveTxt(const TCnComV& CnComV, const TStr& FNm, const TStr& Desc) {
   FILE *F = fopen(FNm.CStr(), "wt");
   if (! Desc.Empty()) { fprintf(F, "# %s\n", Desc.CStr()); }
   fprintf(F, "# Connected Components:\t%d\n", CnComV.Len());
@@ -24,6 +26,32 @@ void TCnCom::SaveTxt(const TCnComV& CnComV, const TStr& FNm, const TStr& Desc) {
   fclose(F);
 }
 
+template <>
+void TCnComT<int64>::Dump(const TCnCom64V& CnComV, const TStr& Desc) {
+  if (! Desc.Empty()) { printf("%s:\n", Desc.CStr()); }
+  for (int cc = 0; cc < CnComV.Len(); cc++) {
+    const TVec<TInt64>& NIdV = CnComV[cc].NIdV;
+    printf("%d : ", NIdV.Len());
+    for (int i = 0; i < NIdV.Len(); i++) { printf(" %s", TInt64::GetStr(NIdV[i]).CStr()); }
+    printf("\n");
+  }
+}
+
+template <>
+void TCnComT<int64>::SaveTxt(const TCnCom64V& CnComV, const TStr& FNm, const TStr& Desc) {
+  FILE *F = fopen(FNm.CStr(), "wt");
+  if (! Desc.Empty()) { fprintf(F, "# %s\n", Desc.CStr()); }
+  fprintf(F, "# Connected Components:\t%d\n", CnComV.Len());
+  fprintf(F, "# Connected components (format: <Size>\\t<NodeId1>\\t<NodeId2>...)\n");
+  for (int cc = 0; cc < CnComV.Len(); cc++) {
+    const TVec<TInt64>& NIdV = CnComV[cc].NIdV;
+    fprintf(F, "%d", NIdV.Len());
+    for (int i = 0; i < NIdV.Len(); i++) { fprintf(F, "\t%s", TInt64::GetStr(NIdV[i]).CStr()); }
+    fprintf(F, "\n");
+  }
+  fclose(F);
+}
+
 /////////////////////////////////////////////////
 // Connected Components
 namespace TSnap {
@@ -139,4 +167,204 @@ PUNGraph GetMxBiCon(const PUNGraph& Graph, const bool& RenumberNodes) {
   return TSnap::GetSubGraph(Graph, CnComV[CcId](), RenumberNodes);
 }
 
+void GetCnComFromLabels(const TCsrGraph& Csr, const TIntV& CcV, TCnComV& CnComV) {
+  const int Nodes = CcV.Len();
+  TIntV CcIdxV(Nodes);  // component label -> position in CnComV
+  CcIdxV.PutAll(-1);
+  TIntV CcSzV;
+  for (int i = 0; i < Nodes; i++) {
+    const int Cc = CcV[i];
+    if (CcIdxV[Cc] == -1) { CcIdxV[Cc] = CcSzV.Add(0); }
+    CcSzV[CcIdxV[Cc]]++;
+  }
+  CnComV.Gen(CcSzV.Len());
+  for (int c = 0; c < CcSzV.Len(); c++) { CnComV[c].NIdV.Gen(CcSzV[c], 0); }
+  for (int i = 0; i < Nodes; i++) { CnComV[CcIdxV[CcV[i]]].Add(Csr.GetNId(i)); }
+  #pragma omp parallel for schedule(dynamic,100)
+  for (int c = 0; c < CnComV.Len(); c++) { CnComV[c].Sort(true); }
+  CnComV.Sort(false);
+}
+
+void GetCnComSzCntFromLabels(const TIntV& CcV, TIntPrV& SzCntV) {
+  const int Nodes = CcV.Len();
+  TIntV CcSzV(Nodes);
+  for (int i = 0; i < Nodes; i++) { CcSzV[CcV[i]]++; }
+  TIntH SzToCntH;
+  for (int i = 0; i < Nodes; i++) {
+    if (CcSzV[i] > 0) { SzToCntH.AddDat(CcSzV[i]) += 1; }
+  }
+  SzToCntH.GetKeyDatPrV(SzCntV);
+  SzCntV.Sort(true);
+}
+
+#ifdef USE_OPENMP
+// Afforest: M. Sutton, T. Ben-Nun, A. Barak: Optimizing Parallel Graph Connectivity Computation via Subgraph Sampling, IPDPS 2018.
+void GetWccLabelsMP(const TCsrGraph& Csr, TIntV& CcV) {
+  const int Nodes = Csr.GetNodes();
+  const int SampleRounds = 2;
+  IAssert(Csr.HasIn());
+  TUnionFindMP UF(Nodes);
+  // link every node to its first few out-neighbors
+  for (int r = 0; r < SampleRounds; r++) {
+    #pragma omp parallel for schedule(dynamic,10000)
+    for (int i = 0; i < Nodes; i++) {
+      if (Csr.GetOutDeg(i) > r) { UF.Union(i, Csr.GetOutNbr(i, r)); }
+    }
+  }
+  // find the (likely) largest component from a sample of nodes
+  int SkipCc = -1;
+  if (Nodes > 0) {
+    TRnd Rnd(1);
+    TIntH CcCntH;
+    for (int s = 0; s < 1024; s++) { CcCntH.AddDat(UF.Find(Rnd.GetUniDevInt(Nodes))) += 1; }
+    CcCntH.SortByDat(false);
+    SkipCc = CcCntH.GetKey(0);
+  }
+  // remaining edges of nodes outside of the largest component; edges from the
+  // largest component to the rest are seen from the other endpoint
+  #pragma omp parallel for schedule(dynamic,1000)
+  for (int i = 0; i < Nodes; i++) {
+    if (UF.Find(i) == SkipCc) { continue; }
+    for (int e = SampleRounds; e < Csr.GetOutDeg(i); e++) { UF.Union(i, Csr.GetOutNbr(i, e)); }
+    if (Csr.IsDirected()) {
+      for (int e = 0; e < Csr.GetInDeg(i); e++) { UF.Union(i, Csr.GetInNbr(i, e)); }
+    }
+  }
+  UF.Flatten();
+  CcV = UF.GetParentV();
+}
+
+// Multistep SCC: G. M. Slota, S. Rajamanickam, K. Madduri: BFS and Coloring-based Parallel Algorithms
+// for Strongly Connected Components and Related Problems, IPDPS 2014.
+// All phases are iterative, so there is no recursion depth limit on long paths.
+void GetSccLabelsMP(const TCsrGraph& Csr, TIntV& CcV) {
+  const int Nodes = Csr.GetNodes();
+  IAssert(Csr.HasIn());
+  CcV.Gen(Nodes);
+  CcV.PutAll(-1); // -1 -- node not yet in any SCC
+  TIntV Vec1(Nodes, 0), Vec2(Nodes, 0);
+  TIntV* PCurV = &Vec1;
+  TIntV* PNextV = &Vec2;
+  // 1. trimming: nodes without in- or out-neighbors are singleton SCCs
+  TIntV InCntV(Nodes), OutCntV(Nodes);
+  #pragma omp parallel for schedule(dynamic,10000)
+  for (int i = 0; i < Nodes; i++) {
+    int InCnt = 0, OutCnt = 0;
+    for (const TInt* N = Csr.BegIn(i); N < Csr.EndIn(i); N++) { if (*N != i) { InCnt++; } }
+    for (const TInt* N = Csr.BegOut(i); N < Csr.EndOut(i); N++) { if (*N != i) { OutCnt++; } }
+    InCntV[i] = InCnt;  OutCntV[i] = OutCnt;
+    if (InCnt == 0 || OutCnt == 0) { CcV[i] = i;  PCurV->AddMP(i); }
+  }
+  while (! PCurV->Empty()) {
+    #pragma omp parallel for schedule(dynamic,1000)
+    for (int k = 0; k < PCurV->Len(); k++) {
+      const int U = (*PCurV)[k];
+      for (const TInt* N = Csr.BegOut(U); N < Csr.EndOut(U); N++) {
+        const int V = *N;
+        if (V != U && CcV[V] == -1 && __sync_sub_and_fetch(&InCntV[V].Val, 1) == 0 &&
+         __sync_bool_compare_and_swap(&CcV[V].Val, -1, V)) { PNextV->AddMP(V); }
+      }
+      for (const TInt* N = Csr.BegIn(U); N < Csr.EndIn(U); N++) {
+        const int V = *N;
+        if (V != U && CcV[V] == -1 && __sync_sub_and_fetch(&OutCntV[V].Val, 1) == 0 &&
+         __sync_bool_compare_and_swap(&CcV[V].Val, -1, V)) { PNextV->AddMP(V); }
+      }
+    }
+    TIntV* Tmp = PCurV;  PCurV = PNextV;  PNextV = Tmp;
+    PNextV->Reduce(0);
+  }
+  InCntV.Clr();  OutCntV.Clr();
+  // 2. forward-backward search from the max in*out degree node finds the giant SCC
+  int Pivot = -1;
+  double MxDegProd = -1;
+  for (int i = 0; i < Nodes; i++) {
+    if (CcV[i] != -1) { continue; }
+    const double DegProd = double(Csr.GetInDeg(i)) * double(Csr.GetOutDeg(i));
+    if (DegProd > MxDegProd) { MxDegProd = DegProd;  Pivot = i; }
+  }
+  if (Pivot == -1) { return; }
+  TIntV MarkV(Nodes); // 1 -- reached forward, 2 -- reached forward and backward
+  for (int Dir = 1; Dir <= 2; Dir++) {
+    MarkV[Pivot] = Dir;
+    PCurV->Reduce(0);  PCurV->Add(Pivot);
+    while (! PCurV->Empty()) {
+      #pragma omp parallel for schedule(dynamic,1000)
+      for (int k = 0; k < PCurV->Len(); k++) {
+        const int U = (*PCurV)[k];
+        const TInt* BegN = Dir == 1 ? Csr.BegOut(U) : Csr.BegIn(U);
+        const TInt* EndN = Dir == 1 ? Csr.EndOut(U) : Csr.EndIn(U);
+        for (const TInt* N = BegN; N < EndN; N++) {
+          const int V = *N;
+          if (CcV[V] == -1 && MarkV[V] == Dir-1 &&
+           __sync_bool_compare_and_swap(&MarkV[V].Val, Dir-1, Dir)) { PNextV->AddMP(V); }
+        }
+      }
+      TIntV* Tmp = PCurV;  PCurV = PNextV;  PNextV = Tmp;
+      PNextV->Reduce(0);
+    }
+  }
+  #pragma omp parallel for schedule(static)
+  for (int i = 0; i < Nodes; i++) {
+    if (MarkV[i] == 2) { CcV[i] = Pivot; }
+  }
+  MarkV.Clr();
+  // 3. coloring: propagate the max node index forward, then every node whose
+  // color equals its own index collects its SCC by a backward search within its color
+  TIntV ColorV(Nodes), PendingV(Nodes);
+  while (true) {
+    PCurV->Reduce(0);
+    #pragma omp parallel for schedule(dynamic,10000)
+    for (int i = 0; i < Nodes; i++) {
+      if (CcV[i] == -1) { ColorV[i] = i;  PendingV[i] = 1;  PCurV->AddMP(i); }
+    }
+    if (PCurV->Empty()) { break; }
+    while (! PCurV->Empty()) {
+      #pragma omp parallel for schedule(dynamic,1000)
+      for (int k = 0; k < PCurV->Len(); k++) {
+        const int U = (*PCurV)[k];
+        PendingV[U] = 0;
+        __sync_synchronize();
+        const int Color = ColorV[U];
+        for (const TInt* N = Csr.BegOut(U); N < Csr.EndOut(U); N++) {
+          const int V = *N;
+          if (CcV[V] != -1) { continue; }
+          int OldColor = ColorV[V];
+          while (OldColor < Color) {
+            if (__sync_bool_compare_and_swap(&ColorV[V].Val, OldColor, Color)) {
+              if (__sync_bool_compare_and_swap(&PendingV[V].Val, 0, 1)) { PNextV->AddMP(V); }
+              break;
+            }
+            OldColor = ColorV[V];
+          }
+        }
+      }
+      TIntV* Tmp = PCurV;  PCurV = PNextV;  PNextV = Tmp;
+      PNextV->Reduce(0);
+    }
+    // roots of the colors
+    #pragma omp parallel for schedule(dynamic,10000)
+    for (int i = 0; i < Nodes; i++) {
+      if (CcV[i] == -1 && ColorV[i] == i) { PCurV->AddMP(i); }
+    }
+    #pragma omp parallel
+    {
+      TIntV QueueV;
+      #pragma omp for schedule(dynamic,10)
+      for (int k = 0; k < PCurV->Len(); k++) {
+        const int Root = (*PCurV)[k];
+        QueueV.Clr(false);  QueueV.Add(Root);
+        CcV[Root] = Root;
+        for (int q = 0; q < QueueV.Len(); q++) {
+          const int U = QueueV[q];
+          for (const TInt* N = Csr.BegIn(U); N < Csr.EndIn(U); N++) {
+            const int V = *N;
+            if (ColorV[V] == Root && CcV[V] == -1) { CcV[V] = Root;  QueueV.Add(V); }
+          }
+        }
+      }
+    }
+  }
+}
+#endif // USE_OPENMP
+
 } // namespace TSnap
@@ -1,12 +1,15 @@
 /////////////////////////////////////////////////
 // Connected Components
-class TCnCom;
+template <class TId> class TCnComT;
+typedef TCnComT<int> TCnCom;
 typedef TVec<TCnCom> TCnComV;
+typedef TCnComT<int64> TCnCom64;
+typedef TVec<TCnCom64> TCnCom64V;
 
 namespace TSnap {
 
 /// Returns (via output parameter CnCom) all nodes that are in the same connected component as node NId.
-template <class PGraph> void GetNodeWcc(const PGraph& Graph, const int& NId, TIntV& CnCom);
+template <class PGraph> void GetNodeWcc(const PGraph& Graph, const typename TNIdType<typename PGraph::TObj>::TNId& NId, TVec<typename TNIdType<typename PGraph::TObj>::TNIdT>& CnCom);
 /// Tests whether the Graph is (weakly) connected.
 template <class PGraph> bool IsConnected(const PGraph& Graph);
 /// Tests whether the Graph is weakly connected.
@@ -14,11 +17,11 @@ template <class PGraph> bool IsWeaklyConn(const PGraph& Graph);
 /// Returns a distribution of weakly connected component sizes. ##GetWccSzCnt
 template <class PGraph> void GetWccSzCnt(const PGraph& Graph, TIntPrV& WccSzCnt);
 /// Returns all weakly connected components in a Graph. ##GetWccs
-template <class PGraph> void GetWccs(const PGraph& Graph, TCnComV& CnComV);
+template <class PGraph> void GetWccs(const PGraph& Graph, TVec<TCnComT<typename TNIdType<typename PGraph::TObj>::TNId> >& CnComV);
 /// Returns a distribution of strongly connected component sizes. ##GetSccSzCnt
 template <class PGraph> void GetSccSzCnt(const PGraph& Graph, TIntPrV& SccSzCnt);
 /// Returns all strongly connected components in a Graph. ##GetSccs
-template <class PGraph> void GetSccs(const PGraph& Graph, TCnComV& CnComV);
+template <class PGraph> void GetSccs(const PGraph& Graph, TVec<TCnComT<typename TNIdType<typename PGraph::TObj>::TNId> >& CnComV);
 /// Returns the fraction of nodes in the largest weakly connected component of a Graph.
 template <class PGraph> double GetMxWccSz(const PGraph& Graph);
 /// Returns the fraction of nodes in the largest strongly connected component of a Graph.
@@ -26,6 +29,8 @@ template <class PGraph> double GetMxSccSz(const PGraph& Graph);
 
 /// Returns a graph representing the largest weakly connected component on an input Graph. ##GetMxWcc
 template <class PGraph> PGraph GetMxWcc(const PGraph& Graph);
+/// Returns a view of the largest weakly connected component of an input Graph, the graph is not copied.
+template <class PGraph> TPt<TGraphView<PGraph> > GetMxWccView(const PGraph& Graph);
 /// Returns a graph representing the largest strongly connected component on an input Graph.  ##GetMxScc
 template <class PGraph> PGraph GetMxScc(const PGraph& Graph);
 /// Returns a graph representing the largest bi-connected component on an input Graph. ##GetMxBiCon
@@ -46,37 +51,62 @@ void Get1CnCom(const PUNGraph& Graph, TCnComV& Cn1ComV);
 /// Returns a graph representing the largest bi-connected component on an undirected Graph. ##GetMxBiCon
 PUNGraph GetMxBiCon(const PUNGraph& Graph, const bool& RenumberNodes=false);
 
+#ifdef USE_OPENMP
+/// Returns a distribution of weakly connected component sizes. Parallel version. ##GetWccSzCntMP
+template <class PGraph> void GetWccSzCntMP(const PGraph& Graph, TIntPrV& WccSzCnt);
+/// Returns all weakly connected components in a Graph. Parallel version. ##GetWccsMP
+template <class PGraph> void GetWccsMP(const PGraph& Graph, TCnComV& CnComV);
+/// Returns a distribution of strongly connected component sizes. Parallel version. ##GetSccSzCntMP
+template <class PGraph> void GetSccSzCntMP(const PGraph& Graph, TIntPrV& SccSzCnt);
+/// Returns all strongly connected components in a Graph. Parallel version. ##GetSccsMP
+template <class PGraph> void GetSccsMP(const PGraph& Graph, TCnComV& CnComV);
+/// Labels node indices of Csr with weakly connected component ids (Afforest union-find). ##GetWccLabelsMP
+void GetWccLabelsMP(const TCsrGraph& Csr, TIntV& CcV);
+/// Labels node indices of Csr with strongly connected component ids (trimming + forward-backward + coloring). ##GetSccLabelsMP
+void GetSccLabelsMP(const TCsrGraph& Csr, TIntV& CcV);
+#endif // USE_OPENMP
+/// Converts per-node component labels of Csr into components sorted by decreasing size.
+void GetCnComFromLabels(const TCsrGraph& Csr, const TIntV& CcV, TCnComV& CnComV);
+/// Converts per-node component labels into a (size, count) distribution of component sizes.
+void GetCnComSzCntFromLabels(const TIntV& CcV, TIntPrV& SzCntV);
+
 }; // namespace TSnap
 
 //#//////////////////////////////////////////////
 /// Connected Component.
-/// Connected component is defined by a vector of its node IDs.
-class TCnCom {
+/// Connected component is defined by a vector of its node IDs. TId is the
+/// node id type of the graph (int, or int64 for TUNGraph64/TNGraph64).
+template <class TId>
+class TCnComT {
+public:
+  typedef typename TSnapDetail::TNIdVal<TId>::TVal TNIdT;
+  typedef TVec<TNIdT> TNIdV;
+  typedef TVec<TCnComT<TId> > TCnComTV;
 public:
-  TIntV NIdV;
+  TNIdV NIdV;
 public:
-  TCnCom() : NIdV() { }
-  TCnCom(const TIntV& NodeIdV) : NIdV(NodeIdV) { }
-  TCnCom(const TCnCom& CC) : NIdV(CC.NIdV) { }
-  TCnCom(TSIn& SIn) : NIdV(SIn) { }
+  TCnComT() : NIdV() { }
+  TCnComT(const TNIdV& NodeIdV) : NIdV(NodeIdV) { }
+  TCnComT(const TCnComT& CC) : NIdV(CC.NIdV) { }
+  TCnComT(TSIn& SIn) : NIdV(SIn) { }
   void Save(TSOut& SOut) const { NIdV.Save(SOut); }
-  TCnCom& operator = (const TCnCom& CC) { if (this != &CC) NIdV = CC.NIdV;  return *this; }
-  bool operator == (const TCnCom& CC) const { return NIdV == CC.NIdV; }
-  bool operator < (const TCnCom& CC) const { return NIdV < CC.NIdV; }
+  TCnComT& operator = (const TCnComT& CC) { if (this != &CC) NIdV = CC.NIdV;  return *this; }
+  bool operator == (const TCnComT& CC) const { return NIdV == CC.NIdV; }
+  bool operator < (const TCnComT& CC) const { return NIdV < CC.NIdV; }
 
   int Len() const { return NIdV.Len(); }
   bool Empty() const { return NIdV.Empty(); }
   void Clr() { NIdV.Clr(); }
-  void Add(const int& NodeId) { NIdV.Add(NodeId); }
-  const TInt& operator [] (const int& NIdN) const { return NIdV[NIdN]; }
-  const TIntV& operator () () const { return NIdV; }
-  TIntV& operator () () { return NIdV; }
-  const TInt& GetVal(const int& NIdN) const { return operator[](NIdN); }
+  void Add(const TId& NodeId) { NIdV.Add(NodeId); }
+  const TNIdT& operator [] (const int& NIdN) const { return NIdV[NIdN]; }
+  const TNIdV& operator () () const { return NIdV; }
+  TNIdV& operator () () { return NIdV; }
+  const TNIdT& GetVal(const int& NIdN) const { return operator[](NIdN); }
   void Sort(const bool& Asc = true) { NIdV.Sort(Asc); }
-  bool IsNIdIn(const int& NId) const { return NIdV.SearchBin(NId) != -1; }
-  const TInt& GetRndNId() const { return NIdV[TInt::Rnd.GetUniDevInt(Len())]; }
-  static void Dump(const TCnComV& CnComV, const TStr& Desc=TStr());
-  static void SaveTxt(const TCnComV& CnComV, const TStr& FNm, const TStr& Desc=TStr());
+  bool IsNIdIn(const TId& NId) const { return NIdV.SearchBin(NId) != -1; }
+  const TNIdT& GetRndNId() const { return NIdV[TInt::Rnd.GetUniDevInt(Len())]; }
+  static void Dump(const TCnComTV& CnComV, const TStr& Desc=TStr());
+  static void SaveTxt(const TCnComTV& CnComV, const TStr& FNm, const TStr& Desc=TStr());
   /// Depth-First-Search.
   /// Depending on the stage of DFS a different member function of Visitor class is called.
   /// See source code for details.
@@ -86,30 +116,40 @@ public:
   int GetSecHashCd() const { return NIdV.GetSecHashCd(); }
 };
 
+template <> void TCnComT<int>::Dump(const TCnComV& CnComV, const TStr& Desc);
+template <> void TCnComT<int>::SaveTxt(const TCnComV& CnComV, const TStr& FNm, const TStr& Desc);
+template <> void TCnComT<int64>::Dump(const TCnCom64V& CnComV, const TStr& Desc);
+template <> void TCnComT<int64>::SaveTxt(const TCnCom64V& CnComV, const TStr& FNm, const TStr& Desc);
+
+template <class TId>
 template <class PGraph, class TVisitor>
-void TCnCom::GetDfsVisitor(const PGraph& Graph, TVisitor& Visitor) {
+void TCnComT<TId>::GetDfsVisitor(const PGraph& Graph, TVisitor& Visitor) {
+  typedef typename TSnap::TNIdType<typename PGraph::TObj>::TNId TNId;
+  typedef typename TSnap::TNIdType<typename PGraph::TObj>::TNIdT TNIdT;
+  typedef TTriple<TNIdT, TInt, TInt> TNIdEdgeTr; // node id, next edge, degree
   const int Nodes = Graph->GetNodes();
-  TSStack<TIntTr> Stack(Nodes);
-  int edge=0, Deg=0, U=0;
-  TIntH ColorH(Nodes);
+  TSStack<TNIdEdgeTr> Stack(Nodes);
+  int edge=0, Deg=0;
+  TNId U=0;
+  THash<TNIdT, TInt> ColorH(Nodes);
   typename PGraph::TObj::TNodeI NI, UI;
   for (NI = Graph->BegNI(); NI < Graph->EndNI(); NI++) {
     U = NI.GetId();
     if (! ColorH.IsKey(U)) {         // is unvisited node
       ColorH.AddDat(U, 1); 
       Visitor.DiscoverNode(U);       // discover
-      Stack.Push(TIntTr(U, 0, Graph->GetNI(U).GetOutDeg()));
+      Stack.Push(TNIdEdgeTr(U, 0, Graph->GetNI(U).GetOutDeg()));
       while (! Stack.Empty()) {
-        const TIntTr& Top = Stack.Top();
+        const TNIdEdgeTr& Top = Stack.Top();
         U=Top.Val1; edge=Top.Val2; Deg=Top.Val3;
         typename PGraph::TObj::TNodeI UI = Graph->GetNI(U);
         Stack.Pop();
         while (edge != Deg) {
-          const int V = UI.GetOutNId(edge);
+          const TNId V = UI.GetOutNId(edge);
           Visitor.ExamineEdge(U, V); // examine edge
           if (! ColorH.IsKey(V)) {
             Visitor.TreeEdge(U, V);  // tree edge
-            Stack.Push(TIntTr(U, ++edge, Deg));
+            Stack.Push(TNIdEdgeTr(U, ++edge, Deg));
             U = V;
             ColorH.AddDat(U, 1); 
             Visitor.DiscoverNode(U); // discover
@@ -198,26 +238,31 @@ public:
 /// Strongly connected componetns Depht-First-Search visitor class.
 template <class PGraph, bool OnlyCount = false>
 class TSccVisitor {
+public:
+  typedef typename TSnap::TNIdType<typename PGraph::TObj>::TNId TNId;
+  typedef typename TSnap::TNIdType<typename PGraph::TObj>::TNIdT TNIdT;
+  typedef TPair<TInt, TNIdT> TTmRtPr; // discovery time, root node id
 public:
   PGraph Graph;
-  THash<TInt, TIntPr> TmRtH;
-  TSStack<TInt> Stack;
+  THash<TNIdT, TTmRtPr> TmRtH;
+  TSStack<TNIdT> Stack;
   TInt Time;
   TIntH SccCntH;
-  TCnComV CnComV;
+  TVec<TCnComT<TNId> > CnComV;
 public:
   TSccVisitor(const PGraph& _Graph) :
       Graph(_Graph), TmRtH(Graph->GetNodes()), Stack(Graph->GetNodes()) { }
-  void DiscoverNode(int NId) {
-    Time++; TmRtH.AddDat(NId, TIntPr(-Time, NId)); // negative time -- node not yet in any SCC
+  void DiscoverNode(TNId NId) {
+    Time++; TmRtH.AddDat(NId, TTmRtPr(-Time, NId)); // negative time -- node not yet in any SCC
     Stack.Push(NId); }
-  void FinishNode(const int& NId) {
+  void FinishNode(const TNId& NId) {
     typename PGraph::TObj::TNodeI NI = Graph->GetNI(NId);
-    TIntPr& TmRtN = TmRtH.GetDat(NId);
-    int W = -1, Cnt = 0;
+    TTmRtPr& TmRtN = TmRtH.GetDat(NId);
+    TNId W = -1;
+    int Cnt = 0;
     for (int i = 0; i < NI.GetOutDeg(); i++) {
       W = NI.GetOutNId(i);
-      const TIntPr& TmRtW = TmRtH.GetDat(W);
+      const TTmRtPr& TmRtW = TmRtH.GetDat(W);
       if (TmRtW.Val1 < 0) { // node not yet in any SCC
         TmRtN.Val2 = GetMinDiscTm(TmRtN.Val2, TmRtW.Val2); } }
     if (TmRtN.Val2 == NId) {
@@ -227,11 +272,11 @@ public:
       TmRtH.GetDat(W).Val1 = abs(TmRtH.GetDat(W).Val1); // node is in SCC
       } while (W != NId);
       if (OnlyCount) { SccCntH.AddDat(Cnt) += 1; } } }
-  void ExamineEdge(const int& NId1, const int& NId2) { }
-  void TreeEdge(const int& NId1, const int& NId2) { }
-  void BackEdge(const int& NId1, const int& NId2) { }
-  void FwdEdge(const int& NId1, const int& NId2) { }
-  int GetMinDiscTm(const int& NId1, const int& NId2) const {
+  void ExamineEdge(const TNId& NId1, const TNId& NId2) { }
+  void TreeEdge(const TNId& NId1, const TNId& NId2) { }
+  void BackEdge(const TNId& NId1, const TNId& NId2) { }
+  void FwdEdge(const TNId& NId1, const TNId& NId2) { }
+  TNId GetMinDiscTm(const TNId& NId1, const TNId& NId2) const {
     return abs(TmRtH.GetDat(NId1).Val1) < abs(TmRtH.GetDat(NId2).Val1) ? NId1 : NId2; }
 };
 
@@ -240,23 +285,24 @@ public:
 namespace TSnap {
 
 template <class PGraph> 
-void GetNodeWcc(const PGraph& Graph, const int& NId, TIntV& CnCom) {
+void GetNodeWcc(const PGraph& Graph, const typename TNIdType<typename PGraph::TObj>::TNId& NId, TVec<typename TNIdType<typename PGraph::TObj>::TNIdT>& CnCom) {
+  typedef typename TNIdType<typename PGraph::TObj>::TNId TNId;
   typename PGraph::TObj::TNodeI NI;
-  THashSet<TInt> VisitedNId(Graph->GetNodes()+1);
-  TSnapQueue<int> NIdQ(Graph->GetNodes()+1);
+  THashSet<typename TNIdType<typename PGraph::TObj>::TNIdT> VisitedNId(Graph->GetNodes()+1);
+  TSnapQueue<TNId> NIdQ(Graph->GetNodes()+1);
   VisitedNId.AddKey(NId);
   NIdQ.Push(NId);
   while (! NIdQ.Empty()) {
     const typename PGraph::TObj::TNodeI Node = Graph->GetNI(NIdQ.Top());  NIdQ.Pop();
     if (HasGraphFlag(typename PGraph::TObj, gfDirected)) {
       for (int e = 0; e < Node.GetInDeg(); e++) {
-        const int InNId = Node.GetInNId(e);
+        const TNId InNId = Node.GetInNId(e);
         if (! VisitedNId.IsKey(InNId)) {
           NIdQ.Push(InNId);  VisitedNId.AddKey(InNId); }
       }
     }
     for (int e = 0; e < Node.GetOutDeg(); e++) {
-      const int OutNId = Node.GetOutNId(e);
+      const TNId OutNId = Node.GetOutNId(e);
       if (! VisitedNId.IsKey(OutNId)) {
         NIdQ.Push(OutNId);  VisitedNId.AddKey(OutNId); }
     }
@@ -274,11 +320,12 @@ bool IsConnected(const PGraph& Graph) {
 
 template <class PGraph>
 bool IsWeaklyConn(const PGraph& Graph) {
+  typedef typename TNIdType<typename PGraph::TObj>::TNId TNId;
   if (Graph->Empty()) {
     return true;
   }
-  THashSet<TInt> VisitedNId(Graph->GetNodes());
-  TSnapQueue<int> NIdQ(Graph->GetNodes()+1);
+  THashSet<typename TNIdType<typename PGraph::TObj>::TNIdT> VisitedNId(Graph->GetNodes());
+  TSnapQueue<TNId> NIdQ(Graph->GetNodes()+1);
   typename PGraph::TObj::TNodeI NI;
   // the rest of the nodes
   NIdQ.Push(Graph->BegNI().GetId());
@@ -286,12 +333,12 @@ bool IsWeaklyConn(const PGraph& Graph) {
     const typename PGraph::TObj::TNodeI Node = Graph->GetNI(NIdQ.Top());  NIdQ.Pop();
     if (HasGraphFlag(typename PGraph::TObj, gfDirected)) {
       for (int e = 0; e < Node.GetInDeg(); e++) {
-        const int InNId = Node.GetInNId(e);
+        const TNId InNId = Node.GetInNId(e);
         if (! VisitedNId.IsKey(InNId)) { NIdQ.Push(InNId);  VisitedNId.AddKey(InNId); }
       }
     }
     for (int e = 0; e < Node.GetOutDeg(); e++) {
-      const int OutNId = Node.GetOutNId(e);
+      const TNId OutNId = Node.GetOutNId(e);
       if (! VisitedNId.IsKey(OutNId)) { NIdQ.Push(OutNId);  VisitedNId.AddKey(OutNId); }
     }
   }
@@ -301,9 +348,10 @@ bool IsWeaklyConn(const PGraph& Graph) {
 
 template <class PGraph>
 void GetWccSzCnt(const PGraph& Graph, TIntPrV& WccSzCnt) {
-  THashSet<TInt> VisitedNId(Graph->GetNodes());
+  typedef typename TNIdType<typename PGraph::TObj>::TNId TNId;
+  THashSet<typename TNIdType<typename PGraph::TObj>::TNIdT> VisitedNId(Graph->GetNodes());
   TIntH SzToCntH;
-  TSnapQueue<int> NIdQ(Graph->GetNodes()+1);
+  TSnapQueue<TNId> NIdQ(Graph->GetNodes()+1);
   typename PGraph::TObj::TNodeI NI;
   int Cnt = 0;
   // zero degree nodes
@@ -321,12 +369,12 @@ void GetWccSzCnt(const PGraph& Graph, TIntPrV& WccSzCnt) {
         const typename PGraph::TObj::TNodeI Node = Graph->GetNI(NIdQ.Top());  NIdQ.Pop();
         if (HasGraphFlag(typename PGraph::TObj, gfDirected)) {
           for (int e = 0; e < Node.GetInDeg(); e++) {
-            const int InNId = Node.GetInNId(e);
+            const TNId InNId = Node.GetInNId(e);
             if (! VisitedNId.IsKey(InNId)) { NIdQ.Push(InNId);  VisitedNId.AddKey(InNId); }
           }
         }
         for (int e = 0; e < Node.GetOutDeg(); e++) {
-          const int OutNId = Node.GetOutNId(e);
+          const TNId OutNId = Node.GetOutNId(e);
           if (! VisitedNId.IsKey(OutNId)) { NIdQ.Push(OutNId);  VisitedNId.AddKey(OutNId); }
         }
         Cnt++;
@@ -339,23 +387,25 @@ void GetWccSzCnt(const PGraph& Graph, TIntPrV& WccSzCnt) {
 }
 
 template <class PGraph>
-void GetWccs(const PGraph& Graph, TCnComV& CnComV) {
+void GetWccs(const PGraph& Graph, TVec<TCnComT<typename TNIdType<typename PGraph::TObj>::TNId> >& CnComV) {
+  typedef typename TNIdType<typename PGraph::TObj>::TNId TNId;
+  typedef typename TNIdType<typename PGraph::TObj>::TNIdT TNIdT;
   typename PGraph::TObj::TNodeI NI;
-  THashSet<TInt> VisitedNId(Graph->GetNodes()+1);
-  TSnapQueue<int> NIdQ(Graph->GetNodes()+1);
-  TIntV CcNIdV;
+  THashSet<TNIdT> VisitedNId(Graph->GetNodes()+1);
+  TSnapQueue<TNId> NIdQ(Graph->GetNodes()+1);
+  TVec<TNIdT> CcNIdV;
   CnComV.Clr();  CcNIdV.Gen(1);
   // zero degree nodes
   for (NI = Graph->BegNI(); NI < Graph->EndNI(); NI++) {
     if (NI.GetDeg() == 0) {
-      const int NId = NI.GetId();
+      const TNId NId = NI.GetId();
       VisitedNId.AddKey(NId);
       CcNIdV[0] = NId;  CnComV.Add(CcNIdV);
     }
   }
   // the rest of the nodes
   for (NI = Graph->BegNI(); NI < Graph->EndNI(); NI++) {
-    const int NId = NI.GetId();
+    const TNId NId = NI.GetId();
     if (! VisitedNId.IsKey(NId)) {
       VisitedNId.AddKey(NId);
       NIdQ.Clr(false);  NIdQ.Push(NId);
@@ -364,19 +414,19 @@ void GetWccs(const PGraph& Graph, TCnComV& CnComV) {
         const typename PGraph::TObj::TNodeI Node = Graph->GetNI(NIdQ.Top());  NIdQ.Pop();
         if (HasGraphFlag(typename PGraph::TObj, gfDirected)) {
           for (int e = 0; e < Node.GetInDeg(); e++) {
-            const int InNId = Node.GetInNId(e);
+            const TNId InNId = Node.GetInNId(e);
             if (! VisitedNId.IsKey(InNId)) {
               NIdQ.Push(InNId);  VisitedNId.AddKey(InNId);  CcNIdV.Add(InNId); }
           }
         }
         for (int e = 0; e < Node.GetOutDeg(); e++) {
-          const int OutNId = Node.GetOutNId(e);
+          const TNId OutNId = Node.GetOutNId(e);
           if (! VisitedNId.IsKey(OutNId)) {
             NIdQ.Push(OutNId);  VisitedNId.AddKey(OutNId);  CcNIdV.Add(OutNId); }
         }
       }
       CcNIdV.Sort(true);
-      CnComV.Add(TCnCom(CcNIdV)); // add wcc comoponent
+      CnComV.Add(TCnComT<TNId>(CcNIdV)); // add wcc comoponent
     }
   }
   CnComV.Sort(false);
@@ -391,27 +441,63 @@ void GetSccSzCnt(const PGraph& Graph, TIntPrV& SccSzCnt) {
 }
 
 template <class PGraph>
-void GetSccs(const PGraph& Graph, TCnComV& CnComV) {
+void GetSccs(const PGraph& Graph, TVec<TCnComT<typename TNIdType<typename PGraph::TObj>::TNId> >& CnComV) {
   TSccVisitor<PGraph, false> Visitor(Graph);
   TCnCom::GetDfsVisitor(Graph, Visitor);
   CnComV = Visitor.CnComV;
   CnComV.Sort(false);
 }
 
+#ifdef USE_OPENMP
+template <class PGraph>
+void GetWccSzCntMP(const PGraph& Graph, TIntPrV& WccSzCnt) {
+  const TCsrGraph Csr(Graph);
+  TIntV CcV;
+  GetWccLabelsMP(Csr, CcV);
+  GetCnComSzCntFromLabels(CcV, WccSzCnt);
+}
+
+template <class PGraph>
+void GetWccsMP(const PGraph& Graph, TCnComV& CnComV) {
+  const TCsrGraph Csr(Graph);
+  TIntV CcV;
+  GetWccLabelsMP(Csr, CcV);
+  GetCnComFromLabels(Csr, CcV, CnComV);
+}
+
+template <class PGraph>
+void GetSccSzCntMP(const PGraph& Graph, TIntPrV& SccSzCnt) {
+  const TCsrGraph Csr(Graph);
+  TIntV CcV;
+  if (Csr.IsDirected()) { GetSccLabelsMP(Csr, CcV); }
+  else { GetWccLabelsMP(Csr, CcV); }
+  GetCnComSzCntFromLabels(CcV, SccSzCnt);
+}
+
+template <class PGraph>
+void GetSccsMP(const PGraph& Graph, TCnComV& CnComV) {
+  const TCsrGraph Csr(Graph);
+  TIntV CcV;
+  if (Csr.IsDirected()) { GetSccLabelsMP(Csr, CcV); }
+  else { GetWccLabelsMP(Csr, CcV); }
+  GetCnComFromLabels(Csr, CcV, CnComV);
+}
+#endif // USE_OPENMP
+
 template <class PGraph> 
 double GetMxWccSz(const PGraph& Graph) {
-  TCnComV CnComV;
-  GetWccs(Graph, CnComV);
+  TIntPrV SzCntV;
+  GetWccSzCnt(Graph, SzCntV);
   if (Graph->GetNodes() == 0) { return 0; }
-  else { return CnComV[0].Len() / double(Graph->GetNodes()); }
+  else { return SzCntV.Last().Val1 / double(Graph->GetNodes()); }
 }
 
 template <class PGraph>
 double GetMxSccSz(const PGraph& Graph) {
-  TCnComV CnComV;
-  GetSccs(Graph, CnComV);
+  TIntPrV SzCntV;
+  GetSccSzCnt(Graph, SzCntV);
   if (Graph->GetNodes() == 0) { return 0; }
-  else { return CnComV[0].Len() / double(Graph->GetNodes()); }
+  else { return SzCntV.Last().Val1 / double(Graph->GetNodes()); }
 }
   
 template <class PGraph>
@@ -431,6 +517,19 @@ PGraph GetMxWcc(const PGraph& Graph) {
   }
 }
 
+template <class PGraph>
+TPt<TGraphView<PGraph> > GetMxWccView(const PGraph& Graph) {
+  TCnComV CnComV;
+  GetWccs(Graph, CnComV);
+  if (CnComV.Empty()) { return TGraphView<PGraph>::New(Graph, TIntV()); }
+  int CcId = 0, MxSz = 0;
+  for (int i = 0; i < CnComV.Len(); i++) {
+    if (MxSz < CnComV[i].Len()) {
+      MxSz=CnComV[i].Len();  CcId=i; }
+  }
+  return TGraphView<PGraph>::New(Graph, CnComV[CcId]());
+}
+
 template <class PGraph>
 PGraph GetMxScc(const PGraph& Graph) {
   TCnComV CnComV;
@@ -13,6 +13,7 @@ PGraph ToGraph(PTable Table, const TStr& SrcCol, const TStr& DstCol, TAttrAggr A
   Assert(NodeType == Table->GetColType(DstCol));
   const TInt SrcColIdx = Table->GetColIdx(SrcCol);
   const TInt DstColIdx = Table->GetColIdx(DstCol);
+  TIntPrV EdgeV;
 
   // make single pass over all rows in the table
   if (NodeType == atInt) {
@@ -24,7 +25,7 @@ PGraph ToGraph(PTable Table, const TStr& SrcCol, const TStr& DstCol, TAttrAggr A
       //Using AddNodeUnchecked ensures that no error is thrown when the same node is seen twice
       Graph->AddNodeUnchecked(SVal);
       Graph->AddNodeUnchecked(DVal);
-      Graph->AddEdgeUnchecked(SVal, DVal);
+      EdgeV.Add(TIntPr(SVal, DVal));
     }
   } else if (NodeType == atFlt) {
     // node values - i.e. the unique values of src/dst col
@@ -38,7 +39,7 @@ PGraph ToGraph(PTable Table, const TStr& SrcCol, const TStr& DstCol, TAttrAggr A
       SVal = Table->CheckAndAddFltNode(Graph, FltNodeVals, FSVal);
       TFlt FDVal = (Table->FltCols)[SrcColIdx][CurrRowIdx];
       DVal = Table->CheckAndAddFltNode(Graph, FltNodeVals, FDVal);
-      Graph->AddEdge(SVal, DVal);
+      EdgeV.Add(TIntPr(SVal, DVal));
     }
   } else {
     for (int CurrRowIdx = 0; CurrRowIdx < (Table->Next).Len(); CurrRowIdx++) {
@@ -51,11 +52,12 @@ PGraph ToGraph(PTable Table, const TStr& SrcCol, const TStr& DstCol, TAttrAggr A
       //Using AddNodeUnchecked ensures that no error is thrown when the same node is seen twice
       Graph->AddNodeUnchecked(SVal);
       Graph->AddNodeUnchecked(DVal);
-      Graph->AddEdgeUnchecked(SVal, DVal);
+      EdgeV.Add(TIntPr(SVal, DVal));
     }
   }
 
-  Graph->SortNodeAdjV();
+  // sorts and deduplicates the adjacency lists once
+  TSnap::AddEdgeBatch(Graph, EdgeV);
   return Graph;
 }
 
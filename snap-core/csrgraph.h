@@ -0,0 +1,102 @@
+//#//////////////////////////////////////////////
+/// Compressed sparse row graph snapshot. ##TCsrGraph
+/// Nodes of the source graph are renumbered to dense indices 0..N-1 and the
+/// adjacency is stored in flat offset/neighbor arrays, so algorithms can walk
+/// the graph without per-node hash lookups. Neighbor entries are node indices,
+/// not node ids; use GetNId() to map them back. The snapshot is read-only.
+class TCsrGraph {
+private:
+  TBool Directed;
+  TIntV NIdV;          // node index -> node id
+  TIntV NIdToIdxV;     // node id -> node index, -1 for non-existing ids
+  TIntV OutOffV;       // out-neighbors of node i are OutNbrV[OutOffV[i]..OutOffV[i+1])
+  TIntV OutNbrV;
+  TIntV InOffV;        // in-neighbors, only built for directed graphs
+  TIntV InNbrV;
+public:
+  TCsrGraph() : Directed(false), NIdV(), NIdToIdxV(), OutOffV(), OutNbrV(), InOffV(), InNbrV() { }
+  /// Builds the snapshot of Graph. In-edges of directed graphs are only stored if WithIn is true.
+  template <class PGraph> TCsrGraph(const PGraph& Graph, const bool& WithIn=true) { Build(Graph, WithIn); }
+  /// Rebuilds the snapshot from Graph.
+  template <class PGraph> void Build(const PGraph& Graph, const bool& WithIn=true);
+
+  /// Returns true if the snapshot was taken from a directed graph.
+  bool IsDirected() const { return Directed; }
+  /// Returns true if in-edges are available (always true for undirected graphs).
+  bool HasIn() const { return ! Directed || ! InOffV.Empty(); }
+  /// Returns the number of nodes.
+  int GetNodes() const { return NIdV.Len(); }
+  /// Returns the number of stored out-edges (each undirected edge is stored twice, self-loops once).
+  int GetOutEdges() const { return OutNbrV.Len(); }
+  /// Returns the number of stored in-edges.
+  int GetInEdges() const { return Directed ? InNbrV.Len() : OutNbrV.Len(); }
+  /// Returns the node id of the node with index NIdx.
+  int GetNId(const int& NIdx) const { return NIdV[NIdx]; }
+  /// Returns the index of node NId or -1 if NId is not a node.
+  int GetNIdx(const int& NId) const { return NId >= 0 && NId < NIdToIdxV.Len() ? NIdToIdxV[NId].Val : -1; }
+  /// Returns the vector of node ids indexed by node index.
+  const TIntV& GetNIdV() const { return NIdV; }
+
+  int GetOutDeg(const int& NIdx) const { return OutOffV[NIdx+1] - OutOffV[NIdx]; }
+  /// Returns the index of the e-th out-neighbor of node with index NIdx.
+  int GetOutNbr(const int& NIdx, const int& e) const { return OutNbrV[OutOffV[NIdx]+e]; }
+  /// Returns a pointer to the first out-neighbor of node with index NIdx.
+  const TInt* BegOut(const int& NIdx) const { return OutNbrV.BegI() + OutOffV[NIdx]; }
+  const TInt* EndOut(const int& NIdx) const { return OutNbrV.BegI() + OutOffV[NIdx+1]; }
+  int GetInDeg(const int& NIdx) const { return Directed ? InOffV[NIdx+1] - InOffV[NIdx] : GetOutDeg(NIdx); }
+  /// Returns the index of the e-th in-neighbor of node with index NIdx.
+  int GetInNbr(const int& NIdx, const int& e) const { return Directed ? InNbrV[InOffV[NIdx]+e].Val : GetOutNbr(NIdx, e); }
+  const TInt* BegIn(const int& NIdx) const { return Directed ? InNbrV.BegI() + InOffV[NIdx] : BegOut(NIdx); }
+  const TInt* EndIn(const int& NIdx) const { return Directed ? InNbrV.BegI() + InOffV[NIdx+1] : EndOut(NIdx); }
+  /// Returns the position of the first out-edge of node NIdx in the flat edge arrays.
+  int GetOutOff(const int& NIdx) const { return OutOffV[NIdx]; }
+  /// Returns the position of the first in-edge of node NIdx in the flat edge arrays.
+  int GetInOff(const int& NIdx) const { return Directed ? InOffV[NIdx].Val : OutOffV[NIdx].Val; }
+
+  void Clr() { Directed = false; NIdV.Clr(); NIdToIdxV.Clr(); OutOffV.Clr(); OutNbrV.Clr(); InOffV.Clr(); InNbrV.Clr(); }
+  /// Returns the approximate memory footprint of the snapshot in bytes.
+  int64 GetMemUsed() const {
+    return sizeof(TCsrGraph) + int64(NIdV.Reserved() + NIdToIdxV.Reserved() + OutOffV.Reserved() +
+      OutNbrV.Reserved() + InOffV.Reserved() + InNbrV.Reserved()) * sizeof(TInt); }
+};
+
+template <class PGraph>
+void TCsrGraph::Build(const PGraph& Graph, const bool& WithIn) {
+  Clr();
+  Directed = HasGraphFlag(typename PGraph::TObj, gfDirected);
+  const int Nodes = Graph->GetNodes();
+  NIdV.Gen(Nodes, 0);
+  for (typename PGraph::TObj::TNodeI NI = Graph->BegNI(); NI < Graph->EndNI(); NI++) {
+    NIdV.Add(NI.GetId()); }
+  NIdToIdxV.Gen(Graph->GetMxNId());
+  NIdToIdxV.PutAll(-1);
+  for (int i = 0; i < Nodes; i++) { NIdToIdxV[NIdV[i]] = i; }
+  // degrees, then prefix sums
+  OutOffV.Gen(Nodes+1);
+  const bool DoIn = Directed && WithIn;
+  if (DoIn) { InOffV.Gen(Nodes+1); }
+  #pragma omp parallel for schedule(dynamic,10000)
+  for (int i = 0; i < Nodes; i++) {
+    const typename PGraph::TObj::TNodeI NI = Graph->GetNI(NIdV[i]);
+    OutOffV[i+1] = NI.GetOutDeg();
+    if (DoIn) { InOffV[i+1] = NI.GetInDeg(); }
+  }
+  for (int i = 0; i < Nodes; i++) { OutOffV[i+1] += OutOffV[i]; }
+  OutNbrV.Gen(OutOffV[Nodes]);
+  if (DoIn) {
+    for (int i = 0; i < Nodes; i++) { InOffV[i+1] += InOffV[i]; }
+    InNbrV.Gen(InOffV[Nodes]);
+  }
+  #pragma omp parallel for schedule(dynamic,10000)
+  for (int i = 0; i < Nodes; i++) {
+    const typename PGraph::TObj::TNodeI NI = Graph->GetNI(NIdV[i]);
+    const int OutOff = OutOffV[i];
+    for (int e = 0; e < NI.GetOutDeg(); e++) {
+      OutNbrV[OutOff+e] = NIdToIdxV[NI.GetOutNId(e)]; }
+    if (DoIn) {
+      const int InOff = InOffV[i];
+      for (int e = 0; e < NI.GetInDeg(); e++) {
+        InNbrV[InOff+e] = NIdToIdxV[NI.GetInNId(e)]; }
+    }
+  }
+}
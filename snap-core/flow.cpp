@@ -1,7 +1,7 @@
 namespace TSnap {
 
 // Returns the NId where the two directions of search meet up, or -1 if no augmenting path exists. ##TSnap::IntFlowBiDBFS
-int IntFlowBiDBFS (const PNEANet &Net, const int& CapIndex, TIntV &Flow, TIntQ &FwdNodeQ, TIntH &PredEdgeH, TIntQ &BwdNodeQ, TIntH &SuccEdgeH, const int& SrcNId, const int& SnkNId) {
+int IntFlowBiDBFS (const PNEANet &Net, const TNEANet::TIntAttrCol& CapCol, TIntV &Flow, TIntQ &FwdNodeQ, TIntH &PredEdgeH, TIntQ &BwdNodeQ, TIntH &SuccEdgeH, const int& SrcNId, const int& SnkNId) {
   FwdNodeQ.Push(SrcNId);
   PredEdgeH.AddDat(SrcNId, -1);
   BwdNodeQ.Push(SnkNId);
@@ -25,7 +25,7 @@ int IntFlowBiDBFS (const PNEANet &Net, const int& CapIndex, TIntV &Flow, TIntQ &
     for (int EdgeN = 0; EdgeN < FwdNI.GetOutDeg(); EdgeN++) {
       int NextNId = FwdNI.GetOutNId(EdgeN);
       int NextEId = FwdNI.GetOutEId(EdgeN);
-      if (!PredEdgeH.IsKey(NextNId) && Net->GetIntAttrIndDatE(NextEId, CapIndex) > Flow[NextEId]) {
+      if (!PredEdgeH.IsKey(NextNId) && CapCol.GetDat(NextEId) > Flow[NextEId]) {
         PredEdgeH.AddDat(NextNId, NextEId);
         if (SuccEdgeH.IsKey(NextNId)) {
           return NextNId;
@@ -51,7 +51,7 @@ int IntFlowBiDBFS (const PNEANet &Net, const int& CapIndex, TIntV &Flow, TIntQ &
     for (int EdgeN = 0; EdgeN < BwdNI.GetInDeg(); EdgeN++) {
       int PrevNId = BwdNI.GetInNId(EdgeN);
       int PrevEId = BwdNI.GetInEId(EdgeN);
-      if (!SuccEdgeH.IsKey(PrevNId) && Net->GetIntAttrIndDatE(PrevEId, CapIndex) > Flow[PrevEId]) {
+      if (!SuccEdgeH.IsKey(PrevNId) && CapCol.GetDat(PrevEId) > Flow[PrevEId]) {
         SuccEdgeH.AddDat(PrevNId, PrevEId);
         if (PredEdgeH.IsKey(PrevNId)) {
           return PrevNId;
@@ -64,8 +64,8 @@ int IntFlowBiDBFS (const PNEANet &Net, const int& CapIndex, TIntV &Flow, TIntQ &
 }
 
 /// Returns the amount the flow can be augmented over the paths, 0 if no path can be found. ##TSnap::FindAugV
-int FindAugV (const PNEANet &Net, const int& CapIndex, TIntV &Flow, TIntQ &FwdNodeQ, TIntH &PredEdgeH, TIntQ &BwdNodeQ, TIntH &SuccEdgeH, TIntV &MidToSrcAugV, TIntV &MidToSnkAugV, const int& SrcNId, const int& SnkNId) {
-  int MidPtNId = IntFlowBiDBFS(Net, CapIndex, Flow, FwdNodeQ, PredEdgeH, BwdNodeQ, SuccEdgeH, SrcNId, SnkNId);
+int FindAugV (const PNEANet &Net, const TNEANet::TIntAttrCol& CapCol, TIntV &Flow, TIntQ &FwdNodeQ, TIntH &PredEdgeH, TIntQ &BwdNodeQ, TIntH &SuccEdgeH, TIntV &MidToSrcAugV, TIntV &MidToSnkAugV, const int& SrcNId, const int& SnkNId) {
+  int MidPtNId = IntFlowBiDBFS(Net, CapCol, Flow, FwdNodeQ, PredEdgeH, BwdNodeQ, SuccEdgeH, SrcNId, SnkNId);
   if (MidPtNId == -1) { return 0; }
   int MinAug = TInt::Mx, NId = MidPtNId, AugFlow = 0;
   // Build the path from the midpoint back to the source by tracing through the PredEdgeH
@@ -77,7 +77,7 @@ int FindAugV (const PNEANet &Net, const int& CapIndex, TIntV &Flow, TIntQ &FwdNo
       AugFlow = Flow[EId];
     } else {
       NId = EI.GetSrcNId();
-      AugFlow = Net->GetIntAttrIndDatE(EId, CapIndex) - Flow[EId];
+      AugFlow = CapCol.GetDat(EId) - Flow[EId];
     }
     if (AugFlow < MinAug) { MinAug = AugFlow; }
   }
@@ -91,7 +91,7 @@ int FindAugV (const PNEANet &Net, const int& CapIndex, TIntV &Flow, TIntQ &FwdNo
       AugFlow = Flow[EId];
     } else {
       NId = EI.GetDstNId();
-      AugFlow = Net->GetIntAttrIndDatE(EId, CapIndex) - Flow[EId];
+      AugFlow = CapCol.GetDat(EId) - Flow[EId];
     }
     if (AugFlow < MinAug) { MinAug = AugFlow; }
   }
@@ -102,11 +102,11 @@ int GetMaxFlowIntEK (PNEANet &Net, const int &SrcNId, const int &SnkNId) {
   IAssert(Net->IsNode(SrcNId));
   IAssert(Net->IsNode(SnkNId));
   if (SrcNId == SnkNId) { return 0; }
-  int CapIndex = Net->GetIntAttrIndE(CapAttrName);
+  const TNEANet::TIntAttrCol CapCol = Net->GetIntAttrColE(CapAttrName);
   TIntV Flow(Net->GetMxEId());
   // Initialize flow values to 0, and make sure capacities are nonnegative
   for (TNEANet::TEdgeI EI = Net->BegEI(); EI != Net->EndEI(); EI++) {
-    IAssert(Net->GetIntAttrIndDatE(EI, CapIndex) >= 0);
+    IAssert(CapCol[EI.GetKeyId()] >= 0);
     Flow[EI.GetId()] = 0;
   }
   // Return 0 if user attempts to flow from a node to itself.
@@ -116,7 +116,7 @@ int GetMaxFlowIntEK (PNEANet &Net, const int &SrcNId, const int &SnkNId) {
     TIntV MidToSrcAugV; TIntV MidToSnkAugV;
     TIntQ FwdNodeQ; TIntQ BwdNodeQ;
     TIntH PredEdgeH; TIntH SuccEdgeH;
-    MinAug = FindAugV(Net, CapIndex, Flow, FwdNodeQ, PredEdgeH, BwdNodeQ, SuccEdgeH, MidToSrcAugV, MidToSnkAugV, SrcNId, SnkNId);
+    MinAug = FindAugV(Net, CapCol, Flow, FwdNodeQ, PredEdgeH, BwdNodeQ, SuccEdgeH, MidToSrcAugV, MidToSnkAugV, SrcNId, SnkNId);
     if (MinAug == 0) { break; }
     MaxFlow += MinAug;
     CurNId = SrcNId;
@@ -150,8 +150,7 @@ int GetMaxFlowIntEK (PNEANet &Net, const int &SrcNId, const int &SnkNId) {
 /// Push relabel attr manager. ##PR_Manager
 class TPRManager {
 public:
-  TPRManager(PNEANet &Net) : Net(Net), CapIndex(0), FlowV(Net->GetMxEId()), ExcessV(Net->GetMxNId()), EdgeNumsV(Net->GetMxNId()), LabelsV(Net->GetMxNId()), LabelCounts(Net->GetNodes() + 1), LabelLimit(0), MaxLabel(Net->GetNodes()), ActiveNodeSet(Net->GetMxNId()), ActiveCount(0) {
-    CapIndex = Net->GetIntAttrIndE(CapAttrName);
+  TPRManager(PNEANet &Net) : Net(Net), CapCol(Net->GetIntAttrColE(CapAttrName)), FlowV(Net->GetMxEId()), ExcessV(Net->GetMxNId()), EdgeNumsV(Net->GetMxNId()), LabelsV(Net->GetMxNId()), LabelCounts(Net->GetNodes() + 1), LabelLimit(0), MaxLabel(Net->GetNodes()), ActiveNodeSet(Net->GetMxNId()), ActiveCount(0) {
     for (int i = 0; i <= Net->GetNodes(); i++) { LabelCounts[i] = 0; }
     for (TNEANet::TEdgeI EI = Net->BegEI(); EI != Net->EndEI(); EI++) {
       int EId = EI.GetId();
@@ -168,7 +167,7 @@ public:
   }
 
   int Capacity (int EId) {
-    return Net->GetIntAttrIndDatE(EId, CapIndex);
+    return CapCol.GetDat(EId);
   }
 
   int &Flow (int EId) {
@@ -249,7 +248,7 @@ public:
 
 private:
   PNEANet &Net;
-  int CapIndex;
+  TNEANet::TIntAttrCol CapCol;
   TIntV FlowV;
 
   TIntV ExcessV;
@@ -425,4 +424,320 @@ int GetMaxFlowIntPR (PNEANet &Net, const int& SrcNId, const int& SnkNId) {
 }
 
 
+};
+
+/////////////////////////////////////////////////
+// Flattened residual network
+TFlowNet::TFlowNet(const PNEANet& Net, const TStr& CapAttr) : SrcNIdx(-1), SnkNIdx(-1) {
+  const TNEANet::TIntAttrCol CapCol = Net->GetIntAttrColE(CapAttr);
+  const int Nodes = Net->GetNodes();
+  NIdV.Gen(Nodes, 0);
+  for (TNEANet::TNodeI NI = Net->BegNI(); NI < Net->EndNI(); NI++) { NIdV.Add(NI.GetId()); }
+  NIdToIdxV.Gen(Net->GetMxNId());
+  NIdToIdxV.PutAll(-1);
+  for (int i = 0; i < Nodes; i++) { NIdToIdxV[NIdV[i]] = i; }
+  // arcs of a node: forward arcs of its out-edges, then reverse arcs of its in-edges; self-loops carry no flow
+  ArcOffV.Gen(Nodes+1);
+  #pragma omp parallel for schedule(dynamic,10000)
+  for (int i = 0; i < Nodes; i++) {
+    const TNEANet::TNodeI NI = Net->GetNI(NIdV[i]);
+    int Arcs = 0;
+    for (int e = 0; e < NI.GetOutDeg(); e++) { if (NI.GetOutNId(e) != NI.GetId()) { Arcs++; } }
+    for (int e = 0; e < NI.GetInDeg(); e++) { if (NI.GetInNId(e) != NI.GetId()) { Arcs++; } }
+    ArcOffV[i+1] = Arcs;
+  }
+  for (int i = 0; i < Nodes; i++) { ArcOffV[i+1] += ArcOffV[i]; }
+  const int Arcs = ArcOffV[Nodes];
+  HeadV.Gen(Arcs);  RevV.Gen(Arcs);  CapV.Gen(Arcs);  EIdV.Gen(Arcs);  ResCapV.Gen(Arcs);
+  TIntV InArcOffV(Nodes); // position of the first reverse arc of a node
+  TIntV FwdArcV(Net->GetMxEId()); // edge id -> position of its forward arc
+  #pragma omp parallel for schedule(dynamic,10000)
+  for (int i = 0; i < Nodes; i++) {
+    const TNEANet::TNodeI NI = Net->GetNI(NIdV[i]);
+    int Arc = ArcOffV[i];
+    for (int e = 0; e < NI.GetOutDeg(); e++) {
+      if (NI.GetOutNId(e) == NI.GetId()) { continue; }
+      const int EId = NI.GetOutEId(e);
+      HeadV[Arc] = NIdToIdxV[NI.GetOutNId(e)];
+      CapV[Arc] = CapCol.GetDat(EId);
+      EIdV[Arc] = EId;
+      FwdArcV[EId] = Arc++;
+    }
+    InArcOffV[i] = Arc;
+  }
+  for (int a = 0; a < Arcs; a++) {
+    IAssertR(EIdV[a] == -1 || CapV[a] >= 0, "Capacities must be non-negative"); }
+  #pragma omp parallel for schedule(dynamic,10000)
+  for (int i = 0; i < Nodes; i++) {
+    const TNEANet::TNodeI NI = Net->GetNI(NIdV[i]);
+    int Arc = InArcOffV[i];
+    for (int e = 0; e < NI.GetInDeg(); e++) {
+      if (NI.GetInNId(e) == NI.GetId()) { continue; }
+      const int FwdArc = FwdArcV[NI.GetInEId(e)];
+      HeadV[Arc] = NIdToIdxV[NI.GetInNId(e)];
+      CapV[Arc] = 0;
+      EIdV[Arc] = -1;
+      RevV[Arc] = FwdArc;
+      RevV[FwdArc] = Arc++;
+    }
+  }
+  ExcessV.Gen(Nodes);
+  LabelV.Gen(Nodes);
+}
+
+void TFlowNet::InitPreflow(const int& SrcNId, const int& SnkNId) {
+  SrcNIdx = SrcNId >= 0 && SrcNId < NIdToIdxV.Len() ? NIdToIdxV[SrcNId].Val : -1;
+  SnkNIdx = SnkNId >= 0 && SnkNId < NIdToIdxV.Len() ? NIdToIdxV[SnkNId].Val : -1;
+  IAssertR(SrcNIdx != -1 && SnkNIdx != -1, "Source and sink must be nodes of the network");
+  #pragma omp parallel for schedule(static)
+  for (int a = 0; a < ResCapV.Len(); a++) { ResCapV[a] = CapV[a]; }
+  #pragma omp parallel for schedule(static)
+  for (int i = 0; i < ExcessV.Len(); i++) { ExcessV[i] = 0;  LabelV[i] = 0; }
+  if (SrcNIdx == SnkNIdx) { return; }
+  for (int a = ArcOffV[SrcNIdx]; a < ArcOffV[SrcNIdx+1]; a++) {
+    const int Delta = ResCapV[a];
+    ResCapV[a] = 0;  ResCapV[RevV[a]] += Delta;
+    ExcessV[HeadV[a]] += Delta;
+  }
+}
+
+void TFlowNet::GlobalRelabel() {
+  const int Nodes = GetNodes();
+  TIntV QueueV(Nodes, 0);
+  LabelV.PutAll(Nodes);
+  LabelV[SnkNIdx] = 0;
+  QueueV.Add(SnkNIdx);
+  for (int q = 0; q < QueueV.Len(); q++) {
+    // backward search: U gets a label if its arc to V still has residual capacity
+    const int V = QueueV[q];
+    for (int a = ArcOffV[V]; a < ArcOffV[V+1]; a++) {
+      const int U = HeadV[a];
+      if (LabelV[U] == Nodes && U != SrcNIdx && ResCapV[RevV[a]] > 0) {
+        LabelV[U] = LabelV[V] + 1;  QueueV.Add(U); }
+    }
+  }
+}
+
+#ifdef USE_OPENMP
+void TFlowNet::GlobalRelabelMP() {
+  const int Nodes = GetNodes();
+  TIntV Vec1(Nodes, 0), Vec2(Nodes, 0);
+  TIntV* PCurV = &Vec1;
+  TIntV* PNextV = &Vec2;
+  #pragma omp parallel for schedule(static)
+  for (int i = 0; i < Nodes; i++) { LabelV[i] = Nodes; }
+  LabelV[SnkNIdx] = 0;
+  PCurV->Add(SnkNIdx);
+  for (int Level = 1; ! PCurV->Empty(); Level++) {
+    #pragma omp parallel for schedule(dynamic,1000)
+    for (int k = 0; k < PCurV->Len(); k++) {
+      const int V = (*PCurV)[k];
+      for (int a = ArcOffV[V]; a < ArcOffV[V+1]; a++) {
+        const int U = HeadV[a];
+        if (LabelV[U] == Nodes && U != SrcNIdx && ResCapV[RevV[a]] > 0 &&
+         __sync_bool_compare_and_swap(&LabelV[U].Val, Nodes, Level)) { PNextV->AddMP(U); }
+      }
+    }
+    TIntV* Tmp = PCurV;  PCurV = PNextV;  PNextV = Tmp;
+    PNextV->Reduce(0);
+  }
+}
+#endif // USE_OPENMP
+
+// A. V. Goldberg, R. E. Tarjan: A new approach to the maximum-flow problem, J. ACM 1988.
+// FIFO selection with current arcs, periodic global relabeling and the gap heuristic.
+int TFlowNet::GetMaxFlow(const int& SrcNId, const int& SnkNId) {
+  InitPreflow(SrcNId, SnkNId);
+  if (SrcNIdx == SnkNIdx) { return 0; }
+  const int Nodes = GetNodes();
+  const int GRWork = 6*Nodes + ResCapV.Len(); // relabel work between two global relabels
+  TIntV CurArcV(Nodes), LabelCntV(Nodes+1);
+  TBoolV InQueueV(Nodes);
+  TIntQ ActiveQ;
+  int Work = GRWork;
+  while (true) {
+    if (Work >= GRWork) {
+      // exact labels, restart from the current active nodes
+      GlobalRelabel();
+      Work = 0;
+      LabelCntV.PutAll(0);
+      ActiveQ.Clr(false);
+      for (int i = 0; i < Nodes; i++) {
+        CurArcV[i] = ArcOffV[i];
+        LabelCntV[LabelV[i]]++;
+        InQueueV[i] = ExcessV[i] > 0 && LabelV[i] < Nodes && i != SrcNIdx && i != SnkNIdx;
+        if (InQueueV[i]) { ActiveQ.Push(i); }
+      }
+    }
+    if (ActiveQ.Empty()) { break; }
+    const int U = ActiveQ.Top();  ActiveQ.Pop();
+    InQueueV[U] = false;
+    // discharge U
+    while (ExcessV[U] > 0 && LabelV[U] < Nodes) {
+      if (CurArcV[U] == ArcOffV[U+1]) {
+        // relabel
+        const int OldLabel = LabelV[U];
+        int NewLabel = Nodes;
+        for (int a = ArcOffV[U]; a < ArcOffV[U+1]; a++) {
+          if (ResCapV[a] > 0) { NewLabel = TMath::Mn(NewLabel, LabelV[HeadV[a]]+1); }
+        }
+        NewLabel = TMath::Mn(NewLabel, Nodes);
+        Work += ArcOffV[U+1] - ArcOffV[U] + 12;
+        LabelCntV[OldLabel]--;  LabelCntV[NewLabel]++;
+        LabelV[U] = NewLabel;
+        CurArcV[U] = ArcOffV[U];
+        if (LabelCntV[OldLabel] == 0 && OldLabel < Nodes) {
+          // gap: nodes above the empty label can no longer reach the sink
+          for (int i = 0; i < Nodes; i++) {
+            if (LabelV[i] > OldLabel && LabelV[i] < Nodes) {
+              LabelCntV[LabelV[i]]--;  LabelCntV[Nodes]++;  LabelV[i] = Nodes; }
+          }
+        }
+        continue;
+      }
+      const int a = CurArcV[U];
+      const int V = HeadV[a];
+      if (ResCapV[a] > 0 && LabelV[U] == LabelV[V]+1) {
+        const int Delta = TMath::Mn(ExcessV[U].Val, ResCapV[a].Val);
+        ResCapV[a] -= Delta;  ResCapV[RevV[a]] += Delta;
+        ExcessV[U] -= Delta;  ExcessV[V] += Delta;
+        if (! InQueueV[V] && V != SnkNIdx) { InQueueV[V] = true;  ActiveQ.Push(V); }
+        if (ResCapV[a] == 0) { CurArcV[U]++; }
+      } else {
+        CurArcV[U]++;
+      }
+    }
+  }
+  return ExcessV[SnkNIdx];
+}
+
+#ifdef USE_OPENMP
+// Synchronous parallel push-relabel, after N. Baumstark, G. Blelloch, J. Shun:
+// Efficient Implementation of a Synchronous Parallel Push-Relabel Algorithm, ESA 2015.
+// Every round pushes from all active nodes along admissible arcs with labels
+// fixed, then relabels the nodes that kept excess. An admissible arc leads one
+// label down, so the two arcs of a pair are never pushed on in the same round
+// and residual capacities need no locks; only incoming excess is added atomically.
+int TFlowNet::GetMaxFlowMP(const int& SrcNId, const int& SnkNId) {
+  InitPreflow(SrcNId, SnkNId);
+  if (SrcNIdx == SnkNIdx) { return 0; }
+  const int Nodes = GetNodes();
+  const int GRWork = 6*Nodes + ResCapV.Len();
+  TIntV AddedExcessV(Nodes), NewLabelV(Nodes), InNextV(Nodes);
+  TIntV Vec1(Nodes, 0), Vec2(Nodes, 0);
+  TIntV* PCurV = &Vec1;
+  TIntV* PNextV = &Vec2;
+  int64 Work = GRWork;
+  while (true) {
+    if (Work >= GRWork) {
+      // exact labels also remove all gaps: nodes that cannot reach the sink get label N
+      GlobalRelabelMP();
+      Work = 0;
+      PCurV->Reduce(0);
+      #pragma omp parallel for schedule(dynamic,10000)
+      for (int i = 0; i < Nodes; i++) {
+        if (ExcessV[i] > 0 && LabelV[i] < Nodes && i != SrcNIdx && i != SnkNIdx) { PCurV->AddMP(i); }
+      }
+    }
+    if (PCurV->Empty()) { break; }
+    // push
+    #pragma omp parallel for schedule(dynamic,100)
+    for (int k = 0; k < PCurV->Len(); k++) {
+      const int U = (*PCurV)[k];
+      const int LabelU = LabelV[U];
+      int Excess = ExcessV[U];
+      for (int a = ArcOffV[U]; a < ArcOffV[U+1] && Excess > 0; a++) {
+        const int V = HeadV[a];
+        if (ResCapV[a] == 0 || LabelU != LabelV[V]+1) { continue; }
+        const int Delta = TMath::Mn(Excess, ResCapV[a].Val);
+        ResCapV[a] -= Delta;  ResCapV[RevV[a]] += Delta;
+        Excess -= Delta;
+        __sync_fetch_and_add(&AddedExcessV[V].Val, Delta);
+        if (V != SnkNIdx && __sync_bool_compare_and_swap(&InNextV[V].Val, 0, 1)) { PNextV->AddMP(V); }
+      }
+      ExcessV[U] = Excess;
+    }
+    // relabel, labels of the neighbors only grow so the new labels stay valid
+    int64 RoundWork = 0;
+    #pragma omp parallel for schedule(dynamic,100) reduction(+:RoundWork)
+    for (int k = 0; k < PCurV->Len(); k++) {
+      const int U = (*PCurV)[k];
+      NewLabelV[U] = LabelV[U];
+      if (ExcessV[U] == 0) { continue; }
+      int NewLabel = Nodes;
+      for (int a = ArcOffV[U]; a < ArcOffV[U+1]; a++) {
+        if (ResCapV[a] > 0) { NewLabel = TMath::Mn(NewLabel, LabelV[HeadV[a]]+1); }
+      }
+      NewLabelV[U] = TMath::Mn(NewLabel, Nodes);
+      RoundWork += ArcOffV[U+1] - ArcOffV[U] + 12;
+      if (NewLabelV[U] < Nodes && __sync_bool_compare_and_swap(&InNextV[U].Val, 0, 1)) { PNextV->AddMP(U); }
+    }
+    Work += RoundWork;
+    #pragma omp parallel for schedule(static)
+    for (int k = 0; k < PCurV->Len(); k++) { LabelV[(*PCurV)[k]] = NewLabelV[(*PCurV)[k]]; }
+    // apply incoming excess, the sink is not in the next frontier
+    #pragma omp parallel for schedule(static)
+    for (int k = 0; k < PNextV->Len(); k++) {
+      const int V = (*PNextV)[k];
+      ExcessV[V] += AddedExcessV[V];  AddedExcessV[V] = 0;  InNextV[V] = 0;
+    }
+    ExcessV[SnkNIdx] += AddedExcessV[SnkNIdx];  AddedExcessV[SnkNIdx] = 0;
+    // the source and nodes that can no longer reach the sink stay inactive
+    PCurV->Reduce(0);
+    for (int k = 0; k < PNextV->Len(); k++) {
+      const int V = (*PNextV)[k];
+      if (V != SrcNIdx && LabelV[V] < Nodes && ExcessV[V] > 0) { PCurV->Add(V); }
+    }
+    PNextV->Reduce(0);
+  }
+  return ExcessV[SnkNIdx];
+}
+#endif // USE_OPENMP
+
+void TFlowNet::GetMinCut(TIntV& SrcSideNIdV, TIntV& CutEIdV) const {
+  IAssertR(SnkNIdx != -1, "No max-flow query has been run");
+  const int Nodes = GetNodes();
+  // the sink side are the nodes that can still reach the sink in the residual network
+  TBoolV SnkSideV(Nodes);
+  TIntV QueueV(Nodes, 0);
+  SnkSideV[SnkNIdx] = true;
+  QueueV.Add(SnkNIdx);
+  for (int q = 0; q < QueueV.Len(); q++) {
+    const int V = QueueV[q];
+    for (int a = ArcOffV[V]; a < ArcOffV[V+1]; a++) {
+      const int U = HeadV[a];
+      if (! SnkSideV[U] && ResCapV[RevV[a]] > 0) { SnkSideV[U] = true;  QueueV.Add(U); }
+    }
+  }
+  SrcSideNIdV.Clr();  CutEIdV.Clr();
+  for (int U = 0; U < Nodes; U++) {
+    if (SnkSideV[U]) { continue; }
+    SrcSideNIdV.Add(NIdV[U]);
+    for (int a = ArcOffV[U]; a < ArcOffV[U+1]; a++) {
+      if (EIdV[a] != -1 && SnkSideV[HeadV[a]]) { CutEIdV.Add(EIdV[a]); }
+    }
+  }
+}
+
+namespace TSnap {
+
+#ifdef USE_OPENMP
+int GetMaxFlowIntPRMP (PNEANet &Net, const int &SrcNId, const int &SnkNId) {
+  IAssert(Net->IsNode(SrcNId));
+  IAssert(Net->IsNode(SnkNId));
+  if (SrcNId == SnkNId) { return 0; }
+  TFlowNet FlowNet(Net);
+  return FlowNet.GetMaxFlowMP(SrcNId, SnkNId);
+}
+#endif
+
+int GetMinCutInt (PNEANet &Net, const int &SrcNId, const int &SnkNId, TIntV &SrcSideNIdV, TIntV &CutEIdV) {
+  IAssert(Net->IsNode(SrcNId));
+  IAssert(Net->IsNode(SnkNId));
+  TFlowNet FlowNet(Net);
+  const int Flow = FlowNet.GetMaxFlow(SrcNId, SnkNId);
+  FlowNet.GetMinCut(SrcSideNIdV, CutEIdV);
+  return Flow;
+}
+
 };
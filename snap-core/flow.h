@@ -9,3 +9,57 @@ int GetMaxFlowIntEK (PNEANet &Net, const int &SrcNId, const int &SnkNId);
 int GetMaxFlowIntPR (PNEANet &Net, const int &SrcNId, const int &SnkNId);
 
 };
+
+//#//////////////////////////////////////////////
+/// Flattened residual network for repeated max-flow/min-cut queries. ##TFlowNet
+/// The capacity network is copied once into a residual CSR in which every edge
+/// is stored as a forward arc and a paired reverse arc, so push and relabel
+/// operations touch contiguous arrays instead of attribute hashes. Any number of
+/// s-t queries can then be run; each query resets the residual capacities.
+/// Both solvers compute a maximum preflow (push-relabel with global relabeling
+/// and the gap heuristic), which gives the flow value and the minimum cut.
+class TFlowNet {
+private:
+  TIntV NIdV;          // node index -> node id
+  TIntV NIdToIdxV;     // node id -> node index
+  TIntV ArcOffV;       // arcs of node i are ArcOffV[i]..ArcOffV[i+1]
+  TIntV HeadV;         // head node index of an arc
+  TIntV RevV;          // position of the paired reverse arc
+  TIntV CapV;          // original capacity of an arc, 0 for reverse arcs
+  TIntV EIdV;          // edge id of a forward arc, -1 for reverse arcs
+  TIntV ResCapV;       // residual capacity of an arc
+  TIntV ExcessV;
+  TIntV LabelV;
+  TInt SrcNIdx, SnkNIdx;
+private:
+  void InitPreflow(const int& SrcNId, const int& SnkNId);
+  // exact distance labels to the sink in the residual network, unreachable nodes get label N
+  void GlobalRelabel();
+#ifdef USE_OPENMP
+  void GlobalRelabelMP();
+#endif
+public:
+  /// Builds the residual network from the integer edge attribute CapAttr of Net (TSnap::CapAttrName by default).
+  TFlowNet(const PNEANet& Net, const TStr& CapAttr=TSnap::CapAttrName);
+
+  int GetNodes() const { return NIdV.Len(); }
+  /// Returns the maximum flow value from SrcNId to SnkNId (sequential FIFO push-relabel). ##TFlowNet::GetMaxFlow
+  int GetMaxFlow(const int& SrcNId, const int& SnkNId);
+#ifdef USE_OPENMP
+  /// Returns the maximum flow value from SrcNId to SnkNId (parallel lock-free push-relabel). ##TFlowNet::GetMaxFlowMP
+  int GetMaxFlowMP(const int& SrcNId, const int& SnkNId);
+#endif
+  /// Returns the minimum cut of the last query: nodes on the source side and ids of the saturated edges leaving it.
+  void GetMinCut(TIntV& SrcSideNIdV, TIntV& CutEIdV) const;
+};
+
+namespace TSnap {
+
+#ifdef USE_OPENMP
+/// Returns the maximum integer valued flow in the network \c Net from source \c SrcNId to sink \c SnkNId. Parallel version. ##TSnap::GetMaxFlowIntPRMP
+int GetMaxFlowIntPRMP (PNEANet &Net, const int &SrcNId, const int &SnkNId);
+#endif
+/// Returns the maximum flow value and the minimum cut between \c SrcNId and \c SnkNId: source side nodes and the cut edge ids. ##TSnap::GetMinCutInt
+int GetMinCutInt (PNEANet &Net, const int &SrcNId, const int &SnkNId, TIntV &SrcSideNIdV, TIntV &CutEIdV);
+
+};
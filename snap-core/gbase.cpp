@@ -56,4 +56,17 @@ void TUnionFind::Dump() {
     printf("  %d\t%d\n", int(KIdSetH.GetKey(i)), Find(KIdSetH.GetKey(i)));
   }
   printf("\n");
-}
\ No newline at end of file
+}
+
+#ifdef USE_OPENMP
+void TUnionFindMP::Gen(const int& Keys) {
+  ParentV.Gen(Keys);
+  #pragma omp parallel for schedule(static)
+  for (int i = 0; i < Keys; i++) { ParentV[i] = i; }
+}
+
+void TUnionFindMP::Flatten() {
+  #pragma omp parallel for schedule(dynamic,10000)
+  for (int i = 0; i < ParentV.Len(); i++) { ParentV[i] = Find(i); }
+}
+#endif // USE_OPENMP
\ No newline at end of file
@@ -34,6 +34,10 @@ template <class TGraph> struct IsEdgeDat    { enum { Val = 0 }; };
 template <class TGraph> struct IsSources    { enum { Val = 0 }; };
 /// Tests (at compile time) if the graph is a bipartite graph type.
 template <class TGraph> struct IsBipart     { enum { Val = 0 }; };
+/// Tests (at compile time) if the graph adds a batch of edges with AddEdgeBatch().
+template <class TGraph> struct IsEdgeBatch  { enum { Val = 0 }; };
+/// Type of node ids of the graph (at compile time). ##TSnap::TNIdType
+template <class TGraph> struct TNIdType     { typedef int TNId; typedef TInt TNIdT; };
 
 /// For quick testing of the properties of the graph/network object (see TGraphFlag).
 #define HasGraphFlag(TGraph, Flag) \
@@ -67,6 +71,8 @@ public:
 TStr GetFlagStr(const TGraphFlag& GraphFlag);
 /// Prints basic graph statistics. ##TSnap::PrintInfo
 template <class PGraph> void PrintInfo(const PGraph& Graph, const TStr& Desc="", const TStr& OutFNm="", const bool& Fast=true);
+/// Adds edges from node IDs EdgeV[e].Val1 to node IDs EdgeV[e].Val2 to the graph. ##TSnap::AddEdgeBatch
+template <class PGraph> int AddEdgeBatch(const PGraph& Graph, const TVec<TPair<typename TNIdType<typename PGraph::TObj>::TNIdT, typename TNIdType<typename PGraph::TObj>::TNIdT> >& EdgeV);
 
 /////////////////////////////////////////////////
 // Implementation
@@ -81,8 +87,10 @@ template<class PGraph> int GetKCoreEdges(const PGraph& Graph, TIntPrV& CoreIdSzV
 
 template <class PGraph>
 void PrintInfo(const PGraph& Graph, const TStr& Desc, const TStr& OutFNm, const bool& Fast) {
+  typedef typename TNIdType<typename PGraph::TObj>::TNId TNId;
+  typedef typename TNIdType<typename PGraph::TObj>::TNIdT TNIdT;
   int BiDirEdges=0, ZeroNodes=0, ZeroInNodes=0, ZeroOutNodes=0, SelfEdges=0, NonZIODegNodes=0;
-  THash<TIntPr, TInt> UniqDirE, UniqUnDirE;
+  THash<TPair<TNIdT, TNIdT>, TInt> UniqDirE, UniqUnDirE;
   FILE *F = stdout;
   if (! OutFNm.Empty()) F = fopen(OutFNm.CStr(), "wt");
   if (! Desc.Empty()) { fprintf(F, "%s:", Desc.CStr()); }
@@ -98,13 +106,13 @@ void PrintInfo(const PGraph& Graph, const TStr& Desc, const TStr& OutFNm, const
     if (NI.GetOutDeg()==0) ZeroOutNodes++;
     if (NI.GetInDeg()!=0 && NI.GetOutDeg()!=0) NonZIODegNodes++;
     if (! Fast || Graph->GetNodes() < 1000) {
-      const int NId = NI.GetId();
+      const TNId NId = NI.GetId();
       for (int edge = 0; edge < NI.GetOutDeg(); edge++) {
-        const int DstNId = NI.GetOutNId(edge);
+        const TNId DstNId = NI.GetOutNId(edge);
         if (Graph->IsEdge(DstNId, NId)) BiDirEdges++;
         if (NId == DstNId) SelfEdges++;
-        UniqDirE.AddKey(TIntPr(NId, DstNId));
-        UniqUnDirE.AddKey(TIntPr(TInt::GetMn(NId, DstNId), TInt::GetMx(NId, DstNId)));
+        UniqDirE.AddKey(TPair<TNIdT, TNIdT>(NId, DstNId));
+        UniqUnDirE.AddKey(TPair<TNIdT, TNIdT>(TMath::Mn(NId, DstNId), TMath::Mx(NId, DstNId)));
       }
     }
   }
@@ -121,7 +129,7 @@ void PrintInfo(const PGraph& Graph, const TStr& Desc, const TStr& OutFNm, const
   // print info
   fprintf(F, "\n");
   fprintf(F, "  Nodes:                    %d\n", Graph->GetNodes());
-  fprintf(F, "  Edges:                    %d\n", Graph->GetEdges());
+  fprintf(F, "  Edges:                    %s\n", TInt64::GetStr(Graph->GetEdges()).CStr());
   fprintf(F, "  Zero Deg Nodes:           %d\n", ZeroNodes);
   fprintf(F, "  Zero InDeg Nodes:         %d\n", ZeroInNodes);
   fprintf(F, "  Zero OutDeg Nodes:        %d\n", ZeroOutNodes);
@@ -146,8 +154,61 @@ void PrintInfo(const PGraph& Graph, const TStr& Desc, const TStr& OutFNm, const
   if (! OutFNm.Empty()) { fclose(F); }
 }
 
+namespace TSnapDetail {
+template <class PGraph, bool IsEdgeBatch>
+struct TAddEdgeBatch {
+  template <class TNIdPrV>
+  static int Do(const PGraph& Graph, const TNIdPrV& EdgeV) {
+    return Graph->AddEdgeBatch(EdgeV);
+  }
+};
+
+template <class PGraph>
+struct TAddEdgeBatch<PGraph, false> { // one edge at a time
+  template <class TNIdPrV>
+  static int Do(const PGraph& Graph, const TNIdPrV& EdgeV) {
+    int NewEdges = 0;
+    for (int e = 0; e < EdgeV.Len(); e++) {
+      if (Graph->AddEdge(EdgeV[e].Val1, EdgeV[e].Val2) != -2) { NewEdges++; }
+    }
+    return NewEdges;
+  }
+};
+} // TSnapDetail
+
+template <class PGraph>
+int AddEdgeBatch(const PGraph& Graph, const TVec<TPair<typename TNIdType<typename PGraph::TObj>::TNIdT, typename TNIdType<typename PGraph::TObj>::TNIdT> >& EdgeV) {
+  return TSnapDetail::TAddEdgeBatch<PGraph, TSnap::IsEdgeBatch<typename PGraph::TObj::TNet>::Val>::Do(Graph, EdgeV);
+}
+
 }  // namespace TSnap
 
+namespace TSnapDetail {
+/// Sorts the values appended to the sorted vector NIdV after its first SortedLen values,
+/// merges them in and removes duplicates. Returns the number of new values.
+template <class TNIdT>
+int MergeBatchNIdV(TVec<TNIdT>& NIdV, const int& SortedLen) {
+  const int Vals = NIdV.Len();
+  if (Vals == SortedLen) { return 0; }
+  TVec<TNIdT>::IntroSortCmp(NIdV.BegI() + SortedLen, NIdV.EndI(), TLss<TNIdT>());
+  if (SortedLen > 0 && NIdV[SortedLen-1] >= NIdV[SortedLen]) { // merge from the back
+    TVec<TNIdT> NewV;
+    NIdV.GetSubValV(SortedLen, Vals-1, NewV);
+    int i = SortedLen-1, j = NewV.Len()-1, k = Vals-1;
+    while (j >= 0) {
+      if (i >= 0 && NIdV[i] > NewV[j]) { NIdV[k--] = NIdV[i--]; }
+      else { NIdV[k--] = NewV[j--]; }
+    }
+  }
+  int Len = 1;
+  for (int i = 1; i < Vals; i++) {
+    if (NIdV[i] != NIdV[Len-1]) { NIdV[Len++] = NIdV[i]; }
+  }
+  NIdV.Reduce(Len);
+  return Len - SortedLen;
+}
+} // namespace TSnapDetail
+
 //#//////////////////////////////////////////////
 /// Fast Queue used by the \c TBreathFS (uses \c memcpy to move objects \c TVal around).
 template <class TVal>
@@ -255,6 +316,52 @@ public:
   void Dump();
 };
 
+#ifdef USE_OPENMP
+//#//////////////////////////////////////////////
+/// Lock-free Union Find over dense keys 0..N-1. ##TUnionFindMP
+/// Find and Union can be called concurrently from many threads. Roots are
+/// linked by index (larger root under smaller), which keeps the forest acyclic
+/// without locks, and Find compresses paths by halving.
+class TUnionFindMP {
+private:
+  TIntV ParentV;
+public:
+  TUnionFindMP() : ParentV() { }
+  /// Constructor that creates Keys singleton sets.
+  TUnionFindMP(const int& Keys) : ParentV() { Gen(Keys); }
+  /// Resets the structure to Keys singleton sets.
+  void Gen(const int& Keys);
+
+  /// Returns the number of elements in the structure.
+  int Len() const { return ParentV.Len(); }
+  /// Returns the set that contains element Key.
+  int Find(int Key) {
+    while (true) {
+      const int Parent = ParentV[Key];
+      const int GrandParent = ParentV[Parent];
+      if (Parent == GrandParent) { return Parent; }
+      __sync_bool_compare_and_swap(&ParentV[Key].Val, Parent, GrandParent);
+      Key = GrandParent;
+    }
+  }
+  /// Merges sets with elements Key1 and Key2.
+  void Union(int Key1, int Key2) {
+    while (true) {
+      Key1 = Find(Key1);  Key2 = Find(Key2);
+      if (Key1 == Key2) { return; }
+      if (Key1 < Key2) { const int Tmp = Key1;  Key1 = Key2;  Key2 = Tmp; }
+      if (__sync_bool_compare_and_swap(&ParentV[Key1].Val, Key1, Key2)) { return; }
+    }
+  }
+  /// Returns true if elements Key1 and Key2 are in the same set.
+  bool IsSameSet(const int& Key1, const int& Key2) { return Find(Key1) == Find(Key2); }
+  /// Points every element directly to the root of its set. Not thread-safe with concurrent Union.
+  void Flatten();
+  /// Returns the parent vector; after Flatten() it holds the set id of every element.
+  const TIntV& GetParentV() const { return ParentV; }
+};
+#endif // USE_OPENMP
+
 //#//////////////////////////////////////////////
 /// Simple heap data structure. ##THeap
 template <class TVal, class TCmp = TLss<TVal> >
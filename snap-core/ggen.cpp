@@ -552,3 +552,256 @@ PNGraph GenRMatEpinions() {
 }
 
 } // namespace TSnap
+
+/////////////////////////////////////////////////
+// R-MAT edge stream generator
+const int TRMatGen::BlockEdges = 1<<16;
+
+// splitmix64 finalizer
+static uint64 GetRMatMix(uint64 Key) {
+  Key = (Key ^ (Key >> 30)) * 0xBF58476D1CE4E5B9ULL;
+  Key = (Key ^ (Key >> 27)) * 0x94D049BB133111EBULL;
+  return Key ^ (Key >> 31);
+}
+
+// counter-based random numbers, value i of stream StreamN is a hash of (Seed, StreamN, i)
+class TRMatRnd {
+private:
+  uint64 State;
+public:
+  TRMatRnd(const uint64& Seed, const uint64& StreamN) : State(GetRMatMix(Seed + GetRMatMix(StreamN + 1))) { }
+  uint64 GetUInt64() { State += 0x9E3779B97F4A7C15ULL;  return GetRMatMix(State); }
+  double GetUniDev() { return double(GetUInt64() >> 11) / 9007199254740992.0; }
+};
+
+static void IncRMatCnt(TInt& Cnt) {
+#ifdef USE_OPENMP
+  __sync_fetch_and_add(&Cnt.Val, 1);
+#else
+  Cnt++;
+#endif
+}
+
+static int64 GetRMatPos(TInt64& Pos) {
+#ifdef USE_OPENMP
+  return __sync_fetch_and_add(&Pos.Val, 1);
+#else
+  const int64 Old = Pos;  Pos += 1;
+  return Old;
+#endif
+}
+
+TRMatGen::TRMatGen(const int& _Scale, const int64& _Edges, const double& A, const double& B, const double& C,
+ const uint64& _Seed, const double& Noise, const bool& _Permute) : Scale(_Scale), Edges(_Edges), Seed(_Seed),
+ ThAV(_Scale, 0), ThABV(_Scale, 0), ThABCV(_Scale, 0), Permute(_Permute), PermKeyV() {
+  IAssertR(Scale >= 1 && Scale <= 30, "R-MAT scale must be between 1 and 30");
+  IAssert(Edges >= 0 && A >= 0.0 && B >= 0.0 && C >= 0.0 && A+B+C <= 1.0);
+  const double D = 1.0 - (A+B+C);
+  IAssertR(Noise >= 0.0 && Noise <= TMath::Mn(TMath::Mn(B, C), (A+D)/2.0), "R-MAT noise must be at most min(B, C, (A+D)/2)");
+  TRMatRnd Rnd(Seed, ~uint64(0));
+  for (int l = 0; l < Scale; l++) {
+    const double Mu = Noise > 0.0 ? Noise * (2.0*Rnd.GetUniDev() - 1.0) : 0.0;
+    const double LA = A + (Mu != 0.0 ? -2.0*Mu*A/(A+D) : 0.0), LB = B + Mu, LC = C + Mu;
+    ThAV.Add(uint64(LA * 4294967296.0));
+    ThABV.Add(uint64((LA+LB) * 4294967296.0));
+    ThABCV.Add(uint64((LA+LB+LC) * 4294967296.0));
+  }
+  if (Permute) {
+    TRMatRnd PermRnd(Seed, ~uint64(1));
+    for (int k = 0; k < 4; k++) { PermKeyV.Add(PermRnd.GetUInt64()); }
+    PermKeyV[0] = PermKeyV[0] | 1;  PermKeyV[2] = PermKeyV[2] | 1; // odd multipliers
+  }
+}
+
+int TRMatGen::GetPermNId(const int& NId) const {
+  if (! Permute) { return NId; }
+  const uint64 Mask = (uint64(1) << Scale) - 1;
+  const int Shift = Scale/2 + 1;
+  uint64 X = uint64(NId);
+  X = (X * PermKeyV[0].Val + PermKeyV[1].Val) & Mask;  X ^= X >> Shift;
+  X = (X * PermKeyV[2].Val + PermKeyV[3].Val) & Mask;  X ^= X >> Shift;
+  return int(X);
+}
+
+void TRMatGen::GetBlock(const int64& BlockN, TIntPrV& EdgeV) const {
+  const int BlockLen = int(TMath::Mn(Edges - BlockN*BlockEdges, int64(BlockEdges)));
+  IAssert(BlockN >= 0 && BlockLen >= 0);
+  EdgeV.Gen(BlockLen);
+  TRMatRnd Rnd(Seed, BlockN);
+  for (int e = 0; e < BlockLen; e++) {
+    int Src = 0, Dst = 0;
+    uint64 Bits = 0;
+    for (int l = 0; l < Scale; l++) {
+      // every 64-bit random number gives the 32-bit numbers of two levels
+      if (l % 2 == 0) { Bits = Rnd.GetUInt64(); }
+      const uint64 U = l % 2 == 0 ? Bits >> 32 : Bits & 0xFFFFFFFFULL;
+      Src <<= 1;  Dst <<= 1;
+      if (U < ThAV[l]) { }
+      else if (U < ThABV[l]) { Dst |= 1; }
+      else if (U < ThABCV[l]) { Src |= 1; }
+      else { Src |= 1;  Dst |= 1; }
+    }
+    EdgeV[e].Val1 = GetPermNId(Src);
+    EdgeV[e].Val2 = GetPermNId(Dst);
+  }
+}
+
+void TRMatGen::SaveBinEdges(const TStr& FNm) const {
+  IAssert(sizeof(TIntPr) == 2*sizeof(int));
+  FILE *F = fopen(FNm.CStr(), "wb");
+  EAssertR(F != NULL, "Can not open file " + FNm);
+  const int64 Blocks = GetBlocks();
+  const int BatchBlocks = 64;
+  TVec<TIntPrV> EdgeVV(BatchBlocks);
+  for (int64 FirstBlock = 0; FirstBlock < Blocks; FirstBlock += BatchBlocks) {
+    const int Batch = int(TMath::Mn(int64(BatchBlocks), Blocks - FirstBlock));
+    #pragma omp parallel for schedule(dynamic,1)
+    for (int b = 0; b < Batch; b++) { GetBlock(FirstBlock + b, EdgeVV[b]); }
+    for (int b = 0; b < Batch; b++) {
+      const size_t Written = fwrite(EdgeVV[b].BegI(), sizeof(TIntPr), EdgeVV[b].Len(), F);
+      EAssertR(Written == size_t(EdgeVV[b].Len()), "Can not write file " + FNm);
+    }
+  }
+  fclose(F);
+}
+
+// degrees of the nodes without self-loops, duplicate edges are counted
+void TRMatGen::GetDegV(const bool& IsDir, TIntV& DegV) const {
+  const int64 Blocks = GetBlocks();
+  DegV.Gen(GetNodes());
+  DegV.PutAll(0);
+  #pragma omp parallel
+  {
+    TIntPrV EdgeV;
+    #pragma omp for schedule(dynamic,1)
+    for (int64 b = 0; b < Blocks; b++) {
+      GetBlock(b, EdgeV);
+      for (int e = 0; e < EdgeV.Len(); e++) {
+        if (EdgeV[e].Val1 == EdgeV[e].Val2) { continue; }
+        IncRMatCnt(DegV[EdgeV[e].Val1]);
+        if (! IsDir) { IncRMatCnt(DegV[EdgeV[e].Val2]); }
+      }
+    }
+  }
+}
+
+// rows of nodes MnNId..MxNId-1 from the degrees of GetDegV(), DegV of the range is replaced by the
+// degrees without duplicates. NbrV keeps the capacity of the rows with duplicates.
+void TRMatGen::GetRangeCsr(const bool& IsDir, const int& MnNId, const int& MxNId, TIntV& DegV,
+ TVec<TInt64>& OffV, TVec<TInt, int64>& NbrV) const {
+  const int64 Blocks = GetBlocks();
+  const int Rows = MxNId - MnNId;
+  OffV.Gen(Rows + 1);
+  OffV[0] = 0;
+  for (int i = 0; i < Rows; i++) { OffV[i+1] = OffV[i] + DegV[MnNId+i]; }
+  TVec<TInt64> PosV(OffV);
+  NbrV.Gen(OffV[Rows]);
+  #pragma omp parallel
+  {
+    TIntPrV EdgeV;
+    #pragma omp for schedule(dynamic,1)
+    for (int64 b = 0; b < Blocks; b++) {
+      GetBlock(b, EdgeV);
+      for (int e = 0; e < EdgeV.Len(); e++) {
+        const int Src = EdgeV[e].Val1, Dst = EdgeV[e].Val2;
+        if (Src == Dst) { continue; }
+        if (Src >= MnNId && Src < MxNId) { NbrV[GetRMatPos(PosV[Src-MnNId])] = Dst; }
+        if (! IsDir && Dst >= MnNId && Dst < MxNId) { NbrV[GetRMatPos(PosV[Dst-MnNId])] = Src; }
+      }
+    }
+  }
+  #pragma omp parallel for schedule(dynamic,1000)
+  for (int i = 0; i < Rows; i++) {
+    TInt* Beg = NbrV.BegI() + OffV[i];
+    TInt* End = NbrV.BegI() + OffV[i+1];
+    TIntV::IntroSortCmp(Beg, End, TLss<TInt>());
+    int Len = 0;
+    for (TInt* N = Beg; N < End; N++) {
+      if (Len == 0 || Beg[Len-1] != *N) { Beg[Len] = *N;  Len++; } }
+    DegV[MnNId+i] = Len;
+  }
+  int64 Pos = 0;
+  for (int i = 0; i < Rows; i++) {
+    const int64 Beg = OffV[i];
+    OffV[i] = Pos;
+    for (int k = 0; k < DegV[MnNId+i]; k++) { NbrV[Pos] = NbrV[Beg+k];  Pos++; }
+  }
+  OffV[Rows] = Pos;
+  NbrV.Reduce(Pos);
+}
+
+void TRMatGen::GetCsr(const bool& IsDir, TVec<TInt64>& OffV, TVec<TInt, int64>& NbrV) const {
+  TIntV DegV;
+  GetDegV(IsDir, DegV);
+  GetRangeCsr(IsDir, 0, GetNodes(), DegV, OffV, NbrV);
+  NbrV.Pack();
+}
+
+// file layout: int32 nodes, int64 edges, int64 offsets[nodes+1], int32 neighbors[edges]
+void TRMatGen::SaveCsr(const TStr& FNm, const bool& IsDir, const int64& MxMemEdges) const {
+  const int Nodes = GetNodes();
+  TIntV DegV;
+  GetDegV(IsDir, DegV);
+  // rows of node ranges go to a temporary file until all degrees are known
+  const TStr NbrFNm = FNm + ".nbr.tmp";
+  FILE *NbrF = fopen(NbrFNm.CStr(), "wb");
+  EAssertR(NbrF != NULL, "Can not open file " + NbrFNm);
+  TVec<TInt64> OffV;
+  TVec<TInt, int64> NbrV;
+  for (int MnNId = 0; MnNId < Nodes; ) {
+    int MxNId = MnNId + 1;
+    int64 RangeEdges = DegV[MnNId];
+    while (MxNId < Nodes && RangeEdges + DegV[MxNId] <= MxMemEdges) { RangeEdges += DegV[MxNId];  MxNId++; }
+    GetRangeCsr(IsDir, MnNId, MxNId, DegV, OffV, NbrV);
+    const size_t Written = fwrite(NbrV.BegI(), sizeof(TInt), NbrV.Len(), NbrF);
+    EAssertR(Written == size_t(NbrV.Len()), "Can not write file " + NbrFNm);
+    MnNId = MxNId;
+  }
+  fclose(NbrF);
+  NbrV.Clr();
+  FILE *F = fopen(FNm.CStr(), "wb");
+  EAssertR(F != NULL, "Can not open file " + FNm);
+  int64 NbrLen = 0;
+  for (int i = 0; i < Nodes; i++) { NbrLen += DegV[i]; }
+  fwrite(&Nodes, sizeof(int), 1, F);
+  fwrite(&NbrLen, sizeof(int64), 1, F);
+  const int BfLen = 1<<20;
+  TVec<TInt64> OffBfV(BfLen, 0);
+  int64 Off = 0;
+  for (int i = 0; i <= Nodes; i++) {
+    OffBfV.Add(Off);
+    if (i < Nodes) { Off += DegV[i]; }
+    if (OffBfV.Len() == BfLen || i == Nodes) {
+      const size_t Written = fwrite(OffBfV.BegI(), sizeof(TInt64), OffBfV.Len(), F);
+      EAssertR(Written == size_t(OffBfV.Len()), "Can not write file " + FNm);
+      OffBfV.Clr(false);
+    }
+  }
+  NbrF = fopen(NbrFNm.CStr(), "rb");
+  EAssertR(NbrF != NULL, "Can not open file " + NbrFNm);
+  TIntV NbrBfV(BfLen);
+  for (size_t Read = fread(NbrBfV.BegI(), sizeof(TInt), BfLen, NbrF); Read > 0; Read = fread(NbrBfV.BegI(), sizeof(TInt), BfLen, NbrF)) {
+    const size_t Written = fwrite(NbrBfV.BegI(), sizeof(TInt), Read, F);
+    EAssertR(Written == Read, "Can not write file " + FNm);
+  }
+  fclose(NbrF);
+  fclose(F);
+  TFile::Del(NbrFNm);
+}
+
+void TRMatGen::LoadCsr(const TStr& FNm, TVec<TInt64>& OffV, TVec<TInt, int64>& NbrV) {
+  FILE *F = fopen(FNm.CStr(), "rb");
+  EAssertR(F != NULL, "Can not open file " + FNm);
+  int Nodes = 0;
+  int64 NbrLen = 0;
+  size_t Read = fread(&Nodes, sizeof(int), 1, F);
+  Read += fread(&NbrLen, sizeof(int64), 1, F);
+  EAssertR(Read == 2 && Nodes >= 0 && NbrLen >= 0, "Invalid CSR file " + FNm);
+  OffV.Gen(Nodes + 1);
+  NbrV.Gen(NbrLen);
+  Read = fread(OffV.BegI(), sizeof(TInt64), Nodes + 1, F);
+  EAssertR(Read == size_t(Nodes + 1), "Invalid CSR file " + FNm);
+  Read = fread(NbrV.BegI(), sizeof(TInt), NbrLen, F);
+  EAssertR(Read == size_t(NbrLen), "Invalid CSR file " + FNm);
+  fclose(F);
+}
@@ -223,13 +223,21 @@ PGraph GenRndGnm(const int& Nodes, const int& Edges, const bool& IsDir, TRnd& Rn
   for (int node = 0; node < Nodes; node++) {
     IAssert(Graph.AddNode(node) == node);
   }
+  // every round draws as many edges as are missing, so the graph is the same
+  // as when adding the draws one at a time until Edges of them are new
+  const bool AddRev = ! IsDir && HasGraphFlag(typename PGraph::TObj, gfDirected);
+  TIntPrV EdgeV;
   for (int edge = 0; edge < Edges; ) {
-    const int SrcNId = Rnd.GetUniDevInt(Nodes);
-    const int DstNId = Rnd.GetUniDevInt(Nodes);
-    if (SrcNId != DstNId && Graph.AddEdge(SrcNId, DstNId) != -2) { // is new edge
-      if (! IsDir) { Graph.AddEdge(DstNId, SrcNId); }
-      edge++;
+    EdgeV.Gen(AddRev ? 2*(Edges-edge) : Edges-edge, 0);
+    while (EdgeV.Len() < EdgeV.Reserved()) {
+      const int SrcNId = Rnd.GetUniDevInt(Nodes);
+      const int DstNId = Rnd.GetUniDevInt(Nodes);
+      if (SrcNId != DstNId) {
+        EdgeV.Add(TIntPr(SrcNId, DstNId));
+        if (AddRev) { EdgeV.Add(TIntPr(DstNId, SrcNId)); }
+      }
     }
+    edge += TSnap::AddEdgeBatch(GraphPt, EdgeV) / (AddRev ? 2 : 1);
   }
   return GraphPt;
 }
@@ -265,3 +273,56 @@ TIntPr GetRndEdgeNonAdjNode(const PGraph& Graph, int NId1, int NId2) {
 } // namespace TSnapDetail
 
 }; // namespace TSnap
+
+//#//////////////////////////////////////////////
+/// Out-of-core R-MAT / Graph500 edge stream generator. ##TRMatGen
+/// Draws Edges edges on 2^Scale nodes by recursive descent into the matrix
+/// [A, B; C, 1-(A+B+C)], where rows are sources and columns destinations.
+/// Edges are generated in blocks of BlockEdges. The random numbers of block b
+/// come from a counter-based generator keyed by (Seed, b), so blocks can be
+/// generated by any thread in any order and the output depends only on the
+/// parameters. Noise > 0 perturbs the matrix at every level (noisy SKG: B and C
+/// by mu ~ U[-Noise, Noise], A and D compensate in proportion), Permute relabels
+/// the nodes with a pseudorandom bijection of 0..2^Scale-1. Like the Graph500
+/// generator the stream contains duplicate edges and self-loops, the CSR
+/// builders remove them. Node ids are int, so Scale is at most 30.
+/// See: D. Chakrabarti, Y. Zhan, C. Faloutsos, R-MAT: A Recursive Model for Graph Mining, SDM 2004
+/// and C. Seshadhri, A. Pinar, T. G. Kolda, An in-depth analysis of stochastic Kronecker graphs, ICDM 2011
+class TRMatGen {
+public:
+  static const int BlockEdges;
+private:
+  TInt Scale;
+  TInt64 Edges;
+  TUInt64 Seed;
+  TUInt64V ThAV, ThABV, ThABCV; // quadrant thresholds of every level on 32-bit random numbers
+  TBool Permute;
+  TUInt64V PermKeyV;            // keys of the label bijection
+private:
+  void GetDegV(const bool& IsDir, TIntV& DegV) const;
+  void GetRangeCsr(const bool& IsDir, const int& MnNId, const int& MxNId, TIntV& DegV, TVec<TInt64>& OffV, TVec<TInt, int64>& NbrV) const;
+public:
+  TRMatGen(const int& _Scale, const int64& _Edges, const double& A, const double& B, const double& C,
+    const uint64& _Seed=1, const double& Noise=0.0, const bool& _Permute=false);
+  /// Generator with the Graph500 parameters: 16*2^Scale edges, A=0.57, B=C=0.19, permuted labels.
+  static TRMatGen GetGraph500(const int& Scale, const uint64& Seed=1) { return TRMatGen(Scale, int64(16) << Scale, 0.57, 0.19, 0.19, Seed, 0.0, true); }
+
+  int GetScale() const { return Scale; }
+  int GetNodes() const { return 1 << Scale; }
+  int64 GetEdges() const { return Edges; }
+  int64 GetBlocks() const { return (Edges + BlockEdges - 1) / BlockEdges; }
+  /// Returns the label of node NId after the permutation.
+  int GetPermNId(const int& NId) const;
+  /// Generates the edges (source, destination) of block BlockN.
+  void GetBlock(const int64& BlockN, TIntPrV& EdgeV) const;
+  /// Writes the edge stream to a binary file of (int32 source, int32 destination) pairs in block order.
+  void SaveBinEdges(const TStr& FNm) const;
+  /// Builds the sorted out-neighbor rows NbrV[OffV[i]..OffV[i+1]-1] of every node in memory.
+  /// Duplicate edges and self-loops are dropped. If IsDir is false every edge is stored in the rows of both endpoints.
+  void GetCsr(const bool& IsDir, TVec<TInt64>& OffV, TVec<TInt, int64>& NbrV) const;
+  /// Writes the rows of GetCsr() to a binary file, building the rows of consecutive node ranges with
+  /// at most about MxMemEdges edges at a time. Every range regenerates the edge stream.
+  void SaveCsr(const TStr& FNm, const bool& IsDir, const int64& MxMemEdges=int64(1)<<28) const;
+  /// Loads rows written by SaveCsr().
+  static void LoadCsr(const TStr& FNm, TVec<TInt64>& OffV, TVec<TInt, int64>& NbrV);
+};
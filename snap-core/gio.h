@@ -67,20 +67,37 @@ template<class PGraph> void SaveGViz(const PGraph& Graph, const TStr& OutFNm, co
 /////////////////////////////////////////////////
 // Implementation
 
-/// Loads the format saved by TSnap::SaveEdgeList() ##LoadEdgeList
-template <class PGraph>
-PGraph LoadEdgeList(const TStr& InFNm, const int& SrcColId, const int& DstColId) {
-  TSsParser Ss(InFNm, ssfWhiteSep, true, true, true);
-  PGraph Graph = PGraph::TObj::New();
-  int SrcNId, DstNId;
+namespace TSnapDetail {
+/// Edges are added to the graph in batches of at most LoadEdgeBatch edges.
+const int LoadEdgeBatch = 1<<26;
+/// Parses node id of the graph's node id type from field FldN.
+inline bool GetSsNId(const TSsParser& Ss, const int& FldN, int& NId) { return Ss.GetInt(FldN, NId); }
+inline bool GetSsNId(const TSsParser& Ss, const int& FldN, int64& NId) { return Ss.GetInt64(FldN, NId); }
 
+template <class PGraph>
+void LoadEdgeList(TSsParser& Ss, const PGraph& Graph, const int& SrcColId, const int& DstColId) {
+  typedef typename TNIdType<typename PGraph::TObj>::TNId TNId;
+  typedef typename TNIdType<typename PGraph::TObj>::TNIdT TNIdT;
+  TNId SrcNId, DstNId;
+  TVec<TPair<TNIdT, TNIdT> > EdgeV;
   while (Ss.Next()) {
-    if (! Ss.GetInt(SrcColId, SrcNId) || ! Ss.GetInt(DstColId, DstNId)) { continue; }
+    if (! GetSsNId(Ss, SrcColId, SrcNId) || ! GetSsNId(Ss, DstColId, DstNId)) { continue; }
     if (! Graph->IsNode(SrcNId)) { Graph->AddNode(SrcNId); }
     if (! Graph->IsNode(DstNId)) { Graph->AddNode(DstNId); }
-    Graph->AddEdge(SrcNId, DstNId);
+    EdgeV.Add(TPair<TNIdT, TNIdT>(SrcNId, DstNId));
+    if (EdgeV.Len() == LoadEdgeBatch) { TSnap::AddEdgeBatch(Graph, EdgeV);  EdgeV.Clr(false); }
   }
+  TSnap::AddEdgeBatch(Graph, EdgeV);
   Graph->Defrag();
+}
+} // namespace TSnapDetail
+
+/// Loads the format saved by TSnap::SaveEdgeList() ##LoadEdgeList
+template <class PGraph>
+PGraph LoadEdgeList(const TStr& InFNm, const int& SrcColId, const int& DstColId) {
+  TSsParser Ss(InFNm, ssfWhiteSep, true, true, true);
+  PGraph Graph = PGraph::TObj::New();
+  TSnapDetail::LoadEdgeList(Ss, Graph, SrcColId, DstColId);
   return Graph;
 }
 
@@ -89,14 +106,7 @@ template <class PGraph>
 PGraph LoadEdgeList(const TStr& InFNm, const int& SrcColId, const int& DstColId, const char& Separator) {
   TSsParser Ss(InFNm, Separator);
   PGraph Graph = PGraph::TObj::New();
-  int SrcNId, DstNId;
-  while (Ss.Next()) {
-    if (! Ss.GetInt(SrcColId, SrcNId) || ! Ss.GetInt(DstColId, DstNId)) { continue; }
-    if (! Graph->IsNode(SrcNId)) { Graph->AddNode(SrcNId); }
-    if (! Graph->IsNode(DstNId)) { Graph->AddNode(DstNId); }
-    Graph->AddEdge(SrcNId, DstNId);
-  }
-  Graph->Defrag();
+  TSnapDetail::LoadEdgeList(Ss, Graph, SrcColId, DstColId);
   return Graph;
 }
 
@@ -106,13 +116,15 @@ PGraph LoadEdgeListStr(const TStr& InFNm, const int& SrcColId, const int& DstCol
   TSsParser Ss(InFNm, ssfWhiteSep);
   PGraph Graph = PGraph::TObj::New();
   TStrHash<TInt> StrToNIdH(Mega(1), true); // hash-table mapping strings to integer node ids
+  TIntPrV EdgeV;
   while (Ss.Next()) {
     const int SrcNId = StrToNIdH.AddKey(Ss[SrcColId]);
     const int DstNId = StrToNIdH.AddKey(Ss[DstColId]);
     if (! Graph->IsNode(SrcNId)) { Graph->AddNode(SrcNId); }
     if (! Graph->IsNode(DstNId)) { Graph->AddNode(DstNId); }
-    Graph->AddEdge(SrcNId, DstNId);
+    EdgeV.Add(TIntPr(SrcNId, DstNId));
   }
+  TSnap::AddEdgeBatch(Graph, EdgeV);
   Graph->Defrag();
   return Graph;
 }
@@ -122,13 +134,15 @@ template <class PGraph>
 PGraph LoadEdgeListStr(const TStr& InFNm, const int& SrcColId, const int& DstColId, TStrHash<TInt>& StrToNIdH) {
   TSsParser Ss(InFNm, ssfWhiteSep);
   PGraph Graph = PGraph::TObj::New();
+  TIntPrV EdgeV;
   while (Ss.Next()) {
     const int SrcNId = StrToNIdH.AddKey(Ss[SrcColId]);
     const int DstNId = StrToNIdH.AddKey(Ss[DstColId]);
     if (! Graph->IsNode(SrcNId)) { Graph->AddNode(SrcNId); }
     if (! Graph->IsNode(DstNId)) { Graph->AddNode(DstNId); }
-    Graph->AddEdge(SrcNId, DstNId);
+    EdgeV.Add(TIntPr(SrcNId, DstNId));
   }
+  TSnap::AddEdgeBatch(Graph, EdgeV);
   Graph->Defrag();
   return Graph;
 }
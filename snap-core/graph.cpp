@@ -1,464 +1,3 @@
-/////////////////////////////////////////////////
-// Undirected Graph
-bool TUNGraph::HasFlag(const TGraphFlag& Flag) const {
-  return HasGraphFlag(TUNGraph::TNet, Flag);
-}
-
-// Add a node of ID NId to the graph.
-int TUNGraph::AddNode(int NId) {
-  if (NId == -1) {
-    NId = MxNId;  MxNId++;
-  } else {
-    IAssertR(!IsNode(NId), TStr::Fmt("NodeId %d already exists", NId));
-    MxNId = TMath::Mx(NId+1, MxNId());
-  }
-  NodeH.AddDat(NId, TNode(NId));
-  return NId;
-}
-
-// Add a node of ID NId to the graph.
-int TUNGraph::AddNodeUnchecked(int NId) {
-  if (IsNode(NId)) { return -1;}
-  MxNId = TMath::Mx(NId+1, MxNId());
-  NodeH.AddDat(NId, TNode(NId));
-  return NId;
-}
-
-// Add a node of ID NId to the graph and create edges to all nodes in vector NbrNIdV.
-int TUNGraph::AddNode(const int& NId, const TIntV& NbrNIdV) {
-  int NewNId;
-  if (NId == -1) {
-    NewNId = MxNId;  MxNId++;
-  } else {
-    IAssertR(! IsNode(NId), TStr::Fmt("NodeId %d already exists", NId));
-    NewNId = NId;
-    MxNId = TMath::Mx(NewNId+1, MxNId());
-  }
-  TNode& Node = NodeH.AddDat(NewNId);
-  Node.Id = NewNId;
-  Node.NIdV = NbrNIdV;
-  Node.NIdV.Sort();
-  NEdges += Node.GetDeg();
-  for (int i = 0; i < NbrNIdV.Len(); i++) {
-    GetNode(NbrNIdV[i]).NIdV.AddSorted(NewNId);
-  }
-  return NewNId;
-}
-
-// Add a node of ID NId to the graph and create edges to all nodes in the vector NIdVId in the vector pool Pool).
-int TUNGraph::AddNode(const int& NId, const TVecPool<TInt>& Pool, const int& NIdVId) {
-  int NewNId;
-  if (NId == -1) {
-    NewNId = MxNId;  MxNId++;
-  } else {
-    IAssertR(!IsNode(NId), TStr::Fmt("NodeId %d already exists", NId));
-    NewNId = NId;
-    MxNId = TMath::Mx(NewNId+1, MxNId()); 
-  }
-  TNode& Node = NodeH.AddDat(NewNId);
-  Node.Id = NewNId;
-  Node.NIdV.GenExt(Pool.GetValVPt(NIdVId), Pool.GetVLen(NIdVId));
-  Node.NIdV.Sort();
-  NEdges += Node.GetDeg();
-  return NewNId;
-}
-
-// Delete node of ID NId from the graph.
-void TUNGraph::DelNode(const int& NId) {
-  { AssertR(IsNode(NId), TStr::Fmt("NodeId %d does not exist", NId));
-  TNode& Node = GetNode(NId);
-  NEdges -= Node.GetDeg();
-  for (int e = 0; e < Node.GetDeg(); e++) {
-    const int nbr = Node.GetNbrNId(e);
-    if (nbr == NId) { continue; }
-    TNode& N = GetNode(nbr);
-    const int n = N.NIdV.SearchBin(NId);
-    IAssert(n != -1); // if NId points to N, then N also should point back
-    if (n!= -1) { N.NIdV.Del(n); }
-  } }
-  NodeH.DelKey(NId);
-}
-
-int TUNGraph::GetEdges() const {
-  //int Edges = 0;
-  //for (int N=NodeH.FFirstKeyId(); NodeH.FNextKeyId(N); ) {
-  //  Edges += NodeH[N].GetDeg();
-  //}
-  //return Edges/2;
-  return NEdges;
-}
-
-// Add an edge between SrcNId and DstNId to the graph.
-int TUNGraph::AddEdge(const int& SrcNId, const int& DstNId) {
-  IAssertR(IsNode(SrcNId) && IsNode(DstNId), TStr::Fmt("%d or %d not a node.", SrcNId, DstNId).CStr());
-  if (IsEdge(SrcNId, DstNId)) { return -2; } // edge already exists
-  GetNode(SrcNId).NIdV.AddSorted(DstNId);
-  if (SrcNId!=DstNId) { // not a self edge
-    GetNode(DstNId).NIdV.AddSorted(SrcNId); }
-  NEdges++;
-  return -1; // no edge id
-}
-
-// Add an edge between SrcNId and DstNId to the graph.
-int TUNGraph::AddEdgeUnchecked(const int& SrcNId, const int& DstNId) {
-  GetNode(SrcNId).NIdV.Add(DstNId);
-  if (SrcNId!=DstNId) { // not a self edge
-    GetNode(DstNId).NIdV.Add(SrcNId); }
-  NEdges++;
-  return -1; // no edge id
-}
-
-// Add an edge between SrcNId and DstNId to the graph and create the nodes if they don't yet exist.
-int TUNGraph::AddEdge2(const int& SrcNId, const int& DstNId) {
-  if (! IsNode(SrcNId)) { AddNode(SrcNId); }
-  if (! IsNode(DstNId)) { AddNode(DstNId); }
-  if (GetNode(SrcNId).IsNbrNId(DstNId)) { return -2; } // edge already exists
-  GetNode(SrcNId).NIdV.AddSorted(DstNId);
-  if (SrcNId!=DstNId) { // not a self edge
-    GetNode(DstNId).NIdV.AddSorted(SrcNId); }
-  NEdges++;
-  return -1; // no edge id
-}
-
-// Delete an edge between node IDs SrcNId and DstNId from the graph.
-void TUNGraph::DelEdge(const int& SrcNId, const int& DstNId) {
-  IAssertR(IsNode(SrcNId) && IsNode(DstNId), TStr::Fmt("%d or %d not a node.", SrcNId, DstNId).CStr());
-  { TNode& N = GetNode(SrcNId);
-  const int n = N.NIdV.SearchBin(DstNId);
-  if (n!= -1) { N.NIdV.Del(n);  NEdges--; } }
-  if (SrcNId != DstNId) { // not a self edge
-    TNode& N = GetNode(DstNId);
-    const int n = N.NIdV.SearchBin(SrcNId);
-    if (n!= -1) { N.NIdV.Del(n); }
-  }
-}
-
-// Test whether an edge between node IDs SrcNId and DstNId exists the graph.
-bool TUNGraph::IsEdge(const int& SrcNId, const int& DstNId) const {
-  if (! IsNode(SrcNId) || ! IsNode(DstNId)) return false;
-  return GetNode(SrcNId).IsNbrNId(DstNId);
-}
-
-// Return an iterator referring to edge (SrcNId, DstNId) in the graph.
-TUNGraph::TEdgeI TUNGraph::GetEI(const int& SrcNId, const int& DstNId) const {
-  const int MnNId = TMath::Mn(SrcNId, DstNId);
-  const int MxNId = TMath::Mx(SrcNId, DstNId);
-  const TNodeI SrcNI = GetNI(MnNId);
-  const int NodeN = SrcNI.NodeHI.GetDat().NIdV.SearchBin(MxNId);
-  IAssert(NodeN != -1);
-  return TEdgeI(SrcNI, EndNI(), NodeN);
-}
-
-// Get a vector IDs of all nodes in the graph.
-void TUNGraph::GetNIdV(TIntV& NIdV) const {
-  NIdV.Gen(GetNodes(), 0);
-  for (int N=NodeH.FFirstKeyId(); NodeH.FNextKeyId(N); ) {
-    NIdV.Add(NodeH.GetKey(N)); }
-}
-
-// Defragment the graph.
-void TUNGraph::Defrag(const bool& OnlyNodeLinks) {
-  for (int n = NodeH.FFirstKeyId(); NodeH.FNextKeyId(n); ) {
-    NodeH[n].NIdV.Pack();
-  }
-  if (! OnlyNodeLinks && ! NodeH.IsKeyIdEqKeyN()) {
-    NodeH.Defrag();
-  }
-}
-
-// Check the graph data structure for internal consistency.
-bool TUNGraph::IsOk(const bool& ThrowExcept) const {
-  bool RetVal = true;
-  for (int N = NodeH.FFirstKeyId(); NodeH.FNextKeyId(N); ) {
-    const TNode& Node = NodeH[N];
-    if (! Node.NIdV.IsSorted()) {
-      const TStr Msg = TStr::Fmt("Neighbor list of node %d is not sorted.", Node.GetId());
-      if (ThrowExcept) { EAssertR(false, Msg); } else { ErrNotify(Msg.CStr()); }
-      RetVal=false;
-    }
-    int prevNId = -1;
-    for (int e = 0; e < Node.GetDeg(); e++) {
-      if (! IsNode(Node.GetNbrNId(e))) {
-        const TStr Msg = TStr::Fmt("Edge %d --> %d: node %d does not exist.",
-          Node.GetId(), Node.GetNbrNId(e), Node.GetNbrNId(e));
-        if (ThrowExcept) { EAssertR(false, Msg); } else { ErrNotify(Msg.CStr()); }
-        RetVal=false;
-      }
-      if (e > 0 && prevNId == Node.GetNbrNId(e)) {
-        const TStr Msg = TStr::Fmt("Node %d has duplicate edge %d --> %d.",
-          Node.GetId(), Node.GetId(), Node.GetNbrNId(e));
-        if (ThrowExcept) { EAssertR(false, Msg); } else { ErrNotify(Msg.CStr()); }
-        RetVal=false;
-      }
-      prevNId = Node.GetNbrNId(e);
-    }
-  }
-  int EdgeCnt = 0;
-  for (TEdgeI EI = BegEI(); EI < EndEI(); EI++) { EdgeCnt++; }
-  if (EdgeCnt != GetEdges()) {
-    const TStr Msg = TStr::Fmt("Number of edges counter is corrupted: GetEdges():%d, EdgeCount:%d.", GetEdges(), EdgeCnt);
-    if (ThrowExcept) { EAssertR(false, Msg); } else { ErrNotify(Msg.CStr()); }
-    RetVal=false;
-  }
-  return RetVal;
-}
-
-// Print the graph in a human readable form to an output stream OutF.
-void TUNGraph::Dump(FILE *OutF) const {
-  const int NodePlaces = (int) ceil(log10((double) GetNodes()));
-  fprintf(OutF, "-------------------------------------------------\nUndirected Node Graph: nodes: %d, edges: %d\n", GetNodes(), GetEdges());
-  for (int N = NodeH.FFirstKeyId(); NodeH.FNextKeyId(N); ) {
-    const TNode& Node = NodeH[N];
-    fprintf(OutF, "  %*d [%d] ", NodePlaces, Node.GetId(), Node.GetDeg());
-    for (int edge = 0; edge < Node.GetDeg(); edge++) {
-      fprintf(OutF, " %*d", NodePlaces, Node.GetNbrNId(edge)); }
-    fprintf(OutF, "\n");
-  }
-  fprintf(OutF, "\n");
-}
-
-// Return a small graph on 5 nodes and 5 edges.
-PUNGraph TUNGraph::GetSmallGraph() {
-  PUNGraph Graph = TUNGraph::New();
-  for (int i = 0; i < 5; i++) { Graph->AddNode(i); }
-  Graph->AddEdge(0,1);  Graph->AddEdge(0,2);
-  Graph->AddEdge(0,3);  Graph->AddEdge(0,4);
-  Graph->AddEdge(1,2);
-  return Graph;
-}
-
-/////////////////////////////////////////////////
-// Directed Node Graph
-bool TNGraph::HasFlag(const TGraphFlag& Flag) const {
-  return HasGraphFlag(TNGraph::TNet, Flag);
-}
-
-int TNGraph::AddNode(int NId) {
-  if (NId == -1) {
-    NId = MxNId;  MxNId++;
-  } else {
-    IAssertR(!IsNode(NId), TStr::Fmt("NodeId %d already exists", NId));
-    MxNId = TMath::Mx(NId+1, MxNId());
-  }
-  NodeH.AddDat(NId, TNode(NId));
-  return NId;
-}
-
-int TNGraph::AddNodeUnchecked(int NId) {
-  if (IsNode(NId)) { return NId;}
-  MxNId = TMath::Mx(NId+1, MxNId());
-  NodeH.AddDat(NId, TNode(NId));
-  return NId;
-}
-
-// add a node with a list of neighbors
-// (use TNGraph::IsOk to check whether the graph is consistent)
-int TNGraph::AddNode(const int& NId, const TIntV& InNIdV, const TIntV& OutNIdV) {
-  int NewNId;
-  if (NId == -1) {
-    NewNId = MxNId;  MxNId++;
-  } else {
-    IAssertR(!IsNode(NId), TStr::Fmt("NodeId %d already exists", NId));
-    NewNId = NId;
-    MxNId = TMath::Mx(NewNId+1, MxNId());
-  }
-  TNode& Node = NodeH.AddDat(NewNId);
-  Node.Id = NewNId;
-  Node.InNIdV = InNIdV;
-  Node.OutNIdV = OutNIdV;
-  Node.InNIdV.Sort();
-  Node.OutNIdV.Sort();
-  return NewNId;
-}
-
-// add a node from a vector pool
-// (use TNGraph::IsOk to check whether the graph is consistent)
-int TNGraph::AddNode(const int& NId, const TVecPool<TInt>& Pool, const int& SrcVId, const int& DstVId) {
-  int NewNId;
-  if (NId == -1) {
-    NewNId = MxNId;  MxNId++;
-  } else {
-    IAssertR(!IsNode(NId), TStr::Fmt("NodeId %d already exists", NId));
-    NewNId = NId;
-    MxNId = TMath::Mx(NewNId+1, MxNId());
-  }
-  TNode& Node = NodeH.AddDat(NewNId);
-  Node.Id = NewNId;
-  Node.InNIdV.GenExt(Pool.GetValVPt(SrcVId), Pool.GetVLen(SrcVId));
-  Node.OutNIdV.GenExt(Pool.GetValVPt(DstVId), Pool.GetVLen(DstVId));
-  Node.InNIdV.Sort();
-  Node.OutNIdV.Sort();
-  return NewNId;
-}
-
-void TNGraph::DelNode(const int& NId) {
-  { TNode& Node = GetNode(NId);
-  for (int e = 0; e < Node.GetOutDeg(); e++) {
-  const int nbr = Node.GetOutNId(e);
-  if (nbr == NId) { continue; }
-    TNode& N = GetNode(nbr);
-    const int n = N.InNIdV.SearchBin(NId);
-    if (n!= -1) { N.InNIdV.Del(n); }
-  }
-  for (int e = 0; e < Node.GetInDeg(); e++) {
-  const int nbr = Node.GetInNId(e);
-  if (nbr == NId) { continue; }
-    TNode& N = GetNode(nbr);
-    const int n = N.OutNIdV.SearchBin(NId);
-    if (n!= -1) { N.OutNIdV.Del(n); }
-  } }
-  NodeH.DelKey(NId);
-}
-
-int TNGraph::GetEdges() const {
-  int edges=0;
-  for (int N=NodeH.FFirstKeyId(); NodeH.FNextKeyId(N); ) {
-    edges+=NodeH[N].GetOutDeg();
-  }
-  return edges;
-}
-
-int TNGraph::AddEdge(const int& SrcNId, const int& DstNId) {
-  IAssertR(IsNode(SrcNId) && IsNode(DstNId), TStr::Fmt("%d or %d not a node.", SrcNId, DstNId).CStr());
-  //IAssert(! IsEdge(SrcNId, DstNId));
-  if (IsEdge(SrcNId, DstNId)) { return -2; }
-  GetNode(SrcNId).OutNIdV.AddSorted(DstNId);
-  GetNode(DstNId).InNIdV.AddSorted(SrcNId);
-  return -1; // no edge id
-}
-
-int TNGraph::AddEdgeUnchecked(const int& SrcNId, const int& DstNId) {
-  GetNode(SrcNId).OutNIdV.Add(DstNId);
-  GetNode(DstNId).InNIdV.Add(SrcNId);
-  return -1; // no edge id
-}
-
-int TNGraph::AddEdge2(const int& SrcNId, const int& DstNId) {
-  if (! IsNode(SrcNId)) { AddNode(SrcNId); }
-  if (! IsNode(DstNId)) { AddNode(DstNId); }
-  if (GetNode(SrcNId).IsOutNId(DstNId)) { return -2; } // edge already exists
-  GetNode(SrcNId).OutNIdV.AddSorted(DstNId);
-  GetNode(DstNId).InNIdV.AddSorted(SrcNId);
-  return -1; // no edge id
-}
-
-void TNGraph::DelEdge(const int& SrcNId, const int& DstNId, const bool& IsDir) {
-  IAssertR(IsNode(SrcNId) && IsNode(DstNId), TStr::Fmt("%d or %d not a node.", SrcNId, DstNId).CStr());
-  { TNode& N = GetNode(SrcNId);
-  const int n = N.OutNIdV.SearchBin(DstNId);
-  if (n!= -1) { N.OutNIdV.Del(n); } }
-  { TNode& N = GetNode(DstNId);
-  const int n = N.InNIdV.SearchBin(SrcNId);
-  if (n!= -1) { N.InNIdV.Del(n); } }
-  if (! IsDir) {
-    { TNode& N = GetNode(SrcNId);
-    const int n = N.InNIdV.SearchBin(DstNId);
-    if (n!= -1) { N.InNIdV.Del(n); } }
-    { TNode& N = GetNode(DstNId);
-    const int n = N.OutNIdV.SearchBin(SrcNId);
-    if (n!= -1) { N.OutNIdV.Del(n); } }
-  }
-}
-
-bool TNGraph::IsEdge(const int& SrcNId, const int& DstNId, const bool& IsDir) const {
-  if (! IsNode(SrcNId) || ! IsNode(DstNId)) { return false; }
-  if (IsDir) { return GetNode(SrcNId).IsOutNId(DstNId); }
-  else { return GetNode(SrcNId).IsOutNId(DstNId) || GetNode(DstNId).IsOutNId(SrcNId); }
-}
-
-TNGraph::TEdgeI TNGraph::GetEI(const int& SrcNId, const int& DstNId) const {
-  const TNodeI SrcNI = GetNI(SrcNId);
-  const int NodeN = SrcNI.NodeHI.GetDat().OutNIdV.SearchBin(DstNId);
-  IAssert(NodeN != -1);
-  return TEdgeI(SrcNI, EndNI(), NodeN);
-}
-
-void TNGraph::GetNIdV(TIntV& NIdV) const {
-  NIdV.Gen(GetNodes(), 0);
-  for (int N=NodeH.FFirstKeyId(); NodeH.FNextKeyId(N); ) {
-    NIdV.Add(NodeH.GetKey(N)); }
-}
-
-void TNGraph::Defrag(const bool& OnlyNodeLinks) {
-  for (int n = NodeH.FFirstKeyId(); NodeH.FNextKeyId(n); ) {
-    TNode& Node = NodeH[n];
-    Node.InNIdV.Pack();  Node.OutNIdV.Pack();
-  }
-  if (! OnlyNodeLinks && ! NodeH.IsKeyIdEqKeyN()) { NodeH.Defrag(); }
-}
-
-// for each node check that their neighbors are also nodes
-bool TNGraph::IsOk(const bool& ThrowExcept) const {
-  bool RetVal = true;
-  for (int N = NodeH.FFirstKeyId(); NodeH.FNextKeyId(N); ) {
-    const TNode& Node = NodeH[N];
-    if (! Node.OutNIdV.IsSorted()) {
-      const TStr Msg = TStr::Fmt("Out-neighbor list of node %d is not sorted.", Node.GetId());
-      if (ThrowExcept) { EAssertR(false, Msg); } else { ErrNotify(Msg.CStr()); } RetVal=false;
-    }
-    if (! Node.InNIdV.IsSorted()) {
-      const TStr Msg = TStr::Fmt("In-neighbor list of node %d is not sorted.", Node.GetId());
-      if (ThrowExcept) { EAssertR(false, Msg); } else { ErrNotify(Msg.CStr()); } RetVal=false;
-    }
-    // check out-edges
-    int prevNId = -1;
-    for (int e = 0; e < Node.GetOutDeg(); e++) {
-      if (! IsNode(Node.GetOutNId(e))) {
-        const TStr Msg = TStr::Fmt("Out-edge %d --> %d: node %d does not exist.",
-          Node.GetId(), Node.GetOutNId(e), Node.GetOutNId(e));
-        if (ThrowExcept) { EAssertR(false, Msg); } else { ErrNotify(Msg.CStr()); } RetVal=false;
-      }
-      if (e > 0 && prevNId == Node.GetOutNId(e)) {
-        const TStr Msg = TStr::Fmt("Node %d has duplidate out-edge %d --> %d.",
-          Node.GetId(), Node.GetId(), Node.GetOutNId(e));
-        if (ThrowExcept) { EAssertR(false, Msg); } else { ErrNotify(Msg.CStr()); } RetVal=false;
-      }
-      prevNId = Node.GetOutNId(e);
-    }
-    // check in-edges
-    prevNId = -1;
-    for (int e = 0; e < Node.GetInDeg(); e++) {
-      if (! IsNode(Node.GetInNId(e))) {
-        const TStr Msg = TStr::Fmt("In-edge %d <-- %d: node %d does not exist.",
-          Node.GetId(), Node.GetInNId(e), Node.GetInNId(e));
-        if (ThrowExcept) { EAssertR(false, Msg); } else { ErrNotify(Msg.CStr()); } RetVal=false;
-      }
-      if (e > 0 && prevNId == Node.GetInNId(e)) {
-        const TStr Msg = TStr::Fmt("Node %d has duplidate in-edge %d <-- %d.",
-          Node.GetId(), Node.GetId(), Node.GetInNId(e));
-        if (ThrowExcept) { EAssertR(false, Msg); } else { ErrNotify(Msg.CStr()); } RetVal=false;
-      }
-      prevNId = Node.GetInNId(e);
-    }
-  }
-  return RetVal;
-}
-
-void TNGraph::Dump(FILE *OutF) const {
-  const int NodePlaces = (int) ceil(log10((double) GetNodes()));
-  fprintf(OutF, "-------------------------------------------------\nDirected Node Graph: nodes: %d, edges: %d\n", GetNodes(), GetEdges());
-  for (int N = NodeH.FFirstKeyId(); NodeH.FNextKeyId(N); ) {
-    const TNode& Node = NodeH[N];
-    fprintf(OutF, "  %*d]\n", NodePlaces, Node.GetId());
-    fprintf(OutF, "    in [%d]", Node.GetInDeg());
-    for (int edge = 0; edge < Node.GetInDeg(); edge++) {
-      fprintf(OutF, " %*d", NodePlaces, Node.GetInNId(edge)); }
-    fprintf(OutF, "\n    out[%d]", Node.GetOutDeg());
-    for (int edge = 0; edge < Node.GetOutDeg(); edge++) {
-      fprintf(OutF, " %*d", NodePlaces, Node.GetOutNId(edge)); }
-    fprintf(OutF, "\n");
-  }
-  fprintf(OutF, "\n");
-}
-
-PNGraph TNGraph::GetSmallGraph() {
-  PNGraph G = TNGraph::New();
-  for (int i = 0; i < 5; i++) { G->AddNode(i); }
-  G->AddEdge(0,1); G->AddEdge(1,2); G->AddEdge(0,2);
-  G->AddEdge(1,3); G->AddEdge(3,4); G->AddEdge(2,3);
-  return G;
-}
-
 /////////////////////////////////////////////////
 // Node Edge Graph
 bool TNEGraph::HasFlag(const TGraphFlag& Flag) const {
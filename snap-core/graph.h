@@ -1,10 +1,12 @@
 //#//////////////////////////////////////////////
 /// Undirected graphs
 
-class TUNGraph;
+template <class TId, class TCnt> class TUNGraphT;
 class TBPGraph;
 //TODO:class TUNEGraph; -- undirected multigraph
 
+/// Undirected graph with 32-bit node ids and edge count (TUNGraphT<int, int>)
+typedef TUNGraphT<int, int> TUNGraph;
 /// Pointer to an undirected graph (TUNGraph)
 typedef TPt<TUNGraph> PUNGraph;
 /// Pointer to a bipartitegraph graph (TBPGraph)
@@ -12,55 +14,71 @@ typedef TPt<TBPGraph> PBPGraph;
 
 //#//////////////////////////////////////////////
 /// Directed graphs
-class TNGraph;
+template <class TId, class TCnt> class TNGraphT;
 class TNEGraph;
 
+/// Directed graph with 32-bit node ids and edge count (TNGraphT<int, int>)
+typedef TNGraphT<int, int> TNGraph;
 /// Pointer to a directed graph (TNGraph)
 typedef TPt<TNGraph> PNGraph;
 /// Pointer to a directed multigraph (TNEGraph)
 typedef TPt<TNEGraph> PNEGraph;
 
+namespace TSnapDetail {
+/// Type of node ids and edge counts of type T in vectors and hash tables.
+template <class T> struct TNIdVal { };
+template <> struct TNIdVal<int> { typedef TInt TVal; };
+template <> struct TNIdVal<int64> { typedef TInt64 TVal; };
+} // namespace TSnapDetail
+
 //#//////////////////////////////////////////////
 /// Undirected graph. ##TUNGraph::Class
-class TUNGraph {
+/// Node ids are of type TId and the number of edges of type TCnt. TUNGraph uses int for both,
+/// TUNGraph32 and TUNGraph64 (see graph64.h) count the edges with int64.
+template <class TId, class TCnt>
+class TUNGraphT {
 public:
-  typedef TUNGraph TNet;
-  typedef TPt<TUNGraph> PNet;
+  typedef TUNGraphT TNet;
+  typedef TPt<TUNGraphT> PNet;
+  typedef TId TNId;
+  typedef typename TSnapDetail::TNIdVal<TId>::TVal TNIdT;
+  typedef TVec<TNIdT> TNIdV;
+  typedef TVec<TPair<TNIdT, TNIdT> > TNIdPrV;
 public:
   class TNode {
   private:
-    TInt Id;
-    TIntV NIdV;
+    TNIdT Id;
+    TNIdV NIdV;
   public:
     TNode() : Id(-1), NIdV() { }
-    TNode(const int& NId) : Id(NId), NIdV() { }
+    TNode(const TId& NId) : Id(NId), NIdV() { }
     TNode(const TNode& Node) : Id(Node.Id), NIdV(Node.NIdV) { }
     TNode(TSIn& SIn) : Id(SIn), NIdV(SIn) { }
     void LoadShM(TShMIn& ShMIn) {
-      Id = TInt(ShMIn);
+      Id = TNIdT(ShMIn);
       NIdV.LoadShM(ShMIn);
     }
     void Save(TSOut& SOut) const { Id.Save(SOut); NIdV.Save(SOut); }
-    int GetId() const { return Id; }
+    TId GetId() const { return Id; }
     int GetDeg() const { return NIdV.Len(); }
     int GetInDeg() const { return GetDeg(); }
     int GetOutDeg() const { return GetDeg(); }
-    int GetInNId(const int& NodeN) const { return GetNbrNId(NodeN); }
-    int GetOutNId(const int& NodeN) const { return GetNbrNId(NodeN); }
-    int GetNbrNId(const int& NodeN) const { return NIdV[NodeN]; }
-    bool IsNbrNId(const int& NId) const { return NIdV.SearchBin(NId)!=-1; }
-    bool IsInNId(const int& NId) const { return IsNbrNId(NId); }
-    bool IsOutNId(const int& NId) const { return IsNbrNId(NId); }
+    TId GetInNId(const int& NodeN) const { return GetNbrNId(NodeN); }
+    TId GetOutNId(const int& NodeN) const { return GetNbrNId(NodeN); }
+    TId GetNbrNId(const int& NodeN) const { return NIdV[NodeN]; }
+    bool IsNbrNId(const TId& NId) const { return NIdV.SearchBin(NId)!=-1; }
+    bool IsInNId(const TId& NId) const { return IsNbrNId(NId); }
+    bool IsOutNId(const TId& NId) const { return IsNbrNId(NId); }
     void PackOutNIdV() { NIdV.Pack(); }
     void PackNIdV() { NIdV.Pack(); }
     void SortNIdV() { NIdV.Sort();}
-    friend class TUNGraph;
+    friend class TUNGraphT;
     friend class TUNGraphMtx;
   };
   /// Node iterator. Only forward iteration (operator++) is supported.
   class TNodeI {
   private:
-    typedef THash<TInt, TNode>::TIter THashIter;
+    typedef typename THash<TNIdT, TNode>::TIter THashIter;
     THashIter NodeHI;
   public:
     TNodeI() : NodeHI() { }
@@ -78,7 +96,7 @@ public:
     bool operator == (const TNodeI& NodeI) const { return NodeHI == NodeI.NodeHI; }
 
     /// Returns ID of the current node.
-    int GetId() const { return NodeHI.GetDat().GetId(); }
+    TId GetId() const { return NodeHI.GetDat().GetId(); }
     /// Returns degree of the current node.
     int GetDeg() const { return NodeHI.GetDat().GetDeg(); }
     /// Returns in-degree of the current node (returns same as value GetDeg() since the graph is undirected).
@@ -88,18 +106,18 @@ public:
     /// Sorts the adjacency lists of the current node.
     void SortNIdV() { NodeHI.GetDat().SortNIdV(); }
     /// Returns ID of NodeN-th in-node (the node pointing to the current node). ##TUNGraph::TNodeI::GetInNId
-    int GetInNId(const int& NodeN) const { return NodeHI.GetDat().GetInNId(NodeN); }
+    TId GetInNId(const int& NodeN) const { return NodeHI.GetDat().GetInNId(NodeN); }
     /// Returns ID of NodeN-th out-node (the node the current node points to). ##TUNGraph::TNodeI::GetOutNId
-    int GetOutNId(const int& NodeN) const { return NodeHI.GetDat().GetOutNId(NodeN); }
+    TId GetOutNId(const int& NodeN) const { return NodeHI.GetDat().GetOutNId(NodeN); }
     /// Returns ID of NodeN-th neighboring node. ##TUNGraph::TNodeI::GetNbrNId
-    int GetNbrNId(const int& NodeN) const { return NodeHI.GetDat().GetNbrNId(NodeN); }
+    TId GetNbrNId(const int& NodeN) const { return NodeHI.GetDat().GetNbrNId(NodeN); }
     /// Tests whether node with ID NId points to the current node.
-    bool IsInNId(const int& NId) const { return NodeHI.GetDat().IsInNId(NId); }
+    bool IsInNId(const TId& NId) const { return NodeHI.GetDat().IsInNId(NId); }
     /// Tests whether the current node points to node with ID NId.
-    bool IsOutNId(const int& NId) const { return NodeHI.GetDat().IsOutNId(NId); }
+    bool IsOutNId(const TId& NId) const { return NodeHI.GetDat().IsOutNId(NId); }
     /// Tests whether node with ID NId is a neighbor of the current node.
-    bool IsNbrNId(const int& NId) const { return NodeHI.GetDat().IsNbrNId(NId); }
-    friend class TUNGraph;
+    bool IsNbrNId(const TId& NId) const { return NodeHI.GetDat().IsNbrNId(NId); }
+    friend class TUNGraphT;
   };
   /// Edge iterator. Only forward iteration (operator++) is supported.
   class TEdgeI {
@@ -116,17 +134,19 @@ public:
     bool operator < (const TEdgeI& EdgeI) const { return CurNode<EdgeI.CurNode || (CurNode==EdgeI.CurNode && CurEdge<EdgeI.CurEdge); }
     bool operator == (const TEdgeI& EdgeI) const { return CurNode == EdgeI.CurNode && CurEdge == EdgeI.CurEdge; }
     /// Returns edge ID. Always returns -1 since only edges in multigraphs have explicit IDs.
-    int GetId() const { return -1; }
+    TId GetId() const { return -1; }
     /// Returns the source of the edge. Since the graph is undirected, this is the node with a smaller ID of the edge endpoints.
-    int GetSrcNId() const { return CurNode.GetId(); }
+    TId GetSrcNId() const { return CurNode.GetId(); }
     /// Returns the destination of the edge. Since the graph is undirected, this is the node with a greater ID of the edge endpoints.
-    int GetDstNId() const { return CurNode.GetOutNId(CurEdge); }
-    friend class TUNGraph;
+    TId GetDstNId() const { return CurNode.GetOutNId(CurEdge); }
+    friend class TUNGraphT;
   };
 private:
+  typedef typename TSnapDetail::TNIdVal<TCnt>::TVal TCntT;
   TCRef CRef;
-  TInt MxNId, NEdges;
-  THash<TInt, TNode> NodeH;
+  TNIdT MxNId;
+  TCntT NEdges;
+  THash<TNIdT, TNode> NodeH;
 private:
   class TLoadTNodeInitializer {
   public:
@@ -134,111 +154,113 @@ private:
     void operator() (TNode* Node, TShMIn& ShMIn) { Node->LoadShM(ShMIn);}
   };
 private:
-  TNode& GetNode(const int& NId) { return NodeH.GetDat(NId); }
-  const TNode& GetNode(const int& NId) const { return NodeH.GetDat(NId); }
+  TNode& GetNode(const TId& NId) { return NodeH.GetDat(NId); }
+  const TNode& GetNode(const TId& NId) const { return NodeH.GetDat(NId); }
   void LoadGraphShM(TShMIn& ShMIn) {
-    MxNId = TInt(ShMIn);
-    NEdges = TInt(ShMIn);
+    MxNId = TNIdT(ShMIn);
+    NEdges = TCntT(ShMIn);
     TLoadTNodeInitializer Fn;
     NodeH.LoadShM(ShMIn, Fn);
   }
 public:
-  TUNGraph() : CRef(), MxNId(0), NEdges(0), NodeH() { }
+  TUNGraphT() : CRef(), MxNId(0), NEdges(0), NodeH() { }
   /// Constructor that reserves enough memory for a graph of Nodes nodes and Edges edges.
-  explicit TUNGraph(const int& Nodes, const int& Edges) : MxNId(0), NEdges(0) { Reserve(Nodes, Edges); }
-  TUNGraph(const TUNGraph& Graph) : MxNId(Graph.MxNId), NEdges(Graph.NEdges), NodeH(Graph.NodeH) { }
+  explicit TUNGraphT(const int& Nodes, const TCnt& Edges) : MxNId(0), NEdges(0) { Reserve(Nodes, Edges); }
+  TUNGraphT(const TUNGraphT& Graph) : MxNId(Graph.MxNId), NEdges(Graph.NEdges), NodeH(Graph.NodeH) { }
   /// Constructor that loads the graph from a (binary) stream SIn.
-  TUNGraph(TSIn& SIn) : MxNId(SIn), NEdges(SIn), NodeH(SIn) { }
+  TUNGraphT(TSIn& SIn) : MxNId(SIn), NEdges(SIn), NodeH(SIn) { }
   /// Saves the graph to a (binary) stream SOut.
-
   void Save(TSOut& SOut) const { MxNId.Save(SOut); NEdges.Save(SOut); NodeH.Save(SOut); }
   /// Static constructor that returns a pointer to the graph. Call: PUNGraph Graph = TUNGraph::New().
-  static PUNGraph New() { return new TUNGraph(); }
+  static PNet New() { return new TUNGraphT(); }
   /// Static constructor that returns a pointer to the graph and reserves enough memory for Nodes nodes and Edges edges. ##TUNGraph::New
-  static PUNGraph New(const int& Nodes, const int& Edges) { return new TUNGraph(Nodes, Edges); }
+  static PNet New(const int& Nodes, const TCnt& Edges) { return new TUNGraphT(Nodes, Edges); }
   /// Static constructor that loads the graph from a stream SIn and returns a pointer to it.
-  static PUNGraph Load(TSIn& SIn) { return PUNGraph(new TUNGraph(SIn)); }
+  static PNet Load(TSIn& SIn) { return PNet(new TUNGraphT(SIn)); }
   /// Static constructor that loads the graph from shared memory ##TUNGraph::LoadShM
-  static PUNGraph LoadShM(TShMIn& ShMIn) {
-    TUNGraph* Graph = new TUNGraph();
+  static PNet LoadShM(TShMIn& ShMIn) {
+    TUNGraphT* Graph = new TUNGraphT();
     Graph->LoadGraphShM(ShMIn);
-    return PUNGraph(Graph);
-  }  /// Allows for run-time checking the type of the graph (see the TGraphFlag for flags).
-  bool HasFlag(const TGraphFlag& Flag) const;
-  TUNGraph& operator = (const TUNGraph& Graph) {
+    return PNet(Graph);
+  }
+  /// Allows for run-time checking the type of the graph (see the TGraphFlag for flags).
+  bool HasFlag(const TGraphFlag& Flag) const { return HasGraphFlag(typename TUNGraphT::TNet, Flag); }
+  TUNGraphT& operator = (const TUNGraphT& Graph) {
     if (this!=&Graph) { MxNId=Graph.MxNId; NEdges=Graph.NEdges; NodeH=Graph.NodeH; } return *this; }
-  
+
   /// Returns the number of nodes in the graph.
   int GetNodes() const { return NodeH.Len(); }
   /// Adds a node of ID NId to the graph. ##TUNGraph::AddNode
-  int AddNode(int NId = -1);
+  TId AddNode(TId NId = -1);
   /// Adds a node of ID NId to the network, noop if the node already exists. ##TUNGraph::AddNodeUnchecked
-  int AddNodeUnchecked(int NId = -1);
+  TId AddNodeUnchecked(TId NId = -1);
   /// Adds a node of ID NodeI.GetId() to the graph.
-  int AddNode(const TNodeI& NodeI) { return AddNode(NodeI.GetId()); }
+  TId AddNode(const TNodeI& NodeI) { return AddNode(NodeI.GetId()); }
   /// Adds a node of ID NId to the graph and create edges to all nodes in vector NbrNIdV. ##TUNGraph::AddNode-1
-  int AddNode(const int& NId, const TIntV& NbrNIdV);
+  TId AddNode(const TId& NId, const TNIdV& NbrNIdV);
   /// Adds a node of ID NId to the graph and create edges to all nodes in vector NIdVId in the vector pool Pool. ##TUNGraph::AddNode-2
-  int AddNode(const int& NId, const TVecPool<TInt>& Pool, const int& NIdVId);
+  TId AddNode(const TId& NId, const TVecPool<TNIdT>& Pool, const int& NIdVId);
   /// Deletes node of ID NId from the graph. ##TUNGraph::DelNode
-  void DelNode(const int& NId);
+  void DelNode(const TId& NId);
   /// Deletes node of ID NodeI.GetId() from the graph.
   void DelNode(const TNode& NodeI) { DelNode(NodeI.GetId()); }
   /// Tests whether ID NId is a node.
-  bool IsNode(const int& NId) const { return NodeH.IsKey(NId); }
+  bool IsNode(const TId& NId) const { return NodeH.IsKey(NId); }
   /// Returns an iterator referring to the first node in the graph.
   TNodeI BegNI() const { return TNodeI(NodeH.BegI()); }
   /// Returns an iterator referring to the past-the-end node in the graph.
   TNodeI EndNI() const { return TNodeI(NodeH.EndI()); }
   /// Returns an iterator referring to the node of ID NId in the graph.
-  TNodeI GetNI(const int& NId) const { return TNodeI(NodeH.GetI(NId)); }
+  TNodeI GetNI(const TId& NId) const { return TNodeI(NodeH.GetI(NId)); }
   /// Returns an ID that is larger than any node ID in the graph.
-  int GetMxNId() const { return MxNId; }
+  TId GetMxNId() const { return MxNId; }
 
   /// Returns the number of edges in the graph.
-  int GetEdges() const;
+  TCnt GetEdges() const { return NEdges; }
   /// Adds an edge between node IDs SrcNId and DstNId to the graph. ##TUNGraph::AddEdge
-  int AddEdge(const int& SrcNId, const int& DstNId);
+  int AddEdge(const TId& SrcNId, const TId& DstNId);
   /// Adds an edge between node IDs SrcNId and DstNId to the graph, ignores EId (for compatibility with TNEANet).
-  int AddEdge(const int& SrcNId, const int& DstNId, const int& EId) { return AddEdge(SrcNId, DstNId); }
+  int AddEdge(const TId& SrcNId, const TId& DstNId, const TId& EId) { return AddEdge(SrcNId, DstNId); }
   /// Adds an edge between node IDs SrcNId and DstNId to the graph. ##TUNGraph::AddEdgeUnchecked
-  int AddEdgeUnchecked(const int& SrcNId, const int& DstNId);
+  int AddEdgeUnchecked(const TId& SrcNId, const TId& DstNId);
   /// Adds an edge between node IDs SrcNId and DstNId to the graph. If nodes do not exists, create them.
-  int AddEdge2(const int& SrcNId, const int& DstNId);
+  int AddEdge2(const TId& SrcNId, const TId& DstNId);
+  /// Adds edges between node IDs EdgeV[e].Val1 and EdgeV[e].Val2 to the graph. ##TUNGraph::AddEdgeBatch
+  int AddEdgeBatch(const TNIdPrV& EdgeV);
   /// Adds an edge between EdgeI.GetSrcNId() and EdgeI.GetDstNId() to the graph.
   int AddEdge(const TEdgeI& EdgeI) { return AddEdge(EdgeI.GetSrcNId(), EdgeI.GetDstNId()); }
   /// Deletes an edge between node IDs SrcNId and DstNId from the graph. ##TUNGraph::DelEdge
-  void DelEdge(const int& SrcNId, const int& DstNId);
+  void DelEdge(const TId& SrcNId, const TId& DstNId);
   /// Tests whether an edge between node IDs SrcNId and DstNId exists in the graph.
-  bool IsEdge(const int& SrcNId, const int& DstNId) const;
+  bool IsEdge(const TId& SrcNId, const TId& DstNId) const;
   /// Tests whether an edge EId exists in the graph (for compatibility with TNEANet), always returns false.
-  bool IsEdge(const int& EId) const { return false; }
+  bool IsEdge(const TId& EId) const { return false; }
   /// Returns an iterator referring to the first edge in the graph.
   TEdgeI BegEI() const { TNodeI NI = BegNI(); TEdgeI EI(NI, EndNI(), 0); if (GetNodes() != 0 && (NI.GetOutDeg()==0 || NI.GetId()>NI.GetOutNId(0))) { EI++; } return EI; }
   /// Returns an iterator referring to the past-the-end edge in the graph.
   TEdgeI EndEI() const { return TEdgeI(EndNI(), EndNI()); }
   /// Not supported/implemented!
-  TEdgeI GetEI(const int& EId) const;
+  TEdgeI GetEI(const TId& EId) const;
   /// Returns an iterator referring to edge (SrcNId, DstNId) in the graph. ##TUNGraph::GetEI
-  TEdgeI GetEI(const int& SrcNId, const int& DstNId) const;
+  TEdgeI GetEI(const TId& SrcNId, const TId& DstNId) const;
 
   /// Returns an ID of a random node in the graph.
-  int GetRndNId(TRnd& Rnd=TInt::Rnd) { return NodeH.GetKey(NodeH.GetRndKeyId(Rnd, 0.8)); }
+  TId GetRndNId(TRnd& Rnd=TInt::Rnd) { return NodeH.GetKey(NodeH.GetRndKeyId(Rnd, 0.8)); }
   /// Returns an interator referring to a random node in the graph.
   TNodeI GetRndNI(TRnd& Rnd=TInt::Rnd) { return GetNI(GetRndNId(Rnd)); }
   /// Gets a vector IDs of all nodes in the graph.
-  void GetNIdV(TIntV& NIdV) const;
+  void GetNIdV(TNIdV& NIdV) const;
 
   /// Tests whether the graph is empty (has zero nodes).
   bool Empty() const { return GetNodes()==0; }
   /// Deletes all nodes and edges from the graph.
   void Clr() { MxNId=0; NEdges=0; NodeH.Clr(); }
-  /// Sorts the adjacency lists of each node
-  void SortNodeAdjV() { for (TNodeI NI = BegNI(); NI < EndNI(); NI++) { NI.SortNIdV();} }
+  /// Sorts the adjacency lists of each node, removes duplicate edges and recounts the edges.
+  void SortNodeAdjV();
   /// Reserves memory for a graph of Nodes nodes and Edges edges.
-  void Reserve(const int& Nodes, const int& Edges) { if (Nodes>0) NodeH.Gen(Nodes/2); }
+  void Reserve(const int& Nodes, const TCnt& Edges) { if (Nodes>0) NodeH.Gen(Nodes/2); }
   /// Reserves memory for node ID NId having Deg edges.
-  void ReserveNIdDeg(const int& NId, const int& Deg) { GetNode(NId).NIdV.Reserve(Deg); }
+  void ReserveNIdDeg(const TId& NId, const int& Deg) { GetNode(NId).NIdV.Reserve(Deg); }
   /// Defragments the graph. ##TUNGraph::Defrag
   void Defrag(const bool& OnlyNodeLinks=false);
   /// Checks the graph data structure for internal consistency. ##TUNGraph::IsOk
@@ -246,54 +268,352 @@ public:
   /// Print the graph in a human readable form to an output stream OutF.
   void Dump(FILE *OutF=stdout) const;
   /// Returns a small graph on 5 nodes and 5 edges. ##TUNGraph::GetSmallGraph
-  static PUNGraph GetSmallGraph();
+  static PNet GetSmallGraph();
 
   friend class TUNGraphMtx;
-  friend class TPt<TUNGraph>;
+  friend class TPt<TUNGraphT>;
 };
 
+// set flags
+namespace TSnap {
+template <class TId, class TCnt> struct IsEdgeBatch<TUNGraphT<TId, TCnt> > { enum { Val = 1 }; };
+template <class TId, class TCnt> struct TNIdType<TUNGraphT<TId, TCnt> > { typedef TId TNId; typedef typename TUNGraphT<TId, TCnt>::TNIdT TNIdT; };
+}
+
+// Add a node of ID NId to the graph.
+template <class TId, class TCnt>
+TId TUNGraphT<TId, TCnt>::AddNode(TId NId) {
+  if (NId == -1) {
+    NId = MxNId;  MxNId++;
+  } else {
+    IAssertR(!IsNode(NId), TStr::Fmt("NodeId %s already exists", TInt64::GetStr(NId).CStr()));
+    MxNId = TMath::Mx(NId+1, TId(MxNId));
+  }
+  NodeH.AddDat(NId, TNode(NId));
+  return NId;
+}
+
+// Add a node of ID NId to the graph.
+template <class TId, class TCnt>
+TId TUNGraphT<TId, TCnt>::AddNodeUnchecked(TId NId) {
+  if (IsNode(NId)) { return -1; }
+  MxNId = TMath::Mx(NId+1, TId(MxNId));
+  NodeH.AddDat(NId, TNode(NId));
+  return NId;
+}
+
+// Add a node of ID NId to the graph and create edges to all nodes in vector NbrNIdV.
+template <class TId, class TCnt>
+TId TUNGraphT<TId, TCnt>::AddNode(const TId& NId, const TNIdV& NbrNIdV) {
+  TId NewNId;
+  if (NId == -1) {
+    NewNId = MxNId;  MxNId++;
+  } else {
+    IAssertR(! IsNode(NId), TStr::Fmt("NodeId %s already exists", TInt64::GetStr(NId).CStr()));
+    NewNId = NId;
+    MxNId = TMath::Mx(NewNId+1, TId(MxNId));
+  }
+  TNode& Node = NodeH.AddDat(NewNId);
+  Node.Id = NewNId;
+  Node.NIdV = NbrNIdV;
+  Node.NIdV.Sort();
+  NEdges += Node.GetDeg();
+  for (int i = 0; i < NbrNIdV.Len(); i++) {
+    GetNode(NbrNIdV[i]).NIdV.AddSorted(NewNId);
+  }
+  return NewNId;
+}
+
+// Add a node of ID NId to the graph and create edges to all nodes in the vector NIdVId in the vector pool Pool).
+template <class TId, class TCnt>
+TId TUNGraphT<TId, TCnt>::AddNode(const TId& NId, const TVecPool<TNIdT>& Pool, const int& NIdVId) {
+  TId NewNId;
+  if (NId == -1) {
+    NewNId = MxNId;  MxNId++;
+  } else {
+    IAssertR(!IsNode(NId), TStr::Fmt("NodeId %s already exists", TInt64::GetStr(NId).CStr()));
+    NewNId = NId;
+    MxNId = TMath::Mx(NewNId+1, TId(MxNId));
+  }
+  TNode& Node = NodeH.AddDat(NewNId);
+  Node.Id = NewNId;
+  Node.NIdV.GenExt(Pool.GetValVPt(NIdVId), Pool.GetVLen(NIdVId));
+  Node.NIdV.Sort();
+  NEdges += Node.GetDeg();
+  return NewNId;
+}
+
+// Delete node of ID NId from the graph.
+template <class TId, class TCnt>
+void TUNGraphT<TId, TCnt>::DelNode(const TId& NId) {
+  { AssertR(IsNode(NId), TStr::Fmt("NodeId %s does not exist", TInt64::GetStr(NId).CStr()));
+  TNode& Node = GetNode(NId);
+  NEdges -= Node.GetDeg();
+  for (int e = 0; e < Node.GetDeg(); e++) {
+    const TId nbr = Node.GetNbrNId(e);
+    if (nbr == NId) { continue; }
+    TNode& N = GetNode(nbr);
+    const int n = N.NIdV.SearchBin(NId);
+    IAssert(n != -1); // if NId points to N, then N also should point back
+    if (n!= -1) { N.NIdV.Del(n); }
+  } }
+  NodeH.DelKey(NId);
+}
+
+// Add an edge between SrcNId and DstNId to the graph.
+template <class TId, class TCnt>
+int TUNGraphT<TId, TCnt>::AddEdge(const TId& SrcNId, const TId& DstNId) {
+  IAssertR(IsNode(SrcNId) && IsNode(DstNId), TStr::Fmt("%s or %s not a node.", TInt64::GetStr(SrcNId).CStr(), TInt64::GetStr(DstNId).CStr()).CStr());
+  if (IsEdge(SrcNId, DstNId)) { return -2; } // edge already exists
+  GetNode(SrcNId).NIdV.AddSorted(DstNId);
+  if (SrcNId!=DstNId) { // not a self edge
+    GetNode(DstNId).NIdV.AddSorted(SrcNId); }
+  NEdges++;
+  return -1; // no edge id
+}
+
+// Add an edge between SrcNId and DstNId to the graph.
+template <class TId, class TCnt>
+int TUNGraphT<TId, TCnt>::AddEdgeUnchecked(const TId& SrcNId, const TId& DstNId) {
+  GetNode(SrcNId).NIdV.Add(DstNId);
+  if (SrcNId!=DstNId) { // not a self edge
+    GetNode(DstNId).NIdV.Add(SrcNId); }
+  NEdges++;
+  return -1; // no edge id
+}
+
+// Add an edge between SrcNId and DstNId to the graph and create the nodes if they don't yet exist.
+template <class TId, class TCnt>
+int TUNGraphT<TId, TCnt>::AddEdge2(const TId& SrcNId, const TId& DstNId) {
+  if (! IsNode(SrcNId)) { AddNode(SrcNId); }
+  if (! IsNode(DstNId)) { AddNode(DstNId); }
+  if (GetNode(SrcNId).IsNbrNId(DstNId)) { return -2; } // edge already exists
+  GetNode(SrcNId).NIdV.AddSorted(DstNId);
+  if (SrcNId!=DstNId) { // not a self edge
+    GetNode(DstNId).NIdV.AddSorted(SrcNId); }
+  NEdges++;
+  return -1; // no edge id
+}
+
+// Add edges between EdgeV[e].Val1 and EdgeV[e].Val2 to the graph. Return the number of new edges.
+template <class TId, class TCnt>
+int TUNGraphT<TId, TCnt>::AddEdgeBatch(const TNIdPrV& EdgeV) {
+  // count the new neighbors of every node
+  TIntV AddV(NodeH.GetMxKeyIds());
+  for (int e = 0; e < EdgeV.Len(); e++) {
+    const int SrcKeyId = NodeH.GetKeyId(EdgeV[e].Val1);
+    const int DstKeyId = NodeH.GetKeyId(EdgeV[e].Val2);
+    IAssertR(SrcKeyId != -1 && DstKeyId != -1, TStr::Fmt("%s or %s not a node.", TInt64::GetStr(TId(EdgeV[e].Val1)).CStr(), TInt64::GetStr(TId(EdgeV[e].Val2)).CStr()).CStr());
+    AddV[SrcKeyId]++;
+    if (SrcKeyId != DstKeyId) { AddV[DstKeyId]++; }
+  }
+  TIntV KeyIdV, SortedLenV;
+  TBoolV SelfV;
+  for (int KeyId = 0; KeyId < AddV.Len(); KeyId++) {
+    if (AddV[KeyId] == 0) { continue; }
+    TNode& Node = NodeH[KeyId];
+    KeyIdV.Add(KeyId);
+    SortedLenV.Add(Node.NIdV.Len());
+    SelfV.Add(Node.IsNbrNId(Node.GetId()));
+    Node.NIdV.Reserve(Node.NIdV.Len() + AddV[KeyId]);
+  }
+  for (int e = 0; e < EdgeV.Len(); e++) {
+    const TId SrcNId = EdgeV[e].Val1, DstNId = EdgeV[e].Val2;
+    GetNode(SrcNId).NIdV.Add(DstNId);
+    if (SrcNId != DstNId) { GetNode(DstNId).NIdV.Add(SrcNId); }
+  }
+  // every new edge appears in the lists of both nodes, a new self edge only once
+  int NewNbrs = 0, NewSelf = 0;
+  #pragma omp parallel for schedule(dynamic,1000) reduction(+:NewNbrs,NewSelf)
+  for (int k = 0; k < KeyIdV.Len(); k++) {
+    TNode& Node = NodeH[KeyIdV[k]];
+    NewNbrs += TSnapDetail::MergeBatchNIdV(Node.NIdV, SortedLenV[k]);
+    if (! SelfV[k] && Node.IsNbrNId(Node.GetId())) { NewSelf++; }
+  }
+  const int NewEdges = (NewNbrs + NewSelf) / 2;
+  NEdges += NewEdges;
+  return NewEdges;
+}
+
+// Delete an edge between node IDs SrcNId and DstNId from the graph.
+template <class TId, class TCnt>
+void TUNGraphT<TId, TCnt>::DelEdge(const TId& SrcNId, const TId& DstNId) {
+  IAssertR(IsNode(SrcNId) && IsNode(DstNId), TStr::Fmt("%s or %s not a node.", TInt64::GetStr(SrcNId).CStr(), TInt64::GetStr(DstNId).CStr()).CStr());
+  { TNode& N = GetNode(SrcNId);
+  const int n = N.NIdV.SearchBin(DstNId);
+  if (n!= -1) { N.NIdV.Del(n);  NEdges--; } }
+  if (SrcNId != DstNId) { // not a self edge
+    TNode& N = GetNode(DstNId);
+    const int n = N.NIdV.SearchBin(SrcNId);
+    if (n!= -1) { N.NIdV.Del(n); }
+  }
+}
+
+// Test whether an edge between node IDs SrcNId and DstNId exists the graph.
+template <class TId, class TCnt>
+bool TUNGraphT<TId, TCnt>::IsEdge(const TId& SrcNId, const TId& DstNId) const {
+  if (! IsNode(SrcNId) || ! IsNode(DstNId)) return false;
+  return GetNode(SrcNId).IsNbrNId(DstNId);
+}
+
+// Return an iterator referring to edge (SrcNId, DstNId) in the graph.
+template <class TId, class TCnt>
+typename TUNGraphT<TId, TCnt>::TEdgeI TUNGraphT<TId, TCnt>::GetEI(const TId& SrcNId, const TId& DstNId) const {
+  const TId MnNId = TMath::Mn(SrcNId, DstNId);
+  const TId MxNId = TMath::Mx(SrcNId, DstNId);
+  const TNodeI SrcNI = GetNI(MnNId);
+  const int NodeN = SrcNI.NodeHI.GetDat().NIdV.SearchBin(MxNId);
+  IAssert(NodeN != -1);
+  return TEdgeI(SrcNI, EndNI(), NodeN);
+}
+
+// Get a vector IDs of all nodes in the graph.
+template <class TId, class TCnt>
+void TUNGraphT<TId, TCnt>::GetNIdV(TNIdV& NIdV) const {
+  NIdV.Gen(GetNodes(), 0);
+  for (int N=NodeH.FFirstKeyId(); NodeH.FNextKeyId(N); ) {
+    NIdV.Add(NodeH.GetKey(N)); }
+}
+
+// Sort the adjacency lists, remove duplicate edges and recount the edges.
+template <class TId, class TCnt>
+void TUNGraphT<TId, TCnt>::SortNodeAdjV() {
+  int64 Nbrs = 0, Self = 0;
+  #pragma omp parallel for schedule(dynamic,1000) reduction(+:Nbrs,Self)
+  for (int KeyId = 0; KeyId < NodeH.GetMxKeyIds(); KeyId++) {
+    if (! NodeH.IsKeyId(KeyId)) { continue; }
+    TNode& Node = NodeH[KeyId];
+    Nbrs += TSnapDetail::MergeBatchNIdV(Node.NIdV, 0);
+    if (Node.IsNbrNId(Node.GetId())) { Self++; }
+  }
+  NEdges = TCnt((Nbrs + Self) / 2);
+}
+
+// Defragment the graph.
+template <class TId, class TCnt>
+void TUNGraphT<TId, TCnt>::Defrag(const bool& OnlyNodeLinks) {
+  for (int n = NodeH.FFirstKeyId(); NodeH.FNextKeyId(n); ) {
+    NodeH[n].NIdV.Pack();
+  }
+  if (! OnlyNodeLinks && ! NodeH.IsKeyIdEqKeyN()) {
+    NodeH.Defrag();
+  }
+}
+
+// Check the graph data structure for internal consistency.
+template <class TId, class TCnt>
+bool TUNGraphT<TId, TCnt>::IsOk(const bool& ThrowExcept) const {
+  bool RetVal = true;
+  int64 Nbrs = 0, Self = 0;
+  for (int N = NodeH.FFirstKeyId(); NodeH.FNextKeyId(N); ) {
+    const TNode& Node = NodeH[N];
+    const TStr NIdStr = TInt64::GetStr(Node.GetId());
+    if (! Node.NIdV.IsSorted()) {
+      const TStr Msg = TStr::Fmt("Neighbor list of node %s is not sorted.", NIdStr.CStr());
+      if (ThrowExcept) { EAssertR(false, Msg); } else { ErrNotify(Msg.CStr()); }
+      RetVal=false;
+    }
+    for (int e = 0; e < Node.GetDeg(); e++) {
+      if (! IsNode(Node.GetNbrNId(e)) || ! GetNode(Node.GetNbrNId(e)).IsNbrNId(Node.GetId())) {
+        const TStr Msg = TStr::Fmt("Edge %s --> %s: node does not exist or has no edge back.",
+          NIdStr.CStr(), TInt64::GetStr(Node.GetNbrNId(e)).CStr());
+        if (ThrowExcept) { EAssertR(false, Msg); } else { ErrNotify(Msg.CStr()); }
+        RetVal=false;
+      }
+      if (e > 0 && Node.GetNbrNId(e-1) == Node.GetNbrNId(e)) {
+        const TStr Msg = TStr::Fmt("Node %s has duplicate edge %s --> %s.",
+          NIdStr.CStr(), NIdStr.CStr(), TInt64::GetStr(Node.GetNbrNId(e)).CStr());
+        if (ThrowExcept) { EAssertR(false, Msg); } else { ErrNotify(Msg.CStr()); }
+        RetVal=false;
+      }
+    }
+    Nbrs += Node.GetDeg();
+    if (Node.IsNbrNId(Node.GetId())) { Self++; }
+  }
+  if ((Nbrs + Self) / 2 != GetEdges()) {
+    const TStr Msg = TStr::Fmt("Number of edges counter is corrupted: GetEdges():%s, EdgeCount:%s.",
+      TInt64::GetStr(GetEdges()).CStr(), TInt64::GetStr((Nbrs + Self) / 2).CStr());
+    if (ThrowExcept) { EAssertR(false, Msg); } else { ErrNotify(Msg.CStr()); }
+    RetVal=false;
+  }
+  return RetVal;
+}
+
+// Print the graph in a human readable form to an output stream OutF.
+template <class TId, class TCnt>
+void TUNGraphT<TId, TCnt>::Dump(FILE *OutF) const {
+  const int NodePlaces = (int) ceil(log10((double) GetNodes()));
+  fprintf(OutF, "-------------------------------------------------\nUndirected Node Graph: nodes: %d, edges: %s\n", GetNodes(), TInt64::GetStr(GetEdges()).CStr());
+  for (int N = NodeH.FFirstKeyId(); NodeH.FNextKeyId(N); ) {
+    const TNode& Node = NodeH[N];
+    fprintf(OutF, "  %*s [%d] ", NodePlaces, TInt64::GetStr(Node.GetId()).CStr(), Node.GetDeg());
+    for (int edge = 0; edge < Node.GetDeg(); edge++) {
+      fprintf(OutF, " %*s", NodePlaces, TInt64::GetStr(Node.GetNbrNId(edge)).CStr()); }
+    fprintf(OutF, "\n");
+  }
+  fprintf(OutF, "\n");
+}
+
+// Return a small graph on 5 nodes and 5 edges.
+template <class TId, class TCnt>
+typename TUNGraphT<TId, TCnt>::PNet TUNGraphT<TId, TCnt>::GetSmallGraph() {
+  PNet Graph = TUNGraphT::New();
+  for (int i = 0; i < 5; i++) { Graph->AddNode(i); }
+  Graph->AddEdge(0,1);  Graph->AddEdge(0,2);
+  Graph->AddEdge(0,3);  Graph->AddEdge(0,4);
+  Graph->AddEdge(1,2);
+  return Graph;
+}
+
 //#//////////////////////////////////////////////
 /// Directed graph. ##TNGraph::Class
-class TNGraph {
+/// Node ids are of type TId and the number of edges of type TCnt. TNGraph uses int for both,
+/// TNGraph32 and TNGraph64 (see graph64.h) count the edges with int64.
+template <class TId, class TCnt>
+class TNGraphT {
 public:
-  typedef TNGraph TNet;
-  typedef TPt<TNGraph> PNet;
+  typedef TNGraphT TNet;
+  typedef TPt<TNGraphT> PNet;
+  typedef TId TNId;
+  typedef typename TSnapDetail::TNIdVal<TId>::TVal TNIdT;
+  typedef TVec<TNIdT> TNIdV;
+  typedef TVec<TPair<TNIdT, TNIdT> > TNIdPrV;
 public:
   class TNode {
   private:
-    TInt Id;
-    TIntV InNIdV, OutNIdV;
+    TNIdT Id;
+    TNIdV InNIdV, OutNIdV;
   public:
     TNode() : Id(-1), InNIdV(), OutNIdV() { }
-    TNode(const int& NId) : Id(NId), InNIdV(), OutNIdV() { }
+    TNode(const TId& NId) : Id(NId), InNIdV(), OutNIdV() { }
     TNode(const TNode& Node) : Id(Node.Id), InNIdV(Node.InNIdV), OutNIdV(Node.OutNIdV) { }
     TNode(TSIn& SIn) : Id(SIn), InNIdV(SIn), OutNIdV(SIn) { }
     void Save(TSOut& SOut) const { Id.Save(SOut); InNIdV.Save(SOut); OutNIdV.Save(SOut); }
-    int GetId() const { return Id; }
+    TId GetId() const { return Id; }
     int GetDeg() const { return GetInDeg() + GetOutDeg(); }
     int GetInDeg() const { return InNIdV.Len(); }
     int GetOutDeg() const { return OutNIdV.Len(); }
-    int GetInNId(const int& NodeN) const { return InNIdV[NodeN]; }
-    int GetOutNId(const int& NodeN) const { return OutNIdV[NodeN]; }
-    int GetNbrNId(const int& NodeN) const { return NodeN<GetOutDeg()?GetOutNId(NodeN):GetInNId(NodeN-GetOutDeg()); }
-    bool IsInNId(const int& NId) const { return InNIdV.SearchBin(NId) != -1; }
-    bool IsOutNId(const int& NId) const { return OutNIdV.SearchBin(NId) != -1; }
-    bool IsNbrNId(const int& NId) const { return IsOutNId(NId) || IsInNId(NId); }
+    TId GetInNId(const int& NodeN) const { return InNIdV[NodeN]; }
+    TId GetOutNId(const int& NodeN) const { return OutNIdV[NodeN]; }
+    TId GetNbrNId(const int& NodeN) const { return NodeN<GetOutDeg()?GetOutNId(NodeN):GetInNId(NodeN-GetOutDeg()); }
+    bool IsInNId(const TId& NId) const { return InNIdV.SearchBin(NId) != -1; }
+    bool IsOutNId(const TId& NId) const { return OutNIdV.SearchBin(NId) != -1; }
+    bool IsNbrNId(const TId& NId) const { return IsOutNId(NId) || IsInNId(NId); }
     void PackOutNIdV() { OutNIdV.Pack(); }
     void PackNIdV() { InNIdV.Pack(); }
     void SortNIdV() { InNIdV.Sort(); OutNIdV.Sort();}
     void LoadShM(TShMIn& ShMIn) {
-      Id = TInt(ShMIn);
+      Id = TNIdT(ShMIn);
       InNIdV.LoadShM(ShMIn);
       OutNIdV.LoadShM(ShMIn);
     }
-    friend class TNGraph;
+    friend class TNGraphT;
     friend class TNGraphMtx;
   };
   /// Node iterator. Only forward iteration (operator++) is supported.
   class TNodeI {
   private:
-    typedef THash<TInt, TNode>::TIter THashIter;
+    typedef typename THash<TNIdT, TNode>::TIter THashIter;
     THashIter NodeHI;
   public:
     TNodeI() : NodeHI() { }
@@ -308,7 +628,7 @@ public:
     bool operator < (const TNodeI& NodeI) const { return NodeHI < NodeI.NodeHI; }
     bool operator == (const TNodeI& NodeI) const { return NodeHI == NodeI.NodeHI; }
     /// Returns ID of the current node.
-    int GetId() const { return NodeHI.GetDat().GetId(); }
+    TId GetId() const { return NodeHI.GetDat().GetId(); }
     /// Returns degree of the current node, the sum of in-degree and out-degree.
     int GetDeg() const { return NodeHI.GetDat().GetDeg(); }
     /// Returns in-degree of the current node.
@@ -318,18 +638,18 @@ public:
     /// Sorts the adjacency lists of the current node.
     void SortNIdV() { NodeHI.GetDat().SortNIdV(); }
     /// Returns ID of NodeN-th in-node (the node pointing to the current node). ##TNGraph::TNodeI::GetInNId
-    int GetInNId(const int& NodeN) const { return NodeHI.GetDat().GetInNId(NodeN); }
+    TId GetInNId(const int& NodeN) const { return NodeHI.GetDat().GetInNId(NodeN); }
     /// Returns ID of NodeN-th out-node (the node the current node points to). ##TNGraph::TNodeI::GetOutNId
-    int GetOutNId(const int& NodeN) const { return NodeHI.GetDat().GetOutNId(NodeN); }
+    TId GetOutNId(const int& NodeN) const { return NodeHI.GetDat().GetOutNId(NodeN); }
     /// Returns ID of NodeN-th neighboring node. ##TNGraph::TNodeI::GetNbrNId
-    int GetNbrNId(const int& NodeN) const { return NodeHI.GetDat().GetNbrNId(NodeN); }
+    TId GetNbrNId(const int& NodeN) const { return NodeHI.GetDat().GetNbrNId(NodeN); }
     /// Tests whether node with ID NId points to the current node.
-    bool IsInNId(const int& NId) const { return NodeHI.GetDat().IsInNId(NId); }
+    bool IsInNId(const TId& NId) const { return NodeHI.GetDat().IsInNId(NId); }
     /// Tests whether the current node points to node with ID NId.
-    bool IsOutNId(const int& NId) const { return NodeHI.GetDat().IsOutNId(NId); }
+    bool IsOutNId(const TId& NId) const { return NodeHI.GetDat().IsOutNId(NId); }
     /// Tests whether node with ID NId is a neighbor of the current node.
-    bool IsNbrNId(const int& NId) const { return IsOutNId(NId) || IsInNId(NId); }
-    friend class TNGraph;
+    bool IsNbrNId(const TId& NId) const { return IsOutNId(NId) || IsInNId(NId); }
+    friend class TNGraphT;
   };
   /// Edge iterator. Only forward iteration (operator++) is supported.
   class TEdgeI {
@@ -347,17 +667,19 @@ public:
     bool operator < (const TEdgeI& EdgeI) const { return CurNode<EdgeI.CurNode || (CurNode==EdgeI.CurNode && CurEdge<EdgeI.CurEdge); }
     bool operator == (const TEdgeI& EdgeI) const { return CurNode == EdgeI.CurNode && CurEdge == EdgeI.CurEdge; }
     /// Returns edge ID. Always returns -1 since only edges in multigraphs have explicit IDs.
-    int GetId() const { return -1; }
+    TId GetId() const { return -1; }
     /// Returns the source node of the edge.
-    int GetSrcNId() const { return CurNode.GetId(); }
+    TId GetSrcNId() const { return CurNode.GetId(); }
     /// Returns the destination node of the edge.
-    int GetDstNId() const { return CurNode.GetOutNId(CurEdge); }
-    friend class TNGraph;
+    TId GetDstNId() const { return CurNode.GetOutNId(CurEdge); }
+    friend class TNGraphT;
   };
 private:
+  typedef typename TSnapDetail::TNIdVal<TCnt>::TVal TCntT;
   TCRef CRef;
-  TInt MxNId;
-  THash<TInt, TNode> NodeH;
+  TNIdT MxNId;
+  TCntT NEdges;
+  THash<TNIdT, TNode> NodeH;
 private:
   class TLoadTNodeInitializer {
   public:
@@ -365,115 +687,124 @@ private:
     void operator() (TNode* Node, TShMIn& ShMIn) {Node->LoadShM(ShMIn);}
   };
 private:
-  TNode& GetNode(const int& NId) { return NodeH.GetDat(NId); }
-  const TNode& GetNode(const int& NId) const { return NodeH.GetDat(NId); }
+  TNode& GetNode(const TId& NId) { return NodeH.GetDat(NId); }
+  const TNode& GetNode(const TId& NId) const { return NodeH.GetDat(NId); }
   void LoadGraphShM(TShMIn& ShMIn) {
-    MxNId = TInt(ShMIn);
+    MxNId = TNIdT(ShMIn);
     TLoadTNodeInitializer Fn;
     NodeH.LoadShM(ShMIn, Fn);
+    NEdges = CountEdges();
+  }
+  // The edge counter is not saved, it is the sum of the out-degrees.
+  TCnt CountEdges() const {
+    int64 Edges = 0;
+    for (int N = NodeH.FFirstKeyId(); NodeH.FNextKeyId(N); ) { Edges += NodeH[N].GetOutDeg(); }
+    return TCnt(Edges);
   }
 
 public:
-  TNGraph() : CRef(), MxNId(0), NodeH() { }
+  TNGraphT() : CRef(), MxNId(0), NEdges(0), NodeH() { }
   /// Constructor that reserves enough memory for a graph of Nodes nodes and Edges edges.
-  explicit TNGraph(const int& Nodes, const int& Edges) : MxNId(0) { Reserve(Nodes, Edges); }
-  TNGraph(const TNGraph& Graph) : MxNId(Graph.MxNId), NodeH(Graph.NodeH) { }
+  explicit TNGraphT(const int& Nodes, const TCnt& Edges) : MxNId(0), NEdges(0) { Reserve(Nodes, Edges); }
+  TNGraphT(const TNGraphT& Graph) : MxNId(Graph.MxNId), NEdges(Graph.NEdges), NodeH(Graph.NodeH) { }
   /// Constructor that loads the graph from a (binary) stream SIn.
-  TNGraph(TSIn& SIn) : MxNId(SIn), NodeH(SIn) { }
+  TNGraphT(TSIn& SIn) : MxNId(SIn), NEdges(0), NodeH(SIn) { NEdges = CountEdges(); }
   /// Saves the graph to a (binary) stream SOut.
   void Save(TSOut& SOut) const { MxNId.Save(SOut); NodeH.Save(SOut); }
   /// Static constructor that returns a pointer to the graph. Call: PNGraph Graph = TNGraph::New().
-  static PNGraph New() { return new TNGraph(); }
+  static PNet New() { return new TNGraphT(); }
   /// Static constructor that returns a pointer to the graph and reserves enough memory for Nodes nodes and Edges edges. ##TNGraph::New
-  static PNGraph New(const int& Nodes, const int& Edges) { return new TNGraph(Nodes, Edges); }
+  static PNet New(const int& Nodes, const TCnt& Edges) { return new TNGraphT(Nodes, Edges); }
   /// Static constructor that loads the graph from a stream SIn and returns a pointer to it.
-  static PNGraph Load(TSIn& SIn) { return PNGraph(new TNGraph(SIn)); }
+  static PNet Load(TSIn& SIn) { return PNet(new TNGraphT(SIn)); }
   /// Static constructor that loads the graph from a shared memory stream and returns pointer to it. ##TNGraph::LoadShM
-  static PNGraph LoadShM(TShMIn& ShMIn) {
-    TNGraph* Graph = new TNGraph();
+  static PNet LoadShM(TShMIn& ShMIn) {
+    TNGraphT* Graph = new TNGraphT();
     Graph->LoadGraphShM(ShMIn);
-    return PNGraph(Graph);
+    return PNet(Graph);
   }
   /// Allows for run-time checking the type of the graph (see the TGraphFlag for flags).
-  bool HasFlag(const TGraphFlag& Flag) const;
-  TNGraph& operator = (const TNGraph& Graph) {
-    if (this!=&Graph) { MxNId=Graph.MxNId; NodeH=Graph.NodeH; }  return *this; }
-  
+  bool HasFlag(const TGraphFlag& Flag) const { return HasGraphFlag(typename TNGraphT::TNet, Flag); }
+  TNGraphT& operator = (const TNGraphT& Graph) {
+    if (this!=&Graph) { MxNId=Graph.MxNId; NEdges=Graph.NEdges; NodeH=Graph.NodeH; }  return *this; }
+
   /// Returns the number of nodes in the graph.
   int GetNodes() const { return NodeH.Len(); }
   /// Adds a node of ID NId to the graph. ##TNGraph::AddNode
-  int AddNode(int NId = -1);
+  TId AddNode(TId NId = -1);
   /// Adds a node of ID NId to the network, noop if the node already exists. ##TNGraph::AddNodeUnchecked
-  int AddNodeUnchecked(int NId = -1);
+  TId AddNodeUnchecked(TId NId = -1);
   /// Adds a node of ID NodeI.GetId() to the graph.
-  int AddNode(const TNodeI& NodeId) { return AddNode(NodeId.GetId()); }
+  TId AddNode(const TNodeI& NodeId) { return AddNode(NodeId.GetId()); }
   /// Adds a node of ID NId to the graph, creates edges to the node from all nodes in vector InNIdV, creates edges from the node to all nodes in vector OutNIdV. ##TNGraph::AddNode-1
-  int AddNode(const int& NId, const TIntV& InNIdV, const TIntV& OutNIdV);
+  TId AddNode(const TId& NId, const TNIdV& InNIdV, const TNIdV& OutNIdV);
   /// Adds a node of ID NId to the graph, creates edges to the node from all nodes in vector InNIdV in the vector pool Pool, creates edges from the node to all nodes in vector OutNIdVin the vector pool Pool . ##TNGraph::AddNode-2
-  int AddNode(const int& NId, const TVecPool<TInt>& Pool, const int& SrcVId, const int& DstVId);
+  TId AddNode(const TId& NId, const TVecPool<TNIdT>& Pool, const int& SrcVId, const int& DstVId);
   /// Deletes node of ID NId from the graph. ##TNGraph::DelNode
-  void DelNode(const int& NId);
+  void DelNode(const TId& NId);
   /// Deletes node of ID NodeI.GetId() from the graph.
   void DelNode(const TNode& NodeI) { DelNode(NodeI.GetId()); }
   /// Tests whether ID NId is a node.
-  bool IsNode(const int& NId) const { return NodeH.IsKey(NId); }
+  bool IsNode(const TId& NId) const { return NodeH.IsKey(NId); }
   /// Returns an iterator referring to the first node in the graph.
   TNodeI BegNI() const { return TNodeI(NodeH.BegI()); }
   /// Returns an iterator referring to the past-the-end node in the graph.
   TNodeI EndNI() const { return TNodeI(NodeH.EndI()); }
   /// Returns an iterator referring to the node of ID NId in the graph.
-  TNodeI GetNI(const int& NId) const { return TNodeI(NodeH.GetI(NId)); }
+  TNodeI GetNI(const TId& NId) const { return TNodeI(NodeH.GetI(NId)); }
   // GetNodeC() has been commented out. It was a quick shortcut, do not use.
   //const TNode& GetNodeC(const int& NId) const { return NodeH.GetDat(NId); }
   /// Returns an ID that is larger than any node ID in the graph.
-  int GetMxNId() const { return MxNId; }
+  TId GetMxNId() const { return MxNId; }
 
   /// Returns the number of edges in the graph.
-  int GetEdges() const;
+  TCnt GetEdges() const { return NEdges; }
   /// Adds an edge from node SrcNId to node DstNId to the graph. ##TNGraph::AddEdge
-  int AddEdge(const int& SrcNId, const int& DstNId);
+  int AddEdge(const TId& SrcNId, const TId& DstNId);
   /// Adds an edge between node IDs SrcNId and DstNId to the graph, ignores EId (for compatibility with TNEANet).
-  int AddEdge(const int& SrcNId, const int& DstNId, const int& EId) { return AddEdge(SrcNId, DstNId); }
+  int AddEdge(const TId& SrcNId, const TId& DstNId, const TId& EId) { return AddEdge(SrcNId, DstNId); }
   /// Adds an edge from node SrcNId to node DstNId to the graph. ##TNGraph::AddEdgeUnchecked
-  int AddEdgeUnchecked(const int& SrcNId, const int& DstNId);
+  int AddEdgeUnchecked(const TId& SrcNId, const TId& DstNId);
   /// Adds an edge from node IDs SrcNId to node DstNId to the graph. If nodes do not exist, create them.
-  int AddEdge2(const int& SrcNId, const int& DstNId);
+  int AddEdge2(const TId& SrcNId, const TId& DstNId);
+  /// Adds edges from node IDs EdgeV[e].Val1 to node IDs EdgeV[e].Val2 to the graph. ##TNGraph::AddEdgeBatch
+  int AddEdgeBatch(const TNIdPrV& EdgeV);
   /// Adds an edge from EdgeI.GetSrcNId() to EdgeI.GetDstNId() to the graph.
   int AddEdge(const TEdgeI& EdgeI) { return AddEdge(EdgeI.GetSrcNId(), EdgeI.GetDstNId()); }
   /// Deletes an edge from node IDs SrcNId to DstNId from the graph. ##TNGraph::DelEdge
-  void DelEdge(const int& SrcNId, const int& DstNId, const bool& IsDir = true);
+  void DelEdge(const TId& SrcNId, const TId& DstNId, const bool& IsDir = true);
   /// Tests whether an edge from node IDs SrcNId to DstNId exists in the graph.
-  bool IsEdge(const int& SrcNId, const int& DstNId, const bool& IsDir = true) const;
+  bool IsEdge(const TId& SrcNId, const TId& DstNId, const bool& IsDir = true) const;
   /// Tests whether an edge EId exists in the graph (for compatibility with TNEANet), always returns false.
-  bool IsEdge(const int& EId) const { return false; }
+  bool IsEdge(const TId& EId) const { return false; }
   /// Returns an iterator referring to the first edge in the graph.
   TEdgeI BegEI() const { TNodeI NI=BegNI(); while(NI<EndNI() && NI.GetOutDeg()==0){NI++;} return TEdgeI(NI, EndNI()); }
   /// Returns an iterator referring to the past-the-end edge in the graph.
   TEdgeI EndEI() const { return TEdgeI(EndNI(), EndNI()); }
   /// Not supported/implemented!
-  TEdgeI GetEI(const int& EId) const; // not supported
+  TEdgeI GetEI(const TId& EId) const; // not supported
   /// Returns an iterator referring to edge (SrcNId, DstNId) in the graph.
-  TEdgeI GetEI(const int& SrcNId, const int& DstNId) const;
+  TEdgeI GetEI(const TId& SrcNId, const TId& DstNId) const;
 
   /// Returns an ID of a random node in the graph.
-  int GetRndNId(TRnd& Rnd=TInt::Rnd) { return NodeH.GetKey(NodeH.GetRndKeyId(Rnd, 0.8)); }
+  TId GetRndNId(TRnd& Rnd=TInt::Rnd) { return NodeH.GetKey(NodeH.GetRndKeyId(Rnd, 0.8)); }
   /// Returns an interator referring to a random node in the graph.
   TNodeI GetRndNI(TRnd& Rnd=TInt::Rnd) { return GetNI(GetRndNId(Rnd)); }
   /// Gets a vector IDs of all nodes in the graph.
-  void GetNIdV(TIntV& NIdV) const;
+  void GetNIdV(TNIdV& NIdV) const;
 
   /// Tests whether the graph is empty (has zero nodes).
   bool Empty() const { return GetNodes()==0; }
   /// Deletes all nodes and edges from the graph.
-  void Clr() { MxNId=0; NodeH.Clr(); }
+  void Clr() { MxNId=0; NEdges=0; NodeH.Clr(); }
   /// Reserves memory for a graph of Nodes nodes and Edges edges.
-  void Reserve(const int& Nodes, const int& Edges) { if (Nodes>0) { NodeH.Gen(Nodes/2); } }
+  void Reserve(const int& Nodes, const TCnt& Edges) { if (Nodes>0) { NodeH.Gen(Nodes/2); } }
   /// Reserves memory for node ID NId having InDeg in-edges.
-  void ReserveNIdInDeg(const int& NId, const int& InDeg) { GetNode(NId).InNIdV.Reserve(InDeg); }
+  void ReserveNIdInDeg(const TId& NId, const int& InDeg) { GetNode(NId).InNIdV.Reserve(InDeg); }
   /// Reserves memory for node ID NId having OutDeg out-edges.
-  void ReserveNIdOutDeg(const int& NId, const int& OutDeg) { GetNode(NId).OutNIdV.Reserve(OutDeg); }
-  /// Sorts the adjacency lists of each node
-  void SortNodeAdjV() { for (TNodeI NI = BegNI(); NI < EndNI(); NI++) { NI.SortNIdV();} }
+  void ReserveNIdOutDeg(const TId& NId, const int& OutDeg) { GetNode(NId).OutNIdV.Reserve(OutDeg); }
+  /// Sorts the adjacency lists of each node, removes duplicate edges and recounts the edges.
+  void SortNodeAdjV();
   /// Defragments the graph. ##TNGraph::Defrag
   void Defrag(const bool& OnlyNodeLinks=false);
   /// Checks the graph data structure for internal consistency. ##TNGraph::IsOk
@@ -481,14 +812,311 @@ public:
   /// Print the graph in a human readable form to an output stream OutF.
   void Dump(FILE *OutF=stdout) const;
   /// Returns a small graph on 5 nodes and 6 edges. ##TNGraph::GetSmallGraph
-  static PNGraph GetSmallGraph();
-  friend class TPt<TNGraph>;
+  static PNet GetSmallGraph();
+  friend class TPt<TNGraphT>;
   friend class TNGraphMtx;
 };
 
 // set flags
 namespace TSnap {
-template <> struct IsDirected<TNGraph> { enum { Val = 1 }; };
+template <class TId, class TCnt> struct IsDirected<TNGraphT<TId, TCnt> > { enum { Val = 1 }; };
+template <class TId, class TCnt> struct IsEdgeBatch<TNGraphT<TId, TCnt> > { enum { Val = 1 }; };
+template <class TId, class TCnt> struct TNIdType<TNGraphT<TId, TCnt> > { typedef TId TNId; typedef typename TNGraphT<TId, TCnt>::TNIdT TNIdT; };
+}
+
+template <class TId, class TCnt>
+TId TNGraphT<TId, TCnt>::AddNode(TId NId) {
+  if (NId == -1) {
+    NId = MxNId;  MxNId++;
+  } else {
+    IAssertR(!IsNode(NId), TStr::Fmt("NodeId %s already exists", TInt64::GetStr(NId).CStr()));
+    MxNId = TMath::Mx(NId+1, TId(MxNId));
+  }
+  NodeH.AddDat(NId, TNode(NId));
+  return NId;
+}
+
+template <class TId, class TCnt>
+TId TNGraphT<TId, TCnt>::AddNodeUnchecked(TId NId) {
+  if (IsNode(NId)) { return -1;}
+  MxNId = TMath::Mx(NId+1, TId(MxNId));
+  NodeH.AddDat(NId, TNode(NId));
+  return NId;
+}
+
+// add a node with a list of neighbors
+// (use TNGraph::IsOk to check whether the graph is consistent)
+template <class TId, class TCnt>
+TId TNGraphT<TId, TCnt>::AddNode(const TId& NId, const TNIdV& InNIdV, const TNIdV& OutNIdV) {
+  TId NewNId;
+  if (NId == -1) {
+    NewNId = MxNId;  MxNId++;
+  } else {
+    IAssertR(!IsNode(NId), TStr::Fmt("NodeId %s already exists", TInt64::GetStr(NId).CStr()));
+    NewNId = NId;
+    MxNId = TMath::Mx(NewNId+1, TId(MxNId));
+  }
+  TNode& Node = NodeH.AddDat(NewNId);
+  Node.Id = NewNId;
+  Node.InNIdV = InNIdV;
+  Node.OutNIdV = OutNIdV;
+  Node.InNIdV.Sort();
+  Node.OutNIdV.Sort();
+  NEdges += Node.GetOutDeg();
+  return NewNId;
+}
+
+// add a node from a vector pool
+// (use TNGraph::IsOk to check whether the graph is consistent)
+template <class TId, class TCnt>
+TId TNGraphT<TId, TCnt>::AddNode(const TId& NId, const TVecPool<TNIdT>& Pool, const int& SrcVId, const int& DstVId) {
+  TId NewNId;
+  if (NId == -1) {
+    NewNId = MxNId;  MxNId++;
+  } else {
+    IAssertR(!IsNode(NId), TStr::Fmt("NodeId %s already exists", TInt64::GetStr(NId).CStr()));
+    NewNId = NId;
+    MxNId = TMath::Mx(NewNId+1, TId(MxNId));
+  }
+  TNode& Node = NodeH.AddDat(NewNId);
+  Node.Id = NewNId;
+  Node.InNIdV.GenExt(Pool.GetValVPt(SrcVId), Pool.GetVLen(SrcVId));
+  Node.OutNIdV.GenExt(Pool.GetValVPt(DstVId), Pool.GetVLen(DstVId));
+  Node.InNIdV.Sort();
+  Node.OutNIdV.Sort();
+  NEdges += Node.GetOutDeg();
+  return NewNId;
+}
+
+template <class TId, class TCnt>
+void TNGraphT<TId, TCnt>::DelNode(const TId& NId) {
+  { TNode& Node = GetNode(NId);
+  NEdges -= Node.GetOutDeg();
+  for (int e = 0; e < Node.GetOutDeg(); e++) {
+    const TId nbr = Node.GetOutNId(e);
+    if (nbr == NId) { continue; }
+    TNode& N = GetNode(nbr);
+    const int n = N.InNIdV.SearchBin(NId);
+    if (n!= -1) { N.InNIdV.Del(n); }
+  }
+  for (int e = 0; e < Node.GetInDeg(); e++) {
+    const TId nbr = Node.GetInNId(e);
+    if (nbr == NId) { continue; }
+    TNode& N = GetNode(nbr);
+    const int n = N.OutNIdV.SearchBin(NId);
+    if (n!= -1) { N.OutNIdV.Del(n);  NEdges--; }
+  } }
+  NodeH.DelKey(NId);
+}
+
+template <class TId, class TCnt>
+int TNGraphT<TId, TCnt>::AddEdge(const TId& SrcNId, const TId& DstNId) {
+  IAssertR(IsNode(SrcNId) && IsNode(DstNId), TStr::Fmt("%s or %s not a node.", TInt64::GetStr(SrcNId).CStr(), TInt64::GetStr(DstNId).CStr()).CStr());
+  //IAssert(! IsEdge(SrcNId, DstNId));
+  if (IsEdge(SrcNId, DstNId)) { return -2; }
+  GetNode(SrcNId).OutNIdV.AddSorted(DstNId);
+  GetNode(DstNId).InNIdV.AddSorted(SrcNId);
+  NEdges++;
+  return -1; // no edge id
+}
+
+template <class TId, class TCnt>
+int TNGraphT<TId, TCnt>::AddEdgeUnchecked(const TId& SrcNId, const TId& DstNId) {
+  GetNode(SrcNId).OutNIdV.Add(DstNId);
+  GetNode(DstNId).InNIdV.Add(SrcNId);
+  NEdges++;
+  return -1; // no edge id
+}
+
+template <class TId, class TCnt>
+int TNGraphT<TId, TCnt>::AddEdge2(const TId& SrcNId, const TId& DstNId) {
+  if (! IsNode(SrcNId)) { AddNode(SrcNId); }
+  if (! IsNode(DstNId)) { AddNode(DstNId); }
+  if (GetNode(SrcNId).IsOutNId(DstNId)) { return -2; } // edge already exists
+  GetNode(SrcNId).OutNIdV.AddSorted(DstNId);
+  GetNode(DstNId).InNIdV.AddSorted(SrcNId);
+  NEdges++;
+  return -1; // no edge id
+}
+
+// Add edges from EdgeV[e].Val1 to EdgeV[e].Val2 to the graph. Return the number of new edges.
+template <class TId, class TCnt>
+int TNGraphT<TId, TCnt>::AddEdgeBatch(const TNIdPrV& EdgeV) {
+  // count the new out- and in-neighbors of every node
+  TIntV AddOutV(NodeH.GetMxKeyIds()), AddInV(NodeH.GetMxKeyIds());
+  for (int e = 0; e < EdgeV.Len(); e++) {
+    const int SrcKeyId = NodeH.GetKeyId(EdgeV[e].Val1);
+    const int DstKeyId = NodeH.GetKeyId(EdgeV[e].Val2);
+    IAssertR(SrcKeyId != -1 && DstKeyId != -1, TStr::Fmt("%s or %s not a node.", TInt64::GetStr(TId(EdgeV[e].Val1)).CStr(), TInt64::GetStr(TId(EdgeV[e].Val2)).CStr()).CStr());
+    AddOutV[SrcKeyId]++;
+    AddInV[DstKeyId]++;
+  }
+  TIntV KeyIdV, SortedOutV, SortedInV;
+  for (int KeyId = 0; KeyId < AddOutV.Len(); KeyId++) {
+    if (AddOutV[KeyId] == 0 && AddInV[KeyId] == 0) { continue; }
+    TNode& Node = NodeH[KeyId];
+    KeyIdV.Add(KeyId);
+    SortedOutV.Add(Node.OutNIdV.Len());
+    SortedInV.Add(Node.InNIdV.Len());
+    Node.OutNIdV.Reserve(Node.OutNIdV.Len() + AddOutV[KeyId]);
+    Node.InNIdV.Reserve(Node.InNIdV.Len() + AddInV[KeyId]);
+  }
+  for (int e = 0; e < EdgeV.Len(); e++) {
+    GetNode(EdgeV[e].Val1).OutNIdV.Add(EdgeV[e].Val2);
+    GetNode(EdgeV[e].Val2).InNIdV.Add(EdgeV[e].Val1);
+  }
+  int NewEdges = 0;
+  #pragma omp parallel for schedule(dynamic,1000) reduction(+:NewEdges)
+  for (int k = 0; k < KeyIdV.Len(); k++) {
+    TNode& Node = NodeH[KeyIdV[k]];
+    NewEdges += TSnapDetail::MergeBatchNIdV(Node.OutNIdV, SortedOutV[k]);
+    TSnapDetail::MergeBatchNIdV(Node.InNIdV, SortedInV[k]);
+  }
+  NEdges += NewEdges;
+  return NewEdges;
+}
+
+template <class TId, class TCnt>
+void TNGraphT<TId, TCnt>::DelEdge(const TId& SrcNId, const TId& DstNId, const bool& IsDir) {
+  IAssertR(IsNode(SrcNId) && IsNode(DstNId), TStr::Fmt("%s or %s not a node.", TInt64::GetStr(SrcNId).CStr(), TInt64::GetStr(DstNId).CStr()).CStr());
+  { TNode& N = GetNode(SrcNId);
+  const int n = N.OutNIdV.SearchBin(DstNId);
+  if (n!= -1) { N.OutNIdV.Del(n);  NEdges--; } }
+  { TNode& N = GetNode(DstNId);
+  const int n = N.InNIdV.SearchBin(SrcNId);
+  if (n!= -1) { N.InNIdV.Del(n); } }
+  if (! IsDir) {
+    { TNode& N = GetNode(SrcNId);
+    const int n = N.InNIdV.SearchBin(DstNId);
+    if (n!= -1) { N.InNIdV.Del(n); } }
+    { TNode& N = GetNode(DstNId);
+    const int n = N.OutNIdV.SearchBin(SrcNId);
+    if (n!= -1) { N.OutNIdV.Del(n);  NEdges--; } }
+  }
+}
+
+template <class TId, class TCnt>
+bool TNGraphT<TId, TCnt>::IsEdge(const TId& SrcNId, const TId& DstNId, const bool& IsDir) const {
+  if (! IsNode(SrcNId) || ! IsNode(DstNId)) { return false; }
+  if (IsDir) { return GetNode(SrcNId).IsOutNId(DstNId); }
+  else { return GetNode(SrcNId).IsOutNId(DstNId) || GetNode(DstNId).IsOutNId(SrcNId); }
+}
+
+template <class TId, class TCnt>
+typename TNGraphT<TId, TCnt>::TEdgeI TNGraphT<TId, TCnt>::GetEI(const TId& SrcNId, const TId& DstNId) const {
+  const TNodeI SrcNI = GetNI(SrcNId);
+  const int NodeN = SrcNI.NodeHI.GetDat().OutNIdV.SearchBin(DstNId);
+  IAssert(NodeN != -1);
+  return TEdgeI(SrcNI, EndNI(), NodeN);
+}
+
+template <class TId, class TCnt>
+void TNGraphT<TId, TCnt>::GetNIdV(TNIdV& NIdV) const {
+  NIdV.Gen(GetNodes(), 0);
+  for (int N=NodeH.FFirstKeyId(); NodeH.FNextKeyId(N); ) {
+    NIdV.Add(NodeH.GetKey(N)); }
+}
+
+// sort the adjacency lists, remove duplicate edges and recount the edges
+template <class TId, class TCnt>
+void TNGraphT<TId, TCnt>::SortNodeAdjV() {
+  int64 Edges = 0;
+  #pragma omp parallel for schedule(dynamic,1000) reduction(+:Edges)
+  for (int KeyId = 0; KeyId < NodeH.GetMxKeyIds(); KeyId++) {
+    if (! NodeH.IsKeyId(KeyId)) { continue; }
+    TNode& Node = NodeH[KeyId];
+    Edges += TSnapDetail::MergeBatchNIdV(Node.OutNIdV, 0);
+    TSnapDetail::MergeBatchNIdV(Node.InNIdV, 0);
+  }
+  NEdges = TCnt(Edges);
+}
+
+template <class TId, class TCnt>
+void TNGraphT<TId, TCnt>::Defrag(const bool& OnlyNodeLinks) {
+  for (int n = NodeH.FFirstKeyId(); NodeH.FNextKeyId(n); ) {
+    TNode& Node = NodeH[n];
+    Node.InNIdV.Pack();  Node.OutNIdV.Pack();
+  }
+  if (! OnlyNodeLinks && ! NodeH.IsKeyIdEqKeyN()) { NodeH.Defrag(); }
+}
+
+// for each node check that their neighbors are also nodes
+template <class TId, class TCnt>
+bool TNGraphT<TId, TCnt>::IsOk(const bool& ThrowExcept) const {
+  bool RetVal = true;
+  int64 Edges = 0;
+  for (int N = NodeH.FFirstKeyId(); NodeH.FNextKeyId(N); ) {
+    const TNode& Node = NodeH[N];
+    const TStr NIdStr = TInt64::GetStr(Node.GetId());
+    if (! Node.OutNIdV.IsSorted()) {
+      const TStr Msg = TStr::Fmt("Out-neighbor list of node %s is not sorted.", NIdStr.CStr());
+      if (ThrowExcept) { EAssertR(false, Msg); } else { ErrNotify(Msg.CStr()); } RetVal=false;
+    }
+    if (! Node.InNIdV.IsSorted()) {
+      const TStr Msg = TStr::Fmt("In-neighbor list of node %s is not sorted.", NIdStr.CStr());
+      if (ThrowExcept) { EAssertR(false, Msg); } else { ErrNotify(Msg.CStr()); } RetVal=false;
+    }
+    // check out-edges
+    for (int e = 0; e < Node.GetOutDeg(); e++) {
+      if (! IsNode(Node.GetOutNId(e)) || ! GetNode(Node.GetOutNId(e)).IsInNId(Node.GetId())) {
+        const TStr Msg = TStr::Fmt("Out-edge %s --> %s: node does not exist or has no in-edge.",
+          NIdStr.CStr(), TInt64::GetStr(Node.GetOutNId(e)).CStr());
+        if (ThrowExcept) { EAssertR(false, Msg); } else { ErrNotify(Msg.CStr()); } RetVal=false;
+      }
+      if (e > 0 && Node.GetOutNId(e-1) == Node.GetOutNId(e)) {
+        const TStr Msg = TStr::Fmt("Node %s has duplidate out-edge %s --> %s.",
+          NIdStr.CStr(), NIdStr.CStr(), TInt64::GetStr(Node.GetOutNId(e)).CStr());
+        if (ThrowExcept) { EAssertR(false, Msg); } else { ErrNotify(Msg.CStr()); } RetVal=false;
+      }
+    }
+    // check in-edges
+    for (int e = 0; e < Node.GetInDeg(); e++) {
+      if (! IsNode(Node.GetInNId(e))) {
+        const TStr Msg = TStr::Fmt("In-edge %s <-- %s: node does not exist.",
+          NIdStr.CStr(), TInt64::GetStr(Node.GetInNId(e)).CStr());
+        if (ThrowExcept) { EAssertR(false, Msg); } else { ErrNotify(Msg.CStr()); } RetVal=false;
+      }
+      if (e > 0 && Node.GetInNId(e-1) == Node.GetInNId(e)) {
+        const TStr Msg = TStr::Fmt("Node %s has duplidate in-edge %s <-- %s.",
+          NIdStr.CStr(), NIdStr.CStr(), TInt64::GetStr(Node.GetInNId(e)).CStr());
+        if (ThrowExcept) { EAssertR(false, Msg); } else { ErrNotify(Msg.CStr()); } RetVal=false;
+      }
+    }
+    Edges += Node.GetOutDeg();
+  }
+  if (Edges != GetEdges()) {
+    const TStr Msg = TStr::Fmt("Number of edges counter is corrupted: GetEdges():%s, EdgeCount:%s.",
+      TInt64::GetStr(GetEdges()).CStr(), TInt64::GetStr(Edges).CStr());
+    if (ThrowExcept) { EAssertR(false, Msg); } else { ErrNotify(Msg.CStr()); } RetVal=false;
+  }
+  return RetVal;
+}
+
+template <class TId, class TCnt>
+void TNGraphT<TId, TCnt>::Dump(FILE *OutF) const {
+  const int NodePlaces = (int) ceil(log10((double) GetNodes()));
+  fprintf(OutF, "-------------------------------------------------\nDirected Node Graph: nodes: %d, edges: %s\n", GetNodes(), TInt64::GetStr(GetEdges()).CStr());
+  for (int N = NodeH.FFirstKeyId(); NodeH.FNextKeyId(N); ) {
+    const TNode& Node = NodeH[N];
+    fprintf(OutF, "  %*s]\n", NodePlaces, TInt64::GetStr(Node.GetId()).CStr());
+    fprintf(OutF, "    in [%d]", Node.GetInDeg());
+    for (int edge = 0; edge < Node.GetInDeg(); edge++) {
+      fprintf(OutF, " %*s", NodePlaces, TInt64::GetStr(Node.GetInNId(edge)).CStr()); }
+    fprintf(OutF, "\n    out[%d]", Node.GetOutDeg());
+    for (int edge = 0; edge < Node.GetOutDeg(); edge++) {
+      fprintf(OutF, " %*s", NodePlaces, TInt64::GetStr(Node.GetOutNId(edge)).CStr()); }
+    fprintf(OutF, "\n");
+  }
+  fprintf(OutF, "\n");
+}
+
+template <class TId, class TCnt>
+typename TNGraphT<TId, TCnt>::PNet TNGraphT<TId, TCnt>::GetSmallGraph() {
+  PNet G = TNGraphT::New();
+  for (int i = 0; i < 5; i++) { G->AddNode(i); }
+  G->AddEdge(0,1); G->AddEdge(1,2); G->AddEdge(0,2);
+  G->AddEdge(1,3); G->AddEdge(3,4); G->AddEdge(2,3);
+  return G;
 }
 
 //#//////////////////////////////////////////////
@@ -0,0 +1,462 @@
+//#//////////////////////////////////////////////
+/// Graphs with 64-bit node and edge ids
+/// TNGraph64 and TUNGraph64 are instantiations of TNGraphT and TUNGraphT (see graph.h)
+/// with int64 node ids and edge counts, TNGraph32 and TUNGraph32 keep int node ids,
+/// which halves the memory of the adjacency vectors when the ids fit, but still
+/// count more than 2^31 edges. TNEGraphT is the templated counterpart of TNEGraph.
+template <class TId> class TNEGraphT;
+
+/// Directed graph with 64-bit node ids.
+typedef TNGraphT<int64, int64> TNGraph64;
+/// Directed graph with 32-bit node ids and a 64-bit edge count.
+typedef TNGraphT<int, int64> TNGraph32;
+/// Undirected graph with 64-bit node ids.
+typedef TUNGraphT<int64, int64> TUNGraph64;
+/// Undirected graph with 32-bit node ids and a 64-bit edge count.
+typedef TUNGraphT<int, int64> TUNGraph32;
+/// Directed multigraph with 64-bit node and edge ids.
+typedef TNEGraphT<int64> TNEGraph64;
+/// Directed multigraph with 32-bit node and edge ids and a 64-bit edge count.
+typedef TNEGraphT<int> TNEGraph32;
+
+/// Pointer to a directed graph with 64-bit node ids (TNGraph64)
+typedef TPt<TNGraph64> PNGraph64;
+/// Pointer to a directed graph with 32-bit node ids (TNGraph32)
+typedef TPt<TNGraph32> PNGraph32;
+/// Pointer to an undirected graph with 64-bit node ids (TUNGraph64)
+typedef TPt<TUNGraph64> PUNGraph64;
+/// Pointer to an undirected graph with 32-bit node ids (TUNGraph32)
+typedef TPt<TUNGraph32> PUNGraph32;
+/// Pointer to a directed multigraph with 64-bit ids (TNEGraph64)
+typedef TPt<TNEGraph64> PNEGraph64;
+/// Pointer to a directed multigraph with 32-bit ids (TNEGraph32)
+typedef TPt<TNEGraph32> PNEGraph32;
+
+//#//////////////////////////////////////////////
+/// Directed multigraph with node and edge ids of type TId. ##TNEGraphT::Class
+template <class TId>
+class TNEGraphT {
+public:
+  typedef TNEGraphT TNet;
+  typedef TPt<TNEGraphT> PNet;
+  typedef TId TNId;
+  typedef typename TSnapDetail::TNIdVal<TId>::TVal TNIdT;
+  typedef TVec<TNIdT> TNIdV;
+public:
+  class TNode {
+  private:
+    TNIdT Id;
+    TNIdV InEIdV, OutEIdV;
+  public:
+    TNode() : Id(-1), InEIdV(), OutEIdV() { }
+    TNode(const TId& NId) : Id(NId), InEIdV(), OutEIdV() { }
+    TNode(const TNode& Node) : Id(Node.Id), InEIdV(Node.InEIdV), OutEIdV(Node.OutEIdV) { }
+    TNode(TSIn& SIn) : Id(SIn), InEIdV(SIn), OutEIdV(SIn) { }
+    void Save(TSOut& SOut) const { Id.Save(SOut); InEIdV.Save(SOut); OutEIdV.Save(SOut); }
+    TId GetId() const { return Id; }
+    int GetDeg() const { return GetInDeg() + GetOutDeg(); }
+    int GetInDeg() const { return InEIdV.Len(); }
+    int GetOutDeg() const { return OutEIdV.Len(); }
+    TId GetInEId(const int& EdgeN) const { return InEIdV[EdgeN]; }
+    TId GetOutEId(const int& EdgeN) const { return OutEIdV[EdgeN]; }
+    TId GetNbrEId(const int& EdgeN) const { return EdgeN<GetOutDeg()?GetOutEId(EdgeN):GetInEId(EdgeN-GetOutDeg()); }
+    bool IsInEId(const TId& EId) const { return InEIdV.SearchBin(EId) != -1; }
+    bool IsOutEId(const TId& EId) const { return OutEIdV.SearchBin(EId) != -1; }
+    friend class TNEGraphT;
+  };
+  /// Edges are stored in a vector indexed by edge ID, SrcNId of deleted edges is -1.
+  class TEdge {
+  private:
+    TNIdT SrcNId, DstNId;
+  public:
+    TEdge() : SrcNId(-1), DstNId(-1) { }
+    TEdge(const TId& SourceNId, const TId& DestNId) : SrcNId(SourceNId), DstNId(DestNId) { }
+    TEdge(const TEdge& Edge) : SrcNId(Edge.SrcNId), DstNId(Edge.DstNId) { }
+    TEdge(TSIn& SIn) : SrcNId(SIn), DstNId(SIn) { }
+    void Save(TSOut& SOut) const { SrcNId.Save(SOut); DstNId.Save(SOut); }
+    bool IsEdge() const { return SrcNId != -1; }
+    TId GetSrcNId() const { return SrcNId; }
+    TId GetDstNId() const { return DstNId; }
+    friend class TNEGraphT;
+  };
+  /// Node iterator. Only forward iteration (operator++) is supported.
+  class TNodeI {
+  private:
+    typedef typename THash<TNIdT, TNode>::TIter THashIter;
+    THashIter NodeHI;
+    const TNEGraphT *Graph;
+  public:
+    TNodeI() : NodeHI(), Graph(NULL) { }
+    TNodeI(const THashIter& NodeHIter, const TNEGraphT* GraphPt) : NodeHI(NodeHIter), Graph(GraphPt) { }
+    TNodeI(const TNodeI& NodeI) : NodeHI(NodeI.NodeHI), Graph(NodeI.Graph) { }
+    TNodeI& operator = (const TNodeI& NodeI) { NodeHI = NodeI.NodeHI; Graph=NodeI.Graph; return *this; }
+    /// Increment iterator.
+    TNodeI& operator++ (int) { NodeHI++; return *this; }
+    /// Decrement iterator.
+    TNodeI& operator-- (int) { NodeHI--; return *this; }
+
+    bool operator < (const TNodeI& NodeI) const { return NodeHI < NodeI.NodeHI; }
+    bool operator == (const TNodeI& NodeI) const { return NodeHI == NodeI.NodeHI; }
+    /// Returns ID of the current node.
+    TId GetId() const { return NodeHI.GetDat().GetId(); }
+    /// Returns degree of the current node, the sum of in-degree and out-degree.
+    int GetDeg() const { return NodeHI.GetDat().GetDeg(); }
+    /// Returns in-degree of the current node.
+    int GetInDeg() const { return NodeHI.GetDat().GetInDeg(); }
+    /// Returns out-degree of the current node.
+    int GetOutDeg() const { return NodeHI.GetDat().GetOutDeg(); }
+    /// Returns ID of EdgeN-th in-node (the node pointing to the current node).
+    TId GetInNId(const int& EdgeN) const { return Graph->GetEdge(NodeHI.GetDat().GetInEId(EdgeN)).GetSrcNId(); }
+    /// Returns ID of EdgeN-th out-node (the node the current node points to).
+    TId GetOutNId(const int& EdgeN) const { return Graph->GetEdge(NodeHI.GetDat().GetOutEId(EdgeN)).GetDstNId(); }
+    /// Returns ID of EdgeN-th neighboring node.
+    TId GetNbrNId(const int& EdgeN) const { const TEdge& E = Graph->GetEdge(NodeHI.GetDat().GetNbrEId(EdgeN));
+      return GetId()==E.GetSrcNId() ? E.GetDstNId():E.GetSrcNId(); }
+    /// Tests whether node with ID NId points to the current node.
+    bool IsInNId(const TId& NId) const {
+      for (int e = 0; e < GetInDeg(); e++) { if (GetInNId(e) == NId) { return true; } }  return false; }
+    /// Tests whether the current node points to node with ID NId.
+    bool IsOutNId(const TId& NId) const {
+      for (int e = 0; e < GetOutDeg(); e++) { if (GetOutNId(e) == NId) { return true; } }  return false; }
+    /// Tests whether node with ID NId is a neighbor of the current node.
+    bool IsNbrNId(const TId& NId) const { return IsOutNId(NId) || IsInNId(NId); }
+    /// Returns ID of EdgeN-th in-edge.
+    TId GetInEId(const int& EdgeN) const { return NodeHI.GetDat().GetInEId(EdgeN); }
+    /// Returns ID of EdgeN-th out-edge.
+    TId GetOutEId(const int& EdgeN) const { return NodeHI.GetDat().GetOutEId(EdgeN); }
+    /// Returns ID of EdgeN-th in or out-edge.
+    TId GetNbrEId(const int& EdgeN) const { return NodeHI.GetDat().GetNbrEId(EdgeN); }
+    /// Tests whether the edge with ID EId is an in-edge of current node.
+    bool IsInEId(const TId& EId) const { return NodeHI.GetDat().IsInEId(EId); }
+    /// Tests whether the edge with ID EId is an out-edge of current node.
+    bool IsOutEId(const TId& EId) const { return NodeHI.GetDat().IsOutEId(EId); }
+    /// Tests whether the edge with ID EId is an in or out-edge of current node.
+    bool IsNbrEId(const TId& EId) const { return IsInEId(EId) || IsOutEId(EId); }
+    friend class TNEGraphT;
+  };
+  /// Edge iterator. Only forward iteration (operator++) is supported.
+  class TEdgeI {
+  private:
+    int64 EdgeN;
+    const TNEGraphT *Graph;
+  public:
+    TEdgeI() : EdgeN(0), Graph(NULL) { }
+    TEdgeI(const int64& _EdgeN, const TNEGraphT *GraphPt) : EdgeN(_EdgeN), Graph(GraphPt) { }
+    TEdgeI(const TEdgeI& EdgeI) : EdgeN(EdgeI.EdgeN), Graph(EdgeI.Graph) { }
+    TEdgeI& operator = (const TEdgeI& EdgeI) { if (this!=&EdgeI) { EdgeN=EdgeI.EdgeN; Graph=EdgeI.Graph; }  return *this; }
+    /// Increment iterator.
+    TEdgeI& operator++ (int) { EdgeN++;
+      while (EdgeN < Graph->EdgeV.Len() && ! Graph->EdgeV[EdgeN].IsEdge()) { EdgeN++; }  return *this; }
+    bool operator < (const TEdgeI& EdgeI) const { return EdgeN < EdgeI.EdgeN; }
+    bool operator == (const TEdgeI& EdgeI) const { return EdgeN == EdgeI.EdgeN; }
+    /// Returns edge ID.
+    TId GetId() const { return TId(EdgeN); }
+    /// Returns the source node of the edge.
+    TId GetSrcNId() const { return Graph->EdgeV[EdgeN].GetSrcNId(); }
+    /// Returns the destination node of the edge.
+    TId GetDstNId() const { return Graph->EdgeV[EdgeN].GetDstNId(); }
+    friend class TNEGraphT;
+  };
+private:
+  TNode& GetNode(const TId& NId) { return NodeH.GetDat(NId); }
+  const TNode& GetNode(const TId& NId) const { return NodeH.GetDat(NId); }
+  TEdge& GetEdge(const TId& EId) { return EdgeV[EId]; }
+  const TEdge& GetEdge(const TId& EId) const { return EdgeV[EId]; }
+private:
+  TCRef CRef;
+  TNIdT MxNId;
+  TInt64 NEdges;
+  THash<TNIdT, TNode> NodeH;
+  TVec<TEdge, int64> EdgeV;
+public:
+  TNEGraphT() : CRef(), MxNId(0), NEdges(0), NodeH(), EdgeV() { }
+  /// Constructor that reserves enough memory for a graph of Nodes nodes and Edges edges.
+  explicit TNEGraphT(const int& Nodes, const int64& Edges) : CRef(), MxNId(0), NEdges(0) { Reserve(Nodes, Edges); }
+  TNEGraphT(const TNEGraphT& Graph) : MxNId(Graph.MxNId), NEdges(Graph.NEdges), NodeH(Graph.NodeH), EdgeV(Graph.EdgeV) { }
+  /// Constructor for loading the graph from a (binary) stream SIn.
+  TNEGraphT(TSIn& SIn) : MxNId(SIn), NEdges(SIn), NodeH(SIn), EdgeV(SIn) { }
+  /// Saves the graph to a (binary) stream SOut.
+  void Save(TSOut& SOut) const { MxNId.Save(SOut); NEdges.Save(SOut); NodeH.Save(SOut); EdgeV.Save(SOut); }
+  /// Static constructor that returns a pointer to the graph. Call: PNEGraph64 Graph = TNEGraph64::New().
+  static PNet New() { return PNet(new TNEGraphT()); }
+  /// Static constructor that returns a pointer to the graph and reserves enough memory for Nodes nodes and Edges edges.
+  static PNet New(const int& Nodes, const int64& Edges) { return PNet(new TNEGraphT(Nodes, Edges)); }
+  /// Static constructor that loads the graph from a stream SIn and returns a pointer to it.
+  static PNet Load(TSIn& SIn) { return PNet(new TNEGraphT(SIn)); }
+  /// Allows for run-time checking the type of the graph (see the TGraphFlag for flags).
+  bool HasFlag(const TGraphFlag& Flag) const { return HasGraphFlag(typename TNEGraphT::TNet, Flag); }
+  TNEGraphT& operator = (const TNEGraphT& Graph) { if (this!=&Graph) {
+    MxNId=Graph.MxNId; NEdges=Graph.NEdges; NodeH=Graph.NodeH; EdgeV=Graph.EdgeV; }  return *this; }
+
+  /// Returns the number of nodes in the graph.
+  int GetNodes() const { return NodeH.Len(); }
+  /// Adds a node of ID NId to the graph. ##TNEGraph::AddNode
+  TId AddNode(TId NId = -1);
+  /// Adds a node of ID NodeI.GetId() to the graph.
+  TId AddNode(const TNodeI& NodeI) { return AddNode(NodeI.GetId()); }
+  /// Deletes node of ID NId from the graph together with all its edges.
+  void DelNode(const TId& NId);
+  /// Deletes node of ID NodeI.GetId() from the graph.
+  void DelNode(const TNode& NodeI) { DelNode(NodeI.GetId()); }
+  /// Tests whether ID NId is a node.
+  bool IsNode(const TId& NId) const { return NodeH.IsKey(NId); }
+  /// Returns an iterator referring to the first node in the graph.
+  TNodeI BegNI() const { return TNodeI(NodeH.BegI(), this); }
+  /// Returns an iterator referring to the past-the-end node in the graph.
+  TNodeI EndNI() const { return TNodeI(NodeH.EndI(), this); }
+  /// Returns an iterator referring to the node of ID NId in the graph.
+  TNodeI GetNI(const TId& NId) const { return TNodeI(NodeH.GetI(NId), this); }
+  /// Returns an ID that is larger than any node ID in the graph.
+  TId GetMxNId() const { return MxNId; }
+
+  /// Returns the number of edges in the graph.
+  int64 GetEdges() const { return NEdges; }
+  /// Returns an ID that is larger than any edge ID in the graph.
+  TId GetMxEId() const { return TId(EdgeV.Len()); }
+  /// Adds an edge with ID EId between node IDs SrcNId and DstNId to the graph. ##TNEGraphT::AddEdge
+  /// Edges live in a vector indexed by edge ID, so EId is either -1 (the new ID is GetMxEId()),
+  /// GetMxEId() or the ID of a deleted edge.
+  TId AddEdge(const TId& SrcNId, const TId& DstNId, TId EId = -1);
+  /// Adds an edge between EdgeI.GetSrcNId() and EdgeI.GetDstNId() to the graph.
+  TId AddEdge(const TEdgeI& EdgeI) { return AddEdge(EdgeI.GetSrcNId(), EdgeI.GetDstNId(), EdgeI.GetId()); }
+  /// Deletes an edge with edge ID EId from the graph.
+  void DelEdge(const TId& EId);
+  /// Deletes all edges between node IDs SrcNId and DstNId from the graph.
+  void DelEdge(const TId& SrcNId, const TId& DstNId, const bool& IsDir = true);
+  /// Tests whether an edge with edge ID EId exists in the graph.
+  bool IsEdge(const TId& EId) const { return EId >= 0 && EId < EdgeV.Len() && EdgeV[EId].IsEdge(); }
+  /// Tests whether an edge between node IDs SrcNId and DstNId exists in the graph.
+  bool IsEdge(const TId& SrcNId, const TId& DstNId, const bool& IsDir = true) const { TId EId; return IsEdge(SrcNId, DstNId, EId, IsDir); }
+  /// Tests whether an edge between node IDs SrcNId and DstNId exists in the graph. if an edge exists, return its edge ID in EId.
+  bool IsEdge(const TId& SrcNId, const TId& DstNId, TId& EId, const bool& IsDir = true) const;
+  /// Returns an edge ID between node IDs SrcNId and DstNId, if such an edge exists. Otherwise, return -1.
+  TId GetEId(const TId& SrcNId, const TId& DstNId) const { TId EId; return IsEdge(SrcNId, DstNId, EId)?EId:-1; }
+  /// Returns an iterator referring to the first edge in the graph.
+  TEdgeI BegEI() const { TEdgeI EI(-1, this); EI++; return EI; }
+  /// Returns an iterator referring to the past-the-end edge in the graph.
+  TEdgeI EndEI() const { return TEdgeI(EdgeV.Len(), this); }
+  /// Returns an iterator referring to edge with edge ID EId.
+  TEdgeI GetEI(const TId& EId) const { return TEdgeI(EId, this); }
+  /// Returns an iterator referring to edge (SrcNId, DstNId) in the graph.
+  TEdgeI GetEI(const TId& SrcNId, const TId& DstNId) const { return GetEI(GetEId(SrcNId, DstNId)); }
+
+  /// Returns an ID of a random node in the graph.
+  TId GetRndNId(TRnd& Rnd=TInt::Rnd) { return NodeH.GetKey(NodeH.GetRndKeyId(Rnd, 0.8)); }
+  /// Returns an interator referring to a random node in the graph.
+  TNodeI GetRndNI(TRnd& Rnd=TInt::Rnd) { return GetNI(GetRndNId(Rnd)); }
+  /// Returns an ID of a random edge in the graph.
+  TId GetRndEId(TRnd& Rnd=TInt::Rnd);
+  /// Returns an interator referring to a random edge in the graph.
+  TEdgeI GetRndEI(TRnd& Rnd=TInt::Rnd) { return GetEI(GetRndEId(Rnd)); }
+  /// Gets a vector IDs of all nodes in the graph.
+  void GetNIdV(TNIdV& NIdV) const;
+
+  /// Tests whether the graph is empty (has zero nodes).
+  bool Empty() const { return GetNodes()==0; }
+  /// Deletes all nodes and edges from the graph.
+  void Clr() { MxNId=0; NEdges=0; NodeH.Clr(); EdgeV.Clr(); }
+  /// Reserves memory for a graph of Nodes nodes and Edges edges.
+  void Reserve(const int& Nodes, const int64& Edges) {
+    if (Nodes>0) { NodeH.Gen(Nodes/2); } if (Edges>0) { EdgeV.Reserve(Edges); } }
+  /// Defragments the graph. Edge IDs are not changed.
+  void Defrag(const bool& OnlyNodeLinks=false);
+  /// Checks the graph data structure for internal consistency.
+  bool IsOk(const bool& ThrowExcept=true) const;
+  /// Print the graph in a human readable form to an output stream OutF.
+  void Dump(FILE *OutF=stdout) const;
+  /// Returns a small multigraph on 5 nodes and 6 edges.
+  static PNet GetSmallGraph();
+  friend class TPt<TNEGraphT>;
+};
+
+// set flags
+namespace TSnap {
+template <class TId> struct IsMultiGraph<TNEGraphT<TId> > { enum { Val = 1 }; };
+template <class TId> struct IsDirected<TNEGraphT<TId> > { enum { Val = 1 }; };
+template <class TId> struct TNIdType<TNEGraphT<TId> > { typedef TId TNId; typedef typename TNEGraphT<TId>::TNIdT TNIdT; };
+}
+
+template <class TId>
+TId TNEGraphT<TId>::AddNode(TId NId) {
+  if (NId == -1) {
+    NId = MxNId;  MxNId++;
+  } else {
+    IAssertR(!IsNode(NId), TStr::Fmt("NodeId %s already exists", TInt64::GetStr(NId).CStr()));
+    MxNId = TMath::Mx(NId+1, TId(MxNId));
+  }
+  NodeH.AddDat(NId, TNode(NId));
+  return NId;
+}
+
+template <class TId>
+TId TNEGraphT<TId>::AddEdge(const TId& SrcNId, const TId& DstNId, TId EId) {
+  if (EId == -1) { EId = GetMxEId(); }
+  else { IAssertR(! IsEdge(EId), TStr::Fmt("EdgeId %s already exists", TInt64::GetStr(EId).CStr())); }
+  IAssertR(EId >= 0 && EId <= GetMxEId(), TStr::Fmt("EdgeId %s is larger than GetMxEId() %s",
+    TInt64::GetStr(EId).CStr(), TInt64::GetStr(GetMxEId()).CStr()));
+  IAssertR(IsNode(SrcNId) && IsNode(DstNId), TStr::Fmt("%s or %s not a node.", TInt64::GetStr(SrcNId).CStr(), TInt64::GetStr(DstNId).CStr()).CStr());
+  if (EId == EdgeV.Len()) {
+    IAssertR(int64(TId(EdgeV.Len()+1)) == EdgeV.Len()+1, TStr::Fmt("Edge IDs do not fit into %d bytes", int(sizeof(TId))));
+    EdgeV.Add(TEdge(SrcNId, DstNId));
+  } else { EdgeV[EId] = TEdge(SrcNId, DstNId); }
+  GetNode(SrcNId).OutEIdV.AddSorted(EId);
+  GetNode(DstNId).InEIdV.AddSorted(EId);
+  NEdges++;
+  return EId;
+}
+
+template <class TId>
+void TNEGraphT<TId>::DelEdge(const TId& EId) {
+  IAssert(IsEdge(EId));
+  const TEdge& Edge = GetEdge(EId);
+  { TNode& N = GetNode(Edge.GetSrcNId());
+  const int n = N.OutEIdV.SearchBin(EId);
+  if (n != -1) { N.OutEIdV.Del(n); } }
+  { TNode& N = GetNode(Edge.GetDstNId());
+  const int n = N.InEIdV.SearchBin(EId);
+  if (n != -1) { N.InEIdV.Del(n); } }
+  EdgeV[EId] = TEdge();
+  NEdges--;
+}
+
+template <class TId>
+void TNEGraphT<TId>::DelEdge(const TId& SrcNId, const TId& DstNId, const bool& IsDir) {
+  TId EId = -1;
+  while (IsEdge(SrcNId, DstNId, EId, IsDir)) { DelEdge(EId); }
+}
+
+template <class TId>
+bool TNEGraphT<TId>::IsEdge(const TId& SrcNId, const TId& DstNId, TId& EId, const bool& IsDir) const {
+  if (! IsNode(SrcNId)) { return false; }
+  const TNode& SrcNode = GetNode(SrcNId);
+  for (int edge = 0; edge < SrcNode.GetOutDeg(); edge++) {
+    const TEdge& Edge = GetEdge(SrcNode.GetOutEId(edge));
+    if (DstNId == Edge.GetDstNId()) {
+      EId = SrcNode.GetOutEId(edge);  return true; }
+  }
+  if (! IsDir) {
+    for (int edge = 0; edge < SrcNode.GetInDeg(); edge++) {
+      const TEdge& Edge = GetEdge(SrcNode.GetInEId(edge));
+      if (DstNId == Edge.GetSrcNId()) {
+        EId = SrcNode.GetInEId(edge);  return true; }
+    }
+  }
+  return false;
+}
+
+template <class TId>
+void TNEGraphT<TId>::DelNode(const TId& NId) {
+  TNode& Node = GetNode(NId);
+  while (Node.GetOutDeg() > 0) { DelEdge(Node.GetOutEId(Node.GetOutDeg()-1)); }
+  while (Node.GetInDeg() > 0) { DelEdge(Node.GetInEId(Node.GetInDeg()-1)); }
+  NodeH.DelKey(NId);
+}
+
+template <class TId>
+TId TNEGraphT<TId>::GetRndEId(TRnd& Rnd) {
+  IAssert(GetEdges() > 0);
+  TId EId;
+  do { EId = TId(Rnd.GetUniDevInt64(EdgeV.Len())); } while (! EdgeV[EId].IsEdge());
+  return EId;
+}
+
+template <class TId>
+void TNEGraphT<TId>::GetNIdV(TNIdV& NIdV) const {
+  NIdV.Gen(GetNodes(), 0);
+  for (int N=NodeH.FFirstKeyId(); NodeH.FNextKeyId(N); ) {
+    NIdV.Add(NodeH.GetKey(N)); }
+}
+
+template <class TId>
+void TNEGraphT<TId>::Defrag(const bool& OnlyNodeLinks) {
+  for (int n = NodeH.FFirstKeyId(); NodeH.FNextKeyId(n); ) {
+    TNode& Node = NodeH[n];
+    Node.InEIdV.Pack();  Node.OutEIdV.Pack();
+  }
+  if (! OnlyNodeLinks && ! NodeH.IsKeyIdEqKeyN()) { NodeH.Defrag(); }
+}
+
+template <class TId>
+bool TNEGraphT<TId>::IsOk(const bool& ThrowExcept) const {
+  bool RetVal = true;
+  for (int N = NodeH.FFirstKeyId(); NodeH.FNextKeyId(N); ) {
+    const TNode& Node = NodeH[N];
+    const TStr NIdStr = TInt64::GetStr(Node.GetId());
+    if (! Node.OutEIdV.IsSorted()) {
+      const TStr Msg = TStr::Fmt("Out-edge list of node %s is not sorted.", NIdStr.CStr());
+      if (ThrowExcept) { EAssertR(false, Msg); } else { ErrNotify(Msg.CStr()); } RetVal=false;
+    }
+    if (! Node.InEIdV.IsSorted()) {
+      const TStr Msg = TStr::Fmt("In-edge list of node %s is not sorted.", NIdStr.CStr());
+      if (ThrowExcept) { EAssertR(false, Msg); } else { ErrNotify(Msg.CStr()); } RetVal=false;
+    }
+    // check out-edge ids
+    for (int e = 0; e < Node.GetOutDeg(); e++) {
+      if (! IsEdge(Node.GetOutEId(e)) || GetEdge(Node.GetOutEId(e)).GetSrcNId() != Node.GetId()) {
+        const TStr Msg = TStr::Fmt("Out-edge id %s of node %s does not exist or does not start at the node.",
+          TInt64::GetStr(Node.GetOutEId(e)).CStr(), NIdStr.CStr());
+        if (ThrowExcept) { EAssertR(false, Msg); } else { ErrNotify(Msg.CStr()); } RetVal=false;
+      }
+    }
+    // check in-edge ids
+    for (int e = 0; e < Node.GetInDeg(); e++) {
+      if (! IsEdge(Node.GetInEId(e)) || GetEdge(Node.GetInEId(e)).GetDstNId() != Node.GetId()) {
+        const TStr Msg = TStr::Fmt("In-edge id %s of node %s does not exist or does not end at the node.",
+          TInt64::GetStr(Node.GetInEId(e)).CStr(), NIdStr.CStr());
+        if (ThrowExcept) { EAssertR(false, Msg); } else { ErrNotify(Msg.CStr()); } RetVal=false;
+      }
+    }
+  }
+  int64 Edges = 0;
+  for (int64 E = 0; E < EdgeV.Len(); E++) {
+    const TEdge& Edge = EdgeV[E];
+    if (! Edge.IsEdge()) { continue; }
+    Edges++;
+    if (! IsNode(Edge.GetSrcNId()) || ! GetNode(Edge.GetSrcNId()).IsOutEId(TId(E))) {
+      const TStr Msg = TStr::Fmt("Edge %s source node %s does not exist or does not have the edge.",
+        TInt64::GetStr(E).CStr(), TInt64::GetStr(Edge.GetSrcNId()).CStr());
+      if (ThrowExcept) { EAssertR(false, Msg); } else { ErrNotify(Msg.CStr()); } RetVal=false;
+    }
+    if (! IsNode(Edge.GetDstNId()) || ! GetNode(Edge.GetDstNId()).IsInEId(TId(E))) {
+      const TStr Msg = TStr::Fmt("Edge %s destination node %s does not exist or does not have the edge.",
+        TInt64::GetStr(E).CStr(), TInt64::GetStr(Edge.GetDstNId()).CStr());
+      if (ThrowExcept) { EAssertR(false, Msg); } else { ErrNotify(Msg.CStr()); } RetVal=false;
+    }
+  }
+  if (Edges != GetEdges()) {
+    const TStr Msg = TStr::Fmt("Number of edges counter is corrupted: GetEdges():%s, EdgeCount:%s.",
+      TInt64::GetStr(GetEdges()).CStr(), TInt64::GetStr(Edges).CStr());
+    if (ThrowExcept) { EAssertR(false, Msg); } else { ErrNotify(Msg.CStr()); } RetVal=false;
+  }
+  return RetVal;
+}
+
+template <class TId>
+void TNEGraphT<TId>::Dump(FILE *OutF) const {
+  fprintf(OutF, "-------------------------------------------------\nDirected Node-Edge Graph: nodes: %d, edges: %s\n", GetNodes(), TInt64::GetStr(GetEdges()).CStr());
+  for (TNodeI NodeI = BegNI(); NodeI < EndNI(); NodeI++) {
+    fprintf(OutF, "  %s]\n", TInt64::GetStr(NodeI.GetId()).CStr());
+    fprintf(OutF, "    in[%d]", NodeI.GetInDeg());
+    for (int edge = 0; edge < NodeI.GetInDeg(); edge++) {
+      fprintf(OutF, " %s", TInt64::GetStr(NodeI.GetInEId(edge)).CStr()); }
+    fprintf(OutF, "\n    out[%d]", NodeI.GetOutDeg());
+    for (int edge = 0; edge < NodeI.GetOutDeg(); edge++) {
+      fprintf(OutF, " %s", TInt64::GetStr(NodeI.GetOutEId(edge)).CStr()); }
+    fprintf(OutF, "\n");
+  }
+  for (TEdgeI EdgeI = BegEI(); EdgeI < EndEI(); EdgeI++) {
+    fprintf(OutF, "  %s]  %s  ->  %s\n", TInt64::GetStr(EdgeI.GetId()).CStr(),
+      TInt64::GetStr(EdgeI.GetSrcNId()).CStr(), TInt64::GetStr(EdgeI.GetDstNId()).CStr());
+  }
+  fprintf(OutF, "\n");
+}
+
+template <class TId>
+typename TNEGraphT<TId>::PNet TNEGraphT<TId>::GetSmallGraph() {
+  PNet Graph = TNEGraphT::New();
+  for (int i = 0; i < 5; i++) { Graph->AddNode(i); }
+  Graph->AddEdge(0,1);  Graph->AddEdge(0,2);
+  Graph->AddEdge(0,3);  Graph->AddEdge(0,4);
+  Graph->AddEdge(1,2);  Graph->AddEdge(1,2);
+  return Graph;
+}
@@ -0,0 +1,282 @@
+/////////////////////////////////////////////////
+#ifdef GCC_ATOMIC
+
+/////////////////////////////////////////////////
+// Directed Node Graph for concurrent updates
+TNGraphConc::TNGraphConc(const int& MnStripes) : CRef(), StripeMask(0), StripeV(), LockV(NULL), MxNId(0), NNodes(0), NEdges(0) {
+  int Stripes = 1;
+  while (Stripes < MnStripes) { Stripes *= 2; }
+  StripeMask = Stripes - 1;
+  StripeV.Gen(Stripes);
+  LockV = new omp_lock_t[Stripes];
+  for (int s = 0; s < Stripes; s++) {
+    StripeV[s] = new TStripe();
+    omp_init_lock(&LockV[s]);
+  }
+}
+
+TNGraphConc::~TNGraphConc() {
+  for (int s = 0; s < StripeV.Len(); s++) {
+    omp_destroy_lock(&LockV[s]);
+  }
+  delete [] LockV;
+}
+
+// stripes are always locked in increasing order, so that threads can not deadlock
+void TNGraphConc::Lock2(const int& StripeN1, const int& StripeN2) const {
+  if (StripeN1 == StripeN2) { Lock(StripeN1); return; }
+  Lock(TMath::Mn(StripeN1, StripeN2));
+  Lock(TMath::Mx(StripeN1, StripeN2));
+}
+
+void TNGraphConc::Unlock2(const int& StripeN1, const int& StripeN2) const {
+  Unlock(StripeN1);
+  if (StripeN1 != StripeN2) { Unlock(StripeN2); }
+}
+
+void TNGraphConc::LockAll() const {
+  for (int s = 0; s < StripeV.Len(); s++) { Lock(s); }
+}
+
+void TNGraphConc::UnlockAll() const {
+  for (int s = StripeV.Len()-1; s >= 0; s--) { Unlock(s); }
+}
+
+// returns the nodes of a locked stripe for modification, copying them first if a snapshot still refers to them
+THash<TInt, TNGraphConc::TNode>& TNGraphConc::GetNodeH(const int& StripeN) {
+  if (StripeV[StripeN].GetRefs() > 1) {
+    StripeV[StripeN] = new TStripe(*StripeV[StripeN]);
+  }
+  return StripeV[StripeN]->NodeH;
+}
+
+void TNGraphConc::UpdMxNId(const int& NId) {
+  int OldMxNId = MxNId;
+  while (OldMxNId <= NId && ! __sync_bool_compare_and_swap(&MxNId.Val, OldMxNId, NId+1)) {
+    OldMxNId = MxNId;
+  }
+}
+
+// the stripe of NId must be locked
+bool TNGraphConc::AddNodeLocked(const int& NId) {
+  THash<TInt, TNode>& NodeH = GetNodeH(GetStripeN(NId));
+  if (NodeH.IsKey(NId)) { return false; }
+  NodeH.AddDat(NId, TNode(NId));
+  __sync_fetch_and_add(&NNodes.Val, 1);
+  UpdMxNId(NId);
+  return true;
+}
+
+int TNGraphConc::AddNode(int NId) {
+  if (NId == -1) {
+    NId = __sync_fetch_and_add(&MxNId.Val, 1);
+  }
+  IAssertR(NId >= 0, TStr::Fmt("NodeId %d is negative.", NId));
+  const int StripeN = GetStripeN(NId);
+  Lock(StripeN);
+  const bool IsNew = AddNodeLocked(NId);
+  Unlock(StripeN);
+  IAssertR(IsNew, TStr::Fmt("NodeId %d already exists", NId));
+  return NId;
+}
+
+int TNGraphConc::AddNodeUnchecked(int NId) {
+  if (NId == -1) {
+    NId = __sync_fetch_and_add(&MxNId.Val, 1);
+  }
+  IAssertR(NId >= 0, TStr::Fmt("NodeId %d is negative.", NId));
+  const int StripeN = GetStripeN(NId);
+  Lock(StripeN);
+  AddNodeLocked(NId);
+  Unlock(StripeN);
+  return NId;
+}
+
+void TNGraphConc::DelNode(const int& NId) {
+  LockAll();
+  THash<TInt, TNode>& NodeH = GetNodeH(GetStripeN(NId));
+  if (! NodeH.IsKey(NId)) {
+    UnlockAll();
+    IAssertR(false, TStr::Fmt("NodeId %d does not exist", NId));
+  }
+  const TNode& Node = NodeH.GetDat(NId);
+  int DelEdges = Node.OutNIdV.Len() + Node.InNIdV.Len();
+  for (int e = 0; e < Node.OutNIdV.Len(); e++) {
+    const int Nbr = Node.OutNIdV[e];
+    if (Nbr == NId) { DelEdges--; continue; }
+    TIntV& NbrInNIdV = GetNodeH(GetStripeN(Nbr)).GetDat(Nbr).InNIdV;
+    const int n = NbrInNIdV.SearchBin(NId);
+    if (n != -1) { NbrInNIdV.Del(n); }
+  }
+  for (int e = 0; e < Node.InNIdV.Len(); e++) {
+    const int Nbr = Node.InNIdV[e];
+    if (Nbr == NId) { continue; }
+    TIntV& NbrOutNIdV = GetNodeH(GetStripeN(Nbr)).GetDat(Nbr).OutNIdV;
+    const int n = NbrOutNIdV.SearchBin(NId);
+    if (n != -1) { NbrOutNIdV.Del(n); }
+  }
+  NodeH.DelKey(NId);
+  NNodes--;
+  NEdges -= DelEdges;
+  UnlockAll();
+}
+
+bool TNGraphConc::IsNode(const int& NId) const {
+  const int StripeN = GetStripeN(NId);
+  Lock(StripeN);
+  const bool Result = GetNodeH(StripeN).IsKey(NId);
+  Unlock(StripeN);
+  return Result;
+}
+
+int TNGraphConc::AddEdge(const int& SrcNId, const int& DstNId) {
+  const int SrcStripeN = GetStripeN(SrcNId);
+  const int DstStripeN = GetStripeN(DstNId);
+  Lock2(SrcStripeN, DstStripeN);
+  THash<TInt, TNode>& SrcNodeH = GetNodeH(SrcStripeN);
+  THash<TInt, TNode>& DstNodeH = GetNodeH(DstStripeN);
+  if (! SrcNodeH.IsKey(SrcNId) || ! DstNodeH.IsKey(DstNId)) {
+    Unlock2(SrcStripeN, DstStripeN);
+    IAssertR(false, TStr::Fmt("%d or %d not a node.", SrcNId, DstNId).CStr());
+  }
+  TIntV& OutNIdV = SrcNodeH.GetDat(SrcNId).OutNIdV;
+  if (OutNIdV.SearchBin(DstNId) != -1) {
+    Unlock2(SrcStripeN, DstStripeN);
+    return -2;
+  }
+  OutNIdV.AddSorted(DstNId);
+  DstNodeH.GetDat(DstNId).InNIdV.AddSorted(SrcNId);
+  __sync_fetch_and_add(&NEdges.Val, 1);
+  Unlock2(SrcStripeN, DstStripeN);
+  return -1;
+}
+
+int TNGraphConc::AddEdge2(const int& SrcNId, const int& DstNId) {
+  IAssertR(SrcNId >= 0 && DstNId >= 0, TStr::Fmt("NodeId %d or %d is negative.", SrcNId, DstNId));
+  const int SrcStripeN = GetStripeN(SrcNId);
+  const int DstStripeN = GetStripeN(DstNId);
+  Lock2(SrcStripeN, DstStripeN);
+  AddNodeLocked(SrcNId);
+  AddNodeLocked(DstNId);
+  TIntV& OutNIdV = GetNodeH(SrcStripeN).GetDat(SrcNId).OutNIdV;
+  if (OutNIdV.SearchBin(DstNId) != -1) {
+    Unlock2(SrcStripeN, DstStripeN);
+    return -2;
+  }
+  OutNIdV.AddSorted(DstNId);
+  GetNodeH(DstStripeN).GetDat(DstNId).InNIdV.AddSorted(SrcNId);
+  __sync_fetch_and_add(&NEdges.Val, 1);
+  Unlock2(SrcStripeN, DstStripeN);
+  return -1;
+}
+
+void TNGraphConc::DelEdge(const int& SrcNId, const int& DstNId) {
+  const int SrcStripeN = GetStripeN(SrcNId);
+  const int DstStripeN = GetStripeN(DstNId);
+  Lock2(SrcStripeN, DstStripeN);
+  const THash<TInt, TNode>& CSrcNodeH = StripeV[SrcStripeN]->NodeH;
+  const int SrcKeyId = CSrcNodeH.GetKeyId(SrcNId);
+  if (SrcKeyId == -1 || CSrcNodeH[SrcKeyId].OutNIdV.SearchBin(DstNId) == -1) {
+    Unlock2(SrcStripeN, DstStripeN);
+    return;
+  }
+  TIntV& OutNIdV = GetNodeH(SrcStripeN).GetDat(SrcNId).OutNIdV;
+  OutNIdV.Del(OutNIdV.SearchBin(DstNId));
+  TIntV& InNIdV = GetNodeH(DstStripeN).GetDat(DstNId).InNIdV;
+  const int n = InNIdV.SearchBin(SrcNId);
+  if (n != -1) { InNIdV.Del(n); }
+  __sync_fetch_and_sub(&NEdges.Val, 1);
+  Unlock2(SrcStripeN, DstStripeN);
+}
+
+bool TNGraphConc::IsEdge(const int& SrcNId, const int& DstNId) const {
+  const int StripeN = GetStripeN(SrcNId);
+  Lock(StripeN);
+  const THash<TInt, TNode>& NodeH = GetNodeH(StripeN);
+  const int KeyId = NodeH.GetKeyId(SrcNId);
+  const bool Result = KeyId != -1 && NodeH[KeyId].OutNIdV.SearchBin(DstNId) != -1;
+  Unlock(StripeN);
+  return Result;
+}
+
+int TNGraphConc::GetOutDeg(const int& NId) const {
+  const int StripeN = GetStripeN(NId);
+  Lock(StripeN);
+  const THash<TInt, TNode>& NodeH = GetNodeH(StripeN);
+  const int KeyId = NodeH.GetKeyId(NId);
+  const int Deg = KeyId == -1 ? -1 : NodeH[KeyId].OutNIdV.Len();
+  Unlock(StripeN);
+  return Deg;
+}
+
+int TNGraphConc::GetInDeg(const int& NId) const {
+  const int StripeN = GetStripeN(NId);
+  Lock(StripeN);
+  const THash<TInt, TNode>& NodeH = GetNodeH(StripeN);
+  const int KeyId = NodeH.GetKeyId(NId);
+  const int Deg = KeyId == -1 ? -1 : NodeH[KeyId].InNIdV.Len();
+  Unlock(StripeN);
+  return Deg;
+}
+
+bool TNGraphConc::GetOutNIdV(const int& NId, TIntV& NIdV) const {
+  const int StripeN = GetStripeN(NId);
+  Lock(StripeN);
+  const THash<TInt, TNode>& NodeH = GetNodeH(StripeN);
+  const int KeyId = NodeH.GetKeyId(NId);
+  if (KeyId != -1) { NIdV = NodeH[KeyId].OutNIdV; }
+  Unlock(StripeN);
+  return KeyId != -1;
+}
+
+bool TNGraphConc::GetInNIdV(const int& NId, TIntV& NIdV) const {
+  const int StripeN = GetStripeN(NId);
+  Lock(StripeN);
+  const THash<TInt, TNode>& NodeH = GetNodeH(StripeN);
+  const int KeyId = NodeH.GetKeyId(NId);
+  if (KeyId != -1) { NIdV = NodeH[KeyId].InNIdV; }
+  Unlock(StripeN);
+  return KeyId != -1;
+}
+
+PNGraph TNGraphConc::GetSnapshot() {
+  const int Stripes = StripeV.Len();
+  TVec<PStripe> SnapStripeV(Stripes);
+  // holding all the locks at once only takes a reference to every stripe,
+  // writers copy a stripe before they next change it
+  LockAll();
+  for (int s = 0; s < Stripes; s++) {
+    SnapStripeV[s] = StripeV[s];
+  }
+  const int Nodes = NNodes;
+  const int64 Edges = NEdges;
+  UnlockAll();
+  PNGraph Graph = TNGraph::New(Nodes, (int) TMath::Mn(Edges, (int64) TInt::Mx));
+  for (int s = 0; s < Stripes; s++) {
+    const THash<TInt, TNode>& NodeH = SnapStripeV[s]->NodeH;
+    for (int KeyId = NodeH.FFirstKeyId(); NodeH.FNextKeyId(KeyId); ) {
+      const TNode& Node = NodeH[KeyId];
+      Graph->AddNode(Node.Id, Node.InNIdV, Node.OutNIdV);
+    }
+  }
+  // reference counts of the stripes are only changed under the stripe lock
+  for (int s = 0; s < Stripes; s++) {
+    Lock(s);
+    SnapStripeV[s].Clr();
+    Unlock(s);
+  }
+  return Graph;
+}
+
+void TNGraphConc::Clr() {
+  LockAll();
+  for (int s = 0; s < StripeV.Len(); s++) {
+    StripeV[s] = new TStripe();
+  }
+  MxNId = 0;
+  NNodes = 0;
+  NEdges = 0;
+  UnlockAll();
+}
+
+#endif // GCC_ATOMIC
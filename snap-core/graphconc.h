@@ -0,0 +1,116 @@
+#ifndef GRAPHCONC_H
+#define GRAPHCONC_H
+
+#ifdef GCC_ATOMIC
+//#//////////////////////////////////////////////
+/// Directed graphs for concurrent updates
+
+class TNGraphConc;
+
+/// Pointer to a directed graph for concurrent updates (TNGraphConc)
+typedef TPt<TNGraphConc> PNGraphConc;
+
+//#//////////////////////////////////////////////
+/// Directed graph that many threads can update at the same time. ##TNGraphConc::Class
+class TNGraphConc {
+public:
+  typedef TNGraphConc TNet;
+  typedef TPt<TNGraphConc> PNet;
+private:
+  class TNode {
+  public:
+    TInt Id;
+    TIntV InNIdV, OutNIdV;
+  public:
+    TNode() : Id(-1), InNIdV(), OutNIdV() { }
+    TNode(const int& NId) : Id(NId), InNIdV(), OutNIdV() { }
+    TNode(const TNode& Node) : Id(Node.Id), InNIdV(Node.InNIdV), OutNIdV(Node.OutNIdV) { }
+    TNode& operator = (const TNode& Node) { Id = Node.Id; InNIdV = Node.InNIdV; OutNIdV = Node.OutNIdV; return *this; }
+  };
+  /// Nodes whose IDs fall into one lock stripe. Shared with snapshots until the next update.
+  class TStripe {
+  private:
+    TCRef CRef;
+  public:
+    THash<TInt, TNode> NodeH;
+  public:
+    TStripe() : CRef(), NodeH() { }
+    TStripe(const TStripe& Stripe) : CRef(), NodeH(Stripe.NodeH) { }
+    friend class TPt<TStripe>;
+  };
+  typedef TPt<TStripe> PStripe;
+private:
+  TCRef CRef;
+  TInt StripeMask;
+  TVec<PStripe> StripeV;
+  omp_lock_t* LockV;
+  TInt MxNId, NNodes;
+  TInt64 NEdges;
+private:
+  int GetStripeN(const int& NId) const { return NId & StripeMask; }
+  void Lock(const int& StripeN) const { omp_set_lock(&LockV[StripeN]); }
+  void Unlock(const int& StripeN) const { omp_unset_lock(&LockV[StripeN]); }
+  void Lock2(const int& StripeN1, const int& StripeN2) const;
+  void Unlock2(const int& StripeN1, const int& StripeN2) const;
+  void LockAll() const;
+  void UnlockAll() const;
+  THash<TInt, TNode>& GetNodeH(const int& StripeN);
+  const THash<TInt, TNode>& GetNodeH(const int& StripeN) const { return StripeV[StripeN]->NodeH; }
+  void UpdMxNId(const int& NId);
+  bool AddNodeLocked(const int& NId);
+private:
+  TNGraphConc(const TNGraphConc& Graph);
+  TNGraphConc& operator = (const TNGraphConc& Graph);
+public:
+  /// Constructs an empty graph whose nodes are spread over at least MnStripes separately locked stripes.
+  TNGraphConc(const int& MnStripes=1024);
+  ~TNGraphConc();
+  /// Static constructor that returns a pointer to the graph. Call: PNGraphConc Graph = TNGraphConc::New().
+  static PNGraphConc New(const int& MnStripes=1024) { return new TNGraphConc(MnStripes); }
+  /// Returns the number of lock stripes.
+  int GetStripes() const { return StripeV.Len(); }
+
+  /// Returns the number of nodes in the graph.
+  int GetNodes() const { return NNodes; }
+  /// Adds a node of ID NId to the graph. ##TNGraphConc::AddNode
+  int AddNode(int NId = -1);
+  /// Adds a node of ID NId to the graph, noop if the node already exists.
+  int AddNodeUnchecked(int NId = -1);
+  /// Deletes node of ID NId from the graph. ##TNGraphConc::DelNode
+  void DelNode(const int& NId);
+  /// Tests whether ID NId is a node.
+  bool IsNode(const int& NId) const;
+  /// Returns an ID that is larger than any node ID in the graph.
+  int GetMxNId() const { return MxNId; }
+
+  /// Returns the number of edges in the graph.
+  int64 GetEdges() const { return NEdges; }
+  /// Adds an edge from node SrcNId to node DstNId to the graph. ##TNGraphConc::AddEdge
+  int AddEdge(const int& SrcNId, const int& DstNId);
+  /// Adds an edge from node SrcNId to node DstNId to the graph, adding the nodes if they do not exist.
+  int AddEdge2(const int& SrcNId, const int& DstNId);
+  /// Deletes an edge from node SrcNId to node DstNId from the graph, noop if the edge does not exist.
+  void DelEdge(const int& SrcNId, const int& DstNId);
+  /// Tests whether an edge from node SrcNId to node DstNId exists in the graph.
+  bool IsEdge(const int& SrcNId, const int& DstNId) const;
+
+  /// Returns the out-degree of node NId, -1 if the node does not exist.
+  int GetOutDeg(const int& NId) const;
+  /// Returns the in-degree of node NId, -1 if the node does not exist.
+  int GetInDeg(const int& NId) const;
+  /// Copies the sorted out-neighbors of node NId to NIdV. Returns false if the node does not exist.
+  bool GetOutNIdV(const int& NId, TIntV& NIdV) const;
+  /// Copies the sorted in-neighbors of node NId to NIdV. Returns false if the node does not exist.
+  bool GetInNIdV(const int& NId, TIntV& NIdV) const;
+
+  /// Returns a consistent copy of the graph as a TNGraph. ##TNGraphConc::GetSnapshot
+  PNGraph GetSnapshot();
+  /// Deletes all nodes and edges from the graph.
+  void Clr();
+
+  friend class TPt<TNGraphConc>;
+};
+
+#endif // GCC_ATOMIC
+
+#endif // GRAPHCONC_H
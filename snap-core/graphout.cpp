@@ -0,0 +1,258 @@
+/////////////////////////////////////////////////
+// Directed Node Graph with Out-Edges only
+bool TNGraphOut::HasFlag(const TGraphFlag& Flag) const {
+  return HasGraphFlag(TNGraphOut::TNet, Flag);
+}
+
+// Counts the in-degree of every node, then places the sources of the in-edges
+// of each node next to each other and sorts every list. Threads that query the
+// in-edges at the same time wait for the first one to build them.
+void TNGraphOut::BuildInEdgesIndex() const {
+  #pragma omp critical(TNGraphOutInEdges)
+  {
+    if (! HasInEdges()) { BuildInEdgesIndexLocked(); }
+  }
+}
+
+void TNGraphOut::BuildInEdgesIndexLocked() const {
+  const int KeyIds = NodeH.GetMxKeyIds();
+  TIntV OffV(KeyIds+1);
+  for (int N = NodeH.FFirstKeyId(); NodeH.FNextKeyId(N); ) {
+    const TNode& Node = NodeH[N];
+    for (int e = 0; e < Node.GetOutDeg(); e++) {
+      OffV[NodeH.GetKeyId(Node.GetOutNId(e))+1]++; }
+  }
+  for (int KeyId = 0; KeyId < KeyIds; KeyId++) {
+    OffV[KeyId+1] += OffV[KeyId]; }
+  TIntV NIdV(OffV.Last()), PosV(OffV);
+  for (int N = NodeH.FFirstKeyId(); NodeH.FNextKeyId(N); ) {
+    const TNode& Node = NodeH[N];
+    for (int e = 0; e < Node.GetOutDeg(); e++) {
+      const int DstKeyId = NodeH.GetKeyId(Node.GetOutNId(e));
+      NIdV[PosV[DstKeyId]] = Node.GetId();
+      PosV[DstKeyId]++;
+    }
+  }
+  #pragma omp parallel for schedule(dynamic,1000)
+  for (int KeyId = 0; KeyId < KeyIds; KeyId++) {
+    if (OffV[KeyId+1] - OffV[KeyId] > 1) {
+      NIdV.QSort(OffV[KeyId], OffV[KeyId+1]-1, true); }
+  }
+  TIntV DegV(KeyIds);
+  for (int KeyId = 0; KeyId < KeyIds; KeyId++) {
+    DegV[KeyId] = OffV[KeyId+1] - OffV[KeyId]; }
+  InNIdV.MoveFrom(NIdV);
+  InDegV.MoveFrom(DegV);
+  InOffV.MoveFrom(OffV);
+  __atomic_store_n(&InEdgesOk.Val, 1, __ATOMIC_RELEASE);
+}
+
+int TNGraphOut::AddNode(int NId) {
+  if (NId == -1) {
+    NId = MxNId;  MxNId++;
+  } else {
+    IAssertR(!IsNode(NId), TStr::Fmt("NodeId %d already exists", NId));
+    MxNId = TMath::Mx(NId+1, MxNId());
+  }
+  NodeH.AddDat(NId, TNode(NId));
+  ClrInEdges();
+  return NId;
+}
+
+int TNGraphOut::AddNodeUnchecked(int NId) {
+  if (IsNode(NId)) { return NId;}
+  MxNId = TMath::Mx(NId+1, MxNId());
+  NodeH.AddDat(NId, TNode(NId));
+  ClrInEdges();
+  return NId;
+}
+
+// removes NId from the sorted in-edges of the node with hash key id KeyId
+void TNGraphOut::DelInNId(const int& KeyId, const int& NId) {
+  TInt* NIdV = InNIdV.BegI() + InOffV[KeyId];
+  const int Deg = InDegV[KeyId];
+  int Lo = 0, Hi = Deg;
+  while (Lo < Hi) {
+    const int Mid = (Lo + Hi) / 2;
+    if (NIdV[Mid] < NId) { Lo = Mid + 1; } else { Hi = Mid; }
+  }
+  IAssert(Lo < Deg && NIdV[Lo] == NId);
+  for (int e = Lo+1; e < Deg; e++) { NIdV[e-1] = NIdV[e]; }
+  InDegV[KeyId]--;
+}
+
+// the in-edges find the nodes pointing to NId if they are built and are kept up to date,
+// otherwise the out-neighbors of all nodes are searched for NId
+void TNGraphOut::DelNode(const int& NId) {
+  const int KeyId = NodeH.GetKeyId(NId);
+  IAssertR(KeyId != -1, TStr::Fmt("NodeId %d does not exist", NId));
+  const TNode& Node = NodeH[KeyId];
+  int DelEdges = Node.GetOutDeg();
+  if (HasInEdges()) {
+    for (int e = 0; e < InDegV[KeyId]; e++) {
+      const int SrcNId = InNIdV[InOffV[KeyId] + e];
+      if (SrcNId == NId) { continue; }
+      TIntV& OutNIdV = GetNode(SrcNId).OutNIdV;
+      const int Pos = OutNIdV.SearchBin(NId);
+      IAssert(Pos != -1);
+      OutNIdV.Del(Pos);
+      DelEdges++;
+    }
+    for (int e = 0; e < Node.GetOutDeg(); e++) {
+      const int DstKeyId = NodeH.GetKeyId(Node.GetOutNId(e));
+      if (DstKeyId != KeyId) { DelInNId(DstKeyId, NId); }
+    }
+    InDegV[KeyId] = 0;
+  } else {
+    #pragma omp parallel for schedule(dynamic,1000) reduction(+:DelEdges)
+    for (int N = 0; N < NodeH.GetMxKeyIds(); N++) {
+      if (N == KeyId || ! NodeH.IsKeyId(N)) { continue; }
+      TIntV& OutNIdV = NodeH[N].OutNIdV;
+      const int Pos = OutNIdV.SearchBin(NId);
+      if (Pos != -1) { OutNIdV.Del(Pos);  DelEdges++; }
+    }
+  }
+  NEdges -= DelEdges;
+  NodeH.DelKey(NId);
+}
+
+int TNGraphOut::AddEdge(const int& SrcNId, const int& DstNId) {
+  IAssertR(IsNode(SrcNId) && IsNode(DstNId), TStr::Fmt("%d or %d not a node.", SrcNId, DstNId).CStr());
+  if (IsEdge(SrcNId, DstNId)) { return -2; }
+  GetNode(SrcNId).OutNIdV.AddSorted(DstNId);
+  NEdges++;
+  ClrInEdges();
+  return -1; // no edge id
+}
+
+int TNGraphOut::AddEdgeUnchecked(const int& SrcNId, const int& DstNId) {
+  GetNode(SrcNId).OutNIdV.Add(DstNId);
+  NEdges++;
+  ClrInEdges();
+  return -1; // no edge id
+}
+
+int TNGraphOut::AddEdge2(const int& SrcNId, const int& DstNId) {
+  if (! IsNode(SrcNId)) { AddNode(SrcNId); }
+  if (! IsNode(DstNId)) { AddNode(DstNId); }
+  return AddEdge(SrcNId, DstNId);
+}
+
+void TNGraphOut::DelEdge(const int& SrcNId, const int& DstNId, const bool& IsDir) {
+  IAssertR(IsNode(SrcNId) && IsNode(DstNId), TStr::Fmt("%d or %d not a node.", SrcNId, DstNId).CStr());
+  { TIntV& OutNIdV = GetNode(SrcNId).OutNIdV;
+  const int Pos = OutNIdV.SearchBin(DstNId);
+  if (Pos != -1) { OutNIdV.Del(Pos); NEdges--; } }
+  if (! IsDir) {
+    TIntV& OutNIdV = GetNode(DstNId).OutNIdV;
+    const int Pos = OutNIdV.SearchBin(SrcNId);
+    if (Pos != -1) { OutNIdV.Del(Pos); NEdges--; }
+  }
+  ClrInEdges();
+}
+
+bool TNGraphOut::IsEdge(const int& SrcNId, const int& DstNId, const bool& IsDir) const {
+  if (! IsNode(SrcNId) || ! IsNode(DstNId)) { return false; }
+  if (IsDir) { return GetNode(SrcNId).IsOutNId(DstNId); }
+  else { return GetNode(SrcNId).IsOutNId(DstNId) || GetNode(DstNId).IsOutNId(SrcNId); }
+}
+
+TNGraphOut::TEdgeI TNGraphOut::GetEI(const int& SrcNId, const int& DstNId) const {
+  const TNodeI SrcNI = GetNI(SrcNId);
+  const int NodeN = SrcNI.NodeHI.GetDat().OutNIdV.SearchBin(DstNId);
+  IAssert(NodeN != -1);
+  return TEdgeI(SrcNI, EndNI(), NodeN);
+}
+
+void TNGraphOut::GetNIdV(TIntV& NIdV) const {
+  NIdV.Gen(GetNodes(), 0);
+  for (int N=NodeH.FFirstKeyId(); NodeH.FNextKeyId(N); ) {
+    NIdV.Add(NodeH.GetKey(N)); }
+}
+
+void TNGraphOut::SortNodeAdjV() {
+  int Edges = 0;
+  #pragma omp parallel for schedule(dynamic,1000) reduction(+:Edges)
+  for (int KeyId = 0; KeyId < NodeH.GetMxKeyIds(); KeyId++) {
+    if (! NodeH.IsKeyId(KeyId)) { continue; }
+    TIntV& OutNIdV = NodeH[KeyId].OutNIdV;
+    OutNIdV.Sort();
+    OutNIdV.Merge();
+    Edges += OutNIdV.Len();
+  }
+  NEdges = Edges;
+  ClrInEdges();
+}
+
+void TNGraphOut::Defrag(const bool& OnlyNodeLinks) {
+  for (int n = NodeH.FFirstKeyId(); NodeH.FNextKeyId(n); ) {
+    NodeH[n].PackOutNIdV();
+  }
+  if (! OnlyNodeLinks && ! NodeH.IsKeyIdEqKeyN()) {
+    NodeH.Defrag();
+    ClrInEdges();
+  }
+}
+
+::TSize TNGraphOut::GetMemUsed() const {
+  ::TSize MemUsed = sizeof(TNGraphOut) + NodeH.GetMemUsed() + InOffV.GetMemUsed() + InDegV.GetMemUsed() + InNIdV.GetMemUsed();
+  for (int N = NodeH.FFirstKeyId(); NodeH.FNextKeyId(N); ) {
+    MemUsed += NodeH[N].OutNIdV.GetMemUsed() - sizeof(TIntV); }
+  return MemUsed;
+}
+
+// for each node check that their neighbors are also nodes
+bool TNGraphOut::IsOk(const bool& ThrowExcept) const {
+  bool RetVal = true;
+  int Edges = 0;
+  for (int N = NodeH.FFirstKeyId(); NodeH.FNextKeyId(N); ) {
+    const TNode& Node = NodeH[N];
+    for (int e = 0; e < Node.GetOutDeg(); e++) {
+      if (! IsNode(Node.GetOutNId(e))) {
+        const TStr Msg = TStr::Fmt("Out-edge %d --> %d: node %d does not exist.",
+          Node.GetId(), Node.GetOutNId(e), Node.GetOutNId(e));
+        if (ThrowExcept) { EAssertR(false, Msg); } else { ErrNotify(Msg.CStr()); } RetVal=false;
+      }
+      if (e > 0 && Node.GetOutNId(e-1) >= Node.GetOutNId(e)) {
+        const TStr Msg = TStr::Fmt("Out-neighbor list of node %d is not sorted or has duplicate out-edge %d --> %d.",
+          Node.GetId(), Node.GetId(), Node.GetOutNId(e));
+        if (ThrowExcept) { EAssertR(false, Msg); } else { ErrNotify(Msg.CStr()); } RetVal=false;
+      }
+    }
+    Edges += Node.GetOutDeg();
+  }
+  if (Edges != NEdges) {
+    const TStr Msg = TStr::Fmt("Number of edges counter is corrupted: GetEdges():%d, EdgeCount:%d.", GetEdges(), Edges);
+    if (ThrowExcept) { EAssertR(false, Msg); } else { ErrNotify(Msg.CStr()); } RetVal=false;
+  }
+  int InEdges = 0;
+  if (HasInEdges() && InDegV.Len() == NodeH.GetMxKeyIds()) {
+    for (int N = NodeH.FFirstKeyId(); NodeH.FNextKeyId(N); ) { InEdges += InDegV[N]; }
+  }
+  if (HasInEdges() && (InOffV.Len() != NodeH.GetMxKeyIds()+1 || InDegV.Len() != NodeH.GetMxKeyIds() || InEdges != NEdges)) {
+    const TStr Msg = TStr::Fmt("In-edges are out of date: %d in-edges, %d edges.", InEdges, GetEdges());
+    if (ThrowExcept) { EAssertR(false, Msg); } else { ErrNotify(Msg.CStr()); } RetVal=false;
+  }
+  return RetVal;
+}
+
+void TNGraphOut::Dump(FILE *OutF) const {
+  const int NodePlaces = (int) ceil(log10((double) GetNodes()));
+  fprintf(OutF, "-------------------------------------------------\nDirected Node Graph (out-edges): nodes: %d, edges: %d\n", GetNodes(), GetEdges());
+  for (TNodeI NI = BegNI(); NI < EndNI(); NI++) {
+    fprintf(OutF, "  %*d]\n", NodePlaces, NI.GetId());
+    fprintf(OutF, "    out[%d]", NI.GetOutDeg());
+    for (int edge = 0; edge < NI.GetOutDeg(); edge++) {
+      fprintf(OutF, " %*d", NodePlaces, NI.GetOutNId(edge)); }
+    fprintf(OutF, "\n");
+  }
+  fprintf(OutF, "\n");
+}
+
+PNGraphOut TNGraphOut::GetSmallGraph() {
+  PNGraphOut G = TNGraphOut::New();
+  for (int i = 0; i < 5; i++) { G->AddNode(i); }
+  G->AddEdge(0,1); G->AddEdge(1,2); G->AddEdge(0,2);
+  G->AddEdge(1,3); G->AddEdge(3,4); G->AddEdge(2,3);
+  return G;
+}
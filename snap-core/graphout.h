@@ -0,0 +1,220 @@
+//#//////////////////////////////////////////////
+/// Directed graphs that store only out-edges
+
+class TNGraphOut;
+
+/// Pointer to a directed graph that stores only out-edges (TNGraphOut)
+typedef TPt<TNGraphOut> PNGraphOut;
+
+//#//////////////////////////////////////////////
+/// Directed graph that stores only out-edges, in-edges are built on demand. ##TNGraphOut::Class
+class TNGraphOut {
+public:
+  typedef TNGraphOut TNet;
+  typedef TPt<TNGraphOut> PNet;
+public:
+  class TNode {
+  private:
+    TInt Id;
+    TIntV OutNIdV;
+  public:
+    TNode() : Id(-1), OutNIdV() { }
+    TNode(const int& NId) : Id(NId), OutNIdV() { }
+    TNode(const TNode& Node) : Id(Node.Id), OutNIdV(Node.OutNIdV) { }
+    TNode(TSIn& SIn) : Id(SIn), OutNIdV(SIn) { }
+    void Save(TSOut& SOut) const { Id.Save(SOut); OutNIdV.Save(SOut); }
+    int GetId() const { return Id; }
+    int GetOutDeg() const { return OutNIdV.Len(); }
+    int GetOutNId(const int& NodeN) const { return OutNIdV[NodeN]; }
+    bool IsOutNId(const int& NId) const { return OutNIdV.SearchBin(NId) != -1; }
+    void PackOutNIdV() { OutNIdV.Trunc(); }
+    ::TSize GetMemUsed() const { return Id.GetMemUsed() + OutNIdV.GetMemUsed(); }
+    friend class TNGraphOut;
+  };
+  /// Node iterator. Only forward iteration (operator++) is supported.
+  class TNodeI {
+  private:
+    typedef THash<TInt, TNode>::TIter THashIter;
+    THashIter NodeHI;
+    const TNGraphOut* Graph;
+  private:
+    int GetKeyId() const { return Graph->NodeH.GetKeyId(NodeHI); }
+  public:
+    TNodeI() : NodeHI(), Graph(NULL) { }
+    TNodeI(const THashIter& NodeHIter, const TNGraphOut* GraphPt) : NodeHI(NodeHIter), Graph(GraphPt) { }
+    TNodeI(const TNodeI& NodeI) : NodeHI(NodeI.NodeHI), Graph(NodeI.Graph) { }
+    TNodeI& operator = (const TNodeI& NodeI) { NodeHI = NodeI.NodeHI; Graph = NodeI.Graph; return *this; }
+    /// Increment iterator.
+    TNodeI& operator++ (int) { NodeHI++; return *this; }
+    /// Decrement iterator.
+    TNodeI& operator-- (int) { NodeHI--; return *this; }
+    bool operator < (const TNodeI& NodeI) const { return NodeHI < NodeI.NodeHI; }
+    bool operator == (const TNodeI& NodeI) const { return NodeHI == NodeI.NodeHI; }
+    /// Returns ID of the current node.
+    int GetId() const { return NodeHI.GetDat().GetId(); }
+    /// Returns degree of the current node, the sum of in-degree and out-degree. Builds the in-edges if needed.
+    int GetDeg() const { return GetInDeg() + GetOutDeg(); }
+    /// Returns in-degree of the current node. Builds the in-edges if needed.
+    int GetInDeg() const { return Graph->GetInDeg(GetKeyId()); }
+    /// Returns out-degree of the current node.
+    int GetOutDeg() const { return NodeHI.GetDat().GetOutDeg(); }
+    /// Returns ID of NodeN-th in-node (the node pointing to the current node). Builds the in-edges if needed.
+    int GetInNId(const int& NodeN) const { return Graph->GetInNId(GetKeyId(), NodeN); }
+    /// Returns ID of NodeN-th out-node (the node the current node points to).
+    int GetOutNId(const int& NodeN) const { return NodeHI.GetDat().GetOutNId(NodeN); }
+    /// Returns ID of NodeN-th neighboring node.
+    int GetNbrNId(const int& NodeN) const { return NodeN<GetOutDeg()?GetOutNId(NodeN):GetInNId(NodeN-GetOutDeg()); }
+    /// Tests whether node with ID NId points to the current node.
+    bool IsInNId(const int& NId) const { return Graph->IsEdge(NId, GetId()); }
+    /// Tests whether the current node points to node with ID NId.
+    bool IsOutNId(const int& NId) const { return NodeHI.GetDat().IsOutNId(NId); }
+    /// Tests whether node with ID NId is a neighbor of the current node.
+    bool IsNbrNId(const int& NId) const { return IsOutNId(NId) || IsInNId(NId); }
+    friend class TNGraphOut;
+  };
+  /// Edge iterator. Only forward iteration (operator++) is supported.
+  class TEdgeI {
+  private:
+    TNodeI CurNode, EndNode;
+    int CurEdge;
+  public:
+    TEdgeI() : CurNode(), EndNode(), CurEdge(0) { }
+    TEdgeI(const TNodeI& NodeI, const TNodeI& EndNodeI, const int& EdgeN=0) : CurNode(NodeI), EndNode(EndNodeI), CurEdge(EdgeN) { }
+    TEdgeI(const TEdgeI& EdgeI) : CurNode(EdgeI.CurNode), EndNode(EdgeI.EndNode), CurEdge(EdgeI.CurEdge) { }
+    TEdgeI& operator = (const TEdgeI& EdgeI) { if (this!=&EdgeI) { CurNode=EdgeI.CurNode; EndNode=EdgeI.EndNode; CurEdge=EdgeI.CurEdge; }  return *this; }
+    /// Increment iterator.
+    TEdgeI& operator++ (int) { CurEdge++; if (CurEdge >= CurNode.GetOutDeg()) { CurEdge=0; CurNode++;
+      while (CurNode < EndNode && CurNode.GetOutDeg()==0) { CurNode++; } }  return *this; }
+    bool operator < (const TEdgeI& EdgeI) const { return CurNode<EdgeI.CurNode || (CurNode==EdgeI.CurNode && CurEdge<EdgeI.CurEdge); }
+    bool operator == (const TEdgeI& EdgeI) const { return CurNode == EdgeI.CurNode && CurEdge == EdgeI.CurEdge; }
+    /// Returns edge ID. Always returns -1 since only edges in multigraphs have explicit IDs.
+    int GetId() const { return -1; }
+    /// Returns the source node of the edge.
+    int GetSrcNId() const { return CurNode.GetId(); }
+    /// Returns the destination node of the edge.
+    int GetDstNId() const { return CurNode.GetOutNId(CurEdge); }
+    friend class TNGraphOut;
+  };
+private:
+  TCRef CRef;
+  TInt MxNId, NEdges;
+  THash<TInt, TNode> NodeH;
+  // in-edges of the node with hash key id KeyId are InNIdV[InOffV[KeyId]] .. InNIdV[InOffV[KeyId]+InDegV[KeyId]-1],
+  // DelNode() removes in-edges in place and leaves gaps between the lists,
+  // InEdgesOk is set once the vectors are built, so that concurrent readers never see them half built
+  mutable TIntV InOffV, InDegV, InNIdV;
+  mutable TInt InEdgesOk;
+private:
+  TNode& GetNode(const int& NId) { return NodeH.GetDat(NId); }
+  const TNode& GetNode(const int& NId) const { return NodeH.GetDat(NId); }
+  int GetInDeg(const int& KeyId) const { BuildInEdges();  return InDegV[KeyId]; }
+  int GetInNId(const int& KeyId, const int& NodeN) const { BuildInEdges();  return InNIdV[InOffV[KeyId] + NodeN]; }
+  void BuildInEdgesIndex() const;
+  void BuildInEdgesIndexLocked() const;
+  void DelInNId(const int& KeyId, const int& NId);
+public:
+  TNGraphOut() : CRef(), MxNId(0), NEdges(0), NodeH(), InOffV(), InDegV(), InNIdV(), InEdgesOk(0) { }
+  /// Constructor that reserves enough memory for a graph of Nodes nodes and Edges edges.
+  explicit TNGraphOut(const int& Nodes, const int& Edges) : MxNId(0), NEdges(0), InEdgesOk(0) { Reserve(Nodes, Edges); }
+  TNGraphOut(const TNGraphOut& Graph) : MxNId(Graph.MxNId), NEdges(Graph.NEdges), NodeH(Graph.NodeH), InOffV(), InDegV(), InNIdV(), InEdgesOk(0) { }
+  /// Constructor that loads the graph from a (binary) stream SIn.
+  TNGraphOut(TSIn& SIn) : MxNId(SIn), NEdges(SIn), NodeH(SIn), InOffV(), InDegV(), InNIdV(), InEdgesOk(0) { }
+  /// Saves the graph to a (binary) stream SOut. In-edges are not saved.
+  void Save(TSOut& SOut) const { MxNId.Save(SOut); NEdges.Save(SOut); NodeH.Save(SOut); }
+  /// Static constructor that returns a pointer to the graph. Call: PNGraphOut Graph = TNGraphOut::New().
+  static PNGraphOut New() { return new TNGraphOut(); }
+  /// Static constructor that returns a pointer to the graph and reserves enough memory for Nodes nodes and Edges edges.
+  static PNGraphOut New(const int& Nodes, const int& Edges) { return new TNGraphOut(Nodes, Edges); }
+  /// Static constructor that loads the graph from a stream SIn and returns a pointer to it.
+  static PNGraphOut Load(TSIn& SIn) { return PNGraphOut(new TNGraphOut(SIn)); }
+  /// Allows for run-time checking the type of the graph (see the TGraphFlag for flags).
+  bool HasFlag(const TGraphFlag& Flag) const;
+  TNGraphOut& operator = (const TNGraphOut& Graph) {
+    if (this!=&Graph) { MxNId=Graph.MxNId; NEdges=Graph.NEdges; NodeH=Graph.NodeH; ClrInEdges(); }  return *this; }
+
+  /// Returns the number of nodes in the graph.
+  int GetNodes() const { return NodeH.Len(); }
+  /// Adds a node of ID NId to the graph. ##TNGraphOut::AddNode
+  int AddNode(int NId = -1);
+  /// Adds a node of ID NId to the graph, noop if the node already exists.
+  int AddNodeUnchecked(int NId = -1);
+  /// Adds a node of ID NodeI.GetId() to the graph.
+  int AddNode(const TNodeI& NodeI) { return AddNode(NodeI.GetId()); }
+  /// Deletes node of ID NId from the graph. ##TNGraphOut::DelNode
+  void DelNode(const int& NId);
+  /// Tests whether ID NId is a node.
+  bool IsNode(const int& NId) const { return NodeH.IsKey(NId); }
+  /// Returns an iterator referring to the first node in the graph.
+  TNodeI BegNI() const { return TNodeI(NodeH.BegI(), this); }
+  /// Returns an iterator referring to the past-the-end node in the graph.
+  TNodeI EndNI() const { return TNodeI(NodeH.EndI(), this); }
+  /// Returns an iterator referring to the node of ID NId in the graph.
+  TNodeI GetNI(const int& NId) const { return TNodeI(NodeH.GetI(NId), this); }
+  /// Returns an ID that is larger than any node ID in the graph.
+  int GetMxNId() const { return MxNId; }
+
+  /// Returns the number of edges in the graph.
+  int GetEdges() const { return NEdges; }
+  /// Adds an edge from node SrcNId to node DstNId to the graph. Returns -2 if the edge already exists.
+  int AddEdge(const int& SrcNId, const int& DstNId);
+  /// Adds an edge between node IDs SrcNId and DstNId to the graph, ignores EId (for compatibility with TNEANet).
+  int AddEdge(const int& SrcNId, const int& DstNId, const int& EId) { return AddEdge(SrcNId, DstNId); }
+  /// Adds an edge from node SrcNId to node DstNId to the graph. ##TNGraphOut::AddEdgeUnchecked
+  int AddEdgeUnchecked(const int& SrcNId, const int& DstNId);
+  /// Adds an edge from node IDs SrcNId to node DstNId to the graph. If nodes do not exist, create them.
+  int AddEdge2(const int& SrcNId, const int& DstNId);
+  /// Adds an edge from EdgeI.GetSrcNId() to EdgeI.GetDstNId() to the graph.
+  int AddEdge(const TEdgeI& EdgeI) { return AddEdge(EdgeI.GetSrcNId(), EdgeI.GetDstNId()); }
+  /// Deletes an edge from node IDs SrcNId to DstNId from the graph. If IsDir=false, also deletes the edge from DstNId to SrcNId.
+  void DelEdge(const int& SrcNId, const int& DstNId, const bool& IsDir = true);
+  /// Tests whether an edge from node IDs SrcNId to DstNId exists in the graph.
+  bool IsEdge(const int& SrcNId, const int& DstNId, const bool& IsDir = true) const;
+  /// Tests whether an edge EId exists in the graph (for compatibility with TNEANet), always returns false.
+  bool IsEdge(const int& EId) const { return false; }
+  /// Returns an iterator referring to the first edge in the graph.
+  TEdgeI BegEI() const { TNodeI NI=BegNI(); while(NI<EndNI() && NI.GetOutDeg()==0){NI++;} return TEdgeI(NI, EndNI()); }
+  /// Returns an iterator referring to the past-the-end edge in the graph.
+  TEdgeI EndEI() const { return TEdgeI(EndNI(), EndNI()); }
+  /// Returns an iterator referring to edge (SrcNId, DstNId) in the graph.
+  TEdgeI GetEI(const int& SrcNId, const int& DstNId) const;
+
+  /// Tests whether the in-edges are built.
+  bool HasInEdges() const { return __atomic_load_n(&InEdgesOk.Val, __ATOMIC_ACQUIRE) != 0; }
+  /// Builds the in-edges of all nodes, noop if they are already built. ##TNGraphOut::BuildInEdges
+  void BuildInEdges() const { if (! HasInEdges()) { BuildInEdgesIndex(); } }
+  /// Frees the memory used by the in-edges. They are built again on the next in-edge query.
+  void ClrInEdges() const { InEdgesOk = 0;  InOffV.Clr();  InDegV.Clr();  InNIdV.Clr(); }
+
+  /// Returns an ID of a random node in the graph.
+  int GetRndNId(TRnd& Rnd=TInt::Rnd) { return NodeH.GetKey(NodeH.GetRndKeyId(Rnd, 0.8)); }
+  /// Returns an interator referring to a random node in the graph.
+  TNodeI GetRndNI(TRnd& Rnd=TInt::Rnd) { return GetNI(GetRndNId(Rnd)); }
+  /// Gets a vector IDs of all nodes in the graph.
+  void GetNIdV(TIntV& NIdV) const;
+  /// Tests whether the graph is empty (has zero nodes).
+  bool Empty() const { return GetNodes()==0; }
+  /// Deletes all nodes and edges from the graph.
+  void Clr() { MxNId=0; NEdges=0; NodeH.Clr(); ClrInEdges(); }
+  /// Reserves memory for a graph of Nodes nodes and Edges edges.
+  void Reserve(const int& Nodes, const int& Edges) { if (Nodes>0) { NodeH.Gen(Nodes/2); } }
+  /// Reserves memory for node ID NId having OutDeg out-edges.
+  void ReserveNIdOutDeg(const int& NId, const int& OutDeg) { GetNode(NId).OutNIdV.Reserve(OutDeg); }
+  /// Sorts the out-neighbors of each node and removes duplicate edges. ##TNGraphOut::SortNodeAdjV
+  void SortNodeAdjV();
+  /// Defragments the graph. ##TNGraphOut::Defrag
+  void Defrag(const bool& OnlyNodeLinks=false);
+  /// Returns the number of bytes used by the graph, including the in-edges if they are built.
+  ::TSize GetMemUsed() const;
+  /// Checks the graph data structure for internal consistency.
+  bool IsOk(const bool& ThrowExcept=true) const;
+  /// Print the graph in a human readable form to an output stream OutF.
+  void Dump(FILE *OutF=stdout) const;
+  /// Returns a small graph on 5 nodes and 6 edges.
+  static PNGraphOut GetSmallGraph();
+  friend class TPt<TNGraphOut>;
+};
+
+// set flags
+namespace TSnap {
+template <> struct IsDirected<TNGraphOut> { enum { Val = 1 }; };
+}
@@ -0,0 +1,322 @@
+/////////////////////////////////////////////////
+// Directed Node Graph with Slab Pool
+bool TNGraphSlab::HasFlag(const TGraphFlag& Flag) const {
+  return HasGraphFlag(TNGraphSlab::TNet, Flag);
+}
+
+int TNGraphSlab::SearchBin(const TInt64& Slot, const int& Vals, const int& NId) const {
+  if (Vals == 0) { return -1; }
+  const TInt* NIdT = Pool.GetValVPt(Slot);
+  int LValN = 0, RValN = Vals-1;
+  while (RValN >= LValN) {
+    const int ValN = (LValN+RValN)/2;
+    if (NId == NIdT[ValN]) { return ValN; }
+    if (NId < NIdT[ValN]) { RValN = ValN-1; } else { LValN = ValN+1; }
+  }
+  return -1;
+}
+
+void TNGraphSlab::AddSorted(TInt64& Slot, TInt& Vals, const int& NId) {
+  Slot = Pool.Renew(Slot, Vals, Vals+1);
+  TInt* NIdT = Pool.GetValVPt(Slot);
+  int ValN = Vals;
+  for (; ValN > 0 && NIdT[ValN-1] > NId; ValN--) { NIdT[ValN] = NIdT[ValN-1]; }
+  NIdT[ValN] = NId;
+  Vals++;
+}
+
+bool TNGraphSlab::DelSorted(TInt64& Slot, TInt& Vals, const int& NId) {
+  const int ValN = SearchBin(Slot, Vals, NId);
+  if (ValN == -1) { return false; }
+  TInt* NIdT = Pool.GetValVPt(Slot);
+  for (int n = ValN+1; n < Vals; n++) { NIdT[n-1] = NIdT[n]; }
+  Vals--;
+  if (Vals == 0) { Pool.DelSlot(Slot);  Slot = -1; }
+  return true;
+}
+
+void TNGraphSlab::SortUnique(const TInt64& Slot, TInt& Vals) const {
+  if (Vals < 2) { return; }
+  TIntV NIdV(Pool.GetValVPt(Slot), Vals);
+  Vals = TSnapDetail::MergeBatchNIdV(NIdV, 0);
+}
+
+void TNGraphSlab::PutNIdV(TInt64& Slot, TInt& Vals, const TInt* NIdT, const int& NIds) {
+  Pool.DelSlot(Slot);
+  Slot = Pool.AddV(NIdT, NIds);
+  Vals = NIds;
+}
+
+TNGraphSlab::TNGraphSlab(TSIn& SIn) : MxNId(SIn), NEdges(0), NodeH(), Pool() {
+  const TInt Nodes(SIn);
+  NodeH.Gen(Nodes);
+  for (int n = 0; n < Nodes; n++) {
+    const TInt NId(SIn);
+    const TIntV InNIdV(SIn), OutNIdV(SIn);
+    TNode& Node = NodeH.AddDat(NId, TNode(NId));
+    PutNIdV(Node.InSlot, Node.InDeg, InNIdV.BegI(), InNIdV.Len());
+    PutNIdV(Node.OutSlot, Node.OutDeg, OutNIdV.BegI(), OutNIdV.Len());
+    NEdges += Node.OutDeg;
+  }
+}
+
+// The adjacency lists are saved as TIntV, slot IDs are not saved.
+void TNGraphSlab::Save(TSOut& SOut) const {
+  MxNId.Save(SOut);
+  TInt(GetNodes()).Save(SOut);
+  for (int N = NodeH.FFirstKeyId(); NodeH.FNextKeyId(N); ) {
+    const TNode& Node = NodeH[N];
+    Node.Id.Save(SOut);
+    TIntV(Node.InDeg > 0 ? Pool.GetValVPt(Node.InSlot) : NULL, Node.InDeg).Save(SOut);
+    TIntV(Node.OutDeg > 0 ? Pool.GetValVPt(Node.OutSlot) : NULL, Node.OutDeg).Save(SOut);
+  }
+}
+
+int TNGraphSlab::AddNode(int NId) {
+  if (NId == -1) {
+    NId = MxNId;  MxNId++;
+  } else {
+    IAssertR(!IsNode(NId), TStr::Fmt("NodeId %d already exists", NId));
+    MxNId = TMath::Mx(NId+1, MxNId());
+  }
+  NodeH.AddDat(NId, TNode(NId));
+  return NId;
+}
+
+int TNGraphSlab::AddNodeUnchecked(int NId) {
+  if (IsNode(NId)) { return NId;}
+  MxNId = TMath::Mx(NId+1, MxNId());
+  NodeH.AddDat(NId, TNode(NId));
+  return NId;
+}
+
+// add a node with a list of neighbors
+// (use TNGraphSlab::IsOk to check whether the graph is consistent)
+int TNGraphSlab::AddNode(const int& NId, const TIntV& InNIdV, const TIntV& OutNIdV) {
+  const int NewNId = AddNode(NId);
+  TNode& Node = GetNode(NewNId);
+  PutNIdV(Node.InSlot, Node.InDeg, InNIdV.BegI(), InNIdV.Len());
+  PutNIdV(Node.OutSlot, Node.OutDeg, OutNIdV.BegI(), OutNIdV.Len());
+  SortUnique(Node.InSlot, Node.InDeg);
+  SortUnique(Node.OutSlot, Node.OutDeg);
+  NEdges += Node.OutDeg;
+  return NewNId;
+}
+
+void TNGraphSlab::DelNode(const int& NId) {
+  TNode& Node = GetNode(NId);
+  for (int e = 0; e < Node.GetOutDeg(); e++) {
+    const int nbr = Pool.GetValVPt(Node.OutSlot)[e];
+    if (nbr == NId) { continue; }
+    TNode& N = GetNode(nbr);
+    DelSorted(N.InSlot, N.InDeg, NId);
+  }
+  for (int e = 0; e < Node.GetInDeg(); e++) {
+    const int nbr = Pool.GetValVPt(Node.InSlot)[e];
+    if (nbr == NId) { continue; }
+    TNode& N = GetNode(nbr);
+    DelSorted(N.OutSlot, N.OutDeg, NId);
+    NEdges--;
+  }
+  NEdges -= Node.OutDeg;
+  Pool.DelSlot(Node.InSlot);
+  Pool.DelSlot(Node.OutSlot);
+  NodeH.DelKey(NId);
+}
+
+int TNGraphSlab::AddEdge(const int& SrcNId, const int& DstNId) {
+  IAssertR(IsNode(SrcNId) && IsNode(DstNId), TStr::Fmt("%d or %d not a node.", SrcNId, DstNId).CStr());
+  if (IsEdge(SrcNId, DstNId)) { return -2; }
+  { TNode& N = GetNode(SrcNId);  AddSorted(N.OutSlot, N.OutDeg, DstNId); }
+  { TNode& N = GetNode(DstNId);  AddSorted(N.InSlot, N.InDeg, SrcNId); }
+  NEdges++;
+  return -1; // no edge id
+}
+
+int TNGraphSlab::AddEdgeUnchecked(const int& SrcNId, const int& DstNId) {
+  { TNode& N = GetNode(SrcNId);  AddUnchecked(N.OutSlot, N.OutDeg, DstNId); }
+  { TNode& N = GetNode(DstNId);  AddUnchecked(N.InSlot, N.InDeg, SrcNId); }
+  NEdges++;
+  return -1; // no edge id
+}
+
+int TNGraphSlab::AddEdge2(const int& SrcNId, const int& DstNId) {
+  if (! IsNode(SrcNId)) { AddNode(SrcNId); }
+  if (! IsNode(DstNId)) { AddNode(DstNId); }
+  return AddEdge(SrcNId, DstNId);
+}
+
+// Add edges from EdgeV[e].Val1 to EdgeV[e].Val2 to the graph. Return the number of new edges.
+// Slots are resized once per node, then the new neighbors are merged in parallel.
+int TNGraphSlab::AddEdgeBatch(const TIntPrV& EdgeV) {
+  TIntV AddOutV(NodeH.GetMxKeyIds()), AddInV(NodeH.GetMxKeyIds());
+  for (int e = 0; e < EdgeV.Len(); e++) {
+    const int SrcKeyId = NodeH.GetKeyId(EdgeV[e].Val1);
+    const int DstKeyId = NodeH.GetKeyId(EdgeV[e].Val2);
+    IAssertR(SrcKeyId != -1 && DstKeyId != -1, TStr::Fmt("%d or %d not a node.", EdgeV[e].Val1(), EdgeV[e].Val2()).CStr());
+    AddOutV[SrcKeyId]++;
+    AddInV[DstKeyId]++;
+  }
+  TIntV KeyIdV, SortedOutV, SortedInV;
+  for (int KeyId = 0; KeyId < AddOutV.Len(); KeyId++) {
+    if (AddOutV[KeyId] == 0 && AddInV[KeyId] == 0) { continue; }
+    TNode& Node = NodeH[KeyId];
+    KeyIdV.Add(KeyId);
+    SortedOutV.Add(Node.OutDeg);
+    SortedInV.Add(Node.InDeg);
+    Node.OutSlot = Pool.Renew(Node.OutSlot, Node.OutDeg, Node.OutDeg + AddOutV[KeyId]);
+    Node.InSlot = Pool.Renew(Node.InSlot, Node.InDeg, Node.InDeg + AddInV[KeyId]);
+  }
+  for (int e = 0; e < EdgeV.Len(); e++) {
+    { TNode& N = GetNode(EdgeV[e].Val1);  Pool.GetValVPt(N.OutSlot)[N.OutDeg] = EdgeV[e].Val2;  N.OutDeg++; }
+    { TNode& N = GetNode(EdgeV[e].Val2);  Pool.GetValVPt(N.InSlot)[N.InDeg] = EdgeV[e].Val1;  N.InDeg++; }
+  }
+  int NewEdges = 0;
+  #pragma omp parallel for schedule(dynamic,1000) reduction(+:NewEdges)
+  for (int k = 0; k < KeyIdV.Len(); k++) {
+    TNode& Node = NodeH[KeyIdV[k]];
+    if (Node.OutDeg > 0) {
+      TIntV OutNIdV(Pool.GetValVPt(Node.OutSlot), Node.OutDeg);
+      NewEdges += TSnapDetail::MergeBatchNIdV(OutNIdV, SortedOutV[k]);
+      Node.OutDeg = OutNIdV.Len();
+    }
+    if (Node.InDeg > 0) {
+      TIntV InNIdV(Pool.GetValVPt(Node.InSlot), Node.InDeg);
+      TSnapDetail::MergeBatchNIdV(InNIdV, SortedInV[k]);
+      Node.InDeg = InNIdV.Len();
+    }
+  }
+  NEdges += NewEdges;
+  return NewEdges;
+}
+
+void TNGraphSlab::DelEdge(const int& SrcNId, const int& DstNId, const bool& IsDir) {
+  IAssertR(IsNode(SrcNId) && IsNode(DstNId), TStr::Fmt("%d or %d not a node.", SrcNId, DstNId).CStr());
+  { TNode& N = GetNode(SrcNId);
+  if (DelSorted(N.OutSlot, N.OutDeg, DstNId)) { NEdges--; } }
+  { TNode& N = GetNode(DstNId);
+  DelSorted(N.InSlot, N.InDeg, SrcNId); }
+  if (! IsDir) {
+    { TNode& N = GetNode(DstNId);
+    if (DelSorted(N.OutSlot, N.OutDeg, SrcNId)) { NEdges--; } }
+    { TNode& N = GetNode(SrcNId);
+    DelSorted(N.InSlot, N.InDeg, DstNId); }
+  }
+}
+
+bool TNGraphSlab::IsEdge(const int& SrcNId, const int& DstNId, const bool& IsDir) const {
+  if (! IsNode(SrcNId) || ! IsNode(DstNId)) { return false; }
+  if (IsDir) { return IsOutNId(GetNode(SrcNId), DstNId); }
+  else { return IsOutNId(GetNode(SrcNId), DstNId) || IsOutNId(GetNode(DstNId), SrcNId); }
+}
+
+TNGraphSlab::TEdgeI TNGraphSlab::GetEI(const int& SrcNId, const int& DstNId) const {
+  const TNodeI SrcNI = GetNI(SrcNId);
+  const TNode& Node = SrcNI.NodeHI.GetDat();
+  const int NodeN = SearchBin(Node.OutSlot, Node.OutDeg, DstNId);
+  IAssert(NodeN != -1);
+  return TEdgeI(SrcNI, EndNI(), NodeN);
+}
+
+void TNGraphSlab::GetNIdV(TIntV& NIdV) const {
+  NIdV.Gen(GetNodes(), 0);
+  for (int N=NodeH.FFirstKeyId(); NodeH.FNextKeyId(N); ) {
+    NIdV.Add(NodeH.GetKey(N)); }
+}
+
+void TNGraphSlab::SortNodeAdjV() {
+  int Edges = 0;
+  #pragma omp parallel for schedule(dynamic,1000) reduction(+:Edges)
+  for (int KeyId = 0; KeyId < NodeH.GetMxKeyIds(); KeyId++) {
+    if (! NodeH.IsKeyId(KeyId)) { continue; }
+    TNode& Node = NodeH[KeyId];
+    SortUnique(Node.InSlot, Node.InDeg);
+    SortUnique(Node.OutSlot, Node.OutDeg);
+    Edges += Node.OutDeg;
+  }
+  NEdges = Edges;
+}
+
+// Copies the adjacency lists into a new pool, in node order and with the smallest
+// size class that holds each list. The old pool is freed afterwards.
+void TNGraphSlab::Defrag(const bool& OnlyNodeLinks) {
+  if (! OnlyNodeLinks && ! NodeH.IsKeyIdEqKeyN()) { NodeH.Defrag(); }
+  TSlabPool<TInt> NewPool;
+  for (int N = NodeH.FFirstKeyId(); NodeH.FNextKeyId(N); ) {
+    TNode& Node = NodeH[N];
+    Node.InSlot = Node.InDeg > 0 ? NewPool.AddV(Pool.GetValVPt(Node.InSlot), Node.InDeg) : -1;
+    Node.OutSlot = Node.OutDeg > 0 ? NewPool.AddV(Pool.GetValVPt(Node.OutSlot), Node.OutDeg) : -1;
+  }
+  Pool.Swap(NewPool);
+}
+
+// for each node check that their neighbors are also nodes
+bool TNGraphSlab::IsOk(const bool& ThrowExcept) const {
+  bool RetVal = true;
+  int Edges = 0;
+  for (int N = NodeH.FFirstKeyId(); NodeH.FNextKeyId(N); ) {
+    const TNode& Node = NodeH[N];
+    const TNodeI NI(NodeH.GetI(Node.GetId()), this);
+    if (Pool.GetCap(Node.OutSlot) < Node.OutDeg || Pool.GetCap(Node.InSlot) < Node.InDeg) {
+      const TStr Msg = TStr::Fmt("Adjacency list of node %d does not fit into its slot.", Node.GetId());
+      if (ThrowExcept) { EAssertR(false, Msg); } else { ErrNotify(Msg.CStr()); } RetVal=false;
+      continue;
+    }
+    // check out-edges
+    for (int e = 0; e < Node.GetOutDeg(); e++) {
+      if (! IsNode(NI.GetOutNId(e))) {
+        const TStr Msg = TStr::Fmt("Out-edge %d --> %d: node %d does not exist.",
+          Node.GetId(), NI.GetOutNId(e), NI.GetOutNId(e));
+        if (ThrowExcept) { EAssertR(false, Msg); } else { ErrNotify(Msg.CStr()); } RetVal=false;
+      }
+      if (e > 0 && NI.GetOutNId(e-1) >= NI.GetOutNId(e)) {
+        const TStr Msg = TStr::Fmt("Out-neighbor list of node %d is not sorted or has duplicate out-edge %d --> %d.",
+          Node.GetId(), Node.GetId(), NI.GetOutNId(e));
+        if (ThrowExcept) { EAssertR(false, Msg); } else { ErrNotify(Msg.CStr()); } RetVal=false;
+      }
+    }
+    // check in-edges
+    for (int e = 0; e < Node.GetInDeg(); e++) {
+      if (! IsNode(NI.GetInNId(e))) {
+        const TStr Msg = TStr::Fmt("In-edge %d <-- %d: node %d does not exist.",
+          Node.GetId(), NI.GetInNId(e), NI.GetInNId(e));
+        if (ThrowExcept) { EAssertR(false, Msg); } else { ErrNotify(Msg.CStr()); } RetVal=false;
+      }
+      if (e > 0 && NI.GetInNId(e-1) >= NI.GetInNId(e)) {
+        const TStr Msg = TStr::Fmt("In-neighbor list of node %d is not sorted or has duplicate in-edge %d <-- %d.",
+          Node.GetId(), Node.GetId(), NI.GetInNId(e));
+        if (ThrowExcept) { EAssertR(false, Msg); } else { ErrNotify(Msg.CStr()); } RetVal=false;
+      }
+    }
+    Edges += Node.GetOutDeg();
+  }
+  if (Edges != NEdges) {
+    const TStr Msg = TStr::Fmt("Number of edges counter is corrupted: GetEdges():%d, EdgeCount:%d.", GetEdges(), Edges);
+    if (ThrowExcept) { EAssertR(false, Msg); } else { ErrNotify(Msg.CStr()); } RetVal=false;
+  }
+  return RetVal;
+}
+
+void TNGraphSlab::Dump(FILE *OutF) const {
+  const int NodePlaces = (int) ceil(log10((double) GetNodes()));
+  fprintf(OutF, "-------------------------------------------------\nDirected Node Graph (slab pool): nodes: %d, edges: %d\n", GetNodes(), GetEdges());
+  for (TNodeI NI = BegNI(); NI < EndNI(); NI++) {
+    fprintf(OutF, "  %*d]\n", NodePlaces, NI.GetId());
+    fprintf(OutF, "    in [%d]", NI.GetInDeg());
+    for (int edge = 0; edge < NI.GetInDeg(); edge++) {
+      fprintf(OutF, " %*d", NodePlaces, NI.GetInNId(edge)); }
+    fprintf(OutF, "\n    out[%d]", NI.GetOutDeg());
+    for (int edge = 0; edge < NI.GetOutDeg(); edge++) {
+      fprintf(OutF, " %*d", NodePlaces, NI.GetOutNId(edge)); }
+    fprintf(OutF, "\n");
+  }
+  fprintf(OutF, "\n");
+}
+
+PNGraphSlab TNGraphSlab::GetSmallGraph() {
+  PNGraphSlab G = TNGraphSlab::New();
+  for (int i = 0; i < 5; i++) { G->AddNode(i); }
+  G->AddEdge(0,1); G->AddEdge(1,2); G->AddEdge(0,2);
+  G->AddEdge(1,3); G->AddEdge(3,4); G->AddEdge(2,3);
+  return G;
+}
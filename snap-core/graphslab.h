@@ -0,0 +1,222 @@
+//#//////////////////////////////////////////////
+/// Directed graphs with adjacency lists in a slab pool
+
+class TNGraphSlab;
+
+/// Pointer to a directed graph with adjacency lists in a slab pool (TNGraphSlab)
+typedef TPt<TNGraphSlab> PNGraphSlab;
+
+//#//////////////////////////////////////////////
+/// Directed graph with adjacency lists in a slab pool. ##TNGraphSlab::Class
+class TNGraphSlab {
+public:
+  typedef TNGraphSlab TNet;
+  typedef TPt<TNGraphSlab> PNet;
+public:
+  class TNode {
+  private:
+    TInt Id, InDeg, OutDeg;
+    TInt64 InSlot, OutSlot;
+  public:
+    TNode() : Id(-1), InDeg(0), OutDeg(0), InSlot(-1), OutSlot(-1) { }
+    TNode(const int& NId) : Id(NId), InDeg(0), OutDeg(0), InSlot(-1), OutSlot(-1) { }
+    int GetId() const { return Id; }
+    int GetDeg() const { return GetInDeg() + GetOutDeg(); }
+    int GetInDeg() const { return InDeg; }
+    int GetOutDeg() const { return OutDeg; }
+    ::TSize GetMemUsed() const { return sizeof(TNode); }
+    friend class TNGraphSlab;
+  };
+  /// Node iterator. Only forward iteration (operator++) is supported.
+  class TNodeI {
+  private:
+    typedef THash<TInt, TNode>::TIter THashIter;
+    THashIter NodeHI;
+    const TNGraphSlab* Graph;
+  public:
+    TNodeI() : NodeHI(), Graph(NULL) { }
+    TNodeI(const THashIter& NodeHIter, const TNGraphSlab* GraphPt) : NodeHI(NodeHIter), Graph(GraphPt) { }
+    TNodeI(const TNodeI& NodeI) : NodeHI(NodeI.NodeHI), Graph(NodeI.Graph) { }
+    TNodeI& operator = (const TNodeI& NodeI) { NodeHI = NodeI.NodeHI; Graph = NodeI.Graph; return *this; }
+    /// Increment iterator.
+    TNodeI& operator++ (int) { NodeHI++; return *this; }
+    /// Decrement iterator.
+    TNodeI& operator-- (int) { NodeHI--; return *this; }
+
+    bool operator < (const TNodeI& NodeI) const { return NodeHI < NodeI.NodeHI; }
+    bool operator == (const TNodeI& NodeI) const { return NodeHI == NodeI.NodeHI; }
+    /// Returns ID of the current node.
+    int GetId() const { return NodeHI.GetDat().GetId(); }
+    /// Returns degree of the current node, the sum of in-degree and out-degree.
+    int GetDeg() const { return NodeHI.GetDat().GetDeg(); }
+    /// Returns in-degree of the current node.
+    int GetInDeg() const { return NodeHI.GetDat().GetInDeg(); }
+    /// Returns out-degree of the current node.
+    int GetOutDeg() const { return NodeHI.GetDat().GetOutDeg(); }
+    /// Returns ID of NodeN-th in-node (the node pointing to the current node).
+    int GetInNId(const int& NodeN) const { return Graph->Pool.GetValVPt(NodeHI.GetDat().InSlot)[NodeN]; }
+    /// Returns ID of NodeN-th out-node (the node the current node points to).
+    int GetOutNId(const int& NodeN) const { return Graph->Pool.GetValVPt(NodeHI.GetDat().OutSlot)[NodeN]; }
+    /// Returns ID of NodeN-th neighboring node.
+    int GetNbrNId(const int& NodeN) const { return NodeN<GetOutDeg()?GetOutNId(NodeN):GetInNId(NodeN-GetOutDeg()); }
+    /// Tests whether node with ID NId points to the current node.
+    bool IsInNId(const int& NId) const { return Graph->IsInNId(NodeHI.GetDat(), NId); }
+    /// Tests whether the current node points to node with ID NId.
+    bool IsOutNId(const int& NId) const { return Graph->IsOutNId(NodeHI.GetDat(), NId); }
+    /// Tests whether node with ID NId is a neighbor of the current node.
+    bool IsNbrNId(const int& NId) const { return IsOutNId(NId) || IsInNId(NId); }
+    friend class TNGraphSlab;
+  };
+  /// Edge iterator. Only forward iteration (operator++) is supported.
+  class TEdgeI {
+  private:
+    TNodeI CurNode, EndNode;
+    int CurEdge;
+  public:
+    TEdgeI() : CurNode(), EndNode(), CurEdge(0) { }
+    TEdgeI(const TNodeI& NodeI, const TNodeI& EndNodeI, const int& EdgeN=0) : CurNode(NodeI), EndNode(EndNodeI), CurEdge(EdgeN) { }
+    TEdgeI(const TEdgeI& EdgeI) : CurNode(EdgeI.CurNode), EndNode(EdgeI.EndNode), CurEdge(EdgeI.CurEdge) { }
+    TEdgeI& operator = (const TEdgeI& EdgeI) { if (this!=&EdgeI) { CurNode=EdgeI.CurNode; EndNode=EdgeI.EndNode; CurEdge=EdgeI.CurEdge; }  return *this; }
+    /// Increment iterator.
+    TEdgeI& operator++ (int) { CurEdge++; if (CurEdge >= CurNode.GetOutDeg()) { CurEdge=0; CurNode++;
+      while (CurNode < EndNode && CurNode.GetOutDeg()==0) { CurNode++; } }  return *this; }
+    bool operator < (const TEdgeI& EdgeI) const { return CurNode<EdgeI.CurNode || (CurNode==EdgeI.CurNode && CurEdge<EdgeI.CurEdge); }
+    bool operator == (const TEdgeI& EdgeI) const { return CurNode == EdgeI.CurNode && CurEdge == EdgeI.CurEdge; }
+    /// Returns edge ID. Always returns -1 since only edges in multigraphs have explicit IDs.
+    int GetId() const { return -1; }
+    /// Returns the source node of the edge.
+    int GetSrcNId() const { return CurNode.GetId(); }
+    /// Returns the destination node of the edge.
+    int GetDstNId() const { return CurNode.GetOutNId(CurEdge); }
+    friend class TNGraphSlab;
+  };
+private:
+  TCRef CRef;
+  TInt MxNId, NEdges;
+  THash<TInt, TNode> NodeH;
+  TSlabPool<TInt> Pool;
+private:
+  TNode& GetNode(const int& NId) { return NodeH.GetDat(NId); }
+  const TNode& GetNode(const int& NId) const { return NodeH.GetDat(NId); }
+  /// Returns the position of NId in the sorted list of Vals node ids in slot Slot, or -1.
+  int SearchBin(const TInt64& Slot, const int& Vals, const int& NId) const;
+  bool IsInNId(const TNode& Node, const int& NId) const { return SearchBin(Node.InSlot, Node.InDeg, NId) != -1; }
+  bool IsOutNId(const TNode& Node, const int& NId) const { return SearchBin(Node.OutSlot, Node.OutDeg, NId) != -1; }
+  /// Inserts NId into the sorted list of Vals node ids in slot Slot.
+  void AddSorted(TInt64& Slot, TInt& Vals, const int& NId);
+  /// Appends NId to the list of Vals node ids in slot Slot.
+  void AddUnchecked(TInt64& Slot, TInt& Vals, const int& NId) {
+    Slot = Pool.Renew(Slot, Vals, Vals+1);  Pool.GetValVPt(Slot)[Vals] = NId;  Vals++; }
+  /// Deletes NId from the sorted list of Vals node ids in slot Slot. Returns true, if NId was found.
+  bool DelSorted(TInt64& Slot, TInt& Vals, const int& NId);
+  /// Sorts the list of Vals node ids in slot Slot and removes duplicates.
+  void SortUnique(const TInt64& Slot, TInt& Vals) const;
+  /// Sets slot Slot to a copy of the Vals node ids at NIdT.
+  void PutNIdV(TInt64& Slot, TInt& Vals, const TInt* NIdT, const int& NIds);
+public:
+  TNGraphSlab() : CRef(), MxNId(0), NEdges(0), NodeH(), Pool() { }
+  /// Constructor that reserves enough memory for a graph of Nodes nodes and Edges edges.
+  explicit TNGraphSlab(const int& Nodes, const int& Edges) : MxNId(0), NEdges(0) { Reserve(Nodes, Edges); }
+  TNGraphSlab(const TNGraphSlab& Graph) : MxNId(Graph.MxNId), NEdges(Graph.NEdges), NodeH(Graph.NodeH), Pool(Graph.Pool) { }
+  /// Constructor that loads the graph from a (binary) stream SIn.
+  TNGraphSlab(TSIn& SIn);
+  /// Saves the graph to a (binary) stream SOut. ##TNGraphSlab::Save
+  void Save(TSOut& SOut) const;
+  /// Static constructor that returns a pointer to the graph. Call: PNGraphSlab Graph = TNGraphSlab::New().
+  static PNGraphSlab New() { return new TNGraphSlab(); }
+  /// Static constructor that returns a pointer to the graph and reserves enough memory for Nodes nodes and Edges edges.
+  static PNGraphSlab New(const int& Nodes, const int& Edges) { return new TNGraphSlab(Nodes, Edges); }
+  /// Static constructor that loads the graph from a stream SIn and returns a pointer to it.
+  static PNGraphSlab Load(TSIn& SIn) { return PNGraphSlab(new TNGraphSlab(SIn)); }
+  /// Allows for run-time checking the type of the graph (see the TGraphFlag for flags).
+  bool HasFlag(const TGraphFlag& Flag) const;
+  TNGraphSlab& operator = (const TNGraphSlab& Graph) {
+    if (this!=&Graph) { MxNId=Graph.MxNId; NEdges=Graph.NEdges; NodeH=Graph.NodeH; Pool=Graph.Pool; }  return *this; }
+
+  /// Returns the number of nodes in the graph.
+  int GetNodes() const { return NodeH.Len(); }
+  /// Adds a node of ID NId to the graph. ##TNGraphSlab::AddNode
+  int AddNode(int NId = -1);
+  /// Adds a node of ID NId to the graph, noop if the node already exists.
+  int AddNodeUnchecked(int NId = -1);
+  /// Adds a node of ID NodeI.GetId() to the graph.
+  int AddNode(const TNodeI& NodeI) { return AddNode(NodeI.GetId()); }
+  /// Adds a node of ID NId to the graph, creates edges to the node from all nodes in vector InNIdV, creates edges from the node to all nodes in vector OutNIdV. ##TNGraphSlab::AddNode-1
+  int AddNode(const int& NId, const TIntV& InNIdV, const TIntV& OutNIdV);
+  /// Deletes node of ID NId from the graph. ##TNGraphSlab::DelNode
+  void DelNode(const int& NId);
+  /// Tests whether ID NId is a node.
+  bool IsNode(const int& NId) const { return NodeH.IsKey(NId); }
+  /// Returns an iterator referring to the first node in the graph.
+  TNodeI BegNI() const { return TNodeI(NodeH.BegI(), this); }
+  /// Returns an iterator referring to the past-the-end node in the graph.
+  TNodeI EndNI() const { return TNodeI(NodeH.EndI(), this); }
+  /// Returns an iterator referring to the node of ID NId in the graph.
+  TNodeI GetNI(const int& NId) const { return TNodeI(NodeH.GetI(NId), this); }
+  /// Returns an ID that is larger than any node ID in the graph.
+  int GetMxNId() const { return MxNId; }
+
+  /// Returns the number of edges in the graph.
+  int GetEdges() const { return NEdges; }
+  /// Adds an edge from node SrcNId to node DstNId to the graph. Returns -2 if the edge already exists.
+  int AddEdge(const int& SrcNId, const int& DstNId);
+  /// Adds an edge between node IDs SrcNId and DstNId to the graph, ignores EId (for compatibility with TNEANet).
+  int AddEdge(const int& SrcNId, const int& DstNId, const int& EId) { return AddEdge(SrcNId, DstNId); }
+  /// Adds an edge from node SrcNId to node DstNId to the graph. ##TNGraphSlab::AddEdgeUnchecked
+  int AddEdgeUnchecked(const int& SrcNId, const int& DstNId);
+  /// Adds an edge from node IDs SrcNId to node DstNId to the graph. If nodes do not exist, create them.
+  int AddEdge2(const int& SrcNId, const int& DstNId);
+  /// Adds edges from node IDs EdgeV[e].Val1 to node IDs EdgeV[e].Val2 to the graph. ##TNGraphSlab::AddEdgeBatch
+  int AddEdgeBatch(const TIntPrV& EdgeV);
+  /// Adds an edge from EdgeI.GetSrcNId() to EdgeI.GetDstNId() to the graph.
+  int AddEdge(const TEdgeI& EdgeI) { return AddEdge(EdgeI.GetSrcNId(), EdgeI.GetDstNId()); }
+  /// Deletes an edge from node IDs SrcNId to DstNId from the graph. If IsDir=false, also deletes the edge from DstNId to SrcNId.
+  void DelEdge(const int& SrcNId, const int& DstNId, const bool& IsDir = true);
+  /// Tests whether an edge from node IDs SrcNId to DstNId exists in the graph.
+  bool IsEdge(const int& SrcNId, const int& DstNId, const bool& IsDir = true) const;
+  /// Tests whether an edge EId exists in the graph (for compatibility with TNEANet), always returns false.
+  bool IsEdge(const int& EId) const { return false; }
+  /// Returns an iterator referring to the first edge in the graph.
+  TEdgeI BegEI() const { TNodeI NI=BegNI(); while(NI<EndNI() && NI.GetOutDeg()==0){NI++;} return TEdgeI(NI, EndNI()); }
+  /// Returns an iterator referring to the past-the-end edge in the graph.
+  TEdgeI EndEI() const { return TEdgeI(EndNI(), EndNI()); }
+  /// Returns an iterator referring to edge (SrcNId, DstNId) in the graph.
+  TEdgeI GetEI(const int& SrcNId, const int& DstNId) const;
+
+  /// Returns an ID of a random node in the graph.
+  int GetRndNId(TRnd& Rnd=TInt::Rnd) { return NodeH.GetKey(NodeH.GetRndKeyId(Rnd, 0.8)); }
+  /// Returns an interator referring to a random node in the graph.
+  TNodeI GetRndNI(TRnd& Rnd=TInt::Rnd) { return GetNI(GetRndNId(Rnd)); }
+  /// Gets a vector IDs of all nodes in the graph.
+  void GetNIdV(TIntV& NIdV) const;
+
+  /// Tests whether the graph is empty (has zero nodes).
+  bool Empty() const { return GetNodes()==0; }
+  /// Deletes all nodes and edges from the graph.
+  void Clr() { MxNId=0; NEdges=0; NodeH.Clr(); Pool.Clr(); }
+  /// Reserves memory for a graph of Nodes nodes and Edges edges.
+  void Reserve(const int& Nodes, const int& Edges) { if (Nodes>0) { NodeH.Gen(Nodes/2); } }
+  /// Reserves memory for node ID NId having InDeg in-edges.
+  void ReserveNIdInDeg(const int& NId, const int& InDeg) { TNode& Node = GetNode(NId); Node.InSlot = Pool.Renew(Node.InSlot, Node.InDeg, InDeg); }
+  /// Reserves memory for node ID NId having OutDeg out-edges.
+  void ReserveNIdOutDeg(const int& NId, const int& OutDeg) { TNode& Node = GetNode(NId); Node.OutSlot = Pool.Renew(Node.OutSlot, Node.OutDeg, OutDeg); }
+  /// Sorts the adjacency lists of each node and removes duplicate edges. ##TNGraphSlab::SortNodeAdjV
+  void SortNodeAdjV();
+  /// Defragments the graph. ##TNGraphSlab::Defrag
+  void Defrag(const bool& OnlyNodeLinks=false);
+  /// Returns the number of bytes used by the graph.
+  ::TSize GetMemUsed() const { return sizeof(TNGraphSlab) + NodeH.GetMemUsed() + Pool.GetMemUsed(); }
+  /// Checks the graph data structure for internal consistency.
+  bool IsOk(const bool& ThrowExcept=true) const;
+  /// Print the graph in a human readable form to an output stream OutF.
+  void Dump(FILE *OutF=stdout) const;
+  /// Returns a small graph on 5 nodes and 6 edges.
+  static PNGraphSlab GetSmallGraph();
+  friend class TPt<TNGraphSlab>;
+};
+
+// set flags
+namespace TSnap {
+template <> struct IsDirected<TNGraphSlab> { enum { Val = 1 }; };
+template <> struct IsEdgeBatch<TNGraphSlab> { enum { Val = 1 }; };
+}
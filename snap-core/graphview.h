@@ -0,0 +1,614 @@
+#ifndef GRAPHVIEW_H
+#define GRAPHVIEW_H
+
+//#//////////////////////////////////////////////
+/// Read-only views of graphs
+
+/// Edge filter of TGraphView that keeps all edges.
+class TAnyEdgeFilter {
+public:
+  bool operator () (const int& SrcNId, const int& DstNId) const { return true; }
+};
+
+template <class PGraph, class TEdgeFilter = TAnyEdgeFilter> class TGraphView;
+template <class PGraph> class TTransView;
+template <class PGraph> class TSymView;
+
+namespace TSnap {
+/// Type of the graph a view is built on (at compile time), the graph itself if it is not a view.
+template <class TGraph> struct TViewBase { typedef TGraph TBase; };
+template <class PGraph, class TEdgeFilter> struct TViewBase<TGraphView<PGraph, TEdgeFilter> > {
+  typedef typename TViewBase<typename PGraph::TObj>::TBase TBase; };
+template <class PGraph, class TEdgeFilter> struct IsDirected<TGraphView<PGraph, TEdgeFilter> > {
+  enum { Val = IsDirected<typename PGraph::TObj::TNet>::Val }; };
+template <class PGraph, class TEdgeFilter> struct IsMultiGraph<TGraphView<PGraph, TEdgeFilter> > {
+  enum { Val = IsMultiGraph<typename PGraph::TObj::TNet>::Val }; };
+template <class PGraph> struct TViewBase<TTransView<PGraph> > {
+  typedef typename TViewBase<typename PGraph::TObj>::TBase TBase; };
+template <class PGraph> struct IsDirected<TTransView<PGraph> > { enum { Val = 1 }; };
+template <class PGraph> struct IsMultiGraph<TTransView<PGraph> > {
+  enum { Val = IsMultiGraph<typename PGraph::TObj::TNet>::Val }; };
+template <class PGraph> struct TViewBase<TSymView<PGraph> > { typedef TUNGraph TBase; };
+}
+
+//#//////////////////////////////////////////////
+/// Subgraph view of a graph, defined by a node bitmap and an edge filter. ##TGraphView::Class
+template <class PGraph, class TEdgeFilter>
+class TGraphView {
+public:
+  typedef TGraphView<PGraph, TEdgeFilter> TNet;
+  typedef TPt<TNet> PNet;
+  typedef typename PGraph::TObj TBaseGraph;
+  typedef typename TBaseGraph::TNodeI TBaseNodeI;
+  enum { IsDir = TSnap::IsDirected<typename TBaseGraph::TNet>::Val };
+public:
+  /// Node iterator. Only forward iteration (operator++) is supported.
+  class TNodeI {
+  private:
+    TBaseNodeI NI, EndNI;
+    const TGraphView* View;
+    // positions of the visible neighbors in the adjacency lists of the base graph, built on first use
+    mutable TIntV OutPosV, InPosV;
+    mutable bool OutInit, InInit;
+  private:
+    void SkipHidden() { while (NI < EndNI && ! View->IsNode(NI.GetId())) { NI++; } }
+    const TIntV& GetOutPosV() const;
+    const TIntV& GetInPosV() const;
+  public:
+    TNodeI() : NI(), EndNI(), View(NULL), OutPosV(), InPosV(), OutInit(false), InInit(false) { }
+    TNodeI(const TBaseNodeI& NodeI, const TBaseNodeI& EndNodeI, const TGraphView* ViewPt) :
+      NI(NodeI), EndNI(EndNodeI), View(ViewPt), OutPosV(), InPosV(), OutInit(false), InInit(false) { SkipHidden(); }
+    TNodeI(const TNodeI& NodeI) : NI(NodeI.NI), EndNI(NodeI.EndNI), View(NodeI.View), OutPosV(NodeI.OutPosV),
+      InPosV(NodeI.InPosV), OutInit(NodeI.OutInit), InInit(NodeI.InInit) { }
+    TNodeI& operator = (const TNodeI& NodeI) { NI = NodeI.NI; EndNI = NodeI.EndNI; View = NodeI.View; OutPosV = NodeI.OutPosV;
+      InPosV = NodeI.InPosV; OutInit = NodeI.OutInit; InInit = NodeI.InInit; return *this; }
+    /// Increment iterator.
+    TNodeI& operator++ (int) { NI++; SkipHidden(); OutInit = false; InInit = false; return *this; }
+    bool operator < (const TNodeI& NodeI) const { return NI < NodeI.NI; }
+    bool operator == (const TNodeI& NodeI) const { return NI == NodeI.NI; }
+    /// Returns ID of the current node.
+    int GetId() const { return NI.GetId(); }
+    /// Returns degree of the current node, the sum of in-degree and out-degree for directed graphs.
+    int GetDeg() const { return IsDir ? GetInDeg() + GetOutDeg() : GetOutDeg(); }
+    /// Returns in-degree of the current node.
+    int GetInDeg() const { return GetInPosV().Len(); }
+    /// Returns out-degree of the current node.
+    int GetOutDeg() const { return GetOutPosV().Len(); }
+    /// Returns ID of NodeN-th in-node (the node pointing to the current node).
+    int GetInNId(const int& NodeN) const { return NI.GetInNId(GetInPosV()[NodeN]); }
+    /// Returns ID of NodeN-th out-node (the node the current node points to).
+    int GetOutNId(const int& NodeN) const { return NI.GetOutNId(GetOutPosV()[NodeN]); }
+    /// Returns ID of NodeN-th neighboring node, out-nodes come before in-nodes for directed graphs.
+    int GetNbrNId(const int& NodeN) const {
+      if (! IsDir) { return GetOutNId(NodeN); }
+      return NodeN < GetOutDeg() ? GetOutNId(NodeN) : GetInNId(NodeN - GetOutDeg()); }
+    /// Tests whether node with ID NId points to the current node.
+    bool IsInNId(const int& NId) const { return View->IsNode(NId) && View->IsViewEdge(NId, GetId()) && NI.IsInNId(NId); }
+    /// Tests whether the current node points to node with ID NId.
+    bool IsOutNId(const int& NId) const { return View->IsNode(NId) && View->IsViewEdge(GetId(), NId) && NI.IsOutNId(NId); }
+    /// Tests whether node with ID NId is a neighbor of the current node.
+    bool IsNbrNId(const int& NId) const { return IsOutNId(NId) || IsInNId(NId); }
+    friend class TGraphView;
+  };
+  /// Edge iterator. Only forward iteration (operator++) is supported.
+  class TEdgeI {
+  private:
+    TNodeI CurNode, EndNode;
+    int CurEdge;
+  private:
+    // moves to the next visible edge, undirected edges are returned once, from the node with the smaller ID
+    void SkipEdges() {
+      while (CurNode < EndNode) {
+        for ( ; CurEdge < CurNode.GetOutDeg(); CurEdge++) {
+          if (IsDir || CurNode.GetId() <= CurNode.GetOutNId(CurEdge)) { return; }
+        }
+        CurNode++;  CurEdge = 0;
+      }
+    }
+  public:
+    TEdgeI() : CurNode(), EndNode(), CurEdge(0) { }
+    TEdgeI(const TNodeI& NodeI, const TNodeI& EndNodeI, const int& EdgeN=0) : CurNode(NodeI), EndNode(EndNodeI), CurEdge(EdgeN) { SkipEdges(); }
+    TEdgeI(const TEdgeI& EdgeI) : CurNode(EdgeI.CurNode), EndNode(EdgeI.EndNode), CurEdge(EdgeI.CurEdge) { }
+    TEdgeI& operator = (const TEdgeI& EdgeI) { if (this!=&EdgeI) { CurNode=EdgeI.CurNode; EndNode=EdgeI.EndNode; CurEdge=EdgeI.CurEdge; } return *this; }
+    /// Increment iterator.
+    TEdgeI& operator++ (int) { CurEdge++; SkipEdges(); return *this; }
+    bool operator < (const TEdgeI& EdgeI) const { return CurNode<EdgeI.CurNode || (CurNode==EdgeI.CurNode && CurEdge<EdgeI.CurEdge); }
+    bool operator == (const TEdgeI& EdgeI) const { return CurNode == EdgeI.CurNode && CurEdge == EdgeI.CurEdge; }
+    /// Returns edge ID. Always returns -1 since views do not expose edge IDs.
+    int GetId() const { return -1; }
+    /// Returns the source node of the edge.
+    int GetSrcNId() const { return CurNode.GetId(); }
+    /// Returns the destination node of the edge.
+    int GetDstNId() const { return CurNode.GetOutNId(CurEdge); }
+    friend class TGraphView;
+  };
+private:
+  TCRef CRef;
+  PGraph Graph;
+  TUInt64V NodeBitV;
+  TInt Nodes;
+  mutable TInt Edges;
+  TEdgeFilter EdgeFilter;
+private:
+  void SetBit(const int& NId, const bool& Val);
+public:
+  /// Constructs a view of all nodes of Graph.
+  TGraphView(const PGraph& BaseGraph, const TEdgeFilter& Filter=TEdgeFilter());
+  /// Constructs a view of the subgraph of Graph induced by the nodes in NIdV.
+  TGraphView(const PGraph& BaseGraph, const TIntV& NIdV, const TEdgeFilter& Filter=TEdgeFilter());
+  /// Static constructor that returns a pointer to a view of all nodes of Graph.
+  static PNet New(const PGraph& BaseGraph, const TEdgeFilter& Filter=TEdgeFilter()) { return new TGraphView(BaseGraph, Filter); }
+  /// Static constructor that returns a pointer to a view of the subgraph of Graph induced by the nodes in NIdV.
+  static PNet New(const PGraph& BaseGraph, const TIntV& NIdV, const TEdgeFilter& Filter=TEdgeFilter()) { return new TGraphView(BaseGraph, NIdV, Filter); }
+
+  /// Returns the graph the view is built on.
+  const PGraph& GetBaseGraph() const { return Graph; }
+  /// Returns the edge filter of the view.
+  const TEdgeFilter& GetEdgeFilter() const { return EdgeFilter; }
+  /// Allows for run-time checking the type of the graph (see the TGraphFlag for flags).
+  bool HasFlag(const TGraphFlag& Flag) const { return HasGraphFlag(typename TGraphView::TNet, Flag); }
+
+  /// Returns the number of nodes in the view.
+  int GetNodes() const { return Nodes; }
+  /// Adds node NId of the base graph to the view.
+  void ShowNode(const int& NId);
+  /// Removes node NId from the view. The base graph is not changed.
+  void HideNode(const int& NId);
+  /// Tests whether ID NId is a node of the view.
+  bool IsNode(const int& NId) const {
+    return NId >= 0 && (NId >> 6) < NodeBitV.Len() && ((NodeBitV[NId >> 6].Val >> (NId & 63)) & 1) != 0; }
+  /// Returns an ID that is larger than any node ID in the view.
+  int GetMxNId() const { return Graph->GetMxNId(); }
+  /// Returns an iterator referring to the first node in the view.
+  TNodeI BegNI() const { return TNodeI(Graph->BegNI(), Graph->EndNI(), this); }
+  /// Returns an iterator referring to the past-the-end node in the view.
+  TNodeI EndNI() const { return TNodeI(Graph->EndNI(), Graph->EndNI(), this); }
+  /// Returns an iterator referring to the node of ID NId in the view.
+  TNodeI GetNI(const int& NId) const { return TNodeI(Graph->GetNI(NId), Graph->EndNI(), this); }
+
+  /// Returns the number of edges in the view. ##TGraphView::GetEdges
+  int GetEdges() const;
+  /// Tests whether the edge SrcNId->DstNId is visible in the view, the filter decides between the two
+  /// nodes of the view whether their edge is shown.
+  bool IsViewEdge(const int& SrcNId, const int& DstNId) const {
+    return IsDir || SrcNId <= DstNId ? EdgeFilter(SrcNId, DstNId) : EdgeFilter(DstNId, SrcNId); }
+  /// Tests whether an edge from node IDs SrcNId to DstNId exists in the view.
+  bool IsEdge(const int& SrcNId, const int& DstNId, const bool& IsDirected = true) const;
+  /// Returns an iterator referring to the first edge in the view.
+  TEdgeI BegEI() const { return TEdgeI(BegNI(), EndNI()); }
+  /// Returns an iterator referring to the past-the-end edge in the view.
+  TEdgeI EndEI() const { return TEdgeI(EndNI(), EndNI()); }
+
+  /// Returns an ID of a random node in the view.
+  int GetRndNId(TRnd& Rnd=TInt::Rnd);
+  /// Returns an interator referring to a random node in the view.
+  TNodeI GetRndNI(TRnd& Rnd=TInt::Rnd) { return GetNI(GetRndNId(Rnd)); }
+  /// Gets a vector IDs of all nodes in the view.
+  void GetNIdV(TIntV& NIdV) const;
+  /// Tests whether the view is empty (has zero nodes).
+  bool Empty() const { return GetNodes()==0; }
+
+  /// Returns a new graph of the type of the base graph with the nodes and edges of the view. ##TGraphView::GetSubGraph
+  TPt<typename TSnap::TViewBase<TBaseGraph>::TBase> GetSubGraph() const;
+
+  friend class TPt<TGraphView>;
+};
+
+template <class PGraph, class TEdgeFilter>
+const TIntV& TGraphView<PGraph, TEdgeFilter>::TNodeI::GetOutPosV() const {
+  if (! OutInit) {
+    const int Id = NI.GetId();
+    OutPosV.Gen(NI.GetOutDeg(), 0);
+    for (int e = 0; e < NI.GetOutDeg(); e++) {
+      const int NbrId = NI.GetOutNId(e);
+      if (View->IsNode(NbrId) && View->IsViewEdge(Id, NbrId)) { OutPosV.Add(e); }
+    }
+    OutInit = true;
+  }
+  return OutPosV;
+}
+
+template <class PGraph, class TEdgeFilter>
+const TIntV& TGraphView<PGraph, TEdgeFilter>::TNodeI::GetInPosV() const {
+  if (! IsDir) { return GetOutPosV(); }
+  if (! InInit) {
+    const int Id = NI.GetId();
+    InPosV.Gen(NI.GetInDeg(), 0);
+    for (int e = 0; e < NI.GetInDeg(); e++) {
+      const int NbrId = NI.GetInNId(e);
+      if (View->IsNode(NbrId) && View->IsViewEdge(NbrId, Id)) { InPosV.Add(e); }
+    }
+    InInit = true;
+  }
+  return InPosV;
+}
+
+template <class PGraph, class TEdgeFilter>
+TGraphView<PGraph, TEdgeFilter>::TGraphView(const PGraph& BaseGraph, const TEdgeFilter& Filter) :
+  CRef(), Graph(BaseGraph), NodeBitV((BaseGraph->GetMxNId() + 63) / 64), Nodes(0), Edges(-1), EdgeFilter(Filter) {
+  NodeBitV.PutAll(0);
+  for (typename TBaseGraph::TNodeI NI = Graph->BegNI(); NI < Graph->EndNI(); NI++) {
+    SetBit(NI.GetId(), true);
+  }
+  Nodes = Graph->GetNodes();
+}
+
+template <class PGraph, class TEdgeFilter>
+TGraphView<PGraph, TEdgeFilter>::TGraphView(const PGraph& BaseGraph, const TIntV& NIdV, const TEdgeFilter& Filter) :
+  CRef(), Graph(BaseGraph), NodeBitV((BaseGraph->GetMxNId() + 63) / 64), Nodes(0), Edges(-1), EdgeFilter(Filter) {
+  NodeBitV.PutAll(0);
+  for (int n = 0; n < NIdV.Len(); n++) {
+    ShowNode(NIdV[n]);
+  }
+}
+
+template <class PGraph, class TEdgeFilter>
+void TGraphView<PGraph, TEdgeFilter>::SetBit(const int& NId, const bool& Val) {
+  if (Val) { NodeBitV[NId >> 6].Val |= uint64(1) << (NId & 63); }
+  else { NodeBitV[NId >> 6].Val &= ~(uint64(1) << (NId & 63)); }
+}
+
+template <class PGraph, class TEdgeFilter>
+void TGraphView<PGraph, TEdgeFilter>::ShowNode(const int& NId) {
+  if (IsNode(NId) || ! Graph->IsNode(NId)) { return; }
+  while (NodeBitV.Len() <= (NId >> 6)) { NodeBitV.Add(0); }
+  SetBit(NId, true);
+  Nodes++;  Edges = -1;
+}
+
+template <class PGraph, class TEdgeFilter>
+void TGraphView<PGraph, TEdgeFilter>::HideNode(const int& NId) {
+  if (! IsNode(NId)) { return; }
+  SetBit(NId, false);
+  Nodes--;  Edges = -1;
+}
+
+template <class PGraph, class TEdgeFilter>
+int TGraphView<PGraph, TEdgeFilter>::GetEdges() const {
+  if (Edges == -1) {
+    int EdgeCnt = 0;
+    for (TNodeI NI = BegNI(); NI < EndNI(); NI++) {
+      if (IsDir) { EdgeCnt += NI.GetOutDeg(); continue; }
+      for (int e = 0; e < NI.GetOutDeg(); e++) {
+        if (NI.GetId() <= NI.GetOutNId(e)) { EdgeCnt++; }
+      }
+    }
+    Edges = EdgeCnt;
+  }
+  return Edges;
+}
+
+template <class PGraph, class TEdgeFilter>
+bool TGraphView<PGraph, TEdgeFilter>::IsEdge(const int& SrcNId, const int& DstNId, const bool& IsDirected) const {
+  if (! IsNode(SrcNId) || ! IsNode(DstNId)) { return false; }
+  if (IsViewEdge(SrcNId, DstNId) && Graph->IsEdge(SrcNId, DstNId)) { return true; }
+  return ! IsDirected && IsViewEdge(DstNId, SrcNId) && Graph->IsEdge(DstNId, SrcNId);
+}
+
+template <class PGraph, class TEdgeFilter>
+int TGraphView<PGraph, TEdgeFilter>::GetRndNId(TRnd& Rnd) {
+  IAssert(Nodes > 0);
+  // rejection sampling works well unless the view is a small part of the graph
+  for (int TryN = 0; TryN < 32; TryN++) {
+    const int NId = Graph->GetRndNId(Rnd);
+    if (IsNode(NId)) { return NId; }
+  }
+  TIntV NIdV;
+  GetNIdV(NIdV);
+  return NIdV[Rnd.GetUniDevInt(NIdV.Len())];
+}
+
+template <class PGraph, class TEdgeFilter>
+void TGraphView<PGraph, TEdgeFilter>::GetNIdV(TIntV& NIdV) const {
+  NIdV.Gen(GetNodes(), 0);
+  for (TNodeI NI = BegNI(); NI < EndNI(); NI++) {
+    NIdV.Add(NI.GetId());
+  }
+}
+
+template <class PGraph, class TEdgeFilter>
+TPt<typename TSnap::TViewBase<typename PGraph::TObj>::TBase> TGraphView<PGraph, TEdgeFilter>::GetSubGraph() const {
+  typedef typename TSnap::TViewBase<TBaseGraph>::TBase TGraph;
+  TPt<TGraph> NewGraph = TGraph::New();
+  NewGraph->Reserve(GetNodes(), GetEdges());
+  for (TNodeI NI = BegNI(); NI < EndNI(); NI++) {
+    NewGraph->AddNode(NI.GetId());
+  }
+  for (TEdgeI EI = BegEI(); EI < EndEI(); EI++) {
+    NewGraph->AddEdge(EI.GetSrcNId(), EI.GetDstNId());
+  }
+  return NewGraph;
+}
+
+//#//////////////////////////////////////////////
+/// Directed graph with the direction of all edges of a directed graph reversed, the graph is not copied. ##TTransView::Class
+template <class PGraph>
+class TTransView {
+public:
+  typedef TTransView<PGraph> TNet;
+  typedef TPt<TNet> PNet;
+  typedef typename PGraph::TObj TBaseGraph;
+  typedef typename TBaseGraph::TNodeI TBaseNodeI;
+  typedef typename TBaseGraph::TEdgeI TBaseEdgeI;
+public:
+  /// Node iterator. Only forward iteration (operator++) is supported.
+  class TNodeI {
+  private:
+    TBaseNodeI NI;
+  public:
+    TNodeI() : NI() { }
+    TNodeI(const TBaseNodeI& NodeI) : NI(NodeI) { }
+    TNodeI(const TNodeI& NodeI) : NI(NodeI.NI) { }
+    TNodeI& operator = (const TNodeI& NodeI) { NI = NodeI.NI; return *this; }
+    /// Increment iterator.
+    TNodeI& operator++ (int) { NI++; return *this; }
+    bool operator < (const TNodeI& NodeI) const { return NI < NodeI.NI; }
+    bool operator == (const TNodeI& NodeI) const { return NI == NodeI.NI; }
+    /// Returns ID of the current node.
+    int GetId() const { return NI.GetId(); }
+    /// Returns degree of the current node, the sum of in-degree and out-degree.
+    int GetDeg() const { return NI.GetDeg(); }
+    /// Returns in-degree of the current node (out-degree in the base graph).
+    int GetInDeg() const { return NI.GetOutDeg(); }
+    /// Returns out-degree of the current node (in-degree in the base graph).
+    int GetOutDeg() const { return NI.GetInDeg(); }
+    /// Returns ID of NodeN-th in-node (the node pointing to the current node).
+    int GetInNId(const int& NodeN) const { return NI.GetOutNId(NodeN); }
+    /// Returns ID of NodeN-th out-node (the node the current node points to).
+    int GetOutNId(const int& NodeN) const { return NI.GetInNId(NodeN); }
+    /// Returns ID of NodeN-th neighboring node, out-nodes come before in-nodes.
+    int GetNbrNId(const int& NodeN) const { return NodeN < GetOutDeg() ? GetOutNId(NodeN) : GetInNId(NodeN - GetOutDeg()); }
+    /// Tests whether node with ID NId points to the current node.
+    bool IsInNId(const int& NId) const { return NI.IsOutNId(NId); }
+    /// Tests whether the current node points to node with ID NId.
+    bool IsOutNId(const int& NId) const { return NI.IsInNId(NId); }
+    /// Tests whether node with ID NId is a neighbor of the current node.
+    bool IsNbrNId(const int& NId) const { return NI.IsOutNId(NId) || NI.IsInNId(NId); }
+    friend class TTransView;
+  };
+  /// Edge iterator. Only forward iteration (operator++) is supported.
+  class TEdgeI {
+  private:
+    TBaseEdgeI EI;
+  public:
+    TEdgeI() : EI() { }
+    TEdgeI(const TBaseEdgeI& EdgeI) : EI(EdgeI) { }
+    TEdgeI(const TEdgeI& EdgeI) : EI(EdgeI.EI) { }
+    TEdgeI& operator = (const TEdgeI& EdgeI) { EI = EdgeI.EI; return *this; }
+    /// Increment iterator.
+    TEdgeI& operator++ (int) { EI++; return *this; }
+    bool operator < (const TEdgeI& EdgeI) const { return EI < EdgeI.EI; }
+    bool operator == (const TEdgeI& EdgeI) const { return EI == EdgeI.EI; }
+    /// Returns edge ID of the edge in the base graph.
+    int GetId() const { return EI.GetId(); }
+    /// Returns the source node of the edge (the destination node in the base graph).
+    int GetSrcNId() const { return EI.GetDstNId(); }
+    /// Returns the destination node of the edge (the source node in the base graph).
+    int GetDstNId() const { return EI.GetSrcNId(); }
+    friend class TTransView;
+  };
+private:
+  TCRef CRef;
+  PGraph Graph;
+public:
+  /// Constructs a view of the directed graph BaseGraph with all edges reversed.
+  TTransView(const PGraph& BaseGraph) : CRef(), Graph(BaseGraph) {
+    CAssert(TSnap::IsDirected<typename TBaseGraph::TNet>::Val); }
+  /// Static constructor that returns a pointer to a view of BaseGraph with all edges reversed.
+  static PNet New(const PGraph& BaseGraph) { return new TTransView(BaseGraph); }
+
+  /// Returns the graph the view is built on.
+  const PGraph& GetBaseGraph() const { return Graph; }
+  /// Allows for run-time checking the type of the graph (see the TGraphFlag for flags).
+  bool HasFlag(const TGraphFlag& Flag) const { return HasGraphFlag(typename TTransView::TNet, Flag); }
+
+  /// Returns the number of nodes in the view.
+  int GetNodes() const { return Graph->GetNodes(); }
+  /// Tests whether ID NId is a node of the view.
+  bool IsNode(const int& NId) const { return Graph->IsNode(NId); }
+  /// Returns an ID that is larger than any node ID in the view.
+  int GetMxNId() const { return Graph->GetMxNId(); }
+  /// Returns an iterator referring to the first node in the view.
+  TNodeI BegNI() const { return TNodeI(Graph->BegNI()); }
+  /// Returns an iterator referring to the past-the-end node in the view.
+  TNodeI EndNI() const { return TNodeI(Graph->EndNI()); }
+  /// Returns an iterator referring to the node of ID NId in the view.
+  TNodeI GetNI(const int& NId) const { return TNodeI(Graph->GetNI(NId)); }
+
+  /// Returns the number of edges in the view.
+  int GetEdges() const { return Graph->GetEdges(); }
+  /// Tests whether an edge from node IDs SrcNId to DstNId exists in the view.
+  bool IsEdge(const int& SrcNId, const int& DstNId, const bool& IsDir = true) const {
+    return Graph->IsEdge(DstNId, SrcNId) || (! IsDir && Graph->IsEdge(SrcNId, DstNId)); }
+  /// Returns an iterator referring to the first edge in the view.
+  TEdgeI BegEI() const { return TEdgeI(Graph->BegEI()); }
+  /// Returns an iterator referring to the past-the-end edge in the view.
+  TEdgeI EndEI() const { return TEdgeI(Graph->EndEI()); }
+
+  /// Returns an ID of a random node in the view.
+  int GetRndNId(TRnd& Rnd=TInt::Rnd) { return Graph->GetRndNId(Rnd); }
+  /// Returns an interator referring to a random node in the view.
+  TNodeI GetRndNI(TRnd& Rnd=TInt::Rnd) { return GetNI(GetRndNId(Rnd)); }
+  /// Gets a vector IDs of all nodes in the view.
+  void GetNIdV(TIntV& NIdV) const { Graph->GetNIdV(NIdV); }
+  /// Tests whether the view is empty (has zero nodes).
+  bool Empty() const { return GetNodes()==0; }
+
+  friend class TPt<TTransView>;
+};
+
+//#//////////////////////////////////////////////
+/// Undirected graph with the edges of a directed graph, the graph is not copied. ##TSymView::Class
+template <class PGraph>
+class TSymView {
+public:
+  typedef TSymView<PGraph> TNet;
+  typedef TPt<TNet> PNet;
+  typedef typename PGraph::TObj TBaseGraph;
+  typedef typename TBaseGraph::TNodeI TBaseNodeI;
+public:
+  /// Node iterator. Only forward iteration (operator++) is supported.
+  class TNodeI {
+  private:
+    TBaseNodeI NI;
+    // sorted in- and out-neighbors of the current node without duplicates, built on first use
+    mutable TIntV NbrV;
+    mutable bool NbrInit;
+  private:
+    const TIntV& GetNbrV() const;
+  public:
+    TNodeI() : NI(), NbrV(), NbrInit(false) { }
+    TNodeI(const TBaseNodeI& NodeI) : NI(NodeI), NbrV(), NbrInit(false) { }
+    TNodeI(const TNodeI& NodeI) : NI(NodeI.NI), NbrV(NodeI.NbrV), NbrInit(NodeI.NbrInit) { }
+    TNodeI& operator = (const TNodeI& NodeI) { NI = NodeI.NI; NbrV = NodeI.NbrV; NbrInit = NodeI.NbrInit; return *this; }
+    /// Increment iterator.
+    TNodeI& operator++ (int) { NI++; NbrInit = false; return *this; }
+    bool operator < (const TNodeI& NodeI) const { return NI < NodeI.NI; }
+    bool operator == (const TNodeI& NodeI) const { return NI == NodeI.NI; }
+    /// Returns ID of the current node.
+    int GetId() const { return NI.GetId(); }
+    /// Returns degree of the current node, the number of distinct in- and out-neighbors in the base graph.
+    int GetDeg() const { return GetNbrV().Len(); }
+    /// Returns degree of the current node. Since the view is undirected, the function returns GetDeg().
+    int GetInDeg() const { return GetDeg(); }
+    /// Returns degree of the current node. Since the view is undirected, the function returns GetDeg().
+    int GetOutDeg() const { return GetDeg(); }
+    /// Returns ID of NodeN-th neighboring node. Since the view is undirected, the function returns GetNbrNId().
+    int GetInNId(const int& NodeN) const { return GetNbrV()[NodeN]; }
+    /// Returns ID of NodeN-th neighboring node. Since the view is undirected, the function returns GetNbrNId().
+    int GetOutNId(const int& NodeN) const { return GetNbrV()[NodeN]; }
+    /// Returns ID of NodeN-th neighboring node, neighbors are sorted by ID.
+    int GetNbrNId(const int& NodeN) const { return GetNbrV()[NodeN]; }
+    /// Tests whether node with ID NId is a neighbor of the current node.
+    bool IsInNId(const int& NId) const { return IsNbrNId(NId); }
+    /// Tests whether node with ID NId is a neighbor of the current node.
+    bool IsOutNId(const int& NId) const { return IsNbrNId(NId); }
+    /// Tests whether node with ID NId is a neighbor of the current node.
+    bool IsNbrNId(const int& NId) const { return NI.IsOutNId(NId) || NI.IsInNId(NId); }
+    friend class TSymView;
+  };
+  /// Edge iterator. Only forward iteration (operator++) is supported.
+  class TEdgeI {
+  private:
+    TNodeI CurNode, EndNode;
+    int CurEdge;
+  private:
+    // moves to the next edge, every edge is returned once, from the node with the smaller ID
+    void SkipEdges() {
+      while (CurNode < EndNode) {
+        for ( ; CurEdge < CurNode.GetOutDeg(); CurEdge++) {
+          if (CurNode.GetId() <= CurNode.GetOutNId(CurEdge)) { return; }
+        }
+        CurNode++;  CurEdge = 0;
+      }
+    }
+  public:
+    TEdgeI() : CurNode(), EndNode(), CurEdge(0) { }
+    TEdgeI(const TNodeI& NodeI, const TNodeI& EndNodeI, const int& EdgeN=0) : CurNode(NodeI), EndNode(EndNodeI), CurEdge(EdgeN) { SkipEdges(); }
+    TEdgeI(const TEdgeI& EdgeI) : CurNode(EdgeI.CurNode), EndNode(EdgeI.EndNode), CurEdge(EdgeI.CurEdge) { }
+    TEdgeI& operator = (const TEdgeI& EdgeI) { if (this!=&EdgeI) { CurNode=EdgeI.CurNode; EndNode=EdgeI.EndNode; CurEdge=EdgeI.CurEdge; } return *this; }
+    /// Increment iterator.
+    TEdgeI& operator++ (int) { CurEdge++; SkipEdges(); return *this; }
+    bool operator < (const TEdgeI& EdgeI) const { return CurNode<EdgeI.CurNode || (CurNode==EdgeI.CurNode && CurEdge<EdgeI.CurEdge); }
+    bool operator == (const TEdgeI& EdgeI) const { return CurNode == EdgeI.CurNode && CurEdge == EdgeI.CurEdge; }
+    /// Returns edge ID. Always returns -1 since views do not expose edge IDs.
+    int GetId() const { return -1; }
+    /// Returns the source node of the edge, the node with the smaller ID.
+    int GetSrcNId() const { return CurNode.GetId(); }
+    /// Returns the destination node of the edge, the node with the larger ID.
+    int GetDstNId() const { return CurNode.GetOutNId(CurEdge); }
+    friend class TSymView;
+  };
+private:
+  TCRef CRef;
+  PGraph Graph;
+  mutable TInt Edges;
+public:
+  /// Constructs an undirected view of the directed graph BaseGraph.
+  TSymView(const PGraph& BaseGraph) : CRef(), Graph(BaseGraph), Edges(-1) {
+    CAssert(TSnap::IsDirected<typename TBaseGraph::TNet>::Val); }
+  /// Static constructor that returns a pointer to an undirected view of BaseGraph.
+  static PNet New(const PGraph& BaseGraph) { return new TSymView(BaseGraph); }
+
+  /// Returns the graph the view is built on.
+  const PGraph& GetBaseGraph() const { return Graph; }
+  /// Allows for run-time checking the type of the graph (see the TGraphFlag for flags).
+  bool HasFlag(const TGraphFlag& Flag) const { return HasGraphFlag(typename TSymView::TNet, Flag); }
+
+  /// Returns the number of nodes in the view.
+  int GetNodes() const { return Graph->GetNodes(); }
+  /// Tests whether ID NId is a node of the view.
+  bool IsNode(const int& NId) const { return Graph->IsNode(NId); }
+  /// Returns an ID that is larger than any node ID in the view.
+  int GetMxNId() const { return Graph->GetMxNId(); }
+  /// Returns an iterator referring to the first node in the view.
+  TNodeI BegNI() const { return TNodeI(Graph->BegNI()); }
+  /// Returns an iterator referring to the past-the-end node in the view.
+  TNodeI EndNI() const { return TNodeI(Graph->EndNI()); }
+  /// Returns an iterator referring to the node of ID NId in the view.
+  TNodeI GetNI(const int& NId) const { return TNodeI(Graph->GetNI(NId)); }
+
+  /// Returns the number of edges in the view. ##TSymView::GetEdges
+  int GetEdges() const;
+  /// Tests whether an edge between node IDs SrcNId and DstNId exists in the view.
+  bool IsEdge(const int& SrcNId, const int& DstNId, const bool& IsDir = true) const {
+    return Graph->IsEdge(SrcNId, DstNId) || Graph->IsEdge(DstNId, SrcNId); }
+  /// Returns an iterator referring to the first edge in the view.
+  TEdgeI BegEI() const { return TEdgeI(BegNI(), EndNI()); }
+  /// Returns an iterator referring to the past-the-end edge in the view.
+  TEdgeI EndEI() const { return TEdgeI(EndNI(), EndNI()); }
+
+  /// Returns an ID of a random node in the view.
+  int GetRndNId(TRnd& Rnd=TInt::Rnd) { return Graph->GetRndNId(Rnd); }
+  /// Returns an interator referring to a random node in the view.
+  TNodeI GetRndNI(TRnd& Rnd=TInt::Rnd) { return GetNI(GetRndNId(Rnd)); }
+  /// Gets a vector IDs of all nodes in the view.
+  void GetNIdV(TIntV& NIdV) const { Graph->GetNIdV(NIdV); }
+  /// Tests whether the view is empty (has zero nodes).
+  bool Empty() const { return GetNodes()==0; }
+
+  friend class TPt<TSymView>;
+};
+
+template <class PGraph>
+const TIntV& TSymView<PGraph>::TNodeI::GetNbrV() const {
+  if (! NbrInit && HasGraphFlag(typename TBaseGraph, gfMultiGraph)) {
+    // neighbor lists of multigraphs are neither sorted nor unique
+    const int InDeg = NI.GetInDeg(), OutDeg = NI.GetOutDeg();
+    NbrV.Gen(InDeg + OutDeg, 0);
+    for (int i = 0; i < InDeg; i++) { NbrV.Add(NI.GetInNId(i)); }
+    for (int o = 0; o < OutDeg; o++) { NbrV.Add(NI.GetOutNId(o)); }
+    NbrV.Merge();
+    NbrInit = true;
+  }
+  if (! NbrInit) {
+    // merges the sorted in- and out-neighbor lists of the base graph
+    const int InDeg = NI.GetInDeg(), OutDeg = NI.GetOutDeg();
+    NbrV.Gen(InDeg + OutDeg, 0);
+    int i = 0, o = 0;
+    while (i < InDeg || o < OutDeg) {
+      int NbrId;
+      if (o == OutDeg || (i < InDeg && NI.GetInNId(i) <= NI.GetOutNId(o))) { NbrId = NI.GetInNId(i);  i++; }
+      else { NbrId = NI.GetOutNId(o);  o++; }
+      if (NbrV.Empty() || NbrV.Last() != NbrId) { NbrV.Add(NbrId); }
+    }
+    NbrInit = true;
+  }
+  return NbrV;
+}
+
+template <class PGraph>
+int TSymView<PGraph>::GetEdges() const {
+  if (Edges == -1) {
+    int EdgeCnt = 0;
+    for (TNodeI NI = BegNI(); NI < EndNI(); NI++) {
+      for (int e = 0; e < NI.GetOutDeg(); e++) {
+        if (NI.GetId() <= NI.GetOutNId(e)) { EdgeCnt++; }
+      }
+    }
+    Edges = EdgeCnt;
+  }
+  return Edges;
+}
+
+#endif // GRAPHVIEW_H
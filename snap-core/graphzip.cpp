@@ -0,0 +1,371 @@
+/////////////////////////////////////////////////
+// Compressed Directed Node Graph
+
+// Bits are written to the words of BitV from the most significant one down.
+void TNGraphZip::PutBits(TUInt64V& BitV, TInt64& Bits, const uint64& Val, const int& NBits) {
+  if (NBits == 0) { return; }
+  const int Off = int(Bits & 63);
+  if (Off == 0) { BitV.Add(0); }
+  const int Free = 64 - Off;
+  if (NBits <= Free) {
+    BitV.Last().Val |= Val << (Free - NBits);
+  } else {
+    BitV.Last().Val |= Val >> (NBits - Free);
+    BitV.Add(Val << (64 - (NBits - Free)));
+  }
+  Bits += NBits;
+}
+
+// Elias gamma code of Val+1: floor(log2(Val+1)) zeros followed by Val+1 in binary.
+void TNGraphZip::PutGamma(TUInt64V& BitV, TInt64& Bits, const uint64& Val) {
+  const uint64 V = Val + 1;
+  int NBits = 0;
+  while ((V >> NBits) > 1) { NBits++; }
+  PutBits(BitV, Bits, 0, NBits);
+  PutBits(BitV, Bits, V, NBits+1);
+}
+
+// Zeta_K code of Val+1 (Boldi and Vigna): H = floor(log2(Val+1)) / K in unary, then the
+// offset of Val+1 in [2^(HK), 2^((H+1)K)) in minimal binary.
+void TNGraphZip::PutZeta(TUInt64V& BitV, TInt64& Bits, const uint64& Val, const int& K) {
+  const uint64 V = Val + 1;
+  int Log = 0;
+  while ((V >> Log) > 1) { Log++; }
+  const int H = Log / K;
+  PutBits(BitV, Bits, 1, H+1);
+  const int NBits = (H+1) * K;
+  const uint64 Left = uint64(1) << (H*K);
+  const uint64 Y = V - Left;
+  if (Y < Left) { PutBits(BitV, Bits, Y, NBits-1); }
+  else { PutBits(BitV, Bits, Y + Left, NBits); }
+}
+
+uint64 TNGraphZip::GetBits(const TUInt64V& BitV, int64& Pos, const int& NBits) {
+  if (NBits == 0) { return 0; }
+  const int WordN = int(Pos >> 6);
+  const int Off = int(Pos & 63);
+  uint64 Val = BitV[WordN].Val << Off;
+  if (Off + NBits > 64) { Val |= BitV[WordN+1].Val >> (64 - Off); }
+  Pos += NBits;
+  return Val >> (64 - NBits);
+}
+
+int TNGraphZip::GetUnary(const TUInt64V& BitV, int64& Pos) {
+  int Zeros = 0;
+  while (true) {
+    uint64 Word = BitV[int(Pos >> 6)].Val << (Pos & 63);
+    if (Word != 0) {
+      int Lead = 0;
+      while ((Word & (uint64(1) << 63)) == 0) { Word <<= 1;  Lead++; }
+      Pos += Lead + 1;
+      return Zeros + Lead;
+    }
+    const int Rest = 64 - int(Pos & 63);
+    Zeros += Rest;  Pos += Rest;
+  }
+}
+
+uint64 TNGraphZip::GetZeta(const TUInt64V& BitV, int64& Pos, const int& K) {
+  const int H = GetUnary(BitV, Pos);
+  const int NBits = (H+1) * K;
+  const uint64 Left = uint64(1) << (H*K);
+  uint64 Y = GetBits(BitV, Pos, NBits-1);
+  if (Y >= Left) { Y = ((Y << 1) | GetBits(BitV, Pos, 1)) - Left; }
+  return Y + Left - 1;
+}
+
+TNGraphZip::TAdjCoder::TAdjCoder(TAdjV& AdjV, const int& K, const int& Win, const int& MxChain) :
+  Adj(AdjV), ZetaK(K), Window(Win), MxRefChain(MxChain), Nodes(0), WinV(TMath::Mx(Win, 1)),
+  ChainV(TMath::Mx(Win, 1)), ResV() {
+  Adj.Clr();
+}
+
+// A list is coded as: degree (gamma); if the degree is positive, the distance to the
+// reference list (gamma, 0 for none); for a reference, the number of copy blocks (gamma)
+// and the block lengths (gamma, all but the first are at least 1), blocks alternate between
+// copying and skipping elements of the reference list, starting with copying, and the
+// elements after the last block are copied if the number of blocks is even; the remaining
+// neighbors (residuals) as zeta coded gaps, the first one relative to the node itself.
+void TNGraphZip::TAdjCoder::AddNbrV(const TIntV& NbrV) {
+  const int NIdx = Nodes;
+  const int64 Beg = Adj.Bits;
+  if (NIdx % SampleStep == 0) {
+    Adj.SampleV.Add(Adj.Bits);
+    Adj.OffSampleV.Add(Adj.OffBits);
+  }
+  PutGamma(Adj.BitV, Adj.Bits, NbrV.Len());
+  int Chain = 0;
+  if (! NbrV.Empty()) {
+    // the previous list that shares the most neighbors is the reference
+    int Ref = 0, MxCommon = 0;
+    for (int r = 1; r <= Window && r <= NIdx; r++) {
+      if (ChainV[(NIdx-r) % Window] >= MxRefChain) { continue; }
+      const TIntV& RefV = WinV[(NIdx-r) % Window];
+      int Common = 0;
+      for (int i = 0, j = 0; i < RefV.Len() && j < NbrV.Len(); ) {
+        if (RefV[i] < NbrV[j]) { i++; }
+        else if (RefV[i] > NbrV[j]) { j++; }
+        else { Common++;  i++;  j++; }
+      }
+      if (Common > MxCommon) { MxCommon = Common;  Ref = r; }
+    }
+    PutGamma(Adj.BitV, Adj.Bits, Ref);
+    ResV.Clr(false);
+    if (Ref > 0) {
+      const TIntV& RefV = WinV[(NIdx-Ref) % Window];
+      Chain = ChainV[(NIdx-Ref) % Window] + 1;
+      // runs of copied and skipped elements of the reference list, the last run is implicit
+      TIntV BlockV;
+      bool Copy = true;
+      int Run = 0, j = 0;
+      for (int i = 0; i < RefV.Len(); i++) {
+        while (j < NbrV.Len() && NbrV[j] < RefV[i]) { ResV.Add(NbrV[j]);  j++; }
+        const bool InNbr = j < NbrV.Len() && NbrV[j] == RefV[i];
+        if (InNbr) { j++; }
+        if (InNbr != Copy) { BlockV.Add(Run);  Run = 0;  Copy = ! Copy; }
+        Run++;
+      }
+      while (j < NbrV.Len()) { ResV.Add(NbrV[j]);  j++; }
+      PutGamma(Adj.BitV, Adj.Bits, BlockV.Len());
+      for (int b = 0; b < BlockV.Len(); b++) {
+        PutGamma(Adj.BitV, Adj.Bits, b == 0 ? BlockV[b]() : BlockV[b]-1); }
+    } else {
+      ResV = NbrV;
+    }
+    for (int r = 0; r < ResV.Len(); r++) {
+      if (r == 0) {
+        const int64 Diff = int64(ResV[0]) - NIdx;
+        PutZeta(Adj.BitV, Adj.Bits, Diff >= 0 ? 2*Diff : -2*Diff-1, ZetaK);
+      } else {
+        PutZeta(Adj.BitV, Adj.Bits, ResV[r] - ResV[r-1] - 1, ZetaK);
+      }
+    }
+  }
+  PutGamma(Adj.OffBitV, Adj.OffBits, Adj.Bits - Beg);
+  if (Window > 0) {
+    WinV[NIdx % Window] = NbrV;
+    ChainV[NIdx % Window] = Chain;
+  }
+  Nodes++;
+}
+
+int64 TNGraphZip::GetNbrPos(const TAdjV& Adj, const int& NIdx) const {
+  const int SampleN = NIdx / SampleStep;
+  int64 Pos = Adj.SampleV[SampleN];
+  int64 OffPos = Adj.OffSampleV[SampleN];
+  for (int n = SampleN * SampleStep; n < NIdx; n++) {
+    Pos += GetGamma(Adj.OffBitV, OffPos); }
+  return Pos;
+}
+
+void TNGraphZip::GetNbrV(const TAdjV& Adj, const int& NIdx, TIntV& NbrV) const {
+  int64 Pos = GetNbrPos(Adj, NIdx);
+  const int Deg = int(GetGamma(Adj.BitV, Pos));
+  NbrV.Clr(false);
+  if (Deg == 0) { return; }
+  const int Ref = int(GetGamma(Adj.BitV, Pos));
+  TIntV CopyV;
+  if (Ref > 0) {
+    TIntV RefV;
+    GetNbrV(Adj, NIdx - Ref, RefV);
+    const int Blocks = int(GetGamma(Adj.BitV, Pos));
+    CopyV.Gen(RefV.Len(), 0);
+    int RefN = 0;
+    bool Copy = true;
+    for (int b = 0; b < Blocks; b++) {
+      const int Len = int(GetGamma(Adj.BitV, Pos)) + (b == 0 ? 0 : 1);
+      if (Copy) {
+        for (int i = RefN; i < RefN + Len; i++) { CopyV.Add(RefV[i]); } }
+      RefN += Len;
+      Copy = ! Copy;
+    }
+    if (Copy) {
+      for (int i = RefN; i < RefV.Len(); i++) { CopyV.Add(RefV[i]); } }
+  }
+  // merge the copied neighbors with the residuals
+  const int Res = Deg - CopyV.Len();
+  int CopyN = 0, Prev = 0;
+  for (int r = 0; r < Res; r++) {
+    int NbrIdx;
+    if (r == 0) {
+      const int64 Val = GetZeta(Adj.BitV, Pos, ZetaK);
+      NbrIdx = int(NIdx + ((Val & 1) == 0 ? Val/2 : -(Val+1)/2));
+    } else {
+      NbrIdx = Prev + 1 + int(GetZeta(Adj.BitV, Pos, ZetaK));
+    }
+    while (CopyN < CopyV.Len() && CopyV[CopyN] < NbrIdx) { NbrV.Add(CopyV[CopyN]);  CopyN++; }
+    NbrV.Add(NbrIdx);
+    Prev = NbrIdx;
+  }
+  while (CopyN < CopyV.Len()) { NbrV.Add(CopyV[CopyN]);  CopyN++; }
+}
+
+// The edges of a run are buffered from a temporary file, or all of them are held in
+// memory when the input fits in a single run.
+class TNGraphZip::TEdgeRun {
+public:
+  FILE* F;
+  int64 Left;               // edges of the run not read from F yet
+  TVec<TIntPr, int64> BfV;
+  int64 BfN;                // next edge in BfV
+public:
+  TEdgeRun() : F(NULL), Left(0), BfV(), BfN(0) { }
+  /// Reads the next edges from the file if the buffer is used up, returns false at the end of the run.
+  bool Fill(const int64& BfLen) {
+    if (BfN < BfV.Len()) { return true; }
+    if (F == NULL || Left == 0) { return false; }
+    const int64 Len = TMath::Mn(BfLen, Left);
+    BfV.Gen(Len);  BfN = 0;  Left -= Len;
+    const size_t Read = fread(BfV.BegI(), sizeof(TIntPr), size_t(Len), F);
+    EAssertR(Read == size_t(Len), "Can not read temporary edge file");
+    return true;
+  }
+  const TIntPr& GetEdge() const { return BfV[BfN]; }
+};
+
+void TNGraphZip::SortEdgeRun(TVec<TIntPr, int64>& EdgeV, TIntV& NIdV) {
+  EdgeV.Sort();
+  int64 Len = 0;
+  TIntV RunNIdV;
+  for (int64 e = 0; e < EdgeV.Len(); e++) {
+    if (Len > 0 && EdgeV[Len-1] == EdgeV[e]) { continue; }
+    if (RunNIdV.Empty() || RunNIdV.Last() != EdgeV[e].Val1) { RunNIdV.Add(EdgeV[e].Val1); }
+    EdgeV[Len] = EdgeV[e];  Len++;
+  }
+  EdgeV.Reduce(Len);
+  NIdV.Union(RunNIdV);
+}
+
+// Merges the runs with a heap of their smallest edges, so the pairs arrive sorted by node ID
+// and duplicates from different runs are next to each other.
+void TNGraphZip::BuildFromRuns(TVec<TEdgeRun>& RunV, const int& Dir, const int& Window, const int& MxRefChain) {
+  typedef TPair<TIntPr, TInt> TEdgeRunPr;
+  const int64 BfLen = 1<<16;
+  THeap<TEdgeRunPr, TGtr<TEdgeRunPr> > Heap;
+  for (int r = 0; r < RunV.Len(); r++) {
+    if (RunV[r].Fill(BfLen)) { Heap.PushHeap(TEdgeRunPr(RunV[r].GetEdge(), r)); } }
+  TAdjCoder Coder(Dir == 0 ? OutAdj : InAdj, ZetaK, Window, MxRefChain);
+  TIntV NbrV;
+  int NIdx = 0;
+  while (! Heap.Empty()) {
+    const TEdgeRunPr Top = Heap.PopHeap();
+    TEdgeRun& Run = RunV[Top.Val2];
+    Run.BfN++;
+    if (Run.Fill(BfLen)) { Heap.PushHeap(TEdgeRunPr(Run.GetEdge(), Top.Val2)); }
+    for ( ; NIdV[NIdx] < Top.Val1.Val1; NIdx++) {
+      Coder.AddNbrV(NbrV);
+      if (Dir == 0) { NEdges += NbrV.Len(); }
+      NbrV.Clr(false);
+    }
+    const int NbrIdx = GetNIdx(Top.Val1.Val2);
+    if (NbrV.Empty() || NbrV.Last() != NbrIdx) { NbrV.Add(NbrIdx); }
+  }
+  for ( ; NIdx < NIdV.Len(); NIdx++) {
+    Coder.AddNbrV(NbrV);
+    if (Dir == 0) { NEdges += NbrV.Len(); }
+    NbrV.Clr(false);
+  }
+  Coder.Finish();
+}
+
+// Reads the edges in chunks of MxMemEdges. If the input does not fit in one chunk, every chunk
+// is sorted by source and by destination and saved to temporary run files next to InFNm, which
+// are then merged. The node IDs are collected as the chunks are sorted.
+PNGraphZip TNGraphZip::LoadEdgeList(const TStr& InFNm, const int& SrcColId, const int& DstColId, const bool& WithIn,
+ const int64& MxMemEdges) {
+  IAssert(MxMemEdges > 0);
+  PNGraphZip Graph = new TNGraphZip();
+  TSsParser Ss(InFNm, ssfWhiteSep, true, true, true);
+  TVec<TIntPr, int64> EdgeV;
+  TStrV RunFNmV[2];
+  TVec<TInt64> RunLenV;
+  bool MoreEdges = true;
+  while (MoreEdges) {
+    int SrcNId, DstNId;
+    EdgeV.Clr(false);
+    while (EdgeV.Len() < MxMemEdges && (MoreEdges = Ss.Next())) {
+      if (TSnap::TSnapDetail::GetSsNId(Ss, SrcColId, SrcNId) && TSnap::TSnapDetail::GetSsNId(Ss, DstColId, DstNId)) {
+        EdgeV.Add(TIntPr(SrcNId, DstNId)); }
+    }
+    if ((! MoreEdges && RunLenV.Empty()) || EdgeV.Empty()) { break; }
+    // saves the chunk as a run sorted by destination, then as a run sorted by source
+    for (int Dir = 1; Dir >= 0; Dir--) {
+      for (int64 e = 0; e < EdgeV.Len(); e++) { EdgeV[e] = TIntPr(EdgeV[e].Val2, EdgeV[e].Val1); }
+      SortEdgeRun(EdgeV, Graph->NIdV);
+      if (Dir == 1 && ! WithIn) { continue; }
+      const TStr RunFNm = InFNm + TStr::Fmt(".%s%d.tmp", Dir == 0 ? "out" : "in", RunLenV.Len());
+      FILE *RunF = fopen(RunFNm.CStr(), "wb");
+      EAssertR(RunF != NULL, "Can not open file " + RunFNm);
+      const size_t Written = fwrite(EdgeV.BegI(), sizeof(TIntPr), size_t(EdgeV.Len()), RunF);
+      EAssertR(Written == size_t(EdgeV.Len()), "Can not write file " + RunFNm);
+      fclose(RunF);
+      RunFNmV[Dir].Add(RunFNm);
+    }
+    RunLenV.Add(EdgeV.Len());
+  }
+  for (int Dir = 0; Dir < (WithIn ? 2 : 1); Dir++) {
+    TVec<TEdgeRun> RunV;
+    if (RunLenV.Empty()) {
+      // the input fits in memory, the edges are sorted in place
+      if (Dir == 0) {
+        for (int64 e = 0; e < EdgeV.Len(); e++) { EdgeV[e] = TIntPr(EdgeV[e].Val2, EdgeV[e].Val1); }
+        SortEdgeRun(EdgeV, Graph->NIdV);
+      }
+      for (int64 e = 0; e < EdgeV.Len(); e++) { EdgeV[e] = TIntPr(EdgeV[e].Val2, EdgeV[e].Val1); }
+      SortEdgeRun(EdgeV, Graph->NIdV);
+      RunV.Gen(1);
+      RunV[0].BfV.MoveFrom(EdgeV);
+      Graph->BuildFromRuns(RunV, Dir, 7, 3);
+      EdgeV.MoveFrom(RunV[0].BfV);
+    } else {
+      RunV.Gen(RunLenV.Len());
+      for (int r = 0; r < RunV.Len(); r++) {
+        RunV[r].F = fopen(RunFNmV[Dir][r].CStr(), "rb");
+        EAssertR(RunV[r].F != NULL, "Can not open file " + RunFNmV[Dir][r]);
+        RunV[r].Left = RunLenV[r];
+      }
+      Graph->BuildFromRuns(RunV, Dir, 7, 3);
+      for (int r = 0; r < RunV.Len(); r++) {
+        fclose(RunV[r].F);
+        TFile::Del(RunFNmV[Dir][r]);
+      }
+    }
+  }
+  return Graph;
+}
+
+bool TNGraphZip::HasFlag(const TGraphFlag& Flag) const {
+  return HasGraphFlag(TNGraphZip::TNet, Flag);
+}
+
+bool TNGraphZip::IsEdge(const int& SrcNId, const int& DstNId, const bool& IsDir) const {
+  if (! IsNode(SrcNId) || ! IsNode(DstNId)) { return false; }
+  if (IsDir) { return GetNI(SrcNId).IsOutNId(DstNId); }
+  else { return GetNI(SrcNId).IsOutNId(DstNId) || GetNI(DstNId).IsOutNId(SrcNId); }
+}
+
+double TNGraphZip::GetOutBitsPerEdge() const {
+  if (NEdges == 0) { return 0.0; }
+  const int64 Bits = OutAdj.Bits + OutAdj.OffBits + 64 * (OutAdj.SampleV.Len() + OutAdj.OffSampleV.Len());
+  return double(Bits) / double(NEdges);
+}
+
+void TNGraphZip::Dump(FILE *OutF) const {
+  const int NodePlaces = (int) ceil(log10((double) GetNodes()));
+  fprintf(OutF, "-------------------------------------------------\nDirected Node Graph (compressed): nodes: %d, edges: %s\n",
+    GetNodes(), TInt64::GetStr(GetEdges()).CStr());
+  for (TNodeI NI = BegNI(); NI < EndNI(); NI++) {
+    fprintf(OutF, "  %*d]\n", NodePlaces, NI.GetId());
+    if (HasIn()) {
+      fprintf(OutF, "    in [%d]", NI.GetInDeg());
+      for (int edge = 0; edge < NI.GetInDeg(); edge++) {
+        fprintf(OutF, " %*d", NodePlaces, NI.GetInNId(edge)); }
+      fprintf(OutF, "\n");
+    }
+    fprintf(OutF, "    out[%d]", NI.GetOutDeg());
+    for (int edge = 0; edge < NI.GetOutDeg(); edge++) {
+      fprintf(OutF, " %*d", NodePlaces, NI.GetOutNId(edge)); }
+    fprintf(OutF, "\n");
+  }
+  fprintf(OutF, "\n");
+}
@@ -0,0 +1,251 @@
+//#//////////////////////////////////////////////
+/// Read-only compressed directed graphs
+
+class TNGraphZip;
+
+/// Pointer to a read-only compressed directed graph (TNGraphZip)
+typedef TPt<TNGraphZip> PNGraphZip;
+
+//#//////////////////////////////////////////////
+/// Read-only directed graph with compressed adjacency lists. ##TNGraphZip::Class
+class TNGraphZip {
+public:
+  typedef TNGraphZip TNet;
+  typedef TPt<TNGraphZip> PNet;
+private:
+  /// Adjacency lists of one direction, gap coded with reference compression. ##TNGraphZip::TAdjV
+  class TAdjV {
+  public:
+    TUInt64V BitV;      // coded lists of all nodes, one after another
+    TInt64 Bits;
+    TUInt64V OffBitV;   // gamma coded length in bits of every list
+    TInt64 OffBits;
+    TVec<TInt64> SampleV;    // position of every SampleStep-th list in BitV
+    TVec<TInt64> OffSampleV; // position of the length of every SampleStep-th list in OffBitV
+  public:
+    TAdjV() : BitV(), Bits(0), OffBitV(), OffBits(0), SampleV(), OffSampleV() { }
+    TAdjV(TSIn& SIn) : BitV(SIn), Bits(SIn), OffBitV(SIn), OffBits(SIn), SampleV(SIn), OffSampleV(SIn) { }
+    void Save(TSOut& SOut) const {
+      BitV.Save(SOut); Bits.Save(SOut); OffBitV.Save(SOut); OffBits.Save(SOut); SampleV.Save(SOut); OffSampleV.Save(SOut); }
+    bool Empty() const { return SampleV.Empty(); }
+    void Clr() { BitV.Clr(); Bits=0; OffBitV.Clr(); OffBits=0; SampleV.Clr(); OffSampleV.Clr(); }
+    ::TSize GetMemUsed() const {
+      return sizeof(TAdjV) + ::TSize(BitV.Reserved() + OffBitV.Reserved() + SampleV.Reserved() + OffSampleV.Reserved()) * sizeof(uint64); }
+  };
+  /// Codes the adjacency lists of consecutive nodes into TAdjV.
+  class TAdjCoder {
+  private:
+    TAdjV& Adj;
+    int ZetaK, Window, MxRefChain, Nodes;
+    TVec<TIntV> WinV;   // lists of the last Window nodes, list of node n is at n % Window
+    TIntV ChainV;       // length of the reference chain of the last Window nodes
+    TIntV ResV;
+  public:
+    TAdjCoder(TAdjV& AdjV, const int& K, const int& Win, const int& MxChain);
+    /// Codes NbrV, the sorted node indices of the neighbors of the next node.
+    void AddNbrV(const TIntV& NbrV);
+    /// Trims the coded lists after the last node.
+    void Finish() { Adj.BitV.Pack(); Adj.OffBitV.Pack(); Adj.SampleV.Pack(); Adj.OffSampleV.Pack(); }
+  };
+public:
+  /// Node iterator. Only forward iteration (operator++) is supported.
+  class TNodeI {
+  private:
+    const TNGraphZip* Graph;
+    int NIdx;
+    // node indices of the neighbors of the current node, decoded on first use
+    mutable TIntV OutV, InV;
+    mutable bool OutInit, InInit;
+  private:
+    const TIntV& GetOutV() const {
+      if (! OutInit) { Graph->GetNbrV(Graph->OutAdj, NIdx, OutV);  OutInit = true; }  return OutV; }
+    const TIntV& GetInV() const {
+      if (! InInit) { IAssertR(Graph->HasIn(), "In-edges were not stored.");
+        Graph->GetNbrV(Graph->GetInAdj(), NIdx, InV);  InInit = true; }  return InV; }
+  public:
+    TNodeI() : Graph(NULL), NIdx(0), OutV(), InV(), OutInit(false), InInit(false) { }
+    TNodeI(const TNGraphZip* GraphPt, const int& NodeIdx) : Graph(GraphPt), NIdx(NodeIdx), OutV(), InV(), OutInit(false), InInit(false) { }
+    TNodeI(const TNodeI& NodeI) : Graph(NodeI.Graph), NIdx(NodeI.NIdx), OutV(NodeI.OutV), InV(NodeI.InV),
+      OutInit(NodeI.OutInit), InInit(NodeI.InInit) { }
+    TNodeI& operator = (const TNodeI& NodeI) { Graph = NodeI.Graph; NIdx = NodeI.NIdx; OutV = NodeI.OutV; InV = NodeI.InV;
+      OutInit = NodeI.OutInit; InInit = NodeI.InInit; return *this; }
+    /// Increment iterator.
+    TNodeI& operator++ (int) { NIdx++; OutInit = false; InInit = false; return *this; }
+    bool operator < (const TNodeI& NodeI) const { return NIdx < NodeI.NIdx; }
+    bool operator == (const TNodeI& NodeI) const { return NIdx == NodeI.NIdx; }
+    /// Returns ID of the current node.
+    int GetId() const { return Graph->NIdV[NIdx]; }
+    /// Returns degree of the current node, the sum of in-degree and out-degree.
+    int GetDeg() const { return GetInDeg() + GetOutDeg(); }
+    /// Returns in-degree of the current node.
+    int GetInDeg() const { return GetInV().Len(); }
+    /// Returns out-degree of the current node.
+    int GetOutDeg() const { return GetOutV().Len(); }
+    /// Returns ID of NodeN-th in-node (the node pointing to the current node).
+    int GetInNId(const int& NodeN) const { return Graph->NIdV[GetInV()[NodeN]]; }
+    /// Returns ID of NodeN-th out-node (the node the current node points to).
+    int GetOutNId(const int& NodeN) const { return Graph->NIdV[GetOutV()[NodeN]]; }
+    /// Returns ID of NodeN-th neighboring node.
+    int GetNbrNId(const int& NodeN) const { return NodeN<GetOutDeg()?GetOutNId(NodeN):GetInNId(NodeN-GetOutDeg()); }
+    /// Tests whether node with ID NId points to the current node.
+    bool IsInNId(const int& NId) const { const int Idx = Graph->GetNIdx(NId); return Idx != -1 && GetInV().SearchBin(Idx) != -1; }
+    /// Tests whether the current node points to node with ID NId.
+    bool IsOutNId(const int& NId) const { const int Idx = Graph->GetNIdx(NId); return Idx != -1 && GetOutV().SearchBin(Idx) != -1; }
+    /// Tests whether node with ID NId is a neighbor of the current node.
+    bool IsNbrNId(const int& NId) const { return IsOutNId(NId) || IsInNId(NId); }
+    friend class TNGraphZip;
+  };
+  /// Edge iterator. Only forward iteration (operator++) is supported.
+  class TEdgeI {
+  private:
+    TNodeI CurNode, EndNode;
+    int CurEdge;
+  public:
+    TEdgeI() : CurNode(), EndNode(), CurEdge(0) { }
+    TEdgeI(const TNodeI& NodeI, const TNodeI& EndNodeI, const int& EdgeN=0) : CurNode(NodeI), EndNode(EndNodeI), CurEdge(EdgeN) { }
+    TEdgeI(const TEdgeI& EdgeI) : CurNode(EdgeI.CurNode), EndNode(EdgeI.EndNode), CurEdge(EdgeI.CurEdge) { }
+    TEdgeI& operator = (const TEdgeI& EdgeI) { if (this!=&EdgeI) { CurNode=EdgeI.CurNode; EndNode=EdgeI.EndNode; CurEdge=EdgeI.CurEdge; }  return *this; }
+    /// Increment iterator.
+    TEdgeI& operator++ (int) { CurEdge++; if (CurEdge >= CurNode.GetOutDeg()) { CurEdge=0; CurNode++;
+      while (CurNode < EndNode && CurNode.GetOutDeg()==0) { CurNode++; } }  return *this; }
+    bool operator < (const TEdgeI& EdgeI) const { return CurNode<EdgeI.CurNode || (CurNode==EdgeI.CurNode && CurEdge<EdgeI.CurEdge); }
+    bool operator == (const TEdgeI& EdgeI) const { return CurNode == EdgeI.CurNode && CurEdge == EdgeI.CurEdge; }
+    /// Returns edge ID. Always returns -1 since only edges in multigraphs have explicit IDs.
+    int GetId() const { return -1; }
+    /// Returns the source node of the edge.
+    int GetSrcNId() const { return CurNode.GetId(); }
+    /// Returns the destination node of the edge.
+    int GetDstNId() const { return CurNode.GetOutNId(CurEdge); }
+    friend class TNGraphZip;
+  };
+private:
+  TCRef CRef;
+  TIntV NIdV;         // node index -> node ID, sorted
+  TInt64 NEdges;
+  TInt ZetaK;
+  TBool Sym;          // in-lists equal out-lists, InAdj is empty
+  TAdjV OutAdj, InAdj;
+private:
+  const TAdjV& GetInAdj() const { return Sym ? OutAdj : InAdj; }
+  /// Every SampleStep-th list has its position stored explicitly.
+  static const int SampleStep = 32;
+  static void PutBits(TUInt64V& BitV, TInt64& Bits, const uint64& Val, const int& NBits);
+  static void PutGamma(TUInt64V& BitV, TInt64& Bits, const uint64& Val);
+  static void PutZeta(TUInt64V& BitV, TInt64& Bits, const uint64& Val, const int& K);
+  static uint64 GetBits(const TUInt64V& BitV, int64& Pos, const int& NBits);
+  static int GetUnary(const TUInt64V& BitV, int64& Pos);
+  static uint64 GetGamma(const TUInt64V& BitV, int64& Pos) {
+    const int NBits = GetUnary(BitV, Pos);  return ((uint64(1) << NBits) | GetBits(BitV, Pos, NBits)) - 1; }
+  static uint64 GetZeta(const TUInt64V& BitV, int64& Pos, const int& K);
+  /// Returns the position of the list of node NIdx in Adj.BitV.
+  int64 GetNbrPos(const TAdjV& Adj, const int& NIdx) const;
+  /// Decodes the list of node NIdx to node indices.
+  void GetNbrV(const TAdjV& Adj, const int& NIdx, TIntV& NbrV) const;
+  /// Sorted run of (node ID, neighbor ID) pairs read by LoadEdgeList().
+  class TEdgeRun;
+  /// Sorts EdgeV by the first node ID of the pairs, removes duplicates and merges the first node IDs into NIdV.
+  static void SortEdgeRun(TVec<TIntPr, int64>& EdgeV, TIntV& NIdV);
+  /// Codes the lists of one direction by merging the sorted runs in RunV, the node IDs in NIdV must be set.
+  void BuildFromRuns(TVec<TEdgeRun>& RunV, const int& Dir, const int& Window, const int& MxRefChain);
+private:
+  TNGraphZip(const TNGraphZip& Graph);
+  TNGraphZip& operator = (const TNGraphZip& Graph);
+public:
+  TNGraphZip() : CRef(), NIdV(), NEdges(0), ZetaK(3), Sym(false), OutAdj(), InAdj() { }
+  /// Constructs a compressed copy of Graph. ##TNGraphZip::TNGraphZip
+  template <class PGraph> TNGraphZip(const PGraph& Graph, const bool& WithIn=true, const int& Window=7, const int& MxRefChain=3);
+  /// Constructor that loads the graph from a (binary) stream SIn.
+  TNGraphZip(TSIn& SIn) : NIdV(SIn), NEdges(SIn), ZetaK(SIn), Sym(SIn), OutAdj(SIn), InAdj(SIn) { }
+  /// Saves the graph to a (binary) stream SOut.
+  void Save(TSOut& SOut) const { NIdV.Save(SOut); NEdges.Save(SOut); ZetaK.Save(SOut); Sym.Save(SOut); OutAdj.Save(SOut); InAdj.Save(SOut); }
+  /// Static constructor that returns a pointer to a compressed copy of Graph. Call: PNGraphZip Graph = TNGraphZip::New(Graph).
+  template <class PGraph> static PNGraphZip New(const PGraph& Graph, const bool& WithIn=true, const int& Window=7, const int& MxRefChain=3) {
+    return new TNGraphZip(Graph, WithIn, Window, MxRefChain); }
+  /// Static constructor that loads the graph from a stream SIn and returns a pointer to it.
+  static PNGraphZip Load(TSIn& SIn) { return PNGraphZip(new TNGraphZip(SIn)); }
+  /// Loads the edge list format saved by TSnap::SaveEdgeList() directly into a compressed graph. ##TNGraphZip::LoadEdgeList
+  static PNGraphZip LoadEdgeList(const TStr& InFNm, const int& SrcColId=0, const int& DstColId=1, const bool& WithIn=true,
+    const int64& MxMemEdges=int64(1)<<27);
+  /// Allows for run-time checking the type of the graph (see the TGraphFlag for flags).
+  bool HasFlag(const TGraphFlag& Flag) const;
+
+  /// Returns the number of nodes in the graph.
+  int GetNodes() const { return NIdV.Len(); }
+  /// Tests whether ID NId is a node.
+  bool IsNode(const int& NId) const { return GetNIdx(NId) != -1; }
+  /// Returns the index of node NId (its position in the sorted node IDs) or -1 if NId is not a node.
+  int GetNIdx(const int& NId) const { return NIdV.SearchBin(NId); }
+  /// Returns an iterator referring to the first node in the graph.
+  TNodeI BegNI() const { return TNodeI(this, 0); }
+  /// Returns an iterator referring to the past-the-end node in the graph.
+  TNodeI EndNI() const { return TNodeI(this, GetNodes()); }
+  /// Returns an iterator referring to the node of ID NId in the graph.
+  TNodeI GetNI(const int& NId) const { const int Idx = GetNIdx(NId);  IAssert(Idx != -1);  return TNodeI(this, Idx); }
+  /// Returns an ID that is larger than any node ID in the graph.
+  int GetMxNId() const { return NIdV.Empty() ? 0 : NIdV.Last()+1; }
+
+  /// Returns the number of edges in the graph.
+  int64 GetEdges() const { return NEdges; }
+  /// Tests whether an edge from node IDs SrcNId to DstNId exists in the graph.
+  bool IsEdge(const int& SrcNId, const int& DstNId, const bool& IsDir = true) const;
+  /// Returns an iterator referring to the first edge in the graph.
+  TEdgeI BegEI() const { TNodeI NI=BegNI(); while(NI<EndNI() && NI.GetOutDeg()==0){NI++;} return TEdgeI(NI, EndNI()); }
+  /// Returns an iterator referring to the past-the-end edge in the graph.
+  TEdgeI EndEI() const { return TEdgeI(EndNI(), EndNI()); }
+  /// Tests whether the in-edges are stored.
+  bool HasIn() const { return Sym || ! InAdj.Empty() || GetNodes() == 0; }
+
+  /// Returns an ID of a random node in the graph.
+  int GetRndNId(TRnd& Rnd=TInt::Rnd) { return NIdV[Rnd.GetUniDevInt(GetNodes())]; }
+  /// Returns an interator referring to a random node in the graph.
+  TNodeI GetRndNI(TRnd& Rnd=TInt::Rnd) { return TNodeI(this, Rnd.GetUniDevInt(GetNodes())); }
+  /// Gets a vector IDs of all nodes in the graph.
+  void GetNIdV(TIntV& NIdV) const { NIdV = this->NIdV; }
+  /// Tests whether the graph is empty (has zero nodes).
+  bool Empty() const { return GetNodes()==0; }
+  /// Deletes all nodes and edges from the graph.
+  void Clr() { NIdV.Clr(); NEdges=0; Sym=false; OutAdj.Clr(); InAdj.Clr(); }
+  /// Returns the number of bytes used by the graph.
+  ::TSize GetMemUsed() const { return sizeof(TNGraphZip) + NIdV.GetMemUsed() + OutAdj.GetMemUsed() + InAdj.GetMemUsed(); }
+  /// Returns the average number of bits per edge of the out-edges, including their offset index.
+  double GetOutBitsPerEdge() const;
+  /// Print the graph in a human readable form to an output stream OutF.
+  void Dump(FILE *OutF=stdout) const;
+
+  friend class TPt<TNGraphZip>;
+};
+
+// set flags
+namespace TSnap {
+template <> struct IsDirected<TNGraphZip> { enum { Val = 1 }; };
+}
+
+template <class PGraph>
+TNGraphZip::TNGraphZip(const PGraph& Graph, const bool& WithIn, const int& Window, const int& MxRefChain) :
+  CRef(), NIdV(), NEdges(0), ZetaK(3), Sym(false), OutAdj(), InAdj() {
+  const bool IsDir = HasGraphFlag(typename PGraph::TObj, gfDirected);
+  Sym = ! IsDir;
+  NIdV.Gen(Graph->GetNodes(), 0);
+  for (typename PGraph::TObj::TNodeI NI = Graph->BegNI(); NI < Graph->EndNI(); NI++) {
+    NIdV.Add(NI.GetId()); }
+  NIdV.Sort();
+  TIntV NIdxV(Graph->GetMxNId());
+  for (int i = 0; i < NIdV.Len(); i++) { NIdxV[NIdV[i]] = i; }
+  TAdjCoder OutCoder(OutAdj, ZetaK, Window, MxRefChain), InCoder(InAdj, ZetaK, Window, MxRefChain);
+  TIntV NbrV;
+  for (int i = 0; i < NIdV.Len(); i++) {
+    const typename PGraph::TObj::TNodeI NI = Graph->GetNI(NIdV[i]);
+    NbrV.Clr(false);
+    for (int e = 0; e < NI.GetOutDeg(); e++) { NbrV.Add(NIdxV[NI.GetOutNId(e)]); }
+    NbrV.Sort();  NbrV.Merge();
+    OutCoder.AddNbrV(NbrV);
+    NEdges += NbrV.Len();
+    if (! WithIn || ! IsDir) { continue; }
+    NbrV.Clr(false);
+    for (int e = 0; e < NI.GetInDeg(); e++) { NbrV.Add(NIdxV[NI.GetInNId(e)]); }
+    NbrV.Sort();  NbrV.Merge();
+    InCoder.AddNbrV(NbrV);
+  }
+  OutCoder.Finish();
+  InCoder.Finish();
+}
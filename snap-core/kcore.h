@@ -37,6 +37,8 @@ public:
   const TIntV& GetNIdV() const { return NIdV; }
   /// Returrns the graph of the current K-core.
   PGraph GetCoreG() const { return TSnap::GetSubGraph(Graph, NIdV); }
+  /// Returns a view of the graph of the current K-core, the graph is not copied.
+  TPt<TGraphView<PGraph> > GetCoreView() const { return TGraphView<PGraph>::New(Graph, NIdV); }
 };
 
 template<class PGraph>
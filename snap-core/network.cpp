@@ -825,6 +825,83 @@ int TNEANet::AddEdge(const int& SrcNId, const int& DstNId, int EId) {
   return EId;
 }
 
+// Edges get consecutive new IDs, which are larger than all existing ones,
+// so appending them keeps the edge ID vectors of the nodes sorted.
+int TNEANet::AddEdgeBatch(const TIntPrV& EdgeV) {
+  int i;
+
+  for (int e = 0; e < EdgeV.Len(); e++) {
+    IAssertR(IsNode(EdgeV[e].Val1) && IsNode(EdgeV[e].Val2), TStr::Fmt("%d or %d not a node.", EdgeV[e].Val1(), EdgeV[e].Val2()).CStr());
+  }
+  const int MnEId = MxEId;
+  for (int e = 0; e < EdgeV.Len(); e++) {
+    const int EId = MxEId;  MxEId++;
+    EdgeH.AddDat(EId, TEdge(EId, EdgeV[e].Val1, EdgeV[e].Val2));
+    GetNode(EdgeV[e].Val1).OutEIdV.Add(EId);
+    GetNode(EdgeV[e].Val2).InEIdV.Add(EId);
+  }
+
+  // update attribute columns
+  for (i = 0; i < VecOfIntVecsE.Len(); i++) {
+    TVec<TInt>& IntVec = VecOfIntVecsE[i];
+    for (int EId = MnEId; EId < MxEId; EId++) {
+      const int KeyId = EdgeH.GetKeyId(EId);
+      if (IntVec.Len() > KeyId) { IntVec[KeyId] = TInt::Mn; }
+      else { IntVec.Ins(KeyId, TInt::Mn); }
+    }
+  }
+  TVec<TStr> DefIntVec = TVec<TStr>();
+  IntDefaultsE.GetKeyV(DefIntVec);
+  for (i = 0; i < DefIntVec.Len(); i++) {
+    TVec<TInt>& IntVec = VecOfIntVecsE[KeyToIndexTypeE.GetDat(DefIntVec[i]).Val2];
+    const TInt Default = GetIntAttrDefaultE(DefIntVec[i]);
+    for (int EId = MnEId; EId < MxEId; EId++) { IntVec[EdgeH.GetKeyId(EId)] = Default; }
+  }
+
+  for (i = 0; i < VecOfIntVecVecsE.Len(); i++) {
+    TVec<TIntV>& IntVecV = VecOfIntVecVecsE[i];
+    for (int EId = MnEId; EId < MxEId; EId++) { IntVecV.Ins(EdgeH.GetKeyId(EId), TIntV()); }
+  }
+
+  for (i = 0; i < VecOfFltVecVecsE.Len(); i++) {
+    TVec<TFltV>& FltVecV = VecOfFltVecVecsE[i];
+    for (int EId = MnEId; EId < MxEId; EId++) { FltVecV.Ins(EdgeH.GetKeyId(EId), TFltV()); }
+  }
+
+  for (i = 0; i < VecOfStrVecsE.Len(); i++) {
+    TVec<TStr>& StrVec = VecOfStrVecsE[i];
+    for (int EId = MnEId; EId < MxEId; EId++) {
+      const int KeyId = EdgeH.GetKeyId(EId);
+      if (StrVec.Len() > KeyId) { StrVec[KeyId] = TStr::GetNullStr(); }
+      else { StrVec.Ins(KeyId, TStr::GetNullStr()); }
+    }
+  }
+  TVec<TStr> DefStrVec = TVec<TStr>();
+  StrDefaultsE.GetKeyV(DefStrVec);
+  for (i = 0; i < DefStrVec.Len(); i++) {
+    TVec<TStr>& StrVec = VecOfStrVecsE[KeyToIndexTypeE.GetDat(DefStrVec[i]).Val2];
+    const TStr Default = GetStrAttrDefaultE(DefStrVec[i]);
+    for (int EId = MnEId; EId < MxEId; EId++) { StrVec[EdgeH.GetKeyId(EId)] = Default; }
+  }
+
+  for (i = 0; i < VecOfFltVecsE.Len(); i++) {
+    TVec<TFlt>& FltVec = VecOfFltVecsE[i];
+    for (int EId = MnEId; EId < MxEId; EId++) {
+      const int KeyId = EdgeH.GetKeyId(EId);
+      if (FltVec.Len() > KeyId) { FltVec[KeyId] = TFlt::Mn; }
+      else { FltVec.Ins(KeyId, TFlt::Mn); }
+    }
+  }
+  TVec<TStr> DefFltVec = TVec<TStr>();
+  FltDefaultsE.GetKeyV(DefFltVec);
+  for (i = 0; i < DefFltVec.Len(); i++) {
+    TVec<TFlt>& FltVec = VecOfFltVecsE[KeyToIndexTypeE.GetDat(DefFltVec[i]).Val2];
+    const TFlt Default = GetFltAttrDefaultE(DefFltVec[i]);
+    for (int EId = MnEId; EId < MxEId; EId++) { FltVec[EdgeH.GetKeyId(EId)] = Default; }
+  }
+  return EdgeV.Len();
+}
+
 void TNEANet::DelEdge(const int& EId) {
   int i;
 
@@ -1408,6 +1485,48 @@ int TNEANet::GetFltKeyIdE(const int& EId) {
   return EdgeH.GetKeyId(EId);
 }
 
+TNEANet::TIntAttrCol TNEANet::GetIntAttrColN(const TStr& attr) {
+  IAssertR(KeyToIndexTypeN.IsKey(attr) && KeyToIndexTypeN.GetDat(attr).Val1 == IntType, TStr::Fmt("%s is not an int node attribute", attr.CStr()));
+  return TIntAttrCol(&VecOfIntVecsN, KeyToIndexTypeN.GetDat(attr).Val2, true, this);
+}
+
+TNEANet::TFltAttrCol TNEANet::GetFltAttrColN(const TStr& attr) {
+  IAssertR(KeyToIndexTypeN.IsKey(attr) && KeyToIndexTypeN.GetDat(attr).Val1 == FltType, TStr::Fmt("%s is not a flt node attribute", attr.CStr()));
+  return TFltAttrCol(&VecOfFltVecsN, KeyToIndexTypeN.GetDat(attr).Val2, true, this);
+}
+
+TNEANet::TIntAttrCol TNEANet::GetIntAttrColE(const TStr& attr) {
+  IAssertR(KeyToIndexTypeE.IsKey(attr) && KeyToIndexTypeE.GetDat(attr).Val1 == IntType, TStr::Fmt("%s is not an int edge attribute", attr.CStr()));
+  return TIntAttrCol(&VecOfIntVecsE, KeyToIndexTypeE.GetDat(attr).Val2, false, this);
+}
+
+TNEANet::TFltAttrCol TNEANet::GetFltAttrColE(const TStr& attr) {
+  IAssertR(KeyToIndexTypeE.IsKey(attr) && KeyToIndexTypeE.GetDat(attr).Val1 == FltType, TStr::Fmt("%s is not a flt edge attribute", attr.CStr()));
+  return TFltAttrCol(&VecOfFltVecsE, KeyToIndexTypeE.GetDat(attr).Val2, false, this);
+}
+
+void TNEANet::GetStrAttrDictN(const TStr& attr, TStrV& DictV, TIntV& CodeV) const {
+  IAssertR(KeyToIndexTypeN.IsKey(attr) && KeyToIndexTypeN.GetDat(attr).Val1 == StrType, TStr::Fmt("%s is not a str node attribute", attr.CStr()));
+  const TStrV& ColV = VecOfStrVecsN[KeyToIndexTypeN.GetDat(attr).Val2];
+  TStrIntH DictH;
+  CodeV.Gen(NodeH.Len(), 0);
+  for (int KeyId = NodeH.FFirstKeyId(); NodeH.FNextKeyId(KeyId); ) {
+    CodeV.Add(DictH.AddKey(ColV[KeyId]));
+  }
+  DictH.GetKeyV(DictV);
+}
+
+void TNEANet::GetStrAttrDictE(const TStr& attr, TStrV& DictV, TIntV& CodeV) const {
+  IAssertR(KeyToIndexTypeE.IsKey(attr) && KeyToIndexTypeE.GetDat(attr).Val1 == StrType, TStr::Fmt("%s is not a str edge attribute", attr.CStr()));
+  const TStrV& ColV = VecOfStrVecsE[KeyToIndexTypeE.GetDat(attr).Val2];
+  TStrIntH DictH;
+  CodeV.Gen(EdgeH.Len(), 0);
+  for (int KeyId = EdgeH.FFirstKeyId(); EdgeH.FNextKeyId(KeyId); ) {
+    CodeV.Add(DictH.AddKey(ColV[KeyId]));
+  }
+  DictH.GetKeyV(DictV);
+}
+
 TInt TNEANet::GetIntAttrDatN(const int& NId, const TStr& attr) {
   return VecOfIntVecsN[KeyToIndexTypeN.GetDat(attr).Val2][NodeH.GetKeyId(NId)];
 }
@@ -1829,12 +1948,10 @@ void TNEANet::GetAttrENames(TStrV& IntAttrNames, TStrV& FltAttrNames, TStrV& Str
 }
 
 TFlt TNEANet::GetWeightOutEdges(const TNodeI& NI, const TStr& attr) {
-  TNode Node = GetNode(NI.GetId());
-  TIntV OutEIdV = Node.OutEIdV;
+  const TFltAttrCol WeightCol = GetFltAttrColE(attr);
   TFlt total = 0;
-  int len = Node.OutEIdV.Len();
-  for (int i = 0; i < len; i++) {
-    total += GetFltAttrDatE(Node.OutEIdV[i], attr);
+  for (int i = 0; i < NI.GetOutDeg(); i++) {
+    total += WeightCol.GetDat(NI.GetOutEId(i));
   }
   return total;
 }
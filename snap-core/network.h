@@ -1650,6 +1650,8 @@ public:
     bool operator == (const TNodeI& NodeI) const { return NodeHI == NodeI.NodeHI; }
     /// Returns ID of the current node.
     int GetId() const { return NodeHI.GetDat().GetId(); }
+    /// Returns position of the current node in the node table, used to index attribute columns (see TNEANet::TAttrCol).
+    int GetKeyId() const { return Graph->NodeH.GetKeyId(NodeHI); }
     /// Returns degree of the current node, the sum of in-degree and out-degree.
     int GetDeg() const { return NodeHI.GetDat().GetDeg(); }
     /// Returns in-degree of the current node.
@@ -1719,6 +1721,8 @@ public:
     bool operator == (const TEdgeI& EdgeI) const { return EdgeHI == EdgeI.EdgeHI; }
     /// Returns edge ID.
     int GetId() const { return EdgeHI.GetDat().GetId(); }
+    /// Returns position of the current edge in the edge table, used to index attribute columns (see TNEANet::TAttrCol).
+    int GetKeyId() const { return Graph->EdgeH.GetKeyId(EdgeHI); }
     /// Returns the source of the edge.
     int GetSrcNId() const { return EdgeHI.GetDat().GetSrcNId(); }
     /// Returns the destination of the edge.
@@ -1865,6 +1869,58 @@ public:
     friend class TNEANet;
   };
 
+  /// Handle to the column of an int or flt node/edge attribute. ##TNEANet::TAttrCol
+  template <class TVal>
+  class TAttrCol {
+  private:
+    TVec<TVec<TVal> >* VecOfVecs;
+    int Index;
+    bool IsNode;
+    const TNEANet *Graph;
+  public:
+    TAttrCol() : VecOfVecs(NULL), Index(-1), IsNode(true), Graph(NULL) { }
+    TAttrCol(TVec<TVec<TVal> >* VecOfVecsPt, const int& AttrIndex, const bool& IsNodeAttr, const TNEANet* GraphPt) :
+      VecOfVecs(VecOfVecsPt), Index(AttrIndex), IsNode(IsNodeAttr), Graph(GraphPt) { }
+    TAttrCol(const TAttrCol& Col) : VecOfVecs(Col.VecOfVecs), Index(Col.Index), IsNode(Col.IsNode), Graph(Col.Graph) { }
+    TAttrCol& operator = (const TAttrCol& Col) { VecOfVecs = Col.VecOfVecs; Index = Col.Index; IsNode = Col.IsNode; Graph = Col.Graph; return *this; }
+    /// Tests whether the handle refers to an attribute.
+    bool Empty() const { return VecOfVecs == NULL; }
+    /// Returns the vector of values indexed by node/edge position, see TNodeI::GetKeyId() and TEdgeI::GetKeyId().
+    TVec<TVal>& GetColV() const { return (*VecOfVecs)[Index]; }
+    /// Returns the value at node/edge position KeyId.
+    TVal& operator [] (const int& KeyId) const { return (*VecOfVecs)[Index][KeyId]; }
+    /// Returns the position of the node/edge with ID Id.
+    int GetKeyId(const int& Id) const { return IsNode ? Graph->NodeH.GetKeyId(Id) : Graph->EdgeH.GetKeyId(Id); }
+    /// Returns the value of the node/edge with ID Id.
+    TVal& GetDat(const int& Id) const { return (*VecOfVecs)[Index][GetKeyId(Id)]; }
+    /// Copies the values of all nodes/edges to ValV, in the order of BegNI()/BegEI().
+    void GetV(TVec<TVal>& ValV) const {
+      const TVec<TVal>& ColV = GetColV();
+      if (IsNode) {
+        ValV.Gen(Graph->NodeH.Len(), 0);
+        for (int KeyId = Graph->NodeH.FFirstKeyId(); Graph->NodeH.FNextKeyId(KeyId); ) { ValV.Add(ColV[KeyId]); }
+      } else {
+        ValV.Gen(Graph->EdgeH.Len(), 0);
+        for (int KeyId = Graph->EdgeH.FFirstKeyId(); Graph->EdgeH.FNextKeyId(KeyId); ) { ValV.Add(ColV[KeyId]); }
+      }
+    }
+    /// Sets the values of all nodes/edges from ValV, in the order of BegNI()/BegEI().
+    void SetV(const TVec<TVal>& ValV) const {
+      TVec<TVal>& ColV = GetColV();
+      int ValN = 0;
+      if (IsNode) {
+        IAssertR(ValV.Len() == Graph->NodeH.Len(), "Need one value per node");
+        for (int KeyId = Graph->NodeH.FFirstKeyId(); Graph->NodeH.FNextKeyId(KeyId); ValN++) { ColV[KeyId] = ValV[ValN]; }
+      } else {
+        IAssertR(ValV.Len() == Graph->EdgeH.Len(), "Need one value per edge");
+        for (int KeyId = Graph->EdgeH.FFirstKeyId(); Graph->EdgeH.FNextKeyId(KeyId); ValN++) { ColV[KeyId] = ValV[ValN]; }
+      }
+    }
+    friend class TNEANet;
+  };
+  typedef TAttrCol<TInt> TIntAttrCol;
+  typedef TAttrCol<TFlt> TFltAttrCol;
+
 protected:
   TNode& GetNode(const int& NId) { return NodeH.GetDat(NId); }
   const TNode& GetNode(const int& NId) const { return NodeH.GetDat(NId); }
@@ -2610,6 +2666,8 @@ public:
   int AddEdge(const int& SrcNId, const int& DstNId, int EId  = -1);
   /// Adds an edge between EdgeI.GetSrcNId() and EdgeI.GetDstNId() to the graph.
   int AddEdge(const TEdgeI& EdgeI) { return AddEdge(EdgeI.GetSrcNId(), EdgeI.GetDstNId(), EdgeI.GetId()); }
+  /// Adds edges from node IDs EdgeV[e].Val1 to node IDs EdgeV[e].Val2 to the graph. ##TNEANet::AddEdgeBatch
+  int AddEdgeBatch(const TIntPrV& EdgeV);
   /// Deletes an edge with edge ID EId from the graph.
   void DelEdge(const int& EId);
   /// Deletes all edges between node IDs SrcNId and DstNId from the graph. ##TNEANet::DelEdge
@@ -2901,6 +2959,18 @@ public:
   bool IsStrAttrE(const TStr& attr);
   /// Gets Vector for the Flt Attribute attr.
   TVec<TFlt>& GetFltAttrVecE(const TStr& attr);
+  /// Returns a handle to the column of int node attribute attr. ##TNEANet::GetIntAttrColN
+  TIntAttrCol GetIntAttrColN(const TStr& attr);
+  /// Returns a handle to the column of flt node attribute attr.
+  TFltAttrCol GetFltAttrColN(const TStr& attr);
+  /// Returns a handle to the column of int edge attribute attr.
+  TIntAttrCol GetIntAttrColE(const TStr& attr);
+  /// Returns a handle to the column of flt edge attribute attr.
+  TFltAttrCol GetFltAttrColE(const TStr& attr);
+  /// Dictionary-encodes the values of str node attribute attr. ##TNEANet::GetStrAttrDictN
+  void GetStrAttrDictN(const TStr& attr, TStrV& DictV, TIntV& CodeV) const;
+  /// Dictionary-encodes the values of str edge attribute attr. ##TNEANet::GetStrAttrDictN
+  void GetStrAttrDictE(const TStr& attr, TStrV& DictV, TIntV& CodeV) const;
   /// Gets keyid for edge with id EId.
   int GetFltKeyIdE(const int& EId);
 
@@ -3156,6 +3226,7 @@ public:
 namespace TSnap {
 template <> struct IsMultiGraph<TNEANet> { enum { Val = 1 }; };
 template <> struct IsDirected<TNEANet> { enum { Val = 1 }; };
+template <> struct IsEdgeBatch<TNEANet> { enum { Val = 1 }; };
 }
 
  //#//////////////////////////////////////////////
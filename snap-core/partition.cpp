@@ -0,0 +1,540 @@
+/////////////////////////////////////////////////
+// Graph partitioning
+void TGraphPart::InitPart(const int& _Parts) {
+  IAssertR(_Parts > 0, "The number of partitions must be positive");
+  Parts = _Parts;
+  PartV.Gen(Csr.GetNodes());
+  PartV.PutAll(-1);
+  PartSzV.Gen(Parts);
+}
+
+// Counts the neighbors of NIdx in every partition, nodes not placed yet are skipped.
+void TGraphPart::GetNbrPartCnt(const int& NIdx, TIntV& CntV, TIntV& TouchedV) const {
+  for (int Dir = 0; Dir < (Csr.IsDirected() ? 2 : 1); Dir++) {
+    const TInt* BegN = Dir == 0 ? Csr.BegOut(NIdx) : Csr.BegIn(NIdx);
+    const TInt* EndN = Dir == 0 ? Csr.EndOut(NIdx) : Csr.EndIn(NIdx);
+    for (const TInt* N = BegN; N < EndN; N++) {
+      const int Part = PartV[*N];
+      if (*N == NIdx || Part == -1) { continue; }
+      if (CntV[Part] == 0) { TouchedV.Add(Part); }
+      CntV[Part]++;
+    }
+  }
+}
+
+void TGraphPart::GetNIdPartH(TIntIntH& NIdPartH) const {
+  NIdPartH.Gen(Csr.GetNodes());
+  for (int i = 0; i < Csr.GetNodes(); i++) {
+    NIdPartH.AddDat(Csr.GetNId(i), PartV[i]); }
+}
+
+void TGraphPart::SetNIdPartH(const TIntIntH& NIdPartH) {
+  int MxPart = -1;
+  for (int i = 0; i < Csr.GetNodes(); i++) {
+    IAssertR(NIdPartH.IsKey(Csr.GetNId(i)), TStr::Fmt("Node %d has no partition", Csr.GetNId(i)));
+    MxPart = TMath::Mx(MxPart, NIdPartH.GetDat(Csr.GetNId(i)).Val);
+  }
+  InitPart(TMath::Mx(MxPart+1, 1));
+  for (int i = 0; i < Csr.GetNodes(); i++) {
+    const int Part = NIdPartH.GetDat(Csr.GetNId(i));
+    IAssert(Part >= 0);
+    AddToPart(i, Part);
+  }
+}
+
+// Places every node, in the order of node indices, in the partition with the most
+// neighbors weighted by the free capacity of the partition (Stanton and Kliot, KDD 2012).
+void TGraphPart::PartLdg(const int& _Parts, const double& Slack) {
+  InitPart(_Parts);
+  const int Cap = GetCap(Slack);
+  TIntV CntV(Parts), TouchedV(Parts, 0);
+  for (int NIdx = 0; NIdx < Csr.GetNodes(); NIdx++) {
+    GetNbrPartCnt(NIdx, CntV, TouchedV);
+    int BestPart = -1;
+    double BestScore = -1.0;
+    for (int p = 0; p < Parts; p++) {
+      if (PartSzV[p] >= Cap) { continue; }
+      const double Score = CntV[p] * (1.0 - double(PartSzV[p]) / double(Cap));
+      if (Score > BestScore || (Score == BestScore && PartSzV[p] < PartSzV[BestPart])) {
+        BestPart = p;  BestScore = Score; }
+    }
+    for (int t = 0; t < TouchedV.Len(); t++) { CntV[TouchedV[t]] = 0; }
+    TouchedV.Clr(false);
+    AddToPart(NIdx, BestPart);
+  }
+}
+
+// Places every node in the partition that maximizes the number of neighbors minus
+// the marginal cost Alpha*Gamma*Size^(Gamma-1) (Tsourakakis et al., WSDM 2014).
+void TGraphPart::PartFennel(const int& _Parts, const double& Gamma, const double& Slack) {
+  InitPart(_Parts);
+  const int Cap = GetCap(Slack);
+  const int Nodes = Csr.GetNodes();
+  const double Alpha = Nodes == 0 ? 0.0 : sqrt(double(Parts)) * double(GetEdges()) / pow(double(Nodes), 1.5);
+  TIntV CntV(Parts), TouchedV(Parts, 0);
+  for (int NIdx = 0; NIdx < Nodes; NIdx++) {
+    GetNbrPartCnt(NIdx, CntV, TouchedV);
+    int BestPart = -1;
+    double BestScore = 0.0;
+    for (int p = 0; p < Parts; p++) {
+      if (PartSzV[p] >= Cap) { continue; }
+      const double Score = CntV[p] - Alpha * Gamma * pow(double(PartSzV[p]), Gamma - 1.0);
+      if (BestPart == -1 || Score > BestScore || (Score == BestScore && PartSzV[p] < PartSzV[BestPart])) {
+        BestPart = p;  BestScore = Score; }
+    }
+    for (int t = 0; t < TouchedV.Len(); t++) { CntV[TouchedV[t]] = 0; }
+    TouchedV.Clr(false);
+    AddToPart(NIdx, BestPart);
+  }
+}
+
+// Merges the in- and out-neighbors of every node, an edge in both directions gets weight 2.
+void TGraphPart::GetWgtAdj(TWgtAdj& Adj) const {
+  const int Nodes = Csr.GetNodes();
+  Adj.NWgtV.Gen(Nodes);
+  Adj.NWgtV.PutAll(1);
+  Adj.OffV.Gen(Nodes+1);
+  Adj.NbrV.Gen(Csr.GetOutEdges() + (Csr.IsDirected() ? Csr.GetInEdges() : 0), 0);
+  Adj.EWgtV.Gen(Adj.NbrV.Reserved(), 0);
+  TIntV BufV;
+  for (int NIdx = 0; NIdx < Nodes; NIdx++) {
+    BufV.Clr(false);
+    for (int Dir = 0; Dir < (Csr.IsDirected() ? 2 : 1); Dir++) {
+      const TInt* BegN = Dir == 0 ? Csr.BegOut(NIdx) : Csr.BegIn(NIdx);
+      const TInt* EndN = Dir == 0 ? Csr.EndOut(NIdx) : Csr.EndIn(NIdx);
+      for (const TInt* N = BegN; N < EndN; N++) {
+        if (*N != NIdx) { BufV.Add(*N); } }
+    }
+    BufV.Sort();
+    for (int b = 0; b < BufV.Len(); b++) {
+      if (b > 0 && BufV[b] == BufV[b-1]) { Adj.EWgtV.Last()++; continue; }
+      Adj.NbrV.Add(BufV[b]);  Adj.EWgtV.Add(1);
+    }
+    Adj.OffV[NIdx+1] = Adj.NbrV.Len();
+  }
+}
+
+// Heavy-edge matching: visits the nodes in random order and merges every unmatched node
+// with the unmatched neighbor it shares the heaviest edge with. Returns false if the
+// graph shrinks by less than 5%.
+bool TGraphPart::Coarsen(const TWgtAdj& Adj, const int& MxNWgt, TRnd& Rnd, TWgtAdj& CoarseAdj, TIntV& CoarseV) {
+  const int Nodes = Adj.GetNodes();
+  TIntV OrderV(Nodes);
+  for (int u = 0; u < Nodes; u++) { OrderV[u] = u; }
+  OrderV.Shuffle(Rnd);
+  TIntV MatchV(Nodes);
+  MatchV.PutAll(-1);
+  for (int o = 0; o < Nodes; o++) {
+    const int U = OrderV[o];
+    if (MatchV[U] != -1) { continue; }
+    int Best = -1, BestWgt = 0;
+    for (int e = Adj.OffV[U]; e < Adj.OffV[U+1]; e++) {
+      const int V = Adj.NbrV[e];
+      if (MatchV[V] == -1 && Adj.EWgtV[e] > BestWgt && Adj.NWgtV[U] + Adj.NWgtV[V] <= MxNWgt) {
+        Best = V;  BestWgt = Adj.EWgtV[e]; }
+    }
+    if (Best == -1) { MatchV[U] = U; }
+    else { MatchV[U] = Best;  MatchV[Best] = U; }
+  }
+  CoarseV.Gen(Nodes);
+  CoarseV.PutAll(-1);
+  TIntV MembV(Nodes, 0);   // first fine node of every coarse node
+  for (int u = 0; u < Nodes; u++) {
+    if (CoarseV[u] != -1) { continue; }
+    CoarseV[u] = MembV.Len();  CoarseV[MatchV[u]] = MembV.Len();
+    MembV.Add(u);
+  }
+  const int CoarseNodes = MembV.Len();
+  if (20.0 * CoarseNodes > 19.0 * Nodes) { return false; }
+  CoarseAdj.NWgtV.Gen(CoarseNodes);
+  CoarseAdj.OffV.Gen(CoarseNodes+1);
+  CoarseAdj.NbrV.Gen(Adj.NbrV.Len(), 0);
+  CoarseAdj.EWgtV.Gen(Adj.NbrV.Len(), 0);
+  TIntV PosV(CoarseNodes);
+  PosV.PutAll(-1);
+  for (int c = 0; c < CoarseNodes; c++) {
+    const int Beg = CoarseAdj.NbrV.Len();
+    const int U1 = MembV[c], U2 = MatchV[U1];
+    for (int m = 0; m < (U1 == U2 ? 1 : 2); m++) {
+      const int U = m == 0 ? U1 : U2;
+      CoarseAdj.NWgtV[c] += Adj.NWgtV[U];
+      for (int e = Adj.OffV[U]; e < Adj.OffV[U+1]; e++) {
+        const int CV = CoarseV[Adj.NbrV[e]];
+        if (CV == c) { continue; }
+        if (PosV[CV] == -1) {
+          PosV[CV] = CoarseAdj.NbrV.Add(CV);
+          CoarseAdj.EWgtV.Add(Adj.EWgtV[e]);
+        } else {
+          CoarseAdj.EWgtV[PosV[CV]] += Adj.EWgtV[e]; }
+      }
+    }
+    for (int e = Beg; e < CoarseAdj.NbrV.Len(); e++) { PosV[CoarseAdj.NbrV[e]] = -1; }
+    CoarseAdj.OffV[c+1] = CoarseAdj.NbrV.Len();
+  }
+  return true;
+}
+
+// Graph growing: visits the nodes in breadth first order from random start nodes
+// and fills the partitions one after another up to an equal share of the node weight.
+void TGraphPart::PartWgtAdj(const TWgtAdj& Adj, const int& Parts, const int& Cap, TRnd& Rnd, TIntV& APartV) {
+  const int Nodes = Adj.GetNodes();
+  TIntV StartV(Nodes), OrderV(Nodes, 0);
+  for (int u = 0; u < Nodes; u++) { StartV[u] = u; }
+  StartV.Shuffle(Rnd);
+  TIntV VisitedV(Nodes);
+  for (int s = 0; s < Nodes; s++) {
+    if (VisitedV[StartV[s]] != 0) { continue; }
+    int Head = OrderV.Len();
+    OrderV.Add(StartV[s]);  VisitedV[StartV[s]] = 1;
+    for ( ; Head < OrderV.Len(); Head++) {
+      const int U = OrderV[Head];
+      for (int e = Adj.OffV[U]; e < Adj.OffV[U+1]; e++) {
+        const int V = Adj.NbrV[e];
+        if (VisitedV[V] == 0) { VisitedV[V] = 1;  OrderV.Add(V); }
+      }
+    }
+  }
+  int64 TotalWgt = 0;
+  for (int u = 0; u < Nodes; u++) { TotalWgt += Adj.NWgtV[u]; }
+  APartV.Gen(Nodes);
+  int64 CumWgt = 0;
+  int Part = 0;
+  for (int o = 0; o < Nodes; o++) {
+    while (Part < Parts-1 && CumWgt * Parts >= (Part+1) * TotalWgt) { Part++; }
+    APartV[OrderV[o]] = Part;
+    CumWgt += Adj.NWgtV[OrderV[o]];
+  }
+}
+
+// Greedy boundary refinement: moves a node to the neighboring partition that lowers the
+// cut the most and has room for it. Moves that keep the cut are made if they improve the
+// balance, nodes of overloaded partitions move even if the cut grows.
+void TGraphPart::Refine(const TWgtAdj& Adj, const int& Parts, const int& Cap, const int& MxPasses, TIntV& APartV) {
+  const int Nodes = Adj.GetNodes();
+  TIntV PartWgtV(Parts), ConnV(Parts), TouchedV(Parts, 0);
+  for (int u = 0; u < Nodes; u++) { PartWgtV[APartV[u]] += Adj.NWgtV[u]; }
+  for (int Pass = 0; Pass < MxPasses; Pass++) {
+    int Moves = 0;
+    for (int U = 0; U < Nodes; U++) {
+      const int Own = APartV[U], NWgt = Adj.NWgtV[U];
+      for (int e = Adj.OffV[U]; e < Adj.OffV[U+1]; e++) {
+        const int Part = APartV[Adj.NbrV[e]];
+        if (ConnV[Part] == 0) { TouchedV.Add(Part); }
+        ConnV[Part] += Adj.EWgtV[e];
+      }
+      const bool Overload = PartWgtV[Own] > Cap;
+      int Best = -1, BestGain = 0;
+      for (int c = 0; c < (Overload ? Parts : TouchedV.Len()); c++) {
+        const int Part = Overload ? c : TouchedV[c].Val;
+        if (Part == Own || PartWgtV[Part] + NWgt > Cap) { continue; }
+        const int Gain = ConnV[Part] - ConnV[Own];
+        const bool Better = Best == -1 ? (Overload || Gain > 0 || (Gain == 0 && PartWgtV[Part] + NWgt < PartWgtV[Own])) :
+          (Gain > BestGain || (Gain == BestGain && PartWgtV[Part] < PartWgtV[Best]));
+        if (Better) { Best = Part;  BestGain = Gain; }
+      }
+      for (int t = 0; t < TouchedV.Len(); t++) { ConnV[TouchedV[t]] = 0; }
+      TouchedV.Clr(false);
+      if (Best != -1) {
+        APartV[U] = Best;
+        PartWgtV[Own] -= NWgt;  PartWgtV[Best] += NWgt;
+        Moves++;
+      }
+    }
+    if (Moves == 0) { break; }
+  }
+}
+
+// Coarsens the graph down to about 20 nodes per partition, partitions the coarsest graph
+// from several random starts, then projects the best partition back level by level
+// and refines it on every level (Karypis and Kumar, METIS).
+void TGraphPart::PartMultilevel(const int& _Parts, const double& Slack, const int& Seed) {
+  InitPart(_Parts);
+  const int Nodes = Csr.GetNodes();
+  if (Nodes == 0) { return; }
+  const int MxLevels = 64, Tries = 8, MxPasses = 8;
+  const int Cap = GetCap(Slack);
+  const int CoarseNodes = TMath::Mx(20 * Parts(), 100);
+  const int MxNWgt = TMath::Mx(1, int(1.5 * Nodes / CoarseNodes));
+  TRnd Rnd(Seed);
+  // no reallocation while coarsening, the last level is read while the next one is built
+  TVec<TWgtAdj> AdjV(MxLevels, 0);
+  TVec<TIntV> CoarseVV(MxLevels, 0);
+  AdjV.Add();
+  GetWgtAdj(AdjV.Last());
+  while (AdjV.Last().GetNodes() > CoarseNodes && AdjV.Len() < MxLevels) {
+    AdjV.Add();  CoarseVV.Add();
+    if (! Coarsen(AdjV[AdjV.Len()-2], MxNWgt, Rnd, AdjV.Last(), CoarseVV.Last())) {
+      AdjV.DelLast();  CoarseVV.DelLast();  break; }
+  }
+  const TWgtAdj& Coarsest = AdjV.Last();
+  TIntV APartV, TryPartV;
+  int64 BestCut = -1;
+  for (int t = 0; t < Tries; t++) {
+    PartWgtAdj(Coarsest, Parts, Cap, Rnd, TryPartV);
+    Refine(Coarsest, Parts, Cap, MxPasses, TryPartV);
+    int64 Cut = 0;
+    for (int u = 0; u < Coarsest.GetNodes(); u++) {
+      for (int e = Coarsest.OffV[u]; e < Coarsest.OffV[u+1]; e++) {
+        if (TryPartV[u] != TryPartV[Coarsest.NbrV[e]]) { Cut += Coarsest.EWgtV[e]; } }
+    }
+    if (BestCut == -1 || Cut < BestCut) { APartV = TryPartV;  BestCut = Cut; }
+  }
+  for (int Level = AdjV.Len()-2; Level >= 0; Level--) {
+    const TIntV& CoarseV = CoarseVV[Level];
+    TIntV FinePartV(CoarseV.Len());
+    for (int u = 0; u < CoarseV.Len(); u++) { FinePartV[u] = APartV[CoarseV[u]]; }
+    Refine(AdjV[Level], Parts, Cap, MxPasses, FinePartV);
+    APartV.MoveFrom(FinePartV);
+  }
+  for (int NIdx = 0; NIdx < Nodes; NIdx++) { AddToPart(NIdx, APartV[NIdx]); }
+}
+
+int64 TGraphPart::GetEdges() const {
+  if (Csr.IsDirected()) { return Csr.GetOutEdges(); }
+  int64 SelfEdges = 0;
+  #pragma omp parallel for schedule(dynamic,10000) reduction(+:SelfEdges)
+  for (int NIdx = 0; NIdx < Csr.GetNodes(); NIdx++) {
+    for (const TInt* N = Csr.BegOut(NIdx); N < Csr.EndOut(NIdx); N++) {
+      if (*N == NIdx) { SelfEdges++; } }
+  }
+  return (Csr.GetOutEdges() + SelfEdges) / 2;
+}
+
+// every cut edge of an undirected graph is stored in both directions
+int64 TGraphPart::GetEdgeCut() const {
+  int64 Cut = 0;
+  #pragma omp parallel for schedule(dynamic,10000) reduction(+:Cut)
+  for (int NIdx = 0; NIdx < Csr.GetNodes(); NIdx++) {
+    for (const TInt* N = Csr.BegOut(NIdx); N < Csr.EndOut(NIdx); N++) {
+      if (PartV[*N] != PartV[NIdx]) { Cut++; } }
+  }
+  return Csr.IsDirected() ? Cut : Cut / 2;
+}
+
+// a node is copied to every other partition that holds one of its neighbors
+double TGraphPart::GetReplicationFactor() const {
+  const int Nodes = Csr.GetNodes();
+  if (Nodes == 0) { return 0.0; }
+  int64 Copies = 0;
+  #pragma omp parallel reduction(+:Copies)
+  {
+    TIntV StampV(Parts);
+    StampV.PutAll(-1);
+    #pragma omp for schedule(dynamic,10000)
+    for (int NIdx = 0; NIdx < Nodes; NIdx++) {
+      StampV[PartV[NIdx]] = NIdx;
+      Copies++;
+      for (int Dir = 0; Dir < (Csr.IsDirected() ? 2 : 1); Dir++) {
+        const TInt* BegN = Dir == 0 ? Csr.BegOut(NIdx) : Csr.BegIn(NIdx);
+        const TInt* EndN = Dir == 0 ? Csr.EndOut(NIdx) : Csr.EndIn(NIdx);
+        for (const TInt* N = BegN; N < EndN; N++) {
+          const int Part = PartV[*N];
+          if (StampV[Part] != NIdx) { StampV[Part] = NIdx;  Copies++; }
+        }
+      }
+    }
+  }
+  return double(Copies) / double(Nodes);
+}
+
+double TGraphPart::GetImbalance() const {
+  if (Csr.GetNodes() == 0) { return 0.0; }
+  int MxPartSz = 0;
+  for (int p = 0; p < Parts; p++) { MxPartSz = TMath::Mx(MxPartSz, PartSzV[p].Val); }
+  return double(MxPartSz) * double(Parts) / double(Csr.GetNodes());
+}
+
+/////////////////////////////////////////////////
+// Partitioned compressed sparse row graph
+// Nodes keep their order within a partition. The adjacency of partition p is built by
+// the thread that processes partition p in every loop with schedule(static,1).
+void TPartCsrGraph::Build(const TCsrGraph& Csr, const TIntV& CsrPartV, const int& _Parts) {
+  IAssertR(_Parts > 0, "The graph is not partitioned");
+  Directed = Csr.IsDirected();
+  Parts = _Parts;
+  const int Nodes = Csr.GetNodes();
+  PartOffV.Gen(Parts+1);
+  for (int i = 0; i < Nodes; i++) { PartOffV[CsrPartV[i]+1]++; }
+  for (int p = 0; p < Parts; p++) { PartOffV[p+1] += PartOffV[p]; }
+  TIntV IdxV(Nodes), CsrIdxV(Nodes), PosV(PartOffV);
+  int MxNId = -1;
+  for (int i = 0; i < Nodes; i++) {
+    IdxV[i] = PosV[CsrPartV[i]];  PosV[CsrPartV[i]]++;
+    CsrIdxV[IdxV[i]] = i;
+    MxNId = TMath::Mx(MxNId, Csr.GetNId(i));
+  }
+  PartV.Gen(Nodes);  NIdV.Gen(Nodes);
+  NIdToIdxV.Gen(MxNId+1);
+  NIdToIdxV.PutAll(-1);
+  for (int NIdx = 0; NIdx < Nodes; NIdx++) {
+    PartV[NIdx] = CsrPartV[CsrIdxV[NIdx]];
+    NIdV[NIdx] = Csr.GetNId(CsrIdxV[NIdx]);
+    NIdToIdxV[NIdV[NIdx]] = NIdx;
+  }
+  const bool DoIn = Directed && Csr.HasIn();
+  IAssertR(! Directed || DoIn, "In-edges of the graph snapshot are required");
+  OutOffVV.Gen(Parts);  OutNbrVV.Gen(Parts);
+  InOffVV.Gen(DoIn ? Parts() : 0);  InNbrVV.Gen(DoIn ? Parts() : 0);
+  #pragma omp parallel for schedule(static,1)
+  for (int p = 0; p < Parts; p++) {
+    const int Beg = PartOffV[p], PartSz = PartOffV[p+1] - PartOffV[p];
+    for (int Dir = 0; Dir < (DoIn ? 2 : 1); Dir++) {
+      TIntV& OffV = Dir == 0 ? OutOffVV[p] : InOffVV[p];
+      TIntV& NbrV = Dir == 0 ? OutNbrVV[p] : InNbrVV[p];
+      OffV.Gen(PartSz+1);
+      for (int l = 0; l < PartSz; l++) {
+        const int CsrIdx = CsrIdxV[Beg+l];
+        OffV[l+1] = OffV[l] + (Dir == 0 ? Csr.GetOutDeg(CsrIdx) : Csr.GetInDeg(CsrIdx)); }
+      NbrV.Gen(OffV[PartSz]);
+      for (int l = 0; l < PartSz; l++) {
+        const int CsrIdx = CsrIdxV[Beg+l];
+        const TInt* BegN = Dir == 0 ? Csr.BegOut(CsrIdx) : Csr.BegIn(CsrIdx);
+        const TInt* EndN = Dir == 0 ? Csr.EndOut(CsrIdx) : Csr.EndIn(CsrIdx);
+        int Pos = OffV[l];
+        for (const TInt* N = BegN; N < EndN; N++, Pos++) { NbrV[Pos] = IdxV[*N]; }
+      }
+    }
+  }
+}
+
+int64 TPartCsrGraph::GetMemUsed() const {
+  int64 MemUsed = sizeof(TPartCsrGraph) + int64(PartOffV.Reserved() + PartV.Reserved() +
+    NIdV.Reserved() + NIdToIdxV.Reserved()) * sizeof(TInt);
+  for (int p = 0; p < OutOffVV.Len(); p++) {
+    MemUsed += int64(OutOffVV[p].Reserved() + OutNbrVV[p].Reserved()) * sizeof(TInt) + 2*sizeof(TIntV); }
+  for (int p = 0; p < InOffVV.Len(); p++) {
+    MemUsed += int64(InOffVV[p].Reserved() + InNbrVV[p].Reserved()) * sizeof(TInt) + 2*sizeof(TIntV); }
+  return MemUsed;
+}
+
+namespace TSnap {
+
+#ifdef USE_OPENMP
+// Same iteration as GetPageRankMP(Graph, PRankH), Berkhin's version. Node ranks are kept
+// per partition and only the thread of a partition writes them.
+void GetPageRankMP(const TPartCsrGraph& Graph, TIntFltH& PRankH, const double& C, const double& Eps, const int& MaxIter) {
+  const int Parts = Graph.GetParts();
+  const int NNodes = Graph.GetNodes();
+  TVec<TFltV> RankVV, ContribVV, TmpVV;
+  Graph.GenPartValV(RankVV);
+  Graph.GenPartValV(ContribVV);
+  Graph.GenPartValV(TmpVV);
+  #pragma omp parallel for schedule(static,1)
+  for (int p = 0; p < Parts; p++) { RankVV[p].PutAll(1.0/NNodes); }
+
+  for (int iter = 0; iter < MaxIter; iter++) {
+    #pragma omp parallel for schedule(static,1)
+    for (int p = 0; p < Parts; p++) {
+      const int Beg = Graph.GetPartBeg(p);
+      for (int l = 0; l < RankVV[p].Len(); l++) {
+        const int OutDeg = Graph.GetOutDeg(Beg+l);
+        ContribVV[p][l] = OutDeg > 0 ? RankVV[p][l] / OutDeg : 0.0;
+      }
+    }
+    double sum = 0;
+    #pragma omp parallel for schedule(static,1) reduction(+:sum)
+    for (int p = 0; p < Parts; p++) {
+      const int Beg = Graph.GetPartBeg(p);
+      for (int l = 0; l < TmpVV[p].Len(); l++) {
+        TFlt Tmp = 0;
+        for (const TInt* N = Graph.BegIn(Beg+l); N < Graph.EndIn(Beg+l); N++) {
+          Tmp += ContribVV[Graph.GetPart(*N)][Graph.GetLocIdx(*N)]; }
+        TmpVV[p][l] = C*Tmp; // Berkhin (the correct way of doing it)
+        sum += TmpVV[p][l];
+      }
+    }
+    const double Leaked = (1.0-sum) / double(NNodes);
+
+    double diff = 0;
+    #pragma omp parallel for schedule(static,1) reduction(+:diff)
+    for (int p = 0; p < Parts; p++) {
+      for (int l = 0; l < RankVV[p].Len(); l++) {
+        const double NewVal = TmpVV[p][l] + Leaked; // Berkhin
+        diff += fabs(NewVal-RankVV[p][l]);
+        RankVV[p][l] = NewVal;
+      }
+    }
+    if (diff < Eps) { break; }
+  }
+
+  PRankH.Gen(NNodes);
+  for (int NIdx = 0; NIdx < NNodes; NIdx++) {
+    PRankH.AddDat(Graph.GetNId(NIdx), RankVV[Graph.GetPart(NIdx)][Graph.GetLocIdx(NIdx)]); }
+}
+
+// Every thread expands the frontier of its partitions. Nodes of other partitions are
+// sent to their partition, whose thread sets their distance in the second phase,
+// so distances are written only by the thread of their partition and without atomics.
+int GetShortestDistancesMP2(const TPartCsrGraph& Graph, const int& StartNId, const bool& FollowOut, const bool& FollowIn, TIntV& ShortestDists) {
+  const int NonNodeDepth = 2147483647; // INT_MAX
+  const int InfDepth = 2147483646; // INT_MAX - 1
+  const int Parts = Graph.GetParts();
+  const int StartNIdx = Graph.GetNIdx(StartNId);
+  IAssertR(StartNIdx != -1, TStr::Fmt("Node %d does not exist", StartNId));
+  // in-neighbors of undirected graphs are the out-neighbors
+  const bool DoIn = FollowIn && (Graph.IsDirected() || ! FollowOut);
+  TVec<TIntV> DistVV, CurVV, NextVV;
+  TVec<TVec<TIntV> > BoxVV;    // BoxVV[p][q]: nodes of partition q reached from partition p
+  Graph.GenPartValV(DistVV);
+  CurVV.Gen(Parts);  NextVV.Gen(Parts);  BoxVV.Gen(Parts);
+  #pragma omp parallel for schedule(static,1)
+  for (int p = 0; p < Parts; p++) {
+    DistVV[p].PutAll(InfDepth);
+    BoxVV[p].Gen(Parts);
+  }
+  DistVV[Graph.GetPart(StartNIdx)][Graph.GetLocIdx(StartNIdx)] = 0;
+  CurVV[Graph.GetPart(StartNIdx)].Add(StartNIdx);
+
+  int Depth = 0; // current depth
+  int Frontier = 1;
+  while (Frontier > 0) {
+    Depth++; // increase depth
+    #pragma omp parallel for schedule(static,1)
+    for (int p = 0; p < Parts; p++) {
+      const int Beg = Graph.GetPartBeg(p);
+      TIntV& NextV = NextVV[p];
+      NextV.Reduce(0);
+      for (int q = 0; q < Parts; q++) { BoxVV[p][q].Reduce(0); }
+      for (int i = 0; i < CurVV[p].Len(); i++) {
+        const int NIdx = CurVV[p][i];
+        for (int Dir = 0; Dir < 2; Dir++) {
+          if ((Dir == 0 && ! FollowOut) || (Dir == 1 && ! DoIn)) { continue; }
+          const TInt* BegN = Dir == 0 ? Graph.BegOut(NIdx) : Graph.BegIn(NIdx);
+          const TInt* EndN = Dir == 0 ? Graph.EndOut(NIdx) : Graph.EndIn(NIdx);
+          for (const TInt* N = BegN; N < EndN; N++) {
+            if (Graph.GetPart(*N) != p) { BoxVV[p][Graph.GetPart(*N)].Add(*N);  continue; }
+            TInt& Dist = DistVV[p][*N - Beg];
+            if (Dist == InfDepth) { Dist = Depth;  NextV.Add(*N); }
+          }
+        }
+      }
+    }
+    Frontier = 0;
+    #pragma omp parallel for schedule(static,1) reduction(+:Frontier)
+    for (int q = 0; q < Parts; q++) {
+      const int Beg = Graph.GetPartBeg(q);
+      for (int p = 0; p < Parts; p++) {
+        const TIntV& BoxV = BoxVV[p][q];
+        for (int i = 0; i < BoxV.Len(); i++) {
+          TInt& Dist = DistVV[q][BoxV[i] - Beg];
+          if (Dist == InfDepth) { Dist = Depth;  NextVV[q].Add(BoxV[i]); }
+        }
+      }
+      Frontier += NextVV[q].Len();
+    }
+    // swap the frontiers, the vectors of every partition stay with its thread
+    CurVV.Swap(NextVV);
+  }
+
+  ShortestDists.Gen(Graph.GetMxNId());
+  ShortestDists.PutAll(NonNodeDepth);
+  #pragma omp parallel for schedule(static,1)
+  for (int p = 0; p < Parts; p++) {
+    const int Beg = Graph.GetPartBeg(p);
+    for (int l = 0; l < DistVV[p].Len(); l++) { ShortestDists[Graph.GetNId(Beg+l)] = DistVV[p][l]; }
+  }
+  return Depth-1;
+}
+#endif // USE_OPENMP
+
+} // namespace TSnap
@@ -0,0 +1,178 @@
+//#//////////////////////////////////////////////
+/// Partition of the nodes of a graph into k parts. ##TGraphPart
+class TGraphPart {
+private:
+  // Symmetric weighted adjacency used by the multilevel partitioner
+  class TWgtAdj {
+  public:
+    TIntV OffV;        // neighbors of node i are NbrV[OffV[i]..OffV[i+1])
+    TIntV NbrV;
+    TIntV EWgtV;       // weight of the edge at the same position in NbrV
+    TIntV NWgtV;       // node weights
+  public:
+    TWgtAdj() : OffV(), NbrV(), EWgtV(), NWgtV() { }
+    int GetNodes() const { return NWgtV.Len(); }
+  };
+private:
+  TCsrGraph Csr;
+  TInt Parts;
+  TIntV PartV;         // partition by node index of Csr
+  TIntV PartSzV;       // number of nodes in each partition
+private:
+  void InitPart(const int& _Parts);
+  void AddToPart(const int& NIdx, const int& Part) { PartV[NIdx] = Part;  PartSzV[Part]++; }
+  int GetCap(const double& Slack) const { return (int) ceil((1.0 + Slack) * double(Csr.GetNodes()) / double(Parts)); }
+  void GetNbrPartCnt(const int& NIdx, TIntV& CntV, TIntV& TouchedV) const;
+  void GetWgtAdj(TWgtAdj& Adj) const;
+  static bool Coarsen(const TWgtAdj& Adj, const int& MxNWgt, TRnd& Rnd, TWgtAdj& CoarseAdj, TIntV& CoarseV);
+  static void PartWgtAdj(const TWgtAdj& Adj, const int& Parts, const int& Cap, TRnd& Rnd, TIntV& APartV);
+  static void Refine(const TWgtAdj& Adj, const int& Parts, const int& Cap, const int& MxPasses, TIntV& APartV);
+public:
+  TGraphPart() : Csr(), Parts(0), PartV(), PartSzV() { }
+  /// Takes a snapshot of Graph to be partitioned, edge directions are ignored.
+  template <class PGraph> TGraphPart(const PGraph& Graph) : Csr(Graph, true), Parts(0), PartV(), PartSzV() { }
+
+  /// Returns the graph snapshot, partitions are indexed by its node indices.
+  const TCsrGraph& GetCsr() const { return Csr; }
+  /// Returns the number of partitions, 0 before the graph is partitioned.
+  int GetParts() const { return Parts; }
+  /// Returns the partition of node NId.
+  int GetPart(const int& NId) const { return PartV[Csr.GetNIdx(NId)]; }
+  /// Returns the partitions indexed by node index of GetCsr().
+  const TIntV& GetPartV() const { return PartV; }
+  /// Returns the number of nodes in partition Part.
+  int GetPartSz(const int& Part) const { return PartSzV[Part]; }
+  /// Returns the partition map, node id -> partition.
+  void GetNIdPartH(TIntIntH& NIdPartH) const;
+  /// Sets the partitions from the map NIdPartH, every node must be in it.
+  void SetNIdPartH(const TIntIntH& NIdPartH);
+
+  /// Linear deterministic greedy streaming partitioner. ##TGraphPart::PartLdg
+  void PartLdg(const int& _Parts, const double& Slack=0.05);
+  /// Fennel streaming partitioner. ##TGraphPart::PartFennel
+  void PartFennel(const int& _Parts, const double& Gamma=1.5, const double& Slack=0.05);
+  /// Multilevel partitioner: coarsening by heavy-edge matching, partitioning of the coarsest graph and refinement. ##TGraphPart::PartMultilevel
+  void PartMultilevel(const int& _Parts, const double& Slack=0.05, const int& Seed=1);
+
+  /// Returns the number of edges, an edge between two nodes in both directions counts twice in directed graphs.
+  int64 GetEdges() const;
+  /// Returns the number of edges between nodes in different partitions.
+  int64 GetEdgeCut() const;
+  /// Returns the fraction of edges between nodes in different partitions.
+  double GetEdgeCutFrac() const { const int64 Edges = GetEdges();  return Edges == 0 ? 0.0 : double(GetEdgeCut()) / double(Edges); }
+  /// Returns the average number of partitions that hold a node or a copy of it. ##TGraphPart::GetReplicationFactor
+  double GetReplicationFactor() const;
+  /// Returns the size of the largest partition divided by the average partition size.
+  double GetImbalance() const;
+};
+
+//#//////////////////////////////////////////////
+/// Graph snapshot split into one compressed sparse row graph per partition. ##TPartCsrGraph
+class TPartCsrGraph {
+private:
+  TBool Directed;
+  TInt Parts;
+  TIntV PartOffV;      // nodes of partition p have indices PartOffV[p]..PartOffV[p+1]-1
+  TIntV PartV;         // node index -> partition
+  TIntV NIdV;          // node index -> node id
+  TIntV NIdToIdxV;     // node id -> node index, -1 for non-existing ids
+  TVec<TIntV> OutOffVV, OutNbrVV;  // adjacency of each partition, indexed by the local index
+  TVec<TIntV> InOffVV, InNbrVV;    // in-neighbors, only for directed graphs
+private:
+  void Build(const TCsrGraph& Csr, const TIntV& CsrPartV, const int& _Parts);
+public:
+  TPartCsrGraph() : Directed(false), Parts(0), PartOffV(), PartV(), NIdV(), NIdToIdxV(),
+    OutOffVV(), OutNbrVV(), InOffVV(), InNbrVV() { }
+  /// Builds the partitioned snapshot of a partitioned graph. ##TPartCsrGraph::TPartCsrGraph
+  TPartCsrGraph(const TGraphPart& Part) { Build(Part.GetCsr(), Part.GetPartV(), Part.GetParts()); }
+  /// Builds the partitioned snapshot of Graph with the partition map NIdPartH, every node must be in it.
+  template <class PGraph> TPartCsrGraph(const PGraph& Graph, const TIntIntH& NIdPartH);
+
+  /// Returns true if the snapshot was taken from a directed graph.
+  bool IsDirected() const { return Directed; }
+  /// Returns the number of partitions.
+  int GetParts() const { return Parts; }
+  /// Returns the number of nodes.
+  int GetNodes() const { return NIdV.Len(); }
+  /// Returns the index of the first node of partition Part.
+  int GetPartBeg(const int& Part) const { return PartOffV[Part]; }
+  /// Returns the index after the last node of partition Part.
+  int GetPartEnd(const int& Part) const { return PartOffV[Part+1]; }
+  /// Returns the number of nodes in partition Part.
+  int GetPartSz(const int& Part) const { return PartOffV[Part+1] - PartOffV[Part]; }
+  /// Returns the partition of the node with index NIdx.
+  int GetPart(const int& NIdx) const { return PartV[NIdx]; }
+  /// Returns the index of the node with index NIdx within its partition.
+  int GetLocIdx(const int& NIdx) const { return NIdx - PartOffV[PartV[NIdx]]; }
+  /// Returns the node id of the node with index NIdx.
+  int GetNId(const int& NIdx) const { return NIdV[NIdx]; }
+  /// Returns the index of node NId or -1 if NId is not a node.
+  int GetNIdx(const int& NId) const { return NId >= 0 && NId < NIdToIdxV.Len() ? NIdToIdxV[NId].Val : -1; }
+  /// Returns the largest node id + 1.
+  int GetMxNId() const { return NIdToIdxV.Len(); }
+
+  int GetOutDeg(const int& NIdx) const { const int P = PartV[NIdx], L = NIdx - PartOffV[P];  return OutOffVV[P][L+1] - OutOffVV[P][L]; }
+  /// Returns a pointer to the first out-neighbor of the node with index NIdx, neighbors are node indices.
+  const TInt* BegOut(const int& NIdx) const { const int P = PartV[NIdx];  return OutNbrVV[P].BegI() + OutOffVV[P][NIdx - PartOffV[P]]; }
+  const TInt* EndOut(const int& NIdx) const { const int P = PartV[NIdx];  return OutNbrVV[P].BegI() + OutOffVV[P][NIdx - PartOffV[P] + 1]; }
+  int GetInDeg(const int& NIdx) const { return int(EndIn(NIdx) - BegIn(NIdx)); }
+  /// Returns a pointer to the first in-neighbor of the node with index NIdx.
+  const TInt* BegIn(const int& NIdx) const { if (! Directed) { return BegOut(NIdx); }
+    const int P = PartV[NIdx];  return InNbrVV[P].BegI() + InOffVV[P][NIdx - PartOffV[P]]; }
+  const TInt* EndIn(const int& NIdx) const { if (! Directed) { return EndOut(NIdx); }
+    const int P = PartV[NIdx];  return InNbrVV[P].BegI() + InOffVV[P][NIdx - PartOffV[P] + 1]; }
+
+  /// Allocates a vector of values for every partition on the thread that processes the partition.
+  template <class TVal> void GenPartValV(TVec<TVec<TVal> >& ValVV) const;
+  /// Returns the approximate memory footprint of the snapshot in bytes.
+  int64 GetMemUsed() const;
+};
+
+template <class PGraph>
+TPartCsrGraph::TPartCsrGraph(const PGraph& Graph, const TIntIntH& NIdPartH) {
+  const TCsrGraph Csr(Graph, true);
+  TIntV CsrPartV(Csr.GetNodes());
+  int MxPart = -1;
+  for (int i = 0; i < Csr.GetNodes(); i++) {
+    IAssertR(NIdPartH.IsKey(Csr.GetNId(i)), TStr::Fmt("Node %d has no partition", Csr.GetNId(i)));
+    CsrPartV[i] = NIdPartH.GetDat(Csr.GetNId(i));
+    IAssert(CsrPartV[i] >= 0);
+    MxPart = TMath::Mx(MxPart, CsrPartV[i].Val);
+  }
+  Build(Csr, CsrPartV, MxPart+1);
+}
+
+// partition p is processed by the same thread in every loop with schedule(static,1) over the partitions
+template <class TVal>
+void TPartCsrGraph::GenPartValV(TVec<TVec<TVal> >& ValVV) const {
+  ValVV.Gen(Parts);
+  #pragma omp parallel for schedule(static,1)
+  for (int p = 0; p < Parts; p++) { ValVV[p].Gen(GetPartSz(p)); }
+}
+
+namespace TSnap {
+
+#ifdef USE_OPENMP
+/// Parallel PageRank where every thread processes the nodes of its own partitions. ##TSnap::GetPageRankMP
+void GetPageRankMP(const TPartCsrGraph& Graph, TIntFltH& PRankH, const double& C=0.85, const double& Eps=1e-4, const int& MaxIter=100);
+/// Parallel PageRank over Graph split by the partition map NIdPartH, every node must be in it.
+template <class PGraph> void GetPageRankMP(const PGraph& Graph, TIntFltH& PRankH, const TIntIntH& NIdPartH, const double& C=0.85, const double& Eps=1e-4, const int& MaxIter=100);
+/// Parallel breadth first search where every thread expands the frontier of its own partitions. ##TSnap::GetShortestDistancesMP2
+int GetShortestDistancesMP2(const TPartCsrGraph& Graph, const int& StartNId, const bool& FollowOut, const bool& FollowIn, TIntV& ShortestDists);
+/// Parallel breadth first search over Graph split by the partition map NIdPartH, every node must be in it.
+template <class PGraph> int GetShortestDistancesMP2(const PGraph& Graph, const int& StartNId, const bool& FollowOut, const bool& FollowIn, const TIntIntH& NIdPartH, TIntV& ShortestDists);
+
+template <class PGraph>
+void GetPageRankMP(const PGraph& Graph, TIntFltH& PRankH, const TIntIntH& NIdPartH, const double& C, const double& Eps, const int& MaxIter) {
+  const TPartCsrGraph PartGraph(Graph, NIdPartH);
+  GetPageRankMP(PartGraph, PRankH, C, Eps, MaxIter);
+}
+
+template <class PGraph>
+int GetShortestDistancesMP2(const PGraph& Graph, const int& StartNId, const bool& FollowOut, const bool& FollowIn, const TIntIntH& NIdPartH, TIntV& ShortestDists) {
+  const TPartCsrGraph PartGraph(Graph, NIdPartH);
+  return GetShortestDistancesMP2(PartGraph, StartNId, FollowOut, FollowIn, ShortestDists);
+}
+#endif // USE_OPENMP
+
+} // namespace TSnap
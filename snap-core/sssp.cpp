@@ -0,0 +1,201 @@
+/////////////////////////////////////////////////
+// Indexed binary min-heap
+void TIdxMinHeap::SiftUp(int Pos) {
+  while (Pos > 0) {
+    const int Parent = (Pos-1) / 2;
+    if (PriV[HeapV[Parent]] <= PriV[HeapV[Pos]]) { break; }
+    Swap(Parent, Pos);
+    Pos = Parent;
+  }
+}
+
+void TIdxMinHeap::SiftDown(int Pos) {
+  const int Keys = HeapV.Len();
+  while (true) {
+    const int Left = 2*Pos + 1, Right = Left + 1;
+    int MnPos = Pos;
+    if (Left < Keys && PriV[HeapV[Left]] < PriV[HeapV[MnPos]]) { MnPos = Left; }
+    if (Right < Keys && PriV[HeapV[Right]] < PriV[HeapV[MnPos]]) { MnPos = Right; }
+    if (MnPos == Pos) { break; }
+    Swap(MnPos, Pos);
+    Pos = MnPos;
+  }
+}
+
+void TIdxMinHeap::PushOrDecrease(const int& Key, const double& Pri) {
+  if (PosV[Key] == -1) {
+    PriV[Key] = Pri;
+    PosV[Key] = HeapV.Add(Key);
+    SiftUp(PosV[Key]);
+  } else if (Pri < PriV[Key]) {
+    PriV[Key] = Pri;
+    SiftUp(PosV[Key]);
+  }
+}
+
+int TIdxMinHeap::PopMin() {
+  const int MnKey = HeapV[0];
+  Swap(0, HeapV.Len()-1);
+  HeapV.DelLast();
+  PosV[MnKey] = -1;
+  if (! HeapV.Empty()) { SiftDown(0); }
+  return MnKey;
+}
+
+/////////////////////////////////////////////////
+// Weighted shortest paths
+TWgtShortPath::TWgtShortPath(const PNEANet& Net, const TFltV& EWgtV, const bool& _IsDir) : IsDir(_IsDir) {
+  InitWgt(Net, EWgtV);
+}
+
+TWgtShortPath::TWgtShortPath(const PNEANet& Net, const TStr& EAttr, const bool& _IsDir) : IsDir(_IsDir) {
+  const TNEANet::TFltAttrCol WgtCol = Net->GetFltAttrColE(EAttr);
+  TFltV EWgtV(Net->GetMxEId());
+  for (TNEANet::TEdgeI EI = Net->BegEI(); EI < Net->EndEI(); EI++) {
+    EWgtV[EI.GetId()] = WgtCol[EI.GetKeyId()]; }
+  InitWgt(Net, EWgtV);
+}
+
+void TWgtShortPath::ResetQuery() {
+  if (FullReset) {
+    #pragma omp parallel for schedule(static)
+    for (int i = 0; i < DistV.Len(); i++) { DistV[i] = TFlt::Mx;  ParentV[i] = -1; }
+    FullReset = false;
+  } else {
+    for (int i = 0; i < TouchedV.Len(); i++) {
+      DistV[TouchedV[i]] = TFlt::Mx;  ParentV[TouchedV[i]] = -1; }
+  }
+  TouchedV.Reduce(0);
+  Heap.Clr();
+}
+
+void TWgtShortPath::GetTargets(const TIntV& TargetNIdV, TIntSet& TargetSet) const {
+  TargetSet.Gen(TargetNIdV.Len());
+  for (int t = 0; t < TargetNIdV.Len(); t++) {
+    const int NIdx = Csr.GetNIdx(TargetNIdV[t]);
+    if (NIdx != -1) { TargetSet.AddKey(NIdx); }
+  }
+}
+
+void TWgtShortPath::GetDijkstra(const int& SrcNId, const TIntV& TargetNIdV) {
+  ResetQuery();
+  const int SrcNIdx = Csr.GetNIdx(SrcNId);
+  IAssertR(SrcNIdx != -1, "Source must be a node of the network");
+  TIntSet TargetSet;
+  GetTargets(TargetNIdV, TargetSet);
+  int TargetsLeft = TargetSet.Len();
+  const TZeroHeuristic NoHeuristic;
+  Touch(SrcNIdx, 0, -1);
+  Heap.PushOrDecrease(SrcNIdx, 0);
+  while (! Heap.Empty()) {
+    const int U = Heap.PopMin();
+    if (TargetsLeft > 0 && TargetSet.IsKey(U) && --TargetsLeft == 0) { Heap.Clr();  return; }
+    RelaxNbrs(U, -1, NoHeuristic);
+  }
+}
+
+#ifdef USE_OPENMP
+// Lowers Dist to NewDist if it is smaller, returns true if Dist was changed.
+// Distances are non-negative, so the update is a plain CAS loop on the bits.
+static bool UpdateMnDistMP(TFlt& Dist, const double& NewDist) {
+  union { double Flt; int64 Bits; } OldVal, NewVal;
+  NewVal.Flt = NewDist;
+  OldVal.Flt = Dist.Val;
+  while (NewDist < OldVal.Flt) {
+    if (__sync_bool_compare_and_swap((int64*) &Dist.Val, OldVal.Bits, NewVal.Bits)) { return true; }
+    OldVal.Flt = Dist.Val;
+  }
+  return false;
+}
+
+// U. Meyer, P. Sanders: Delta-stepping: a parallelizable shortest path algorithm, J. Algorithms 2003.
+// Bucket layout follows the GAP benchmark suite: every thread keeps its own
+// bins and the next non-empty bin is collected into a shared frontier.
+void TWgtShortPath::GetDeltaStepping(const int& SrcNId, double Delta, const TIntV& TargetNIdV) {
+  ResetQuery();
+  FullReset = true;
+  const int SrcNIdx = Csr.GetNIdx(SrcNId);
+  IAssertR(SrcNIdx != -1, "Source must be a node of the network");
+  if (Delta <= 0) {
+    double WgtSum = 0;
+    #pragma omp parallel for reduction(+:WgtSum) schedule(static)
+    for (int e = 0; e < OutWgtV.Len(); e++) { WgtSum += OutWgtV[e]; }
+    Delta = OutWgtV.Empty() ? 0 : WgtSum / OutWgtV.Len();
+    if (Delta <= 0) { Delta = 1.0; }
+  }
+  TIntSet TargetSet;
+  GetTargets(TargetNIdV, TargetSet);
+  const bool UseIn = ! InWgtV.Empty();
+  TVec<TVec<TIntV> > BinsVV(omp_get_max_threads());
+  TIntV FrontierV;
+  DistV[SrcNIdx] = 0;
+  FrontierV.Add(SrcNIdx);
+  int CurBin = 0;
+  while (true) {
+    #pragma omp parallel
+    {
+      TVec<TIntV>& BinsV = BinsVV[omp_get_thread_num()];
+      #pragma omp for schedule(dynamic,64)
+      for (int k = 0; k < FrontierV.Len(); k++) {
+        const int U = FrontierV[k];
+        const double DistU = DistV[U];
+        if (DistU < Delta * CurBin) { continue; } // stale entry, already settled in an earlier bin
+        for (int Dir = 0; Dir < (UseIn ? 2 : 1); Dir++) {
+          const TInt* BegN = Dir == 0 ? Csr.BegOut(U) : Csr.BegIn(U);
+          const TInt* EndN = Dir == 0 ? Csr.EndOut(U) : Csr.EndIn(U);
+          const TFlt* WgtI = Dir == 0 ? OutWgtV.BegI() + Csr.GetOutOff(U) : InWgtV.BegI() + Csr.GetInOff(U);
+          for (const TInt* N = BegN; N < EndN; N++, WgtI++) {
+            const double NewDist = DistU + *WgtI;
+            if (UpdateMnDistMP(DistV[*N], NewDist)) {
+              const int Bin = int(NewDist / Delta);
+              while (BinsV.Len() <= Bin) { BinsV.Add(); }
+              BinsV[Bin].Add(*N);
+            }
+          }
+        }
+      }
+    }
+    // the lowest non-empty bin over all threads
+    int NextBin = TInt::Mx;
+    for (int t = 0; t < BinsVV.Len(); t++) {
+      for (int b = CurBin; b < TMath::Mn(BinsVV[t].Len(), NextBin); b++) {
+        if (! BinsVV[t][b].Empty()) { NextBin = b;  break; }
+      }
+    }
+    if (NextBin == TInt::Mx) { break; }
+    if (! TargetSet.Empty()) { // all distances below NextBin*Delta are final
+      bool TargetsDone = true;
+      for (int t = 0; t < TargetSet.Len() && TargetsDone; t++) {
+        TargetsDone = DistV[TargetSet.GetKey(t)] < Delta * NextBin; }
+      if (TargetsDone) { break; }
+    }
+    FrontierV.Clr(false);
+    for (int t = 0; t < BinsVV.Len(); t++) {
+      if (NextBin < BinsVV[t].Len()) {
+        FrontierV.AddV(BinsVV[t][NextBin]);  BinsVV[t][NextBin].Clr(false); }
+    }
+    CurBin = NextBin;
+  }
+}
+#endif // USE_OPENMP
+
+void TWgtShortPath::GetNIdDistH(TIntFltH& NIdDistH) const {
+  NIdDistH.Clr(false);
+  if (FullReset) {
+    for (int i = 0; i < DistV.Len(); i++) {
+      if (DistV[i] != TFlt::Mx) { NIdDistH.AddDat(Csr.GetNId(i), DistV[i]); }
+    }
+  } else {
+    for (int i = 0; i < TouchedV.Len(); i++) {
+      NIdDistH.AddDat(Csr.GetNId(TouchedV[i]), DistV[TouchedV[i]]); }
+  }
+}
+
+void TWgtShortPath::GetPath(const int& DstNId, TIntV& PathNIdV) const {
+  IAssertR(! FullReset, "Shortest path tree is only kept by GetDijkstra() and GetAStar()");
+  PathNIdV.Clr();
+  if (! IsReached(DstNId)) { return; }
+  for (int NIdx = Csr.GetNIdx(DstNId); NIdx != -1; NIdx = ParentV[NIdx]) {
+    PathNIdV.Add(Csr.GetNId(NIdx)); }
+  PathNIdV.Reverse();
+}
@@ -0,0 +1,155 @@
+//#//////////////////////////////////////////////
+/// Indexed binary min-heap over dense keys 0..N-1 with decrease-key. ##TIdxMinHeap
+class TIdxMinHeap {
+private:
+  TIntV HeapV;   // heap of keys
+  TIntV PosV;    // key -> position in HeapV, -1 if the key is not in the heap
+  TFltV PriV;    // key -> priority
+private:
+  void SiftUp(int Pos);
+  void SiftDown(int Pos);
+  void Swap(const int& Pos1, const int& Pos2) {
+    const int Key1 = HeapV[Pos1], Key2 = HeapV[Pos2];
+    HeapV[Pos1] = Key2;  PosV[Key2] = Pos1;
+    HeapV[Pos2] = Key1;  PosV[Key1] = Pos2; }
+public:
+  TIdxMinHeap() : HeapV(), PosV(), PriV() { }
+  TIdxMinHeap(const int& Keys) : HeapV(), PosV(), PriV() { Gen(Keys); }
+  /// Resizes the heap to keys 0..Keys-1 and empties it.
+  void Gen(const int& Keys) { HeapV.Gen(Keys, 0);  PosV.Gen(Keys);  PosV.PutAll(-1);  PriV.Gen(Keys); }
+  int Len() const { return HeapV.Len(); }
+  bool Empty() const { return HeapV.Empty(); }
+  bool IsKey(const int& Key) const { return PosV[Key] != -1; }
+  /// Inserts Key or lowers its priority if Key is already in the heap with a higher one.
+  void PushOrDecrease(const int& Key, const double& Pri);
+  /// Returns the key with the smallest priority.
+  int GetMinKey() const { return HeapV[0]; }
+  double GetMinPri() const { return PriV[HeapV[0]]; }
+  /// Removes and returns the key with the smallest priority.
+  int PopMin();
+  /// Empties the heap, cost proportional to the number of keys in it.
+  void Clr() { for (int i = 0; i < HeapV.Len(); i++) { PosV[HeapV[i]] = -1; }  HeapV.Reduce(0); }
+};
+
+/// Returns 0, the trivial A* heuristic which turns A* into Dijkstra's algorithm.
+class TZeroHeuristic {
+public:
+  double operator () (const int& NId, const int& DstNId) const { return 0.0; }
+};
+
+//#//////////////////////////////////////////////
+/// Weighted shortest paths on a flattened network. ##TWgtShortPath
+/// The network is copied once into a TCsrGraph with edge weights stored next to
+/// the adjacency, then any number of queries can be run: Dijkstra with an
+/// indexed binary heap, parallel delta-stepping, and A* with a user heuristic.
+/// All of them support stopping early once a set of target nodes is settled.
+/// Weights must be non-negative. Results of the last query are read with
+/// GetDist(), GetNIdDistH() and GetPath().
+class TWgtShortPath {
+private:
+  TBool IsDir;
+  TCsrGraph Csr;
+  TFltV OutWgtV;     // weight of the out-edge at the same position in the CSR
+  TFltV InWgtV;      // weights of in-edges, only for undirected queries on a directed network
+  TFltV DistV;       // tentative distance by node index, TFlt::Mx if not reached
+  TIntV ParentV;     // predecessor node index in the shortest path tree
+  TIntV TouchedV;    // node indices reached by the last sequential query
+  TBool FullReset;   // true if the last query did not record TouchedV (and ParentV)
+  TIdxMinHeap Heap;
+private:
+  template <class PNet> void InitWgt(const PNet& Net, const TFltV& EWgtV);
+  void ResetQuery();
+  void Touch(const int& NIdx, const double& Dist, const int& Parent) {
+    if (DistV[NIdx] == TFlt::Mx) { TouchedV.Add(NIdx); }
+    DistV[NIdx] = Dist;  ParentV[NIdx] = Parent; }
+  void GetTargets(const TIntV& TargetNIdV, TIntSet& TargetSet) const;
+  template <class THeuristic> void RelaxNbrs(const int& U, const int& DstNId, const THeuristic& Heuristic);
+public:
+  /// Builds the flattened network, EWgtV holds the weight of every edge indexed by edge id.
+  /// @param IsDir false: ignore edge directions.
+  TWgtShortPath(const PNEANet& Net, const TFltV& EWgtV, const bool& _IsDir=true);
+  /// Builds the flattened network with weights taken from the float edge attribute EAttr.
+  TWgtShortPath(const PNEANet& Net, const TStr& EAttr, const bool& _IsDir=true);
+
+  /// Returns the flattened network.
+  const TCsrGraph& GetCsr() const { return Csr; }
+  /// Dijkstra's algorithm from SrcNId. If TargetNIdV is not empty, stops once all targets are settled. ##TWgtShortPath::GetDijkstra
+  void GetDijkstra(const int& SrcNId, const TIntV& TargetNIdV=TIntV());
+  /// A* search from SrcNId to DstNId, returns the distance or -1 if DstNId is not reachable. ##TWgtShortPath::GetAStar
+  /// Heuristic(NId, DstNId) must return a lower bound on the distance between the two nodes.
+  template <class THeuristic> double GetAStar(const int& SrcNId, const int& DstNId, const THeuristic& Heuristic);
+#ifdef USE_OPENMP
+  /// Parallel delta-stepping from SrcNId with bucket width Delta (<=0 picks the mean edge weight). ##TWgtShortPath::GetDeltaStepping
+  /// If TargetNIdV is not empty, stops once all targets are settled. Computes distances only, GetPath() is not available afterwards.
+  void GetDeltaStepping(const int& SrcNId, double Delta=-1, const TIntV& TargetNIdV=TIntV());
+#endif
+
+  /// Returns true if NId was reached by the last query.
+  bool IsReached(const int& NId) const { const int NIdx = Csr.GetNIdx(NId); return NIdx != -1 && DistV[NIdx] != TFlt::Mx; }
+  /// Returns the distance of NId from the source of the last query, TFlt::Mx if it was not reached.
+  double GetDist(const int& NId) const { const int NIdx = Csr.GetNIdx(NId); return NIdx == -1 ? TFlt::Mx : DistV[NIdx].Val; }
+  /// Returns the distances of all nodes reached by the last query.
+  /// After an early stop only the targets and nodes closer than them have final distances.
+  void GetNIdDistH(TIntFltH& NIdDistH) const;
+  /// Returns the nodes on the shortest path from the source of the last query to DstNId, empty if DstNId was not reached.
+  void GetPath(const int& DstNId, TIntV& PathNIdV) const;
+};
+
+template <class PNet>
+void TWgtShortPath::InitWgt(const PNet& Net, const TFltV& EWgtV) {
+  Csr.Build(Net, ! IsDir);
+  const int Nodes = Csr.GetNodes();
+  OutWgtV.Gen(Csr.GetOutEdges());
+  if (Csr.IsDirected() && ! IsDir) { InWgtV.Gen(Csr.GetInEdges()); }
+  #pragma omp parallel for schedule(dynamic,10000)
+  for (int i = 0; i < Nodes; i++) {
+    const typename PNet::TObj::TNodeI NI = Net->GetNI(Csr.GetNId(i));
+    const int OutOff = Csr.GetOutOff(i);
+    for (int e = 0; e < NI.GetOutDeg(); e++) { OutWgtV[OutOff+e] = EWgtV[NI.GetOutEId(e)]; }
+    if (! InWgtV.Empty()) {
+      const int InOff = Csr.GetInOff(i);
+      for (int e = 0; e < NI.GetInDeg(); e++) { InWgtV[InOff+e] = EWgtV[NI.GetInEId(e)]; }
+    }
+  }
+  for (int e = 0; e < OutWgtV.Len(); e++) {
+    IAssertR(OutWgtV[e] >= 0, "Edge weights must be non-negative"); }
+  DistV.Gen(Nodes);  DistV.PutAll(TFlt::Mx);
+  ParentV.Gen(Nodes);  ParentV.PutAll(-1);
+  TouchedV.Gen(Nodes, 0);
+  FullReset = false;
+  Heap.Gen(Nodes);
+}
+
+template <class THeuristic>
+void TWgtShortPath::RelaxNbrs(const int& U, const int& DstNId, const THeuristic& Heuristic) {
+  const double DistU = DistV[U];
+  const bool UseIn = ! InWgtV.Empty();
+  for (int Dir = 0; Dir < (UseIn ? 2 : 1); Dir++) {
+    const TInt* BegN = Dir == 0 ? Csr.BegOut(U) : Csr.BegIn(U);
+    const TInt* EndN = Dir == 0 ? Csr.EndOut(U) : Csr.EndIn(U);
+    const TFlt* WgtI = Dir == 0 ? OutWgtV.BegI() + Csr.GetOutOff(U) : InWgtV.BegI() + Csr.GetInOff(U);
+    for (const TInt* N = BegN; N < EndN; N++, WgtI++) {
+      const int V = *N;
+      const double NewDist = DistU + *WgtI;
+      if (NewDist < DistV[V]) {
+        Touch(V, NewDist, U);
+        Heap.PushOrDecrease(V, NewDist + Heuristic(Csr.GetNId(V), DstNId));
+      }
+    }
+  }
+}
+
+template <class THeuristic>
+double TWgtShortPath::GetAStar(const int& SrcNId, const int& DstNId, const THeuristic& Heuristic) {
+  ResetQuery();
+  const int SrcNIdx = Csr.GetNIdx(SrcNId), DstNIdx = Csr.GetNIdx(DstNId);
+  IAssertR(SrcNIdx != -1 && DstNIdx != -1, "Source and destination must be nodes of the network");
+  Touch(SrcNIdx, 0, -1);
+  Heap.PushOrDecrease(SrcNIdx, Heuristic(SrcNId, DstNId));
+  while (! Heap.Empty()) {
+    const int U = Heap.PopMin();
+    if (U == DstNIdx) { Heap.Clr();  return DistV[U]; }
+    RelaxNbrs(U, DstNId, Heuristic);
+  }
+  return -1;
+}
@@ -10,6 +10,7 @@ PUNGraph GetSubGraph(const PUNGraph& Graph, const TIntV& NIdV, const bool& Renum
   TUNGraph& NewGraph = *NewGraphPt;
   NewGraph.Reserve(NIdV.Len(), -1);
   TIntSet NIdSet(NIdV.Len());
+  TIntPrV EdgeV;
   for (int n = 0; n < NIdV.Len(); n++) {
     if (Graph->IsNode(NIdV[n])) {
       NIdSet.AddKey(NIdV[n]);
@@ -24,7 +25,7 @@ PUNGraph GetSubGraph(const PUNGraph& Graph, const TIntV& NIdV, const bool& Renum
       for (int edge = 0; edge < NI.GetOutDeg(); edge++) {
         const int OutNId = NI.GetOutNId(edge);
         if (NIdSet.IsKey(OutNId)) {
-          NewGraph.AddEdge(SrcNId, OutNId); }
+          EdgeV.Add(TIntPr(SrcNId, OutNId)); }
       }
     }
   } else {
@@ -34,10 +35,11 @@ PUNGraph GetSubGraph(const PUNGraph& Graph, const TIntV& NIdV, const bool& Renum
       for (int edge = 0; edge < NI.GetOutDeg(); edge++) {
         const int OutNId = NI.GetOutNId(edge);
         if (NIdSet.IsKey(OutNId)) {
-          NewGraph.AddEdge(NIdSet.GetKeyId(SrcNId), NIdSet.GetKeyId(OutNId)); }
+          EdgeV.Add(TIntPr(NIdSet.GetKeyId(SrcNId), NIdSet.GetKeyId(OutNId))); }
       }
     }
   }
+  NewGraph.AddEdgeBatch(EdgeV);
   return NewGraphPt;
 }
 
@@ -48,6 +50,7 @@ PNGraph GetSubGraph(const PNGraph& Graph, const TIntV& NIdV, const bool& Renumbe
   TNGraph& NewGraph = *NewGraphPt;
   NewGraph.Reserve(NIdV.Len(), -1);
   TIntSet NIdSet(NIdV.Len());
+  TIntPrV EdgeV;
   for (int n = 0; n < NIdV.Len(); n++) {
     if (Graph->IsNode(NIdV[n])) {
       NIdSet.AddKey(NIdV[n]);
@@ -62,7 +65,7 @@ PNGraph GetSubGraph(const PNGraph& Graph, const TIntV& NIdV, const bool& Renumbe
       for (int edge = 0; edge < NI.GetOutDeg(); edge++) {
         const int OutNId = NI.GetOutNId(edge);
         if (NIdSet.IsKey(OutNId)) {
-          NewGraph.AddEdge(SrcNId, OutNId); }
+          EdgeV.Add(TIntPr(SrcNId, OutNId)); }
       }
     }
   } else {
@@ -72,10 +75,11 @@ PNGraph GetSubGraph(const PNGraph& Graph, const TIntV& NIdV, const bool& Renumbe
       for (int edge = 0; edge < NI.GetOutDeg(); edge++) {
         const int OutNId = NI.GetOutNId(edge);
         if (NIdSet.IsKey(OutNId)) {
-          NewGraph.AddEdge(NIdSet.GetKeyId(SrcNId), NIdSet.GetKeyId(OutNId)); }
+          EdgeV.Add(TIntPr(NIdSet.GetKeyId(SrcNId), NIdSet.GetKeyId(OutNId))); }
       }
     }
   }
+  NewGraph.AddEdgeBatch(EdgeV);
   return NewGraphPt;
 }
 
@@ -13,6 +13,8 @@ namespace TSnap {
 template<class PGraph> PGraph GetSubGraph(const PGraph& Graph, const TIntV& NIdV);
 /// Returns an induced subgraph of graph Graph with NIdV nodes with an node renumbering. ##TSnap::GetSubGraph
 template<class PGraph> PGraph GetSubGraphRenumber(const PGraph& Graph, const TIntV& NIdV);
+/// Returns a view of the subgraph of graph Graph induced by NIdV nodes, the graph is not copied. ##TSnap::GetSubGraphView
+template<class PGraph> TPt<TGraphView<PGraph> > GetSubGraphView(const PGraph& Graph, const TIntV& NIdV);
 /// Returns an induced subgraph of an undirected graph Graph with NIdV nodes with an optional node renumbering. ##TSnap::GetSubGraph-1
 PUNGraph GetSubGraph(const PUNGraph& Graph, const TIntV& NIdV, const bool& RenumberNodes=false);
 // Returns an induced subgraph of a directed graph Graph with NIdV nodes with an optional node renumbering. ##TSnap::GetSubGraph-2
@@ -31,6 +33,8 @@ template<class PGraph> PGraph GetESubGraph(const PGraph& Graph, const TIntPrV& E
 template<class PGraph, class TEdgeDat> PGraph GetEDatSubGraph(const PGraph& Graph, const TEdgeDat& EDat, const int& Cmp);
 /// Returns a subgraph of graph Graph with NIdV nodes and edges where edge data matches the parameters. ##TSnap::GetEDatSubGraph-1
 template<class PGraph, class TEdgeDat> PGraph GetEDatSubGraph(const PGraph& Graph, const TIntV& NIdV, const TEdgeDat& EDat, const int& Cmp);
+/// Returns a view of graph Graph with the edges accepted by Filter(SrcNId, DstNId), the graph is not copied.
+template<class PGraph, class TEdgeFilter> TPt<TGraphView<PGraph, TEdgeFilter> > GetESubGraphView(const PGraph& Graph, const TEdgeFilter& Filter);
 
 // convert between the graphs. Does NOT copy the data
 /// Performs conversion of graph InGraph with an optional node renumbering. ##TSnap::ConvertGraph
@@ -110,6 +114,7 @@ struct TGetSubGraph<PGraph, false> { // not multigraph
     typename PGraph::TObj& NewGraph = *NewGraphPt;
     NewGraph.Reserve(NIdV.Len(), -1);
     TIntSet NodeSet;
+    TIntPrV EdgeV;
     for (int n = 0; n < NIdV.Len(); n++) {
       if (! HasGraphFlag(typename PGraph::TObj, gfNodeDat)) {
         if (Graph->IsNode(NIdV[n])) { NewGraph.AddNode(NIdV[n]); NodeSet.AddKey(NIdV[n]); } }
@@ -123,18 +128,29 @@ struct TGetSubGraph<PGraph, false> { // not multigraph
         const int OutNId = NI.GetOutNId(edge);
         if (NewGraph.IsNode(OutNId)) {
           if (! HasGraphFlag(typename PGraph::TObj, gfEdgeDat)) { 
-            NewGraph.AddEdge(SrcNId, OutNId); }
+            EdgeV.Add(TIntPr(SrcNId, OutNId)); }
           else { 
             NewGraph.AddEdge(Graph->GetEI(SrcNId, OutNId)); } // also copy data
         }
       }
     }
+    TSnap::AddEdgeBatch(NewGraphPt, EdgeV);
     NewGraph.Defrag();
     return NewGraphPt;
   }
 };
 }; // TSnapDetail
 
+template<class PGraph>
+TPt<TGraphView<PGraph> > GetSubGraphView(const PGraph& Graph, const TIntV& NIdV) {
+  return TGraphView<PGraph>::New(Graph, NIdV);
+}
+
+template<class PGraph, class TEdgeFilter>
+TPt<TGraphView<PGraph, TEdgeFilter> > GetESubGraphView(const PGraph& Graph, const TEdgeFilter& Filter) {
+  return TGraphView<PGraph, TEdgeFilter>::New(Graph, Filter);
+}
+
 template<class PGraph> 
 PGraph GetSubGraph(const PGraph& Graph, const TIntV& NIdV) {
   return TSnapDetail::TGetSubGraph<PGraph, HasGraphFlag(typename PGraph::TObj, gfMultiGraph)>
@@ -182,9 +198,8 @@ PGraph GetESubGraph(const PGraph& Graph, const TIntPrV& EdgeV) {
     if (! NewGraph.IsNode(DstNId)) {
       NewGraph.AddNode(Graph->GetNI(DstNId)); 
     }
-
-    NewGraph.AddEdge(SrcNId, DstNId);
   }
+  TSnap::AddEdgeBatch(NewGraphPt, EdgeV);
   return NewGraphPt;
 }
 
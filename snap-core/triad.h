@@ -15,9 +15,9 @@ template <class PGraph> double GetClustCf(const PGraph& Graph, TFltPrV& DegToCCf
 /// Computes the distribution of average clustering coefficient as well as the number of open and closed triads in the graph. ##TSnap::GetClustCfAll
 template <class PGraph> double GetClustCfAll(const PGraph& Graph, TFltPrV& DegToCCfV, int64& ClosedTriadsX, int64& OpenTriadsX, int SampleNodes=-1);
 /// Returns clustering coefficient of a particular node. ##TSnap::GetNodeClustCf
-template <class PGraph> double GetNodeClustCf(const PGraph& Graph, const int& NId);
+template <class PGraph> double GetNodeClustCf(const PGraph& Graph, const typename TNIdType<typename PGraph::TObj>::TNId& NId);
 /// Computes clustering coefficient of each node of the Graph. ##TSnap::GetNodeClustCf
-template <class PGraph> void GetNodeClustCf(const PGraph& Graph, TIntFltH& NIdCCfH);
+template <class PGraph> void GetNodeClustCf(const PGraph& Graph, THash<typename TNIdType<typename PGraph::TObj>::TNIdT, TFlt>& NIdCCfH);
 
 /// Returns the number of triangles in a graph. ##TSnap::GetTriads
 template <class PGraph> int64 GetTriads(const PGraph& Graph, int SampleNodes=-1);
@@ -26,16 +26,16 @@ template <class PGraph> int64 GetTriads(const PGraph& Graph, int64& ClosedTriads
 /// Computes the number of Closed and Open triads. ##TSnap::GetTriadsAll
 template <class PGraph> int64 GetTriadsAll(const PGraph& Graph, int64& ClosedTriadsX, int64& OpenTriadsX, int SampleNodes=-1);
 /// Computes the number of open and close triads for every node of the network. ##TSnap::GetTriads2
-template <class PGraph> void GetTriads(const PGraph& Graph, TIntTrV& NIdCOTriadV, int SampleNodes=-1);
+template <class PGraph> void GetTriads(const PGraph& Graph, TVec<TTriple<typename TNIdType<typename PGraph::TObj>::TNIdT, TInt, TInt> >& NIdCOTriadV, int SampleNodes=-1);
 /// Counts the number of edges that participate in at least one triad. ##TSnap::GetTriadEdges
 template <class PGraph> int GetTriadEdges(const PGraph& Graph, int SampleEdges=-1);
 
 /// Returns the number of undirected triads a node \c NId participates in. ##TSnap::GetNodeTriads
-template <class PGraph> int GetNodeTriads(const PGraph& Graph, const int& NId);
+template <class PGraph> int GetNodeTriads(const PGraph& Graph, const typename TNIdType<typename PGraph::TObj>::TNId& NId);
 /// Returns number of Open and Closed triads a node \c NId participates in. ##TSnap::GetNodeTriads1
-template <class PGraph> int GetNodeTriads(const PGraph& Graph, const int& NId, int& ClosedNTriadsX, int& OpenNTriadsX);
+template <class PGraph> int GetNodeTriads(const PGraph& Graph, const typename TNIdType<typename PGraph::TObj>::TNId& NId, int& ClosedNTriadsX, int& OpenNTriadsX);
 /// Returns number of Open and Closed triads a node \c NId participates in. ##TSnap::GetNodeTriadsAll
-template <class PGraph> int GetNodeTriadsAll(const PGraph& Graph, const int& NId, int& ClosedNTriadsX, int& OpenNTriadsX);
+template <class PGraph> int GetNodeTriadsAll(const PGraph& Graph, const typename TNIdType<typename PGraph::TObj>::TNId& NId, int& ClosedNTriadsX, int& OpenNTriadsX);
 /// Returns the number of triads between a node \c NId and a subset of its neighbors \c GroupSet. ##TSnap::GetNodeTriads3
 template <class PGraph>
 int GetNodeTriads(const PGraph& Graph, const int& NId, const TIntSet& GroupSet, int& InGroupEdgesX, int& InOutGroupEdgesX, int& OutGroupEdgesX);
@@ -43,13 +43,13 @@ int GetNodeTriads(const PGraph& Graph, const int& NId, const TIntSet& GroupSet,
 template <class PGraph> void GetTriadParticip(const PGraph& Graph, TIntPrV& TriadCntV);
 
 /// Returns a number of shared neighbors between a pair of nodes NId1 and NId2.
-template<class PGraph> int GetCmnNbrs(const PGraph& Graph, const int& NId1, const int& NId2);
+template<class PGraph> int GetCmnNbrs(const PGraph& Graph, const typename TNIdType<typename PGraph::TObj>::TNId& NId1, const typename TNIdType<typename PGraph::TObj>::TNId& NId2);
 /// Returns the shared neighbors between a pair of nodes NId1 and NId2.
-template<class PGraph> int GetCmnNbrs(const PGraph& Graph, const int& NId1, const int& NId2, TIntV& NbrV);
+template<class PGraph> int GetCmnNbrs(const PGraph& Graph, const typename TNIdType<typename PGraph::TObj>::TNId& NId1, const typename TNIdType<typename PGraph::TObj>::TNId& NId2, TVec<typename TNIdType<typename PGraph::TObj>::TNIdT>& NbrV);
 /// Returns the number of length 2 directed paths between a pair of nodes NId1, NId2 (NId1 --> U --> NId2).
-template<class PGraph> int GetLen2Paths(const PGraph& Graph, const int& NId1, const int& NId2);
+template<class PGraph> int GetLen2Paths(const PGraph& Graph, const typename TNIdType<typename PGraph::TObj>::TNId& NId1, const typename TNIdType<typename PGraph::TObj>::TNId& NId2);
 /// Returns the 2 directed paths between a pair of nodes NId1, NId2 (NId1 --> U --> NId2). ##TSnap::GetLen2Paths
-template<class PGraph> int GetLen2Paths(const PGraph& Graph, const int& NId1, const int& NId2, TIntV& NbrV);
+template<class PGraph> int GetLen2Paths(const PGraph& Graph, const typename TNIdType<typename PGraph::TObj>::TNId& NId1, const typename TNIdType<typename PGraph::TObj>::TNId& NId2, TVec<typename TNIdType<typename PGraph::TObj>::TNIdT>& NbrV);
 /// Returns the number of triangles in graph \c Graph.
 template<class PGraph> int64 GetTriangleCnt(const PGraph& Graph);
 /// Merges neighbors by removing duplicates and produces one sorted vector of neighbors.
@@ -65,7 +65,7 @@ int GetCommon(TIntV& A, TIntV& B);
 // Implementation
 
 template <class PGraph> double GetClustCf(const PGraph& Graph, int SampleNodes) {
-  TIntTrV NIdCOTriadV;
+  TVec<TTriple<typename TNIdType<typename PGraph::TObj>::TNIdT, TInt, TInt> > NIdCOTriadV;
   GetTriads(Graph, NIdCOTriadV, SampleNodes);
   if (NIdCOTriadV.Empty()) { return 0.0; }
   double SumCcf = 0.0;
@@ -79,7 +79,7 @@ template <class PGraph> double GetClustCf(const PGraph& Graph, int SampleNodes)
 }
 
 template <class PGraph> double GetClustCf(const PGraph& Graph, TFltPrV& DegToCCfV, int SampleNodes) {
-  TIntTrV NIdCOTriadV;
+  TVec<TTriple<typename TNIdType<typename PGraph::TObj>::TNIdT, TInt, TInt> > NIdCOTriadV;
   GetTriads(Graph, NIdCOTriadV, SampleNodes);
   if (NIdCOTriadV.Empty()) {
     DegToCCfV.Clr(false);
@@ -106,7 +106,7 @@ template <class PGraph> double GetClustCf(const PGraph& Graph, TFltPrV& DegToCCf
 
 template <class PGraph>
 double GetClustCf(const PGraph& Graph, TFltPrV& DegToCCfV, int64& ClosedTriads, int64& OpenTriads, int SampleNodes) {
-  TIntTrV NIdCOTriadV;
+  TVec<TTriple<typename TNIdType<typename PGraph::TObj>::TNIdT, TInt, TInt> > NIdCOTriadV;
   GetTriads(Graph, NIdCOTriadV, SampleNodes);
   if (NIdCOTriadV.Empty()) {
     DegToCCfV.Clr(false);
@@ -147,7 +147,7 @@ double GetClustCfAll(const PGraph& Graph, TFltPrV& DegToCCfV, int64& ClosedTriad
 }
 
 template <class PGraph>
-double GetNodeClustCf(const PGraph& Graph, const int& NId) {
+double GetNodeClustCf(const PGraph& Graph, const typename TNIdType<typename PGraph::TObj>::TNId& NId) {
   int Open, Closed;
   GetNodeTriads(Graph, NId, Open, Closed);
   //const double Deg = Graph->GetNI(NId).GetDeg();
@@ -155,8 +155,8 @@ double GetNodeClustCf(const PGraph& Graph, const int& NId) {
 }
 
 template <class PGraph>
-void GetNodeClustCf(const PGraph& Graph, TIntFltH& NIdCCfH) {
-  TIntTrV NIdCOTriadV;
+void GetNodeClustCf(const PGraph& Graph, THash<typename TNIdType<typename PGraph::TObj>::TNIdT, TFlt>& NIdCCfH) {
+  TVec<TTriple<typename TNIdType<typename PGraph::TObj>::TNIdT, TInt, TInt> > NIdCOTriadV;
   GetTriads(Graph, NIdCOTriadV);
   NIdCCfH.Clr(false);
   for (int i = 0; i < NIdCOTriadV.Len(); i++) {
@@ -174,7 +174,7 @@ int64 GetTriads(const PGraph& Graph, int SampleNodes) {
 
 template <class PGraph>
 int64 GetTriads(const PGraph& Graph, int64& ClosedTriads, int64& OpenTriads, int SampleNodes) {
-  TIntTrV NIdCOTriadV;
+  TVec<TTriple<typename TNIdType<typename PGraph::TObj>::TNIdT, TInt, TInt> > NIdCOTriadV;
   GetTriads(Graph, NIdCOTriadV, SampleNodes);
   uint64 closedTriads = 0;
   uint64 openTriads = 0;
@@ -197,10 +197,12 @@ int64 GetTriadsAll(const PGraph& Graph, int64& ClosedTriads, int64& OpenTriads,
 // Function pretends that the graph is undirected (count unique connected triples of nodes)
 // This implementation is slower, it uses hash tables directly
 template <class PGraph>
-void GetTriads_v0(const PGraph& Graph, TIntTrV& NIdCOTriadV, int SampleNodes) {
+void GetTriads_v0(const PGraph& Graph, TVec<TTriple<typename TNIdType<typename PGraph::TObj>::TNIdT, TInt, TInt> >& NIdCOTriadV, int SampleNodes) {
+  typedef typename TNIdType<typename PGraph::TObj>::TNIdT TNIdT;
+  typedef TTriple<TNIdT, TInt, TInt> TNIdCOTr;
   const bool IsDir = Graph->HasFlag(gfDirected);
-  TIntSet NbrH;
-  TIntV NIdV;
+  THashSet<TNIdT> NbrH;
+  TVec<TNIdT> NIdV;
   TRnd Rnd(0);
 
   Graph->GetNIdV(NIdV);
@@ -212,7 +214,7 @@ void GetTriads_v0(const PGraph& Graph, TIntTrV& NIdCOTriadV, int SampleNodes) {
   for (int node = 0; node < SampleNodes; node++) {
     typename PGraph::TObj::TNodeI NI = Graph->GetNI(NIdV[node]);
     if (NI.GetDeg() < 2) {
-      NIdCOTriadV.Add(TIntTr(NI.GetId(), 0, 0)); // zero triangles
+      NIdCOTriadV.Add(TNIdCOTr(NI.GetId(), 0, 0)); // zero triangles
       continue;
     }
     // find neighborhood
@@ -232,23 +234,28 @@ void GetTriads_v0(const PGraph& Graph, TIntTrV& NIdCOTriadV, int SampleNodes) {
     for (int srcNbr = 0; srcNbr < NbrH.Len(); srcNbr++) {
       const typename PGraph::TObj::TNodeI SrcNode = Graph->GetNI(NbrH.GetKey(srcNbr));
       for (int dstNbr = srcNbr+1; dstNbr < NbrH.Len(); dstNbr++) {
-        const int dstNId = NbrH.GetKey(dstNbr);
+        const typename TNIdType<typename PGraph::TObj>::TNId dstNId = NbrH.GetKey(dstNbr);
         if (SrcNode.IsNbrNId(dstNId)) { CloseCnt++; } // is edge
         else { OpenCnt++; }
       }
     }
     IAssert(2*(OpenCnt+CloseCnt) == NbrH.Len()*(NbrH.Len()-1));
-    NIdCOTriadV.Add(TIntTr(NI.GetId(), CloseCnt, OpenCnt));
+    NIdCOTriadV.Add(TNIdCOTr(NI.GetId(), CloseCnt, OpenCnt));
   }
 }
 
 // Function pretends that the graph is undirected (count unique connected triples of nodes)
 // This implementation is faster, it converts hash tables to vectors
+// Graphs with 64-bit node ids use GetTriads_v0(), since their node ids cannot index a vector.
 template <class PGraph>
-void GetTriads(const PGraph& Graph, TIntTrV& NIdCOTriadV, int SampleNodes) {
+void GetTriads(const PGraph& Graph, TVec<TTriple<typename TNIdType<typename PGraph::TObj>::TNIdT, TInt, TInt> >& NIdCOTriadV, int SampleNodes) {
+  typedef typename TNIdType<typename PGraph::TObj>::TNIdT TNIdT;
+  typedef TTriple<TNIdT, TInt, TInt> TNIdCOTr;
+  if (sizeof(typename TNIdType<typename PGraph::TObj>::TNId) > sizeof(int)) {
+    GetTriads_v0(Graph, NIdCOTriadV, SampleNodes);  return; }
   const bool IsDir = Graph->HasFlag(gfDirected);
   TIntSet NbrH;
-  TIntV NIdV;
+  TVec<TNIdT> NIdV;
   //TRnd Rnd(0);
   TRnd Rnd(1);
   int NNodes;
@@ -305,7 +312,7 @@ void GetTriads(const PGraph& Graph, TIntTrV& NIdCOTriadV, int SampleNodes) {
     NId = NI.GetId();
     hcount++;
     if (NI.GetDeg() < 2) {
-      NIdCOTriadV.Add(TIntTr(NId, 0, 0)); // zero triangles
+      NIdCOTriadV.Add(TNIdCOTr(NId, 0, 0)); // zero triangles
       continue;
     }
 
@@ -320,7 +327,7 @@ void GetTriads(const PGraph& Graph, TIntTrV& NIdCOTriadV, int SampleNodes) {
     }
     CloseCnt1 /= 2;
     OpenCnt1 = (NLen*(NLen-1))/2 - CloseCnt1;
-    NIdCOTriadV.Add(TIntTr(NId, CloseCnt1, OpenCnt1));
+    NIdCOTriadV.Add(TNIdCOTr(NId, CloseCnt1, OpenCnt1));
   }
 }
 
@@ -542,19 +549,19 @@ int GetTriadEdges(const PGraph& Graph, int SampleEdges) {
 
 // Returns number of undirected triads a node participates in
 template <class PGraph>
-int GetNodeTriads(const PGraph& Graph, const int& NId) {
+int GetNodeTriads(const PGraph& Graph, const typename TNIdType<typename PGraph::TObj>::TNId& NId) {
   int ClosedTriads=0, OpenTriads=0;
   return GetNodeTriads(Graph, NId, ClosedTriads, OpenTriads);
 }
 
 // Return number of undirected triads a node participates in
 template <class PGraph>
-int GetNodeTriads(const PGraph& Graph, const int& NId, int& ClosedTriads, int& OpenTriads) {
+int GetNodeTriads(const PGraph& Graph, const typename TNIdType<typename PGraph::TObj>::TNId& NId, int& ClosedTriads, int& OpenTriads) {
   const typename PGraph::TObj::TNodeI NI = Graph->GetNI(NId);
   ClosedTriads=0;  OpenTriads=0;
   if (NI.GetDeg() < 2) { return 0; }
   // find neighborhood
-  TIntSet NbrSet(NI.GetDeg());
+  THashSet<typename TNIdType<typename PGraph::TObj>::TNIdT> NbrSet(NI.GetDeg());
   for (int e = 0; e < NI.GetOutDeg(); e++) {
     if (NI.GetOutNId(e) != NI.GetId()) { // exclude self edges
       NbrSet.AddKey(NI.GetOutNId(e)); }
@@ -569,7 +576,7 @@ int GetNodeTriads(const PGraph& Graph, const int& NId, int& ClosedTriads, int& O
   for (int srcNbr = 0; srcNbr < NbrSet.Len(); srcNbr++) {
     const typename PGraph::TObj::TNodeI SrcNode = Graph->GetNI(NbrSet.GetKey(srcNbr));
     for (int dstNbr = srcNbr+1; dstNbr < NbrSet.Len(); dstNbr++) {
-      const int dstNId = NbrSet.GetKey(dstNbr);
+      const typename TNIdType<typename PGraph::TObj>::TNId dstNId = NbrSet.GetKey(dstNbr);
       if (SrcNode.IsNbrNId(dstNId)) { ClosedTriads++; }
       else { OpenTriads++; }
     }
@@ -578,7 +585,7 @@ int GetNodeTriads(const PGraph& Graph, const int& NId, int& ClosedTriads, int& O
 }
 
 template <class PGraph>
-int GetNodeTriadsAll(const PGraph& Graph, const int& NId, int& ClosedTriads, int& OpenTriads) {
+int GetNodeTriadsAll(const PGraph& Graph, const typename TNIdType<typename PGraph::TObj>::TNId& NId, int& ClosedTriads, int& OpenTriads) {
   return GetNodeTriads(Graph, NId, ClosedTriads, OpenTriads);
 }
 
@@ -635,27 +642,28 @@ void GetTriadParticip(const PGraph& Graph, TIntPrV& TriadCntV) {
 }
 
 template<class PGraph>
-int GetCmnNbrs(const PGraph& Graph, const int& NId1, const int& NId2) {
-  TIntV NbrV;
+int GetCmnNbrs(const PGraph& Graph, const typename TNIdType<typename PGraph::TObj>::TNId& NId1, const typename TNIdType<typename PGraph::TObj>::TNId& NId2) {
+  TVec<typename TNIdType<typename PGraph::TObj>::TNIdT> NbrV;
   return GetCmnNbrs(Graph, NId1, NId2, NbrV);
 }
 
 // Get common neighbors between a pair of nodes (undirected)
 template<class PGraph>
-int GetCmnNbrs(const PGraph& Graph, const int& NId1, const int& NId2, TIntV& NbrV) {
+int GetCmnNbrs(const PGraph& Graph, const typename TNIdType<typename PGraph::TObj>::TNId& NId1, const typename TNIdType<typename PGraph::TObj>::TNId& NId2, TVec<typename TNIdType<typename PGraph::TObj>::TNIdT>& NbrV) {
+  typedef typename TNIdType<typename PGraph::TObj>::TNId TNId;
   if (! Graph->IsNode(NId1) || ! Graph->IsNode(NId2)) { NbrV.Clr(false); return 0; }
   typename PGraph::TObj::TNodeI NI1 = Graph->GetNI(NId1);
   typename PGraph::TObj::TNodeI NI2 = Graph->GetNI(NId2);
   NbrV.Clr(false);
   NbrV.Reserve(TMath::Mn(NI1.GetDeg(), NI2.GetDeg()));
-  TIntSet NSet1(NI1.GetDeg()), NSet2(NI2.GetDeg());
+  THashSet<typename TNIdType<typename PGraph::TObj>::TNIdT> NSet1(NI1.GetDeg()), NSet2(NI2.GetDeg());
   for (int i = 0; i < NI1.GetDeg(); i++) {
-    const int nid = NI1.GetNbrNId(i);
+    const TNId nid = NI1.GetNbrNId(i);
     if (nid!=NId1 && nid!=NId2) {
       NSet1.AddKey(nid); }
   }
   for (int i = 0; i < NI2.GetDeg(); i++) {
-    const int nid = NI2.GetNbrNId(i);
+    const TNId nid = NI2.GetNbrNId(i);
     if (NSet1.IsKey(nid)) {
       NSet2.AddKey(nid);
     }
@@ -688,15 +696,15 @@ inline int GetCmnNbrs<PUNGraph>(const PUNGraph& Graph, const int& NId1, const in
 // get number of length 2 directed paths between a pair of nodes
 // for a pair of nodes (i,j): |{u: (i,u) and (u,j) }|
 template<class PGraph>
-int GetLen2Paths(const PGraph& Graph, const int& NId1, const int& NId2) {
-  TIntV NbrV;
+int GetLen2Paths(const PGraph& Graph, const typename TNIdType<typename PGraph::TObj>::TNId& NId1, const typename TNIdType<typename PGraph::TObj>::TNId& NId2) {
+  TVec<typename TNIdType<typename PGraph::TObj>::TNIdT> NbrV;
   return GetLen2Paths(Graph, NId1, NId2, NbrV);
 }
 
 // get number of length 2 directed paths between a pair of nodes
 // for a pair of nodes (i,j): {u: (i,u) and (u,j) }
 template<class PGraph>
-int GetLen2Paths(const PGraph& Graph, const int& NId1, const int& NId2, TIntV& NbrV) {
+int GetLen2Paths(const PGraph& Graph, const typename TNIdType<typename PGraph::TObj>::TNId& NId1, const typename TNIdType<typename PGraph::TObj>::TNId& NId2, TVec<typename TNIdType<typename PGraph::TObj>::TNIdT>& NbrV) {
   const typename PGraph::TObj::TNodeI NI = Graph->GetNI(NId1);
   NbrV.Clr(false);
   NbrV.Reserve(NI.GetOutDeg());
@@ -0,0 +1,196 @@
+/////////////////////////////////////////////////
+// Vertex programs
+/// Neighbors of a node that are activated when the node changes.
+typedef enum TVpDir_ { vpdOut, vpdIn, vpdBoth } TVpDir;
+
+//#//////////////////////////////////////////////
+/// Default hooks of a vertex program. ##TVtxProg
+/// A vertex program defines the node state type TVal and the methods
+///   bool InitNode(const TCsrGraph& Csr, const int& NIdx, TVal& Val);
+///   bool Update(const TCsrGraph& Csr, const int& Iter, const int& NIdx, const TVec<TVal>& ValV, TVal& NewVal);
+/// InitNode() sets the initial state and returns true if the node starts active.
+/// Update() gathers from the neighbors of an active node and computes its new
+/// state from ValV, the state of the previous superstep. It returns true if the
+/// node changed, which activates its neighbors in GetScatterDir() direction for
+/// the next superstep. Programs derive from TVtxProg and hide the hooks below.
+template <class TVal>
+class TVtxProg {
+public:
+  /// Direction in which changed nodes activate their neighbors.
+  TVpDir GetScatterDir() const { return vpdOut; }
+  /// Returns true if all nodes are active in every superstep.
+  bool IsDense() const { return false; }
+  /// Called after every superstep with the new state, returns true if the program has converged.
+  bool EndIter(const TCsrGraph& Csr, const int& Iter, TVec<TVal>& ValV) { return false; }
+};
+
+//#//////////////////////////////////////////////
+/// Bulk-synchronous vertex program engine. ##TVtxProgEngine
+/// Runs a vertex program over a TCsrGraph in supersteps. Node states are
+/// double-buffered, so Update() reads the states of the previous superstep while
+/// new states are written to the second buffer. Only the nodes of the active
+/// frontier are updated, the frontier of the next superstep is built from the
+/// nodes that changed. Active nodes are distributed over threads with dynamic
+/// scheduling. The run stops when the frontier is empty, EndIter() reports
+/// convergence, or after MaxIter supersteps.
+template <class TProg>
+class TVtxProgEngine {
+public:
+  typedef typename TProg::TVal TVal;
+private:
+  const TCsrGraph& Csr;
+  TVec<TVal> ValV;       // node state by node index
+  TVec<TVal> NewValV;    // node state written by the running superstep
+  TIntV InNextV;         // 1 if the node is already in the next frontier
+  TInt Iters;
+private:
+  void Activate(const int& NIdx, TIntV& NextV) {
+#ifdef USE_OPENMP
+    if (InNextV[NIdx] == 0 && __sync_bool_compare_and_swap(&InNextV[NIdx].Val, 0, 1)) { NextV.AddMP(NIdx); }
+#else
+    if (InNextV[NIdx] == 0) { InNextV[NIdx] = 1;  NextV.Add(NIdx); }
+#endif
+  }
+  void Scatter(const int& NIdx, const TVpDir& Dir, TIntV& NextV) {
+    if (Dir == vpdOut || Dir == vpdBoth || ! Csr.IsDirected()) {
+      for (const TInt* N = Csr.BegOut(NIdx); N < Csr.EndOut(NIdx); N++) { Activate(*N, NextV); } }
+    if ((Dir == vpdIn || Dir == vpdBoth) && Csr.IsDirected()) {
+      for (const TInt* N = Csr.BegIn(NIdx); N < Csr.EndIn(NIdx); N++) { Activate(*N, NextV); } }
+  }
+public:
+  TVtxProgEngine(const TCsrGraph& _Csr) : Csr(_Csr), ValV(), NewValV(), InNextV(), Iters(0) { }
+  /// Runs Prog from its initial state, returns the number of supersteps.
+  int Run(TProg& Prog, const int& MaxIter);
+  /// Returns the number of supersteps of the last run.
+  int GetIters() const { return Iters; }
+  /// Returns the node states indexed by node index of the graph snapshot.
+  const TVec<TVal>& GetValV() const { return ValV; }
+  /// Returns the state of node NId.
+  const TVal& GetNDat(const int& NId) const { return ValV[Csr.GetNIdx(NId)]; }
+};
+
+template <class TProg>
+int TVtxProgEngine<TProg>::Run(TProg& Prog, const int& MaxIter) {
+  const int Nodes = Csr.GetNodes();
+  const bool Dense = Prog.IsDense();
+  const TVpDir Dir = Prog.GetScatterDir();
+  ValV.Gen(Nodes);  NewValV.Gen(Nodes);
+  InNextV.Gen(Nodes);
+  TIntV Vec1(Dense ? 0 : Nodes, 0), Vec2(Dense ? 0 : Nodes, 0);
+  TIntV* PCurV = &Vec1;
+  TIntV* PNextV = &Vec2;
+  #pragma omp parallel for schedule(dynamic,10000)
+  for (int i = 0; i < Nodes; i++) {
+    if (Prog.InitNode(Csr, i, ValV[i]) && ! Dense) { Activate(i, *PCurV); }
+  }
+  for (Iters = 0; Iters < MaxIter && (Dense || ! PCurV->Empty()); ) {
+    if (Dense) {
+      #pragma omp parallel for schedule(dynamic,1000)
+      for (int i = 0; i < Nodes; i++) {
+        NewValV[i] = ValV[i];
+        Prog.Update(Csr, Iters, i, ValV, NewValV[i]);
+      }
+      ValV.Swap(NewValV);
+    } else {
+      #pragma omp parallel for schedule(static)
+      for (int k = 0; k < PCurV->Len(); k++) { InNextV[(*PCurV)[k]] = 0; }
+      #pragma omp parallel for schedule(dynamic,100)
+      for (int k = 0; k < PCurV->Len(); k++) {
+        const int U = (*PCurV)[k];
+        NewValV[U] = ValV[U];
+        if (Prog.Update(Csr, Iters, U, ValV, NewValV[U])) { Scatter(U, Dir, *PNextV); }
+      }
+      #pragma omp parallel for schedule(static)
+      for (int k = 0; k < PCurV->Len(); k++) { ValV[(*PCurV)[k]] = NewValV[(*PCurV)[k]]; }
+      TIntV* Tmp = PCurV;  PCurV = PNextV;  PNextV = Tmp;
+      PNextV->Reduce(0);
+    }
+    Iters++;
+    if (Prog.EndIter(Csr, Iters-1, ValV)) { break; }
+  }
+  NewValV.Clr();  InNextV.Clr();
+  return Iters;
+}
+
+//#//////////////////////////////////////////////
+/// HITS as a dense vertex program. ##THitsVP
+/// The state of a node is (hub, authority). Even supersteps recompute the
+/// authority scores from the hub scores of in-neighbors, odd supersteps the hub
+/// scores from the authority scores of out-neighbors; every superstep ends by
+/// normalizing the updated scores to L2 norm 1. Run it for 2*MaxIter supersteps.
+class THitsVP : public TVtxProg<TFltPr> {
+public:
+  typedef TFltPr TVal;
+  bool InitNode(const TCsrGraph& Csr, const int& NIdx, TVal& Val) { Val = TFltPr(1.0, 1.0);  return true; }
+  bool IsDense() const { return true; }
+  bool Update(const TCsrGraph& Csr, const int& Iter, const int& NIdx, const TVec<TVal>& ValV, TVal& NewVal) {
+    double Sum = 0;
+    if (Iter % 2 == 0) {
+      for (const TInt* N = Csr.BegIn(NIdx); N < Csr.EndIn(NIdx); N++) { Sum += ValV[*N].Val1; }
+      NewVal.Val2 = Sum;
+    } else {
+      for (const TInt* N = Csr.BegOut(NIdx); N < Csr.EndOut(NIdx); N++) { Sum += ValV[*N].Val2; }
+      NewVal.Val1 = Sum;
+    }
+    return true;
+  }
+  bool EndIter(const TCsrGraph& Csr, const int& Iter, TVec<TVal>& ValV) {
+    const bool Auth = Iter % 2 == 0;
+    double Norm = 0;
+    #pragma omp parallel for reduction(+:Norm) schedule(static)
+    for (int i = 0; i < ValV.Len(); i++) { Norm += TMath::Sqr(Auth ? ValV[i].Val2 : ValV[i].Val1); }
+    Norm = sqrt(Norm);
+    if (Norm > 0) {
+      #pragma omp parallel for schedule(static)
+      for (int i = 0; i < ValV.Len(); i++) {
+        if (Auth) { ValV[i].Val2 /= Norm; } else { ValV[i].Val1 /= Norm; } }
+    }
+    return false;
+  }
+};
+
+//#//////////////////////////////////////////////
+/// Label propagation communities as a vertex program. ##TLabelPropVP
+/// Every node starts with its own label (its node index) and repeatedly adopts
+/// the most frequent label among its neighbors and itself, ties going to the
+/// smallest label. Edge directions are ignored. Nodes whose label changed
+/// activate their neighbors, the program converges when no label changes.
+/// See: U. N. Raghavan, R. Albert, S. Kumara, Near linear time algorithm to detect
+/// community structures in large-scale networks, Phys. Rev. E 76, 036106 (2007)
+class TLabelPropVP : public TVtxProg<TInt> {
+private:
+  TVec<TIntV> LabelVV;   // per-thread scratch for the neighbor labels
+public:
+  typedef TInt TVal;
+  TLabelPropVP() : LabelVV() {
+#ifdef USE_OPENMP
+    LabelVV.Gen(omp_get_max_threads());
+#else
+    LabelVV.Gen(1);
+#endif
+  }
+  bool InitNode(const TCsrGraph& Csr, const int& NIdx, TVal& Val) { Val = NIdx;  return true; }
+  TVpDir GetScatterDir() const { return vpdBoth; }
+  bool Update(const TCsrGraph& Csr, const int& Iter, const int& NIdx, const TVec<TVal>& ValV, TVal& NewVal) {
+#ifdef USE_OPENMP
+    TIntV& LabelV = LabelVV[omp_get_thread_num()];
+#else
+    TIntV& LabelV = LabelVV[0];
+#endif
+    LabelV.Clr(false);
+    LabelV.Add(ValV[NIdx]);
+    for (const TInt* N = Csr.BegOut(NIdx); N < Csr.EndOut(NIdx); N++) { LabelV.Add(ValV[*N]); }
+    if (Csr.IsDirected()) {
+      for (const TInt* N = Csr.BegIn(NIdx); N < Csr.EndIn(NIdx); N++) { LabelV.Add(ValV[*N]); } }
+    LabelV.Sort();
+    int MxLabel = LabelV[0], MxCnt = 0;
+    for (int i = 0; i < LabelV.Len(); ) {
+      int j = i + 1;
+      while (j < LabelV.Len() && LabelV[j] == LabelV[i]) { j++; }
+      if (j - i > MxCnt) { MxCnt = j - i;  MxLabel = LabelV[i]; }
+      i = j;
+    }
+    NewVal = MxLabel;
+    return MxLabel != ValV[NIdx];
+  }
+};
@@ -0,0 +1,4 @@
+#pragma once
+
+// included by the snap-adv module sources compiled with the tests
+#include "Snap.h"
@@ -503,6 +503,49 @@ TEST(TStrIntH, ManipulateTable) {
   EXPECT_EQ(0,DatSum);
 }
 
+// Tables and vectors of vectors and strings, relocated on growth
+TEST(TIntIntVH, Relocate) {
+  const int NElems = 100000;
+  THash<TInt, TIntV> TableV;
+  TVec<TStrV> StrVV;
+  int i;
+
+  const int HashReloc = TIsRelocatable<THash<TInt, TIntV> >::Val;
+  const int PairReloc = TIsRelocatable<TPair<TInt, TStrV> >::Val;
+  const int RndPairReloc = TIsRelocatable<TPair<TInt, TRnd> >::Val;
+  EXPECT_EQ(1, HashReloc);
+  EXPECT_EQ(1, PairReloc);
+  EXPECT_EQ(0, RndPairReloc);
+
+  for (i = 0; i < NElems; i++) {
+    TIntV& V = TableV.AddDat(i);
+    V.Add(i);  V.Add(2*i);
+    StrVV.Add(TStrV());
+    StrVV.Last().Add(TInt::GetStr(i));
+  }
+  EXPECT_EQ(NElems, TableV.Len());
+  for (i = 0; i < NElems; i++) {
+    EXPECT_EQ(2, TableV.GetDat(i).Len());
+    EXPECT_EQ(2*i, TableV.GetDat(i)[1]);
+    EXPECT_EQ(TInt::GetStr(i), StrVV[i][0]);
+  }
+
+  // shrink and regrow
+  StrVV.Trunc(10);
+  StrVV.Pack();
+  EXPECT_EQ(10, StrVV.Len());
+  EXPECT_EQ(10, StrVV.Reserved());
+  EXPECT_EQ(TStr("9"), StrVV[9][0]);
+  StrVV.Add(TStrV());
+  EXPECT_EQ(0, StrVV.Last().Len());
+  StrVV.Trunc(0);
+  StrVV.Pack();
+  EXPECT_EQ(0, StrVV.Reserved());
+  StrVV.Add(TStrV());
+  StrVV[0].Add("a");
+  EXPECT_EQ(TStr("a"), StrVV[0][0]);
+}
+
 int Prime(const int& n) {
   int d;
 
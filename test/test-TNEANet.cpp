@@ -1907,3 +1907,99 @@ TEST(TNEANet, AddEdgeAttributeError) {
     ASSERT_EQ(Graph->GetStrAttrDatE(j, StrAttr), Val.GetStr());
   }
 }
+
+// Test adding edges in batches
+TEST(TNEANet, AddEdgeBatch) {
+  PNEANet Graph = TNEANet::New();
+  for (int i = 0; i < 10; i++) {
+    Graph->AddNode(i);
+  }
+  Graph->AddIntAttrE("int", 5);
+  Graph->AddStrAttrE("str", "none");
+  Graph->AddFltAttrE("flt");
+  Graph->AddEdge(0, 1);
+  Graph->AddEdge(1, 2, 10);
+
+  // multigraph, duplicates are kept
+  TIntPrV EdgeV;
+  for (int i = 0; i < 10; i++) {
+    EdgeV.Add(TIntPr(i, (i*3) % 10));
+    EdgeV.Add(TIntPr(0, 1));
+  }
+  EXPECT_EQ(EdgeV.Len(), Graph->AddEdgeBatch(EdgeV));
+  EXPECT_EQ(2 + EdgeV.Len(), Graph->GetEdges());
+  EXPECT_EQ(1,Graph->IsOk());
+
+  for (int e = 0; e < EdgeV.Len(); e++) {
+    const int EId = 11 + e;
+    EXPECT_EQ(EdgeV[e].Val1, Graph->GetEI(EId).GetSrcNId());
+    EXPECT_EQ(EdgeV[e].Val2, Graph->GetEI(EId).GetDstNId());
+    EXPECT_EQ(5, Graph->GetIntAttrDatE(EId, "int"));
+    EXPECT_EQ(TStr("none"), Graph->GetStrAttrDatE(EId, "str"));
+    EXPECT_EQ(TFlt::Mn, Graph->GetFltAttrDatE(EId, "flt"));
+  }
+  EXPECT_EQ(12, Graph->GetNI(0).GetOutDeg());
+  EXPECT_EQ(11 + EdgeV.Len(), Graph->GetMxEId());
+}
+
+// Test attribute column handles
+TEST(TNEANet, AttrCol) {
+  PNEANet Graph = TNEANet::New();
+  for (int i = 0; i < 10; i++) {
+    Graph->AddNode(i);
+    Graph->AddIntAttrDatN(i, i*i, "sq");
+    Graph->AddStrAttrDatN(i, i % 3 == 0 ? "a" : "b", "str");
+  }
+  for (int i = 0; i < 9; i++) {
+    const int EId = Graph->AddEdge(i, i+1);
+    Graph->AddFltAttrDatE(EId, 0.5*i, "w");
+  }
+  Graph->DelNode(4);
+
+  TNEANet::TIntAttrCol SqCol = Graph->GetIntAttrColN("sq");
+  EXPECT_FALSE(SqCol.Empty());
+  for (TNEANet::TNodeI NI = Graph->BegNI(); NI < Graph->EndNI(); NI++) {
+    EXPECT_EQ(NI.GetId()*NI.GetId(), SqCol[NI.GetKeyId()]);
+    EXPECT_EQ(NI.GetId()*NI.GetId(), SqCol.GetDat(NI.GetId()));
+  }
+  SqCol.GetDat(3) = 100;
+  EXPECT_EQ(100, Graph->GetIntAttrDatN(3, "sq"));
+
+  // handles stay valid when attributes, nodes and edges are added
+  Graph->AddIntAttrDatN(0, 1, "other");
+  Graph->AddFltAttrDatN(0, 1.0, "fother");
+  Graph->AddNode(20);
+  Graph->AddIntAttrDatN(20, 400, "sq");
+  EXPECT_EQ(400, SqCol.GetDat(20));
+
+  TIntV ValV;
+  SqCol.GetV(ValV);
+  EXPECT_EQ(Graph->GetNodes(), ValV.Len());
+  int n = 0;
+  for (TNEANet::TNodeI NI = Graph->BegNI(); NI < Graph->EndNI(); NI++, n++) {
+    EXPECT_EQ(Graph->GetIntAttrDatN(NI.GetId(), "sq"), ValV[n]);
+    ValV[n] = -NI.GetId();
+  }
+  SqCol.SetV(ValV);
+  EXPECT_EQ(-20, Graph->GetIntAttrDatN(20, "sq"));
+  EXPECT_EQ(-7, Graph->GetIntAttrDatN(7, "sq"));
+
+  TNEANet::TFltAttrCol WCol = Graph->GetFltAttrColE("w");
+  for (TNEANet::TEdgeI EI = Graph->BegEI(); EI < Graph->EndEI(); EI++) {
+    EXPECT_EQ(0.5*EI.GetSrcNId(), WCol[EI.GetKeyId()]);
+  }
+  TFltV WV;
+  WCol.GetV(WV);
+  EXPECT_EQ(Graph->GetEdges(), WV.Len());
+
+  TStrV DictV;
+  TIntV CodeV;
+  Graph->GetStrAttrDictN("str", DictV, CodeV);
+  // node 20 has the default value
+  EXPECT_EQ(3, DictV.Len());
+  EXPECT_EQ(Graph->GetNodes(), CodeV.Len());
+  n = 0;
+  for (TNEANet::TNodeI NI = Graph->BegNI(); NI < Graph->EndNI(); NI++, n++) {
+    EXPECT_EQ(Graph->GetStrAttrDatN(NI.GetId(), "str"), DictV[CodeV[n]]);
+  }
+}
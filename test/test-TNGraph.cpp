@@ -158,4 +158,93 @@ TEST(TNGraph, GetSmallGraph) {
   EXPECT_EQ(1,Graph->IsOk());
   EXPECT_EQ(0,Graph->Empty());
   EXPECT_EQ(1,Graph->HasFlag(gfDirected));
-}
\ No newline at end of file
+}
+
+// Test adding edges in batches
+TEST(TNGraph, AddEdgeBatch) {
+  const int NNodes = 200;
+  PNGraph Graph = TNGraph::New();
+  PNGraph Graph1 = TNGraph::New();
+  for (int i = 0; i < NNodes; i++) {
+    Graph->AddNode(i);
+    Graph1->AddNode(i);
+  }
+
+  // a hub node, duplicates and self edges, added in two batches
+  TRnd Rnd(1);
+  for (int b = 0; b < 2; b++) {
+    TIntPrV EdgeV;
+    for (int e = 0; e < 3000; e++) {
+      const int SrcNId = e % 3 == 0 ? 0 : Rnd.GetUniDevInt(NNodes);
+      EdgeV.Add(TIntPr(SrcNId, Rnd.GetUniDevInt(NNodes)));
+    }
+    int NewEdges = 0;
+    for (int e = 0; e < EdgeV.Len(); e++) {
+      if (Graph1->AddEdge(EdgeV[e].Val1, EdgeV[e].Val2) != -2) { NewEdges++; }
+    }
+    EXPECT_EQ(NewEdges, Graph->AddEdgeBatch(EdgeV));
+    EXPECT_EQ(Graph1->GetEdges(), Graph->GetEdges());
+  }
+  EXPECT_EQ(1,Graph->IsOk());
+
+  for (TNGraph::TNodeI NI = Graph->BegNI(); NI < Graph->EndNI(); NI++) {
+    TNGraph::TNodeI NI1 = Graph1->GetNI(NI.GetId());
+    EXPECT_EQ(NI1.GetOutDeg(), NI.GetOutDeg());
+    EXPECT_EQ(NI1.GetInDeg(), NI.GetInDeg());
+    for (int e = 0; e < NI.GetOutDeg(); e++) {
+      EXPECT_EQ(NI1.GetOutNId(e), NI.GetOutNId(e));
+    }
+    for (int e = 0; e < NI.GetInDeg(); e++) {
+      EXPECT_EQ(NI1.GetInNId(e), NI.GetInNId(e));
+    }
+  }
+
+  // generic version
+  TIntPrV EdgeV;
+  EdgeV.Add(TIntPr(1, 2));
+  EdgeV.Add(TIntPr(1, 2));
+  const int NewEdges = Graph->IsEdge(1, 2) ? 0 : 1;
+  EXPECT_EQ(NewEdges, TSnap::AddEdgeBatch(Graph, EdgeV));
+  EXPECT_EQ(1,Graph->IsEdge(1, 2));
+}
+
+// Test the edge counter with unchecked additions and nodes added with their neighbors
+TEST(TNGraph, EdgeCounter) {
+  PNGraph Graph = TNGraph::New();
+  for (int i = 0; i < 4; i++) { Graph->AddNode(i); }
+  EXPECT_EQ(-1, Graph->AddNodeUnchecked(2));
+  EXPECT_EQ(7, Graph->AddNodeUnchecked(7));
+  Graph->AddEdgeUnchecked(0, 3);
+  Graph->AddEdgeUnchecked(0, 1);
+  Graph->AddEdgeUnchecked(0, 3);
+  Graph->AddEdgeUnchecked(2, 2);
+  EXPECT_EQ(4, Graph->GetEdges());
+  // duplicate edges are removed and the edges are recounted
+  Graph->SortNodeAdjV();
+  EXPECT_EQ(3, Graph->GetEdges());
+  EXPECT_EQ(1, Graph->IsOk());
+
+  // a node added with its neighbors counts its out-edges
+  TIntV InNIdV, OutNIdV;
+  InNIdV.Add(1);
+  OutNIdV.Add(3);  OutNIdV.Add(0);
+  EXPECT_EQ(5, Graph->AddNode(5, InNIdV, OutNIdV));
+  EXPECT_EQ(5, Graph->GetEdges());
+  Graph->DelNode(5);
+  Graph->DelNode(2);
+  EXPECT_EQ(2, Graph->GetEdges());
+
+  // TNGraph32 differs only in the type of the edge counter, which is not saved
+  PNGraph32 Graph32 = TNGraph32::New();
+  for (TNGraph::TNodeI NI = Graph->BegNI(); NI < Graph->EndNI(); NI++) { Graph32->AddNode(NI.GetId()); }
+  for (TNGraph::TEdgeI EI = Graph->BegEI(); EI < Graph->EndEI(); EI++) { Graph32->AddEdge(EI.GetSrcNId(), EI.GetDstNId()); }
+  TMOut MOut;
+  Graph32->Save(MOut);
+  PNGraph Graph1 = TNGraph::Load(*MOut.GetSIn());
+  EXPECT_EQ(Graph->GetNodes(), Graph1->GetNodes());
+  EXPECT_EQ(Graph->GetEdges(), Graph1->GetEdges());
+  for (TNGraph::TEdgeI EI = Graph->BegEI(); EI < Graph->EndEI(); EI++) {
+    EXPECT_TRUE(Graph1->IsEdge(EI.GetSrcNId(), EI.GetDstNId()));
+  }
+  EXPECT_EQ(1, Graph1->IsOk());
+}
@@ -289,4 +289,48 @@ TEST(TUNGraph, GetSmallGraph) {
   EXPECT_EQ(1,Graph->IsOk());
   EXPECT_EQ(0,Graph->Empty());
   EXPECT_EQ(0,Graph->HasFlag(gfDirected));
-}
\ No newline at end of file
+}
+
+// Test adding edges in batches
+TEST(TUNGraph, AddEdgeBatch) {
+  const int NNodes = 200;
+  PUNGraph Graph = TUNGraph::New();
+  PUNGraph Graph1 = TUNGraph::New();
+  for (int i = 0; i < NNodes; i++) {
+    Graph->AddNode(i);
+    Graph1->AddNode(i);
+  }
+
+  // a hub node, duplicates and self edges, added in two batches
+  TRnd Rnd(1);
+  for (int b = 0; b < 2; b++) {
+    TIntPrV EdgeV;
+    for (int e = 0; e < 3000; e++) {
+      const int SrcNId = e % 3 == 0 ? 0 : Rnd.GetUniDevInt(NNodes);
+      EdgeV.Add(TIntPr(SrcNId, Rnd.GetUniDevInt(NNodes)));
+    }
+    int NewEdges = 0;
+    for (int e = 0; e < EdgeV.Len(); e++) {
+      if (Graph1->AddEdge(EdgeV[e].Val1, EdgeV[e].Val2) != -2) { NewEdges++; }
+    }
+    EXPECT_EQ(NewEdges, Graph->AddEdgeBatch(EdgeV));
+    EXPECT_EQ(Graph1->GetEdges(), Graph->GetEdges());
+  }
+  EXPECT_EQ(1,Graph->IsOk());
+
+  for (TUNGraph::TNodeI NI = Graph->BegNI(); NI < Graph->EndNI(); NI++) {
+    TUNGraph::TNodeI NI1 = Graph1->GetNI(NI.GetId());
+    EXPECT_EQ(NI1.GetDeg(), NI.GetDeg());
+    for (int e = 0; e < NI.GetDeg(); e++) {
+      EXPECT_EQ(NI1.GetNbrNId(e), NI.GetNbrNId(e));
+    }
+  }
+
+  // generic version
+  TIntPrV EdgeV;
+  EdgeV.Add(TIntPr(1, 2));
+  EdgeV.Add(TIntPr(1, 2));
+  const int NewEdges = Graph->IsEdge(1, 2) ? 0 : 1;
+  EXPECT_EQ(NewEdges, TSnap::AddEdgeBatch(Graph, EdgeV));
+  EXPECT_EQ(1,Graph->IsEdge(1, 2));
+}
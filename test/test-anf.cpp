@@ -0,0 +1,141 @@
+#include <gtest/gtest.h>
+
+#include "Snap.h"
+
+// Returns the exact neighborhood function: number of pairs of nodes within H hops for every H
+template <class PGraph>
+static void GetExactAnf(const PGraph& Graph, const bool& IsDir, TFltV& NPairsV) {
+  NPairsV.Clr();
+  for (typename PGraph::TObj::TNodeI NI = Graph->BegNI(); NI < Graph->EndNI(); NI++) {
+    TIntH NIdDistH;
+    TSnap::GetShortPath(Graph, NI.GetId(), NIdDistH, IsDir);
+    for (int i = 0; i < NIdDistH.Len(); i++) {
+      const int Dist = NIdDistH[i];
+      while (NPairsV.Len() <= Dist) { NPairsV.Add(0); }
+      NPairsV[Dist]++;
+    }
+  }
+  for (int d = 1; d < NPairsV.Len(); d++) { NPairsV[d] += NPairsV[d-1]; }
+}
+
+// Checks the estimates against the exact counts, the relative error of a count is about 1.04/sqrt(Regs)
+static void CheckAnf(const TIntFltKdV& DistNbrsV, const TFltV& NPairsV, const int& Regs) {
+  const double MxErr = 3 * 1.04 / sqrt(double(Regs));
+  ASSERT_LT(0, DistNbrsV.Len());
+  EXPECT_EQ(0, DistNbrsV[0].Key);
+  EXPECT_DOUBLE_EQ(NPairsV[0], DistNbrsV[0].Dat);
+  for (int i = 1; i < DistNbrsV.Len(); i++) {
+    const int Dist = DistNbrsV[i].Key;
+    EXPECT_EQ(i, Dist);
+    const double Exact = NPairsV[TMath::Mn(Dist, NPairsV.Len()-1)];
+    EXPECT_NEAR(Exact, DistNbrsV[i].Dat, MxErr * Exact) << "Dist " << Dist;
+  }
+  // the iteration runs until the counters stop changing, about the diameter
+  EXPECT_LE(NPairsV.Len() - 3, DistNbrsV.Len());
+  EXPECT_GE(NPairsV.Len() + 1, DistNbrsV.Len());
+}
+
+// Returns true if both functions have the same values
+static bool IsEqAnf(const TIntFltKdV& DistNbrsV1, const TIntFltKdV& DistNbrsV2) {
+  if (DistNbrsV1.Len() != DistNbrsV2.Len()) { return false; }
+  for (int i = 0; i < DistNbrsV1.Len(); i++) {
+    if (DistNbrsV1[i].Key != DistNbrsV2[i].Key || DistNbrsV1[i].Dat != DistNbrsV2[i].Dat) { return false; }
+  }
+  return true;
+}
+
+// Test HyperANF against exact neighborhood counts
+TEST(THyperAnf, GetGraphAnf) {
+  TRnd Rnd(1);
+  PNGraph Graph = TSnap::GenRndGnm<PNGraph>(400, 1200, true, Rnd);
+  PUNGraph UGraph = TSnap::GenGrid<PUNGraph>(15, 20, false);
+  TFltV NPairsV;
+  TIntFltKdV DistNbrsV;
+  for (int Seed = 1; Seed <= 3; Seed++) {
+    THyperAnf Anf(Graph, 256, Seed);
+    EXPECT_EQ(256, Anf.GetRegs());
+    GetExactAnf(Graph, true, NPairsV);
+    Anf.GetGraphAnf(DistNbrsV, -1, true);
+    CheckAnf(DistNbrsV, NPairsV, 256);
+    GetExactAnf(Graph, false, NPairsV);
+    Anf.GetGraphAnf(DistNbrsV, -1, false);
+    CheckAnf(DistNbrsV, NPairsV, 256);
+
+    THyperAnf UAnf(UGraph, 256, Seed);
+    GetExactAnf(UGraph, false, NPairsV);
+    UAnf.GetGraphAnf(DistNbrsV, -1, false);
+    CheckAnf(DistNbrsV, NPairsV, 256);
+  }
+  // MxDist limits the number of steps
+  THyperAnf Anf(UGraph, 64, 1);
+  Anf.GetGraphAnf(DistNbrsV, 5, false);
+  EXPECT_EQ(5, DistNbrsV.Len());
+  // the number of registers is a power of 2, at least 16
+  EXPECT_EQ(16, THyperAnf(UGraph, 1, 1).GetRegs());
+  EXPECT_EQ(128, THyperAnf(UGraph, 100, 1).GetRegs());
+}
+
+// Test the neighborhood function of a single node
+TEST(THyperAnf, GetNodeAnf) {
+  PUNGraph Graph = TSnap::GenGrid<PUNGraph>(15, 20, false);
+  const int SrcNId = 0;
+  TIntH NIdDistH;
+  TSnap::GetShortPath(Graph, SrcNId, NIdDistH);
+  TFltV NNbrsV;
+  for (int i = 0; i < NIdDistH.Len(); i++) {
+    while (NNbrsV.Len() <= NIdDistH[i]) { NNbrsV.Add(0); }
+    NNbrsV[NIdDistH[i]]++;
+  }
+  for (int d = 1; d < NNbrsV.Len(); d++) { NNbrsV[d] += NNbrsV[d-1]; }
+  THyperAnf Anf(Graph, 256, 7);
+  TIntFltKdV DistNbrsV;
+  Anf.GetNodeAnf(SrcNId, DistNbrsV, -1, false);
+  EXPECT_DOUBLE_EQ(1, DistNbrsV[0].Dat);
+  const double MxErr = 3 * 1.04 / sqrt(256.0);
+  for (int i = 1; i < DistNbrsV.Len(); i++) {
+    const double Exact = NNbrsV[TMath::Mn(i, NNbrsV.Len()-1)];
+    EXPECT_NEAR(Exact, DistNbrsV[i].Dat, MxErr * Exact) << "Dist " << i;
+  }
+}
+
+#if defined(GLib_UNIX)
+// Test that the registers kept in a file give the same results as registers in memory
+TEST(THyperAnf, RegFile) {
+  TRnd Rnd(1);
+  PNGraph Graph = TSnap::GenRndGnm<PNGraph>(400, 1200, true, Rnd);
+  const TStr RegFNm = "test.hyperanf.dat";
+  TIntFltKdV DistNbrsV, FileDistNbrsV;
+  for (int Dir = 0; Dir < 2; Dir++) {
+    THyperAnf Anf(Graph, 64, 5);
+    Anf.GetGraphAnf(DistNbrsV, -1, Dir == 0);
+    THyperAnf FileAnf(Graph, 64, 5, RegFNm);
+    // the file is removed once it is mapped
+    EXPECT_FALSE(TFile::Exists(RegFNm));
+    FileAnf.GetGraphAnf(FileDistNbrsV, -1, Dir == 0);
+    EXPECT_TRUE(IsEqAnf(DistNbrsV, FileDistNbrsV));
+    // the registers are reset by every run
+    FileAnf.GetGraphAnf(FileDistNbrsV, -1, Dir == 0);
+    EXPECT_TRUE(IsEqAnf(DistNbrsV, FileDistNbrsV));
+    FileAnf.GetNodeAnf(3, FileDistNbrsV, -1, Dir == 0);
+    Anf.GetNodeAnf(3, DistNbrsV, -1, Dir == 0);
+    EXPECT_TRUE(IsEqAnf(DistNbrsV, FileDistNbrsV));
+  }
+  TFltV NPairsV;
+  GetExactAnf(Graph, true, NPairsV);
+  THyperAnf FileAnf(Graph, 256, 2, RegFNm);
+  FileAnf.GetGraphAnf(FileDistNbrsV, -1, true);
+  CheckAnf(FileDistNbrsV, NPairsV, 256);
+}
+#endif
+
+// Test the effective diameter against the exact one
+TEST(THyperAnf, GetAnfEffDiam) {
+  PUNGraph Graph = TSnap::GenGrid<PUNGraph>(15, 20, false);
+  TFltV NPairsV;
+  GetExactAnf(Graph, false, NPairsV);
+  TIntFltKdV ExactDistNbrsV;
+  for (int d = 0; d < NPairsV.Len(); d++) { ExactDistNbrsV.Add(TIntFltKd(d, NPairsV[d])); }
+  const double EffDiam = TSnap::TSnapDetail::CalcEffDiam(ExactDistNbrsV, 0.9);
+  EXPECT_NEAR(EffDiam, TSnap::GetAnfEffDiam(Graph, false, 0.9, 256), 0.15 * EffDiam);
+  EXPECT_NEAR(EffDiam, TSnap::GetAnfEffDiam(Graph), 0.25 * EffDiam);
+}
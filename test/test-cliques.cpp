@@ -0,0 +1,96 @@
+#include <gtest/gtest.h>
+
+#include "Snap.h"
+#include "cliques.h"
+
+// Sorts the nodes of every clique and then the cliques
+static void SortCliques(TVec<TIntV>& CliqueV) {
+  for (int c = 0; c < CliqueV.Len(); c++) { CliqueV[c].Sort(); }
+  CliqueV.Sort();
+}
+
+// Checks the parallel enumeration against the sequential TCliqueOverlap::GetMaximalCliques()
+static void CheckMaxCliques(const PUNGraph& Graph, const int& MinSize) {
+  TVec<TIntV> CliqueV, SeqCliqueV;
+  TCliqueOverlap::GetMaxCliques(Graph, MinSize, CliqueV);
+  TCliqueOverlap CliqueOverlap;
+  CliqueOverlap.GetMaximalCliques(Graph, MinSize, SeqCliqueV);
+  SortCliques(CliqueV);
+  SortCliques(SeqCliqueV);
+  ASSERT_EQ(SeqCliqueV.Len(), CliqueV.Len()) << "MinSize " << MinSize;
+  for (int c = 0; c < CliqueV.Len(); c++) {
+    ASSERT_EQ(SeqCliqueV[c], CliqueV[c]) << "MinSize " << MinSize;
+  }
+}
+
+// Returns the number of nodes the cliques share
+static int GetOverlap(const TIntV& CliqueV1, const TIntV& CliqueV2) {
+  TIntV NIdV1 = CliqueV1, NIdV2 = CliqueV2;
+  NIdV1.Sort();  NIdV2.Sort();
+  return NIdV1.IntrsLen(NIdV2);
+}
+
+// Test the parallel enumeration on random graphs
+TEST(TCliqueOverlap, GetMaxCliques) {
+  TRnd Rnd(11);
+  const int Edges[] = {0, 300, 1500, 4000};
+  for (int g = 0; g < 4; g++) {
+    PUNGraph Graph = TSnap::GenRndGnm<PUNGraph>(150, Edges[g], false, Rnd);
+    for (int MinSize = 1; MinSize <= 5; MinSize++) {
+      CheckMaxCliques(Graph, MinSize);
+    }
+  }
+}
+
+// Test the parallel enumeration when the searches have more than 1024 candidate
+// and excluded nodes and the bitsets are not used
+TEST(TCliqueOverlap, GetMaxCliquesHub) {
+  TRnd Rnd(13);
+  const int Spokes = 1100, Hubs = 4;
+  PUNGraph Graph = TSnap::GenRndGnm<PUNGraph>(Spokes, 3000, false, Rnd);
+  for (int h = 0; h < Hubs; h++) {
+    const int HubNId = Spokes + h;
+    Graph->AddNode(HubNId);
+    for (int n = 0; n < Spokes; n++) { Graph->AddEdge(HubNId, n); }
+    for (int h1 = 0; h1 < h; h1++) { Graph->AddEdge(HubNId, Spokes + h1); }
+  }
+  EXPECT_LT(1024, Graph->GetNI(Spokes).GetDeg());
+  for (int MinSize = 1; MinSize <= Hubs + 3; MinSize += 2) {
+    CheckMaxCliques(Graph, MinSize);
+  }
+  TMaxCliqueEnum CliqueEnum(Graph);
+  EXPECT_EQ(Graph->GetNodes(), CliqueEnum.GetNodes());
+  EXPECT_LE(Hubs, CliqueEnum.GetDegeneracy());
+}
+
+// Test both overlap computations against the pairwise intersection of the cliques
+TEST(TCliqueOverlap, CalculateOverlapMtx) {
+  TRnd Rnd(17);
+  PUNGraph Graph = TSnap::GenRndGnm<PUNGraph>(120, 1000, false, Rnd);
+  TVec<TIntV> CliqueV;
+  TCliqueOverlap::GetMaxCliques(Graph, 2, CliqueV);
+  const int Cliques = CliqueV.Len();
+  ASSERT_LT(100, Cliques);
+  for (int MinOverlap = 0; MinOverlap <= 3; MinOverlap++) {
+    TVec<TIntV> OverlapMtx;
+    TCliqueOverlap::CalculateOverlapMtx(CliqueV, MinOverlap, OverlapMtx);
+    PUNGraph OverlapGraph = TCliqueOverlap::CalculateOverlapMtx(CliqueV, MinOverlap);
+    ASSERT_EQ(Cliques, OverlapMtx.Len());
+    EXPECT_EQ(Cliques, OverlapGraph->GetNodes());
+    int OverlapEdges = 0;
+    for (int i = 0; i < Cliques; i++) {
+      ASSERT_EQ(Cliques, OverlapMtx[i].Len());
+      const bool IsBig = CliqueV[i].Len() >= MinOverlap;
+      EXPECT_EQ(IsBig ? CliqueV[i].Len() : 0, OverlapMtx[i][i]);
+      for (int j = i+1; j < Cliques; j++) {
+        const int Overlap = GetOverlap(CliqueV[i], CliqueV[j]);
+        const bool IsPairBig = IsBig && CliqueV[j].Len() >= MinOverlap;
+        ASSERT_EQ(IsPairBig ? Overlap : 0, OverlapMtx[i][j]) << i << " " << j;
+        ASSERT_EQ(0, OverlapMtx[j][i]);
+        ASSERT_EQ(Overlap >= MinOverlap, OverlapGraph->IsEdge(i, j)) << i << " " << j;
+        if (Overlap >= MinOverlap) { OverlapEdges++; }
+      }
+    }
+    EXPECT_EQ(OverlapEdges, OverlapGraph->GetEdges());
+  }
+}
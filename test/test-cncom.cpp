@@ -305,3 +305,50 @@ TEST(CnComTest, CompleteGraph) {
   Get1CnCom(G, Cn1ComV);
   EXPECT_TRUE(Cn1ComV.Len() == 0);
 }
+
+#ifdef USE_OPENMP
+// Parallel components must match the sequential ones
+template <class PGraph>
+void TestCnComMP(const PGraph& G) {
+  TCnComV CnComV, CnComMPV;
+  TIntPrV SzCntV, SzCntMPV;
+  GetWccs(G, CnComV);
+  GetWccsMP(G, CnComMPV);
+  EXPECT_TRUE(CnComV == CnComMPV);
+  GetWccSzCnt(G, SzCntV);
+  GetWccSzCntMP(G, SzCntMPV);
+  EXPECT_TRUE(SzCntV == SzCntMPV);
+  GetSccs(G, CnComV);
+  GetSccsMP(G, CnComMPV);
+  EXPECT_EQ(CnComV.Len(), CnComMPV.Len());
+  for (int c = 0; c < CnComV.Len(); c++) { CnComV[c].Sort(); }
+  CnComV.Sort(false);
+  EXPECT_TRUE(CnComV == CnComMPV);
+  GetSccSzCnt(G, SzCntV);
+  GetSccSzCntMP(G, SzCntMPV);
+  EXPECT_TRUE(SzCntV == SzCntMPV);
+}
+
+TEST(CnComTest, ParallelComponents) {
+  TestCnComMP(LoadEdgeList<PNGraph>(TStr::Fmt("%s/sample_cncom_ngraph.txt", DIRNAME)));
+  TestCnComMP(LoadEdgeList<PUNGraph>(TStr::Fmt("%s/sample_cncom_unpower.txt", DIRNAME)));
+  TestCnComMP(GenRndGnm<PNGraph>(2000, 2500));
+  TestCnComMP(GenRndGnm<PNGraph>(2000, 6000));
+  TestCnComMP(GenRndGnm<PUNGraph>(2000, 1500));
+  TestCnComMP(GenRndGnm<PNEANet>(1000, 1500));
+
+  // long path of 2-cycles followed by a long directed chain
+  const int NNodes = 20000;
+  PNGraph G = TNGraph::New();
+  for (int n = 0; n < NNodes; n++) { G->AddNode(n); }
+  for (int n = 0; n+1 < NNodes; n++) {
+    G->AddEdge(n, n+1);
+    if (n < NNodes/2) { G->AddEdge(n+1, n); }
+  }
+  TestCnComMP(G);
+  TIntPrV SzCntV;
+  GetSccSzCntMP(G, SzCntV);
+  EXPECT_TRUE(SzCntV[0] == TIntPr(1, NNodes/2-1));
+  EXPECT_TRUE(SzCntV[1] == TIntPr(NNodes/2+1, 1));
+}
+#endif // USE_OPENMP
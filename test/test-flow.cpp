@@ -44,3 +44,53 @@ TEST(FlowTest, BasicTest) {
   EXPECT_EQ (PRFlow3, 2074);
   EXPECT_EQ (PRFlow4, 0);
 }
+
+TEST(FlowTest, FlowNetMinCut) {
+  PNEANet Net;
+  BuildCapacityNetwork("flow/small_sample.txt", Net);
+  const int CapIndex = Net->GetIntAttrIndE(TSnap::CapAttrName);
+  TFlowNet FlowNet(Net);
+  const int SrcNIdV[] = {53, 86, 62, 92};
+  const int SnkNIdV[] = {2, 77, 81, 92};
+  const int FlowV[] = {1735, 3959, 2074, 0};
+  for (int q = 0; q < 4; q++) {
+    EXPECT_EQ(FlowNet.GetMaxFlow(SrcNIdV[q], SnkNIdV[q]), FlowV[q]);
+    TIntV SrcSideNIdV, CutEIdV;
+    FlowNet.GetMinCut(SrcSideNIdV, CutEIdV);
+    if (SrcNIdV[q] == SnkNIdV[q]) { continue; }
+    // the cut separates source and sink and its capacity equals the flow
+    TIntSet SrcSideSet(SrcSideNIdV);
+    EXPECT_TRUE(SrcSideSet.IsKey(SrcNIdV[q]));
+    EXPECT_FALSE(SrcSideSet.IsKey(SnkNIdV[q]));
+    int CutCap = 0;
+    for (int e = 0; e < CutEIdV.Len(); e++) {
+      const TNEANet::TEdgeI EI = Net->GetEI(CutEIdV[e]);
+      EXPECT_TRUE(SrcSideSet.IsKey(EI.GetSrcNId()));
+      EXPECT_FALSE(SrcSideSet.IsKey(EI.GetDstNId()));
+      CutCap += Net->GetIntAttrIndDatE(CutEIdV[e], CapIndex);
+    }
+    EXPECT_EQ(CutCap, FlowV[q]);
+  }
+  TIntV SrcSideNIdV, CutEIdV;
+  EXPECT_EQ(TSnap::GetMinCutInt(Net, 53, 2, SrcSideNIdV, CutEIdV), 1735);
+#ifdef USE_OPENMP
+  EXPECT_EQ(TSnap::GetMaxFlowIntPRMP(Net, 53, 2), 1735);
+  EXPECT_EQ(TSnap::GetMaxFlowIntPRMP(Net, 86, 77), 3959);
+  EXPECT_EQ(TSnap::GetMaxFlowIntPRMP(Net, 62, 81), 2074);
+  EXPECT_EQ(TSnap::GetMaxFlowIntPRMP(Net, 92, 92), 0);
+  // random networks against Edmonds-Karp
+  TRnd Rnd(7);
+  for (int t = 0; t < 5; t++) {
+    PNEANet RndNet = TNEANet::New();
+    for (int n = 0; n < 200; n++) { RndNet->AddNode(n); }
+    for (int e = 0; e < 2000; e++) {
+      const int EId = RndNet->AddEdge(Rnd.GetUniDevInt(200), Rnd.GetUniDevInt(200));
+      RndNet->AddIntAttrDatE(EId, Rnd.GetUniDevInt(100), TSnap::CapAttrName);
+    }
+    TFlowNet RndFlowNet(RndNet);
+    const int EKFlow = TSnap::GetMaxFlowIntEK(RndNet, 0, 1);
+    EXPECT_EQ(RndFlowNet.GetMaxFlow(0, 1), EKFlow);
+    EXPECT_EQ(RndFlowNet.GetMaxFlowMP(0, 1), EKFlow);
+  }
+#endif
+}
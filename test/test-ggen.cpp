@@ -888,6 +888,86 @@ TEST(GGenTest, GenRMat) {
   } // end loop - NNodes
 }
 
+// Test out-of-core R-MAT generator
+TEST(GGenTest, RMatGen) {
+  const int Scale = 10;
+  const int64 Edges = 5 * TRMatGen::BlockEdges / 2;
+  TRMatGen RMat(Scale, Edges, 0.45, 0.15, 0.15, 7, 0.05, true);
+  EXPECT_EQ(1 << Scale, RMat.GetNodes());
+  EXPECT_EQ(3, RMat.GetBlocks());
+
+  // labels are a permutation of the node ids
+  TIntV PermV;
+  for (int NId = 0; NId < RMat.GetNodes(); NId++) {
+    PermV.Add(RMat.GetPermNId(NId));
+  }
+  PermV.Sort();
+  for (int NId = 0; NId < RMat.GetNodes(); NId++) {
+    EXPECT_EQ(NId, PermV[NId]);
+  }
+
+  // blocks depend only on the parameters
+  TIntPrV EdgeV, EdgeV1;
+  TIntPrSet EdgeSet;
+  for (int64 BlockN = 0; BlockN < RMat.GetBlocks(); BlockN++) {
+    RMat.GetBlock(BlockN, EdgeV);
+    RMat.GetBlock(BlockN, EdgeV1);
+    EXPECT_TRUE(EdgeV == EdgeV1);
+    EXPECT_EQ(BlockN+1 < RMat.GetBlocks() ? TRMatGen::BlockEdges : Edges % TRMatGen::BlockEdges, EdgeV.Len());
+    for (int e = 0; e < EdgeV.Len(); e++) {
+      EXPECT_TRUE(EdgeV[e].Val1 >= 0 && EdgeV[e].Val1 < RMat.GetNodes());
+      EXPECT_TRUE(EdgeV[e].Val2 >= 0 && EdgeV[e].Val2 < RMat.GetNodes());
+      if (EdgeV[e].Val1 != EdgeV[e].Val2) { EdgeSet.AddKey(EdgeV[e]); }
+    }
+  }
+  TRMatGen RMat1(Scale, Edges, 0.45, 0.15, 0.15, 8, 0.05, true);
+  RMat1.GetBlock(0, EdgeV1);
+  RMat.GetBlock(0, EdgeV);
+  EXPECT_FALSE(EdgeV == EdgeV1);
+
+  // directed rows hold the distinct edges of the stream
+  TVec<TInt64> OffV;
+  TVec<TInt, int64> NbrV;
+  RMat.GetCsr(true, OffV, NbrV);
+  EXPECT_EQ(RMat.GetNodes() + 1, OffV.Len());
+  EXPECT_EQ(EdgeSet.Len(), NbrV.Len());
+  for (int NId = 0; NId < RMat.GetNodes(); NId++) {
+    for (int64 i = OffV[NId]; i < OffV[NId+1]; i++) {
+      EXPECT_TRUE(EdgeSet.IsKey(TIntPr(NId, NbrV[i])));
+      if (i > OffV[NId]) { EXPECT_LT(NbrV[i-1], NbrV[i]); }
+    }
+  }
+
+  // undirected rows are symmetric
+  RMat.GetCsr(false, OffV, NbrV);
+  TIntPrSet UEdgeSet;
+  for (int NId = 0; NId < RMat.GetNodes(); NId++) {
+    for (int64 i = OffV[NId]; i < OffV[NId+1]; i++) {
+      const int Nbr = NbrV[i];
+      EXPECT_TRUE(EdgeSet.IsKey(TIntPr(NId, Nbr)) || EdgeSet.IsKey(TIntPr(Nbr, NId)));
+      UEdgeSet.AddKey(TIntPr(NId, Nbr));
+    }
+  }
+  for (int KeyId = UEdgeSet.FFirstKeyId(); UEdgeSet.FNextKeyId(KeyId); ) {
+    const TIntPr& Edge = UEdgeSet.GetKey(KeyId);
+    EXPECT_TRUE(UEdgeSet.IsKey(TIntPr(Edge.Val2, Edge.Val1)));
+  }
+
+  // the file built in node ranges equals the rows built in memory
+  TVec<TInt64> OffV1;
+  TVec<TInt, int64> NbrV1;
+  RMat.SaveCsr("test.rmat.dat", false, Edges / 5);
+  TRMatGen::LoadCsr("test.rmat.dat", OffV1, NbrV1);
+  EXPECT_TRUE(OffV == OffV1);
+  EXPECT_TRUE(NbrV == NbrV1);
+
+  RMat.SaveBinEdges("test.rmat.dat");
+  EXPECT_EQ(Edges * 2 * (int64) sizeof(int), (int64) TFIn("test.rmat.dat").Len());
+  TFile::Del("test.rmat.dat");
+  // missing files are reported with an exception
+  EXPECT_THROW(TRMatGen::LoadCsr("test.rmat.missing.dat", OffV1, NbrV1), PExcept);
+}
+
 template <class PGraph> void TestRewire(const PGraph& Graph) {
   PGraph GraphOut;
   TIntPrV DegToCntV;
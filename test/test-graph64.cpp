@@ -0,0 +1,235 @@
+#include <gtest/gtest.h>
+
+#include "Snap.h"
+
+// Node ids beyond the int range
+static const int64 BigNId = int64(1) << 33;
+
+// Test node, edge creation with 64-bit node ids
+TEST(TNGraph64, ManipulateNodesEdges) {
+  PNGraph64 Graph = TNGraph64::New();
+  for (int i = 0; i < 6; i++) {
+    EXPECT_EQ(BigNId + i, Graph->AddNode(BigNId + i));
+  }
+  EXPECT_EQ(BigNId + 6, Graph->AddNode());
+  EXPECT_EQ(7, Graph->GetNodes());
+
+  Graph->AddEdge(BigNId, BigNId + 1);
+  Graph->AddEdge(BigNId + 1, BigNId + 2);
+  Graph->AddEdge(BigNId + 2, BigNId);
+  Graph->AddEdge(BigNId + 2, BigNId + 3);
+  Graph->AddEdge(BigNId + 4, BigNId + 5);
+  EXPECT_EQ(-2, Graph->AddEdge(BigNId + 4, BigNId + 5));
+  EXPECT_EQ(5, Graph->GetEdges());
+  EXPECT_TRUE(Graph->IsEdge(BigNId + 2, BigNId + 3));
+  EXPECT_FALSE(Graph->IsEdge(BigNId + 3, BigNId + 2));
+  EXPECT_TRUE(Graph->IsEdge(BigNId + 3, BigNId + 2, false));
+  EXPECT_EQ(2, Graph->GetNI(BigNId + 2).GetOutDeg());
+  EXPECT_TRUE(Graph->IsOk());
+
+  int64 EdgeCnt = 0;
+  for (TNGraph64::TEdgeI EI = Graph->BegEI(); EI < Graph->EndEI(); EI++) {
+    EXPECT_TRUE(Graph->IsEdge(EI.GetSrcNId(), EI.GetDstNId()));
+    EdgeCnt++;
+  }
+  EXPECT_EQ(5, EdgeCnt);
+
+  Graph->DelNode(BigNId + 2);
+  EXPECT_EQ(6, Graph->GetNodes());
+  EXPECT_EQ(2, Graph->GetEdges());
+  EXPECT_TRUE(Graph->IsOk());
+}
+
+// Test batch and unchecked edge insertion
+TEST(TNGraph64, AddEdgeBatch) {
+  PNGraph64 Graph1 = TNGraph64::New();
+  PNGraph64 Graph2 = TNGraph64::New();
+  TNGraph64::TNIdPrV EdgeV;
+  for (int i = 0; i < 100; i++) {
+    Graph1->AddNode(BigNId + i);
+    Graph2->AddNode(BigNId + i);
+  }
+  for (int i = 0; i < 100; i++) {
+    for (int j = 1; j < 4; j++) {
+      EdgeV.Add(TPair<TInt64, TInt64>(BigNId + i, BigNId + (i * j + 7) % 100));
+      Graph2->AddEdgeUnchecked(BigNId + i, BigNId + (i * j + 7) % 100);
+    }
+  }
+  // duplicates are dropped
+  EdgeV.Add(EdgeV[0]);
+  Graph2->AddEdgeUnchecked(EdgeV[0].Val1, EdgeV[0].Val2);
+  TSnap::AddEdgeBatch(Graph1, EdgeV);
+  Graph2->SortNodeAdjV();
+  EXPECT_TRUE(Graph1->IsOk());
+  EXPECT_TRUE(Graph2->IsOk());
+  EXPECT_EQ(Graph1->GetEdges(), Graph2->GetEdges());
+  for (TNGraph64::TEdgeI EI = Graph1->BegEI(); EI < Graph1->EndEI(); EI++) {
+    EXPECT_TRUE(Graph2->IsEdge(EI.GetSrcNId(), EI.GetDstNId()));
+  }
+}
+
+// Test the compact graph with int node ids
+TEST(TNGraph32, ManipulateNodesEdges) {
+  PNGraph32 Graph = TNGraph32::New();
+  for (int i = 0; i < 10; i++) { Graph->AddNode(i); }
+  for (int i = 0; i < 10; i++) { Graph->AddEdge(i, (i + 1) % 10); }
+  EXPECT_EQ(10, Graph->GetEdges());
+  EXPECT_EQ(1, Graph->GetNI(3).GetInDeg());
+  EXPECT_TRUE(Graph->IsOk());
+  EXPECT_EQ(10, TSnap::GetMxSccSz(Graph) * Graph->GetNodes());
+}
+
+// Test undirected graph with 64-bit node ids
+TEST(TUNGraph64, ManipulateNodesEdges) {
+  PUNGraph64 Graph = TUNGraph64::New();
+  for (int i = 0; i < 4; i++) { Graph->AddNode(BigNId + i); }
+  Graph->AddEdge(BigNId, BigNId + 1);
+  Graph->AddEdge(BigNId + 1, BigNId + 2);
+  Graph->AddEdge(BigNId + 2, BigNId);
+  Graph->AddEdge(BigNId + 3, BigNId + 3);
+  Graph->AddEdge(BigNId + 1, BigNId);
+  EXPECT_EQ(4, Graph->GetEdges());
+  EXPECT_TRUE(Graph->IsEdge(BigNId + 1, BigNId));
+  EXPECT_TRUE(Graph->IsOk());
+  EXPECT_EQ(1, TSnap::GetCmnNbrs(Graph, BigNId, BigNId + 1));
+
+  Graph->DelEdge(BigNId, BigNId + 1);
+  EXPECT_EQ(3, Graph->GetEdges());
+  EXPECT_EQ(1, TSnap::GetCmnNbrs(Graph, BigNId, BigNId + 1));
+  EXPECT_TRUE(Graph->IsOk());
+}
+
+// Test multigraph with 64-bit node and edge ids
+TEST(TNEGraph64, ManipulateNodesEdges) {
+  PNEGraph64 Graph = TNEGraph64::New();
+  Graph->AddNode(BigNId);
+  Graph->AddNode(BigNId + 1);
+  EXPECT_EQ(0, Graph->AddEdge(BigNId, BigNId + 1));
+  EXPECT_EQ(1, Graph->AddEdge(BigNId, BigNId + 1));
+  EXPECT_EQ(2, Graph->AddEdge(BigNId + 1, BigNId));
+  EXPECT_EQ(3, Graph->GetEdges());
+  EXPECT_EQ(2, Graph->GetNI(BigNId).GetOutDeg());
+  EXPECT_EQ(BigNId + 1, Graph->GetEI(1).GetDstNId());
+  EXPECT_TRUE(Graph->IsOk());
+
+  Graph->DelEdge(0);
+  EXPECT_FALSE(Graph->IsEdge(0));
+  EXPECT_EQ(2, Graph->GetEdges());
+  // explicit edge ids reuse deleted ids or take the next one
+  EXPECT_EQ(3, Graph->GetMxEId());
+  EXPECT_EQ(0, Graph->AddEdge(BigNId + 1, BigNId + 1, 0));
+  EXPECT_EQ(3, Graph->AddEdge(BigNId, BigNId, 3));
+  EXPECT_EQ(4, Graph->GetMxEId());
+  EXPECT_EQ(4, Graph->GetEdges());
+  EXPECT_EQ(BigNId + 1, Graph->GetEI(0).GetSrcNId());
+  EXPECT_TRUE(Graph->IsOk());
+  Graph->DelNode(BigNId + 1);
+  EXPECT_EQ(1, Graph->GetEdges());
+  EXPECT_TRUE(Graph->IsOk());
+}
+
+// Test loading an edge list with 64-bit node ids
+TEST(TNGraph64, LoadEdgeList) {
+  const char *FName = "test.graph64.dat";
+  FILE* F = fopen(FName, "w");
+  fprintf(F, "# Directed graph\n8589934592\t8589934593\n8589934593\t3\n3\t8589934592\n");
+  fclose(F);
+
+  PNGraph64 Graph = TSnap::LoadEdgeList<PNGraph64>(FName, 0, 1);
+  EXPECT_EQ(3, Graph->GetNodes());
+  EXPECT_EQ(3, Graph->GetEdges());
+  EXPECT_TRUE(Graph->IsEdge(BigNId, BigNId + 1));
+  EXPECT_TRUE(Graph->IsEdge(3, BigNId));
+  EXPECT_TRUE(Graph->IsOk());
+}
+
+// Test algorithms on graphs with 64-bit node ids
+TEST(TNGraph64, Algorithms) {
+  PNGraph64 Graph = TNGraph64::New();
+  for (int i = 0; i < 6; i++) { Graph->AddNode(BigNId + i); }
+  Graph->AddEdge(BigNId, BigNId + 1);
+  Graph->AddEdge(BigNId + 1, BigNId + 2);
+  Graph->AddEdge(BigNId + 2, BigNId);
+  Graph->AddEdge(BigNId + 2, BigNId + 3);
+  Graph->AddEdge(BigNId + 4, BigNId + 5);
+
+  THash<TInt64, TInt> NIdDistH;
+  EXPECT_EQ(3, TSnap::GetShortPath(Graph, BigNId, NIdDistH, true));
+  EXPECT_EQ(4, NIdDistH.Len());
+  EXPECT_EQ(3, NIdDistH.GetDat(BigNId + 3));
+
+  TIntPrV SzCntV;
+  TSnap::GetWccSzCnt(Graph, SzCntV);
+  EXPECT_EQ(2, SzCntV.Len());
+  EXPECT_EQ(4, SzCntV.Last().Val1);
+  EXPECT_DOUBLE_EQ(0.5, TSnap::GetMxSccSz(Graph));
+  EXPECT_TRUE(TSnap::IsConnected(Graph) == false);
+
+  THash<TInt64, TFlt> PRankH;
+  TSnap::GetPageRank(Graph, PRankH);
+  EXPECT_EQ(6, PRankH.Len());
+  double PRankSum = 0;
+  for (int i = 0; i < PRankH.Len(); i++) { PRankSum += PRankH[i]; }
+  EXPECT_NEAR(1.0, PRankSum, 1e-6);
+
+  int64 ClosedTriads, OpenTriads;
+  TSnap::GetTriads(Graph, ClosedTriads, OpenTriads);
+  EXPECT_EQ(1, ClosedTriads);
+  EXPECT_EQ(2, OpenTriads);
+  EXPECT_EQ(1, TSnap::GetNodeTriads(Graph, BigNId + 2));
+}
+
+// Test connected components on graphs with node ids above 2^31
+TEST(TNGraph64, CnCom) {
+  PNGraph64 Graph = TNGraph64::New();
+  for (int i = 0; i < 7; i++) { Graph->AddNode(BigNId + i); }
+  Graph->AddEdge(BigNId, BigNId + 1);
+  Graph->AddEdge(BigNId + 1, BigNId + 2);
+  Graph->AddEdge(BigNId + 2, BigNId);
+  Graph->AddEdge(BigNId + 2, BigNId + 3);
+  Graph->AddEdge(BigNId + 4, BigNId + 5);
+
+  TCnCom64V WCnComV;
+  TSnap::GetWccs(Graph, WCnComV);
+  ASSERT_EQ(3, WCnComV.Len());
+  EXPECT_EQ(4, WCnComV[0].Len());
+  EXPECT_EQ(BigNId, WCnComV[0][0].Val);
+  EXPECT_EQ(BigNId + 3, WCnComV[0][3].Val);
+  EXPECT_TRUE(WCnComV[0].IsNIdIn(BigNId + 2));
+  EXPECT_FALSE(WCnComV[0].IsNIdIn(BigNId + 4));
+  EXPECT_EQ(2, WCnComV[1].Len());
+  EXPECT_EQ(BigNId + 4, WCnComV[1][0].Val);
+  EXPECT_EQ(1, WCnComV[2].Len());
+  EXPECT_EQ(BigNId + 6, WCnComV[2][0].Val);
+
+  TCnCom64V SCnComV;
+  TSnap::GetSccs(Graph, SCnComV);
+  ASSERT_EQ(5, SCnComV.Len());
+  SCnComV[0].Sort();
+  EXPECT_EQ(3, SCnComV[0].Len());
+  EXPECT_EQ(BigNId, SCnComV[0][0].Val);
+  EXPECT_EQ(BigNId + 2, SCnComV[0][2].Val);
+  for (int c = 1; c < SCnComV.Len(); c++) {
+    EXPECT_EQ(1, SCnComV[c].Len());
+  }
+}
+
+TEST(TUNGraph64, CnCom) {
+  PUNGraph64 Graph = TUNGraph64::New();
+  for (int i = 0; i < 5; i++) { Graph->AddNode(BigNId + i); }
+  Graph->AddEdge(BigNId, BigNId + 1);
+  Graph->AddEdge(BigNId + 1, BigNId + 2);
+  Graph->AddEdge(BigNId + 3, BigNId + 4);
+
+  TCnCom64V WCnComV;
+  TSnap::GetWccs(Graph, WCnComV);
+  ASSERT_EQ(2, WCnComV.Len());
+  EXPECT_EQ(3, WCnComV[0].Len());
+  EXPECT_EQ(BigNId + 1, WCnComV[0][1].Val);
+  EXPECT_EQ(2, WCnComV[1].Len());
+
+  TCnCom64V SCnComV;
+  TSnap::GetSccs(Graph, SCnComV);
+  ASSERT_EQ(2, SCnComV.Len());
+  EXPECT_EQ(3, SCnComV[0].Len());
+}
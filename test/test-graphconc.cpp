@@ -0,0 +1,124 @@
+#include <gtest/gtest.h>
+
+#include "Snap.h"
+
+#ifdef GCC_ATOMIC
+
+// Checks that the two graphs have the same nodes and edges
+static void ExpectSameGraph(const PNGraph& Graph, const PNGraph& Snapshot) {
+  EXPECT_EQ(Graph->GetNodes(), Snapshot->GetNodes());
+  EXPECT_EQ(Graph->GetEdges(), Snapshot->GetEdges());
+  for (TNGraph::TNodeI NI = Graph->BegNI(); NI < Graph->EndNI(); NI++) {
+    ASSERT_TRUE(Snapshot->IsNode(NI.GetId()));
+    const TNGraph::TNodeI SnapNI = Snapshot->GetNI(NI.GetId());
+    ASSERT_EQ(NI.GetInDeg(), SnapNI.GetInDeg());
+    ASSERT_EQ(NI.GetOutDeg(), SnapNI.GetOutDeg());
+    for (int e = 0; e < NI.GetInDeg(); e++) { EXPECT_EQ(NI.GetInNId(e), SnapNI.GetInNId(e)); }
+    for (int e = 0; e < NI.GetOutDeg(); e++) { EXPECT_EQ(NI.GetOutNId(e), SnapNI.GetOutNId(e)); }
+  }
+}
+
+// Test adding and deleting nodes and edges from one thread
+TEST(TNGraphConc, AddDel) {
+  PNGraphConc Graph = TNGraphConc::New(4);
+  EXPECT_EQ(4, Graph->GetStripes());
+  EXPECT_EQ(0, Graph->AddNode());
+  EXPECT_EQ(1, Graph->AddNode());
+  EXPECT_EQ(10, Graph->AddNode(10));
+  EXPECT_EQ(11, Graph->GetMxNId());
+  EXPECT_EQ(10, Graph->AddNodeUnchecked(10));
+  EXPECT_EQ(3, Graph->GetNodes());
+
+  EXPECT_EQ(-1, Graph->AddEdge(0, 1));
+  EXPECT_EQ(-2, Graph->AddEdge(0, 1));
+  EXPECT_EQ(-1, Graph->AddEdge(10, 1));
+  EXPECT_EQ(-1, Graph->AddEdge(10, 10));
+  EXPECT_EQ(-1, Graph->AddEdge2(1, 5));
+  EXPECT_EQ(4, Graph->GetNodes());
+  EXPECT_EQ(4, Graph->GetEdges());
+  EXPECT_TRUE(Graph->IsEdge(0, 1));
+  EXPECT_FALSE(Graph->IsEdge(1, 0));
+  EXPECT_EQ(2, Graph->GetInDeg(1));
+  EXPECT_EQ(-1, Graph->GetInDeg(7));
+
+  TIntV NIdV;
+  EXPECT_TRUE(Graph->GetInNIdV(1, NIdV));
+  EXPECT_EQ(2, NIdV.Len());
+  EXPECT_EQ(0, NIdV[0]);
+  EXPECT_EQ(10, NIdV[1]);
+
+  Graph->DelEdge(0, 1);
+  Graph->DelEdge(0, 1);
+  EXPECT_FALSE(Graph->IsEdge(0, 1));
+  EXPECT_EQ(3, Graph->GetEdges());
+
+  Graph->DelNode(10);
+  EXPECT_FALSE(Graph->IsNode(10));
+  EXPECT_EQ(3, Graph->GetNodes());
+  EXPECT_EQ(1, Graph->GetEdges());
+  EXPECT_EQ(0, Graph->GetInDeg(1));
+
+  Graph->Clr();
+  EXPECT_EQ(0, Graph->GetNodes());
+  EXPECT_EQ(0, Graph->GetEdges());
+}
+
+// Test adding edges from many threads
+TEST(TNGraphConc, ParallelAddEdge) {
+  TRnd Rnd(1);
+  const PNGraph Graph = TSnap::GenRndGnm<PNGraph>(2000, 20000, true, Rnd);
+  TIntPrV EdgeV;
+  for (TNGraph::TEdgeI EI = Graph->BegEI(); EI < Graph->EndEI(); EI++) {
+    EdgeV.Add(TIntPr(EI.GetSrcNId(), EI.GetDstNId()));
+  }
+  PNGraphConc ConcGraph = TNGraphConc::New(16);
+  #pragma omp parallel for schedule(dynamic, 100) num_threads(4)
+  for (int i = 0; i < EdgeV.Len(); i++) {
+    ConcGraph->AddEdge2(EdgeV[i].Val1, EdgeV[i].Val2);
+    // every edge is added twice, once by another thread
+    ConcGraph->AddEdge2(EdgeV[EdgeV.Len()-1-i].Val1, EdgeV[EdgeV.Len()-1-i].Val2);
+  }
+  EXPECT_EQ(Graph->GetEdges(), ConcGraph->GetEdges());
+  ExpectSameGraph(Graph, ConcGraph->GetSnapshot());
+
+  #pragma omp parallel for schedule(dynamic, 100) num_threads(4)
+  for (int i = 0; i < EdgeV.Len(); i += 2) {
+    ConcGraph->DelEdge(EdgeV[i].Val1, EdgeV[i].Val2);
+  }
+  for (int i = 0; i < EdgeV.Len(); i += 2) {
+    Graph->DelEdge(EdgeV[i].Val1, EdgeV[i].Val2);
+  }
+  ExpectSameGraph(Graph, ConcGraph->GetSnapshot());
+}
+
+// Test that a snapshot does not change when the graph is updated
+TEST(TNGraphConc, Snapshot) {
+  PNGraphConc ConcGraph = TNGraphConc::New(8);
+  for (int i = 0; i < 100; i++) {
+    ConcGraph->AddEdge2(i, (i + 1) % 100);
+  }
+  const PNGraph Snapshot = ConcGraph->GetSnapshot();
+  EXPECT_TRUE(Snapshot->IsOk());
+  EXPECT_EQ(100, Snapshot->GetNodes());
+  EXPECT_EQ(100, Snapshot->GetEdges());
+
+  #pragma omp parallel for num_threads(4)
+  for (int i = 0; i < 100; i++) {
+    ConcGraph->AddEdge2(i, (i + 2) % 100);
+    ConcGraph->DelEdge(i, (i + 1) % 100);
+  }
+  ConcGraph->DelNode(0);
+  EXPECT_EQ(100, Snapshot->GetEdges());
+  EXPECT_TRUE(Snapshot->IsEdge(0, 1));
+  EXPECT_FALSE(Snapshot->IsEdge(0, 2));
+  EXPECT_EQ(99, ConcGraph->GetNodes());
+  EXPECT_EQ(98, ConcGraph->GetEdges());
+
+  const PNGraph Snapshot2 = ConcGraph->GetSnapshot();
+  EXPECT_TRUE(Snapshot2->IsOk());
+  EXPECT_EQ(98, Snapshot2->GetEdges());
+  EXPECT_TRUE(Snapshot2->IsEdge(1, 3));
+  EXPECT_FALSE(Snapshot2->IsEdge(1, 2));
+}
+
+#endif // GCC_ATOMIC
@@ -0,0 +1,142 @@
+#include <gtest/gtest.h>
+
+#include "Snap.h"
+
+// Checks that the two graphs have the same nodes and edges
+static void ExpectSameGraph(const PNGraph& Graph, const PNGraphOut& OutGraph) {
+  EXPECT_EQ(Graph->GetNodes(), OutGraph->GetNodes());
+  EXPECT_EQ(Graph->GetEdges(), OutGraph->GetEdges());
+  for (TNGraph::TNodeI NI = Graph->BegNI(); NI < Graph->EndNI(); NI++) {
+    ASSERT_TRUE(OutGraph->IsNode(NI.GetId()));
+    const TNGraphOut::TNodeI OutNI = OutGraph->GetNI(NI.GetId());
+    ASSERT_EQ(NI.GetInDeg(), OutNI.GetInDeg());
+    ASSERT_EQ(NI.GetOutDeg(), OutNI.GetOutDeg());
+    for (int e = 0; e < NI.GetInDeg(); e++) { EXPECT_EQ(NI.GetInNId(e), OutNI.GetInNId(e)); }
+    for (int e = 0; e < NI.GetOutDeg(); e++) { EXPECT_EQ(NI.GetOutNId(e), OutNI.GetOutNId(e)); }
+  }
+}
+
+// Test node, edge creation against TNGraph
+TEST(TNGraphOut, ManipulateNodesEdges) {
+  const int NNodes = 1000;
+  const int NEdges = 20000;
+  PNGraph Graph = TNGraph::New();
+  PNGraphOut OutGraph = TNGraphOut::New();
+  TRnd Rnd(1);
+
+  for (int i = 0; i < NNodes; i++) {
+    Graph->AddNode(i);
+    OutGraph->AddNode(i);
+  }
+  for (int e = 0; e < NEdges; e++) {
+    const int SrcNId = Rnd.GetUniDevInt(NNodes);
+    const int DstNId = Rnd.GetUniDevInt(NNodes);
+    EXPECT_EQ(Graph->AddEdge(SrcNId, DstNId), OutGraph->AddEdge(SrcNId, DstNId));
+  }
+  EXPECT_FALSE(OutGraph->HasInEdges());
+  EXPECT_TRUE(OutGraph->IsOk());
+  ExpectSameGraph(Graph, OutGraph);
+  EXPECT_TRUE(OutGraph->HasInEdges());
+  EXPECT_TRUE(OutGraph->IsOk());
+
+  // delete edges and nodes
+  for (int e = 0; e < NEdges/4; e++) {
+    const int SrcNId = Rnd.GetUniDevInt(NNodes);
+    const int DstNId = Rnd.GetUniDevInt(NNodes);
+    Graph->DelEdge(SrcNId, DstNId, e % 2 == 0);
+    OutGraph->DelEdge(SrcNId, DstNId, e % 2 == 0);
+  }
+  EXPECT_FALSE(OutGraph->HasInEdges());
+  // the first nodes are deleted without in-edges, the rest update the in-edges in place
+  OutGraph->AddEdge(6, 6);  Graph->AddEdge(6, 6);
+  OutGraph->AddEdge(603, 603);  Graph->AddEdge(603, 603);
+  for (int n = 0; n < NNodes; n += 3) {
+    if (n == 300) { OutGraph->BuildInEdges(); }
+    Graph->DelNode(n);
+    OutGraph->DelNode(n);
+  }
+  EXPECT_TRUE(OutGraph->HasInEdges());
+  EXPECT_TRUE(OutGraph->IsOk());
+  ExpectSameGraph(Graph, OutGraph);
+  EXPECT_TRUE(OutGraph->IsEdge(Graph->BegEI().GetSrcNId(), Graph->BegEI().GetDstNId()));
+
+  int EdgeCnt = 0;
+  for (TNGraphOut::TEdgeI EI = OutGraph->BegEI(); EI < OutGraph->EndEI(); EI++) {
+    EXPECT_TRUE(Graph->IsEdge(EI.GetSrcNId(), EI.GetDstNId()));
+    EdgeCnt++;
+  }
+  EXPECT_EQ(Graph->GetEdges(), EdgeCnt);
+
+  // the in-edges take memory only while they are built
+  OutGraph->BuildInEdges();
+  const ::TSize MemUsed = OutGraph->GetMemUsed();
+  OutGraph->ClrInEdges();
+  EXPECT_GT(MemUsed, OutGraph->GetMemUsed());
+  OutGraph->Defrag();
+  EXPECT_TRUE(OutGraph->IsOk());
+  ExpectSameGraph(Graph, OutGraph);
+}
+
+// Test unchecked edge insertion, saving and loading and algorithms
+TEST(TNGraphOut, SaveLoadAlgorithms) {
+  const char *FName = "test.graphout.dat";
+  TRnd Rnd(3);
+  PNGraph Graph = TSnap::GenRndGnm<PNGraph>(200, 1000, true, Rnd);
+  PNGraphOut OutGraph = TNGraphOut::New();
+  for (TNGraph::TNodeI NI = Graph->BegNI(); NI < Graph->EndNI(); NI++) {
+    OutGraph->AddNode(NI.GetId()); }
+  for (TNGraph::TEdgeI EI = Graph->BegEI(); EI < Graph->EndEI(); EI++) {
+    OutGraph->AddEdgeUnchecked(EI.GetSrcNId(), EI.GetDstNId());
+    OutGraph->AddEdgeUnchecked(EI.GetSrcNId(), EI.GetDstNId());
+  }
+  OutGraph->SortNodeAdjV();
+  EXPECT_TRUE(OutGraph->IsOk());
+
+  {
+    TFOut FOut(FName);
+    OutGraph->Save(FOut);
+  }
+  PNGraphOut OutGraph1;
+  {
+    TFIn FIn(FName);
+    OutGraph1 = TNGraphOut::Load(FIn);
+  }
+  EXPECT_TRUE(OutGraph1->IsOk());
+  ExpectSameGraph(Graph, OutGraph1);
+
+  PNGraphOut OutGraph2 = TNGraphOut::New();
+  *OutGraph2 = *OutGraph1;
+  OutGraph1->Clr();
+  EXPECT_TRUE(OutGraph1->Empty());
+  ExpectSameGraph(Graph, OutGraph2);
+
+  EXPECT_EQ(TSnap::GetMxWccSz(Graph), TSnap::GetMxWccSz(OutGraph2));
+  EXPECT_EQ(TSnap::GetMxSccSz(Graph), TSnap::GetMxSccSz(OutGraph2));
+  EXPECT_EQ(TSnap::GetBfsFullDiam(Graph, Graph->GetNodes()), TSnap::GetBfsFullDiam(OutGraph2, Graph->GetNodes()));
+  EXPECT_DOUBLE_EQ(TSnap::GetClustCf(Graph), TSnap::GetClustCf(OutGraph2));
+}
+
+// Test in-edge queries from several threads before the in-edges are built
+TEST(TNGraphOut, ParallelInEdges) {
+  TRnd Rnd(4);
+  PNGraph Graph = TSnap::GenRndGnm<PNGraph>(2000, 20000, true, Rnd);
+  PNGraphOut OutGraph = TSnap::ConvertGraph<PNGraphOut>(Graph);
+  EXPECT_FALSE(OutGraph->HasInEdges());
+  TIntV NIdV;
+  Graph->GetNIdV(NIdV);
+  TIntV InDegV(NIdV.Len()), InNIdSumV(NIdV.Len());
+  #pragma omp parallel for schedule(dynamic, 100) num_threads(4)
+  for (int n = 0; n < NIdV.Len(); n++) {
+    const TNGraphOut::TNodeI NI = OutGraph->GetNI(NIdV[n]);
+    InDegV[n] = NI.GetInDeg();
+    for (int e = 0; e < NI.GetInDeg(); e++) { InNIdSumV[n] += NI.GetInNId(e); }
+  }
+  EXPECT_TRUE(OutGraph->HasInEdges());
+  for (int n = 0; n < NIdV.Len(); n++) {
+    const TNGraph::TNodeI NI = Graph->GetNI(NIdV[n]);
+    int InNIdSum = 0;
+    for (int e = 0; e < NI.GetInDeg(); e++) { InNIdSum += NI.GetInNId(e); }
+    EXPECT_EQ(NI.GetInDeg(), InDegV[n]);
+    EXPECT_EQ(InNIdSum, InNIdSumV[n]);
+  }
+}
@@ -0,0 +1,177 @@
+#include <gtest/gtest.h>
+
+#include "Snap.h"
+
+// Checks that the two graphs have the same nodes and edges
+static void ExpectSameGraph(const PNGraph& Graph, const PNGraphSlab& SlabGraph) {
+  EXPECT_EQ(Graph->GetNodes(), SlabGraph->GetNodes());
+  EXPECT_EQ(Graph->GetEdges(), SlabGraph->GetEdges());
+  for (TNGraph::TNodeI NI = Graph->BegNI(); NI < Graph->EndNI(); NI++) {
+    ASSERT_TRUE(SlabGraph->IsNode(NI.GetId()));
+    const TNGraphSlab::TNodeI SlabNI = SlabGraph->GetNI(NI.GetId());
+    ASSERT_EQ(NI.GetInDeg(), SlabNI.GetInDeg());
+    ASSERT_EQ(NI.GetOutDeg(), SlabNI.GetOutDeg());
+    for (int e = 0; e < NI.GetInDeg(); e++) { EXPECT_EQ(NI.GetInNId(e), SlabNI.GetInNId(e)); }
+    for (int e = 0; e < NI.GetOutDeg(); e++) { EXPECT_EQ(NI.GetOutNId(e), SlabNI.GetOutNId(e)); }
+  }
+}
+
+// Test slots of the slab pool
+TEST(TSlabPool, AddDelSlots) {
+  TSlabPool<TInt> Pool;
+  EXPECT_EQ(0, TSlabPool<TInt>::GetCap(-1));
+  EXPECT_EQ(0, TSlabPool<TInt>::GetClass(1));
+  EXPECT_EQ(1, TSlabPool<TInt>::GetClass(3));
+  EXPECT_EQ(10, TSlabPool<TInt>::GetClass(2000));
+
+  TVec<TInt64> SlotV;
+  for (int i = 0; i < 1000; i++) {
+    const int64 Slot = Pool.AddSlot(i % 50 + 1);
+    EXPECT_LE(i % 50 + 1, TSlabPool<TInt>::GetCap(Slot));
+    TInt* ValT = Pool.GetValVPt(Slot);
+    for (int v = 0; v < i % 50 + 1; v++) { ValT[v] = i; }
+    SlotV.Add(Slot);
+  }
+  EXPECT_EQ(1000, Pool.GetSlots());
+  // slots do not overlap
+  for (int i = 0; i < 1000; i++) {
+    const TInt* ValT = Pool.GetValVPt(SlotV[i]);
+    for (int v = 0; v < i % 50 + 1; v++) { ASSERT_EQ(i, ValT[v]); }
+  }
+  // grow a vector from size class to size class
+  int64 Slot = -1;
+  for (int v = 0; v < 5000; v++) {
+    Slot = Pool.Renew(Slot, v, v+1);
+    Pool.GetValVPt(Slot)[v] = v;
+  }
+  for (int v = 0; v < 5000; v++) { ASSERT_EQ(v, Pool.GetValVPt(Slot)[v]); }
+  EXPECT_EQ(1001, Pool.GetSlots());
+  // freed slots are reused
+  const int64 FreeSlots = Pool.GetFreeSlots();
+  Pool.DelSlot(SlotV[0]);
+  EXPECT_EQ(FreeSlots + 1, Pool.GetFreeSlots());
+  EXPECT_EQ(SlotV[0], Pool.AddSlot(1));
+  EXPECT_EQ(FreeSlots, Pool.GetFreeSlots());
+
+  TSlabPool<TInt> Pool2(Pool);
+  for (int v = 0; v < 5000; v++) { ASSERT_EQ(v, Pool2.GetValVPt(Slot)[v]); }
+  Pool.Clr();
+  EXPECT_EQ(0, Pool.GetSlots());
+  EXPECT_EQ(0, Pool.GetFreeSlots());
+}
+
+// Test node, edge creation against TNGraph
+TEST(TNGraphSlab, ManipulateNodesEdges) {
+  const int NNodes = 1000;
+  const int NEdges = 20000;
+  PNGraph Graph = TNGraph::New();
+  PNGraphSlab SlabGraph = TNGraphSlab::New();
+  TRnd Rnd(1);
+
+  for (int i = 0; i < NNodes; i++) {
+    Graph->AddNode(i);
+    SlabGraph->AddNode(i);
+  }
+  for (int e = 0; e < NEdges; e++) {
+    const int SrcNId = Rnd.GetUniDevInt(NNodes);
+    const int DstNId = Rnd.GetUniDevInt(NNodes);
+    EXPECT_EQ(Graph->AddEdge(SrcNId, DstNId), SlabGraph->AddEdge(SrcNId, DstNId));
+  }
+  EXPECT_TRUE(SlabGraph->IsOk());
+  ExpectSameGraph(Graph, SlabGraph);
+
+  // delete edges and nodes
+  for (int e = 0; e < NEdges/4; e++) {
+    const int SrcNId = Rnd.GetUniDevInt(NNodes);
+    const int DstNId = Rnd.GetUniDevInt(NNodes);
+    Graph->DelEdge(SrcNId, DstNId, e % 2 == 0);
+    SlabGraph->DelEdge(SrcNId, DstNId, e % 2 == 0);
+  }
+  for (int n = 0; n < NNodes; n += 3) {
+    Graph->DelNode(n);
+    SlabGraph->DelNode(n);
+  }
+  EXPECT_TRUE(SlabGraph->IsOk());
+  ExpectSameGraph(Graph, SlabGraph);
+  EXPECT_TRUE(SlabGraph->IsEdge(Graph->BegEI().GetSrcNId(), Graph->BegEI().GetDstNId()));
+
+  int EdgeCnt = 0;
+  for (TNGraphSlab::TEdgeI EI = SlabGraph->BegEI(); EI < SlabGraph->EndEI(); EI++) {
+    EXPECT_TRUE(Graph->IsEdge(EI.GetSrcNId(), EI.GetDstNId()));
+    EdgeCnt++;
+  }
+  EXPECT_EQ(Graph->GetEdges(), EdgeCnt);
+
+  // compact the pool
+  const ::TSize MemUsed = SlabGraph->GetMemUsed();
+  SlabGraph->Defrag();
+  EXPECT_TRUE(SlabGraph->IsOk());
+  ExpectSameGraph(Graph, SlabGraph);
+  EXPECT_GT(MemUsed, SlabGraph->GetMemUsed());
+}
+
+// Test unchecked and batch edge insertion
+TEST(TNGraphSlab, AddEdgeBatch) {
+  const int NNodes = 500;
+  PNGraph Graph = TNGraph::New();
+  PNGraphSlab SlabGraph1 = TNGraphSlab::New();
+  PNGraphSlab SlabGraph2 = TNGraphSlab::New();
+  TIntPrV EdgeV;
+  TRnd Rnd(2);
+  for (int i = 0; i < NNodes; i++) {
+    Graph->AddNode(i);
+    SlabGraph1->AddNode(i);
+    SlabGraph2->AddNode(i);
+  }
+  for (int Batch = 0; Batch < 3; Batch++) {
+    EdgeV.Clr(false);
+    for (int e = 0; e < 5000; e++) {
+      EdgeV.Add(TIntPr(Rnd.GetUniDevInt(NNodes), Rnd.GetUniDevInt(NNodes)));
+      Graph->AddEdge(EdgeV.Last().Val1, EdgeV.Last().Val2);
+      SlabGraph2->AddEdgeUnchecked(EdgeV.Last().Val1, EdgeV.Last().Val2);
+    }
+    const int NewEdges = TSnap::AddEdgeBatch(SlabGraph1, EdgeV);
+    EXPECT_EQ(Graph->GetEdges(), SlabGraph1->GetEdges());
+    EXPECT_LE(NewEdges, EdgeV.Len());
+  }
+  SlabGraph2->SortNodeAdjV();
+  EXPECT_TRUE(SlabGraph1->IsOk());
+  EXPECT_TRUE(SlabGraph2->IsOk());
+  ExpectSameGraph(Graph, SlabGraph1);
+  ExpectSameGraph(Graph, SlabGraph2);
+}
+
+// Test saving and loading, copying and algorithms
+TEST(TNGraphSlab, SaveLoadAlgorithms) {
+  const char *FName = "test.graphslab.dat";
+  TRnd Rnd(3);
+  PNGraph Graph = TSnap::GenRndGnm<PNGraph>(200, 1000, true, Rnd);
+  PNGraphSlab SlabGraph = TNGraphSlab::New();
+  for (TNGraph::TNodeI NI = Graph->BegNI(); NI < Graph->EndNI(); NI++) {
+    SlabGraph->AddNode(NI.GetId()); }
+  for (TNGraph::TEdgeI EI = Graph->BegEI(); EI < Graph->EndEI(); EI++) {
+    SlabGraph->AddEdge(EI.GetSrcNId(), EI.GetDstNId()); }
+
+  {
+    TFOut FOut(FName);
+    SlabGraph->Save(FOut);
+  }
+  PNGraphSlab SlabGraph1;
+  {
+    TFIn FIn(FName);
+    SlabGraph1 = TNGraphSlab::Load(FIn);
+  }
+  EXPECT_TRUE(SlabGraph1->IsOk());
+  ExpectSameGraph(Graph, SlabGraph1);
+
+  PNGraphSlab SlabGraph2 = TNGraphSlab::New();
+  *SlabGraph2 = *SlabGraph1;
+  SlabGraph1->Clr();
+  EXPECT_TRUE(SlabGraph1->Empty());
+  ExpectSameGraph(Graph, SlabGraph2);
+
+  EXPECT_EQ(TSnap::GetMxWccSz(Graph), TSnap::GetMxWccSz(SlabGraph2));
+  EXPECT_EQ(TSnap::GetMxSccSz(Graph), TSnap::GetMxSccSz(SlabGraph2));
+  EXPECT_EQ(TSnap::GetBfsFullDiam(Graph, Graph->GetNodes()), TSnap::GetBfsFullDiam(SlabGraph2, Graph->GetNodes()));
+  EXPECT_DOUBLE_EQ(TSnap::GetClustCf(Graph), TSnap::GetClustCf(SlabGraph2));
+}
@@ -0,0 +1,221 @@
+#include <gtest/gtest.h>
+
+#include "Snap.h"
+
+// Keeps the edges whose endpoint IDs do not add up to a multiple of 3
+class TSumEdgeFilter {
+public:
+  bool operator () (const int& SrcNId, const int& DstNId) const { return (SrcNId + DstNId) % 3 != 0; }
+};
+
+// Checks that the view has the same nodes and edges as the graph
+template <class PView, class PGraph>
+static void ExpectSameGraph(const PView& View, const PGraph& Graph) {
+  EXPECT_EQ(Graph->GetNodes(), View->GetNodes());
+  EXPECT_EQ(Graph->GetEdges(), View->GetEdges());
+  int Nodes = 0;
+  for (typename PView::TObj::TNodeI NI = View->BegNI(); NI < View->EndNI(); NI++, Nodes++) {
+    ASSERT_TRUE(Graph->IsNode(NI.GetId()));
+    const typename PGraph::TObj::TNodeI GraphNI = Graph->GetNI(NI.GetId());
+    ASSERT_EQ(GraphNI.GetInDeg(), NI.GetInDeg());
+    ASSERT_EQ(GraphNI.GetOutDeg(), NI.GetOutDeg());
+    ASSERT_EQ(GraphNI.GetDeg(), NI.GetDeg());
+    for (int e = 0; e < NI.GetInDeg(); e++) { EXPECT_EQ(GraphNI.GetInNId(e), NI.GetInNId(e)); }
+    for (int e = 0; e < NI.GetOutDeg(); e++) { EXPECT_EQ(GraphNI.GetOutNId(e), NI.GetOutNId(e)); }
+  }
+  EXPECT_EQ(Graph->GetNodes(), Nodes);
+  int Edges = 0;
+  for (typename PView::TObj::TEdgeI EI = View->BegEI(); EI < View->EndEI(); EI++, Edges++) {
+    EXPECT_TRUE(Graph->IsEdge(EI.GetSrcNId(), EI.GetDstNId()));
+    EXPECT_TRUE(View->IsEdge(EI.GetSrcNId(), EI.GetDstNId()));
+  }
+  EXPECT_EQ(Graph->GetEdges(), Edges);
+}
+
+// Returns the IDs of the nodes with even IDs
+template <class PGraph>
+static void GetEvenNIdV(const PGraph& Graph, TIntV& NIdV) {
+  for (typename PGraph::TObj::TNodeI NI = Graph->BegNI(); NI < Graph->EndNI(); NI++) {
+    if (NI.GetId() % 2 == 0) { NIdV.Add(NI.GetId()); }
+  }
+}
+
+// Test induced subgraph views of directed and undirected graphs
+TEST(TGraphView, SubGraph) {
+  TRnd Rnd(1);
+  PNGraph Graph = TSnap::GenRndGnm<PNGraph>(200, 2000, true, Rnd);
+  TIntV NIdV;
+  GetEvenNIdV(Graph, NIdV);
+  TPt<TGraphView<PNGraph> > View = TSnap::GetSubGraphView(Graph, NIdV);
+  EXPECT_TRUE(View->HasFlag(gfDirected));
+  EXPECT_FALSE(View->IsNode(1));
+  EXPECT_TRUE(View->IsNode(2));
+  ExpectSameGraph(View, TSnap::GetSubGraph(Graph, NIdV));
+  ExpectSameGraph(View, View->GetSubGraph());
+
+  PUNGraph UGraph = TSnap::GenRndGnm<PUNGraph>(200, 2000, true, Rnd);
+  TIntV UNIdV;
+  GetEvenNIdV(UGraph, UNIdV);
+  TPt<TGraphView<PUNGraph> > UView = TSnap::GetSubGraphView(UGraph, UNIdV);
+  EXPECT_FALSE(UView->HasFlag(gfDirected));
+  ExpectSameGraph(UView, TSnap::GetSubGraph(UGraph, UNIdV));
+  PUNGraph UCopy = UView->GetSubGraph();
+  ExpectSameGraph(UView, UCopy);
+
+  // hiding and showing nodes updates the view
+  UView->HideNode(0);
+  UNIdV.DelIfIn(0);
+  ExpectSameGraph(UView, TSnap::GetSubGraph(UGraph, UNIdV));
+  UView->ShowNode(1);
+  UNIdV.Add(1);
+  ExpectSameGraph(UView, TSnap::GetSubGraph(UGraph, UNIdV));
+  for (int i = 0; i < 100; i++) {
+    EXPECT_TRUE(UView->IsNode(UView->GetRndNId()));
+  }
+}
+
+// Test views with an edge filter and views of views
+TEST(TGraphView, EdgeFilter) {
+  TRnd Rnd(2);
+  PNGraph Graph = TSnap::GenRndGnm<PNGraph>(100, 1000, true, Rnd);
+  PNGraph Expected = TNGraph::New();
+  for (TNGraph::TNodeI NI = Graph->BegNI(); NI < Graph->EndNI(); NI++) {
+    Expected->AddNode(NI.GetId());
+  }
+  for (TNGraph::TEdgeI EI = Graph->BegEI(); EI < Graph->EndEI(); EI++) {
+    if ((EI.GetSrcNId() + EI.GetDstNId()) % 3 != 0) { Expected->AddEdge(EI.GetSrcNId(), EI.GetDstNId()); }
+  }
+  TPt<TGraphView<PNGraph, TSumEdgeFilter> > View = TSnap::GetESubGraphView(Graph, TSumEdgeFilter());
+  ExpectSameGraph(View, Expected);
+
+  // view of the filtered view, induced by the nodes with even IDs
+  TIntV NIdV;
+  GetEvenNIdV(Graph, NIdV);
+  typedef TPt<TGraphView<PNGraph, TSumEdgeFilter> > PFltView;
+  TPt<TGraphView<PFltView> > SubView = TSnap::GetSubGraphView(View, NIdV);
+  EXPECT_TRUE(SubView->HasFlag(gfDirected));
+  ExpectSameGraph(SubView, TSnap::GetSubGraph(Expected, NIdV));
+  PNGraph Copy = SubView->GetSubGraph();
+  ExpectSameGraph(SubView, Copy);
+
+  PUNGraph UGraph = TSnap::GenRndGnm<PUNGraph>(100, 1000, true, Rnd);
+  PUNGraph UExpected = TUNGraph::New();
+  for (TUNGraph::TNodeI NI = UGraph->BegNI(); NI < UGraph->EndNI(); NI++) {
+    UExpected->AddNode(NI.GetId());
+  }
+  for (TUNGraph::TEdgeI EI = UGraph->BegEI(); EI < UGraph->EndEI(); EI++) {
+    if ((EI.GetSrcNId() + EI.GetDstNId()) % 3 != 0) { UExpected->AddEdge(EI.GetSrcNId(), EI.GetDstNId()); }
+  }
+  ExpectSameGraph(TSnap::GetESubGraphView(UGraph, TSumEdgeFilter()), UExpected);
+}
+
+// Test algorithms on views
+TEST(TGraphView, Algorithms) {
+  TRnd Rnd(3);
+  PUNGraph Graph = TSnap::GenRndGnm<PUNGraph>(300, 400, true, Rnd);
+  TIntV NIdV;
+  GetEvenNIdV(Graph, NIdV);
+  TPt<TGraphView<PUNGraph> > View = TSnap::GetSubGraphView(Graph, NIdV);
+  PUNGraph SubGraph = TSnap::GetSubGraph(Graph, NIdV);
+
+  TCnComV ViewCnComV, CnComV;
+  TSnap::GetWccs(View, ViewCnComV);
+  TSnap::GetWccs(SubGraph, CnComV);
+  ASSERT_EQ(CnComV.Len(), ViewCnComV.Len());
+  for (int c = 0; c < CnComV.Len(); c++) {
+    EXPECT_EQ(CnComV[c].Len(), ViewCnComV[c].Len());
+  }
+  ExpectSameGraph(TSnap::GetMxWccView(View), TSnap::GetMxWcc(SubGraph));
+
+  const int StartNId = ViewCnComV[0].NIdV[0];
+  PNGraph ViewBfsTree = TSnap::GetBfsTree(View, StartNId, true, false);
+  PNGraph BfsTree = TSnap::GetBfsTree(SubGraph, StartNId, true, false);
+  EXPECT_EQ(BfsTree->GetNodes(), ViewBfsTree->GetNodes());
+  EXPECT_EQ(BfsTree->GetEdges(), ViewBfsTree->GetEdges());
+
+  TKCore<PUNGraph> KCore(Graph);
+  KCore.GetNextCore();
+  KCore.GetNextCore();
+  ExpectSameGraph(KCore.GetCoreView(), KCore.GetCoreG());
+}
+
+// Test views of a directed graph with reversed edges
+TEST(TTransView, Reverse) {
+  TRnd Rnd(4);
+  PNGraph Graph = TSnap::GenRndGnm<PNGraph>(200, 2000, true, Rnd);
+  PNGraph Expected = TNGraph::New();
+  for (TNGraph::TNodeI NI = Graph->BegNI(); NI < Graph->EndNI(); NI++) {
+    Expected->AddNode(NI.GetId());
+  }
+  for (TNGraph::TEdgeI EI = Graph->BegEI(); EI < Graph->EndEI(); EI++) {
+    Expected->AddEdge(EI.GetDstNId(), EI.GetSrcNId());
+  }
+  TPt<TTransView<PNGraph> > View = TSnap::GetTransView(Graph);
+  EXPECT_TRUE(View->HasFlag(gfDirected));
+  ExpectSameGraph(View, Expected);
+  EXPECT_EQ(TSnap::GetMxSccSz(Expected), TSnap::GetMxSccSz(View));
+
+  // reversing twice gives the graph back
+  ExpectSameGraph(TSnap::GetTransView(View), Graph);
+
+  // induced subgraph of the reversed graph
+  TIntV NIdV;
+  GetEvenNIdV(Graph, NIdV);
+  TPt<TGraphView<TPt<TTransView<PNGraph> > > > SubView = TSnap::GetSubGraphView(View, NIdV);
+  ExpectSameGraph(SubView, TSnap::GetSubGraph(Expected, NIdV));
+  PNGraph Copy = SubView->GetSubGraph();
+  ExpectSameGraph(SubView, Copy);
+}
+
+// Test undirected views of directed graphs
+TEST(TSymView, UnDir) {
+  TRnd Rnd(5);
+  PNGraph Graph = TSnap::GenRndGnm<PNGraph>(200, 2000, true, Rnd);
+  Graph->AddEdge(5, 5);
+  PUNGraph Expected = TSnap::ConvertGraph<PUNGraph>(Graph);
+  TPt<TSymView<PNGraph> > View = TSnap::GetSymView(Graph);
+  EXPECT_FALSE(View->HasFlag(gfDirected));
+  ExpectSameGraph(View, Expected);
+  for (TUNGraph::TNodeI NI = Expected->BegNI(); NI < Expected->EndNI(); NI++) {
+    const TSymView<PNGraph>::TNodeI ViewNI = View->GetNI(NI.GetId());
+    for (int e = 0; e < NI.GetDeg(); e++) {
+      EXPECT_EQ(NI.GetNbrNId(e), ViewNI.GetNbrNId(e));
+      EXPECT_TRUE(ViewNI.IsNbrNId(NI.GetNbrNId(e)));
+      EXPECT_TRUE(View->IsEdge(NI.GetNbrNId(e), NI.GetId()));
+    }
+  }
+  EXPECT_EQ(TSnap::GetMxWccSz(Expected), TSnap::GetMxWccSz(View));
+  EXPECT_DOUBLE_EQ(TSnap::GetClustCf(Expected), TSnap::GetClustCf(View));
+
+  // the view of an undirected view materializes as an undirected graph
+  TIntV NIdV;
+  GetEvenNIdV(Graph, NIdV);
+  PUNGraph Copy = TSnap::GetSubGraphView(View, NIdV)->GetSubGraph();
+  ExpectSameGraph(TSnap::GetSubGraphView(View, NIdV), TSnap::GetSubGraph(Expected, NIdV));
+  ExpectSameGraph(TSnap::GetSubGraphView(View, NIdV), Copy);
+
+  // the view works on graphs that store only out-edges
+  PNGraphOut OutGraph = TSnap::ConvertGraph<PNGraphOut>(Graph);
+  ExpectSameGraph(TSnap::GetSymView(OutGraph), Expected);
+}
+
+// Test undirected views of directed multigraphs, whose neighbor lists are not sorted
+TEST(TSymView, MultiGraph) {
+  TRnd Rnd(6);
+  PNGraph Graph = TSnap::GenRndGnm<PNGraph>(100, 800, true, Rnd);
+  PUNGraph Expected = TSnap::ConvertGraph<PUNGraph>(Graph);
+  TIntPrV EdgeV;
+  for (TNGraph::TEdgeI EI = Graph->BegEI(); EI < Graph->EndEI(); EI++) {
+    for (int i = 0; i < 1 + EI.GetSrcNId() % 3; i++) { EdgeV.Add(TIntPr(EI.GetSrcNId(), EI.GetDstNId())); }
+  }
+  EdgeV.Shuffle(Rnd);
+  PNEGraph MGraph = TNEGraph::New();
+  PNEANet Net = TNEANet::New();
+  for (TNGraph::TNodeI NI = Graph->BegNI(); NI < Graph->EndNI(); NI++) { MGraph->AddNode(NI.GetId());  Net->AddNode(NI.GetId()); }
+  for (int e = 0; e < EdgeV.Len(); e++) {
+    MGraph->AddEdge(EdgeV[e].Val2, EdgeV[e].Val1);
+    Net->AddEdge(EdgeV[e].Val1, EdgeV[e].Val2);
+  }
+  ExpectSameGraph(TSnap::GetSymView(MGraph), Expected);
+  ExpectSameGraph(TSnap::GetSymView(Net), Expected);
+}
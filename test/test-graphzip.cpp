@@ -0,0 +1,142 @@
+#include <gtest/gtest.h>
+
+#include "Snap.h"
+
+// Checks that the two graphs have the same nodes and edges
+template <class PGraph>
+static void ExpectSameGraph(const PGraph& Graph, const PNGraphZip& ZipGraph) {
+  EXPECT_EQ(Graph->GetNodes(), ZipGraph->GetNodes());
+  int Nodes = 0;
+  for (TNGraphZip::TNodeI ZipNI = ZipGraph->BegNI(); ZipNI < ZipGraph->EndNI(); ZipNI++, Nodes++) {
+    ASSERT_TRUE(Graph->IsNode(ZipNI.GetId()));
+    const typename PGraph::TObj::TNodeI NI = Graph->GetNI(ZipNI.GetId());
+    ASSERT_EQ(NI.GetInDeg(), ZipNI.GetInDeg());
+    ASSERT_EQ(NI.GetOutDeg(), ZipNI.GetOutDeg());
+    for (int e = 0; e < NI.GetInDeg(); e++) { EXPECT_EQ(NI.GetInNId(e), ZipNI.GetInNId(e)); }
+    for (int e = 0; e < NI.GetOutDeg(); e++) { EXPECT_EQ(NI.GetOutNId(e), ZipNI.GetOutNId(e)); }
+  }
+  EXPECT_EQ(Graph->GetNodes(), Nodes);
+}
+
+// Test compressing directed and undirected graphs
+TEST(TNGraphZip, Compress) {
+  TRnd Rnd(1);
+  PNGraph Graph = TSnap::GenRndGnm<PNGraph>(2000, 20000, true, Rnd);
+  // nodes with similar neighbors make use of reference compression
+  for (int n = 0; n < 200; n++) {
+    Graph->AddNode(5000+n);
+    for (int e = 0; e < 50; e++) { Graph->AddEdge(5000+n, 1000+e+(n%3)); }
+  }
+  Graph->AddNode(100000);
+  Graph->AddEdge(100000, 100000);
+  Graph->AddEdge(100000, 0);
+  PNGraphZip ZipGraph = TNGraphZip::New(Graph);
+  EXPECT_TRUE(ZipGraph->HasFlag(gfDirected));
+  EXPECT_EQ(Graph->GetEdges(), ZipGraph->GetEdges());
+  EXPECT_EQ(Graph->GetMxNId(), ZipGraph->GetMxNId());
+  ExpectSameGraph(Graph, ZipGraph);
+  EXPECT_FALSE(ZipGraph->IsNode(4000));
+  EXPECT_TRUE(ZipGraph->IsEdge(100000, 0));
+  EXPECT_FALSE(ZipGraph->IsEdge(0, 100000));
+  EXPECT_TRUE(ZipGraph->IsEdge(0, 100000, false));
+
+  int EdgeCnt = 0;
+  for (TNGraphZip::TEdgeI EI = ZipGraph->BegEI(); EI < ZipGraph->EndEI(); EI++) {
+    EXPECT_TRUE(Graph->IsEdge(EI.GetSrcNId(), EI.GetDstNId()));
+    EdgeCnt++;
+  }
+  EXPECT_EQ(Graph->GetEdges(), EdgeCnt);
+
+  // undirected graphs store every edge in both directions
+  PUNGraph Grid = TSnap::GenGrid<PUNGraph>(50, 50, false);
+  PNGraphZip ZipGrid = TNGraphZip::New(Grid);
+  EXPECT_TRUE(ZipGrid->HasIn());
+  ExpectSameGraph(Grid, ZipGrid);
+  EXPECT_EQ(2*Grid->GetEdges(), ZipGrid->GetEdges());
+
+  // neighboring nodes with similar lists take a few bits per edge, not 32
+  PNGraph Circle = TSnap::GenCircle<PNGraph>(10000, 10, true);
+  PNGraphZip ZipCircle = TNGraphZip::New(Circle);
+  ExpectSameGraph(Circle, ZipCircle);
+  EXPECT_GT(8.0, ZipCircle->GetOutBitsPerEdge());
+
+  // without the reference window and the in-edges
+  PNGraphZip ZipGraph1 = TNGraphZip::New(Graph, false, 0);
+  EXPECT_FALSE(ZipGraph1->HasIn());
+  for (TNGraph::TNodeI NI = Graph->BegNI(); NI < Graph->EndNI(); NI++) {
+    const TNGraphZip::TNodeI ZipNI = ZipGraph1->GetNI(NI.GetId());
+    ASSERT_EQ(NI.GetOutDeg(), ZipNI.GetOutDeg());
+    for (int e = 0; e < NI.GetOutDeg(); e++) { EXPECT_EQ(NI.GetOutNId(e), ZipNI.GetOutNId(e)); }
+  }
+  EXPECT_LT(ZipGraph1->GetMemUsed(), ZipGraph->GetMemUsed());
+}
+
+// Test loading edge lists, saving and loading and algorithms
+TEST(TNGraphZip, LoadSaveAlgorithms) {
+  const char *EdgeFName = "test.graphzip.txt";
+  const char *FName = "test.graphzip.dat";
+  TRnd Rnd(2);
+  PNGraph Graph = TSnap::GenRndGnm<PNGraph>(500, 3000, true, Rnd);
+  TSnap::SaveEdgeList(Graph, EdgeFName);
+  PNGraph Graph1 = TSnap::LoadEdgeList<PNGraph>(EdgeFName, 0, 1);
+  PNGraphZip ZipGraph = TNGraphZip::LoadEdgeList(EdgeFName);
+  EXPECT_EQ(Graph1->GetEdges(), ZipGraph->GetEdges());
+  ExpectSameGraph(Graph1, ZipGraph);
+
+  // chunks that do not fit in memory are merged from sorted runs, duplicate edges are in different chunks
+  const TStr DupFName = "test.graphzip.dup.txt";
+  {
+    TFOut FOut(DupFName);
+    FOut.PutStrLn("# edges twice");
+    for (int i = 0; i < 2; i++) {
+      for (TNGraph::TEdgeI EI = Graph1->BegEI(); EI < Graph1->EndEI(); EI++) {
+        FOut.PutStrLn(TStr::Fmt("%d\t%d", EI.GetSrcNId(), EI.GetDstNId())); }
+    }
+  }
+  PNGraphZip ChunkGraph = TNGraphZip::LoadEdgeList(DupFName, 0, 1, true, 700);
+  EXPECT_FALSE(TFile::Exists(DupFName + ".out0.tmp"));
+  EXPECT_FALSE(TFile::Exists(DupFName + ".in0.tmp"));
+  EXPECT_EQ(Graph1->GetEdges(), ChunkGraph->GetEdges());
+  ExpectSameGraph(Graph1, ChunkGraph);
+  PNGraphZip ChunkOutGraph = TNGraphZip::LoadEdgeList(DupFName, 0, 1, false, 1000);
+  EXPECT_FALSE(ChunkOutGraph->HasIn());
+  EXPECT_EQ(Graph1->GetEdges(), ChunkOutGraph->GetEdges());
+  for (TNGraph::TNodeI NI = Graph1->BegNI(); NI < Graph1->EndNI(); NI++) {
+    const TNGraphZip::TNodeI ZipNI = ChunkOutGraph->GetNI(NI.GetId());
+    ASSERT_EQ(NI.GetOutDeg(), ZipNI.GetOutDeg());
+    for (int e = 0; e < NI.GetOutDeg(); e++) { EXPECT_EQ(NI.GetOutNId(e), ZipNI.GetOutNId(e)); }
+  }
+  TFile::Del(DupFName);
+
+  {
+    TFOut FOut(FName);
+    ZipGraph->Save(FOut);
+  }
+  PNGraphZip ZipGraph1;
+  {
+    TFIn FIn(FName);
+    ZipGraph1 = TNGraphZip::Load(FIn);
+  }
+  ExpectSameGraph(Graph1, ZipGraph1);
+
+  EXPECT_EQ(TSnap::GetMxWccSz(Graph1), TSnap::GetMxWccSz(ZipGraph1));
+  EXPECT_EQ(TSnap::GetMxSccSz(Graph1), TSnap::GetMxSccSz(ZipGraph1));
+  const int StartNId = Graph1->BegNI().GetId();
+  PNGraph BfsTree = TSnap::GetBfsTree(Graph1, StartNId, true, true);
+  PNGraph ZipBfsTree = TSnap::GetBfsTree(ZipGraph1, StartNId, true, true);
+  EXPECT_EQ(BfsTree->GetNodes(), ZipBfsTree->GetNodes());
+  EXPECT_EQ(BfsTree->GetEdges(), ZipBfsTree->GetEdges());
+  TIntH NIdToDistH, ZipNIdToDistH;
+  EXPECT_EQ(TSnap::GetShortPath(Graph1, StartNId, NIdToDistH, true), TSnap::GetShortPath(ZipGraph1, StartNId, ZipNIdToDistH, true));
+  EXPECT_EQ(NIdToDistH.Len(), ZipNIdToDistH.Len());
+  for (int i = 0; i < NIdToDistH.Len(); i++) {
+    EXPECT_EQ(NIdToDistH[i], ZipNIdToDistH.GetDat(NIdToDistH.GetKey(i)));
+  }
+  EXPECT_EQ(TSnap::GetTriads(Graph1), TSnap::GetTriads(ZipGraph1));
+  TIntFltH PRankH, ZipPRankH;
+  TSnap::GetPageRank(Graph1, PRankH);
+  TSnap::GetPageRank(ZipGraph1, ZipPRankH);
+  for (TNGraph::TNodeI NI = Graph1->BegNI(); NI < Graph1->EndNI(); NI++) {
+    EXPECT_NEAR(PRankH.GetDat(NI.GetId()), ZipPRankH.GetDat(NI.GetId()), 1e-9);
+  }
+}
@@ -0,0 +1,110 @@
+#include <gtest/gtest.h>
+
+#include "Snap.h"
+#include "kronecker.h"
+
+// Checks that the rows are sorted without duplicates and that the neighbors are nodes
+static void CheckKronRows(const TVec<TInt64>& OffV, const TVec<TInt, int64>& NbrV, const int& NNodes) {
+  ASSERT_EQ(NNodes + 1, OffV.Len());
+  EXPECT_EQ(0, OffV[0]);
+  EXPECT_EQ(NbrV.Len(), OffV[NNodes]);
+  for (int i = 0; i < NNodes; i++) {
+    ASSERT_LE(OffV[i], OffV[i+1]);
+    for (int64 e = OffV[i]; e < OffV[i+1]; e++) {
+      ASSERT_LE(0, NbrV[e]);
+      ASSERT_GT(NNodes, NbrV[e]);
+      if (e > OffV[i]) { ASSERT_LT(NbrV[e-1], NbrV[e]); }
+    }
+  }
+}
+
+// Test the number of edges and the rows of the parallel generator
+TEST(TKronMtx, GenFastKroneckerMP) {
+  const TKronMtx SeedMtx = TKronMtx::GetMtx("0.9, 0.6; 0.6, 0.2");
+  const int NIter = 12, NNodes = 1<<NIter;
+  const int64 Edges = 30000;
+  TVec<TInt64> OffV;
+  TVec<TInt, int64> NbrV;
+  TKronMtx::GenFastKroneckerMP(SeedMtx, NIter, Edges, true, 7, OffV, NbrV);
+  EXPECT_EQ(Edges, NbrV.Len());
+  CheckKronRows(OffV, NbrV, NNodes);
+
+  // undirected edges are drawn as (Edges+1)/2 node pairs, the rows hold both directions
+  TVec<TInt64> UOffV;
+  TVec<TInt, int64> UNbrV;
+  TKronMtx::GenFastKroneckerMP(SeedMtx, NIter, Edges+1, false, 7, UOffV, UNbrV);
+  CheckKronRows(UOffV, UNbrV, NNodes);
+  int64 Pairs = 0;
+  for (int i = 0; i < NNodes; i++) {
+    for (int64 e = UOffV[i]; e < UOffV[i+1]; e++) {
+      const int j = UNbrV[e];
+      if (j < i) { continue; }
+      Pairs++;
+      bool IsRev = false;
+      for (int64 r = UOffV[j]; r < UOffV[j+1]; r++) { IsRev = IsRev || UNbrV[r] == i; }
+      EXPECT_TRUE(IsRev);
+    }
+  }
+  EXPECT_EQ((Edges+2)/2, Pairs);
+
+  PNGraph Graph = TKronMtx::GenFastKroneckerMP(SeedMtx, NIter, int(Edges), true, 7);
+  EXPECT_EQ(NNodes, Graph->GetNodes());
+  EXPECT_EQ(Edges, Graph->GetEdges());
+  for (int i = 0; i < NNodes; i++) {
+    const TNGraph::TNodeI NI = Graph->GetNI(i);
+    ASSERT_EQ(OffV[i+1] - OffV[i], NI.GetOutDeg());
+    for (int e = 0; e < NI.GetOutDeg(); e++) { EXPECT_EQ(NbrV[OffV[i]+e], NI.GetOutNId(e)); }
+  }
+  EXPECT_TRUE(Graph->IsOk(false));
+  // by default the graph has the expected number of edges of the seed matrix
+  PNGraph DefGraph = TKronMtx::GenFastKroneckerMP(SeedMtx, 10, true, 3);
+  EXPECT_EQ(SeedMtx.GetEdges(10), DefGraph->GetEdges());
+}
+
+// Test that a fixed seed gives the same graph for any number of threads
+TEST(TKronMtx, GenFastKroneckerMPSeed) {
+  const TKronMtx SeedMtx = TKronMtx::GetMtx("0.9, 0.6; 0.6, 0.2");
+  const int NIter = 14;
+  const int64 Edges = 200000; // several chunks of draws and collisions
+  TVec<TInt64> OffV1, OffV2;
+  TVec<TInt, int64> NbrV1, NbrV2;
+  TKronMtx::GenFastKroneckerMP(SeedMtx, NIter, Edges, true, 11, OffV1, NbrV1);
+#ifdef USE_OPENMP
+  const int Threads = omp_get_max_threads();
+  omp_set_num_threads(1);
+#endif
+  TKronMtx::GenFastKroneckerMP(SeedMtx, NIter, Edges, true, 11, OffV2, NbrV2);
+#ifdef USE_OPENMP
+  omp_set_num_threads(Threads);
+#endif
+  EXPECT_TRUE(OffV1 == OffV2);
+  EXPECT_TRUE(NbrV1 == NbrV2);
+  TKronMtx::GenFastKroneckerMP(SeedMtx, NIter, Edges, true, 11, OffV2, NbrV2);
+  EXPECT_TRUE(NbrV1 == NbrV2);
+  TKronMtx::GenFastKroneckerMP(SeedMtx, NIter, Edges, true, 12, OffV2, NbrV2);
+  EXPECT_EQ(Edges, NbrV2.Len());
+  EXPECT_FALSE(NbrV1 == NbrV2);
+}
+
+// Test that the approximate log-likelihood and its gradient do not depend on the number of threads
+TEST(TKroneckerLL, CalcApxGraphLL) {
+  PNGraph Graph = TKronMtx::GenFastKroneckerMP(TKronMtx::GetMtx("0.9, 0.6; 0.6, 0.2"), 12, 20000, true, 5);
+  TKroneckerLL KronLL(Graph, TKronMtx::GetMtx("0.8, 0.6; 0.5, 0.3"));
+  KronLL.SetPerm('d');
+  const double LL = KronLL.CalcApxGraphLL();
+  const TFltV DLLV = KronLL.CalcApxGraphDLL();
+  EXPECT_GT(0, LL);
+  EXPECT_EQ(4, DLLV.Len());
+  for (int Threads = 1; Threads <= 3; Threads++) {
+#ifdef USE_OPENMP
+    const int MxThreads = omp_get_max_threads();
+    omp_set_num_threads(Threads);
+#endif
+    EXPECT_EQ(LL, KronLL.CalcApxGraphLL());
+    const TFltV& ThreadDLLV = KronLL.CalcApxGraphDLL();
+    for (int p = 0; p < DLLV.Len(); p++) { EXPECT_EQ(DLLV[p], ThreadDLLV[p]); }
+#ifdef USE_OPENMP
+    omp_set_num_threads(MxThreads);
+#endif
+  }
+}
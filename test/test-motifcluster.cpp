@@ -0,0 +1,168 @@
+#include <gtest/gtest.h>
+
+#include "Snap.h"
+#include "motifcluster.h"
+
+// Checks that weights holds exactly the weights (i, j, weight) of ExpV, i < j
+static void CheckWeights(const WeightVH& weights, const TIntTrV& ExpV, const int& Motif) {
+  int Entries = 0;
+  for (int i = 0; i < weights.Len(); i++) {
+    for (int k = 0; k < weights[i].Len(); k++) {
+      if (weights[i][k] != 0) { Entries++; }
+    }
+  }
+  EXPECT_EQ(ExpV.Len(), Entries) << "Motif M" << Motif + 1;
+  for (int e = 0; e < ExpV.Len(); e++) {
+    const int i = ExpV[e].Val1, j = ExpV[e].Val2;
+    const int Weight = weights[i].IsKey(j) ? weights[i].GetDat(j).Val : 0;
+    EXPECT_EQ(ExpV[e].Val3.Val, Weight) << "Motif M" << Motif + 1 << " (" << i << ", " << j << ")";
+  }
+}
+
+// Adds an edge in both directions
+static void AddBidirEdge(const PNGraph& Graph, const int& u, const int& v) {
+  Graph->AddEdge(u, v);
+  Graph->AddEdge(v, u);
+}
+
+// Returns one triangle of each motif M1-M7 and a second M4 triangle sharing an edge
+static PNGraph GetTriangleGraph() {
+  PNGraph Graph = TNGraph::New();
+  for (int n = 1; n <= 22; n++) { Graph->AddNode(n); }
+  // M1: 1 --> 2 --> 3 --> 1
+  Graph->AddEdge(1, 2);  Graph->AddEdge(2, 3);  Graph->AddEdge(3, 1);
+  // M2: 4 <--> 5, 5 --> 6, 6 --> 4
+  AddBidirEdge(Graph, 4, 5);  Graph->AddEdge(5, 6);  Graph->AddEdge(6, 4);
+  // M3: 7 <--> 8, 8 <--> 9, 9 --> 7
+  AddBidirEdge(Graph, 7, 8);  AddBidirEdge(Graph, 8, 9);  Graph->AddEdge(9, 7);
+  // M4: 10, 11, 12 and 10, 11, 13
+  AddBidirEdge(Graph, 10, 11);  AddBidirEdge(Graph, 10, 12);  AddBidirEdge(Graph, 11, 12);
+  AddBidirEdge(Graph, 10, 13);  AddBidirEdge(Graph, 11, 13);
+  // M5: 14 --> 15, 15 --> 16, 14 --> 16
+  Graph->AddEdge(14, 15);  Graph->AddEdge(15, 16);  Graph->AddEdge(14, 16);
+  // M6: 17 <--> 18, 19 --> 17, 19 --> 18
+  AddBidirEdge(Graph, 17, 18);  Graph->AddEdge(19, 17);  Graph->AddEdge(19, 18);
+  // M7: 20 <--> 21, 20 --> 22, 21 --> 22
+  AddBidirEdge(Graph, 20, 21);  Graph->AddEdge(20, 22);  Graph->AddEdge(21, 22);
+  return Graph;
+}
+
+// Returns a star around node 1 with two out-, two in- and two reciprocal edges,
+// and an edge 8 --> 2 that makes node 2 the center of a wedge
+static PNGraph GetWedgeGraph() {
+  PNGraph Graph = TNGraph::New();
+  for (int n = 1; n <= 8; n++) { Graph->AddNode(n); }
+  Graph->AddEdge(1, 2);  Graph->AddEdge(1, 3);
+  Graph->AddEdge(4, 1);  Graph->AddEdge(5, 1);
+  AddBidirEdge(Graph, 1, 6);  AddBidirEdge(Graph, 1, 7);
+  Graph->AddEdge(8, 2);
+  return Graph;
+}
+
+// Test the motif adjacency weights of the directed triangle motifs against hand-computed ones
+TEST(TriadMotifWeighter, Triangles) {
+  PNGraph Graph = GetTriangleGraph();
+  TVec<TIntTrV> ExpVV(13);
+  ExpVV[M1].Add(TIntTr(1, 2, 1));  ExpVV[M1].Add(TIntTr(2, 3, 1));  ExpVV[M1].Add(TIntTr(1, 3, 1));
+  ExpVV[M2].Add(TIntTr(4, 5, 1));  ExpVV[M2].Add(TIntTr(5, 6, 1));  ExpVV[M2].Add(TIntTr(4, 6, 1));
+  ExpVV[M3].Add(TIntTr(7, 8, 1));  ExpVV[M3].Add(TIntTr(8, 9, 1));  ExpVV[M3].Add(TIntTr(7, 9, 1));
+  ExpVV[M4].Add(TIntTr(10, 11, 2));  ExpVV[M4].Add(TIntTr(10, 12, 1));  ExpVV[M4].Add(TIntTr(11, 12, 1));
+  ExpVV[M4].Add(TIntTr(10, 13, 1));  ExpVV[M4].Add(TIntTr(11, 13, 1));
+  ExpVV[M5].Add(TIntTr(14, 15, 1));  ExpVV[M5].Add(TIntTr(15, 16, 1));  ExpVV[M5].Add(TIntTr(14, 16, 1));
+  ExpVV[M6].Add(TIntTr(17, 18, 1));  ExpVV[M6].Add(TIntTr(18, 19, 1));  ExpVV[M6].Add(TIntTr(17, 19, 1));
+  ExpVV[M7].Add(TIntTr(20, 21, 1));  ExpVV[M7].Add(TIntTr(21, 22, 1));  ExpVV[M7].Add(TIntTr(20, 22, 1));
+  // the only wedges are 12 -- 10 -- 13 and 12 -- 11 -- 13, both M13
+  ExpVV[M13].Add(TIntTr(10, 12, 1));  ExpVV[M13].Add(TIntTr(10, 13, 1));
+  ExpVV[M13].Add(TIntTr(11, 12, 1));  ExpVV[M13].Add(TIntTr(11, 13, 1));
+  ExpVV[M13].Add(TIntTr(12, 13, 2));
+  for (int Motif = M1; Motif <= M13; Motif++) {
+    WeightVH weights;
+    MotifCluster::MotifAdjacency(Graph, MotifType(Motif), weights);
+    EXPECT_EQ(Graph->GetMxNId() + 1, weights.Len());
+    CheckWeights(weights, ExpVV[Motif], Motif);
+  }
+}
+
+// Test the motif adjacency weights of the directed wedge motifs against hand-computed ones
+TEST(TriadMotifWeighter, Wedges) {
+  PNGraph Graph = GetWedgeGraph();
+  TVec<TIntTrV> ExpVV(13);
+  // out-out: 2, 3
+  ExpVV[M8].Add(TIntTr(1, 2, 1));  ExpVV[M8].Add(TIntTr(1, 3, 1));  ExpVV[M8].Add(TIntTr(2, 3, 1));
+  // out-in: 2, 3 with 4, 5
+  ExpVV[M9].Add(TIntTr(1, 2, 2));  ExpVV[M9].Add(TIntTr(1, 3, 2));
+  ExpVV[M9].Add(TIntTr(1, 4, 2));  ExpVV[M9].Add(TIntTr(1, 5, 2));
+  ExpVV[M9].Add(TIntTr(2, 4, 1));  ExpVV[M9].Add(TIntTr(2, 5, 1));
+  ExpVV[M9].Add(TIntTr(3, 4, 1));  ExpVV[M9].Add(TIntTr(3, 5, 1));
+  // in-in: 4, 5 around 1 and 1, 8 around 2
+  ExpVV[M10].Add(TIntTr(1, 4, 1));  ExpVV[M10].Add(TIntTr(1, 5, 1));  ExpVV[M10].Add(TIntTr(4, 5, 1));
+  ExpVV[M10].Add(TIntTr(1, 2, 1));  ExpVV[M10].Add(TIntTr(2, 8, 1));  ExpVV[M10].Add(TIntTr(1, 8, 1));
+  // out-reciprocal: 2, 3 with 6, 7
+  ExpVV[M11].Add(TIntTr(1, 2, 2));  ExpVV[M11].Add(TIntTr(1, 3, 2));
+  ExpVV[M11].Add(TIntTr(1, 6, 2));  ExpVV[M11].Add(TIntTr(1, 7, 2));
+  ExpVV[M11].Add(TIntTr(2, 6, 1));  ExpVV[M11].Add(TIntTr(2, 7, 1));
+  ExpVV[M11].Add(TIntTr(3, 6, 1));  ExpVV[M11].Add(TIntTr(3, 7, 1));
+  // in-reciprocal: 4, 5 with 6, 7
+  ExpVV[M12].Add(TIntTr(1, 4, 2));  ExpVV[M12].Add(TIntTr(1, 5, 2));
+  ExpVV[M12].Add(TIntTr(1, 6, 2));  ExpVV[M12].Add(TIntTr(1, 7, 2));
+  ExpVV[M12].Add(TIntTr(4, 6, 1));  ExpVV[M12].Add(TIntTr(4, 7, 1));
+  ExpVV[M12].Add(TIntTr(5, 6, 1));  ExpVV[M12].Add(TIntTr(5, 7, 1));
+  // reciprocal-reciprocal: 6, 7
+  ExpVV[M13].Add(TIntTr(1, 6, 1));  ExpVV[M13].Add(TIntTr(1, 7, 1));  ExpVV[M13].Add(TIntTr(6, 7, 1));
+  for (int Motif = M1; Motif <= M13; Motif++) {
+    WeightVH weights;
+    MotifCluster::MotifAdjacency(Graph, MotifType(Motif), weights);
+    CheckWeights(weights, ExpVV[Motif], Motif);
+  }
+  // every edge has weight 1 in the edge motif, reciprocal edges count once
+  TIntTrV ExpV;
+  ExpV.Add(TIntTr(1, 2, 1));  ExpV.Add(TIntTr(1, 3, 1));  ExpV.Add(TIntTr(1, 4, 1));  ExpV.Add(TIntTr(1, 5, 1));
+  ExpV.Add(TIntTr(1, 6, 1));  ExpV.Add(TIntTr(1, 7, 1));  ExpV.Add(TIntTr(2, 8, 1));
+  WeightVH weights;
+  MotifCluster::MotifAdjacency(Graph, edge, weights);
+  CheckWeights(weights, ExpV, edge);
+}
+
+// Test the weights against counts of the motif instances with the IsMotif checks on a random graph
+TEST(TriadMotifWeighter, Random) {
+  TRnd Rnd(7);
+  PNGraph Graph = TSnap::GenRndGnm<PNGraph>(40, 150, true, Rnd);
+  for (int e = 0; e < 40; e++) { AddBidirEdge(Graph, Rnd.GetUniDevInt(40), Rnd.GetUniDevInt(40)); }
+  for (int n = 0; n < 40; n++) { if (Graph->IsEdge(n, n)) { Graph->DelEdge(n, n); } }
+  for (int Motif = M1; Motif <= M13; Motif++) {
+    TIntTrV ExpV;
+    TIntPrIntH PairWeightH;
+    for (int u = 0; u < 40; u++) {
+      for (int v = u+1; v < 40; v++) {
+        for (int w = v+1; w < 40; w++) {
+          int Instances = 0;
+          switch (Motif) {
+          case M1: Instances = MotifCluster::IsMotifM1(Graph, u, v, w); break;
+          case M2: Instances = MotifCluster::IsMotifM2(Graph, u, v, w); break;
+          case M3: Instances = MotifCluster::IsMotifM3(Graph, u, v, w); break;
+          case M4: Instances = MotifCluster::IsMotifM4(Graph, u, v, w); break;
+          case M5: Instances = MotifCluster::IsMotifM5(Graph, u, v, w); break;
+          case M6: Instances = MotifCluster::IsMotifM6(Graph, u, v, w); break;
+          case M7: Instances = MotifCluster::IsMotifM7(Graph, u, v, w); break;
+          case M8: Instances = MotifCluster::IsMotifM8(Graph, u, v, w) + MotifCluster::IsMotifM8(Graph, v, u, w) + MotifCluster::IsMotifM8(Graph, w, u, v); break;
+          case M9: Instances = MotifCluster::IsMotifM9(Graph, u, v, w) + MotifCluster::IsMotifM9(Graph, v, u, w) + MotifCluster::IsMotifM9(Graph, w, u, v); break;
+          case M10: Instances = MotifCluster::IsMotifM10(Graph, u, v, w) + MotifCluster::IsMotifM10(Graph, v, u, w) + MotifCluster::IsMotifM10(Graph, w, u, v); break;
+          case M11: Instances = MotifCluster::IsMotifM11(Graph, u, v, w) + MotifCluster::IsMotifM11(Graph, v, u, w) + MotifCluster::IsMotifM11(Graph, w, u, v); break;
+          case M12: Instances = MotifCluster::IsMotifM12(Graph, u, v, w) + MotifCluster::IsMotifM12(Graph, v, u, w) + MotifCluster::IsMotifM12(Graph, w, u, v); break;
+          case M13: Instances = MotifCluster::IsMotifM13(Graph, u, v, w) + MotifCluster::IsMotifM13(Graph, v, u, w) + MotifCluster::IsMotifM13(Graph, w, u, v); break;
+          }
+          if (Instances == 0) { continue; }
+          PairWeightH.AddDat(TIntPr(u, v)) += Instances;
+          PairWeightH.AddDat(TIntPr(v, w)) += Instances;
+          PairWeightH.AddDat(TIntPr(u, w)) += Instances;
+        }
+      }
+    }
+    for (int i = 0; i < PairWeightH.Len(); i++) {
+      ExpV.Add(TIntTr(PairWeightH.GetKey(i).Val1, PairWeightH.GetKey(i).Val2, PairWeightH[i]));
+    }
+    WeightVH weights;
+    MotifCluster::MotifAdjacency(Graph, MotifType(Motif), weights);
+    CheckWeights(weights, ExpV, Motif);
+  }
+}
@@ -0,0 +1,159 @@
+#include <gtest/gtest.h>
+
+#include "Snap.h"
+#include "n2v.h"
+
+// Returns a small undirected weighted network, every edge is added in both directions
+static PWNet GetWNet() {
+  PWNet Net = PWNet::New();
+  for (int n = 0; n < 5; n++) { Net->AddNode(n); }
+  const int SrcV[] = { 0, 1, 1, 0, 2, 3, 1 };
+  const int DstV[] = { 1, 2, 3, 3, 4, 4, 4 };
+  const double WgtV[] = { 1, 2, 1, 3, 1, 2, 1 };
+  for (int e = 0; e < 7; e++) {
+    Net->AddEdge(SrcV[e], DstV[e], WgtV[e]);
+    Net->AddEdge(DstV[e], SrcV[e], WgtV[e]);
+  }
+  return Net;
+}
+
+// Counts the third node of the walks whose second node is MidNId
+static void CountSteps(const TVec<TIntV>& WalkVV, const int& MidNId, TIntV& CntV, int& Walks) {
+  CntV.Gen(5);
+  Walks = 0;
+  for (int w = 0; w < WalkVV.Len(); w++) {
+    if (WalkVV[w].Len() < 3 || WalkVV[w][1] != MidNId) { continue; }
+    CntV[WalkVV[w][2]]++;
+    Walks++;
+  }
+}
+
+// Test that the rejection sampling walker follows the same transition
+// probabilities as the walker with precomputed (t, v) alias tables
+TEST(TRejectionWalker, SimulateWalk) {
+  const double ParamP = 2.0, ParamQ = 0.5;
+  const int NWalks = 200000;
+  // second step from t=0 through v=1: edge weight times 1/p for x=t, 1 for
+  // neighbors of t and 1/q otherwise, x=0,2,3,4 give 0.5, 4, 1, 2
+  const double ProbV[] = { 0.5/7.5, 0, 4.0/7.5, 1.0/7.5, 2.0/7.5 };
+
+  PWNet Net = GetWNet();
+  TRejectionWalker Walker(Net, ParamP, ParamQ);
+  EXPECT_LT(0, Walker.GetMemUsed());
+  TVec<TIntV> RejWalkVV(NWalks);
+  TRnd Rnd(1);
+  for (int w = 0; w < NWalks; w++) {
+    Walker.SimulateWalk(0, 3, Rnd, RejWalkVV[w]);
+    ASSERT_EQ(3, RejWalkVV[w].Len());
+  }
+
+  PreprocessTransitionProbs(Net, ParamP, ParamQ, false);
+  TVec<TIntV> WalkVV(NWalks);
+  for (int w = 0; w < NWalks; w++) {
+    SimulateWalk(Net, 0, 3, Rnd, WalkVV[w]);
+    ASSERT_EQ(3, WalkVV[w].Len());
+  }
+
+  TIntV RejCntV, CntV;
+  int RejWalks, Walks;
+  CountSteps(RejWalkVV, 1, RejCntV, RejWalks);
+  CountSteps(WalkVV, 1, CntV, Walks);
+  // the first step is uniform over the two neighbors of node 0
+  EXPECT_NEAR(0.5, RejWalks / double(NWalks), 0.01);
+  EXPECT_NEAR(0.5, Walks / double(NWalks), 0.01);
+  for (int x = 0; x < 5; x++) {
+    EXPECT_NEAR(ProbV[x], RejCntV[x] / double(RejWalks), 0.01) << "Node " << x;
+    EXPECT_NEAR(ProbV[x], CntV[x] / double(Walks), 0.01) << "Node " << x;
+  }
+
+  // longer walks visit the nodes equally often with both walkers
+  TIntV RejVisitV(5), VisitV(5);
+  for (int w = 0; w < 20000; w++) {
+    TIntV RejWalkV, WalkV;
+    Walker.SimulateWalk(w % 5, 20, Rnd, RejWalkV);
+    SimulateWalk(Net, w % 5, 20, Rnd, WalkV);
+    ASSERT_EQ(20, RejWalkV.Len());
+    ASSERT_EQ(20, WalkV.Len());
+    for (int i = 0; i < 20; i++) { RejVisitV[RejWalkV[i]]++;  VisitV[WalkV[i]]++; }
+  }
+  for (int n = 0; n < 5; n++) {
+    EXPECT_NEAR(VisitV[n] / 400000.0, RejVisitV[n] / 400000.0, 0.01) << "Node " << n;
+  }
+}
+
+// Writes the walks to a spill file in batches of up to 7 walks, reads them back one by one and compares them
+static void CheckWalkSpill(const TStr& FNm, const TVec<TIntV>& WalkVV) {
+  {
+    PSOut SOut = TZipOut::NewIfZip(FNm);
+    TIntV BatchV;
+    for (int w = 0; w < WalkVV.Len(); w++) {
+      BatchV.AddV(WalkVV[w]);
+      if (w % 7 == 6 || w == WalkVV.Len()-1) { SaveWalkSpill(SOut, BatchV);  BatchV.Clr(false); }
+    }
+  }
+  PSIn SIn = TZipIn::NewIfZip(FNm);
+  TIntV WalkV;
+  for (int w = 0; w < WalkVV.Len(); w++) {
+    WalkV.Clr(false);
+    ASSERT_TRUE(LoadWalkSpill(SIn, WalkV));
+    EXPECT_TRUE(WalkV == WalkVV[w]) << "Walk " << w;
+  }
+  WalkV.Clr(false);
+  EXPECT_FALSE(LoadWalkSpill(SIn, WalkV));
+}
+
+// Test that walks read back from a spill file equal the walks that were written
+TEST(TWalkSpill, SaveLoad) {
+  TVec<TIntV> WalkVV;
+  // indices that need one to five varint bytes
+  const int IdxV[] = { 0, 126, 127, 128, 16382, 16383, 16384, 2097151, 2097152, 268435455, 268435456, TInt::Mx-1 };
+  TIntV WalkV;
+  for (int i = 0; i < 12; i++) { WalkV.Add(IdxV[i]); }
+  WalkV.Add(-1);
+  WalkVV.Add(WalkV);
+  // random walks, including a walk of one node
+  TRnd Rnd(3);
+  for (int w = 0; w < 100; w++) {
+    WalkV.Clr();
+    const int Len = w == 0 ? 1 : Rnd.GetUniDevInt(1, 80);
+    for (int i = 0; i < Len; i++) { WalkV.Add(Rnd.GetUniDevInt(100000)); }
+    WalkV.Add(-1);
+    WalkVV.Add(WalkV);
+  }
+  CheckWalkSpill("test.walks.dat", WalkVV);
+  if (system("which 7za > /dev/null 2>&1") == 0) {
+    CheckWalkSpill("test.walks.gz", WalkVV);
+  } else {
+    printf("7za not found, zip output is not tested\n");
+  }
+}
+
+// Test the walks that node2vec writes to its spill file
+TEST(TWalkSpill, Node2Vec) {
+  PWNet Net = GetWNet();
+  TIntV NIdV;
+  for (TWNet::TNodeI NI = Net->BegNI(); NI < Net->EndNI(); NI++) { NIdV.Add(NI.GetId()); }
+  const int WalkLen = 10, NumWalks = 4;
+  for (int Reject = 0; Reject < 2; Reject++) {
+    TVVec<TInt, int64> WalksVV;
+    TIntFltVH EmbeddingsHV;
+    node2vec(Net, 1.0, 1.0, 8, WalkLen, NumWalks, 3, 1, false, false, WalksVV, EmbeddingsHV, Reject == 1, "test.walks.dat");
+    EXPECT_EQ(Net->GetNodes(), EmbeddingsHV.Len());
+    PSIn SIn = TZipIn::NewIfZip("test.walks.dat");
+    TIntV WalkV, StartCntV(NIdV.Len());
+    int Walks = 0;
+    while (LoadWalkSpill(SIn, WalkV)) {
+      ASSERT_EQ(WalkLen+1, WalkV.Len());
+      EXPECT_EQ(-1, WalkV.Last());
+      StartCntV[WalkV[0]]++;
+      for (int i = 1; i < WalkLen; i++) {
+        EXPECT_TRUE(Net->IsEdge(NIdV[WalkV[i-1]], NIdV[WalkV[i]]));
+      }
+      WalkV.Clr(false);
+      Walks++;
+    }
+    // every node starts NumWalks walks
+    EXPECT_EQ(NumWalks * Net->GetNodes(), Walks);
+    for (int n = 0; n < NIdV.Len(); n++) { EXPECT_EQ(NumWalks, StartCntV[n]); }
+  }
+}
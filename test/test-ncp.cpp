@@ -0,0 +1,127 @@
+#include <gtest/gtest.h>
+
+#include "Snap.h"
+#include "ncp.h"
+
+// Returns a connected graph of Cmtys dense communities of CmtySz nodes joined by InterEdges random edges
+static PUNGraph GetCmtyGraph(const int& Cmtys, const int& CmtySz, const int& InterEdges) {
+  TRnd Rnd(5);
+  const int Nodes = Cmtys * CmtySz;
+  PUNGraph Graph = TUNGraph::New();
+  for (int n = 0; n < Nodes; n++) { Graph->AddNode(n); }
+  for (int c = 0; c < Cmtys; c++) {
+    for (int n = 1; n < CmtySz; n++) { Graph->AddEdge(c*CmtySz + n, c*CmtySz + Rnd.GetUniDevInt(n)); }
+    for (int e = 0; e < 3 * CmtySz; e++) {
+      Graph->AddEdge(c*CmtySz + Rnd.GetUniDevInt(CmtySz), c*CmtySz + Rnd.GetUniDevInt(CmtySz)); }
+  }
+  for (int c = 1; c < Cmtys; c++) { Graph->AddEdge(c*CmtySz, Rnd.GetUniDevInt(c*CmtySz)); }
+  for (int e = 0; e < InterEdges; e++) {
+    Graph->AddEdge(Rnd.GetUniDevInt(Nodes), Rnd.GetUniDevInt(Nodes)); }
+  TSnap::DelSelfEdges(Graph);
+  return Graph;
+}
+
+// Collects the sweeps of all seeds
+class TSweepCollector : public TLocClustBatch::TVisitor {
+public:
+  TVec<TLocClustBatch::TSweep> SweepV;
+public:
+  TSweepCollector(const int& Seeds) : SweepV(Seeds) { }
+  void OnSweep(const int& ThreadN, const int& SeedN, const TLocClustBatch::TSweep& Sweep) { SweepV[SeedN] = Sweep; }
+};
+
+// Test the sweeps of the batch against TLocClust, both are computed from an approximate
+// PageRank with residuals below Eps*degree, so the best conductances are close
+TEST(TLocClustBatch, Run) {
+  PUNGraph Graph = GetCmtyGraph(6, 40, 30);
+  TIntV SeedNIdV;
+  for (TUNGraph::TNodeI NI = Graph->BegNI(); NI < Graph->EndNI(); NI++) { SeedNIdV.Add(NI.GetId()); }
+  TLocClustBatch Batch(Graph, 0.001);
+  EXPECT_LT(0, Batch.GetThreads());
+  TLocClust Clust(Graph, 0.001);
+  const int ClustSzV[] = { 10, 100, 1000 };
+  for (int c = 0; c < 3; c++) {
+    TSweepCollector Collector(SeedNIdV.Len());
+    Batch.Run(SeedNIdV, ClustSzV[c], Collector);
+    int SameCuts = 0;
+    for (int s = 0; s < SeedNIdV.Len(); s++) {
+      const TLocClustBatch::TSweep& Sweep = Collector.SweepV[s];
+      Clust.FindBestCut(SeedNIdV[s], ClustSzV[c]);
+      ASSERT_EQ(SeedNIdV[s], Sweep.SeedNId);
+      ASSERT_LT(0, Sweep.Len());
+      ASSERT_EQ(Sweep.Len(), Sweep.NIdV.Len());
+      // the volume and cut of every prefix of the sweep are exact
+      for (int i = 0; i < Sweep.Len(); i += 7) {
+        TIntV NIdV;
+        Sweep.NIdV.GetSubValV(0, i, NIdV);
+        int Vol, Cut;
+        double Phi;
+        TLocClust::GetCutStat(Graph, NIdV, Vol, Cut, Phi);
+        EXPECT_EQ(Vol, Sweep.GetVol(i));
+        EXPECT_EQ(Cut, Sweep.GetCut(i));
+      }
+      EXPECT_NEAR(Clust.GetCutPhi(), Sweep.GetCutPhi(), 0.1) << "Seed " << SeedNIdV[s];
+      if (Clust.BestCutNodes() == Sweep.BestCutNodes() && Clust.GetCutPhi() == Sweep.GetCutPhi()) { SameCuts++; }
+    }
+    // the residuals are pushed in a different order, most seeds still find the same cut
+    EXPECT_LE(3 * SeedNIdV.Len() / 4, SameCuts);
+  }
+}
+
+// Returns the best conductance at every cluster size over the same seeds as TLocClustStat::Run(), one seed at a time with TLocClust
+static void GetSeqBestPhi(const PUNGraph& Graph, const double& Alpha, const int& KMin, const int& KMax, const double& KFac,
+  const int& Coverage, TIntFltH& SizePhiH, TIntH& SizeCondH) {
+  TLocClust Clust(Graph, Alpha);
+  int PrevK = -1;
+  bool NextDone = false;
+  for (int K = KMin; K < KMax; K = int(KFac * double(K))+1) {
+    if (K == PrevK) { K++; } PrevK = K;
+    const int Runs = 2 + int(Coverage * floor(double(Graph->GetEdges()) / double(K)));
+    if (NextDone) { break; }
+    if (K+1 > 2*Graph->GetEdges()) { K = Graph->GetEdges(); NextDone = true; }
+    for (int run = 0; run < Runs; run++) {
+      Clust.FindBestCut(Graph->GetRndNId(), K);
+      const double Phi = TMath::Round(Clust.GetCutPhi(), 4);
+      if (Clust.BestCutNodes() == 0 || Clust.GetCutVol() == 0 || Phi == 0) { continue; }
+      for (int s = 0; s < Clust.Len(); s++) {
+        const int Cut = Clust.GetCut(s);
+        const double phi = Clust.GetPhi(s);
+        if (phi != double(Cut)/double(Clust.GetVol(s))) { continue; }
+        if (! SizePhiH.IsKey(s+1) || SizePhiH.GetDat(s+1) > phi) { SizePhiH.AddDat(s+1, phi); }
+        SizeCondH.AddDat(s+1)++;
+      }
+    }
+  }
+}
+
+// Test the statistics gathered from the parallel batches against seeds processed one by one
+TEST(TLocClustStat, Run) {
+  PUNGraph Graph = GetCmtyGraph(6, 40, 30);
+  const double Alpha = 0.001, KFac = 1.5;
+  const int KMin = 10, KMax = 1000, Coverage = 2;
+  TLocClustStat ClustStat(Alpha, KMin, KMax, KFac, Coverage, 0.001);
+  TInt::Rnd.PutSeed(1);
+  ClustStat.Run(Graph, false, true, false);
+  TIntFltH SeqPhiH;
+  TIntH SeqCondH;
+  TInt::Rnd.PutSeed(1);
+  GetSeqBestPhi(Graph, Alpha, KMin, KMax, KFac, Coverage, SeqPhiH, SeqCondH);
+  int Common = 0;
+  for (int i = 0; i < SeqPhiH.Len(); i++) {
+    const int Size = SeqPhiH.GetKey(i);
+    if (! ClustStat.BestCutH.IsKey(Size)) { continue; }
+    EXPECT_NEAR(SeqPhiH[i], ClustStat.BestCutH.GetDat(Size).GetPhi(), 0.1) << "Size " << Size;
+    Common++;
+  }
+  EXPECT_LE(9 * SeqPhiH.Len() / 10, Common);
+  // the best cut at every size is the smallest of all conductances at that size
+  for (int i = 0; i < ClustStat.SizePhiH.Len(); i++) {
+    const int Size = ClustStat.SizePhiH.GetKey(i);
+    const TFltV& PhiV = ClustStat.SizePhiH[i];
+    ASSERT_LT(0, PhiV.Len());
+    EXPECT_TRUE(PhiV.IsSorted());
+    EXPECT_DOUBLE_EQ(ClustStat.BestCutH.GetDat(Size).GetPhi(), PhiV[0]);
+    // about as many sweeps reach the size as with TLocClust
+    EXPECT_NEAR(SeqCondH.IsKey(Size) ? SeqCondH.GetDat(Size).Val : 0, PhiV.Len(), 0.5 * PhiV.Len() + 1) << "Size " << Size;
+  }
+}
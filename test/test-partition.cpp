@@ -0,0 +1,157 @@
+#include <gtest/gtest.h>
+
+#include "Snap.h"
+
+// Returns a graph of Cmtys dense communities of CmtySz nodes joined by InterEdges random edges,
+// node ids are shuffled so that the communities are not contiguous
+static PUNGraph GetCmtyGraph(const int& Cmtys, const int& CmtySz, const int& InterEdges) {
+  TRnd Rnd(7);
+  const int Nodes = Cmtys * CmtySz;
+  TIntV NIdV(Nodes);
+  for (int n = 0; n < Nodes; n++) { NIdV[n] = n; }
+  NIdV.Shuffle(Rnd);
+  PUNGraph Graph = TUNGraph::New();
+  for (int n = 0; n < Nodes; n++) { Graph->AddNode(n); }
+  for (int c = 0; c < Cmtys; c++) {
+    for (int e = 0; e < 5 * CmtySz; e++) {
+      Graph->AddEdge(NIdV[c*CmtySz + Rnd.GetUniDevInt(CmtySz)], NIdV[c*CmtySz + Rnd.GetUniDevInt(CmtySz)]); }
+  }
+  for (int e = 0; e < InterEdges; e++) {
+    Graph->AddEdge(NIdV[Rnd.GetUniDevInt(Nodes)], NIdV[Rnd.GetUniDevInt(Nodes)]); }
+  return Graph;
+}
+
+// Test the quality measures on small graphs
+TEST(TGraphPart, Metrics) {
+  PUNGraph Graph = TUNGraph::New();
+  for (int n = 0; n < 4; n++) { Graph->AddNode(n); }
+  Graph->AddEdge(0, 1);  Graph->AddEdge(1, 2);  Graph->AddEdge(2, 3);  Graph->AddEdge(3, 3);
+  TGraphPart Part(Graph);
+  TIntIntH NIdPartH;
+  NIdPartH.AddDat(0, 0);  NIdPartH.AddDat(1, 0);  NIdPartH.AddDat(2, 1);  NIdPartH.AddDat(3, 1);
+  Part.SetNIdPartH(NIdPartH);
+  EXPECT_EQ(2, Part.GetParts());
+  EXPECT_EQ(1, Part.GetPart(2));
+  EXPECT_EQ(4, Part.GetEdges());
+  EXPECT_EQ(1, Part.GetEdgeCut());
+  EXPECT_DOUBLE_EQ(0.25, Part.GetEdgeCutFrac());
+  EXPECT_DOUBLE_EQ(1.5, Part.GetReplicationFactor());
+  EXPECT_DOUBLE_EQ(1.0, Part.GetImbalance());
+  TIntIntH NIdPartH1;
+  Part.GetNIdPartH(NIdPartH1);
+  EXPECT_TRUE(NIdPartH1 == NIdPartH);
+
+  // edges in both directions count twice in directed graphs
+  PNGraph DGraph = TNGraph::New();
+  for (int n = 0; n < 3; n++) { DGraph->AddNode(n); }
+  DGraph->AddEdge(0, 1);  DGraph->AddEdge(1, 0);  DGraph->AddEdge(1, 2);
+  TGraphPart DPart(DGraph);
+  NIdPartH.Clr();
+  NIdPartH.AddDat(0, 0);  NIdPartH.AddDat(1, 1);  NIdPartH.AddDat(2, 1);
+  DPart.SetNIdPartH(NIdPartH);
+  EXPECT_EQ(3, DPart.GetEdges());
+  EXPECT_EQ(2, DPart.GetEdgeCut());
+  EXPECT_DOUBLE_EQ(5.0/3.0, DPart.GetReplicationFactor());
+  EXPECT_DOUBLE_EQ(4.0/3.0, DPart.GetImbalance());
+}
+
+// Test that the partitioners keep the balance and cut fewer edges than hashing
+TEST(TGraphPart, Partitioners) {
+  const int Parts = 4;
+  PUNGraph Graph = GetCmtyGraph(8, 100, 100);
+  TGraphPart Part(Graph);
+  TIntIntH NIdPartH;
+  for (TUNGraph::TNodeI NI = Graph->BegNI(); NI < Graph->EndNI(); NI++) {
+    NIdPartH.AddDat(NI.GetId(), NI.GetId() % Parts); }
+  Part.SetNIdPartH(NIdPartH);
+  const int64 HashCut = Part.GetEdgeCut();
+  const double HashRepl = Part.GetReplicationFactor();
+
+  for (int Alg = 0; Alg < 3; Alg++) {
+    if (Alg == 0) { Part.PartLdg(Parts); }
+    else if (Alg == 1) { Part.PartFennel(Parts); }
+    else { Part.PartMultilevel(Parts); }
+    EXPECT_EQ(Parts, Part.GetParts());
+    int Nodes = 0;
+    for (int p = 0; p < Parts; p++) { Nodes += Part.GetPartSz(p); }
+    EXPECT_EQ(Graph->GetNodes(), Nodes);
+    EXPECT_GE(1.05, Part.GetImbalance());
+    EXPECT_GT(HashCut / 2, Part.GetEdgeCut());
+    EXPECT_GT(HashRepl, Part.GetReplicationFactor());
+  }
+  // the multilevel partitioner finds the communities
+  EXPECT_GT(200, Part.GetEdgeCut());
+
+  TRnd Rnd(11);
+  PNGraph DGraph = TSnap::GenRndGnm<PNGraph>(1000, 5000, true, Rnd);
+  TGraphPart DPart(DGraph);
+  DPart.PartMultilevel(8, 0.03);
+  EXPECT_GE(1.03, DPart.GetImbalance());
+  EXPECT_GT(1.0, DPart.GetEdgeCutFrac());
+}
+
+// Test the partitioned graph snapshot
+TEST(TPartCsrGraph, Build) {
+  TRnd Rnd(12);
+  PNGraph Graph = TSnap::GenRndGnm<PNGraph>(500, 3000, true, Rnd);
+  Graph->DelNode(7);
+  TGraphPart Part(Graph);
+  Part.PartLdg(3);
+  const TPartCsrGraph PartGraph(Part);
+  EXPECT_TRUE(PartGraph.IsDirected());
+  EXPECT_EQ(3, PartGraph.GetParts());
+  EXPECT_EQ(Graph->GetNodes(), PartGraph.GetNodes());
+  EXPECT_EQ(-1, PartGraph.GetNIdx(7));
+  for (int p = 0; p < PartGraph.GetParts(); p++) {
+    EXPECT_EQ(Part.GetPartSz(p), PartGraph.GetPartSz(p));
+    for (int NIdx = PartGraph.GetPartBeg(p); NIdx < PartGraph.GetPartEnd(p); NIdx++) {
+      EXPECT_EQ(p, PartGraph.GetPart(NIdx));
+      EXPECT_EQ(Part.GetPart(PartGraph.GetNId(NIdx)), p);
+    }
+  }
+  for (TNGraph::TNodeI NI = Graph->BegNI(); NI < Graph->EndNI(); NI++) {
+    const int NIdx = PartGraph.GetNIdx(NI.GetId());
+    ASSERT_EQ(NI.GetId(), PartGraph.GetNId(NIdx));
+    ASSERT_EQ(NI.GetOutDeg(), PartGraph.GetOutDeg(NIdx));
+    ASSERT_EQ(NI.GetInDeg(), PartGraph.GetInDeg(NIdx));
+    for (int e = 0; e < NI.GetOutDeg(); e++) { EXPECT_EQ(NI.GetOutNId(e), PartGraph.GetNId(PartGraph.BegOut(NIdx)[e])); }
+    for (int e = 0; e < NI.GetInDeg(); e++) { EXPECT_EQ(NI.GetInNId(e), PartGraph.GetNId(PartGraph.BegIn(NIdx)[e])); }
+  }
+  EXPECT_LT(0, PartGraph.GetMemUsed());
+}
+
+#ifdef USE_OPENMP
+// Test PageRank and breadth first search with a partition map
+TEST(TPartCsrGraph, Algorithms) {
+  TRnd Rnd(13);
+  PNGraph Graph = TSnap::GenRndGnm<PNGraph>(1000, 4000, true, Rnd);
+  TGraphPart Part(Graph);
+  Part.PartMultilevel(4);
+  TIntIntH NIdPartH;
+  Part.GetNIdPartH(NIdPartH);
+
+  TIntFltH PRankH, PartPRankH;
+  TSnap::GetPageRankMP(Graph, PRankH, 0.85, 1e-10, 100);
+  TSnap::GetPageRankMP(Graph, PartPRankH, NIdPartH, 0.85, 1e-10, 100);
+  ASSERT_EQ(PRankH.Len(), PartPRankH.Len());
+  for (int i = 0; i < PRankH.Len(); i++) {
+    EXPECT_NEAR(PRankH[i], PartPRankH.GetDat(PRankH.GetKey(i)), 1e-9);
+  }
+
+  const int StartNId = Graph->BegNI().GetId();
+  TIntV DistV, PartDistV;
+  const int Depth = TSnap::GetShortestDistancesMP2(Graph, StartNId, true, false, DistV);
+  EXPECT_EQ(Depth, TSnap::GetShortestDistancesMP2(Graph, StartNId, true, false, NIdPartH, PartDistV));
+  EXPECT_TRUE(DistV == PartDistV);
+
+  // following in-edges as well gives the undirected distances
+  const TPartCsrGraph PartGraph(Part);
+  TSnap::GetShortestDistancesMP2(PartGraph, StartNId, true, true, PartDistV);
+  TIntH NIdToDistH;
+  TSnap::GetShortPath(Graph, StartNId, NIdToDistH, false);
+  for (TNGraph::TNodeI NI = Graph->BegNI(); NI < Graph->EndNI(); NI++) {
+    if (NIdToDistH.IsKey(NI.GetId())) { EXPECT_EQ(NIdToDistH.GetDat(NI.GetId()), PartDistV[NI.GetId()]); }
+  }
+  EXPECT_EQ(NIdToDistH.Len(), Graph->GetNodes() - PartDistV.Count(2147483646));
+}
+#endif
@@ -0,0 +1,107 @@
+#include <gtest/gtest.h>
+
+#include "Snap.h"
+#include "rolx.h"
+
+// Random graph with a star and an isolated node
+static PUNGraph GetRolXGraph() {
+  TRnd Rnd(7);
+  PUNGraph Graph = TSnap::GenRndGnm<PUNGraph>(200, 700, false, Rnd);
+  Graph->AddNode(200);
+  for (int n = 0; n < 40; n++) { Graph->AddEdge(200, n); }
+  Graph->AddNode(201);
+  return Graph;
+}
+
+// Test the dense local and egonet features against the hash-based ones
+TEST(RolX, NeighborhoodFeatures) {
+  PUNGraph Graph = GetRolXGraph();
+  TFltVV FtrVV;
+  TIntIntH NodeIdMtxIdxH;
+  ExtractFeatures(Graph, FtrVV, NodeIdMtxIdxH);
+  ASSERT_EQ(Graph->GetNodes(), FtrVV.GetXDim());
+  ASSERT_EQ(Graph->GetNodes(), NodeIdMtxIdxH.Len());
+  ASSERT_LE(3, FtrVV.GetYDim());
+
+  TIntFtrH Features = CreateEmptyFeatures(Graph);
+  AddLocalFeatures(Graph, Features);
+  AddEgonetFeatures(Graph, Features);
+  ASSERT_EQ(3, GetNumFeatures(Features));
+  for (TUNGraph::TNodeI NI = Graph->BegNI(); NI < Graph->EndNI(); NI++) {
+    const int i = GetMtxIdx(NI.GetId(), NodeIdMtxIdxH);
+    const TFtr& Feature = Features.GetDat(NI.GetId());
+    for (int j = 0; j < 3; j++) {
+      EXPECT_DOUBLE_EQ(Feature[j], FtrVV(i, j)) << "node " << NI.GetId() << " feature " << j;
+    }
+  }
+}
+
+// Test that the recursive features match the hash-based ones and do not change between runs
+TEST(RolX, RecursiveFeatures) {
+  PUNGraph Graph = GetRolXGraph();
+  TFltVV FtrVV, FtrVV2;
+  TIntIntH NodeIdMtxIdxH, NodeIdMtxIdxH2;
+  ExtractFeatures(Graph, FtrVV, NodeIdMtxIdxH);
+  ExtractFeatures(Graph, FtrVV2, NodeIdMtxIdxH2);
+  EXPECT_LT(3, FtrVV.GetYDim());
+  ASSERT_EQ(FtrVV.GetYDim(), FtrVV2.GetYDim());
+  for (int i = 0; i < FtrVV.GetXDim(); i++) {
+    for (int j = 0; j < FtrVV.GetYDim(); j++) {
+      ASSERT_DOUBLE_EQ(FtrVV(i, j), FtrVV2(i, j));
+    }
+  }
+
+  TIntFtrH Features = CreateEmptyFeatures(Graph);
+  AddNeighborhoodFeatures(Graph, Features);
+  AddRecursiveFeatures(Graph, Features);
+  ASSERT_EQ(FtrVV.GetYDim(), GetNumFeatures(Features));
+  for (TUNGraph::TNodeI NI = Graph->BegNI(); NI < Graph->EndNI(); NI++) {
+    const int i = GetMtxIdx(NI.GetId(), NodeIdMtxIdxH);
+    const TFtr& Feature = Features.GetDat(NI.GetId());
+    // the hash-based recursive features are sums and means computed in float
+    for (int j = 0; j < FtrVV.GetYDim(); j++) {
+      EXPECT_NEAR(Feature[j], FtrVV(i, j), 1e-6 * (1 + TFlt::Abs(Feature[j])));
+    }
+  }
+
+  TIntFtrH HashFeatures = ExtractFeatures(Graph);
+  EXPECT_EQ(FtrVV.GetYDim(), GetNumFeatures(HashFeatures));
+}
+
+// Test that the factorization is non-negative and that iterating longer does not increase the cost
+TEST(RolX, CalcNonNegativeFactorization) {
+  PUNGraph Graph = GetRolXGraph();
+  TFltVV FtrVV;
+  TIntIntH NodeIdMtxIdxH;
+  ExtractFeatures(Graph, FtrVV, NodeIdMtxIdxH);
+  const int NumRoles = 4;
+  const double Thresholds[] = {1e-2, 1e-4, 1e-6};
+  double FirstCost = 0, PrevCost = TFlt::Mx;
+  for (int t = 0; t < 3; t++) {
+    TFltVV W, H;
+    CalcNonNegativeFactorization(FtrVV, NumRoles, W, H, Thresholds[t]);
+    ASSERT_EQ(FtrVV.GetXDim(), W.GetXDim());
+    ASSERT_EQ(NumRoles, W.GetYDim());
+    ASSERT_EQ(NumRoles, H.GetXDim());
+    ASSERT_EQ(FtrVV.GetYDim(), H.GetYDim());
+    for (int i = 0; i < W.GetXDim(); i++) {
+      for (int a = 0; a < NumRoles; a++) { ASSERT_LE(0.0, W(i, a)); }
+    }
+    for (int a = 0; a < NumRoles; a++) {
+      for (int j = 0; j < H.GetYDim(); j++) { ASSERT_LE(0.0, H(a, j)); }
+    }
+    const double Cost = CalcDescriptionLength(FtrVV, W, H);
+    EXPECT_LE(Cost, PrevCost * (1 + 1e-12)) << "threshold " << Thresholds[t];
+    if (t == 0) { FirstCost = Cost; }
+    PrevCost = Cost;
+
+    TIntIntH Roles = FindRoles(W, NodeIdMtxIdxH);
+    EXPECT_EQ(Graph->GetNodes(), Roles.Len());
+    for (int r = 0; r < Roles.Len(); r++) {
+      EXPECT_LE(0, Roles[r]);
+      EXPECT_GT(NumRoles, Roles[r]);
+    }
+  }
+  // the isolated node has an all-zero row, it must not stop the iterations early
+  EXPECT_LT(PrevCost, FirstCost);
+}
@@ -0,0 +1,215 @@
+#include <gtest/gtest.h>
+
+#include "Snap.h"
+
+// Returns a small weighted network with a zero-weight chain, parallel paths of
+// different lengths and node 6 which is not reachable from node 0 along edge directions
+static PNEANet GetWgtNet(TFltV& EWgtV) {
+  PNEANet Net = TNEANet::New();
+  for (int n = 0; n < 8; n++) { Net->AddNode(n); }
+  const int SrcV[] = { 0, 0, 1, 2, 1, 3, 4, 6, 5 };
+  const int DstV[] = { 1, 2, 2, 3, 3, 4, 5, 0, 1 };
+  const double WgtV[] = { 2, 5, 1, 0, 6, 3, 0, 1, 4 };
+  EWgtV.Gen(9);
+  for (int e = 0; e < 9; e++) {
+    const int EId = Net->AddEdge(SrcV[e], DstV[e]);
+    EWgtV[EId] = WgtV[e];
+    Net->AddFltAttrDatE(EId, WgtV[e], "Wgt");
+  }
+  return Net;
+}
+
+// Returns a random network with random integer weights, some of them zero
+static PNEANet GetRndWgtNet(const int& Nodes, const int& Edges, TFltV& EWgtV) {
+  TRnd Rnd(11);
+  PNEANet Net = TNEANet::New();
+  for (int n = 0; n < Nodes; n++) { Net->AddNode(n); }
+  for (int e = 0; e < Edges; e++) {
+    Net->AddEdge(Rnd.GetUniDevInt(Nodes), Rnd.GetUniDevInt(Nodes)); }
+  EWgtV.Gen(Net->GetMxEId());
+  for (int e = 0; e < EWgtV.Len(); e++) { EWgtV[e] = Rnd.GetUniDevInt(10); }
+  return Net;
+}
+
+// Exact remaining distances to node 5, a consistent A* heuristic
+class TToFiveHeuristic {
+public:
+  double operator () (const int& NId, const int& DstNId) const {
+    const double DistV[] = { 6, 4, 3, 3, 0, 0, 0, 0 };
+    return DistV[NId];
+  }
+};
+
+// Test Dijkstra and A* against hand-computed distances
+TEST(TWgtShortPath, Dijkstra) {
+  TFltV EWgtV;
+  PNEANet Net = GetWgtNet(EWgtV);
+  TWgtShortPath ShortPath(Net, EWgtV);
+  ShortPath.GetDijkstra(0);
+  const double DistV[] = { 0, 2, 3, 3, 6, 6 };
+  for (int n = 0; n < 6; n++) {
+    EXPECT_TRUE(ShortPath.IsReached(n));
+    EXPECT_DOUBLE_EQ(DistV[n], ShortPath.GetDist(n));
+  }
+  EXPECT_FALSE(ShortPath.IsReached(6));
+  EXPECT_FALSE(ShortPath.IsReached(7));
+  EXPECT_EQ(TFlt::Mx, ShortPath.GetDist(6));
+  EXPECT_EQ(TFlt::Mx, ShortPath.GetDist(100));
+
+  TIntFltH NIdDistH;
+  ShortPath.GetNIdDistH(NIdDistH);
+  EXPECT_EQ(6, NIdDistH.Len());
+  EXPECT_DOUBLE_EQ(6, NIdDistH.GetDat(5));
+
+  TIntV PathV;
+  ShortPath.GetPath(5, PathV);
+  const int ExpPathV[] = { 0, 1, 2, 3, 4, 5 };
+  ASSERT_EQ(6, PathV.Len());
+  for (int i = 0; i < PathV.Len(); i++) { EXPECT_EQ(ExpPathV[i], PathV[i]); }
+  ShortPath.GetPath(6, PathV);
+  EXPECT_EQ(0, PathV.Len());
+
+  // a new query does not see the results of the previous one
+  ShortPath.GetDijkstra(6);
+  EXPECT_DOUBLE_EQ(0, ShortPath.GetDist(6));
+  EXPECT_DOUBLE_EQ(7, ShortPath.GetDist(5));
+  ShortPath.GetDijkstra(5);
+  EXPECT_DOUBLE_EQ(4, ShortPath.GetDist(1));
+  EXPECT_FALSE(ShortPath.IsReached(0));
+
+  // weights from an attribute, and ignoring edge directions
+  TWgtShortPath AttrShortPath(Net, TStr("Wgt"));
+  AttrShortPath.GetDijkstra(0);
+  for (int n = 0; n < 6; n++) { EXPECT_DOUBLE_EQ(DistV[n], AttrShortPath.GetDist(n)); }
+  TWgtShortPath UndirShortPath(Net, EWgtV, false);
+  UndirShortPath.GetDijkstra(0);
+  EXPECT_DOUBLE_EQ(1, UndirShortPath.GetDist(6));
+  EXPECT_DOUBLE_EQ(6, UndirShortPath.GetDist(5));
+  EXPECT_FALSE(UndirShortPath.IsReached(7));
+  UndirShortPath.GetDijkstra(5);
+  EXPECT_DOUBLE_EQ(6, UndirShortPath.GetDist(0));
+  EXPECT_DOUBLE_EQ(7, UndirShortPath.GetDist(6));
+
+  EXPECT_DOUBLE_EQ(6, ShortPath.GetAStar(0, 5, TZeroHeuristic()));
+  EXPECT_DOUBLE_EQ(6, ShortPath.GetAStar(0, 5, TToFiveHeuristic()));
+  ShortPath.GetPath(5, PathV);
+  ASSERT_EQ(6, PathV.Len());
+  for (int i = 0; i < PathV.Len(); i++) { EXPECT_EQ(ExpPathV[i], PathV[i]); }
+  EXPECT_DOUBLE_EQ(3, ShortPath.GetAStar(0, 3, TZeroHeuristic()));
+  EXPECT_DOUBLE_EQ(-1, ShortPath.GetAStar(0, 6, TZeroHeuristic()));
+  EXPECT_DOUBLE_EQ(-1, ShortPath.GetAStar(0, 7, TZeroHeuristic()));
+}
+
+// Test that queries with targets settle the targets
+TEST(TWgtShortPath, Targets) {
+  TFltV EWgtV;
+  PNEANet Net = GetWgtNet(EWgtV);
+  TWgtShortPath ShortPath(Net, EWgtV);
+  TIntV TargetV;
+  TargetV.Add(2);
+  ShortPath.GetDijkstra(0, TargetV);
+  EXPECT_DOUBLE_EQ(3, ShortPath.GetDist(2));
+  EXPECT_DOUBLE_EQ(2, ShortPath.GetDist(1));
+  EXPECT_FALSE(ShortPath.IsReached(5));
+  TargetV.Add(4);
+  ShortPath.GetDijkstra(0, TargetV);
+  EXPECT_DOUBLE_EQ(3, ShortPath.GetDist(2));
+  EXPECT_DOUBLE_EQ(6, ShortPath.GetDist(4));
+  // an unreachable target makes the query run to completion
+  TargetV.Add(6);
+  ShortPath.GetDijkstra(0, TargetV);
+  EXPECT_DOUBLE_EQ(6, ShortPath.GetDist(5));
+  EXPECT_FALSE(ShortPath.IsReached(6));
+#ifdef USE_OPENMP
+  TargetV.Clr();
+  TargetV.Add(3);
+  ShortPath.GetDeltaStepping(0, 1, TargetV);
+  EXPECT_DOUBLE_EQ(3, ShortPath.GetDist(3));
+  EXPECT_DOUBLE_EQ(3, ShortPath.GetDist(2));
+#endif
+}
+
+#ifdef USE_OPENMP
+// Test delta-stepping against hand-computed distances for several bucket widths
+TEST(TWgtShortPath, DeltaStepping) {
+  TFltV EWgtV;
+  PNEANet Net = GetWgtNet(EWgtV);
+  TWgtShortPath ShortPath(Net, EWgtV);
+  const double DeltaV[] = { -1, 0.5, 1, 2.5, 100 };
+  const double DistV[] = { 0, 2, 3, 3, 6, 6 };
+  for (int d = 0; d < 5; d++) {
+    ShortPath.GetDeltaStepping(0, DeltaV[d]);
+    for (int n = 0; n < 6; n++) { EXPECT_DOUBLE_EQ(DistV[n], ShortPath.GetDist(n)); }
+    EXPECT_FALSE(ShortPath.IsReached(6));
+    EXPECT_FALSE(ShortPath.IsReached(7));
+  }
+  // a sequential query after a parallel one starts from a clean state
+  ShortPath.GetDijkstra(6);
+  EXPECT_DOUBLE_EQ(7, ShortPath.GetDist(5));
+  TIntV PathV;
+  ShortPath.GetPath(5, PathV);
+  EXPECT_EQ(7, PathV.Len());
+}
+#endif
+
+// Test that all query modes agree on a random network
+TEST(TWgtShortPath, Consistency) {
+  TFltV EWgtV;
+  PNEANet Net = GetRndWgtNet(500, 2000, EWgtV);
+  for (int Dir = 0; Dir < 2; Dir++) {
+    TWgtShortPath ShortPath(Net, EWgtV, Dir == 0);
+    for (int SrcNId = 0; SrcNId < 500; SrcNId += 97) {
+      ShortPath.GetDijkstra(SrcNId);
+      TIntFltH NIdDistH;
+      ShortPath.GetNIdDistH(NIdDistH);
+      // path lengths add up to the distances
+      for (int i = 0; i < NIdDistH.Len(); i++) {
+        TIntV PathV;
+        ShortPath.GetPath(NIdDistH.GetKey(i), PathV);
+        ASSERT_LT(0, PathV.Len());
+        EXPECT_EQ(SrcNId, PathV[0]);
+      }
+      for (int DstNId = 1; DstNId < 500; DstNId += 50) {
+        const double Dist = NIdDistH.IsKey(DstNId) ? NIdDistH.GetDat(DstNId).Val : -1.0;
+        EXPECT_DOUBLE_EQ(Dist, ShortPath.GetAStar(SrcNId, DstNId, TZeroHeuristic()));
+        TIntV TargetV;
+        TargetV.Add(DstNId);
+        ShortPath.GetDijkstra(SrcNId, TargetV);
+        if (Dist >= 0) { EXPECT_DOUBLE_EQ(Dist, ShortPath.GetDist(DstNId)); }
+        else { EXPECT_FALSE(ShortPath.IsReached(DstNId)); }
+      }
+#ifdef USE_OPENMP
+      ShortPath.GetDeltaStepping(SrcNId, 3);
+      TIntFltH MPDistH;
+      ShortPath.GetNIdDistH(MPDistH);
+      ASSERT_EQ(NIdDistH.Len(), MPDistH.Len());
+      for (int i = 0; i < NIdDistH.Len(); i++) {
+        EXPECT_DOUBLE_EQ(NIdDistH[i], MPDistH.GetDat(NIdDistH.GetKey(i)));
+      }
+#endif
+    }
+  }
+}
+
+// Test the centrality functions that reuse one flattened network
+TEST(TWgtShortPath, Centrality) {
+  TFltV EWgtV;
+  PNEANet Net = GetWgtNet(EWgtV);
+  TWgtShortPath ShortPath(Net, EWgtV);
+  // distances 2,3,3,6,6 from node 0 to the 5 nodes it reaches out of 8
+  EXPECT_DOUBLE_EQ(4.0, TSnap::GetWeightedFarnessCentr(ShortPath, 0, false));
+  EXPECT_DOUBLE_EQ(4.0 * 7.0 / 5.0, TSnap::GetWeightedFarnessCentr(ShortPath, 0, true));
+  EXPECT_DOUBLE_EQ(0.25, TSnap::GetWeightedClosenessCentr(ShortPath, 0, false));
+  EXPECT_DOUBLE_EQ(0.0, TSnap::GetWeightedFarnessCentr(ShortPath, 7));
+  EXPECT_DOUBLE_EQ(0.0, TSnap::GetWeightedClosenessCentr(ShortPath, 7));
+  for (int n = 0; n < 8; n++) {
+    EXPECT_DOUBLE_EQ(TSnap::GetWeightedFarnessCentr(Net, n, EWgtV),
+      TSnap::GetWeightedFarnessCentr(ShortPath, n));
+    EXPECT_DOUBLE_EQ(TSnap::GetWeightedClosenessCentr(Net, n, EWgtV),
+      TSnap::GetWeightedClosenessCentr(ShortPath, n));
+  }
+  TIntFltH NIdDistH;
+  TSnap::GetWeightedShortestPath(Net, 0, NIdDistH, EWgtV);
+  EXPECT_EQ(6, NIdDistH.Len());
+  EXPECT_DOUBLE_EQ(6, NIdDistH.GetDat(4));
+}
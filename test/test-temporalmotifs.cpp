@@ -0,0 +1,170 @@
+#include <gtest/gtest.h>
+
+#include "Snap.h"
+#include "temporalmotifs.h"
+
+// Three motifs, far apart in time: the two-node motif M_{5,1} on (0, 1),
+// the triangle M_{2,4} on (2, 3, 4) and the star M_{4,3} centered at 5
+static const int MotifEvents[][3] = {
+  {0, 1, 1}, {1, 0, 2}, {0, 1, 3},
+  {2, 3, 101}, {3, 4, 102}, {4, 2, 103},
+  {5, 6, 201}, {5, 7, 202}, {5, 7, 203}};
+
+// Writes the temporal edges (source, destination, time) to FNm
+static void SaveEvents(const TStr& FNm, const TVec<TIntTr>& EventV) {
+  FILE* F = fopen(FNm.CStr(), "wt");
+  for (int i = 0; i < EventV.Len(); i++) {
+    fprintf(F, "%d %d %d\n", EventV[i].Val1.Val, EventV[i].Val2.Val, EventV[i].Val3.Val);
+  }
+  fclose(F);
+}
+
+static void GetMotifEvents(TVec<TIntTr>& EventV) {
+  EventV.Clr();
+  for (int i = 0; i < int(sizeof(MotifEvents) / sizeof(MotifEvents[0])); i++) {
+    EventV.Add(TIntTr(MotifEvents[i][0], MotifEvents[i][1], MotifEvents[i][2]));
+  }
+}
+
+// Random temporal edges with distinct timestamps on few nodes, so that many
+// motif instances overlap
+static void GetRndEvents(const int& Nodes, const int& Events, const int& MxTm, TVec<TIntTr>& EventV) {
+  TRnd Rnd(17);
+  TIntSet TmSet;
+  EventV.Clr();
+  while (EventV.Len() < Events) {
+    const int Src = Rnd.GetUniDevInt(Nodes), Dst = Rnd.GetUniDevInt(Nodes);
+    const int Tm = Rnd.GetUniDevInt(MxTm);
+    if (Src != Dst && ! TmSet.IsKey(Tm)) {
+      TmSet.AddKey(Tm);
+      EventV.Add(TIntTr(Src, Dst, Tm));
+    }
+  }
+}
+
+static void ExpectEqCounts(const Counter2D& Expected, const Counter2D& Counts) {
+  for (int i = 0; i < 6; i++) {
+    for (int j = 0; j < 6; j++) {
+      EXPECT_EQ(Expected(i, j).Val, Counts(i, j).Val) << "M_{" << i+1 << "," << j+1 << "}";
+    }
+  }
+}
+
+static void ExpectEqCounts3D(const Counter3D& Expected, const Counter3D& Counts) {
+  for (int i = 0; i < 2; i++) {
+    for (int j = 0; j < 2; j++) {
+      for (int k = 0; k < 2; k++) {
+        EXPECT_EQ(Expected(i, j, k).Val, Counts(i, j, k).Val) << i << j << k;
+      }
+    }
+  }
+}
+
+// Test exact counts on a hand-built event list
+TEST(TempMotifCounter, Count3TEdge23Node) {
+  TVec<TIntTr> EventV;
+  GetMotifEvents(EventV);
+  SaveEvents("test.temporalmotifs.txt", EventV);
+  TempMotifCounter Tmc("test.temporalmotifs.txt");
+
+  Counter2D Counts;
+  Tmc.Count3TEdge23Node(10, Counts);
+  Counter2D Expected(6, 6);
+  Expected(4, 0) = 1;
+  Expected(1, 3) = 1;
+  Expected(3, 2) = 1;
+  ExpectEqCounts(Expected, Counts);
+
+  // the motifs span 2 time units
+  Tmc.Count3TEdge23Node(1, Counts);
+  ExpectEqCounts(Counter2D(6, 6), Counts);
+
+  Counter3D PreCounts, PosCounts, MidCounts;
+  Tmc.Count3TEdge3NodeStars(10, PreCounts, PosCounts, MidCounts);
+  Counter3D ExpectedPos(2, 2, 2);
+  ExpectedPos(0, 0, 0) = 1;
+  ExpectEqCounts3D(Counter3D(2, 2, 2), PreCounts);
+  ExpectEqCounts3D(ExpectedPos, PosCounts);
+  ExpectEqCounts3D(Counter3D(2, 2, 2), MidCounts);
+
+  Counter3D TriadCounts;
+  Tmc.Count3TEdgeTriads(10, TriadCounts);
+  Counter3D ExpectedTriads(2, 2, 2);
+  ExpectedTriads(0, 1, 1) = 1;
+  ExpectEqCounts3D(ExpectedTriads, TriadCounts);
+}
+
+// Test the fast star and triad counters against the naive ones
+TEST(TempMotifCounter, CountNaive) {
+  TVec<TIntTr> EventV;
+  GetRndEvents(8, 400, 1000, EventV);
+  SaveEvents("test.temporalmotifs.txt", EventV);
+  TempMotifCounter Tmc("test.temporalmotifs.txt");
+
+  Counter3D PreCounts, PosCounts, MidCounts, NPreCounts, NPosCounts, NMidCounts;
+  Tmc.Count3TEdge3NodeStars(20, PreCounts, PosCounts, MidCounts);
+  Tmc.Count3TEdge3NodeStarsNaive(20, NPreCounts, NPosCounts, NMidCounts);
+  ExpectEqCounts3D(NPreCounts, PreCounts);
+  ExpectEqCounts3D(NPosCounts, PosCounts);
+  ExpectEqCounts3D(NMidCounts, MidCounts);
+
+  Counter3D TriadCounts, NTriadCounts;
+  Tmc.Count3TEdgeTriads(20, TriadCounts);
+  Tmc.Count3TEdgeTriadsNaive(20, NTriadCounts);
+  ExpectEqCounts3D(NTriadCounts, TriadCounts);
+  uint64 Triads = 0;
+  for (int i = 0; i < 8; i++) { Triads += TriadCounts(i / 4, (i / 2) % 2, i % 2); }
+  EXPECT_LT(0u, Triads);
+}
+
+// Test that the PTable constructor gives the same counts as the file one
+TEST(TempMotifCounter, Table) {
+  TVec<TIntTr> EventV;
+  GetRndEvents(8, 400, 1000, EventV);
+  SaveEvents("test.temporalmotifs.txt", EventV);
+  TempMotifCounter FileTmc("test.temporalmotifs.txt");
+
+  // same events, in columns named differently and ordered (time, source, destination)
+  FILE* F = fopen("test.temporalmotifs.tsv", "wt");
+  for (int i = 0; i < EventV.Len(); i++) {
+    fprintf(F, "%d\t%d\t%d\n", EventV[i].Val3.Val, EventV[i].Val1.Val, EventV[i].Val2.Val);
+  }
+  fclose(F);
+  TTableContext Context;
+  Schema S;
+  S.Add(TPair<TStr,TAttrType>("ts", atInt));
+  S.Add(TPair<TStr,TAttrType>("src", atInt));
+  S.Add(TPair<TStr,TAttrType>("dst", atInt));
+  PTable Table = TTable::LoadSS(S, "test.temporalmotifs.tsv", &Context);
+  TempMotifCounter TableTmc(Table, "src", "dst", "ts");
+
+  Counter2D FileCounts, TableCounts;
+  FileTmc.Count3TEdge23Node(20, FileCounts);
+  TableTmc.Count3TEdge23Node(20, TableCounts);
+  ExpectEqCounts(FileCounts, TableCounts);
+  TFile::Del("test.temporalmotifs.tsv");
+}
+
+// Test that sampling every interval reproduces the exact counts
+TEST(TempMotifCounter, Count3TEdge23NodeSampled) {
+  TVec<TIntTr> EventV;
+  GetRndEvents(8, 400, 1000, EventV);
+  SaveEvents("test.temporalmotifs.txt", EventV);
+  TempMotifCounter Tmc("test.temporalmotifs.txt");
+
+  Counter2D Counts;
+  Tmc.Count3TEdge23Node(20, Counts);
+  TRnd Rnd(5);
+  const double WindowFactors[] = {1, 2.5, 30};
+  for (int w = 0; w < 3; w++) {
+    TFltVV EstimateVV, StdErrVV;
+    Tmc.Count3TEdge23NodeSampled(20, WindowFactors[w], 1.0, Rnd, EstimateVV, StdErrVV);
+    for (int i = 0; i < 6; i++) {
+      for (int j = 0; j < 6; j++) {
+        EXPECT_DOUBLE_EQ(double(Counts(i, j)), EstimateVV(i, j)) << "M_{" << i+1 << "," << j+1 << "}";
+        EXPECT_DOUBLE_EQ(0, StdErrVV(i, j));
+      }
+    }
+  }
+  TFile::Del("test.temporalmotifs.txt");
+}
@@ -0,0 +1,68 @@
+#include <gtest/gtest.h>
+
+#include "Snap.h"
+
+// Connected components as a vertex program: every node takes the minimum label of its neighbors.
+class TMinLabelVP : public TVtxProg<TInt> {
+public:
+  typedef TInt TVal;
+  bool InitNode(const TCsrGraph& Csr, const int& NIdx, TVal& Val) { Val = NIdx;  return true; }
+  TVpDir GetScatterDir() const { return vpdBoth; }
+  bool Update(const TCsrGraph& Csr, const int& Iter, const int& NIdx, const TVec<TVal>& ValV, TVal& NewVal) {
+    for (const TInt* N = Csr.BegOut(NIdx); N < Csr.EndOut(NIdx); N++) { NewVal = TMath::Mn(NewVal.Val, ValV[*N].Val); }
+    for (const TInt* N = Csr.BegIn(NIdx); N < Csr.EndIn(NIdx); N++) { NewVal = TMath::Mn(NewVal.Val, ValV[*N].Val); }
+    return NewVal != ValV[NIdx];
+  }
+};
+
+TEST(VtxProgTest, Frontier) {
+  PNGraph Graph = TSnap::GenRndGnm<PNGraph>(2000, 1500);
+  TCsrGraph Csr(Graph);
+  TMinLabelVP MinLabel;
+  TVtxProgEngine<TMinLabelVP> Engine(Csr);
+  const int Iters = Engine.Run(MinLabel, 10000);
+  EXPECT_LT(Iters, 10000);
+  TCnComV CnComV, VpCnComV;
+  TSnap::GetWccs(Graph, CnComV);
+  TSnap::GetCnComFromLabels(Csr, Engine.GetValV(), VpCnComV);
+  ASSERT_EQ(CnComV.Len(), VpCnComV.Len());
+  for (int c = 0; c < CnComV.Len(); c++) {
+    EXPECT_EQ(CnComV[c].Len(), VpCnComV[c].Len());
+  }
+}
+
+TEST(VtxProgTest, LabelProp) {
+  // three 10-cliques joined in a ring by single edges
+  PUNGraph Graph = TUNGraph::New();
+  for (int c = 0; c < 3; c++) {
+    for (int i = 0; i < 10; i++) {
+      Graph->AddNode(10*c + i);
+      for (int j = 0; j < i; j++) { Graph->AddEdge(10*c + i, 10*c + j); }
+    }
+  }
+  Graph->AddEdge(0, 10);  Graph->AddEdge(11, 20);  Graph->AddEdge(21, 1);
+  TCnComV CmtyV;
+  const double Q = TSnap::CommunityLabelProp(Graph, CmtyV);
+  ASSERT_EQ(CmtyV.Len(), 3);
+  for (int c = 0; c < CmtyV.Len(); c++) {
+    EXPECT_EQ(CmtyV[c].Len(), 10);
+    for (int i = 0; i < CmtyV[c].Len(); i++) { EXPECT_EQ(CmtyV[c][i] / 10, CmtyV[c][0] / 10); }
+  }
+  EXPECT_NEAR(Q, TSnap::GetModularity(Graph, CmtyV), 1e-9);
+  EXPECT_GT(Q, 0.5);
+}
+
+#ifdef USE_OPENMP
+TEST(VtxProgTest, Hits) {
+  PNGraph Graph = TSnap::GenRndGnm<PNGraph>(500, 3000);
+  TIntFltH HubH, AuthH, HubMPH, AuthMPH;
+  TSnap::GetHits(Graph, HubH, AuthH);
+  TSnap::GetHitsMP(Graph, HubMPH, AuthMPH);
+  ASSERT_EQ(HubH.Len(), HubMPH.Len());
+  for (int i = 0; i < HubH.Len(); i++) {
+    EXPECT_EQ(HubH.GetKey(i), HubMPH.GetKey(i));
+    EXPECT_NEAR(HubH[i], HubMPH[i], 1e-9);
+    EXPECT_NEAR(AuthH.GetDat(HubH.GetKey(i)), AuthMPH.GetDat(HubH.GetKey(i)), 1e-9);
+  }
+}
+#endif
@@ -0,0 +1,90 @@
+#include <gtest/gtest.h>
+
+#include "Snap.h"
+#include "word2vec.h"
+
+// Test that embeddings written in the binary word2vec format read back unchanged
+TEST(TSkipGram, SaveLoadBin) {
+  TIntFltVH EmbeddingsHV;
+  TRnd Rnd(5);
+  const int Dimensions = 13;
+  // node ids with several digits, and values that are exact in float32
+  for (int n = 0; n < 50; n++) {
+    TFltV ValV(Dimensions);
+    for (int d = 0; d < Dimensions; d++) { ValV[d] = float(Rnd.GetNrmDev()); }
+    EmbeddingsHV.AddDat(n * 1013, ValV);
+  }
+  // bytes of newlines and spaces inside the float values
+  EmbeddingsHV.GetDat(0)[0] = float(1.4e-44);  // 0x0000000a
+  EmbeddingsHV.GetDat(0)[1] = float(4.5e-44);  // 0x00000020
+  EmbeddingsHV.GetDat(0)[2] = -0.0;
+  SaveEmbeddingsBin(TFOut::New("test.emb.dat"), EmbeddingsHV);
+
+  TIntFltVH LoadHV;
+  LoadEmbeddingsBin(TFIn::New("test.emb.dat"), LoadHV);
+  ASSERT_EQ(EmbeddingsHV.Len(), LoadHV.Len());
+  for (int i = 0; i < EmbeddingsHV.Len(); i++) {
+    EXPECT_EQ(EmbeddingsHV.GetKey(i), LoadHV.GetKey(i));
+    const TFltV& ValV = EmbeddingsHV[i];
+    const TFltV& LoadV = LoadHV.GetDat(EmbeddingsHV.GetKey(i));
+    ASSERT_EQ(Dimensions, LoadV.Len());
+    for (int d = 0; d < Dimensions; d++) { EXPECT_EQ(ValV[d].Val, LoadV[d].Val); }
+  }
+
+  // header line, then id, space, float32 values and newline for every node
+  TFIn FIn("test.emb.dat");
+  // ids 0, 1013..9117 and 10130..49637 have 1, 4 and 5 digits
+  EXPECT_EQ(6 + 50 * (Dimensions * 4 + 2) + 1 + 9 * 4 + 40 * 5, FIn.Len());
+}
+
+// Test training with buffers reused across walks and threads
+TEST(TSkipGram, TrainWalk) {
+  // two groups of words that only appear together
+  const int Words = 20, WalkLen = 20;
+  TRnd Rnd(1);
+  TVec<TIntV> WalkVV;
+  TIntV Vocab(Words);
+  for (int w = 0; w < 2000; w++) {
+    TIntV WalkV;
+    const int Group = w % 2;
+    for (int i = 0; i < WalkLen; i++) { WalkV.Add(Group * Words/2 + Rnd.GetUniDevInt(Words/2)); }
+    for (int i = 0; i < WalkLen; i++) { Vocab[WalkV[i]]++; }
+    WalkVV.Add(WalkV);
+  }
+  TSkipGram SkipGram(Vocab, 16, 3, 2000 * WalkLen, false, Rnd);
+  EXPECT_LE(2 * Words * 16 * int64(sizeof(float)), SkipGram.GetMemUsed());
+#ifdef USE_OPENMP
+  TVec<TRnd> RndV(omp_get_max_threads());
+#else
+  TVec<TRnd> RndV(1);
+#endif
+  for (int t = 0; t < RndV.Len(); t++) { RndV[t].PutSeed(t+1); }
+#pragma omp parallel for schedule(dynamic)
+  for (int w = 0; w < WalkVV.Len(); w++) {
+#ifdef USE_OPENMP
+    TRnd& ThreadRnd = RndV[omp_get_thread_num()];
+#else
+    TRnd& ThreadRnd = RndV[0];
+#endif
+    SkipGram.TrainWalk(WalkVV[w].BegI(), WalkLen, ThreadRnd);
+  }
+  EXPECT_EQ(2000 * WalkLen, SkipGram.GetWordCnt());
+  TIntV NIdV;
+  for (int i = 0; i < Words; i++) { NIdV.Add(100 + i); }
+  TIntFltVH EmbeddingsHV;
+  SkipGram.GetEmbeddings(NIdV, EmbeddingsHV);
+  ASSERT_EQ(Words, EmbeddingsHV.Len());
+  // words of the same group are more similar than words of different groups
+  double InSim = 0, OutSim = 0;
+  for (int i = 0; i < Words; i++) {
+    for (int j = 0; j < Words; j++) {
+      if (i == j) { continue; }
+      const TFltV& V1 = EmbeddingsHV.GetDat(100 + i);
+      const TFltV& V2 = EmbeddingsHV.GetDat(100 + j);
+      ASSERT_EQ(16, V1.Len());
+      const double Sim = TLinAlg::DotProduct(V1, V2) / sqrt(TLinAlg::Norm2(V1) * TLinAlg::Norm2(V2));
+      if (i / (Words/2) == j / (Words/2)) { InSim += Sim; } else { OutSim += Sim; }
+    }
+  }
+  EXPECT_LT(OutSim / 200.0 + 0.2, InSim / 180.0);
+}